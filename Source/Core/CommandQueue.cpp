@@ -4,32 +4,67 @@
 
 namespace core
 {
-	CommandBuffer::CommandBuffer(size_t allocationByteSize)
-		: m_buffer(nullptr)
+	CommandBuffer::Page::Page(size_t numBytes)
+		: m_buffer(static_cast<uint8_t*>(malloc(numBytes))) // Note: malloc is aligned to alignof(std::max_align_t)
+		, m_numBytes(numBytes)
 		, m_baseIdx(0)
-		, m_bufferNumBytes(allocationByteSize)		
+		, m_next(nullptr)
 	{
-		m_buffer = malloc(m_bufferNumBytes);
+		// Unclaimed space must read as CommandState::Unpublished
+		memset(m_buffer, 0, m_numBytes);
+	}
+
+
+	CommandBuffer::Page::~Page()
+	{
+		free(m_buffer);
+		m_buffer = nullptr;
+
+		delete m_next.load(std::memory_order_relaxed);
+	}
+
+
+	// ---
+
 
-		// As a micro-optimization, reserve a reasonable amount of space in the metadata vector
-		constexpr size_t expectedAllocationChunkByteSize = 64;
-		m_commandMetadata.reserve(allocationByteSize / expectedAllocationChunkByteSize);
+	CommandBuffer::CommandBuffer(size_t pageByteSize)
+		: m_firstPage(std::make_unique<Page>(pageByteSize))
+		, m_currentPage(nullptr)
+		, m_pageByteSize(pageByteSize)
+	{
+		m_currentPage.store(m_firstPage.get(), std::memory_order_release);
 	}
 
 
 	CommandBuffer::~CommandBuffer()
 	{
 		Reset();
+		m_currentPage.store(nullptr, std::memory_order_release);
+		m_firstPage = nullptr;
+	}
+
+
+	CommandBuffer::Page* CommandBuffer::GetNextPage(Page* fullPage)
+	{
+		Page* nextPage = fullPage->m_next.load(std::memory_order_acquire);
+		if (nextPage == nullptr)
 		{
-			std::unique_lock<std::mutex> lock(m_commandMetadataMutex);
-			
-			if (m_buffer != nullptr)
+			// Race the other producers to link a new page. The losers discard theirs
+			Page* newPage = new Page(m_pageByteSize);
+			if (fullPage->m_next.compare_exchange_strong(nextPage, newPage, std::memory_order_acq_rel))
 			{
-				free(m_buffer);
-				m_buffer = nullptr;
-				m_baseIdx = 0;
+				nextPage = newPage;
+			}
+			else
+			{
+				delete newPage;
 			}
 		}
+
+		// Advance the current page, unless another producer has already done so
+		m_currentPage.compare_exchange_strong(fullPage, nextPage, std::memory_order_acq_rel);
+
+		return nextPage;
 	}
 
 
@@ -37,19 +72,15 @@ namespace core
 	{
 		SEBeginCPUEvent("CommandBuffer::Execute");
 
-		// To ensure deterministic execution order, we execute commands single threaded via the CommandManager. We lock
-		// our own mutex just to be safe, but it shouldn't be necessary as we're executing the CommandBuffer at the
-		// reading index
-		{
-			std::unique_lock<std::mutex> lock(m_commandMetadataMutex);
-
-			for (size_t cmdIdx = 0; cmdIdx < m_commandMetadata.size(); cmdIdx++)
+		// To ensure deterministic execution order, we execute commands single threaded via the CommandManager, in the
+		// order that their space in the buffer was claimed
+		size_t cmdIdx = 0;
+		ForEachCommand([&cmdIdx](CommandMetadata* metadata)
 			{
-				SEBeginCPUEvent("CommandBuffer::Execute command %llu/%llu", cmdIdx, m_commandMetadata.size());
-				m_commandMetadata[cmdIdx]->Execute(m_commandMetadata[cmdIdx]->m_commandData);
+				SEBeginCPUEvent("CommandBuffer::Execute command %llu", cmdIdx++);
+				metadata->Execute(metadata->m_commandData);
 				SEEndCPUEvent();
-			}			
-		}
+			});
 
 		SEEndCPUEvent();
 	}
@@ -58,17 +89,225 @@ namespace core
 	void CommandBuffer::Reset()
 	{
 		SEBeginCPUEvent("CommandBuffer::Reset");
+
+		// Even though we own the backing memory, we manually call the command dtors incase they're complex types
+		ForEachCommand([](CommandMetadata* metadata)
+			{
+				metadata->Destroy(metadata->m_commandData);
+			});
+
+		// Clear the claimed bytes so stale metadata can't be mistaken for published commands once the pages are reused
+		Page* page = m_firstPage.get();
+		while (page)
+		{
+			const size_t numClaimedBytes = std::min(page->m_baseIdx.load(std::memory_order_relaxed), page->m_numBytes);
+			memset(page->m_buffer, 0, numClaimedBytes);
+			page->m_baseIdx.store(0, std::memory_order_relaxed);
+
+			page = page->m_next.load(std::memory_order_relaxed);
+		}
+		m_currentPage.store(m_firstPage.get(), std::memory_order_release);
+
+		SEEndCPUEvent();
+	}
+
+
+	/******************************************************************************************************************/
+
+
+	namespace
+	{
+		// Per-thread CommandBuffers grow by chaining pages, so we don't need every producer to allocate the full size
+		constexpr size_t k_maxPerThreadPageByteSize = 256 * 1024;
+
+
+		std::atomic<uint64_t> s_perThreadCommandBuffersUniqueID = 0;
+
+
+		// Each producer thread is assigned a slot the first time it records into any PerThreadCommandBuffers. Slots
+		// are never reassigned, so a thread's commands sort identically across frames and managers. The assignment
+		// order depends on thread scheduling, so it is not reproducible across runs
+		constexpr uint32_t k_invalidThreadSlot = std::numeric_limits<uint32_t>::max();
+		std::atomic<uint32_t> s_nextThreadSlot = 0;
+		thread_local uint32_t s_threadSlot = k_invalidThreadSlot;
+
+		uint32_t GetThreadSlot()
+		{
+			if (s_threadSlot == k_invalidThreadSlot)
+			{
+				s_threadSlot = s_nextThreadSlot.fetch_add(1);
+			}
+			return s_threadSlot;
+		}
+
+
+		struct ProducerCacheEntry
+		{
+			uint64_t m_ownerUniqueID = std::numeric_limits<uint64_t>::max();
+			void* m_producer = nullptr;
+		};
+		constexpr size_t k_producerCacheSize = 8;
+
+		thread_local std::array<ProducerCacheEntry, k_producerCacheSize> s_producerCache;
+		thread_local size_t s_nextProducerCacheEntry = 0;
+	}
+
+
+	PerThreadCommandBuffers::PerThreadCommandBuffers(size_t pageByteSize, uint8_t numBuffers)
+		: m_pageByteSize(std::min(pageByteSize, k_maxPerThreadPageByteSize))
+		, m_numBuffers(numBuffers)
+		, m_uniqueID(s_perThreadCommandBuffersUniqueID.fetch_add(1))
+	{
+	}
+
+
+	PerThreadCommandBuffers::Producer& PerThreadCommandBuffers::GetProducer()
+	{
+		// Fast path: We've recently recorded from the calling thread
+		for (ProducerCacheEntry const& cacheEntry : s_producerCache)
+		{
+			if (cacheEntry.m_ownerUniqueID == m_uniqueID)
+			{
+				return *static_cast<Producer*>(cacheEntry.m_producer);
+			}
+		}
+
+		// Slow path: The calling thread is new, or was evicted from the cache (if it uses more than
+		// k_producerCacheSize managers). Evicted threads reuse the Producer they registered previously
+		const uint32_t threadSlot = GetThreadSlot();
+
+		Producer* producer = nullptr;
+		{
+			std::shared_lock<std::shared_mutex> readLock(m_producersMutex);
+			producer = FindProducer(threadSlot);
+		}
+
+		if (producer == nullptr)
+		{
+			std::unique_lock<std::shared_mutex> writeLock(m_producersMutex);
+
+			// Only the calling thread can register its own slot, so it can't have been added since we checked
+			auto insertItr = std::lower_bound(m_producers.begin(), m_producers.end(), threadSlot,
+				[](std::unique_ptr<Producer> const& existing, uint32_t slot)
+				{
+					return existing->m_threadSlot < slot;
+				});
+
+			std::unique_ptr<Producer> newProducer = std::make_unique<Producer>();
+			newProducer->m_threadSlot = threadSlot;
+			for (uint8_t bufferIdx = 0; bufferIdx < m_numBuffers; ++bufferIdx)
+			{
+				newProducer->m_commandBuffers.emplace_back(std::make_unique<CommandBuffer>(m_pageByteSize));
+			}
+			producer = m_producers.emplace(insertItr, std::move(newProducer))->get();
+		}
+
+		ProducerCacheEntry& cacheEntry = s_producerCache[s_nextProducerCacheEntry];
+		s_nextProducerCacheEntry = (s_nextProducerCacheEntry + 1) % k_producerCacheSize;
+
+		cacheEntry.m_ownerUniqueID = m_uniqueID;
+		cacheEntry.m_producer = producer;
+
+		return *producer;
+	}
+
+
+	PerThreadCommandBuffers::Producer* PerThreadCommandBuffers::FindProducer(uint32_t threadSlot) const
+	{
+		auto producerItr = std::lower_bound(m_producers.begin(), m_producers.end(), threadSlot,
+			[](std::unique_ptr<Producer> const& existing, uint32_t slot)
+			{
+				return existing->m_threadSlot < slot;
+			});
+
+		if (producerItr != m_producers.end() && (*producerItr)->m_threadSlot == threadSlot)
+		{
+			return producerItr->get();
+		}
+		return nullptr;
+	}
+
+
+	void PerThreadCommandBuffers::Merge(uint8_t bufferIdx)
+	{
+		SEBeginCPUEvent("PerThreadCommandBuffers::Merge");
+
+		m_mergedCommands.clear();
+		{
+			std::shared_lock<std::shared_mutex> readLock(m_producersMutex);
+
+			for (std::unique_ptr<Producer> const& producer : m_producers)
+			{
+				uint32_t sequenceIdx = 0;
+				producer->m_commandBuffers[bufferIdx]->ForEachCommand(
+					[this, &producer, &sequenceIdx](CommandBuffer::CommandMetadata* metadata)
+					{
+						m_mergedCommands.emplace_back(MergedCommand{
+							.m_sortKey = metadata->m_sortKey,
+							.m_threadSlot = producer->m_threadSlot,
+							.m_sequenceIdx = sequenceIdx++,
+							.m_metadata = metadata,
+						});
+					});
+			}
+		}
+
+		// Producers are visited in thread slot order, and each producer's commands in enqueue order, so a stable sort
+		// on the sort key alone gives us (sort key, thread slot, sequence) ordering
+		std::stable_sort(m_mergedCommands.begin(), m_mergedCommands.end(),
+			[](MergedCommand const& lhs, MergedCommand const& rhs)
+			{
+				return lhs.m_sortKey < rhs.m_sortKey;
+			});
+
+		SEEndCPUEvent();
+	}
+
+
+	void PerThreadCommandBuffers::Execute() const
+	{
+		SEBeginCPUEvent("PerThreadCommandBuffers::Execute");
+
+		for (size_t cmdIdx = 0; cmdIdx < m_mergedCommands.size(); ++cmdIdx)
+		{
+			SEBeginCPUEvent("PerThreadCommandBuffers::Execute command %llu/%llu", cmdIdx, m_mergedCommands.size());
+			CommandBuffer::CommandMetadata* metadata = m_mergedCommands[cmdIdx].m_metadata;
+			metadata->Execute(metadata->m_commandData);
+			SEEndCPUEvent();
+		}
+
+		SEEndCPUEvent();
+	}
+
+
+	bool PerThreadCommandBuffers::HasCommandsToExecute(uint8_t bufferIdx) const
+	{
+		std::shared_lock<std::shared_mutex> readLock(m_producersMutex);
+
+		for (std::unique_ptr<Producer> const& producer : m_producers)
+		{
+			if (producer->m_commandBuffers[bufferIdx]->HasCommandsToExecute())
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+
+	void PerThreadCommandBuffers::Reset(uint8_t bufferIdx)
+	{
+		SEBeginCPUEvent("PerThreadCommandBuffers::Reset");
 		{
-			std::unique_lock<std::mutex> lock(m_commandMetadataMutex);
+			std::shared_lock<std::shared_mutex> readLock(m_producersMutex);
 
-			// Even though we own the backing memory, we manually call the command dtors incase they're complex types
-			for (size_t cmdIdx = 0; cmdIdx < m_commandMetadata.size(); cmdIdx++)
+			for (std::unique_ptr<Producer> const& producer : m_producers)
 			{
-				m_commandMetadata[cmdIdx]->Destroy(m_commandMetadata[cmdIdx]->m_commandData);
+				producer->m_commandBuffers[bufferIdx]->Reset();
 			}
-			m_commandMetadata.clear();
-			m_baseIdx = 0;
 		}
+		m_mergedCommands.clear(); // Any merged commands may reference the buffer we just reset
+
 		SEEndCPUEvent();
 	}
 
@@ -76,13 +315,27 @@ namespace core
 	/******************************************************************************************************************/
 
 
-	CommandManager::CommandManager(size_t bufferAllocationSize)
+	CommandManager::CommandManager(size_t bufferAllocationSize, CommandRecordingMode recordingMode)
 		: m_writeIdx(0)
 		, m_readIdx(static_cast<uint8_t>(-1)) // Read index starts OOB
+		, m_recordingMode(recordingMode)
 	{
-		for (uint8_t bufferIdx = 0; bufferIdx < k_numBuffers; bufferIdx++)
+		switch (m_recordingMode)
+		{
+		case CommandRecordingMode::SharedBuffer:
+		{
+			for (uint8_t bufferIdx = 0; bufferIdx < k_numBuffers; bufferIdx++)
+			{
+				m_commandBuffers[bufferIdx] = std::make_unique<CommandBuffer>(bufferAllocationSize);
+			}
+		}
+		break;
+		case CommandRecordingMode::PerThread:
 		{
-			m_commandBuffers[bufferIdx] = std::make_unique<CommandBuffer>(bufferAllocationSize);
+			m_perThreadCommandBuffers = std::make_unique<PerThreadCommandBuffers>(bufferAllocationSize, k_numBuffers);
+		}
+		break;
+		default: SEAssertF("Invalid command recording mode");
 		}
 	}
 
@@ -98,7 +351,15 @@ namespace core
 
 			// We must reset while we hold the m_commandBuffersMutex, in case another thread is trying to Enqueue a
 			// command using the old/new write index
-			m_commandBuffers[m_writeIdx]->Reset();
+			if (m_recordingMode == CommandRecordingMode::PerThread)
+			{
+				m_perThreadCommandBuffers->Reset(m_writeIdx);
+				m_perThreadCommandBuffers->Merge(m_readIdx);
+			}
+			else
+			{
+				m_commandBuffers[m_writeIdx]->Reset();
+			}
 		}
 		SEEndCPUEvent();
 	}
@@ -111,7 +372,14 @@ namespace core
 		// To ensure deterministic execution order, we execute commands single threaded
 		{
 			std::shared_lock<std::shared_mutex> readLock(m_commandBuffersMutex);
-			m_commandBuffers[m_readIdx]->Execute();
+			if (m_recordingMode == CommandRecordingMode::PerThread)
+			{
+				m_perThreadCommandBuffers->Execute(); // Merged during SwapBuffers()
+			}
+			else
+			{
+				m_commandBuffers[m_readIdx]->Execute();
+			}
 		}
 		SEEndCPUEvent();
 	}
@@ -138,17 +406,33 @@ namespace core
 	/******************************************************************************************************************/
 
 
-	FrameIndexedCommandManager::FrameIndexedCommandManager(size_t bufferAllocationSize, uint8_t numFramesInFlight)
+	FrameIndexedCommandManager::FrameIndexedCommandManager(
+		size_t bufferAllocationSize, uint8_t numFramesInFlight, CommandRecordingMode recordingMode)
 		: m_lastEnqueuedFrameNum(k_invalidFrameNum)
 		, m_lastExecutedFrameNum(k_invalidFrameNum)
 		, m_numBuffers(numFramesInFlight)
+		, m_recordingMode(recordingMode)
 	{
 		{
 			std::unique_lock<std::mutex> lock(m_commandBuffersMutex);
 
-			for (uint8_t bufferIdx = 0; bufferIdx < m_numBuffers; bufferIdx++)
+			switch (m_recordingMode)
 			{
-				m_commandBuffers.emplace_back(std::make_unique<CommandBuffer>(bufferAllocationSize));
+			case CommandRecordingMode::SharedBuffer:
+			{
+				for (uint8_t bufferIdx = 0; bufferIdx < m_numBuffers; bufferIdx++)
+				{
+					m_commandBuffers.emplace_back(std::make_unique<CommandBuffer>(bufferAllocationSize));
+				}
+			}
+			break;
+			case CommandRecordingMode::PerThread:
+			{
+				m_perThreadCommandBuffers = 
+					std::make_unique<PerThreadCommandBuffers>(bufferAllocationSize, m_numBuffers);
+			}
+			break;
+			default: SEAssertF("Invalid command recording mode");
 			}
 		}
 	}
@@ -163,8 +447,17 @@ namespace core
 
 		// To ensure deterministic execution order, we execute commands single threaded
 		const uint8_t readIdx = GetReadIdx(frameNum);
-		m_commandBuffers[readIdx]->Execute();
-		m_commandBuffers[readIdx]->Reset();
+		if (m_recordingMode == CommandRecordingMode::PerThread)
+		{
+			m_perThreadCommandBuffers->Merge(readIdx);
+			m_perThreadCommandBuffers->Execute();
+			m_perThreadCommandBuffers->Reset(readIdx);
+		}
+		else
+		{
+			m_commandBuffers[readIdx]->Execute();
+			m_commandBuffers[readIdx]->Reset();
+		}
 
 		m_lastExecutedFrameNum = frameNum;
 
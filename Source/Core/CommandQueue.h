@@ -9,20 +9,36 @@ namespace core
 	class CommandManager;
 
 
+	enum class CommandRecordingMode : uint8_t
+	{
+		SharedBuffer,	// All producers record into a single (lock-free) CommandBuffer, executed in claim order
+		PerThread,		// Each thread records into its own CommandBuffer, merged by (sort key, thread, sequence)
+	};
+	// Note: No engine manager uses CommandRecordingMode::PerThread yet. Its thread tie-break is only stable within a
+	// single run; see CommandManager::EnqueueWithSortKey
+
+
+	// Multi-producer command arena. Enqueue claims space with an atomic bump allocator, and the buffer grows by
+	// chaining additional pages rather than overflowing. Commands are executed (single-threaded) in the order their
+	// space was claimed
 	class CommandBuffer final
 	{
 	public:
-		CommandBuffer(size_t allocationByteSize);
+		CommandBuffer(size_t pageByteSize);
 		~CommandBuffer();
 
 
 	protected:
 		friend class CommandManager;
 		friend class FrameIndexedCommandManager;
+		friend class PerThreadCommandBuffers;
 
 		template<typename T, typename... Args>
 		void Enqueue(Args&&... args);
 
+		template<typename T, typename... Args>
+		void EnqueueWithSortKey(uint64_t sortKey, Args&&... args);
+
 		void Execute() const;
 		
 		bool HasCommandsToExecute() const;
@@ -31,11 +47,21 @@ namespace core
 
 
 	private:
+		enum CommandState : uint32_t
+		{
+			Unpublished	= 0, // Space has been claimed, but the command is not yet constructed
+			Published	= 1,
+			EndOfPage	= 2, // The command did not fit in the page, it will be found in the next page
+		};
+
 		struct CommandMetadata
 		{
 			void* m_commandData = nullptr;
 			void (*Execute)(void*) = nullptr;
 			void (*Destroy)(void*) = nullptr;
+			uint64_t m_sortKey = 0; // Only used by CommandRecordingMode::PerThread
+			uint32_t m_byteSize = 0; // Byte offset from this command to the next one in the page
+			uint32_t m_state = CommandState::Unpublished; // Accessed via std::atomic_ref
 		};
 
 		template<typename T>
@@ -52,13 +78,31 @@ namespace core
 			}
 		};
 
-	private:
-		void* m_buffer;
-		size_t m_baseIdx;
-		const size_t m_bufferNumBytes;
+		struct Page
+		{
+			Page(size_t numBytes);
+			~Page();
+
+			uint8_t* m_buffer;
+			const size_t m_numBytes;
+			std::atomic<size_t> m_baseIdx; // Bump allocator: May exceed m_numBytes once the page is full
+			std::atomic<Page*> m_next;
+		};
+
+		static constexpr size_t k_commandAlignment = alignof(std::max_align_t);
+
+		static CommandMetadata* GetMetadata(Page const*, size_t byteOffset);
 
-		std::vector<CommandMetadata*> m_commandMetadata;
-		mutable std::mutex m_commandMetadataMutex;
+		Page* GetNextPage(Page* fullPage); // Links a new page if required
+
+		template<typename Visitor>
+		void ForEachCommand(Visitor&&) const; // Walks pages/commands in claim order
+
+
+	private:
+		std::unique_ptr<Page> m_firstPage; // Pages are reused after a Reset()
+		std::atomic<Page*> m_currentPage;
+		const size_t m_pageByteSize;
 
 
 	private: 
@@ -73,33 +117,58 @@ namespace core
 	template<typename T, typename... Args>
 	void CommandBuffer::Enqueue(Args&&... args)
 	{
-		SEBeginCPUEvent("CommandBuffer::Enqueue");
+		EnqueueWithSortKey<T>(0, std::forward<Args>(args)...);
+	}
 
-		SEAssert(m_buffer != nullptr, "No buffer allocation exists");
 
-		{
-			std::unique_lock<std::mutex> lock(m_commandMetadataMutex);
+	template<typename T, typename... Args>
+	void CommandBuffer::EnqueueWithSortKey(uint64_t sortKey, Args&&... args)
+	{
+		SEBeginCPUEvent("CommandBuffer::Enqueue");
+
+		SEStaticAssert(alignof(PackedCommand<T>) <= k_commandAlignment, "Command type is over-aligned");
 
-			const size_t byteOffset = sizeof(PackedCommand<T>);
+		constexpr size_t k_cmdByteSize = 
+			((sizeof(PackedCommand<T>) + k_commandAlignment - 1) / k_commandAlignment) * k_commandAlignment;
 
-			// Reinterpret the required memory in our buffer as a PackedCommand:
-			PackedCommand<T>* packedCommand = 
-				reinterpret_cast<PackedCommand<T>*>(static_cast<uint8_t*>(m_buffer) + m_baseIdx);
-			m_baseIdx += byteOffset;
+		SEAssert(k_cmdByteSize <= m_pageByteSize, "Command is larger than the page size");
 
-			SEAssert(m_baseIdx < m_bufferNumBytes,
-				"Commands have overflowed. Consider increasing the allocation size");
+		Page* page = m_currentPage.load(std::memory_order_acquire);
+		while (true)
+		{
+			// Claim our space:
+			const size_t byteOffset = page->m_baseIdx.fetch_add(k_cmdByteSize, std::memory_order_relaxed);
+			if (byteOffset + k_cmdByteSize <= page->m_numBytes)
+			{
+				// Reinterpret the required memory in our buffer as a PackedCommand:
+				PackedCommand<T>* packedCommand = reinterpret_cast<PackedCommand<T>*>(page->m_buffer + byteOffset);
+
+				// Place our data:
+				new (&packedCommand->m_metadata) CommandMetadata();
+				T* newCommand = new (&packedCommand->m_commandData) T(std::forward<Args>(args)...);
+
+				// Set the metadata so we can access everything later on:
+				packedCommand->m_metadata.m_commandData = newCommand;
+				packedCommand->m_metadata.Execute = &newCommand->T::Execute;
+				packedCommand->m_metadata.Destroy = &PackedCommand<T>::Destroy;
+				packedCommand->m_metadata.m_sortKey = sortKey;
+				packedCommand->m_metadata.m_byteSize = static_cast<uint32_t>(k_cmdByteSize);
+
+				// Publish the command:
+				std::atomic_ref<uint32_t>(packedCommand->m_metadata.m_state).store(
+					CommandState::Published, std::memory_order_release);
+				break;
+			}
 
-			// Place our data:
-			new (&packedCommand->m_metadata) CommandMetadata();
-			T* newCommand = new (&packedCommand->m_commandData) T(std::forward<Args>(args)...);
+			// Our claim straddles the end of the page: We're the only producer that can observe this, so we mark the
+			// end of the valid commands (if the metadata fits) before moving on to the next page
+			if (byteOffset < page->m_numBytes && byteOffset + sizeof(CommandMetadata) <= page->m_numBytes)
+			{
+				CommandMetadata* endOfPage = new (page->m_buffer + byteOffset) CommandMetadata();
+				std::atomic_ref<uint32_t>(endOfPage->m_state).store(CommandState::EndOfPage, std::memory_order_release);
+			}
 
-			// Set the metadata so we can access everything later on:
-			packedCommand->m_metadata.m_commandData = newCommand;
-			packedCommand->m_metadata.Execute = &newCommand->T::Execute;
-			packedCommand->m_metadata.Destroy = &PackedCommand<T>::Destroy;
-			
-			m_commandMetadata.emplace_back(&packedCommand->m_metadata);
+			page = GetNextPage(page);
 		}
 
 		SEEndCPUEvent();
@@ -108,9 +177,54 @@ namespace core
 
 	inline bool CommandBuffer::HasCommandsToExecute() const
 	{
+		return m_firstPage->m_baseIdx.load(std::memory_order_acquire) != 0;
+	}
+
+
+	inline CommandBuffer::CommandMetadata* CommandBuffer::GetMetadata(Page const* page, size_t byteOffset)
+	{
+		return reinterpret_cast<CommandMetadata*>(page->m_buffer + byteOffset);
+	}
+
+
+	template<typename Visitor>
+	void CommandBuffer::ForEachCommand(Visitor&& visitor) const
+	{
+		Page const* page = m_firstPage.get();
+		while (page)
 		{
-			std::unique_lock<std::mutex> lock(m_commandMetadataMutex);
-			return !m_commandMetadata.empty();
+			const size_t numClaimedBytes = 
+				std::min(page->m_baseIdx.load(std::memory_order_acquire), page->m_numBytes);
+			if (numClaimedBytes == 0)
+			{
+				break; // Pages are filled in order: Nothing was claimed beyond here
+			}
+
+			size_t byteOffset = 0;
+			while (byteOffset < numClaimedBytes && byteOffset + sizeof(CommandMetadata) <= page->m_numBytes)
+			{
+				CommandMetadata* metadata = GetMetadata(page, byteOffset);
+
+				// A producer may have claimed its space but still be constructing its command
+				std::atomic_ref<uint32_t> state(metadata->m_state);
+				uint32_t curState = state.load(std::memory_order_acquire);
+				while (curState == CommandState::Unpublished)
+				{
+					std::this_thread::yield();
+					curState = state.load(std::memory_order_acquire);
+				}
+
+				if (curState == CommandState::EndOfPage)
+				{
+					break;
+				}
+
+				visitor(metadata);
+
+				byteOffset += metadata->m_byteSize;
+			}
+
+			page = page->m_next.load(std::memory_order_acquire);
 		}
 	}
 
@@ -118,6 +232,78 @@ namespace core
 	/******************************************************************************************************************/
 
 
+	// Per-producer-thread CommandBuffers for CommandRecordingMode::PerThread. Each thread lazily registers itself the
+	// first time it enqueues a command, and then records into its own CommandBuffers without any cross-thread
+	// contention. Before execution, the commands from all threads are merged into a deterministic order
+	class PerThreadCommandBuffers final
+	{
+	public:
+		PerThreadCommandBuffers(size_t pageByteSize, uint8_t numBuffers);
+		~PerThreadCommandBuffers() = default;
+
+		template<typename T, typename... Args>
+		void Enqueue(uint8_t bufferIdx, uint64_t sortKey, Args&&... args);
+
+		// Sort the commands recorded by all threads into (sort key, producer thread slot, sequence) order. Thread slots
+		// are assigned in first-use order, so only unique sort keys give the same order across runs
+		void Merge(uint8_t bufferIdx);
+
+		void Execute() const; // Executes the most recently merged commands
+
+		bool HasCommandsToExecute(uint8_t bufferIdx) const;
+
+		void Reset(uint8_t bufferIdx);
+
+
+	private:
+		struct Producer
+		{
+			uint32_t m_threadSlot; // Assigned once per thread, for the lifetime of the process
+			std::vector<std::unique_ptr<CommandBuffer>> m_commandBuffers; // One per buffer index
+		};
+
+		Producer& GetProducer(); // For the calling thread
+
+		Producer* FindProducer(uint32_t threadSlot) const; // Requires m_producersMutex to be held
+
+
+	private:
+		const size_t m_pageByteSize;
+		const uint8_t m_numBuffers;
+		const uint64_t m_uniqueID; // Distinguishes us in the per-thread caches, even if our address is reused
+
+		std::vector<std::unique_ptr<Producer>> m_producers; // Sorted by thread slot
+		mutable std::shared_mutex m_producersMutex;
+
+		struct MergedCommand
+		{
+			uint64_t m_sortKey;
+			uint32_t m_threadSlot;
+			uint32_t m_sequenceIdx;
+			CommandBuffer::CommandMetadata* m_metadata;
+		};
+		std::vector<MergedCommand> m_mergedCommands; // Reused every frame
+
+
+	private:
+		PerThreadCommandBuffers() = delete;
+		PerThreadCommandBuffers(PerThreadCommandBuffers const&) = delete;
+		PerThreadCommandBuffers(PerThreadCommandBuffers&&) noexcept = delete;
+		PerThreadCommandBuffers& operator=(PerThreadCommandBuffers const&) = delete;
+		PerThreadCommandBuffers& operator=(PerThreadCommandBuffers&&) noexcept = delete;
+	};
+
+
+	template<typename T, typename... Args>
+	inline void PerThreadCommandBuffers::Enqueue(uint8_t bufferIdx, uint64_t sortKey, Args&&... args)
+	{
+		GetProducer().m_commandBuffers[bufferIdx]->EnqueueWithSortKey<T>(sortKey, std::forward<Args>(args)...);
+	}
+
+
+	/******************************************************************************************************************/
+
+
 	// Wraps a lambda in a command function for convenience
 	class LambdaCommandWrapper final
 	{
@@ -147,11 +333,20 @@ namespace core
 	class CommandManager final
 	{
 	public:
-		CommandManager(size_t bufferAllocationSize);
+		CommandManager(size_t bufferAllocationSize, CommandRecordingMode = CommandRecordingMode::SharedBuffer);
 
 		template<typename T, typename... Args>
 		void Enqueue(Args&&... args);
 
+		// CommandRecordingMode::PerThread only: Commands execute in ascending sort key order, with ties broken by
+		// producer thread and then enqueue order. Enqueue() uses a sort key of 0.
+		// Threads are ordered by when they first recorded a command in this process, which depends on scheduling. The
+		// order of equal sort keys from different threads is therefore consistent between frames and managers, but
+		// can differ between runs. If the execution order must be reproducible across runs (e.g. for replays or
+		// golden image tests), give every command a unique sort key (e.g. encode a stable producer ID in its low bits)
+		template<typename T, typename... Args>
+		void EnqueueWithSortKey(uint64_t sortKey, Args&&... args);
+
 		// Note: This is a convenience helper intended to reduce boilerplate for one-off commands. Avoid use in hot
 		// paths, as std::function will likely use dynamic allocation to hold any captures
 		void Enqueue(std::function<void(void)>&&);
@@ -174,7 +369,10 @@ namespace core
 	private:
 		static constexpr uint8_t k_numBuffers = 2; // Double-buffer our CommandBuffers
 
-		std::array<std::unique_ptr<CommandBuffer>, k_numBuffers> m_commandBuffers;
+		const CommandRecordingMode m_recordingMode;
+
+		std::array<std::unique_ptr<CommandBuffer>, k_numBuffers> m_commandBuffers; // CommandRecordingMode::SharedBuffer
+		std::unique_ptr<PerThreadCommandBuffers> m_perThreadCommandBuffers; // CommandRecordingMode::PerThread
 		mutable std::shared_mutex m_commandBuffersMutex;
 	};
 
@@ -183,7 +381,26 @@ namespace core
 	inline void CommandManager::Enqueue(Args&&... args)
 	{
 		SEBeginCPUEvent("CommandManager::Enqueue");
-		m_commandBuffers[GetWriteIdx()]->Enqueue<T>(std::forward<Args>(args)...);
+		if (m_recordingMode == CommandRecordingMode::PerThread)
+		{
+			m_perThreadCommandBuffers->Enqueue<T>(GetWriteIdx(), 0, std::forward<Args>(args)...);
+		}
+		else
+		{
+			m_commandBuffers[GetWriteIdx()]->Enqueue<T>(std::forward<Args>(args)...);
+		}
+		SEEndCPUEvent();
+	}
+
+
+	template<typename T, typename... Args>
+	inline void CommandManager::EnqueueWithSortKey(uint64_t sortKey, Args&&... args)
+	{
+		SEBeginCPUEvent("CommandManager::EnqueueWithSortKey");
+		SEAssert(m_recordingMode == CommandRecordingMode::PerThread,
+			"Sort keys are only supported by CommandRecordingMode::PerThread");
+
+		m_perThreadCommandBuffers->Enqueue<T>(GetWriteIdx(), sortKey, std::forward<Args>(args)...);
 		SEEndCPUEvent();
 	}
 
@@ -198,6 +415,10 @@ namespace core
 
 	inline bool CommandManager::HasCommandsToExecute() const
 	{
+		if (m_recordingMode == CommandRecordingMode::PerThread)
+		{
+			return m_perThreadCommandBuffers->HasCommandsToExecute(GetReadIdx());
+		}
 		return m_commandBuffers[GetReadIdx()]->HasCommandsToExecute();
 	}
 
@@ -208,11 +429,18 @@ namespace core
 	class FrameIndexedCommandManager final
 	{
 	public:
-		FrameIndexedCommandManager(size_t bufferAllocationSize, uint8_t numFramesInFlight);
+		FrameIndexedCommandManager(
+			size_t bufferAllocationSize,
+			uint8_t numFramesInFlight,
+			CommandRecordingMode = CommandRecordingMode::SharedBuffer);
 
 		template<typename T, typename... Args>
 		void Enqueue(uint64_t frameNum, Args&&... args);
 
+		// CommandRecordingMode::PerThread only. See CommandManager::EnqueueWithSortKey
+		template<typename T, typename... Args>
+		void EnqueueWithSortKey(uint64_t frameNum, uint64_t sortKey, Args&&... args);
+
 		// Note: This is a convenience helper intended to reduce boilerplate for one-off commands. Avoid use in hot
 		// paths, as std::function will likely use dynamic allocation to hold any captures
 		void Enqueue(uint64_t frameNum, std::function<void(void)>&&);
@@ -233,27 +461,47 @@ namespace core
 		uint64_t m_lastExecutedFrameNum;
 
 		uint8_t m_numBuffers; // Number of frames in flight
+
+		const CommandRecordingMode m_recordingMode;
 		
-		std::vector<std::unique_ptr<CommandBuffer>> m_commandBuffers;
+		std::vector<std::unique_ptr<CommandBuffer>> m_commandBuffers; // CommandRecordingMode::SharedBuffer
+		std::unique_ptr<PerThreadCommandBuffers> m_perThreadCommandBuffers; // CommandRecordingMode::PerThread
 		mutable std::mutex m_commandBuffersMutex;
 	};
 
 
 	template<typename T, typename... Args>
 	inline void FrameIndexedCommandManager::Enqueue(uint64_t frameNum, Args&&... args)
+	{
+		EnqueueWithSortKey<T>(frameNum, 0, std::forward<Args>(args)...);
+	}
+
+
+	template<typename T, typename... Args>
+	inline void FrameIndexedCommandManager::EnqueueWithSortKey(uint64_t frameNum, uint64_t sortKey, Args&&... args)
 	{
 		SEBeginCPUEvent("FrameIndexedCommandManager::Enqueue");
 
+		SEAssert(sortKey == 0 || m_recordingMode == CommandRecordingMode::PerThread,
+			"Sort keys are only supported by CommandRecordingMode::PerThread");
+
 		SEAssert(frameNum > m_lastExecutedFrameNum || m_lastExecutedFrameNum == k_invalidFrameNum,
 			"Trying to enqueue for a frame that has already been executed");
 
 		SEAssert(frameNum >= m_lastEnqueuedFrameNum || m_lastEnqueuedFrameNum == k_invalidFrameNum,
 			"Trying to enqueue for a non-monotonically-increasing frame number");
 
-		SEAssert(frameNum == m_lastEnqueuedFrameNum || !m_commandBuffers[GetWriteIdx(frameNum)]->HasCommandsToExecute(),
+		SEAssert(frameNum == m_lastEnqueuedFrameNum || !HasCommandsToExecute(frameNum),
 			"Trying to enqueue work for a new frame, but the buffer still contains old elements");
 
-		m_commandBuffers[GetWriteIdx(frameNum)]->Enqueue<T>(std::forward<Args>(args)...);
+		if (m_recordingMode == CommandRecordingMode::PerThread)
+		{
+			m_perThreadCommandBuffers->Enqueue<T>(GetWriteIdx(frameNum), sortKey, std::forward<Args>(args)...);
+		}
+		else
+		{
+			m_commandBuffers[GetWriteIdx(frameNum)]->Enqueue<T>(std::forward<Args>(args)...);
+		}
 
 		m_lastEnqueuedFrameNum = frameNum;
 
@@ -269,6 +517,10 @@ namespace core
 
 	inline bool FrameIndexedCommandManager::HasCommandsToExecute(uint64_t frameNum) const
 	{
+		if (m_recordingMode == CommandRecordingMode::PerThread)
+		{
+			return m_perThreadCommandBuffers->HasCommandsToExecute(GetReadIdx(frameNum));
+		}
 		return m_commandBuffers[GetReadIdx(frameNum)]->HasCommandsToExecute();
 	}
 
@@ -28,13 +28,16 @@ namespace core::configkeys
 	constexpr char const* k_pixCaptureFolderName		= "PIX Captures";
 	constexpr char const* k_renderDocCaptureFolderName	= "RenderDoc Captures";
 	constexpr char const* k_captureTitle				= "SaberEngine";
+	constexpr char const* k_traceCaptureOutputDir		= ".\\Traces\\";
+	constexpr char const* k_traceCaptureFileExtension	= ".setrace";
 
 	// ImGui:
 	constexpr char const* k_imguiIniPath = "config\\imgui.ini";
 
 	// Logging:
-	constexpr char const* k_logFileName		= "SaberEngine.log";
-	constexpr char const* k_logOutputDir	= ".\\Logs\\";
+	constexpr char const* k_logFileName			= "SaberEngine.log";
+	constexpr char const* k_logOutputDir		= ".\\Logs\\";
+	constexpr char const* k_perfStatsFileName	= "SaberEngine_PerfStats"; // Performance statistics (.csv/.json)
 
 	// JSON parsing:
 	constexpr util::CHashKey k_jsonAllowExceptionsKey	= "JSONAllowExceptions";
@@ -60,8 +63,12 @@ namespace core::configkeys
 	constexpr char const* k_pixGPUProgrammaticCapturesCmdLineArg	= "pixgpucapture";
 	constexpr char const* k_pixCPUProgrammaticCapturesCmdLineArg	= "pixcpucapture";
 	constexpr char const* k_renderDocProgrammaticCapturesCmdLineArg	= "renderdoc";
+	constexpr char const* k_traceCaptureCmdLineArg					= "tracecapture"; // Optional value: No. of frames
+	constexpr char const* k_perfStatsCmdLineArg						= "perfstats"; // Write perf stats on shutdown
 	constexpr char const* k_strictShaderBindingCmdLineArg			= "strictshaderbinding";
 	constexpr char const* k_disableCullingCmdLineArg				= "disableculling";
+	constexpr char const* k_disableIncrementalCullingCmdLineArg		= "disableincrementalculling";
+	constexpr char const* k_hierarchicalTransformUpdateCmdLineArg	= "hierarchicaltransforms"; // Per-root DFS updates
 
 
 	// Config keys:
@@ -8,18 +8,31 @@
 
 namespace core
 {
-	std::vector<EventManager::EventInfo> EventManager::s_eventQueue;
-	std::mutex EventManager::s_eventQueueMutex;
+	util::MPMCQueue<EventManager::EventInfo> EventManager::s_eventQueue(EventManager::k_eventQueueCapacity);
 
-	std::unordered_map<util::CHashKey, std::vector<IEventListener*>> EventManager::s_eventListeners;
-	std::mutex EventManager::s_eventListenersMutex;
+	std::vector<EventManager::EventInfo> EventManager::s_overflowEvents;
+	std::atomic<bool> EventManager::s_hasOverflowEvents = false;
+	std::atomic<uint64_t> EventManager::s_numOverflowEvents = 0;
+	std::mutex EventManager::s_overflowEventsMutex;
+
+	std::vector<EventManager::EventInfo> EventManager::s_eventsToDispatch;
+
+	std::vector<EventManager::Subscription> EventManager::s_subscriptions;
+
+	std::vector<EventManager::Subscription> EventManager::s_newSubscriptions;
+	std::atomic<bool> EventManager::s_hasNewSubscriptions = false;
+	std::mutex EventManager::s_newSubscriptionsMutex;
+
+	std::vector<EventManager::Delivery> EventManager::s_deliveries;
+	std::vector<EventManager::EventInfo const*> EventManager::s_listenerBatch;
 
 
 	void EventManager::Startup()
 	{
 		LOG("Event manager starting...");
 
-		s_eventQueue.reserve(1024); // Just a wild guess; we clear this each frame
+		s_eventsToDispatch.reserve(1024); // Just a wild guess; we clear this each frame
+		s_deliveries.reserve(1024);
 	}
 
 
@@ -35,20 +48,107 @@ namespace core
 	{
 		platform::EventManager::ProcessMessages();
 
+		UpdateSubscriptions();
+
+		// Drain the ring buffer. We only take what was posted before we started, so a producer that keeps posting
+		// can't keep us here forever
+		const size_t maxEventsToDrain = s_eventQueue.Capacity();
+		EventInfo eventInfo;
+		while (s_eventsToDispatch.size() < maxEventsToDrain && s_eventQueue.TryDequeue(eventInfo))
 		{
-			std::scoped_lock lock(s_eventQueueMutex, s_eventListenersMutex);
+			s_eventsToDispatch.emplace_back(std::move(eventInfo));
+		}
 
-			for (auto const& curEvent : s_eventQueue)
+		if (s_hasOverflowEvents.load(std::memory_order_acquire))
+		{
+			std::lock_guard<std::mutex> lock(s_overflowEventsMutex);
+
+			for (EventInfo& overflowEvent : s_overflowEvents)
 			{
-				if (s_eventListeners.contains(curEvent.m_eventKey))
+				s_eventsToDispatch.emplace_back(std::move(overflowEvent));
+			}
+			s_overflowEvents.clear();
+			s_hasOverflowEvents.store(false, std::memory_order_release);
+		}
+
+		DispatchEvents();
+
+		s_eventsToDispatch.clear();
+	}
+
+
+	void EventManager::UpdateSubscriptions()
+	{
+		if (!s_hasNewSubscriptions.load(std::memory_order_acquire))
+		{
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(s_newSubscriptionsMutex);
+
+			s_subscriptions.insert(s_subscriptions.end(), s_newSubscriptions.begin(), s_newSubscriptions.end());
+			s_newSubscriptions.clear();
+			s_hasNewSubscriptions.store(false, std::memory_order_release);
+		}
+
+		// Stable: Listeners of the same event receive it in the order they subscribed
+		std::stable_sort(s_subscriptions.begin(), s_subscriptions.end(),
+			[](Subscription const& lhs, Subscription const& rhs)
+			{
+				return lhs.m_eventKey < rhs.m_eventKey;
+			});
+	}
+
+
+	void EventManager::DispatchEvents()
+	{
+		if (s_eventsToDispatch.empty() || s_subscriptions.empty())
+		{
+			return;
+		}
+
+		// Gather (listener, event) pairs in event order:
+		s_deliveries.clear();
+		for (EventInfo const& curEvent : s_eventsToDispatch)
+		{
+			auto subscriptionItr = std::lower_bound(s_subscriptions.begin(), s_subscriptions.end(), curEvent.m_eventKey,
+				[](Subscription const& subscription, util::CHashKey const& eventKey)
 				{
-					for (auto& listener : s_eventListeners.at(curEvent.m_eventKey))
-					{
-						listener->PostEvent(curEvent);
-					}
-				}
+					return subscription.m_eventKey < eventKey;
+				});
+
+			while (subscriptionItr != s_subscriptions.end() && subscriptionItr->m_eventKey == curEvent.m_eventKey)
+			{
+				s_deliveries.emplace_back(Delivery{
+					.m_listener = subscriptionItr->m_listener,
+					.m_eventInfo = &curEvent,
+				});
+				++subscriptionItr;
 			}
-			s_eventQueue.clear();
+		}
+
+		// Group by listener. Stable: Each listener still receives its events in the order they were posted
+		std::stable_sort(s_deliveries.begin(), s_deliveries.end(),
+			[](Delivery const& lhs, Delivery const& rhs)
+			{
+				return lhs.m_listener < rhs.m_listener;
+			});
+
+		// Deliver a single batch per listener:
+		auto deliveryItr = s_deliveries.begin();
+		while (deliveryItr != s_deliveries.end())
+		{
+			IEventListener* listener = deliveryItr->m_listener;
+
+			s_listenerBatch.clear();
+			while (deliveryItr != s_deliveries.end() && deliveryItr->m_listener == listener)
+			{
+				s_listenerBatch.emplace_back(deliveryItr->m_eventInfo);
+				++deliveryItr;
+			}
+
+			listener->PostEvents(s_listenerBatch);
 		}
 	}
 
@@ -56,19 +156,38 @@ namespace core
 	void EventManager::Subscribe(util::CHashKey const& eventType, IEventListener* listener)
 	{
 		{
-			std::lock_guard<std::mutex> lock(s_eventListenersMutex);
+			std::lock_guard<std::mutex> lock(s_newSubscriptionsMutex);
 
-			s_eventListeners[eventType].emplace_back(listener);
+			s_newSubscriptions.emplace_back(Subscription{
+				.m_eventKey = eventType,
+				.m_listener = listener,
+			});
+			s_hasNewSubscriptions.store(true, std::memory_order_release);
 		}
 	}
 
 
 	void EventManager::Notify(EventInfo&& eventInfo)
 	{
+		// Once we've spilled, keep spilling until the next Update() so we don't reorder this thread's events any more
+		// than necessary
+		if (!s_hasOverflowEvents.load(std::memory_order_acquire) && s_eventQueue.TryEnqueue(std::move(eventInfo)))
+		{
+			return;
+		}
+
 		{
-			std::lock_guard<std::mutex> lock(s_eventQueueMutex);
+			std::lock_guard<std::mutex> lock(s_overflowEventsMutex);
 
-			s_eventQueue.emplace_back(std::move(eventInfo));
+			s_overflowEvents.emplace_back(std::move(eventInfo));
+			s_hasOverflowEvents.store(true, std::memory_order_release);
 		}
+		s_numOverflowEvents.fetch_add(1, std::memory_order_relaxed);
+	}
+
+
+	uint64_t EventManager::GetNumOverflowEvents()
+	{
+		return s_numOverflowEvents.load(std::memory_order_relaxed);
 	}
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 //  2022 Adam Badke. All rights reserved.
 #pragma once
 #include "Util/CHashKey.h"
+#include "Util/MPMCQueue.h"
 
 
 namespace core
@@ -47,13 +48,46 @@ namespace core
 		static void Subscribe(util::CHashKey const& eventType, IEventListener* listener); // Subscribe to an event
 		static void Notify(EventInfo&&); // Post an event
 
+		static uint64_t GetNumOverflowEvents(); // Total events that spilled out of the ring buffer. Thread safe
+
+
+	private:
+		static void UpdateSubscriptions(); // Rebuilds the subscription table, if required
+		static void DispatchEvents();
+
 
 	private:
-		static std::vector<EventInfo> s_eventQueue;
-		static std::mutex s_eventQueueMutex;
+		// Notify() posts into a bounded lock-free ring buffer; If it fills up between Update() calls, events spill into
+		// a locked overflow list. Note: Ordering is only guaranteed for events that don't spill.
+		// Sized for bursts of 100k+ events per frame (~8MB of cells), so spilling is the exception
+		static constexpr size_t k_eventQueueCapacity = 131072;
+		static util::MPMCQueue<EventInfo> s_eventQueue;
+
+		static std::vector<EventInfo> s_overflowEvents;
+		static std::atomic<bool> s_hasOverflowEvents;
+		static std::atomic<uint64_t> s_numOverflowEvents;
+		static std::mutex s_overflowEventsMutex;
+
+		static std::vector<EventInfo> s_eventsToDispatch; // Update() thread only. Reused every frame
 
-		static std::unordered_map<util::CHashKey, std::vector<IEventListener*>> s_eventListeners;
-		static std::mutex s_eventListenersMutex;
+		struct Subscription
+		{
+			util::CHashKey m_eventKey;
+			IEventListener* m_listener;
+		};
+		static std::vector<Subscription> s_subscriptions; // Sorted by event key. Update() thread only
+
+		static std::vector<Subscription> s_newSubscriptions;
+		static std::atomic<bool> s_hasNewSubscriptions;
+		static std::mutex s_newSubscriptionsMutex;
+
+		struct Delivery
+		{
+			IEventListener* m_listener;
+			EventInfo const* m_eventInfo;
+		};
+		static std::vector<Delivery> s_deliveries; // Update() thread only. Reused every frame
+		static std::vector<EventInfo const*> s_listenerBatch; // Update() thread only. Reused every frame
 
 
 	private: // Pure static only:
@@ -1,5 +1,6 @@
 //  2022 Adam Badke. All rights reserved.
 #pragma once
+#include "../Assert.h"
 #include "../EventManager.h"
 
 
@@ -17,6 +18,7 @@ namespace core
 
 	public:
 		void PostEvent(core::EventManager::EventInfo const& eventInfo);
+		void PostEvents(std::vector<core::EventManager::EventInfo const*> const& eventInfos); // Single lock per batch
 
 
 	protected:		
@@ -25,7 +27,10 @@ namespace core
 
 
 	private:
-		std::queue<core::EventManager::EventInfo> m_events;
+		// We consume from the front without erasing, and clear once everything has been read. This keeps the
+		// allocation alive between frames
+		std::vector<core::EventManager::EventInfo> m_events;
+		size_t m_nextEventIdx = 0;
 		mutable std::shared_mutex m_eventsMutex;
 	};
 
@@ -34,7 +39,19 @@ namespace core
 	{
 		{
 			std::unique_lock<std::shared_mutex> writeLock(m_eventsMutex);
-			m_events.emplace(eventInfo);
+			m_events.emplace_back(eventInfo);
+		}
+	}
+
+
+	inline void IEventListener::PostEvents(std::vector<core::EventManager::EventInfo const*> const& eventInfos)
+	{
+		{
+			std::unique_lock<std::shared_mutex> writeLock(m_eventsMutex);
+			for (core::EventManager::EventInfo const* eventInfo : eventInfos)
+			{
+				m_events.emplace_back(*eventInfo);
+			}
 		}
 	}
 
@@ -43,7 +60,7 @@ namespace core
 	{
 		{
 			std::shared_lock<std::shared_mutex> readLock(m_eventsMutex);
-			return !m_events.empty();
+			return m_nextEventIdx < m_events.size();
 		}
 	}
 
@@ -52,8 +69,14 @@ namespace core
 	{
 		{
 			std::unique_lock<std::shared_mutex> writeLock(m_eventsMutex);
-			core::EventManager::EventInfo nextEvent = m_events.front();
-			m_events.pop();
+			SEAssert(m_nextEventIdx < m_events.size(), "No events to get");
+
+			core::EventManager::EventInfo nextEvent = std::move(m_events[m_nextEventIdx++]);
+			if (m_nextEventIdx == m_events.size())
+			{
+				m_events.clear();
+				m_nextEventIdx = 0;
+			}
 			return nextEvent;
 		}
 	}
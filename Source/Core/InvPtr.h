@@ -180,9 +180,10 @@ namespace core
 	{
 		InvPtr<T> newInvPtr(control);
 
-		// If we're in the Empty state, kick off an asyncronous loading job:
+		// If we're in the Empty state, kick off an asyncronous loading job. We hold the resource in the Loading state
+		// until its load context has been initialized, so no other thread can steal the load before then:
 		core::ResourceState expected = core::ResourceState::Empty;
-		if (newInvPtr.m_control->m_state.compare_exchange_strong(expected, core::ResourceState::Requested,
+		if (newInvPtr.m_control->m_state.compare_exchange_strong(expected, core::ResourceState::Loading,
 			std::memory_order_acq_rel, std::memory_order_acquire))
 		{
 			SEAssert(newInvPtr.m_control->m_loadContext != nullptr,
@@ -195,6 +196,10 @@ namespace core
 			// require it before the creation can possibly have finished
 			std::dynamic_pointer_cast<ILoadContext<T>>(newInvPtr.m_control->m_loadContext)->CallOnLoadBegin();
 
+			// Now the load can be stolen: Wake any threads that dereferenced the InvPtr while we were setting up
+			newInvPtr.m_control->m_state.store(core::ResourceState::Requested, std::memory_order_release);
+			newInvPtr.m_control->m_state.notify_all();
+
 			core::ThreadPool::EnqueueJob([newInvPtr]()
 				{
 					newInvPtr.TryToLoad();
@@ -260,9 +265,16 @@ namespace core
 			return m_objectCache;
 		}
 
-		TryToLoad(); // Check if we can steal the work
+		// Check if we can steal the work, and block until the resource is loaded. The resource is also Loading while
+		// Create() is setting up its load, after which it is Requested again and the work can be stolen
+		core::ResourceState state = m_control->m_state.load(std::memory_order_acquire);
+		while (state == ResourceState::Requested || state == ResourceState::Loading)
+		{
+			TryToLoad();
 
-		m_control->m_state.wait(ResourceState::Loading); // Block until the resource is loaded
+			m_control->m_state.wait(ResourceState::Loading, std::memory_order_acquire);
+			state = m_control->m_state.load(std::memory_order_acquire);
+		}
 		SEAssert(IsValid() && m_control->m_object && m_control->m_object->get(), "InvPtr is invalid after loading");
 		
 		// Update this object's local cache of the object pointer, now that loading has finished:
@@ -6,18 +6,22 @@
 
 namespace core
 {
-	std::unordered_map<std::type_index, std::unique_ptr<IResourceSystem>> Inventory::s_resourceSystems;
-	std::shared_mutex Inventory::s_resourceSystemsMutex;
+	std::vector<Inventory::ResourceSystemRecord> Inventory::s_resourceSystems;
+	std::mutex Inventory::s_resourceSystemsMutex;
 
 
 	void Inventory::Destroy(AccessKey)
 	{
 		{
-			std::lock_guard<std::shared_mutex> lock(s_resourceSystemsMutex);
+			std::lock_guard<std::mutex> lock(s_resourceSystemsMutex);
 
 			for (auto& resourceSystem : s_resourceSystems)
 			{
-				resourceSystem.second->Destroy();
+				resourceSystem.m_resourceSystem->Destroy();
+			}
+			for (auto& resourceSystem : s_resourceSystems)
+			{
+				resourceSystem.m_clearSlot();
 			}
 			s_resourceSystems.clear();
 		}
@@ -29,11 +33,11 @@ namespace core
 		SEBeginCPUEvent("Inventory::OnEndOfFrame");
 
 		{
-			std::lock_guard<std::shared_mutex> lock(s_resourceSystemsMutex);
+			std::lock_guard<std::mutex> lock(s_resourceSystemsMutex);
 
 			for (auto& resourceSystem : s_resourceSystems)
 			{
-				resourceSystem.second->OnEndOfFrame();
+				resourceSystem.m_resourceSystem->OnEndOfFrame();
 			}
 		}
 
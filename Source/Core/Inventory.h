@@ -36,10 +36,23 @@ namespace core
 		template<typename T>
 		static ResourceSystem<T>* GetCreateResourceSystem();
 
+		template<typename T>
+		static ResourceSystem<T>* GetResourceSystem(); // Returns null if the ResourceSystem has not been created
+
 
 	private:
-		static std::unordered_map<std::type_index, std::unique_ptr<IResourceSystem>> s_resourceSystems;
-		static std::shared_mutex s_resourceSystemsMutex;
+		// Each type has its own compile-time slot, so lookups are a single atomic load: No type map or casting needed.
+		// The slots are populated once, and cleared when the Inventory is destroyed
+		template<typename T>
+		static std::atomic<ResourceSystem<T>*> s_resourceSystem;
+
+		struct ResourceSystemRecord
+		{
+			std::unique_ptr<IResourceSystem> m_resourceSystem;
+			void(*m_clearSlot)(); // Resets the s_resourceSystem<T> slot for the ResourceSystem's type
+		};
+		static std::vector<ResourceSystemRecord> s_resourceSystems; // For iteration/ownership only
+		static std::mutex s_resourceSystemsMutex;
 
 
 	private:
@@ -64,21 +77,13 @@ namespace core
 
 
 	template<typename T>
-	bool Inventory::HasLoaded(util::HashKey ID)
-	{
-		const std::type_index typeIdx = std::type_index(typeid(T));
+	std::atomic<ResourceSystem<T>*> Inventory::s_resourceSystem = nullptr;
 
-		ResourceSystem<T> const* resourceSystem = nullptr;
 
-		{
-			std::shared_lock readLock(s_resourceSystemsMutex);
-
-			auto iResourceSystemItr = s_resourceSystems.find(typeIdx);
-			if (iResourceSystemItr != s_resourceSystems.end())
-			{
-				resourceSystem = dynamic_cast<ResourceSystem<T> const*>(iResourceSystemItr->second.get());
-			}
-		}
+	template<typename T>
+	bool Inventory::HasLoaded(util::HashKey ID)
+	{
+		ResourceSystem<T> const* resourceSystem = GetResourceSystem<T>();
 
 		return resourceSystem != nullptr && resourceSystem->HasLoaded(ID);
 	}
@@ -87,60 +92,38 @@ namespace core
 	template<typename T>
 	bool Inventory::Has(util::HashKey ID)
 	{
-		const std::type_index typeIdx = std::type_index(typeid(T));
+		ResourceSystem<T> const* resourceSystem = GetResourceSystem<T>();
 
-		ResourceSystem<T> const* resourceSystem = nullptr;
-
-		{
-			std::shared_lock readLock(s_resourceSystemsMutex);
+		return resourceSystem != nullptr && resourceSystem->Has(ID);
+	}
 
-			auto iResourceSystemItr = s_resourceSystems.find(typeIdx);
-			if (iResourceSystemItr != s_resourceSystems.end())
-			{
-				resourceSystem = dynamic_cast<ResourceSystem<T> const*>(iResourceSystemItr->second.get());
-			}
-		}
 
-		return resourceSystem != nullptr && resourceSystem->Has(ID);
+	template<typename T>
+	ResourceSystem<T>* Inventory::GetResourceSystem()
+	{
+		return s_resourceSystem<T>.load(std::memory_order_acquire);
 	}
 
 
 	template<typename T>
 	ResourceSystem<T>* Inventory::GetCreateResourceSystem()
 	{
-		ResourceSystem<T>* resourceSystem = nullptr;
-
-		const std::type_index typeIdx = std::type_index(typeid(T));
+		ResourceSystem<T>* resourceSystem = GetResourceSystem<T>();
+		if (resourceSystem == nullptr)
 		{
-			std::shared_lock readLock(s_resourceSystemsMutex);
+			std::lock_guard<std::mutex> lock(s_resourceSystemsMutex);
 
-			auto iResourceSystemItr = s_resourceSystems.find(typeIdx);
-			if (iResourceSystemItr == s_resourceSystems.end())
+			resourceSystem = s_resourceSystem<T>.load(std::memory_order_relaxed);
+			if (resourceSystem == nullptr) // It might have been created while we waited
 			{
-				readLock.unlock();
-
-				// Convert to a write lock, and create the ResourceSystem:
-				{
-					std::unique_lock<std::shared_mutex> writeLock(s_resourceSystemsMutex);
-
-					iResourceSystemItr = s_resourceSystems.find(typeIdx);
-					if (iResourceSystemItr == s_resourceSystems.end())
-					{
-						iResourceSystemItr = s_resourceSystems.emplace(
-							typeIdx,
-							new ResourceSystem<T>()).first;
-
-						resourceSystem = dynamic_cast<ResourceSystem<T>*>(iResourceSystemItr->second.get());
-					}
-					else // The ResourceSystem was created while we waited, just get it
-					{
-						resourceSystem = dynamic_cast<ResourceSystem<T>*>(iResourceSystemItr->second.get());
-					}
-				}
-			}
-			else // Otherwise, we still hold the read lock here so get the pointer:
-			{
-				resourceSystem = dynamic_cast<ResourceSystem<T>*>(iResourceSystemItr->second.get());
+				resourceSystem = new ResourceSystem<T>();
+
+				s_resourceSystems.emplace_back(ResourceSystemRecord{
+					.m_resourceSystem = std::unique_ptr<IResourceSystem>(resourceSystem),
+					.m_clearSlot = []() { s_resourceSystem<T>.store(nullptr, std::memory_order_release); },
+					});
+
+				s_resourceSystem<T>.store(resourceSystem, std::memory_order_release);
 			}
 		}
 		SEAssert(resourceSystem, "Failed to find or create a ResourceSystem");
@@ -186,20 +186,190 @@ namespace
 			ImGui::End();
 		}
 	};
+
+
+	// Single-producer/single-consumer ring of variable-length log records. Each producer thread owns one, and the
+	// logger thread consumes from all of them
+	class LogRing final
+	{
+	public:
+		static constexpr uint32_t k_capacity = 128 * 1024; // Must be a power of 2
+		static constexpr uint32_t k_recordAlignment = 32; // Guarantees padding records are large enough for a header
+
+
+	public:
+		LogRing()
+			: m_buffer(std::make_unique<uint64_t[]>(k_capacity / sizeof(uint64_t)))
+			, m_head(0)
+			, m_tail(0)
+			, m_hasOwner(true)
+		{
+		}
+
+
+		uint8_t* Data() { return reinterpret_cast<uint8_t*>(m_buffer.get()); }
+
+
+		// Producer: Returns a pointer to recordByteSize bytes, or nullptr if the ring is full
+		uint8_t* TryReserve(uint32_t recordByteSize, uint32_t& reservedByteSizeOut)
+		{
+			const uint64_t tail = m_tail.load(std::memory_order_relaxed);
+			const uint32_t offset = static_cast<uint32_t>(tail & (k_capacity - 1));
+
+			// Records are contiguous: If we don't fit before the end of the ring, pad the remainder and wrap around
+			const uint32_t paddingByteSize = (offset + recordByteSize > k_capacity) ? k_capacity - offset : 0;
+			const uint32_t totalByteSize = paddingByteSize + recordByteSize;
+
+			if (tail + totalByteSize - m_head.load(std::memory_order_acquire) > k_capacity)
+			{
+				return nullptr;
+			}
+
+			if (paddingByteSize > 0)
+			{
+				core::Logger::RecordHeader* padding = reinterpret_cast<core::Logger::RecordHeader*>(Data() + offset);
+				padding->FormatRecord = nullptr;
+				padding->m_byteSize = paddingByteSize;
+			}
+
+			reservedByteSizeOut = totalByteSize;
+			return Data() + ((offset + paddingByteSize) & (k_capacity - 1));
+		}
+
+
+		void Commit(uint32_t reservedByteSize) // Producer
+		{
+			m_tail.store(m_tail.load(std::memory_order_relaxed) + reservedByteSize, std::memory_order_release);
+		}
+
+
+		// Consumer: Returns the next (non-padding) record, or nullptr if the ring is empty
+		core::Logger::RecordHeader const* Peek()
+		{
+			const uint64_t tail = m_tail.load(std::memory_order_acquire);
+			uint64_t head = m_head.load(std::memory_order_relaxed);
+			while (head < tail)
+			{
+				core::Logger::RecordHeader const* record =
+					reinterpret_cast<core::Logger::RecordHeader const*>(Data() + (head & (k_capacity - 1)));
+				if (record->FormatRecord != nullptr)
+				{
+					return record;
+				}
+
+				head += record->m_byteSize; // Skip padding
+				m_head.store(head, std::memory_order_release);
+			}
+			return nullptr;
+		}
+
+
+		void Pop(core::Logger::RecordHeader const* record) // Consumer
+		{
+			m_head.store(m_head.load(std::memory_order_relaxed) + record->m_byteSize, std::memory_order_release);
+		}
+
+
+		bool IsEmpty() const
+		{
+			return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+		}
+
+
+	public:
+		uint32_t m_pendingByteSize = 0; // Producer only: Reserved, but not yet committed
+
+
+	private:
+		std::unique_ptr<uint64_t[]> m_buffer;
+
+		alignas(64) std::atomic<uint64_t> m_head;
+		alignas(64) std::atomic<uint64_t> m_tail;
+
+
+	public:
+		alignas(64) std::atomic<bool> m_hasOwner; // Rings are recycled once their thread exits and they're drained
+	};
+
+
+	// Rings are never destroyed (their threads may outlive us), so the logger thread can read this without locking
+	constexpr uint32_t k_maxLogRings = 256;
+	std::array<std::atomic<LogRing*>, k_maxLogRings> s_logRings{};
+	std::atomic<uint32_t> s_numLogRings = 0;
+	std::mutex s_logRingRegistrationMutex;
+
+
+	struct ThreadLogRing
+	{
+		LogRing* m_ring = nullptr;
+
+		~ThreadLogRing()
+		{
+			if (m_ring)
+			{
+				m_ring->m_hasOwner.store(false, std::memory_order_release);
+			}
+		}
+	};
+	thread_local ThreadLogRing s_threadLogRing;
+
+
+	LogRing* GetThreadLogRing()
+	{
+		if (s_threadLogRing.m_ring != nullptr)
+		{
+			return s_threadLogRing.m_ring;
+		}
+
+		// First record from this thread: Recycle a drained ring from an exited thread, or register a new one
+		std::lock_guard<std::mutex> lock(s_logRingRegistrationMutex);
+
+		const uint32_t numLogRings = s_numLogRings.load(std::memory_order_relaxed);
+		for (uint32_t ringIdx = 0; ringIdx < numLogRings; ++ringIdx)
+		{
+			LogRing* ring = s_logRings[ringIdx].load(std::memory_order_relaxed);
+			if (!ring->m_hasOwner.load(std::memory_order_acquire) && ring->IsEmpty())
+			{
+				ring->m_hasOwner.store(true, std::memory_order_relaxed);
+				s_threadLogRing.m_ring = ring;
+				return ring;
+			}
+		}
+
+		if (numLogRings == k_maxLogRings)
+		{
+			return nullptr;
+		}
+
+		LogRing* newRing = new LogRing();
+		s_logRings[numLogRings].store(newRing, std::memory_order_relaxed);
+		s_numLogRings.store(numLogRings + 1, std::memory_order_release);
+
+		s_threadLogRing.m_ring = newRing;
+		return newRing;
+	}
+
+
+	// Logger thread only: Formatted messages are batched here, and written out in one go
+	constexpr size_t k_writeBufferSize = 64 * 1024;
+	std::array<char, k_writeBufferSize> s_writeBuffer;
 }
 
 
 namespace core
 {
 	std::unique_ptr<ImGuiLogWindow> Logger::s_imGuiLogWindow = nullptr;
-	bool Logger::s_isRunning = false;
+	std::atomic<bool> Logger::s_isRunning = false;
+	std::atomic<bool> Logger::s_loggerThreadIsRunning = false;
 	bool Logger::s_showHostConsole = false;
 
-	std::queue<std::array<char, Logger::k_internalStagingBufferSize>> Logger::s_messages;
-	std::mutex Logger::s_messagesMutex;
-	std::condition_variable Logger::s_messagesCV;
+	std::atomic<uint64_t> Logger::s_messageEpoch = 0;
+	std::atomic<bool> Logger::s_loggerIsSleeping = false;
+
+	std::atomic<uint64_t> Logger::s_nextSequenceNum = 0;
+	std::atomic<uint32_t> Logger::s_numDroppedMessages = 0;
 
-	std::ofstream Logger::s_logOutputStream;
+	std::FILE* Logger::s_logOutputStream = nullptr;
 
 
 	// ---
@@ -209,11 +379,19 @@ namespace core
 	{
 		LOG("Log manager starting...");
 
-		s_isRunning = true; // Start running *before* we kick off a thread
 		s_showHostConsole = isSystemConsoleWindowEnabled;
 
 		s_imGuiLogWindow = std::make_unique<ImGuiLogWindow>();
 
+		std::filesystem::create_directory(core::configkeys::k_logOutputDir); // No error if the directory already exists
+
+		s_logOutputStream = std::fopen(
+			std::format("{}{}", core::configkeys::k_logOutputDir, core::configkeys::k_logFileName).c_str(), "w");
+		assert(s_logOutputStream && "Error creating log output stream");
+
+		s_isRunning = true; // Start running *before* we kick off a thread
+		s_loggerThreadIsRunning = true;
+
 		core::ThreadPool::EnqueueJob([]()
 			{
 				core::ThreadPool::NameCurrentThread(L"Logger Thread");
@@ -227,74 +405,127 @@ namespace core
 		LOG("Log manager shutting down...");
 		s_isRunning = false;
 
-		FlushMessages(); // Flush any remaining messages on the queue
+		// Wake the logger thread, and wait for it to exit
+		s_messageEpoch.fetch_add(1);
+		s_messageEpoch.notify_all();
+		s_loggerThreadIsRunning.wait(true);
+
+		FlushMessages(); // Flush any remaining messages in the rings
+
+		std::fclose(s_logOutputStream);
+		s_logOutputStream = nullptr;
 
-		s_logOutputStream.close();
 		s_imGuiLogWindow = nullptr;
 	}
 
 
-	void Logger::PrintMessage(char const* msg)
+	void Logger::PrintMessages(char const* msgs, size_t numChars)
 	{
-		s_imGuiLogWindow->AddLog(msg);
+		if (numChars == 0)
+		{
+			return;
+		}
 
-		// Print the message to the terminal. Note: We might get different ordering since s_imGuiLogWindow
-		// internally locks a mutex before appending the new message
+		s_imGuiLogWindow->AddLog("%s", msgs);
+
+		// Print the messages to the terminal. Note: We might get different ordering since s_imGuiLogWindow
+		// internally locks a mutex before appending the new messages
 		if (s_showHostConsole)
 		{
-			std::fputs(msg, stdout);
+			std::fwrite(msgs, sizeof(char), numChars, stdout);
 		}
 
-		s_logOutputStream << msg;
-		s_logOutputStream.flush(); // Flush every time to keep the log up to date
+		std::fwrite(msgs, sizeof(char), numChars, s_logOutputStream);
+		std::fflush(s_logOutputStream); // Flush every batch to keep the log up to date
 	};
 
 
-	void Logger::FlushMessages()
+	bool Logger::ProcessRecords()
 	{
-		assert(!s_isRunning && "Flushing messages while running. This is unexpected");
+		size_t numBufferedChars = 0;
+		bool processedRecords = false;
 
+		const uint32_t numDroppedMessages = s_numDroppedMessages.exchange(0);
+		if (numDroppedMessages > 0)
 		{
-			std::unique_lock<std::mutex> modifyLock(s_messagesMutex);
+			numBufferedChars += static_cast<size_t>(snprintf(s_writeBuffer.data(), s_writeBuffer.size(),
+				"%s%u log messages were dropped\n", logging::k_warnPrefix, numDroppedMessages));
+		}
 
-			while (!s_messages.empty())
+		const uint32_t numLogRings = s_numLogRings.load(std::memory_order_acquire);
+		while (true)
+		{
+			// Merge the rings: Take the oldest record at the head of any ring
+			LogRing* nextRing = nullptr;
+			RecordHeader const* nextRecord = nullptr;
+			for (uint32_t ringIdx = 0; ringIdx < numLogRings; ++ringIdx)
 			{
-				PrintMessage(s_messages.front().data());
-				s_messages.pop();
+				LogRing* ring = s_logRings[ringIdx].load(std::memory_order_relaxed);
+				RecordHeader const* record = ring->Peek();
+				if (record && (nextRecord == nullptr || record->m_sequenceNum < nextRecord->m_sequenceNum))
+				{
+					nextRing = ring;
+					nextRecord = record;
+				}
 			}
+			if (nextRecord == nullptr)
+			{
+				break;
+			}
+
+			if (s_writeBuffer.size() - numBufferedChars < k_internalStagingBufferSize)
+			{
+				PrintMessages(s_writeBuffer.data(), numBufferedChars);
+				numBufferedChars = 0;
+			}
+
+			numBufferedChars += nextRecord->FormatRecord(
+				reinterpret_cast<uint8_t const*>(nextRecord) + sizeof(RecordHeader),
+				nextRecord->m_logType,
+				s_writeBuffer.data() + numBufferedChars,
+				s_writeBuffer.size() - numBufferedChars);
+
+			nextRing->Pop(nextRecord);
+			processedRecords = true;
 		}
+
+		PrintMessages(s_writeBuffer.data(), numBufferedChars);
+
+		return processedRecords;
 	}
 
 
-	void Logger::Run()
+	void Logger::FlushMessages()
 	{
-		std::filesystem::create_directory(core::configkeys::k_logOutputDir); // No error if the directory already exists
+		assert(!s_isRunning && !s_loggerThreadIsRunning && "Flushing messages while running. This is unexpected");
 
-		s_logOutputStream.open(
-			std::format("{}{}", core::configkeys::k_logOutputDir, core::configkeys::k_logFileName).c_str(),
-			std::ios::out);
-		assert(s_logOutputStream.good() && "Error creating log output stream");
+		ProcessRecords();
+	}
 
-		std::array<char, Logger::k_internalStagingBufferSize> messageBuffer{ '\0' };
 
-		while (s_isRunning)
+	void Logger::Run()
+	{
+		while (s_isRunning.load(std::memory_order_acquire))
 		{
-			std::unique_lock<std::mutex> waitingLock(s_messagesMutex);
-			s_messagesCV.wait(waitingLock,
-				[]() { return !s_messages.empty() || !s_isRunning; }); // while (!stop_waiting())
-			if (!s_isRunning)
+			const uint64_t currentEpoch = s_messageEpoch.load();
+
+			if (ProcessRecords())
 			{
-				return;
+				continue;
 			}
 
-			// Copy the front message into the intermediate buffer, then release the lock so more messages can be added
-			strcpy(messageBuffer.data(), s_messages.front().data());
-			s_messages.pop();
-
-			waitingLock.unlock();
-
-			PrintMessage(messageBuffer.data());
+			// Nothing to do: Sleep until a producer bumps the epoch. We re-check the rings after announcing that we're
+			// sleeping, so a record committed in between can't be missed
+			s_loggerIsSleeping.store(true);
+			if (!ProcessRecords() && s_isRunning.load())
+			{
+				s_messageEpoch.wait(currentEpoch);
+			}
+			s_loggerIsSleeping.store(false);
 		}
+
+		s_loggerThreadIsRunning.store(false);
+		s_loggerThreadIsRunning.notify_all();
 	}
 
 
@@ -312,13 +543,63 @@ namespace core
 	}
 
 
-	void Logger::AddMessage(char const* msg)
+	uint8_t* Logger::BeginRecord(uint32_t payloadByteSize, LogType logType, FormatRecordFn formatRecord)
+	{
+		LogRing* ring = GetThreadLogRing();
+
+		const uint32_t recordByteSize =
+			loginternal::AlignUp(static_cast<uint32_t>(sizeof(RecordHeader)) + payloadByteSize, LogRing::k_recordAlignment);
+
+		if (ring == nullptr || recordByteSize > LogRing::k_capacity / 2)
+		{
+			assert(ring != nullptr && "Too many threads are logging");
+			assert(recordByteSize <= LogRing::k_capacity / 2 && "Log record is too large");
+
+			s_numDroppedMessages.fetch_add(1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		uint32_t reservedByteSize = 0;
+		uint8_t* record = ring->TryReserve(recordByteSize, reservedByteSize);
+		while (record == nullptr)
+		{
+			// The ring is full. If there is no logger thread to drain it, we have no choice but to drop the message
+			if (!s_loggerThreadIsRunning.load(std::memory_order_acquire))
+			{
+				s_numDroppedMessages.fetch_add(1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			s_messageEpoch.fetch_add(1);
+			s_messageEpoch.notify_one();
+			std::this_thread::yield();
+
+			record = ring->TryReserve(recordByteSize, reservedByteSize);
+		}
+		ring->m_pendingByteSize = reservedByteSize;
+
+		// Note: The sequence number is assigned once we have space, so that a blocked producer doesn't stall the merge
+		RecordHeader* header = reinterpret_cast<RecordHeader*>(record);
+		header->m_sequenceNum = s_nextSequenceNum.fetch_add(1, std::memory_order_relaxed);
+		header->FormatRecord = formatRecord;
+		header->m_byteSize = recordByteSize;
+		header->m_logType = logType;
+
+		return record + sizeof(RecordHeader);
+	}
+
+
+	void Logger::CommitRecord()
 	{
+		LogRing* ring = s_threadLogRing.m_ring;
+
+		ring->Commit(ring->m_pendingByteSize);
+		ring->m_pendingByteSize = 0;
+
+		s_messageEpoch.fetch_add(1);
+		if (s_loggerIsSleeping.load())
 		{
-			std::unique_lock<std::mutex> lock(s_messagesMutex);
-			s_messages.emplace();
-			strcpy(s_messages.back().data(), msg);
+			s_messageEpoch.notify_one();
 		}
-		s_messagesCV.notify_one();
 	}
 }
\ No newline at end of file
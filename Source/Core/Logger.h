@@ -5,9 +5,59 @@
 #include "Util/TextUtils.h"
 
 
+// Compile-time log filtering: Messages below SE_LOG_LEVEL are compiled out entirely (including their arguments)
+#define SE_LOG_LEVEL_LOG		0
+#define SE_LOG_LEVEL_WARNING	1
+#define SE_LOG_LEVEL_ERROR		2
+#define SE_LOG_LEVEL_NONE		3
+
+#if !defined(SE_LOG_LEVEL)
+#define SE_LOG_LEVEL SE_LOG_LEVEL_LOG
+#endif
+
+
 namespace
 {
 	struct ImGuiLogWindow;
+	class LogRing;
+}
+
+namespace loginternal
+{
+	// String arguments are copied into the log record, and replaced with their offset from the start of the payload
+	template<typename CharT>
+	struct DeferredString
+	{
+		uint32_t m_offset;
+	};
+
+
+	template<typename Arg>
+	struct StoredArg
+	{
+		using Type = Arg;
+	};
+	template<> struct StoredArg<char*> { using Type = DeferredString<char>; };
+	template<> struct StoredArg<char const*> { using Type = DeferredString<char>; };
+	template<> struct StoredArg<wchar_t*> { using Type = DeferredString<wchar_t>; };
+	template<> struct StoredArg<wchar_t const*> { using Type = DeferredString<wchar_t>; };
+
+	template<typename Arg>
+	using StoredArg_t = typename StoredArg<std::decay_t<Arg>>::Type;
+
+
+	template<typename Arg>
+	struct IsString : std::false_type {};
+	template<> struct IsString<char*> : std::true_type {};
+	template<> struct IsString<char const*> : std::true_type {};
+	template<> struct IsString<wchar_t*> : std::true_type {};
+	template<> struct IsString<wchar_t const*> : std::true_type {};
+
+
+	constexpr uint32_t AlignUp(uint32_t value, uint32_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
 }
 
 namespace core
@@ -45,24 +95,28 @@ namespace core
 	private:
 		static void Run(); // Logger thread
 
-		static void PrintMessage(char const* msg);
+		static bool ProcessRecords(); // Returns true if any records were processed
+		static void PrintMessages(char const* msgs, size_t numChars);
 		static void FlushMessages();
 
 
 	private:
 		constexpr static uint32_t k_internalStagingBufferSize = 4096;
 
-		static void AddMessage(char const*);
 		static std::unique_ptr<ImGuiLogWindow> s_imGuiLogWindow; // Internally contains a mutex
 
-		static bool s_isRunning;
+		static std::atomic<bool> s_isRunning;
+		static std::atomic<bool> s_loggerThreadIsRunning;
 		static bool s_showHostConsole;
 
-		static std::queue<std::array<char, k_internalStagingBufferSize>> s_messages;
-		static std::mutex s_messagesMutex;
-		static std::condition_variable s_messagesCV;
+		// Producers bump the epoch after every record; The logger thread sleeps on it when there is nothing to do
+		static std::atomic<uint64_t> s_messageEpoch;
+		static std::atomic<bool> s_loggerIsSleeping;
+
+		static std::atomic<uint64_t> s_nextSequenceNum; // Restores the global ordering of records from different threads
+		static std::atomic<uint32_t> s_numDroppedMessages;
 
-		static std::ofstream s_logOutputStream;
+		static std::FILE* s_logOutputStream;
 
 
 	private:
@@ -73,14 +127,57 @@ namespace core
 			Error
 		};
 
-		
+
+	private:
+		// Deferred formatting: Producers copy the format string and the raw arguments into a variable-length record in
+		// their own lock-free ring buffer. The logger thread formats the records, and writes them out in batches
+		using FormatRecordFn = size_t(*)(uint8_t const* payload, LogType, char* destBuffer, size_t destBufferSize);
+
+		struct RecordHeader
+		{
+			uint64_t m_sequenceNum;
+			FormatRecordFn FormatRecord; // nullptr for padding at the end of the ring
+			uint32_t m_byteSize; // Including this header and any padding
+			LogType m_logType;
+		};
+
+		friend class ::LogRing;
+
+		static uint8_t* BeginRecord(uint32_t payloadByteSize, LogType, FormatRecordFn); // Returns nullptr if dropped
+		static void CommitRecord();
+
+
 	private:
 		template<typename T, typename... Args>
 		static void LogInternal(LogType, T const* msg, Args&&... args);
 
+		template<typename T, typename... Args>
+		static size_t FormatRecord(uint8_t const* payload, LogType, char* destBuffer, size_t destBufferSize);
+
+		template<typename T, typename... Args>
+		static void FormatMessage(LogType, T const* msg, T* stagingBuffer, Args const&... args);
+
 		template<typename T>
 		static void InsertMessageAndVariadicArgs(T* buf, uint32_t bufferSize, T const* msg, ...);
 
+		template<typename T, typename StoredArgs>
+		static constexpr uint32_t GetMessageOffset();
+
+		template<typename CharT>
+		static uint32_t GetStringLength(CharT const*); // Clamped to the staging buffer size
+
+		template<typename Arg>
+		static uint32_t GetStringArgByteSize(Arg const&);
+
+		template<typename Arg>
+		static loginternal::StoredArg_t<Arg> StoreArg(Arg const&, uint8_t* payload, uint32_t& stringOffset);
+
+		template<typename Arg>
+		static Arg const& ResolveArg(uint8_t const* payload, Arg const&);
+
+		template<typename CharT>
+		static CharT const* ResolveArg(uint8_t const* payload, loginternal::DeferredString<CharT>);
+
 		template<typename T>
 		static void InsertLogPrefix(
 			T const* alignPrefix,
@@ -150,6 +247,73 @@ namespace core
 
 	template<typename T, typename... Args>
 	inline void Logger::LogInternal(LogType logType, T const* msg, Args&&... args)
+	{
+		// Note: We copy the format string as many callers pass the result of a temporary std::format(...).c_str()
+		using StoredArgs = std::tuple<loginternal::StoredArg_t<Args>...>;
+		constexpr uint32_t k_msgOffset = GetMessageOffset<T, StoredArgs>();
+
+		const uint32_t msgLen = GetStringLength(msg);
+
+		uint32_t payloadByteSize = k_msgOffset + (msgLen + 1) * sizeof(T);
+		((payloadByteSize += GetStringArgByteSize(args)), ...);
+
+		uint8_t* payload = BeginRecord(payloadByteSize, logType, &FormatRecord<T, Args...>);
+		if (payload == nullptr)
+		{
+			return; // Dropped
+		}
+
+		memcpy(payload + k_msgOffset, msg, msgLen * sizeof(T));
+		reinterpret_cast<T*>(payload + k_msgOffset)[msgLen] = T('\0');
+
+		// Note: Braced initialization guarantees left-to-right evaluation, so string offsets are assigned in order
+		uint32_t stringOffset = k_msgOffset + (msgLen + 1) * sizeof(T);
+		new (payload) StoredArgs{ StoreArg(args, payload, stringOffset)... };
+
+		CommitRecord();
+	}
+
+
+	template<typename T, typename... Args>
+	size_t Logger::FormatRecord(uint8_t const* payload, LogType logType, char* destBuffer, size_t destBufferSize)
+	{
+		using StoredArgs = std::tuple<loginternal::StoredArg_t<Args>...>;
+		constexpr uint32_t k_msgOffset = GetMessageOffset<T, StoredArgs>();
+
+		StoredArgs const& storedArgs = *reinterpret_cast<StoredArgs const*>(payload);
+		T const* msg = reinterpret_cast<T const*>(payload + k_msgOffset);
+
+		std::array<T, k_internalStagingBufferSize> stagingBuffer;
+
+		std::apply([&](auto const&... storedArg)
+			{
+				FormatMessage<T>(logType, msg, stagingBuffer.data(), ResolveArg(payload, storedArg)...);
+			},
+			storedArgs);
+
+		// Convert/copy into the destination. Note: wcstombs doesn't allocate, unlike util::FromWideCString
+		size_t numChars = 0;
+		if constexpr (std::is_same<T, wchar_t>::value)
+		{
+			numChars = std::wcstombs(destBuffer, stagingBuffer.data(), destBufferSize - 1);
+			if (numChars == static_cast<size_t>(-1))
+			{
+				numChars = 0; // Unconvertible character
+			}
+		}
+		else
+		{
+			numChars = std::min(strlen(stagingBuffer.data()), destBufferSize - 1);
+			memcpy(destBuffer, stagingBuffer.data(), numChars);
+		}
+		destBuffer[numChars] = '\0';
+
+		return numChars;
+	}
+
+
+	template<typename T, typename... Args>
+	void Logger::FormatMessage(LogType logType, T const* msg, T* stagingBuffer, Args const&... args)
 	{
 		// Select the appropriate tag prefix:
 		T const* tagPrefix = nullptr;
@@ -198,8 +362,6 @@ namespace core
 		default: break;
 		}
 
-		std::array<T, k_internalStagingBufferSize> stagingBuffer;
-
 		// Prepend log prefix formatting:
 		size_t prependLength = 0;
 		T const* messageStart = nullptr;
@@ -223,7 +385,7 @@ namespace core
 				logging::k_newlinePrefixLen, 
 				tagPrefix, 
 				tagPrefixLen,
-				stagingBuffer.data());
+				stagingBuffer);
 		}
 		else if (msg[0] == '\t')
 		{
@@ -245,7 +407,7 @@ namespace core
 				logging::k_tabPrefixLen,
 				nullptr,
 				0,
-				stagingBuffer.data());
+				stagingBuffer);
 		}
 		else
 		{
@@ -257,25 +419,108 @@ namespace core
 				0,
 				tagPrefix,
 				tagPrefixLen,
-				stagingBuffer.data());
+				stagingBuffer);
 		}
 
 		// Append the expanded message after our prefix formatting:
 		InsertMessageAndVariadicArgs<T>(
-			stagingBuffer.data() + prependLength, 
+			stagingBuffer + prependLength, 
 			k_internalStagingBufferSize - static_cast<uint32_t>(prependLength + 2), // +2 for null terminator and new line
 			messageStart,
-			std::forward<Args>(args)...);
+			args...);
+	}
 
-		// Finally, pass the message to our Logger singleton:
-		if constexpr (std::is_same<T, wchar_t>::value)
+
+	template<typename T, typename StoredArgs>
+	constexpr uint32_t Logger::GetMessageOffset()
+	{
+		// Note: An empty std::tuple still has a non-zero size
+		return loginternal::AlignUp(
+			std::tuple_size_v<StoredArgs> == 0 ? 0 : static_cast<uint32_t>(sizeof(StoredArgs)),
+			static_cast<uint32_t>(alignof(T)));
+	}
+
+
+	template<typename CharT>
+	inline uint32_t Logger::GetStringLength(CharT const* str)
+	{
+		if (str == nullptr)
 		{
-			AddMessage(util::FromWideCString(stagingBuffer.data()).c_str());
+			return 0;
+		}
+
+		size_t strLen = 0;
+		if constexpr (std::is_same<CharT, wchar_t>::value)
+		{
+			strLen = wcsnlen(str, k_internalStagingBufferSize - 1);
 		}
 		else
 		{
-			AddMessage(stagingBuffer.data());
+			strLen = strnlen(str, k_internalStagingBufferSize - 1);
 		}
+		return static_cast<uint32_t>(strLen);
+	}
+
+
+	template<typename Arg>
+	inline uint32_t Logger::GetStringArgByteSize(Arg const& arg)
+	{
+		if constexpr (loginternal::IsString<std::decay_t<Arg>>::value)
+		{
+			using CharT = std::remove_cv_t<std::remove_pointer_t<std::decay_t<Arg>>>;
+
+			// Worst-case alignment padding, the string, and a null terminator
+			return static_cast<uint32_t>(alignof(CharT) - 1 + (GetStringLength<CharT>(arg) + 1) * sizeof(CharT));
+		}
+		else
+		{
+			return 0;
+		}
+	}
+
+
+	template<typename Arg>
+	inline loginternal::StoredArg_t<Arg> Logger::StoreArg(Arg const& arg, uint8_t* payload, uint32_t& stringOffset)
+	{
+		if constexpr (loginternal::IsString<std::decay_t<Arg>>::value)
+		{
+			using CharT = std::remove_cv_t<std::remove_pointer_t<std::decay_t<Arg>>>;
+
+			stringOffset = loginternal::AlignUp(stringOffset, static_cast<uint32_t>(alignof(CharT)));
+
+			// Note: nullptr strings are logged as empty strings
+			const uint32_t strLen = GetStringLength<CharT>(arg);
+			CharT* dest = reinterpret_cast<CharT*>(payload + stringOffset);
+			if (strLen > 0)
+			{
+				memcpy(dest, arg, strLen * sizeof(CharT));
+			}
+			dest[strLen] = CharT('\0');
+
+			const loginternal::DeferredString<CharT> deferredString{ .m_offset = stringOffset };
+			stringOffset += (strLen + 1) * sizeof(CharT);
+			return deferredString;
+		}
+		else
+		{
+			static_assert(std::is_trivially_copyable_v<std::decay_t<Arg>>,
+				"Log arguments must be trivially copyable, or C strings");
+			return arg;
+		}
+	}
+
+
+	template<typename Arg>
+	inline Arg const& Logger::ResolveArg(uint8_t const*, Arg const& arg)
+	{
+		return arg;
+	}
+
+
+	template<typename CharT>
+	inline CharT const* Logger::ResolveArg(uint8_t const* payload, loginternal::DeferredString<CharT> deferredString)
+	{
+		return reinterpret_cast<CharT const*>(payload + deferredString.m_offset);
 	}
 
 
@@ -363,6 +608,20 @@ namespace core
 
 // Log macros:
 // ------------------------------------------------
+#if SE_LOG_LEVEL <= SE_LOG_LEVEL_LOG
 #define LOG(msg, ...)			core::Logger::Log(msg, __VA_ARGS__);
+#else
+#define LOG(msg, ...)
+#endif
+
+#if SE_LOG_LEVEL <= SE_LOG_LEVEL_WARNING
 #define LOG_WARNING(msg, ...)	core::Logger::LogWarning(msg, __VA_ARGS__);
-#define LOG_ERROR(msg, ...)		core::Logger::LogError(msg, __VA_ARGS__);
\ No newline at end of file
+#else
+#define LOG_WARNING(msg, ...)
+#endif
+
+#if SE_LOG_LEVEL <= SE_LOG_LEVEL_ERROR
+#define LOG_ERROR(msg, ...)		core::Logger::LogError(msg, __VA_ARGS__);
+#else
+#define LOG_ERROR(msg, ...)
+#endif
\ No newline at end of file
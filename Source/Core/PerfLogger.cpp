@@ -1,13 +1,129 @@
 //  2025 Adam Badke. All rights reserved.
 #include "PerfLogger.h"
+#include "TraceCapture.h"
 
 #include "../Assert.h"
 #include "../Config.h"
 #include "../Definitions/EventKeys.h"
 
+#include "../Util/TextUtils.h"
+
+
+namespace
+{
+	constexpr double k_nsPerMs = 1000000.0;
+
+
+	inline uint64_t MsToHistogramValue(double timeMs)
+	{
+		return static_cast<uint64_t>(std::max(timeMs, 0.0) * k_nsPerMs);
+	}
+
+
+	// Histogram values are approximate: Clamp them to the exact range we've observed
+	inline double HistogramValueToMs(uint64_t value, double minMs, double maxMs)
+	{
+		return std::clamp(static_cast<double>(value) / k_nsPerMs, minMs, maxMs);
+	}
+
+
+	void PopulatePercentiles(
+		core::PerfLogger::TimeStatistics& stats, util::LogLinearHistogram const& histogram)
+	{
+		stats.m_p50Ms = HistogramValueToMs(histogram.GetValueAtPercentile(50.0), stats.m_minMs, stats.m_maxMs);
+		stats.m_p95Ms = HistogramValueToMs(histogram.GetValueAtPercentile(95.0), stats.m_minMs, stats.m_maxMs);
+		stats.m_p99Ms = HistogramValueToMs(histogram.GetValueAtPercentile(99.0), stats.m_minMs, stats.m_maxMs);
+	}
+}
+
 
 namespace core
 {
+	PerfLogger::RecordStatistics::RecordStatistics()
+		: m_windowSamplesMs{}
+		, m_nextWindowSampleIdx(0)
+		, m_numWindowSamples(0)
+		, m_windowTotalMs(0.0)
+		, m_numLifetimeSamples(0)
+		, m_lifetimeTotalMs(0.0)
+		, m_lifetimeMinMs(std::numeric_limits<double>::max())
+		, m_lifetimeMaxMs(0.0)
+	{
+	}
+
+
+	void PerfLogger::RecordStatistics::AddSample(double timeMs)
+	{
+		// Evict the oldest sample once the window is full:
+		if (m_numWindowSamples == k_statsWindowNumSamples)
+		{
+			const double evictedMs = m_windowSamplesMs[m_nextWindowSampleIdx];
+			m_windowTotalMs -= evictedMs;
+			m_windowHistogram.Remove(MsToHistogramValue(evictedMs));
+		}
+		else
+		{
+			++m_numWindowSamples;
+		}
+
+		m_windowSamplesMs[m_nextWindowSampleIdx] = timeMs;
+		m_nextWindowSampleIdx = (m_nextWindowSampleIdx + 1) % k_statsWindowNumSamples;
+		m_windowTotalMs += timeMs;
+
+		const uint64_t histogramValue = MsToHistogramValue(timeMs);
+		m_windowHistogram.Add(histogramValue);
+
+		++m_numLifetimeSamples;
+		m_lifetimeTotalMs += timeMs;
+		m_lifetimeMinMs = std::min(m_lifetimeMinMs, timeMs);
+		m_lifetimeMaxMs = std::max(m_lifetimeMaxMs, timeMs);
+		m_lifetimeHistogram.Add(histogramValue);
+	}
+
+
+	PerfLogger::TimeStatistics PerfLogger::RecordStatistics::GetWindowStatistics() const
+	{
+		TimeStatistics stats{};
+		if (m_numWindowSamples == 0)
+		{
+			return stats;
+		}
+
+		// The window is small: Scanning it for the exact min/max is cheaper than maintaining them on every sample
+		stats.m_numSamples = m_numWindowSamples;
+		stats.m_minMs = std::numeric_limits<double>::max();
+		for (size_t sampleIdx = 0; sampleIdx < m_numWindowSamples; ++sampleIdx)
+		{
+			stats.m_minMs = std::min(stats.m_minMs, m_windowSamplesMs[sampleIdx]);
+			stats.m_maxMs = std::max(stats.m_maxMs, m_windowSamplesMs[sampleIdx]);
+		}
+		stats.m_meanMs = m_windowTotalMs / static_cast<double>(m_numWindowSamples);
+
+		PopulatePercentiles(stats, m_windowHistogram);
+
+		return stats;
+	}
+
+
+	PerfLogger::TimeStatistics PerfLogger::RecordStatistics::GetLifetimeStatistics() const
+	{
+		TimeStatistics stats{};
+		if (m_numLifetimeSamples == 0)
+		{
+			return stats;
+		}
+
+		stats.m_numSamples = m_numLifetimeSamples;
+		stats.m_minMs = m_lifetimeMinMs;
+		stats.m_maxMs = m_lifetimeMaxMs;
+		stats.m_meanMs = m_lifetimeTotalMs / static_cast<double>(m_numLifetimeSamples);
+
+		PopulatePercentiles(stats, m_lifetimeHistogram);
+
+		return stats;
+	}
+
+
 	PerfLogger* PerfLogger::Get()
 	{
 		static std::unique_ptr<core::PerfLogger> instance = std::make_unique<core::PerfLogger>();
@@ -18,8 +134,27 @@ namespace core
 	PerfLogger::PerfLogger()
 		: m_numFramesInFlight(core::Config::GetValue<int>(core::configkeys::k_numBackbuffersKey))
 		, m_isEnabled(false)
+		, m_writeStatisticsOnShutdown(core::Config::KeyExists(core::configkeys::k_perfStatsCmdLineArg))
 	{
 		core::EventManager::Subscribe(eventkey::TogglePerformanceTimers, this);
+
+		if (m_writeStatisticsOnShutdown)
+		{
+			m_isEnabled.store(true);
+		}
+
+		// e.g. "-tracecapture 120": Capture a trace of the first 120 frames
+		if (core::Config::KeyExists(core::configkeys::k_traceCaptureCmdLineArg))
+		{
+			// The frame count is optional: A bare "-tracecapture" flag is stored as a boolean
+			int numCaptureFrames = std::atoi(
+				core::Config::GetValueAsString(core::configkeys::k_traceCaptureCmdLineArg).c_str());
+			if (numCaptureFrames <= 0)
+			{
+				numCaptureFrames = core::TraceCapture::k_defaultNumCaptureFrames;
+			}
+			core::TraceCapture::RequestCapture(static_cast<uint32_t>(numCaptureFrames));
+		}
 	}
 
 
@@ -31,6 +166,8 @@ namespace core
 
 	void PerfLogger::BeginFrame()
 	{
+		core::TraceCapture::BeginFrame(); // Trace captures are independent of our enabled state
+
 		HandleEvents();
 
 		if (m_isEnabled.load() == false)
@@ -84,6 +221,12 @@ namespace core
 						recordItr->second.m_timer.StopMs();
 					}
 
+					m_retiredRecords.emplace(recordItr->first, RetiredRecord{
+						.m_name = std::move(recordItr->second.m_name),
+						.m_parentName = std::move(recordItr->second.m_parentName),
+						.m_statistics = std::move(recordItr->second.m_statistics),
+					});
+
 					recordItr = m_times.erase(recordItr);
 				}
 				else
@@ -109,6 +252,19 @@ namespace core
 		auto recordItr = m_times.find(nameHash);
 		if (recordItr == m_times.end())
 		{
+			// Resume the statistics of a record that previously aged out:
+			std::unique_ptr<RecordStatistics> statistics;
+			auto retiredItr = m_retiredRecords.find(nameHash);
+			if (retiredItr != m_retiredRecords.end())
+			{
+				statistics = std::move(retiredItr->second.m_statistics);
+				m_retiredRecords.erase(retiredItr);
+			}
+			else
+			{
+				statistics = std::make_unique<RecordStatistics>();
+			}
+
 			recordItr = m_times.emplace(
 				nameHash,
 				TimeRecord{
@@ -117,6 +273,7 @@ namespace core
 					.m_parentName = hasParent ? parentName : std::string{},
 					.m_parentNameHash = hasParent ? util::HashKey(parentName) : util::HashKey(),
 					.m_mostRecentTimeMs = 0.0,
+					.m_statistics = std::move(statistics),
 					.m_hasParent = hasParent,
 					.m_numFramesSinceUpdated = 0,
 				}).first;
@@ -170,6 +327,14 @@ namespace core
 	}
 
 
+	void PerfLogger::RecordSampleHelper(TimeRecord& record, double timeMs)
+	{
+		// Note: Internal helper function: We assume m_perfLoggerMutex is already locked
+		record.m_mostRecentTimeMs = timeMs;
+		record.m_statistics->AddSample(timeMs);
+	}
+
+
 	void PerfLogger::NotifyBegin(char const* name, char const* parentName /*= nullptr*/)
 	{
 		if (m_isEnabled.load() == false)
@@ -204,7 +369,7 @@ namespace core
 			{
 				if (recordItr->second.m_timer.IsRunning()) // Might not be running (e.g. 1st update in a loop)
 				{
-					recordItr->second.m_mostRecentTimeMs = recordItr->second.m_timer.StopMs();
+					RecordSampleHelper(recordItr->second, recordItr->second.m_timer.StopMs());
 				}
 			}
 		}
@@ -224,7 +389,195 @@ namespace core
 			TimeRecord& record = AddUpdateTimeRecordHelper(name, parentName);
 			SEAssert(!record.m_timer.IsRunning(), "Timer is running, this is invalid for manual time periods");
 
-			record.m_mostRecentTimeMs = totalTimeMs;
+			RecordSampleHelper(record, totalTimeMs);
+		}
+	}
+
+
+	void PerfLogger::Shutdown()
+	{
+		if (m_writeStatisticsOnShutdown)
+		{
+			WriteStatisticsFilesHelper();
+		}
+		Destroy();
+	}
+
+
+	bool PerfLogger::GetStatistics(char const* name, TimeStatistics& windowStatsOut, TimeStatistics& lifetimeStatsOut)
+	{
+		std::lock_guard<std::mutex> lock(m_perfLoggerMutex);
+
+		const util::HashKey nameHash(name);
+
+		RecordStatistics const* statistics = nullptr;
+
+		auto recordItr = m_times.find(nameHash);
+		if (recordItr != m_times.end())
+		{
+			statistics = recordItr->second.m_statistics.get();
+		}
+		else
+		{
+			auto retiredItr = m_retiredRecords.find(nameHash);
+			if (retiredItr == m_retiredRecords.end())
+			{
+				return false;
+			}
+			statistics = retiredItr->second.m_statistics.get();
+		}
+
+		windowStatsOut = statistics->GetWindowStatistics();
+		lifetimeStatsOut = statistics->GetLifetimeStatistics();
+		return true;
+	}
+
+
+	bool PerfLogger::WriteStatistics(std::string const& filePath, StatisticsFormat format)
+	{
+		std::ofstream statsFile(filePath, std::ios::out);
+		if (!statsFile.good())
+		{
+			LOG_ERROR("Failed to create performance statistics file \"%s\"", filePath.c_str());
+			return false;
+		}
+
+		auto FormatCSVStats = [](TimeStatistics const& stats) -> std::string
+			{
+				return std::format("{},{:.4f},{:.4f},{:.4f},{:.4f},{:.4f},{:.4f}",
+					stats.m_numSamples,
+					stats.m_minMs,
+					stats.m_maxMs,
+					stats.m_meanMs,
+					stats.m_p50Ms,
+					stats.m_p95Ms,
+					stats.m_p99Ms);
+			};
+
+		auto FormatJSONStats = [](TimeStatistics const& stats) -> std::string
+			{
+				return std::format("{{\"samples\":{},\"minMs\":{:.4f},\"maxMs\":{:.4f},\"meanMs\":{:.4f},"
+					"\"p50Ms\":{:.4f},\"p95Ms\":{:.4f},\"p99Ms\":{:.4f}}}",
+					stats.m_numSamples,
+					stats.m_minMs,
+					stats.m_maxMs,
+					stats.m_meanMs,
+					stats.m_p50Ms,
+					stats.m_p95Ms,
+					stats.m_p99Ms);
+			};
+
+		// Record names are code identifiers (e.g. "en::EntityManager::Update"), but may still contain a delimiter
+		auto EscapeName = [format](std::string const& name) -> std::string
+			{
+				std::string result;
+				for (char c : name)
+				{
+					if (c == '"' || (format == StatisticsFormat::JSON && c == '\\'))
+					{
+						result += format == StatisticsFormat::CSV ? '"' : '\\'; // CSV escapes quotes by doubling
+					}
+					result += c;
+				}
+				return result;
+			};
+
+		{
+			std::lock_guard<std::mutex> lock(m_perfLoggerMutex);
+
+			struct RecordEntry
+			{
+				std::string const* m_name;
+				std::string const* m_parentName;
+				RecordStatistics const* m_statistics;
+			};
+
+			// Sort by name, so files from different runs can be diffed
+			std::vector<RecordEntry> sortedRecords;
+			sortedRecords.reserve(m_times.size() + m_retiredRecords.size());
+			for (auto const& record : m_times)
+			{
+				sortedRecords.emplace_back(RecordEntry{
+					.m_name = &record.second.m_name,
+					.m_parentName = &record.second.m_parentName,
+					.m_statistics = record.second.m_statistics.get(),
+				});
+			}
+			for (auto const& retiredRecord : m_retiredRecords)
+			{
+				sortedRecords.emplace_back(RecordEntry{
+					.m_name = &retiredRecord.second.m_name,
+					.m_parentName = &retiredRecord.second.m_parentName,
+					.m_statistics = retiredRecord.second.m_statistics.get(),
+				});
+			}
+			std::sort(sortedRecords.begin(), sortedRecords.end(),
+				[](RecordEntry const& lhs, RecordEntry const& rhs) { return *lhs.m_name < *rhs.m_name; });
+
+			switch (format)
+			{
+			case StatisticsFormat::CSV:
+			{
+				statsFile << "name,parent,"
+					"windowSamples,windowMinMs,windowMaxMs,windowMeanMs,windowP50Ms,windowP95Ms,windowP99Ms,"
+					"lifetimeSamples,lifetimeMinMs,lifetimeMaxMs,lifetimeMeanMs,lifetimeP50Ms,lifetimeP95Ms,lifetimeP99Ms\n";
+
+				for (RecordEntry const& record : sortedRecords)
+				{
+					statsFile << std::format("\"{}\",\"{}\",{},{}\n",
+						EscapeName(*record.m_name),
+						EscapeName(*record.m_parentName),
+						FormatCSVStats(record.m_statistics->GetWindowStatistics()),
+						FormatCSVStats(record.m_statistics->GetLifetimeStatistics()));
+				}
+			}
+			break;
+			case StatisticsFormat::JSON:
+			{
+				statsFile << std::format("{{\"windowSize\":{},\"records\":[", k_statsWindowNumSamples);
+
+				for (size_t recordIdx = 0; recordIdx < sortedRecords.size(); ++recordIdx)
+				{
+					RecordEntry const& record = sortedRecords[recordIdx];
+
+					statsFile << std::format("{}\n{{\"name\":\"{}\",\"parent\":\"{}\",\"window\":{},\"lifetime\":{}}}",
+						recordIdx == 0 ? "" : ",",
+						EscapeName(*record.m_name),
+						EscapeName(*record.m_parentName),
+						FormatJSONStats(record.m_statistics->GetWindowStatistics()),
+						FormatJSONStats(record.m_statistics->GetLifetimeStatistics()));
+				}
+
+				statsFile << "\n]}\n";
+			}
+			break;
+			default: SEAssertF("Invalid statistics format");
+			}
+		}
+
+		return statsFile.good();
+	}
+
+
+	void PerfLogger::WriteStatisticsFilesHelper()
+	{
+		std::filesystem::create_directory(core::configkeys::k_logOutputDir);
+
+		const std::string filePathNoExtension = std::format("{}{}_{}",
+			core::configkeys::k_logOutputDir,
+			core::configkeys::k_perfStatsFileName,
+			util::GetTimeAndDateAsString());
+
+		const std::string csvFilePath = std::format("{}.csv", filePathNoExtension);
+		if (WriteStatistics(csvFilePath, StatisticsFormat::CSV))
+		{
+			LOG("Performance statistics written to \"%s\"", csvFilePath.c_str());
+		}
+
+		const std::string jsonFilePath = std::format("{}.json", filePathNoExtension);
+		if (WriteStatistics(jsonFilePath, StatisticsFormat::JSON))
+		{
+			LOG("Performance statistics written to \"%s\"", jsonFilePath.c_str());
 		}
 	}
 
@@ -239,7 +592,7 @@ namespace core
 			{
 			case eventkey::TogglePerformanceTimers:
 			{
-				m_isEnabled.store(std::get<bool>(eventInfo.m_data));
+				m_isEnabled.store(std::get<bool>(eventInfo.m_data) || m_writeStatisticsOnShutdown);
 
 				if (!m_isEnabled.load())
 				{
@@ -267,6 +620,7 @@ namespace core
 				}
 			}
 			m_times.clear();
+			m_retiredRecords.clear();
 		}
 	}
 
@@ -376,10 +730,30 @@ namespace core
 								ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_Bullet
 								: ImGuiTreeNodeFlags_None;
 
+							auto ShowStatisticsTooltip = [](TimeRecord const& record)
+								{
+									if (ImGui::IsItemHovered())
+									{
+										TimeStatistics const& stats = record.m_statistics->GetWindowStatistics();
+										ImGui::SetTooltip(std::format(
+											"Last {} samples:\n"
+											"min: {:6.2f}ms\nmax: {:6.2f}ms\nmean: {:6.2f}ms\n"
+											"p50: {:6.2f}ms\np95: {:6.2f}ms\np99: {:6.2f}ms",
+											stats.m_numSamples,
+											stats.m_minMs,
+											stats.m_maxMs,
+											stats.m_meanMs,
+											stats.m_p50Ms,
+											stats.m_p95Ms,
+											stats.m_p99Ms).c_str());
+									}
+								};
+
 							if (ImGui::TreeNodeEx(std::format("##{}", record.m_name).c_str(), flags))
 							{
 								ImGui::SameLine();
 								ImGui::Text(recordTex.c_str());
+								ShowStatisticsTooltip(record);
 
 								for (auto const& childKey : record.m_children)
 								{
@@ -392,6 +766,7 @@ namespace core
 							{
 								ImGui::SameLine();
 								ImGui::Text(recordTex.c_str());
+								ShowStatisticsTooltip(record);
 							}
 
 							// Cleanup:
@@ -402,6 +777,8 @@ namespace core
 				}
 			}
 
+			bool writeStatistics = false;
+
 			if (ImGui::BeginPopupContextWindow())
 			{
 				if (ImGui::MenuItem("Top-left", nullptr, s_location == TopLeft))
@@ -420,6 +797,20 @@ namespace core
 				{
 					s_location = BottomRight;
 				}
+				ImGui::Separator();
+				if (ImGui::MenuItem(std::format("Capture trace ({} frames)",
+					core::TraceCapture::k_defaultNumCaptureFrames).c_str(),
+					nullptr,
+					false,
+					!core::TraceCapture::IsCapturing()))
+				{
+					core::TraceCapture::RequestCapture(core::TraceCapture::k_defaultNumCaptureFrames);
+				}
+				if (ImGui::MenuItem("Save statistics"))
+				{
+					writeStatistics = true;
+				}
+				ImGui::Separator();
 				if (show && ImGui::MenuItem("Hide"))
 				{
 					*show = false;
@@ -427,6 +818,11 @@ namespace core
 
 				ImGui::EndPopup();
 			}
+
+			if (writeStatistics)
+			{
+				WriteStatisticsFilesHelper();
+			}
 		}
 		ImGui::End();
 	}
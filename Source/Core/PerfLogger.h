@@ -5,6 +5,7 @@
 #include "Interfaces/IEventListener.h"
 
 #include "Util/HashKey.h"
+#include "Util/LogLinearHistogram.h"
 
 
 namespace core
@@ -15,6 +16,27 @@ namespace core
 		static PerfLogger* Get(); // Singleton functionality
 
 
+	public:
+		static constexpr size_t k_statsWindowNumSamples = 300; // Size of the sliding window used for rolling statistics
+
+		struct TimeStatistics
+		{
+			uint64_t m_numSamples = 0;
+			double m_minMs = 0.0;
+			double m_maxMs = 0.0;
+			double m_meanMs = 0.0;
+			double m_p50Ms = 0.0;
+			double m_p95Ms = 0.0;
+			double m_p99Ms = 0.0;
+		};
+
+		enum class StatisticsFormat : uint8_t
+		{
+			CSV,
+			JSON,
+		};
+
+
 	public:
 		PerfLogger();
 
@@ -32,6 +54,17 @@ namespace core
 
 		void NotifyPeriod(double totalTimeMs, char const*, char const* parentName = nullptr);
 
+		void Shutdown(); // Writes statistics files, if requested via the command line
+
+
+	public:
+		// Rolling statistics over the last k_statsWindowNumSamples samples, and over the lifetime of the record.
+		// Records that have aged out are included. Returns false if no record with the given name exists
+		bool GetStatistics(char const* name, TimeStatistics& windowStatsOut, TimeStatistics& lifetimeStatsOut);
+
+		// Writes the statistics of all current and aged out records to a file. Returns false on failure
+		bool WriteStatistics(std::string const& filePath, StatisticsFormat);
+
 
 	public:
 		void ShowImGuiWindow(bool* show);
@@ -45,6 +78,31 @@ namespace core
 
 	private:
 		static constexpr uint8_t k_maxFramesWithoutUpdate = 10; // No. frames without update to delete a record
+
+		// Fixed-size sample storage: Allocated once when a record is created, and never resized
+		class RecordStatistics final
+		{
+		public:
+			RecordStatistics();
+
+			void AddSample(double timeMs);
+
+			TimeStatistics GetWindowStatistics() const;
+			TimeStatistics GetLifetimeStatistics() const;
+
+		private:
+			std::array<double, k_statsWindowNumSamples> m_windowSamplesMs; // Ring buffer
+			size_t m_nextWindowSampleIdx;
+			size_t m_numWindowSamples;
+			double m_windowTotalMs;
+			util::LogLinearHistogram m_windowHistogram; // Nanoseconds
+
+			uint64_t m_numLifetimeSamples;
+			double m_lifetimeTotalMs;
+			double m_lifetimeMinMs;
+			double m_lifetimeMaxMs;
+			util::LogLinearHistogram m_lifetimeHistogram; // Nanoseconds
+		};
 		
 		struct TimeRecord
 		{
@@ -57,6 +115,7 @@ namespace core
 			util::HashKey m_parentNameHash;
 
 			double m_mostRecentTimeMs = 0.0;
+			std::unique_ptr<RecordStatistics> m_statistics;
 
 			std::vector<util::HashKey> m_children;
 			bool m_hasParent = false; // If true, will be nested
@@ -65,6 +124,16 @@ namespace core
 		};
 		std::unordered_map<util::HashKey, TimeRecord> m_times;
 
+		// Records that aged out of m_times: We keep their statistics, so they're included in the statistics files
+		// and are resumed if the record is updated again
+		struct RetiredRecord
+		{
+			std::string m_name;
+			std::string m_parentName;
+			std::unique_ptr<RecordStatistics> m_statistics;
+		};
+		std::unordered_map<util::HashKey, RetiredRecord> m_retiredRecords;
+
 		static constexpr double k_warnThresholdMs = 1000.0 / 70.0;
 		static constexpr double k_alertThresholdMs = 1000.0 / 60.0;
 
@@ -73,10 +142,14 @@ namespace core
 		std::mutex m_perfLoggerMutex;
 		
 		std::atomic<bool> m_isEnabled;
+		bool m_writeStatisticsOnShutdown; // Also keeps us enabled, so soak tests can run with the UI hidden
 
 
 	private:
 		TimeRecord& AddUpdateTimeRecordHelper(char const* name, char const* parentName /*= nullptr*/);
+		void RecordSampleHelper(TimeRecord&, double timeMs);
+
+		void WriteStatisticsFilesHelper(); // Writes both CSV and JSON statistics files
 
 
 	private: // No copying allowed
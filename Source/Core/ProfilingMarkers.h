@@ -4,6 +4,8 @@
 //#define PIX_USE_GPU_MARKERS_V2
 #include <pix3.h>
 
+#include "TraceCapture.h"
+
 
 namespace perfmarkers
 {
@@ -27,6 +29,8 @@ namespace perfmarkers
 /***********************************************************************************************************************
 *	Notes:
 *	- Event names are expected to be null-terminated C-strings
+*	- CPU markers are always forwarded to core::TraceCapture (which is a no-op unless a capture is in progress), so
+*	  traces can be captured in any build configuration/platform
 ***********************************************************************************************************************/
 
 
@@ -36,11 +40,17 @@ namespace perfmarkers
 // CPU markers:
 //-------------
 #define SEBeginCPUEvent(...) \
-	PIXBeginEvent(PIX_COLOR_INDEX(perfmarkers::Type::CPUSection),  __VA_ARGS__);
+	do { \
+		PIXBeginEvent(PIX_COLOR_INDEX(perfmarkers::Type::CPUSection),  __VA_ARGS__); \
+		core::TraceCapture::BeginEvent(__VA_ARGS__); \
+	} while(0);
 
 
 #define SEEndCPUEvent() \
-	PIXEndEvent();
+	do { \
+		PIXEndEvent(); \
+		core::TraceCapture::EndEvent(); \
+	} while(0);
 
 
 // DX12 GPU markers:
@@ -72,14 +82,14 @@ namespace perfmarkers
 #else
 // Release mode: Remove markers
 
-// CPU markers:
+// CPU markers: Trace capture only
 //-------------
 #define SEBeginCPUEvent(...) \
-	do { static_cast<void>(0, ##__VA_ARGS__); } while(0);
+	core::TraceCapture::BeginEvent(__VA_ARGS__);
 
 
 #define SEEndCPUEvent() \
-	do {} while(0);
+	core::TraceCapture::EndEvent();
 
 
 // GPU markers:
@@ -207,6 +217,7 @@ namespace debugperfmarkers
 	{
 		debugperfmarkers::RecordMarkerBegin(m_name, m_file, m_line);
 		PIXBeginEvent(PIX_COLOR_INDEX(perfmarkers::Type::CPUSection), m_name);
+		core::TraceCapture::BeginEvent(m_name);
 	}
 
 
@@ -214,6 +225,7 @@ namespace debugperfmarkers
 	{
 		debugperfmarkers::RecordMarkerEnd(name);
 		PIXEndEvent();
+		core::TraceCapture::EndEvent();
 	}
 } // namespace debugperfmarkers
 
@@ -102,8 +102,20 @@ namespace core
 
 
 	private:
-		std::unordered_map<util::HashKey, PtrAndControl> m_ptrAndControlBlocks;
-		mutable std::shared_mutex m_ptrAndControlBlocksMutex;
+		// The control blocks are split into independently-locked shards, selected by ID, to reduce contention when
+		// many threads request resources concurrently (e.g. asset loading jobs)
+		static constexpr size_t k_numShards = 16;
+		SEStaticAssert((k_numShards & (k_numShards - 1)) == 0, "Number of shards must be a power of 2");
+
+		struct alignas(64) Shard
+		{
+			std::unordered_map<util::HashKey, PtrAndControl> m_ptrAndControlBlocks;
+			mutable std::shared_mutex m_ptrAndControlBlocksMutex;
+		};
+		std::array<Shard, k_numShards> m_shards;
+
+		Shard& GetShard(util::HashKey);
+		Shard const& GetShard(util::HashKey) const;
 
 		// We defer resource release to avoid degenerate cases (e.g. release and then re-load the same thing). 
 		// Note: This is not intended to guarantee resource lifetime/scope, it is only a reload optimization
@@ -127,27 +139,47 @@ namespace core
 		// Due to indeterminate ordering when Destroy() is called, we must check for resource leaks here, once we know
 		// all ResourceSystems have destroyed their contents
 #if defined (_DEBUG)
-		for (auto& entry : m_ptrAndControlBlocks)
+		for (Shard const& shard : m_shards)
 		{
-			const RefCountType entryRefCount = entry.second.m_control->m_refCount.load(std::memory_order_relaxed);
+			for (auto& entry : shard.m_ptrAndControlBlocks)
+			{
+				const RefCountType entryRefCount = entry.second.m_control->m_refCount.load(std::memory_order_relaxed);
 
-			SEAssert(entryRefCount == 0 ||
-				(entryRefCount == 1 && entry.second.m_retentionPolicy == core::RetentionPolicy::Permanent),
-				"There is an outstanding InvPtr that has not been released yet. This might indicate a resource leak");
+				SEAssert(entryRefCount == 0 ||
+					(entryRefCount == 1 && entry.second.m_retentionPolicy == core::RetentionPolicy::Permanent),
+					"There is an outstanding InvPtr that has not been released yet. This might indicate a resource leak");
+			}
 		}
 #endif
 	}
 
 
+	template<typename T>
+	ResourceSystem<T>::Shard& ResourceSystem<T>::GetShard(util::HashKey id)
+	{
+		// IDs are already hashed: Fold the upper bits in, in case the lower bits are poorly distributed
+		const uint64_t hash = id.m_hashKey;
+		return m_shards[(hash ^ (hash >> 32)) & (k_numShards - 1)];
+	}
+
+
+	template<typename T>
+	ResourceSystem<T>::Shard const& ResourceSystem<T>::GetShard(util::HashKey id) const
+	{
+		return const_cast<ResourceSystem<T>*>(this)->GetShard(id);
+	}
+
+
 	template<typename T>
 	void ResourceSystem<T>::Destroy()
 	{
 		FreeDeferredReleases(std::numeric_limits<uint64_t>::max()); // Force-release everything
 
+		for (Shard& shard : m_shards)
 		{
-			std::lock_guard<std::shared_mutex> readLock(m_ptrAndControlBlocksMutex);
+			std::lock_guard<std::shared_mutex> readLock(shard.m_ptrAndControlBlocksMutex);
 
-			for (auto& entry : m_ptrAndControlBlocks)
+			for (auto& entry : shard.m_ptrAndControlBlocks)
 			{
 				// Note: Resources may still have a ref count >= 1 here, as they may be permanent or still referenced
 				// by another resource held another ResourceSystem that has not been Destroy()ed yet
@@ -163,14 +195,14 @@ namespace core
 	template<typename T>
 	bool ResourceSystem<T>::HasLoaded(util::HashKey id) const
 	{
+		Shard const& shard = GetShard(id);
 		{
-			std::shared_lock<std::shared_mutex> readLock(m_ptrAndControlBlocksMutex);
+			std::shared_lock<std::shared_mutex> readLock(shard.m_ptrAndControlBlocksMutex);
 			
-			auto ptrCtrlItr = m_ptrAndControlBlocks.find(id);
-			if (ptrCtrlItr != m_ptrAndControlBlocks.end())
+			auto ptrCtrlItr = shard.m_ptrAndControlBlocks.find(id);
+			if (ptrCtrlItr != shard.m_ptrAndControlBlocks.end())
 			{
-				return m_ptrAndControlBlocks.at(id).m_control->m_state.load(
-					std::memory_order_acquire) == ResourceState::Ready;
+				return ptrCtrlItr->second.m_control->m_state.load(std::memory_order_acquire) == ResourceState::Ready;
 			}
 			return false;
 		}
@@ -180,14 +212,14 @@ namespace core
 	template<typename T>
 	bool ResourceSystem<T>::Has(util::HashKey id) const
 	{
+		Shard const& shard = GetShard(id);
 		{
-			std::shared_lock<std::shared_mutex> readLock(m_ptrAndControlBlocksMutex);
+			std::shared_lock<std::shared_mutex> readLock(shard.m_ptrAndControlBlocksMutex);
 
-			auto ptrCtrlItr = m_ptrAndControlBlocks.find(id);
-			if (ptrCtrlItr != m_ptrAndControlBlocks.end())
+			auto ptrCtrlItr = shard.m_ptrAndControlBlocks.find(id);
+			if (ptrCtrlItr != shard.m_ptrAndControlBlocks.end())
 			{
-				const ResourceState resourceState =
-					m_ptrAndControlBlocks.at(id).m_control->m_state.load(std::memory_order_acquire);
+				const ResourceState resourceState = ptrCtrlItr->second.m_control->m_state.load(std::memory_order_acquire);
 
 				// Note: We cannot say we have a resource if it is in the Empty state, as this allows a race condition
 				// where a thread that does not supply a load context might transition the resource state to Requested
@@ -206,11 +238,12 @@ namespace core
 	ResourceSystem<T>::ControlBlock* ResourceSystem<T>::Get(
 		util::HashKey id, std::shared_ptr<ILoadContext<L>> const& loadContext)
 	{
+		Shard& shard = GetShard(id);
 		{
-			std::shared_lock<std::shared_mutex> readLock(m_ptrAndControlBlocksMutex);
+			std::shared_lock<std::shared_mutex> readLock(shard.m_ptrAndControlBlocksMutex);
 
-			auto entryItr = m_ptrAndControlBlocks.find(id);
-			if (entryItr != m_ptrAndControlBlocks.end())
+			auto entryItr = shard.m_ptrAndControlBlocks.find(id);
+			if (entryItr != shard.m_ptrAndControlBlocks.end())
 			{
 				return entryItr->second.m_control.get();
 			}
@@ -218,10 +251,10 @@ namespace core
 
 		// If we made it this far, we probably need to construct our object:
 		{
-			std::unique_lock<std::shared_mutex> writeLock(m_ptrAndControlBlocksMutex);
+			std::unique_lock<std::shared_mutex> writeLock(shard.m_ptrAndControlBlocksMutex);
 
-			auto entryItr = m_ptrAndControlBlocks.find(id);
-			if (entryItr != m_ptrAndControlBlocks.end()) // It might have been created while we waited
+			auto entryItr = shard.m_ptrAndControlBlocks.find(id);
+			if (entryItr != shard.m_ptrAndControlBlocks.end()) // It might have been created while we waited
 			{
 				return entryItr->second.m_control.get();
 			}
@@ -236,7 +269,7 @@ namespace core
 					"Get() called with a null loadContext, this is only valid if the object is guaranteed to exist");
 
 				ResourceSystem<T>::PtrAndControl& newPtrAndCntrl =
-					m_ptrAndControlBlocks.emplace(id, ResourceSystem<T>::PtrAndControl{}).first->second;
+					shard.m_ptrAndControlBlocks.emplace(id, ResourceSystem<T>::PtrAndControl{}).first->second;
 
 				newPtrAndCntrl.m_control = std::make_unique<ControlBlock>();
 
@@ -285,18 +318,23 @@ namespace core
 		SEBeginCPUEvent("ResourceSystem::FreeDeferredReleases");
 
 		{
-			std::scoped_lock lock(m_deferredReleaseMutex, m_ptrAndControlBlocksMutex);
+			// Note: Release() never holds a shard lock while acquiring m_deferredReleaseMutex, so it is safe for us to
+			// lock the individual shards while holding it
+			std::lock_guard<std::mutex> lock(m_deferredReleaseMutex);
 
 			while (!m_deferredRelease.empty() &&
 				m_deferredRelease.front().first + k_deferredReleaseNumFrames < frameNum)
 			{
 				const util::HashKey ID = m_deferredRelease.front().second;
 
+				Shard& shard = GetShard(ID);
+				std::unique_lock<std::shared_mutex> writeLock(shard.m_ptrAndControlBlocksMutex);
+
 				// It is possible for Resources to be added to the deferred delete queue multiple times (e.g. if they're
 				// resurrected/released multiple times), the important thing is that they have a ref count of zero for
 				// the entry when we actually free them
-				auto entryItr = m_ptrAndControlBlocks.find(ID);
-				if (entryItr != m_ptrAndControlBlocks.end())
+				auto entryItr = shard.m_ptrAndControlBlocks.find(ID);
+				if (entryItr != shard.m_ptrAndControlBlocks.end())
 				{
 					PtrAndControl& ptrAndCtrl = entryItr->second;
 					if (ptrAndCtrl.m_control->m_refCount.load(std::memory_order_acquire) == 0)
@@ -306,9 +344,10 @@ namespace core
 							"Ref count is 0, but state is not Released. This should not be possible");
 
 						ptrAndCtrl.m_object->Destroy();
-						m_ptrAndControlBlocks.erase(ID);
+						shard.m_ptrAndControlBlocks.erase(entryItr);
 					}
-				}				
+				}
+				writeLock.unlock();
 
 				m_deferredRelease.pop();
 			}
@@ -322,21 +361,23 @@ namespace core
 	void ResourceSystem<T>::Release(util::HashKey ID)
 	{
 		bool immediatelyReleased = false;
+		Shard& shard = GetShard(ID);
 		{
-			std::unique_lock<std::shared_mutex> writeLock(m_ptrAndControlBlocksMutex);
+			std::unique_lock<std::shared_mutex> writeLock(shard.m_ptrAndControlBlocksMutex);
 
-			SEAssert(m_ptrAndControlBlocks.contains(ID),
+			auto entryItr = shard.m_ptrAndControlBlocks.find(ID);
+			SEAssert(entryItr != shard.m_ptrAndControlBlocks.end(),
 				"Trying to release an ID that doesn't exist. This should not be possible");
 
-			if (m_ptrAndControlBlocks.at(ID).m_retentionPolicy == core::RetentionPolicy::ForceNew)
+			if (entryItr->second.m_retentionPolicy == core::RetentionPolicy::ForceNew)
 			{
-				SEAssert(m_ptrAndControlBlocks.at(ID).m_control->m_refCount.load(std::memory_order_acquire) == 0 &&
-					m_ptrAndControlBlocks.at(ID).m_control->m_state.load(
+				SEAssert(entryItr->second.m_control->m_refCount.load(std::memory_order_acquire) == 0 &&
+					entryItr->second.m_control->m_state.load(
 						std::memory_order_acquire) == core::ResourceState::Released,
 					"Immediately-released resources must have a ref. count of 0 and Released state");
 
-				m_ptrAndControlBlocks.at(ID).m_object->Destroy();
-				m_ptrAndControlBlocks.erase(ID);
+				entryItr->second.m_object->Destroy();
+				shard.m_ptrAndControlBlocks.erase(entryItr);
 
 				immediatelyReleased = true;
 			}
@@ -3,31 +3,206 @@
 #include "Config.h"
 #include "ThreadPool.h"
 #include "Logger.h"
+#include "ProfilingMarkers.h"
+#include "TraceCapture.h"
 
 #include "Util/CastUtils.h"
 
 
+namespace
+{
+	// Fixed-size pool of Job-sized memory slots. Slots are recycled through a lock-free queue, as Jobs are typically
+	// created and destroyed on different threads
+	class JobPool final
+	{
+	public:
+		static constexpr size_t k_numSlots = 8192;
+
+		JobPool()
+			: m_slots(std::make_unique<JobSlot[]>(k_numSlots))
+			, m_freeSlots(k_numSlots)
+		{
+			for (size_t slotIdx = 0; slotIdx < k_numSlots; ++slotIdx)
+			{
+				m_freeSlots.TryEnqueue(&m_slots[slotIdx]);
+			}
+		}
+
+		void* Allocate()
+		{
+			JobSlot* slot = nullptr;
+			if (m_freeSlots.TryDequeue(slot))
+			{
+				return slot;
+			}
+			return ::operator new(sizeof(core::Job)); // Pool is exhausted
+		}
+
+		void Free(void* jobMemory)
+		{
+			JobSlot* slot = static_cast<JobSlot*>(jobMemory);
+			if (slot >= &m_slots[0] && slot < &m_slots[0] + k_numSlots)
+			{
+				// The queue can hold every slot, so it's never truly full: TryEnqueue can only fail transiently, while
+				// a concurrent TryDequeue has claimed (but not yet released) the cell we're wrapping around to
+				while (!m_freeSlots.TryEnqueue(slot))
+				{
+					std::this_thread::yield();
+				}
+			}
+			else
+			{
+				::operator delete(jobMemory);
+			}
+		}
+
+
+	private:
+		struct JobSlot
+		{
+			alignas(core::Job) std::byte m_bytes[sizeof(core::Job)];
+		};
+
+		std::unique_ptr<JobSlot[]> m_slots;
+		util::MPMCQueue<JobSlot*> m_freeSlots;
+	};
+	JobPool s_jobPool;
+}
+
+
 namespace core
 {
+	FunctionWrapper::FunctionWrapper(FunctionWrapper&& other) noexcept
+		: m_ops(other.m_ops)
+	{
+		if (m_ops)
+		{
+			m_ops->Move(m_storage, other.m_storage);
+			other.m_ops = nullptr;
+		}
+	}
+
+
 	FunctionWrapper& FunctionWrapper::operator=(FunctionWrapper&& other) noexcept
 	{
-		m_impl = std::move(other.m_impl);
+		if (&other != this)
+		{
+			if (m_ops)
+			{
+				m_ops->Destroy(m_storage);
+			}
+
+			m_ops = other.m_ops;
+			if (m_ops)
+			{
+				m_ops->Move(m_storage, other.m_storage);
+				other.m_ops = nullptr;
+			}
+		}
 		return *this;
 	}
 
 
+	FunctionWrapper::~FunctionWrapper()
+	{
+		if (m_ops)
+		{
+			m_ops->Destroy(m_storage);
+		}
+	}
+
+
+	// ---
+
+
+	JobCounter::JobCounter()
+		: m_count(0)
+		, m_numDecrementsInFlight(0)
+	{
+	}
+
+
+	JobCounter::~JobCounter()
+	{
+		SEAssert(m_count.load() == 0 && m_numDecrementsInFlight.load() == 0,
+			"JobCounter destroyed while jobs are still in flight. Use ThreadPool::WaitForCounter");
+		SEAssert(m_continuations.empty(), "JobCounter destroyed with unscheduled continuations");
+	}
+
+
+	bool JobCounter::IsDone() const
+	{
+		return m_count.load() == 0;
+	}
+
+
+	void JobCounter::Increment()
+	{
+		m_count.fetch_add(1);
+	}
+
+
+	void JobCounter::Decrement()
+	{
+		// The waiting thread may destroy us as soon as it observes m_count == 0, so we record that we're still in
+		// use BEFORE we decrement, and release it as the very last thing we do
+		m_numDecrementsInFlight.fetch_add(1);
+
+		if (m_count.fetch_sub(1) == 1)
+		{
+			std::vector<Job*> continuations;
+			{
+				std::lock_guard<std::mutex> lock(m_continuationsMutex);
+				continuations.swap(m_continuations);
+			}
+
+			m_count.notify_all(); // Wake any sleeping waiters
+
+			for (Job* continuation : continuations)
+			{
+				ThreadPool::Schedule(continuation);
+			}
+		}
+
+		m_numDecrementsInFlight.fetch_sub(1);
+	}
+
+
+	void JobCounter::AddContinuation(Job* continuation)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_continuationsMutex);
+
+			// If the count is not 0, the Decrement() that takes it to 0 will lock the mutex (and schedule the
+			// continuation) after we've released it
+			if (m_count.load() != 0)
+			{
+				m_continuations.emplace_back(continuation);
+				return;
+			}
+		}
+		ThreadPool::Schedule(continuation); // Dependency already satisfied
+	}
+
+
 	// ---
 
 
-	bool ThreadPool::s_isRunning = false;
+	std::atomic<bool> ThreadPool::s_isRunning = false;
 
-	std::mutex ThreadPool::s_jobQueueMutex;
-	std::condition_variable ThreadPool::s_jobQueueCV;
+	std::vector<std::unique_ptr<util::WorkStealingDeque<Job*>>> ThreadPool::s_workerQueues;
+	util::MPMCQueue<Job*> ThreadPool::s_injectionQueue(ThreadPool::k_injectionQueueCapacity);
+	std::vector<std::unique_ptr<util::WorkStealingDeque<Job*>>> ThreadPool::s_longLivedWorkerQueues;
+	util::MPMCQueue<Job*> ThreadPool::s_longLivedJobQueue(ThreadPool::k_injectionQueueCapacity);
 
-	std::queue<FunctionWrapper> ThreadPool::s_jobQueue;
+	std::atomic<uint32_t> ThreadPool::s_workEpoch = 0;
+	std::atomic<uint32_t> ThreadPool::s_numSleepingWorkers = 0;
 
 	std::vector<std::thread> ThreadPool::s_workerThreads;
 
+	thread_local size_t ThreadPool::s_currentWorkerIdx = ThreadPool::k_invalidWorkerIdx;
+	thread_local uint32_t ThreadPool::s_helpDepth = 0;
+
 
 	void ThreadPool::Startup()
 	{
@@ -39,25 +214,33 @@ namespace core
 		if (Config::KeyExists(configkeys::k_numWorkerThreads))
 		{
 			actualNumThreads = util::CheckedCast<size_t>(Config::GetValue<int>(configkeys::k_numWorkerThreads));
-		}		
+		}
+
+		// The worker queues must all exist before any worker starts trying to steal from them
+		s_workerQueues.reserve(actualNumThreads);
+		s_longLivedWorkerQueues.reserve(actualNumThreads);
+		for (size_t i = 0; i < actualNumThreads; ++i)
+		{
+			s_workerQueues.emplace_back(std::make_unique<util::WorkStealingDeque<Job*>>());
+			s_longLivedWorkerQueues.emplace_back(std::make_unique<util::WorkStealingDeque<Job*>>());
+		}
 
 		s_isRunning = true; // Must be true BEFORE a new thread checks this in ExecuteJobs()
 
 		for (size_t i = 0; i < actualNumThreads; ++i)
 		{
-			AddWorkerThread();
+			AddWorkerThread(i);
 		}
 	}
 
 
 	void ThreadPool::Stop()
 	{
-		{
-			std::unique_lock<std::mutex> waitingLock(s_jobQueueMutex);
+		s_isRunning = false;
 
-			s_isRunning = false;			
-		}
-		s_jobQueueCV.notify_all();
+		// Wake everyone up so they can observe that we've stopped running:
+		s_workEpoch.fetch_add(1);
+		s_workEpoch.notify_all();
 
 		// Wait for all of our threads to complete:
 		for (auto& thread : s_workerThreads)
@@ -65,32 +248,272 @@ namespace core
 			thread.join();
 		}
 		s_workerThreads.clear();
+
+		// Destroy any jobs that were never executed:
+		Job* abandonedJob = nullptr;
+		for (auto& workerQueue : s_workerQueues)
+		{
+			while (workerQueue->Pop(abandonedJob))
+			{
+				DestroyJob(abandonedJob);
+			}
+		}
+		s_workerQueues.clear();
+
+		for (auto& workerQueue : s_longLivedWorkerQueues)
+		{
+			while (workerQueue->Pop(abandonedJob))
+			{
+				DestroyJob(abandonedJob);
+			}
+		}
+		s_longLivedWorkerQueues.clear();
+
+		while (s_injectionQueue.TryDequeue(abandonedJob))
+		{
+			DestroyJob(abandonedJob);
+		}
+		while (s_longLivedJobQueue.TryDequeue(abandonedJob))
+		{
+			DestroyJob(abandonedJob);
+		}
+	}
+
+
+	void ThreadPool::Schedule(Job* job)
+	{
+		if (s_currentWorkerIdx != k_invalidWorkerIdx)
+		{
+			// Unbounded: Workers must never block on a full queue, as they may be the only ones able to drain it
+			if (job->m_canExecuteWhileWaiting)
+			{
+				s_workerQueues[s_currentWorkerIdx]->Push(job);
+			}
+			else
+			{
+				s_longLivedWorkerQueues[s_currentWorkerIdx]->Push(job);
+			}
+		}
+		else
+		{
+			// The queues are bounded: If it's full, give the workers a chance to drain it
+			util::MPMCQueue<Job*>& queue = job->m_canExecuteWhileWaiting ? s_injectionQueue : s_longLivedJobQueue;
+			while (!queue.TryEnqueue(job))
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		// Bump the epoch so any worker that is about to sleep sees there is new work. Both operations are seq_cst to
+		// pair with the sleeping worker incrementing s_numSleepingWorkers before it waits on the epoch
+		s_workEpoch.fetch_add(1);
+		if (s_numSleepingWorkers.load() > 0)
+		{
+			s_workEpoch.notify_one();
+		}
+	}
+
+
+	Job* ThreadPool::FindJob(size_t workerIdx, bool includeLongLivedJobs)
+	{
+		Job* job = nullptr;
+
+		// Our own work first (LIFO, for cache locality):
+		if (workerIdx != k_invalidWorkerIdx && s_workerQueues[workerIdx]->Pop(job))
+		{
+			return job;
+		}
+
+		// Then work enqueued from outside of the pool:
+		if (s_injectionQueue.TryDequeue(job))
+		{
+			return job;
+		}
+
+		// Long-lived jobs are only taken by idle workers, and we prefer our own
+		if (includeLongLivedJobs &&
+			((workerIdx != k_invalidWorkerIdx && s_longLivedWorkerQueues[workerIdx]->Pop(job)) ||
+				s_longLivedJobQueue.TryDequeue(job)))
+		{
+			return job;
+		}
+
+		// Finally, try and steal from the other workers. We start from a different victim each time to spread the
+		// contention around
+		static thread_local uint32_t s_victimSeed = 
+			static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())) | 1;
+		s_victimSeed ^= s_victimSeed << 13;
+		s_victimSeed ^= s_victimSeed >> 17;
+		s_victimSeed ^= s_victimSeed << 5;
+
+		const size_t numWorkers = s_workerQueues.size();
+		if (numWorkers == 0)
+		{
+			return nullptr;
+		}
+
+		const size_t firstVictim = s_victimSeed % numWorkers;
+		for (size_t i = 0; i < numWorkers; ++i)
+		{
+			const size_t victimIdx = (firstVictim + i) % numWorkers;
+			if (victimIdx != workerIdx && s_workerQueues[victimIdx]->Steal(job))
+			{
+				return job;
+			}
+		}
+
+		if (includeLongLivedJobs)
+		{
+			for (size_t i = 0; i < numWorkers; ++i)
+			{
+				const size_t victimIdx = (firstVictim + i) % numWorkers;
+				if (victimIdx != workerIdx && s_longLivedWorkerQueues[victimIdx]->Steal(job))
+				{
+					return job;
+				}
+			}
+		}
+
+		return nullptr;
+	}
+
+
+	void ThreadPool::ExecuteJob(Job* job)
+	{
+		job->m_function(); // Do the work
+
+		JobCounter* counter = job->m_counter;
+
+		// Destroy the job before we signal the counter: Its captures may reference the waiting thread's stack
+		DestroyJob(job);
+
+		if (counter)
+		{
+			counter->Decrement();
+		}
+	}
+
+
+	void ThreadPool::DestroyJob(Job* job)
+	{
+		job->~Job();
+		FreeJobMemory(job);
+	}
+
+
+	void* ThreadPool::AllocateJobMemory()
+	{
+		return s_jobPool.Allocate();
+	}
+
+
+	void ThreadPool::FreeJobMemory(void* jobMemory)
+	{
+		s_jobPool.Free(jobMemory);
+	}
+
+
+	void ThreadPool::WaitForCounter(JobCounter& counter)
+	{
+		SEBeginCPUEvent("ThreadPool::WaitForCounter");
+
+		uint32_t numFailedAttempts = 0;
+		while (!counter.IsDone())
+		{
+			// We can't risk getting stuck inside a long-lived job, so we only look for JobCounter jobs
+			constexpr bool k_includeLongLivedJobs = false;
+			Job* job = FindJob(s_currentWorkerIdx, k_includeLongLivedJobs);
+			if (job)
+			{
+				SEAssert(job->m_canExecuteWhileWaiting,
+					"Found a long-lived job while waiting, this should not be possible");
+
+				++s_helpDepth;
+				ExecuteJob(job);
+				--s_helpDepth;
+
+				numFailedAttempts = 0;
+				continue;
+			}
+
+			if (++numFailedAttempts < k_numSpinsBeforeSleep)
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			// Nothing left that we can help with: Sleep until the count reaches 0
+			const uint32_t curCount = counter.m_count.load();
+			if (curCount != 0)
+			{
+				counter.m_count.wait(curCount);
+			}
+			numFailedAttempts = 0;
+		}
+
+		// Ensure the thread that took the count to 0 is finished with the counter before we allow it to be destroyed
+		while (counter.m_numDecrementsInFlight.load() != 0)
+		{
+			std::this_thread::yield();
+		}
+
+		SEEndCPUEvent();
 	}
 
 
-	void ThreadPool::ExecuteJobs()
+	size_t ThreadPool::GetNumWorkerThreads()
 	{
+		return s_workerQueues.size();
+	}
+
+
+	uint32_t ThreadPool::GetHelpDepth()
+	{
+		return s_helpDepth;
+	}
+
+
+	void ThreadPool::ExecuteJobs(size_t workerIdx)
+	{
+		s_currentWorkerIdx = workerIdx;
+
+		core::TraceCapture::SetCurrentThreadName(std::format("Worker Thread {}", workerIdx).c_str());
+
+		uint32_t numFailedAttempts = 0;
 		while (s_isRunning)
 		{
-			// Aquire the lock and get a job, or wait if no jobs exist:
-			std::unique_lock<std::mutex> waitingLock(s_jobQueueMutex);
-			s_jobQueueCV.wait(
-				waitingLock, 
-				[](){ return !s_jobQueue.empty() || !s_isRunning;}); // False if waiting should continue
-			
-			if (!s_isRunning)
+			// Sample the epoch BEFORE we look for work: If a job is scheduled after we've looked, the epoch will have
+			// changed and our wait below will return immediately
+			const uint32_t epoch = s_workEpoch.load();
+
+			constexpr bool k_includeLongLivedJobs = true;
+			Job* currentJob = FindJob(workerIdx, k_includeLongLivedJobs);
+			if (currentJob)
 			{
-				return;
+				ExecuteJob(currentJob);
+
+				numFailedAttempts = 0;
+				continue;
 			}
 
-			// Get the job from the queue:
-			FunctionWrapper currentJob = std::move(s_jobQueue.front());
-			s_jobQueue.pop();
+			// Briefly spin before going to sleep, as fork-join phases tend to schedule work in quick bursts
+			if (++numFailedAttempts < k_numSpinsBeforeSleep)
+			{
+				std::this_thread::yield();
+				continue;
+			}
 
-			waitingLock.unlock();
+			s_numSleepingWorkers.fetch_add(1);
+			if (s_isRunning)
+			{
+				s_workEpoch.wait(epoch);
+			}
+			s_numSleepingWorkers.fetch_sub(1);
 
-			currentJob(); // Do the work
+			numFailedAttempts = 0;
 		}
+
+		s_currentWorkerIdx = k_invalidWorkerIdx;
 	}
 
 
@@ -101,12 +524,14 @@ namespace core
 			threadName);
 
 		SEAssert(hr >= 0, "Failed to set thread name");
+
+		core::TraceCapture::SetCurrentThreadName(util::FromWideCString(threadName).c_str());
 	}
 
 
-	void ThreadPool::AddWorkerThread()
+	void ThreadPool::AddWorkerThread(size_t workerIdx)
 	{
-		s_workerThreads.emplace_back(std::thread(&ThreadPool::ExecuteJobs));
+		s_workerThreads.emplace_back(std::thread(&ThreadPool::ExecuteJobs, workerIdx));
 
 		const HRESULT hr = ::SetThreadDescription(
 			s_workerThreads.back().native_handle(),
@@ -1,41 +1,82 @@
 //  2022 Adam Badke. All rights reserved.
 #pragma once
+#include "Util/MPMCQueue.h"
+#include "Util/WorkStealingDeque.h"
 
 
 namespace core
 {
+	// Type-erased, move-only callable. Callables that fit within the inline storage (and are nothrow move
+	// constructible) are stored in place, so wrapping a small lambda does not allocate
 	class FunctionWrapper final
 	{
+	public:
+		static constexpr size_t k_inlineStorageByteSize = 96;
+
+
 	public:
 		template<typename Function>
-		FunctionWrapper(Function&& function) : m_impl(new ImplType<Function>(std::forward<Function>(function)))  {}
+		FunctionWrapper(Function&& function);
 	
-		FunctionWrapper(FunctionWrapper&& other) noexcept : m_impl(std::move(other.m_impl)) {}
-
+		FunctionWrapper(FunctionWrapper&& other) noexcept;
 		FunctionWrapper& operator=(FunctionWrapper&& other) noexcept;
 
-		void operator()() { m_impl->Call(); }
+		~FunctionWrapper();
+
+		void operator()() { m_ops->Invoke(m_storage); }
 
 
 	private:
-		struct ImplBase
+		// Per-type function table
+		struct Ops
 		{
-			virtual ~ImplBase() {}
-			virtual inline void Call() = 0;
+			void (*Invoke)(void* storage);
+			void (*Move)(void* dstStorage, void* srcStorage) noexcept; // Move-constructs dst, and destroys src
+			void (*Destroy)(void* storage) noexcept;
 		};
-		std::unique_ptr<ImplBase> m_impl;
 
 		template<typename Function>
-		struct ImplType : ImplBase
+		struct InlineOps
 		{
-			ImplType(Function&& function) noexcept : m_function(std::forward<Function>(function)) {}
+			static void Invoke(void* storage) { (*std::launder(static_cast<Function*>(storage)))(); }
+			static void Move(void* dstStorage, void* srcStorage) noexcept
+			{
+				Function* src = std::launder(static_cast<Function*>(srcStorage));
+				new (dstStorage) Function(std::move(*src));
+				src->~Function();
+			}
+			static void Destroy(void* storage) noexcept { std::launder(static_cast<Function*>(storage))->~Function(); }
 
-			inline void Call() override { m_function(); }
+			static constexpr Ops k_ops = { &Invoke, &Move, &Destroy };
+		};
 
-		private:
-			Function m_function;
+		template<typename Function>
+		struct HeapOps // Fallback for large callables: The inline storage holds a Function*
+		{
+			static void Invoke(void* storage) { (**static_cast<Function**>(storage))(); }
+			static void Move(void* dstStorage, void* srcStorage) noexcept
+			{
+				*static_cast<Function**>(dstStorage) = *static_cast<Function**>(srcStorage);
+			}
+			static void Destroy(void* storage) noexcept { delete *static_cast<Function**>(storage); }
+
+			static constexpr Ops k_ops = { &Invoke, &Move, &Destroy };
 		};
 
+		template<typename Function>
+		static constexpr bool StoreInline()
+		{
+			return sizeof(Function) <= k_inlineStorageByteSize &&
+				alignof(Function) <= alignof(std::max_align_t) &&
+				std::is_nothrow_move_constructible_v<Function>;
+		}
+
+
+	private:
+		alignas(std::max_align_t) std::byte m_storage[k_inlineStorageByteSize];
+		Ops const* m_ops; // nullptr if we've been moved from
+
+
 	private:
 		FunctionWrapper() = delete;
 		FunctionWrapper(const FunctionWrapper&) = delete;
@@ -44,6 +85,84 @@ namespace core
 	};
 
 
+	template<typename Function>
+	FunctionWrapper::FunctionWrapper(Function&& function)
+	{
+		using FunctionType = std::decay_t<Function>;
+
+		if constexpr (StoreInline<FunctionType>())
+		{
+			new (m_storage) FunctionType(std::forward<Function>(function));
+			m_ops = &InlineOps<FunctionType>::k_ops;
+		}
+		else
+		{
+			*reinterpret_cast<FunctionType**>(m_storage) = new FunctionType(std::forward<Function>(function));
+			m_ops = &HeapOps<FunctionType>::k_ops;
+		}
+	}
+
+
+	class JobCounter;
+
+
+	// Internal: The unit of work stored in the ThreadPool queues
+	struct Job final
+	{
+		template<typename Function>
+		Job(Function&& function, JobCounter* counter, bool canExecuteWhileWaiting)
+			: m_function(std::forward<Function>(function))
+			, m_counter(counter)
+			, m_canExecuteWhileWaiting(canExecuteWhileWaiting)
+		{}
+
+		FunctionWrapper m_function;
+		JobCounter* m_counter; // Optional: Decremented once m_function has been executed
+
+		// Jobs returning a std::future may be long-lived (e.g. the render/logger threads), so we only allow threads
+		// that are waiting on a JobCounter to execute JobCounter jobs. Long-lived jobs are kept in their own queue so
+		// waiting threads never have to dequeue them
+		bool m_canExecuteWhileWaiting;
+	};
+
+
+	// A fence for a group of jobs: Incremented when a job is enqueued against it, and decremented when the job has
+	// finished executing. Continuations enqueued against a JobCounter are scheduled once it reaches 0.
+	// Note: JobCounters can be reused, but must not be destroyed until ThreadPool::WaitForCounter has returned
+	class JobCounter final
+	{
+	public:
+		JobCounter();
+		~JobCounter();
+
+		bool IsDone() const;
+
+
+	private:
+		friend class ThreadPool;
+
+		void Increment();
+		void Decrement(); // Schedules any continuations when the count reaches 0
+
+		void AddContinuation(Job*);
+
+
+	private:
+		std::atomic<uint32_t> m_count;
+		std::atomic<uint32_t> m_numDecrementsInFlight; // Prevents the waiter destroying us while we're still in use
+
+		std::mutex m_continuationsMutex;
+		std::vector<Job*> m_continuations;
+
+
+	private: // No copying allowed
+		JobCounter(JobCounter const&) = delete;
+		JobCounter(JobCounter&&) noexcept = delete;
+		JobCounter& operator=(JobCounter const&) = delete;
+		JobCounter& operator=(JobCounter&&) noexcept = delete;
+	};
+
+
 	class ThreadPool final
 	{
 	public:
@@ -53,24 +172,91 @@ namespace core
 		template<typename FunctionType>
 		static std::future<typename std::invoke_result<FunctionType>::type> EnqueueJob(FunctionType job); // Producer
 
+
+	public: // Job graph:
+		template<typename FunctionType>
+		static void EnqueueJob(FunctionType job, JobCounter& counter);
+
+		// Schedule a job to run once the dependency counter has reached 0. The (optional) counter is incremented
+		// immediately, so it can be waited on to determine when the continuation has finished executing
+		template<typename FunctionType>
+		static void EnqueueContinuation(JobCounter& dependency, FunctionType job, JobCounter* counter = nullptr);
+
+		// Help-while-waiting: The calling thread executes pending jobs until the counter reaches 0
+		static void WaitForCounter(JobCounter&);
+
+		// Split the [begin, end) range into chunks, and execute rangeFunction(chunkBegin, chunkEnd) on each in
+		// parallel. The calling thread executes the first chunk, and then helps until all chunks are complete.
+		// A grainSize of 0 automatically sizes the chunks based on the number of worker threads
+		template<typename RangeFunctionType>
+		static void ParallelForRange(size_t begin, size_t end, RangeFunctionType&& rangeFunction, size_t grainSize = 0);
+
+		// Convenience wrapper for ParallelForRange: Executes indexFunction(idx) for every index in [begin, end)
+		template<typename IndexFunctionType>
+		static void ParallelFor(size_t begin, size_t end, IndexFunctionType&& indexFunction, size_t grainSize = 0);
+
+		static size_t GetNumWorkerThreads();
+
+		// The number of jobs the calling thread is nested within while helping (i.e. executing jobs from within
+		// WaitForCounter). Lets thread-local state established by a job be scoped to it, rather than leaking into
+		// unrelated jobs the thread executes while that job waits
+		static uint32_t GetHelpDepth();
+
+
+	public:
 		static void NameCurrentThread(wchar_t const* threadName);
 
 	private:
-		static void ExecuteJobs(); // Consumer loop
+		friend class JobCounter;
+
+		// Pushes to the local deques if called from a worker thread. Long-lived jobs are kept separate from JobCounter
+		// jobs, so waiting threads never have to dequeue them
+		static void Schedule(Job*);
+
+		static void ExecuteJobs(size_t workerIdx); // Consumer loop
+
+		static Job* FindJob(size_t workerIdx, bool includeLongLivedJobs);
+
+		static void ExecuteJob(Job*);
+
+		// Jobs are placement-constructed in a fixed pool of slots, and only fall back to the heap if the pool is
+		// exhausted
+		template<typename FunctionType>
+		static Job* CreateJob(FunctionType&&, JobCounter*, bool canExecuteWhileWaiting);
+		static void DestroyJob(Job*);
+
+		static void* AllocateJobMemory();
+		static void FreeJobMemory(void*);
 
-		static void AddWorkerThread();
+		static void AddWorkerThread(size_t workerIdx);
 
 
 	private:
-		static bool s_isRunning;
+		static std::atomic<bool> s_isRunning;
 
-		static std::mutex s_jobQueueMutex;
-		static std::condition_variable s_jobQueueCV;
+		// Each worker owns a work-stealing deque: Jobs enqueued from a worker thread are pushed to its own deque, and
+		// idle workers steal from the others. Jobs enqueued from any other thread go into the global injection queue
+		static std::vector<std::unique_ptr<util::WorkStealingDeque<Job*>>> s_workerQueues;
+		static util::MPMCQueue<Job*> s_injectionQueue;
 
-		static std::queue<FunctionWrapper> s_jobQueue;
+		// Jobs that cannot be executed while waiting (i.e. std::future jobs) are only ever dequeued by idle workers
+		static std::vector<std::unique_ptr<util::WorkStealingDeque<Job*>>> s_longLivedWorkerQueues;
+		static util::MPMCQueue<Job*> s_longLivedJobQueue;
+
+		// Idle workers sleep on the work epoch, which is bumped every time a job is scheduled
+		static std::atomic<uint32_t> s_workEpoch;
+		static std::atomic<uint32_t> s_numSleepingWorkers;
 
 		static std::vector<std::thread> s_workerThreads;
 
+		static thread_local size_t s_currentWorkerIdx;
+		static thread_local uint32_t s_helpDepth;
+		static constexpr size_t k_invalidWorkerIdx = std::numeric_limits<size_t>::max();
+
+		static constexpr size_t k_injectionQueueCapacity = 8192;
+		static constexpr uint32_t k_numSpinsBeforeSleep = 64;
+		static constexpr size_t k_parallelForChunksPerThread = 4; // Over-subscribe to balance uneven chunk costs
+
 
 	private: // Static class only
 		ThreadPool() = delete;
@@ -82,6 +268,13 @@ namespace core
 	};
 
 
+	template<typename FunctionType>
+	Job* ThreadPool::CreateJob(FunctionType&& function, JobCounter* counter, bool canExecuteWhileWaiting)
+	{
+		return new (AllocateJobMemory()) Job(std::forward<FunctionType>(function), counter, canExecuteWhileWaiting);
+	}
+
+
 	template<typename FunctionType>
 	std::future<typename std::invoke_result<FunctionType>::type> ThreadPool::EnqueueJob(FunctionType job)
 	{
@@ -90,14 +283,87 @@ namespace core
 		std::packaged_task<resultType()> packagedTask(std::move(job));
 		std::future<resultType> taskFuture(packagedTask.get_future());
 
-		// Add the task to our queue:
+		constexpr bool k_canExecuteWhileWaiting = false;
+		Schedule(CreateJob(std::move(packagedTask), nullptr, k_canExecuteWhileWaiting));
+
+		return taskFuture;
+	}
+
+
+	template<typename FunctionType>
+	void ThreadPool::EnqueueJob(FunctionType job, JobCounter& counter)
+	{
+		counter.Increment();
+
+		constexpr bool k_canExecuteWhileWaiting = true;
+		Schedule(CreateJob(std::move(job), &counter, k_canExecuteWhileWaiting));
+	}
+
+
+	template<typename FunctionType>
+	void ThreadPool::EnqueueContinuation(JobCounter& dependency, FunctionType job, JobCounter* counter /*= nullptr*/)
+	{
+		if (counter)
 		{
-			std::unique_lock<std::mutex> waitingLock(s_jobQueueMutex);
-			s_jobQueue.push(std::move(packagedTask));
+			counter->Increment();
 		}
 
-		s_jobQueueCV.notify_one();
+		constexpr bool k_canExecuteWhileWaiting = true;
+		dependency.AddContinuation(CreateJob(std::move(job), counter, k_canExecuteWhileWaiting));
+	}
 
-		return taskFuture;
+
+	template<typename RangeFunctionType>
+	void ThreadPool::ParallelForRange(
+		size_t begin, size_t end, RangeFunctionType&& rangeFunction, size_t grainSize /*= 0*/)
+	{
+		if (end <= begin)
+		{
+			return;
+		}
+		const size_t numItems = end - begin;
+
+		if (grainSize == 0)
+		{
+			// +1 for the calling thread, which also executes chunks
+			const size_t numChunks = (GetNumWorkerThreads() + 1) * k_parallelForChunksPerThread;
+			grainSize = std::max<size_t>((numItems + numChunks - 1) / numChunks, 1);
+		}
+
+		if (numItems <= grainSize)
+		{
+			rangeFunction(begin, end); // Not worth distributing
+			return;
+		}
+
+		JobCounter chunkCounter;
+		for (size_t chunkBegin = begin + grainSize; chunkBegin < end; chunkBegin += grainSize)
+		{
+			const size_t chunkEnd = std::min(chunkBegin + grainSize, end);
+			EnqueueJob([&rangeFunction, chunkBegin, chunkEnd]()
+				{
+					rangeFunction(chunkBegin, chunkEnd);
+				},
+				chunkCounter);
+		}
+
+		rangeFunction(begin, begin + grainSize); // Execute the first chunk ourselves
+
+		WaitForCounter(chunkCounter);
+	}
+
+
+	template<typename IndexFunctionType>
+	void ThreadPool::ParallelFor(size_t begin, size_t end, IndexFunctionType&& indexFunction, size_t grainSize /*= 0*/)
+	{
+		ParallelForRange(begin, end, 
+			[&indexFunction](size_t chunkBegin, size_t chunkEnd)
+			{
+				for (size_t idx = chunkBegin; idx < chunkEnd; ++idx)
+				{
+					indexFunction(idx);
+				}
+			},
+			grainSize);
 	}
 }
\ No newline at end of file
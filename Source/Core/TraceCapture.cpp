@@ -0,0 +1,604 @@
+// © 2025 Adam Badke. All rights reserved.
+#include "Assert.h"
+#include "Logger.h"
+#include "ThreadPool.h"
+#include "TraceCapture.h"
+
+#include "Definitions/ConfigKeys.h"
+
+#include "Util/TextUtils.h"
+
+
+namespace
+{
+	struct TraceEvent
+	{
+		int64_t m_timestampNs;
+		uint64_t m_nameHash; // k_endEventNameHash for end events
+	};
+	constexpr uint64_t k_endEventNameHash = 0;
+
+	constexpr char const* k_frameEventName = "Frame";
+
+
+	// Binary trace file layout:
+	// FileHeader
+	// FileHeader::m_numNames x { uint64_t nameHash, uint32_t nameLength, char[nameLength] }
+	// FileHeader::m_numThreads x { uint32_t threadIdx, uint32_t nameLength, char[nameLength], uint64_t numEvents,
+	//	TraceEvent[numEvents] }
+	struct FileHeader
+	{
+		char m_magic[8];
+		uint32_t m_version;
+		uint32_t m_numNames;
+		uint32_t m_numThreads;
+		uint32_t m_numFrames;
+		int64_t m_captureStartNs;
+	};
+	constexpr char k_traceFileMagic[8] = { 'S', 'E', 'T', 'R', 'A', 'C', 'E', '\0' };
+	constexpr uint32_t k_traceFileVersion = 1;
+
+
+	// Per-thread event storage: A linked list of fixed-size chunks. Only the owning thread appends; the capture thread
+	// reads published events once the capture has finished
+	class ThreadBuffer final
+	{
+	public:
+		struct Chunk
+		{
+			static constexpr uint32_t k_numEvents = 4096;
+
+			std::array<TraceEvent, k_numEvents> m_events;
+			std::atomic<uint32_t> m_numEvents = 0;
+			std::atomic<Chunk*> m_next = nullptr;
+		};
+
+
+	public:
+		ThreadBuffer(uint32_t threadIdx)
+			: m_firstChunk(new Chunk())
+			, m_currentChunk(m_firstChunk)
+			, m_captureIdx(0)
+			, m_threadIdx(threadIdx)
+			, m_threadName(std::format("Thread {}", threadIdx))
+			, m_hasOwner(true)
+		{
+		}
+
+
+		void Append(TraceEvent const& traceEvent) // Owner thread only
+		{
+			uint32_t numEvents = m_currentChunk->m_numEvents.load(std::memory_order_relaxed);
+			if (numEvents == Chunk::k_numEvents)
+			{
+				Chunk* nextChunk = m_currentChunk->m_next.load(std::memory_order_relaxed);
+				if (nextChunk == nullptr) // Chunks are reused between captures; we only allocate when we grow
+				{
+					nextChunk = new Chunk();
+					m_currentChunk->m_next.store(nextChunk, std::memory_order_release);
+				}
+				m_currentChunk = nextChunk;
+				numEvents = 0;
+			}
+
+			m_currentChunk->m_events[numEvents] = traceEvent;
+			m_currentChunk->m_numEvents.store(numEvents + 1, std::memory_order_release);
+		}
+
+
+		void Reset(uint64_t captureIdx) // Owner thread only
+		{
+			for (Chunk* chunk = m_firstChunk; chunk != nullptr; chunk = chunk->m_next.load(std::memory_order_relaxed))
+			{
+				chunk->m_numEvents.store(0, std::memory_order_relaxed);
+			}
+			m_currentChunk = m_firstChunk;
+
+			m_captureIdx.store(captureIdx, std::memory_order_release);
+		}
+
+
+		template<typename Visitor>
+		void ForEachChunk(Visitor&& visitor) const // Reader: Visits the published events
+		{
+			for (Chunk const* chunk = m_firstChunk; chunk != nullptr; chunk = chunk->m_next.load(std::memory_order_acquire))
+			{
+				const uint32_t numEvents = chunk->m_numEvents.load(std::memory_order_acquire);
+				if (numEvents > 0)
+				{
+					visitor(chunk->m_events.data(), numEvents);
+				}
+				if (numEvents < Chunk::k_numEvents)
+				{
+					break;
+				}
+			}
+		}
+
+
+	public:
+		Chunk* const m_firstChunk; // Never freed: Threads may outlive the capture system
+		Chunk* m_currentChunk; // Owner thread only
+
+		std::atomic<uint64_t> m_captureIdx; // The capture our events belong to
+		const uint32_t m_threadIdx;
+		std::string m_threadName; // Guarded by s_namesMutex
+
+		std::unordered_set<uint64_t> m_knownNameHashes; // Owner thread only: Names already added to s_names
+
+		std::atomic<bool> m_hasOwner; // Buffers are recycled once their thread exits
+	};
+
+
+	constexpr uint32_t k_maxTraceThreads = 256;
+	std::array<std::atomic<ThreadBuffer*>, k_maxTraceThreads> s_threadBuffers{};
+	std::atomic<uint32_t> s_numThreadBuffers = 0;
+	std::mutex s_threadBufferRegistrationMutex;
+
+	std::unordered_map<uint64_t, std::string> s_names; // Name hash -> name
+	std::mutex s_namesMutex;
+
+	std::atomic<uint64_t> s_captureIdx = 0; // 0 is never captured
+
+	// Main thread only:
+	uint32_t s_numFramesRemaining = 0;
+	uint32_t s_numCaptureFrames = 0;
+	int64_t s_captureStartNs = 0;
+
+
+	struct ThreadBufferHandle
+	{
+		ThreadBuffer* m_buffer = nullptr;
+
+		~ThreadBufferHandle()
+		{
+			if (m_buffer)
+			{
+				m_buffer->m_hasOwner.store(false, std::memory_order_release);
+			}
+		}
+	};
+	thread_local ThreadBufferHandle s_threadBufferHandle;
+
+
+	ThreadBuffer* GetThreadBuffer()
+	{
+		if (s_threadBufferHandle.m_buffer != nullptr)
+		{
+			return s_threadBufferHandle.m_buffer;
+		}
+
+		std::lock_guard<std::mutex> lock(s_threadBufferRegistrationMutex);
+
+		// Recycle a buffer from an exited thread, as long as it doesn't hold events for the current capture
+		const uint64_t captureIdx = s_captureIdx.load(std::memory_order_acquire);
+		const uint32_t numThreadBuffers = s_numThreadBuffers.load(std::memory_order_relaxed);
+		for (uint32_t bufferIdx = 0; bufferIdx < numThreadBuffers; ++bufferIdx)
+		{
+			ThreadBuffer* buffer = s_threadBuffers[bufferIdx].load(std::memory_order_relaxed);
+			if (!buffer->m_hasOwner.load(std::memory_order_acquire) &&
+				buffer->m_captureIdx.load(std::memory_order_acquire) != captureIdx)
+			{
+				buffer->m_hasOwner.store(true, std::memory_order_relaxed);
+				{
+					std::lock_guard<std::mutex> namesLock(s_namesMutex);
+					buffer->m_threadName = std::format("Thread {}", buffer->m_threadIdx);
+				}
+				s_threadBufferHandle.m_buffer = buffer;
+				return buffer;
+			}
+		}
+
+		if (numThreadBuffers == k_maxTraceThreads)
+		{
+			return nullptr;
+		}
+
+		ThreadBuffer* newBuffer = new ThreadBuffer(numThreadBuffers);
+		s_threadBuffers[numThreadBuffers].store(newBuffer, std::memory_order_relaxed);
+		s_numThreadBuffers.store(numThreadBuffers + 1, std::memory_order_release);
+
+		s_threadBufferHandle.m_buffer = newBuffer;
+		return newBuffer;
+	}
+
+
+	inline int64_t GetTimestampNs()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+
+	inline uint64_t HashEventName(char const* name)
+	{
+		// FNV-1a: We hash the contents, as names are not guaranteed to be string literals (e.g. GetName().c_str())
+		uint64_t hash = 14695981039346656037ull;
+		for (char const* c = name; *c != '\0'; ++c)
+		{
+			hash = (hash ^ static_cast<uint64_t>(*c)) * 1099511628211ull;
+		}
+		return hash == k_endEventNameHash ? 1 : hash;
+	}
+
+
+	ThreadBuffer* GetCurrentCaptureThreadBuffer()
+	{
+		ThreadBuffer* buffer = GetThreadBuffer();
+		if (buffer != nullptr)
+		{
+			const uint64_t captureIdx = s_captureIdx.load(std::memory_order_acquire);
+			if (buffer->m_captureIdx.load(std::memory_order_relaxed) != captureIdx)
+			{
+				buffer->Reset(captureIdx); // First event of a new capture
+			}
+		}
+		return buffer;
+	}
+
+
+	void WriteString(std::ofstream& stream, std::string const& str)
+	{
+		const uint32_t length = static_cast<uint32_t>(str.size());
+		stream.write(reinterpret_cast<char const*>(&length), sizeof(length));
+		stream.write(str.data(), length);
+	}
+
+
+	bool ReadString(std::ifstream& stream, std::string& strOut)
+	{
+		uint32_t length = 0;
+		if (!stream.read(reinterpret_cast<char*>(&length), sizeof(length)))
+		{
+			return false;
+		}
+		strOut.resize(length);
+		return static_cast<bool>(stream.read(strOut.data(), length));
+	}
+
+
+	std::string EscapeJSON(std::string const& str)
+	{
+		std::string result;
+		result.reserve(str.size());
+		for (char c : str)
+		{
+			switch (c)
+			{
+			case '"': result += "\\\""; break;
+			case '\\': result += "\\\\"; break;
+			case '\n': result += "\\n"; break;
+			case '\t': result += "\\t"; break;
+			default:
+			{
+				if (static_cast<unsigned char>(c) < 0x20)
+				{
+					result += std::format("\\u{:04x}", static_cast<uint32_t>(c));
+				}
+				else
+				{
+					result += c;
+				}
+			}
+			}
+		}
+		return result;
+	}
+}
+
+
+namespace core
+{
+	std::atomic<bool> TraceCapture::s_isCapturing = false;
+	std::atomic<uint32_t> TraceCapture::s_numRequestedFrames = 0;
+
+
+	void TraceCapture::RequestCapture(uint32_t numFrames)
+	{
+		SEAssert(numFrames > 0, "Invalid number of frames to capture");
+
+		uint32_t expected = 0;
+		if (!s_numRequestedFrames.compare_exchange_strong(expected, numFrames))
+		{
+			LOG_WARNING("Trace capture already requested, ignoring request");
+		}
+	}
+
+
+	void TraceCapture::BeginFrame()
+	{
+		if (s_isCapturing.load(std::memory_order_relaxed))
+		{
+			RecordEndEvent(); // Close the previous frame
+
+			if (--s_numFramesRemaining == 0)
+			{
+				FinishCapture();
+			}
+		}
+
+		if (!s_isCapturing.load(std::memory_order_relaxed))
+		{
+			const uint32_t numRequestedFrames = s_numRequestedFrames.exchange(0);
+			if (numRequestedFrames > 0)
+			{
+				StartCapture(numRequestedFrames);
+			}
+		}
+
+		if (s_isCapturing.load(std::memory_order_relaxed))
+		{
+			RecordBeginEvent(k_frameEventName);
+		}
+	}
+
+
+	void TraceCapture::RecordBeginEvent(char const* name)
+	{
+		ThreadBuffer* buffer = GetCurrentCaptureThreadBuffer();
+		if (buffer == nullptr)
+		{
+			return;
+		}
+
+		const uint64_t nameHash = HashEventName(name);
+		if (!buffer->m_knownNameHashes.contains(nameHash))
+		{
+			buffer->m_knownNameHashes.emplace(nameHash);
+
+			std::lock_guard<std::mutex> lock(s_namesMutex);
+			s_names.try_emplace(nameHash, name);
+		}
+
+		buffer->Append(TraceEvent{
+			.m_timestampNs = GetTimestampNs(),
+			.m_nameHash = nameHash,
+		});
+	}
+
+
+	void TraceCapture::RecordEndEvent()
+	{
+		ThreadBuffer* buffer = GetCurrentCaptureThreadBuffer();
+		if (buffer == nullptr)
+		{
+			return;
+		}
+
+		buffer->Append(TraceEvent{
+			.m_timestampNs = GetTimestampNs(),
+			.m_nameHash = k_endEventNameHash,
+		});
+	}
+
+
+	void TraceCapture::SetCurrentThreadName(char const* threadName)
+	{
+		ThreadBuffer* buffer = GetThreadBuffer();
+		if (buffer != nullptr)
+		{
+			std::lock_guard<std::mutex> lock(s_namesMutex);
+			buffer->m_threadName = threadName;
+		}
+	}
+
+
+	void TraceCapture::StartCapture(uint32_t numFrames)
+	{
+		LOG("Starting %u frame trace capture", numFrames);
+
+		s_numFramesRemaining = numFrames;
+		s_numCaptureFrames = numFrames;
+		s_captureStartNs = GetTimestampNs();
+
+		s_captureIdx.fetch_add(1, std::memory_order_release);
+		s_isCapturing.store(true, std::memory_order_release);
+	}
+
+
+	void TraceCapture::FinishCapture()
+	{
+		s_isCapturing.store(false, std::memory_order_release);
+
+		// Note: Threads that were already recording when we stopped may still publish an event or two while we're
+		// writing. They're either fully visible to us, or not at all
+		const uint64_t captureIdx = s_captureIdx.load(std::memory_order_acquire);
+
+		std::filesystem::create_directory(core::configkeys::k_traceCaptureOutputDir);
+
+		const std::string traceFilePath = std::format("{}{}_{}{}",
+			core::configkeys::k_traceCaptureOutputDir,
+			core::configkeys::k_captureTitle,
+			util::GetTimeAndDateAsString(),
+			core::configkeys::k_traceCaptureFileExtension);
+
+		std::ofstream traceFile(traceFilePath, std::ios::out | std::ios::binary);
+		if (!traceFile.good())
+		{
+			LOG_ERROR("Failed to create trace capture file \"%s\"", traceFilePath.c_str());
+			return;
+		}
+
+		const uint32_t numThreadBuffers = s_numThreadBuffers.load(std::memory_order_acquire);
+
+		std::vector<ThreadBuffer const*> capturedBuffers;
+		for (uint32_t bufferIdx = 0; bufferIdx < numThreadBuffers; ++bufferIdx)
+		{
+			ThreadBuffer const* buffer = s_threadBuffers[bufferIdx].load(std::memory_order_relaxed);
+			if (buffer->m_captureIdx.load(std::memory_order_acquire) == captureIdx)
+			{
+				capturedBuffers.emplace_back(buffer);
+			}
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(s_namesMutex);
+
+			FileHeader header{
+				.m_version = k_traceFileVersion,
+				.m_numNames = static_cast<uint32_t>(s_names.size()),
+				.m_numThreads = static_cast<uint32_t>(capturedBuffers.size()),
+				.m_numFrames = s_numCaptureFrames,
+				.m_captureStartNs = s_captureStartNs,
+			};
+			memcpy(header.m_magic, k_traceFileMagic, sizeof(k_traceFileMagic));
+			traceFile.write(reinterpret_cast<char const*>(&header), sizeof(header));
+
+			for (auto const& name : s_names)
+			{
+				traceFile.write(reinterpret_cast<char const*>(&name.first), sizeof(name.first));
+				WriteString(traceFile, name.second);
+			}
+
+			for (ThreadBuffer const* buffer : capturedBuffers)
+			{
+				traceFile.write(reinterpret_cast<char const*>(&buffer->m_threadIdx), sizeof(buffer->m_threadIdx));
+				WriteString(traceFile, buffer->m_threadName);
+
+				// Count first, as we write the number of events before the events themselves
+				uint64_t numEvents = 0;
+				buffer->ForEachChunk([&numEvents](TraceEvent const*, uint32_t numChunkEvents)
+					{
+						numEvents += numChunkEvents;
+					});
+				traceFile.write(reinterpret_cast<char const*>(&numEvents), sizeof(numEvents));
+
+				uint64_t numEventsWritten = 0;
+				buffer->ForEachChunk([&traceFile, &numEventsWritten, numEvents]
+					(TraceEvent const* events, uint32_t numChunkEvents)
+					{
+						// A late event may have been published since we counted
+						const uint64_t numToWrite = std::min<uint64_t>(numChunkEvents, numEvents - numEventsWritten);
+						traceFile.write(reinterpret_cast<char const*>(events), numToWrite * sizeof(TraceEvent));
+						numEventsWritten += numToWrite;
+					});
+			}
+		}
+		traceFile.close();
+
+		LOG("Trace capture written to \"%s\"", traceFilePath.c_str());
+
+		// Convert to JSON asynchronously, as it is considerably larger/slower to write
+		core::ThreadPool::EnqueueJob([traceFilePath]()
+			{
+				const std::string jsonFilePath = std::format("{}.json", traceFilePath);
+				if (ConvertToChromeTrace(traceFilePath, jsonFilePath))
+				{
+					LOG("Trace capture converted to \"%s\"", jsonFilePath.c_str());
+				}
+			});
+	}
+
+
+	bool TraceCapture::ConvertToChromeTrace(std::string const& traceFilePath, std::string const& jsonFilePath)
+	{
+		std::ifstream traceFile(traceFilePath, std::ios::in | std::ios::binary);
+		if (!traceFile.good())
+		{
+			LOG_ERROR("Failed to open trace capture file \"%s\"", traceFilePath.c_str());
+			return false;
+		}
+
+		FileHeader header{};
+		if (!traceFile.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+			memcmp(header.m_magic, k_traceFileMagic, sizeof(k_traceFileMagic)) != 0 ||
+			header.m_version != k_traceFileVersion)
+		{
+			LOG_ERROR("\"%s\" is not a valid trace capture file", traceFilePath.c_str());
+			return false;
+		}
+
+		std::unordered_map<uint64_t, std::string> names;
+		for (uint32_t nameIdx = 0; nameIdx < header.m_numNames; ++nameIdx)
+		{
+			uint64_t nameHash = 0;
+			std::string name;
+			if (!traceFile.read(reinterpret_cast<char*>(&nameHash), sizeof(nameHash)) || !ReadString(traceFile, name))
+			{
+				LOG_ERROR("Trace capture file \"%s\" is truncated", traceFilePath.c_str());
+				return false;
+			}
+			names.emplace(nameHash, EscapeJSON(name));
+		}
+
+		std::ofstream jsonFile(jsonFilePath, std::ios::out);
+		if (!jsonFile.good())
+		{
+			LOG_ERROR("Failed to create trace JSON file \"%s\"", jsonFilePath.c_str());
+			return false;
+		}
+
+		jsonFile << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		jsonFile << std::format(
+			"{{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{{\"name\":\"{}\"}}}}",
+			core::configkeys::k_captureTitle);
+
+		std::vector<TraceEvent> events;
+		for (uint32_t threadIdx = 0; threadIdx < header.m_numThreads; ++threadIdx)
+		{
+			uint32_t tid = 0;
+			std::string threadName;
+			uint64_t numEvents = 0;
+			if (!traceFile.read(reinterpret_cast<char*>(&tid), sizeof(tid)) ||
+				!ReadString(traceFile, threadName) ||
+				!traceFile.read(reinterpret_cast<char*>(&numEvents), sizeof(numEvents)))
+			{
+				LOG_ERROR("Trace capture file \"%s\" is truncated", traceFilePath.c_str());
+				return false;
+			}
+
+			events.resize(numEvents);
+			if (!traceFile.read(reinterpret_cast<char*>(events.data()), numEvents * sizeof(TraceEvent)))
+			{
+				LOG_ERROR("Trace capture file \"%s\" is truncated", traceFilePath.c_str());
+				return false;
+			}
+
+			jsonFile << std::format(
+				",\n{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":{},\"args\":{{\"name\":\"{}\"}}}}",
+				tid,
+				EscapeJSON(threadName));
+
+			// Events that began before the capture started have no begin event, and events that were still open
+			// when it finished have no end event: We drop the former, and close the latter
+			uint32_t depth = 0;
+			int64_t lastTimestampNs = header.m_captureStartNs;
+			for (TraceEvent const& traceEvent : events)
+			{
+				const double timestampUs = static_cast<double>(traceEvent.m_timestampNs - header.m_captureStartNs) / 1000.0;
+				lastTimestampNs = traceEvent.m_timestampNs;
+
+				if (traceEvent.m_nameHash == k_endEventNameHash)
+				{
+					if (depth == 0)
+					{
+						continue;
+					}
+					--depth;
+
+					jsonFile << std::format(",\n{{\"ph\":\"E\",\"pid\":0,\"tid\":{},\"ts\":{:.3f}}}", tid, timestampUs);
+				}
+				else
+				{
+					++depth;
+
+					auto nameItr = names.find(traceEvent.m_nameHash);
+					jsonFile << std::format(",\n{{\"name\":\"{}\",\"ph\":\"B\",\"pid\":0,\"tid\":{},\"ts\":{:.3f}}}",
+						nameItr != names.end() ? nameItr->second : "<unknown>",
+						tid,
+						timestampUs);
+				}
+			}
+
+			const double lastTimestampUs = static_cast<double>(lastTimestampNs - header.m_captureStartNs) / 1000.0;
+			for (; depth > 0; --depth)
+			{
+				jsonFile << std::format(",\n{{\"ph\":\"E\",\"pid\":0,\"tid\":{},\"ts\":{:.3f}}}", tid, lastTimestampUs);
+			}
+		}
+
+		jsonFile << "\n]}\n";
+
+		return jsonFile.good();
+	}
+}
\ No newline at end of file
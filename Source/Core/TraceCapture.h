@@ -0,0 +1,79 @@
+// © 2025 Adam Badke. All rights reserved.
+#pragma once
+
+
+namespace core
+{
+	// Portable, always-available CPU trace capture. While a capture is active, each thread records timestamped
+	// begin/end events into its own lock-free buffer. Once the requested number of frames has elapsed, the events are
+	// written to a compact binary file, which can be converted to Chrome trace/Perfetto JSON.
+	// Note: Event names are expected to be null-terminated C-strings. Any additional (printf-style) arguments are ignored
+	class TraceCapture final
+	{
+	public:
+		static constexpr uint32_t k_defaultNumCaptureFrames = 60;
+
+
+	public:
+		static void RequestCapture(uint32_t numFrames); // Capture begins at the next frame boundary
+		static bool IsCapturing();
+
+		static void BeginFrame(); // Main thread: Marks a frame boundary, and starts/finishes captures
+
+		template<typename... Args>
+		static void BeginEvent(char const* name, Args&&...);
+		static void EndEvent();
+
+		static void SetCurrentThreadName(char const* threadName);
+
+		// Converts a binary trace file into Chrome trace/Perfetto JSON (e.g. for use with ui.perfetto.dev)
+		static bool ConvertToChromeTrace(std::string const& traceFilePath, std::string const& jsonFilePath);
+
+
+	private:
+		static void RecordBeginEvent(char const* name);
+		static void RecordEndEvent();
+
+		static void StartCapture(uint32_t numFrames);
+		static void FinishCapture();
+
+
+	private:
+		static std::atomic<bool> s_isCapturing;
+		static std::atomic<uint32_t> s_numRequestedFrames;
+
+
+	private: // Static class only
+		TraceCapture() = delete;
+		TraceCapture(TraceCapture const&) = delete;
+		TraceCapture(TraceCapture&&) noexcept = delete;
+		TraceCapture& operator=(TraceCapture&&) noexcept = delete;
+		void operator=(TraceCapture const&) = delete;
+		~TraceCapture() = default;
+	};
+
+
+	inline bool TraceCapture::IsCapturing()
+	{
+		return s_isCapturing.load(std::memory_order_relaxed);
+	}
+
+
+	template<typename... Args>
+	inline void TraceCapture::BeginEvent(char const* name, Args&&...)
+	{
+		if (IsCapturing())
+		{
+			RecordBeginEvent(name);
+		}
+	}
+
+
+	inline void TraceCapture::EndEvent()
+	{
+		if (IsCapturing())
+		{
+			RecordEndEvent();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,214 @@
+// © 2025 Adam Badke. All rights reserved.
+#pragma once
+#include "../Assert.h"
+
+
+namespace util
+{
+	// Resizable bitset, packed into 64-bit words. Words are exposed so callers can combine several bitsets with
+	// word-parallel AND/OR operations, and set bits are extracted with tzcnt/popcount (i.e. O(numBits / 64) scans)
+	class DenseBitset final
+	{
+	public:
+		static constexpr size_t k_bitsPerWord = 64;
+
+
+	public:
+		DenseBitset() : m_numBits(0) {}
+		DenseBitset(size_t numBits) : m_words(GetNumWords(numBits), 0), m_numBits(numBits) {}
+		~DenseBitset() = default;
+
+		DenseBitset(DenseBitset const&) = default;
+		DenseBitset(DenseBitset&&) noexcept = default;
+		DenseBitset& operator=(DenseBitset const&) = default;
+		DenseBitset& operator=(DenseBitset&&) noexcept = default;
+
+
+	public:
+		void Resize(size_t numBits); // New bits are cleared
+		void PushBack(bool value);
+		void PopBack();
+		void EraseUnordered(size_t bitIdx); // Moves the last bit into bitIdx, and pops the back (i.e. swap-and-pop)
+
+		bool Test(size_t bitIdx) const;
+		void Set(size_t bitIdx);
+		void Reset(size_t bitIdx);
+		void Assign(size_t bitIdx, bool value);
+		bool TestAndSet(size_t bitIdx); // Returns the previous value
+
+		void ClearAll();
+
+		bool Any() const;
+		size_t Count() const;
+
+		size_t GetNumBits() const;
+		size_t GetNumWords() const;
+		uint64_t GetWord(size_t wordIdx) const;
+
+		// Calls fn(size_t bitIdx) for each set bit, in ascending order
+		template<typename Fn>
+		void ForEachSetBit(Fn&&) const;
+
+		// Calls fn(size_t bitIdx) for each set bit of a word, in ascending order
+		template<typename Fn>
+		static void ForEachSetBit(uint64_t word, size_t wordIdx, Fn&&);
+
+		static size_t GetNumWords(size_t numBits);
+
+
+	private:
+		static uint64_t GetMask(size_t bitIdx) { return 1ull << (bitIdx % k_bitsPerWord); }
+
+
+	private:
+		std::vector<uint64_t> m_words;
+		size_t m_numBits;
+	};
+
+
+	inline size_t DenseBitset::GetNumWords(size_t numBits)
+	{
+		return (numBits + k_bitsPerWord - 1) / k_bitsPerWord;
+	}
+
+
+	inline void DenseBitset::Resize(size_t numBits)
+	{
+		if (numBits < m_numBits && numBits % k_bitsPerWord != 0)
+		{
+			// Clear the truncated bits in the last word, so they're not resurrected if we grow again
+			m_words[numBits / k_bitsPerWord] &= GetMask(numBits) - 1;
+		}
+		m_words.resize(GetNumWords(numBits), 0);
+		m_numBits = numBits;
+	}
+
+
+	inline void DenseBitset::PushBack(bool value)
+	{
+		if (m_numBits % k_bitsPerWord == 0)
+		{
+			m_words.emplace_back(0);
+		}
+		Assign(m_numBits++, value);
+	}
+
+
+	inline void DenseBitset::PopBack()
+	{
+		SEAssert(m_numBits > 0, "Bitset is empty");
+		Resize(m_numBits - 1);
+	}
+
+
+	inline void DenseBitset::EraseUnordered(size_t bitIdx)
+	{
+		SEAssert(bitIdx < m_numBits, "Bit index is OOB");
+		Assign(bitIdx, Test(m_numBits - 1));
+		PopBack();
+	}
+
+
+	inline bool DenseBitset::Test(size_t bitIdx) const
+	{
+		SEAssert(bitIdx < m_numBits, "Bit index is OOB");
+		return (m_words[bitIdx / k_bitsPerWord] & GetMask(bitIdx)) != 0;
+	}
+
+
+	inline void DenseBitset::Set(size_t bitIdx)
+	{
+		SEAssert(bitIdx < m_numBits, "Bit index is OOB");
+		m_words[bitIdx / k_bitsPerWord] |= GetMask(bitIdx);
+	}
+
+
+	inline void DenseBitset::Reset(size_t bitIdx)
+	{
+		SEAssert(bitIdx < m_numBits, "Bit index is OOB");
+		m_words[bitIdx / k_bitsPerWord] &= ~GetMask(bitIdx);
+	}
+
+
+	inline void DenseBitset::Assign(size_t bitIdx, bool value)
+	{
+		value ? Set(bitIdx) : Reset(bitIdx);
+	}
+
+
+	inline bool DenseBitset::TestAndSet(size_t bitIdx)
+	{
+		SEAssert(bitIdx < m_numBits, "Bit index is OOB");
+
+		uint64_t& word = m_words[bitIdx / k_bitsPerWord];
+		const uint64_t mask = GetMask(bitIdx);
+
+		const bool wasSet = (word & mask) != 0;
+		word |= mask;
+		return wasSet;
+	}
+
+
+	inline void DenseBitset::ClearAll()
+	{
+		std::fill(m_words.begin(), m_words.end(), 0);
+	}
+
+
+	inline bool DenseBitset::Any() const
+	{
+		return std::any_of(m_words.begin(), m_words.end(), [](uint64_t word) { return word != 0; });
+	}
+
+
+	inline size_t DenseBitset::Count() const
+	{
+		size_t count = 0;
+		for (uint64_t word : m_words)
+		{
+			count += std::popcount(word);
+		}
+		return count;
+	}
+
+
+	inline size_t DenseBitset::GetNumBits() const
+	{
+		return m_numBits;
+	}
+
+
+	inline size_t DenseBitset::GetNumWords() const
+	{
+		return m_words.size();
+	}
+
+
+	inline uint64_t DenseBitset::GetWord(size_t wordIdx) const
+	{
+		SEAssert(wordIdx < m_words.size(), "Word index is OOB");
+		return m_words[wordIdx];
+	}
+
+
+	template<typename Fn>
+	void DenseBitset::ForEachSetBit(Fn&& fn) const
+	{
+		for (size_t wordIdx = 0; wordIdx < m_words.size(); ++wordIdx)
+		{
+			ForEachSetBit(m_words[wordIdx], wordIdx, fn);
+		}
+	}
+
+
+	template<typename Fn>
+	void DenseBitset::ForEachSetBit(uint64_t word, size_t wordIdx, Fn&& fn)
+	{
+		const size_t baseIdx = wordIdx * k_bitsPerWord;
+		while (word != 0)
+		{
+			fn(baseIdx + std::countr_zero(word));
+			word &= word - 1; // Clear the lowest set bit
+		}
+	}
+}
\ No newline at end of file
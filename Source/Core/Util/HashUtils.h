@@ -1,5 +1,11 @@
 //  2023 Adam Badke. All rights reserved.
 #pragma once
+#include "../Assert.h"
+
+// xxHash: Inlined, so XXH3 is specialized for its call sites. The widest vector extension enabled for the build is
+// used (SSE2 is the x64 baseline; AVX2 is used when compiling with /arch:AVX2)
+#define XXH_INLINE_ALL
+#include <xxhash.h>
 
 
 namespace util
@@ -31,48 +37,97 @@ namespace util
 	}
 
 
+	// XXH3: Results are stable across runs and platforms. Inputs of any length/alignment are supported (including
+	// trailing bytes), and different lengths of 0-padded data produce different hashes
 	inline uint64_t HashDataBytes(void const* const data, size_t numBytes)
 	{
-		uint64_t dataHash = 0;
-
-		constexpr uint8_t k_wordSize = sizeof(uint64_t); // 8 bytes in a word on 64-bit architecture
-
-		if (numBytes == k_wordSize) // Fast path: Hash 8 bytes at once
-		{
-			util::AddDataToHash(dataHash, *reinterpret_cast<uint64_t const*>(data));
-		}
-		else if (numBytes < k_wordSize)
-		{
-			// Fast-ish path: Hash 8 bytes packed into a single word, with any remaining bytes padded with 0's.
-			// Note: This is the same behavior as the next case
-			uint64_t bytes = 0;
-			uint8_t const* bytePtr = static_cast<uint8_t const*>(data);
-			memcpy(&bytes, bytePtr, numBytes);
-
-			util::AddDataToHash(dataHash, bytes);
-		}
-		else // Hash all of the words, then any remaining bytes:
-		{
-			const uint64_t numWords = numBytes / k_wordSize;
-			const uint64_t remainingNumBytes = numBytes - (numWords * k_wordSize);
-
-			uint64_t const* wordPtr = static_cast<uint64_t const*>(data);
-			for (size_t curWord = 0; curWord < numWords; curWord++)
-			{
-				util::AddDataToHash(dataHash, *wordPtr);
-				wordPtr++;
-			}
-
-			// Pack the remaining bytes into a single word, with any remaining bytes padded with 0's
-			// Note: This is the same behavior as the previous case
-			uint64_t remainingBytes = 0;
-			uint8_t const* bytePtr = static_cast<uint8_t const*>(data) + (numWords * k_wordSize);
-			memcpy(&remainingBytes, bytePtr, remainingNumBytes);
-
-			util::AddDataToHash(dataHash, remainingBytes);
-		}
-
-		return dataHash;
+		return XXH3_64bits(data, numBytes);
+	}
+
+
+	struct Hash128
+	{
+		uint64_t m_low64;
+		uint64_t m_high64;
+
+		bool operator==(Hash128 const&) const = default;
+	};
+
+
+	inline Hash128 HashDataBytes128(void const* const data, size_t numBytes)
+	{
+		const XXH128_hash_t hash = XXH3_128bits(data, numBytes);
+		return Hash128{ .m_low64 = hash.low64, .m_high64 = hash.high64 };
+	}
+
+
+	// Incrementally hashes data supplied in chunks (e.g. as it is streamed/generated), without first gathering it
+	// into a contiguous allocation. Digests match HashDataBytes/HashDataBytes128 of the concatenated chunks
+	class StreamingHasher final
+	{
+	public:
+		StreamingHasher();
+		~StreamingHasher() = default;
+
+		void Reset();
+
+		void Update(void const* data, size_t numBytes);
+
+		template<typename T>
+		void Update(T const& data); // Hashes the object representation: Beware of padding bytes
+
+		uint64_t Digest() const; // The state is not modified: More data can be added after digesting
+		Hash128 Digest128() const;
+
+
+	private:
+		XXH3_state_t m_state; // Note: The 64 and 128-bit XXH3 variants share the same state & update functions
+
+
+	private: // No copying allowed
+		StreamingHasher(StreamingHasher const&) = delete;
+		StreamingHasher(StreamingHasher&&) noexcept = delete;
+		StreamingHasher& operator=(StreamingHasher const&) = delete;
+		StreamingHasher& operator=(StreamingHasher&&) noexcept = delete;
+	};
+
+
+	inline StreamingHasher::StreamingHasher()
+	{
+		Reset();
+	}
+
+
+	inline void StreamingHasher::Reset()
+	{
+		XXH3_64bits_reset(&m_state);
+	}
+
+
+	inline void StreamingHasher::Update(void const* data, size_t numBytes)
+	{
+		XXH3_64bits_update(&m_state, data, numBytes);
+	}
+
+
+	template<typename T>
+	void StreamingHasher::Update(T const& data)
+	{
+		SEStaticAssert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be hashed as bytes");
+		Update(&data, sizeof(T));
+	}
+
+
+	inline uint64_t StreamingHasher::Digest() const
+	{
+		return XXH3_64bits_digest(&m_state);
+	}
+
+
+	inline Hash128 StreamingHasher::Digest128() const
+	{
+		const XXH128_hash_t hash = XXH3_128bits_digest(&m_state);
+		return Hash128{ .m_low64 = hash.low64, .m_high64 = hash.high64 };
 	}
 
 
@@ -0,0 +1,150 @@
+// © 2025 Adam Badke. All rights reserved.
+#pragma once
+#include "../Assert.h"
+
+
+namespace util
+{
+	// Fixed-size HDR-style histogram of unsigned integer values. Buckets are linear within each power of 2, and
+	// logarithmic across them: Values are recorded with a relative error of at most 1/k_numSubBuckets (~3%) across the
+	// entire range, using a constant amount of memory and no allocations.
+	// Values > k_maxTrackableValue are clamped. Values can also be removed, allowing use as a sliding window.
+	class LogLinearHistogram final
+	{
+	public:
+		static constexpr uint8_t k_subBucketBits = 5;
+		static constexpr uint64_t k_numSubBuckets = 1ull << k_subBucketBits;
+		static constexpr uint8_t k_maxValueBits = 40; // e.g. ~18 minutes, when recording nanoseconds
+		static constexpr uint64_t k_maxTrackableValue = (1ull << k_maxValueBits) - 1;
+		static constexpr size_t k_numBuckets = (k_maxValueBits - k_subBucketBits + 1) * k_numSubBuckets;
+
+
+	public:
+		LogLinearHistogram();
+		~LogLinearHistogram() = default;
+
+		LogLinearHistogram(LogLinearHistogram const&) = default;
+		LogLinearHistogram(LogLinearHistogram&&) noexcept = default;
+		LogLinearHistogram& operator=(LogLinearHistogram const&) = default;
+		LogLinearHistogram& operator=(LogLinearHistogram&&) noexcept = default;
+
+
+	public:
+		void Add(uint64_t value);
+		void Remove(uint64_t value); // Value must have been previously added
+		void Reset();
+
+		uint64_t GetCount() const;
+
+		// Returns a value representative of the bucket containing the given percentile, in [0, 100]
+		uint64_t GetValueAtPercentile(double percentile) const;
+
+
+	private:
+		static size_t GetBucketIndex(uint64_t value);
+		static uint64_t GetBucketLowestValue(size_t bucketIdx);
+		static uint64_t GetBucketRepresentativeValue(size_t bucketIdx);
+
+
+	private:
+		std::array<uint32_t, k_numBuckets> m_counts;
+		uint64_t m_totalCount;
+	};
+
+
+	inline LogLinearHistogram::LogLinearHistogram()
+		: m_counts{}
+		, m_totalCount(0)
+	{
+	}
+
+
+	inline size_t LogLinearHistogram::GetBucketIndex(uint64_t value)
+	{
+		value = std::min(value, k_maxTrackableValue);
+		if (value < k_numSubBuckets)
+		{
+			return static_cast<size_t>(value);
+		}
+
+		// Shift the value so its most significant bit is the top bit of the sub-bucket range: The shift amount selects
+		// the power-of-2 range, and the remaining bits select the sub-bucket within it
+		const uint32_t shift = static_cast<uint32_t>(std::bit_width(value)) - (k_subBucketBits + 1);
+		return static_cast<size_t>(shift * k_numSubBuckets + (value >> shift));
+	}
+
+
+	inline uint64_t LogLinearHistogram::GetBucketLowestValue(size_t bucketIdx)
+	{
+		if (bucketIdx < 2 * k_numSubBuckets)
+		{
+			return bucketIdx; // The first 2 ranges have a bucket per value
+		}
+		const uint64_t shift = (bucketIdx / k_numSubBuckets) - 1;
+		const uint64_t subBucket = (bucketIdx % k_numSubBuckets) + k_numSubBuckets;
+		return subBucket << shift;
+	}
+
+
+	inline uint64_t LogLinearHistogram::GetBucketRepresentativeValue(size_t bucketIdx)
+	{
+		const uint64_t lowest = GetBucketLowestValue(bucketIdx);
+		const uint64_t nextLowest = bucketIdx + 1 < k_numBuckets ?
+			GetBucketLowestValue(bucketIdx + 1) : k_maxTrackableValue + 1;
+		return lowest + (nextLowest - lowest) / 2;
+	}
+
+
+	inline void LogLinearHistogram::Add(uint64_t value)
+	{
+		++m_counts[GetBucketIndex(value)];
+		++m_totalCount;
+	}
+
+
+	inline void LogLinearHistogram::Remove(uint64_t value)
+	{
+		const size_t bucketIdx = GetBucketIndex(value);
+		SEAssert(m_counts[bucketIdx] > 0 && m_totalCount > 0, "Removing a value that was not added");
+
+		--m_counts[bucketIdx];
+		--m_totalCount;
+	}
+
+
+	inline void LogLinearHistogram::Reset()
+	{
+		m_counts.fill(0);
+		m_totalCount = 0;
+	}
+
+
+	inline uint64_t LogLinearHistogram::GetCount() const
+	{
+		return m_totalCount;
+	}
+
+
+	inline uint64_t LogLinearHistogram::GetValueAtPercentile(double percentile) const
+	{
+		if (m_totalCount == 0)
+		{
+			return 0;
+		}
+
+		const double clampedPercentile = std::clamp(percentile, 0.0, 100.0);
+		const uint64_t targetCount = std::max<uint64_t>(1,
+			static_cast<uint64_t>(std::ceil((clampedPercentile / 100.0) * static_cast<double>(m_totalCount))));
+
+		uint64_t cumulativeCount = 0;
+		for (size_t bucketIdx = 0; bucketIdx < k_numBuckets; ++bucketIdx)
+		{
+			cumulativeCount += m_counts[bucketIdx];
+			if (cumulativeCount >= targetCount)
+			{
+				return GetBucketRepresentativeValue(bucketIdx);
+			}
+		}
+		return k_maxTrackableValue;
+	}
+}
\ No newline at end of file
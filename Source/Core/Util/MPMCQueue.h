@@ -0,0 +1,169 @@
+// © 2025 Adam Badke. All rights reserved.
+#pragma once
+#include "../Assert.h"
+
+
+namespace util
+{
+	// Bounded, lock-free multi-producer/multi-consumer FIFO queue.
+	// Based on Dmitry Vyukov's bounded MPMC queue: Each cell carries a sequence number that producers and consumers use
+	// to claim it, so the only contended operations are a single CAS on the enqueue or dequeue position
+	template<typename T>
+	class MPMCQueue final
+	{
+	public:
+		MPMCQueue(size_t capacityPow2);
+		~MPMCQueue() = default;
+
+		bool TryEnqueue(T const& item); // Returns false if the queue is full
+		bool TryEnqueue(T&& item); // Returns false (and leaves item untouched) if the queue is full
+		bool TryDequeue(T& itemOut); // Returns false if the queue is empty
+
+		size_t Capacity() const;
+
+
+	private:
+		struct Cell
+		{
+			std::atomic<size_t> m_sequence;
+			T m_data;
+		};
+
+		Cell* ClaimEnqueueCell(size_t& posOut); // Returns nullptr if the queue is full
+
+		std::unique_ptr<Cell[]> m_cells;
+		const size_t m_mask;
+
+		alignas(64) std::atomic<size_t> m_enqueuePos;
+		alignas(64) std::atomic<size_t> m_dequeuePos;
+
+
+	private: // No copying allowed
+		MPMCQueue() = delete;
+		MPMCQueue(MPMCQueue const&) = delete;
+		MPMCQueue(MPMCQueue&&) noexcept = delete;
+		MPMCQueue& operator=(MPMCQueue const&) = delete;
+		MPMCQueue& operator=(MPMCQueue&&) noexcept = delete;
+	};
+
+
+	template<typename T>
+	MPMCQueue<T>::MPMCQueue(size_t capacityPow2)
+		: m_cells(std::make_unique<Cell[]>(capacityPow2))
+		, m_mask(capacityPow2 - 1)
+		, m_enqueuePos(0)
+		, m_dequeuePos(0)
+	{
+		SEStaticAssert(std::is_default_constructible_v<T>, "T must be default constructible");
+		SEAssert(capacityPow2 >= 2 && (capacityPow2 & (capacityPow2 - 1)) == 0, "Capacity must be a power of 2");
+
+		for (size_t i = 0; i < capacityPow2; ++i)
+		{
+			m_cells[i].m_sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+
+	template<typename T>
+	typename MPMCQueue<T>::Cell* MPMCQueue<T>::ClaimEnqueueCell(size_t& posOut)
+	{
+		size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+		while (true)
+		{
+			Cell* cell = &m_cells[pos & m_mask];
+			const size_t sequence = cell->m_sequence.load(std::memory_order_acquire);
+			const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+			if (diff == 0)
+			{
+				if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					posOut = pos;
+					return cell;
+				}
+			}
+			else if (diff < 0)
+			{
+				return nullptr; // Full
+			}
+			else
+			{
+				pos = m_enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+
+	template<typename T>
+	bool MPMCQueue<T>::TryEnqueue(T const& item)
+	{
+		size_t pos = 0;
+		Cell* cell = ClaimEnqueueCell(pos);
+		if (cell == nullptr)
+		{
+			return false;
+		}
+
+		cell->m_data = item;
+		cell->m_sequence.store(pos + 1, std::memory_order_release);
+
+		return true;
+	}
+
+
+	template<typename T>
+	bool MPMCQueue<T>::TryEnqueue(T&& item)
+	{
+		size_t pos = 0;
+		Cell* cell = ClaimEnqueueCell(pos);
+		if (cell == nullptr)
+		{
+			return false;
+		}
+
+		cell->m_data = std::move(item);
+		cell->m_sequence.store(pos + 1, std::memory_order_release);
+
+		return true;
+	}
+
+
+	template<typename T>
+	bool MPMCQueue<T>::TryDequeue(T& itemOut)
+	{
+		Cell* cell = nullptr;
+		size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+		while (true)
+		{
+			cell = &m_cells[pos & m_mask];
+			const size_t sequence = cell->m_sequence.load(std::memory_order_acquire);
+			const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+			if (diff == 0)
+			{
+				if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (diff < 0)
+			{
+				return false; // Empty
+			}
+			else
+			{
+				pos = m_dequeuePos.load(std::memory_order_relaxed);
+			}
+		}
+
+		itemOut = std::move(cell->m_data);
+		cell->m_sequence.store(pos + m_mask + 1, std::memory_order_release);
+
+		return true;
+	}
+
+
+	template<typename T>
+	inline size_t MPMCQueue<T>::Capacity() const
+	{
+		return m_mask + 1;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+// © 2025 Adam Badke. All rights reserved.
+#pragma once
+#include "../Assert.h"
+
+
+namespace util
+{
+	// A 64-bit sort key, and the index of the element it was generated from
+	struct RadixSortKey
+	{
+		uint64_t m_key;
+		uint32_t m_index;
+	};
+
+
+	// Stable LSD radix sort of RadixSortKeys, 8 bits per pass. All digit histograms are built in a single pass over the
+	// keys, and passes where every key shares the same digit are skipped. The scratch vector is resized as required,
+	// and can be reused between calls to avoid reallocations. Small inputs fall back to a comparison sort
+	inline void RadixSort(std::vector<RadixSortKey>& keys, std::vector<RadixSortKey>& scratch)
+	{
+		constexpr uint32_t k_bitsPerDigit = 8;
+		constexpr uint32_t k_numBuckets = 1u << k_bitsPerDigit;
+		constexpr uint32_t k_numPasses = (sizeof(uint64_t) * 8) / k_bitsPerDigit;
+
+		constexpr size_t k_minRadixSortSize = 1024; // Below this, the histogram overhead isn't worth it
+
+		const size_t numKeys = keys.size();
+		SEAssert(numKeys <= std::numeric_limits<uint32_t>::max(), "Too many keys");
+
+		if (numKeys < k_minRadixSortSize)
+		{
+			// Indexes are unique, so ordering equal keys by index gives the same result as the stable radix sort when
+			// the keys are supplied in index order
+			std::sort(keys.begin(), keys.end(),
+				[](RadixSortKey const& a, RadixSortKey const& b)
+				{
+					return a.m_key < b.m_key || (a.m_key == b.m_key && a.m_index < b.m_index);
+				});
+			return;
+		}
+
+		std::array<std::array<uint32_t, k_numBuckets>, k_numPasses> histograms{};
+		for (RadixSortKey const& sortKey : keys)
+		{
+			for (uint32_t pass = 0; pass < k_numPasses; ++pass)
+			{
+				histograms[pass][(sortKey.m_key >> (pass * k_bitsPerDigit)) & (k_numBuckets - 1)]++;
+			}
+		}
+
+		scratch.resize(numKeys);
+
+		RadixSortKey* src = keys.data();
+		RadixSortKey* dst = scratch.data();
+		for (uint32_t pass = 0; pass < k_numPasses; ++pass)
+		{
+			std::array<uint32_t, k_numBuckets>& histogram = histograms[pass];
+
+			const uint32_t shift = pass * k_bitsPerDigit;
+
+			// If every key has the same digit, this pass would not change the order
+			if (histogram[(src[0].m_key >> shift) & (k_numBuckets - 1)] == numKeys)
+			{
+				continue;
+			}
+
+			// Convert the counts to exclusive prefix sums, i.e. the first destination index for each bucket:
+			uint32_t offset = 0;
+			for (uint32_t& bucket : histogram)
+			{
+				const uint32_t count = bucket;
+				bucket = offset;
+				offset += count;
+			}
+
+			for (size_t i = 0; i < numKeys; ++i)
+			{
+				dst[histogram[(src[i].m_key >> shift) & (k_numBuckets - 1)]++] = src[i];
+			}
+			std::swap(src, dst);
+		}
+
+		if (src != keys.data())
+		{
+			keys.swap(scratch); // The results finished in the scratch buffer
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,357 @@
+// © 2025 Adam Badke. All rights reserved.
+#pragma once
+#include "../Assert.h"
+
+
+namespace util
+{
+	// Dense storage for values keyed by externally-allocated integer IDs (e.g. monotonically increasing object IDs).
+	// Values are tightly packed in insertion order (erasing swaps the last element into the hole), and keys are mapped
+	// to their dense index via a paged sparse table, so lookups are O(1) array indexing and iteration is linear.
+	// Each dense slot has a generation that is incremented whenever its occupant changes, allowing cached Handles to
+	// be validated.
+	// Keys are offset by 1 before paging, so the maximum key (commonly used as a sentinel) packs into the first page.
+	// Pages are released once they are empty, as monotonically allocated keys leave earlier pages unused over time.
+	template<typename Key, typename T>
+	class SlotMap final
+	{
+	public:
+		static constexpr uint32_t k_invalidIndex = std::numeric_limits<uint32_t>::max();
+
+		struct Handle
+		{
+			uint32_t m_index = k_invalidIndex;
+			uint32_t m_generation = 0;
+		};
+
+
+	public:
+		SlotMap() = default;
+		~SlotMap() = default;
+
+		SlotMap(SlotMap&&) noexcept = default;
+		SlotMap& operator=(SlotMap&&) noexcept = default;
+
+
+	public:
+		template<typename... Args>
+		T& Emplace(Key, Args&&...); // Key must not already exist. The new element is appended at index Size() - 1
+
+		// Returns the dense index the element occupied: The last element (if any) is moved into it
+		uint32_t Erase(Key);
+
+		void Clear();
+		void Reserve(size_t);
+
+		bool Contains(Key) const;
+		uint32_t GetIndex(Key) const; // k_invalidIndex if the key does not exist
+
+		T& Get(Key);
+		T const& Get(Key) const;
+
+		T* TryGet(Key); // nullptr if the key does not exist
+		T const* TryGet(Key) const;
+
+		T& GetAt(uint32_t index);
+		T const& GetAt(uint32_t index) const;
+
+		Key GetKeyAt(uint32_t index) const;
+
+		Handle GetHandle(Key) const;
+		bool IsValid(Handle) const; // Does the Handle's slot still contain the element it was created for?
+
+		uint32_t Size() const;
+		bool IsEmpty() const;
+
+		std::vector<T> const& GetValues() const; // In dense index order
+		std::vector<Key> const& GetKeys() const; // Parallel to GetValues()
+
+
+	private:
+		static constexpr uint32_t k_pageBits = 10;
+		static constexpr uint32_t k_pageSize = 1u << k_pageBits;
+		static constexpr uint32_t k_pageMask = k_pageSize - 1;
+
+		struct Page
+		{
+			std::array<uint32_t, k_pageSize> m_indexes; // Key -> dense index, or k_invalidIndex
+			uint32_t m_numUsed;
+		};
+
+		static uint32_t GetSparseIndex(Key key) { return static_cast<uint32_t>(key) + 1; } // Max key wraps to 0
+
+		uint32_t& GetSparseEntry(Key); // Allocates the page if necessary
+		uint32_t const* FindSparseEntry(Key) const;
+
+		void ReleaseSparseEntry(Key);
+
+
+	private:
+		std::vector<std::unique_ptr<Page>> m_pages;
+
+		std::vector<T> m_values;
+		std::vector<Key> m_keys;
+		std::vector<uint32_t> m_generations; // Never shrinks, so generations survive a slot being vacated
+
+
+	private: // No copying allowed
+		SlotMap(SlotMap const&) = delete;
+		SlotMap& operator=(SlotMap const&) = delete;
+	};
+
+
+	template<typename Key, typename T>
+	uint32_t& SlotMap<Key, T>::GetSparseEntry(Key key)
+	{
+		SEStaticAssert(std::is_unsigned_v<Key> && sizeof(Key) <= sizeof(uint32_t),
+			"Keys must be unsigned integers of at most 32 bits");
+
+		const uint32_t sparseIdx = GetSparseIndex(key);
+		const uint32_t pageIdx = sparseIdx >> k_pageBits;
+
+		if (pageIdx >= m_pages.size())
+		{
+			m_pages.resize(pageIdx + 1);
+		}
+		if (m_pages[pageIdx] == nullptr)
+		{
+			m_pages[pageIdx] = std::make_unique<Page>();
+			m_pages[pageIdx]->m_indexes.fill(k_invalidIndex);
+			m_pages[pageIdx]->m_numUsed = 0;
+		}
+		return m_pages[pageIdx]->m_indexes[sparseIdx & k_pageMask];
+	}
+
+
+	template<typename Key, typename T>
+	uint32_t const* SlotMap<Key, T>::FindSparseEntry(Key key) const
+	{
+		const uint32_t sparseIdx = GetSparseIndex(key);
+		const uint32_t pageIdx = sparseIdx >> k_pageBits;
+
+		if (pageIdx >= m_pages.size() || m_pages[pageIdx] == nullptr)
+		{
+			return nullptr;
+		}
+		uint32_t const* entry = &m_pages[pageIdx]->m_indexes[sparseIdx & k_pageMask];
+		return *entry == k_invalidIndex ? nullptr : entry;
+	}
+
+
+	template<typename Key, typename T>
+	void SlotMap<Key, T>::ReleaseSparseEntry(Key key)
+	{
+		const uint32_t sparseIdx = GetSparseIndex(key);
+		const uint32_t pageIdx = sparseIdx >> k_pageBits;
+
+		Page& page = *m_pages[pageIdx];
+		page.m_indexes[sparseIdx & k_pageMask] = k_invalidIndex;
+
+		SEAssert(page.m_numUsed > 0, "Page use count is out of sync");
+		if (--page.m_numUsed == 0)
+		{
+			m_pages[pageIdx] = nullptr;
+
+			while (!m_pages.empty() && m_pages.back() == nullptr)
+			{
+				m_pages.pop_back();
+			}
+		}
+	}
+
+
+	template<typename Key, typename T>
+	template<typename... Args>
+	T& SlotMap<Key, T>::Emplace(Key key, Args&&... args)
+	{
+		uint32_t& sparseEntry = GetSparseEntry(key);
+		SEAssert(sparseEntry == k_invalidIndex, "Key already exists");
+		SEAssert(m_values.size() < k_invalidIndex, "Too many elements");
+
+		sparseEntry = static_cast<uint32_t>(m_values.size());
+		m_pages[GetSparseIndex(key) >> k_pageBits]->m_numUsed++;
+
+		m_keys.emplace_back(key);
+		if (m_generations.size() < m_keys.size())
+		{
+			m_generations.emplace_back(0);
+		}
+
+		return m_values.emplace_back(std::forward<Args>(args)...);
+	}
+
+
+	template<typename Key, typename T>
+	uint32_t SlotMap<Key, T>::Erase(Key key)
+	{
+		uint32_t const* sparseEntry = FindSparseEntry(key);
+		SEAssert(sparseEntry != nullptr, "Key does not exist");
+
+		const uint32_t erasedIdx = *sparseEntry;
+		const uint32_t lastIdx = static_cast<uint32_t>(m_values.size() - 1);
+
+		if (erasedIdx != lastIdx)
+		{
+			m_values[erasedIdx] = std::move(m_values[lastIdx]);
+			m_keys[erasedIdx] = m_keys[lastIdx];
+
+			GetSparseEntry(m_keys[erasedIdx]) = erasedIdx;
+		}
+		m_values.pop_back();
+		m_keys.pop_back();
+
+		// Both slots changed occupants
+		m_generations[erasedIdx]++;
+		if (erasedIdx != lastIdx)
+		{
+			m_generations[lastIdx]++;
+		}
+
+		ReleaseSparseEntry(key);
+
+		return erasedIdx;
+	}
+
+
+	template<typename Key, typename T>
+	void SlotMap<Key, T>::Clear()
+	{
+		m_pages.clear();
+		m_values.clear();
+		m_keys.clear();
+
+		for (uint32_t& generation : m_generations)
+		{
+			generation++;
+		}
+	}
+
+
+	template<typename Key, typename T>
+	void SlotMap<Key, T>::Reserve(size_t capacity)
+	{
+		m_values.reserve(capacity);
+		m_keys.reserve(capacity);
+		m_generations.reserve(capacity);
+	}
+
+
+	template<typename Key, typename T>
+	inline bool SlotMap<Key, T>::Contains(Key key) const
+	{
+		return FindSparseEntry(key) != nullptr;
+	}
+
+
+	template<typename Key, typename T>
+	inline uint32_t SlotMap<Key, T>::GetIndex(Key key) const
+	{
+		uint32_t const* sparseEntry = FindSparseEntry(key);
+		return sparseEntry ? *sparseEntry : k_invalidIndex;
+	}
+
+
+	template<typename Key, typename T>
+	inline T& SlotMap<Key, T>::Get(Key key)
+	{
+		const uint32_t index = GetIndex(key);
+		SEAssert(index != k_invalidIndex, "Key does not exist");
+		return m_values[index];
+	}
+
+
+	template<typename Key, typename T>
+	inline T const& SlotMap<Key, T>::Get(Key key) const
+	{
+		const uint32_t index = GetIndex(key);
+		SEAssert(index != k_invalidIndex, "Key does not exist");
+		return m_values[index];
+	}
+
+
+	template<typename Key, typename T>
+	inline T* SlotMap<Key, T>::TryGet(Key key)
+	{
+		const uint32_t index = GetIndex(key);
+		return index == k_invalidIndex ? nullptr : &m_values[index];
+	}
+
+
+	template<typename Key, typename T>
+	inline T const* SlotMap<Key, T>::TryGet(Key key) const
+	{
+		const uint32_t index = GetIndex(key);
+		return index == k_invalidIndex ? nullptr : &m_values[index];
+	}
+
+
+	template<typename Key, typename T>
+	inline T& SlotMap<Key, T>::GetAt(uint32_t index)
+	{
+		SEAssert(index < m_values.size(), "Index is OOB");
+		return m_values[index];
+	}
+
+
+	template<typename Key, typename T>
+	inline T const& SlotMap<Key, T>::GetAt(uint32_t index) const
+	{
+		SEAssert(index < m_values.size(), "Index is OOB");
+		return m_values[index];
+	}
+
+
+	template<typename Key, typename T>
+	inline Key SlotMap<Key, T>::GetKeyAt(uint32_t index) const
+	{
+		SEAssert(index < m_keys.size(), "Index is OOB");
+		return m_keys[index];
+	}
+
+
+	template<typename Key, typename T>
+	inline typename SlotMap<Key, T>::Handle SlotMap<Key, T>::GetHandle(Key key) const
+	{
+		const uint32_t index = GetIndex(key);
+		if (index == k_invalidIndex)
+		{
+			return Handle{};
+		}
+		return Handle{ .m_index = index, .m_generation = m_generations[index] };
+	}
+
+
+	template<typename Key, typename T>
+	inline bool SlotMap<Key, T>::IsValid(Handle handle) const
+	{
+		return handle.m_index < m_values.size() && m_generations[handle.m_index] == handle.m_generation;
+	}
+
+
+	template<typename Key, typename T>
+	inline uint32_t SlotMap<Key, T>::Size() const
+	{
+		return static_cast<uint32_t>(m_values.size());
+	}
+
+
+	template<typename Key, typename T>
+	inline bool SlotMap<Key, T>::IsEmpty() const
+	{
+		return m_values.empty();
+	}
+
+
+	template<typename Key, typename T>
+	inline std::vector<T> const& SlotMap<Key, T>::GetValues() const
+	{
+		return m_values;
+	}
+
+
+	template<typename Key, typename T>
+	inline std::vector<Key> const& SlotMap<Key, T>::GetKeys() const
+	{
+		return m_keys;
+	}
+}
\ No newline at end of file
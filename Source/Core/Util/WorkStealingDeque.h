@@ -0,0 +1,178 @@
+// © 2025 Adam Badke. All rights reserved.
+#pragma once
+#include "../Assert.h"
+
+
+namespace util
+{
+	// Chase-Lev work-stealing deque, using the C++11 memory model mapping from Lê et al., "Correct and Efficient
+	// Work-Stealing for Weak Memory Models" (PPoPP 2013).
+	// The owning thread pushes and pops at the bottom (LIFO); any other thread may steal from the top (FIFO).
+	// Note: T is stored in atomics, and must be trivially copyable (e.g. a pointer)
+	template<typename T>
+	class WorkStealingDeque final
+	{
+	public:
+		WorkStealingDeque(size_t initialCapacityPow2 = 1024);
+		~WorkStealingDeque();
+
+		void Push(T item); // Owner thread only. Grows the underlying ring buffer if necessary
+		bool Pop(T& itemOut); // Owner thread only
+		bool Steal(T& itemOut); // Any thread
+
+		bool IsEmpty() const;
+
+
+	private:
+		struct RingBuffer
+		{
+			RingBuffer(int64_t capacity) : m_capacity(capacity), m_mask(capacity - 1), m_data(capacity) {}
+
+			inline T Get(int64_t idx) const { return m_data[idx & m_mask].load(std::memory_order_relaxed); }
+			inline void Put(int64_t idx, T item) { m_data[idx & m_mask].store(item, std::memory_order_relaxed); }
+
+			RingBuffer* Grow(int64_t bottom, int64_t top) const;
+
+			const int64_t m_capacity;
+			const int64_t m_mask;
+			std::vector<std::atomic<T>> m_data;
+		};
+
+
+	private:
+		alignas(64) std::atomic<int64_t> m_top;
+		alignas(64) std::atomic<int64_t> m_bottom;
+		alignas(64) std::atomic<RingBuffer*> m_buffer;
+
+		// Stealers may still be reading from a buffer after we've grown it; we keep them alive until we're destroyed
+		std::vector<std::unique_ptr<RingBuffer>> m_retiredBuffers;
+
+
+	private: // No copying allowed
+		WorkStealingDeque(WorkStealingDeque const&) = delete;
+		WorkStealingDeque(WorkStealingDeque&&) noexcept = delete;
+		WorkStealingDeque& operator=(WorkStealingDeque const&) = delete;
+		WorkStealingDeque& operator=(WorkStealingDeque&&) noexcept = delete;
+	};
+
+
+	template<typename T>
+	typename WorkStealingDeque<T>::RingBuffer* WorkStealingDeque<T>::RingBuffer::Grow(int64_t bottom, int64_t top) const
+	{
+		RingBuffer* newBuffer = new RingBuffer(m_capacity * 2);
+		for (int64_t i = top; i < bottom; ++i)
+		{
+			newBuffer->Put(i, Get(i));
+		}
+		return newBuffer;
+	}
+
+
+	template<typename T>
+	WorkStealingDeque<T>::WorkStealingDeque(size_t initialCapacityPow2)
+		: m_top(0)
+		, m_bottom(0)
+		, m_buffer(nullptr)
+	{
+		SEStaticAssert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+		SEAssert(initialCapacityPow2 > 0 && (initialCapacityPow2 & (initialCapacityPow2 - 1)) == 0,
+			"Initial capacity must be a power of 2");
+
+		m_buffer.store(new RingBuffer(static_cast<int64_t>(initialCapacityPow2)), std::memory_order_relaxed);
+	}
+
+
+	template<typename T>
+	WorkStealingDeque<T>::~WorkStealingDeque()
+	{
+		delete m_buffer.load(std::memory_order_relaxed);
+	}
+
+
+	template<typename T>
+	void WorkStealingDeque<T>::Push(T item)
+	{
+		const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+		const int64_t top = m_top.load(std::memory_order_acquire);
+		RingBuffer* buffer = m_buffer.load(std::memory_order_relaxed);
+
+		if (bottom - top > buffer->m_capacity - 1)
+		{
+			RingBuffer* newBuffer = buffer->Grow(bottom, top);
+			m_retiredBuffers.emplace_back(buffer);
+			m_buffer.store(newBuffer, std::memory_order_release);
+			buffer = newBuffer;
+		}
+
+		buffer->Put(bottom, item);
+
+		// Publish the item to stealers (equivalent to a release fence + relaxed store)
+		m_bottom.store(bottom + 1, std::memory_order_release);
+	}
+
+
+	template<typename T>
+	bool WorkStealingDeque<T>::Pop(T& itemOut)
+	{
+		const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+		RingBuffer* buffer = m_buffer.load(std::memory_order_relaxed);
+		m_bottom.store(bottom, std::memory_order_relaxed);
+
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		int64_t top = m_top.load(std::memory_order_relaxed);
+
+		bool foundItem = false;
+		if (top <= bottom)
+		{
+			itemOut = buffer->Get(bottom);
+			foundItem = true;
+
+			if (top == bottom) // Last item: Race against any stealers
+			{
+				if (!m_top.compare_exchange_strong(
+					top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				{
+					foundItem = false;
+				}
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+		}
+		else // Deque was empty
+		{
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		}
+		return foundItem;
+	}
+
+
+	template<typename T>
+	bool WorkStealingDeque<T>::Steal(T& itemOut)
+	{
+		int64_t top = m_top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+		if (top < bottom)
+		{
+			RingBuffer* buffer = m_buffer.load(std::memory_order_acquire);
+			T item = buffer->Get(top);
+
+			if (m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			{
+				itemOut = item;
+				return true;
+			}
+		}
+		return false; // Empty, or we lost a race with the owner/another stealer
+	}
+
+
+	template<typename T>
+	bool WorkStealingDeque<T>::IsEmpty() const
+	{
+		const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+		const int64_t top = m_top.load(std::memory_order_relaxed);
+		return bottom <= top;
+	}
+}
\ No newline at end of file
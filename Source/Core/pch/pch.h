@@ -13,9 +13,12 @@
 // std library:
 #include <any>
 #include <array>
+#include <atomic>
 #include <barrier>
+#include <bit>
 #include <cassert>
 #include <chrono>
+#include <cmath>
 #include <cstdint>
 #include <filesystem>
 #include <format>
@@ -7,6 +7,66 @@
 #include "Core/Util/ImGuiUtils.h"
 
 
+namespace
+{
+	// Advances a cached cursor (the index of the 1st keyframe time > currentTimeSec) to the current time, and computes
+	// the keyframe segment about it. Keyframe times must be sorted in ascending order
+	void UpdateKeyframeCursor(
+		std::vector<float> const& keyframeTimes,
+		float currentTimeSec,
+		uint32_t& cursor,
+		uint32_t& prevIdxOut,
+		uint32_t& nextIdxOut)
+	{
+		constexpr uint32_t k_maxLinearSteps = 4; // Fall back to a binary search if time moved further than this
+
+		const uint32_t numKeyframes = static_cast<uint32_t>(keyframeTimes.size());
+		SEAssert(numKeyframes > 0, "Channel has no keyframes");
+		SEAssert(cursor <= numKeyframes, "Cursor is OOB");
+
+		if (cursor < numKeyframes && keyframeTimes[cursor] <= currentTimeSec) // Time moved forward
+		{
+			uint32_t numSteps = 0;
+			do
+			{
+				++cursor;
+			} while (cursor < numKeyframes && keyframeTimes[cursor] <= currentTimeSec && ++numSteps < k_maxLinearSteps);
+
+			if (cursor < numKeyframes && keyframeTimes[cursor] <= currentTimeSec)
+			{
+				cursor = static_cast<uint32_t>(std::distance(keyframeTimes.begin(),
+					std::upper_bound(keyframeTimes.begin() + cursor, keyframeTimes.end(), currentTimeSec)));
+			}
+		}
+		else if (cursor > 0 && keyframeTimes[cursor - 1] > currentTimeSec) // Time moved backward
+		{
+			--cursor;
+			if (cursor > 0 && keyframeTimes[cursor - 1] > currentTimeSec)
+			{
+				cursor = static_cast<uint32_t>(std::distance(keyframeTimes.begin(),
+					std::upper_bound(keyframeTimes.begin(), keyframeTimes.begin() + cursor, currentTimeSec)));
+			}
+		}
+
+		if (cursor == 0) // Clamp to the 1st keyframe
+		{
+			prevIdxOut = 0;
+			nextIdxOut = 0;
+		}
+		else if (cursor == numKeyframes) // Clamp to the last keyframe
+		{
+			prevIdxOut = numKeyframes - 1;
+			nextIdxOut = numKeyframes - 1;
+		}
+		else
+		{
+			prevIdxOut = cursor - 1;
+			nextIdxOut = cursor;
+		}
+	}
+}
+
+
 namespace pr
 {
 	AnimationController* AnimationController::CreateAnimationController(pr::EntityManager& em, char const* name)
@@ -51,6 +111,11 @@ namespace pr
 		if (animController.HasAnimations())	
 		{
 			animController.UpdateCurrentAnimationTime(stepTimeMs);
+
+			if (animController.GetAnimationState() == AnimationState::Playing)
+			{
+				animController.SampleActiveAnimation();
+			}
 		}
 	}
 
@@ -90,6 +155,96 @@ namespace pr
 	}
 
 
+	void AnimationController::SampleActiveAnimation()
+	{
+		SEBeginCPUEvent("AnimationController::SampleActiveAnimation");
+
+		const float currentTimeSec = GetActiveClampedAnimationTimeSec();
+
+		std::vector<std::vector<float>> const& animKeyframeTimes = m_animChannelKeyframeTimesSec[m_activeAnimationIdx];
+		ClipSamplers& clipSamplers = m_clipSamplers[m_activeAnimationIdx];
+
+		// Update the keyframe segments. Channels commonly share keyframe times, so this is done once per set of times
+		for (size_t keyframeTimesIdx = 0; keyframeTimesIdx < animKeyframeTimes.size(); ++keyframeTimesIdx)
+		{
+			UpdateKeyframeCursor(
+				animKeyframeTimes[keyframeTimesIdx],
+				currentTimeSec,
+				clipSamplers.m_keyframeCursors[keyframeTimesIdx],
+				clipSamplers.m_prevKeyframeIdxs[keyframeTimesIdx],
+				clipSamplers.m_nextKeyframeIdxs[keyframeTimesIdx]);
+		}
+
+		// Sample every translation/rotation/scale channel:
+		for (size_t samplerIdx = 0; samplerIdx < clipSamplers.m_sampledValues.size(); ++samplerIdx)
+		{
+			const uint32_t keyframeTimesIdx = clipSamplers.m_samplerKeyframeTimesIdxs[samplerIdx];
+			const size_t prevKeyframeIdx = clipSamplers.m_prevKeyframeIdxs[keyframeTimesIdx];
+			const size_t nextKeyframeIdx = clipSamplers.m_nextKeyframeIdxs[keyframeTimesIdx];
+
+			std::vector<float> const& keyframeTimes = animKeyframeTimes[keyframeTimesIdx];
+			std::vector<float> const& channelData = m_channelData[clipSamplers.m_samplerDataIdxs[samplerIdx]];
+
+			const InterpolationMode interpolationMode = clipSamplers.m_samplerInterpolationModes[samplerIdx];
+
+			switch (clipSamplers.m_samplerTargetPaths[samplerIdx])
+			{
+			case AnimationPath::Translation:
+			case AnimationPath::Scale:
+			{
+				clipSamplers.m_sampledValues[samplerIdx] = glm::vec4(GetInterpolatedValue<glm::vec3>(
+					interpolationMode,
+					channelData.data(),
+					channelData.size(),
+					prevKeyframeIdx,
+					nextKeyframeIdx,
+					keyframeTimes[prevKeyframeIdx],
+					keyframeTimes[nextKeyframeIdx],
+					currentTimeSec),
+					0.f);
+			}
+			break;
+			case AnimationPath::Rotation:
+			{
+				glm::quat interpolatedValue;
+				if (interpolationMode == pr::InterpolationMode::SphericalLinearInterpolation)
+				{
+					interpolatedValue = GetSphericalLinearInterpolatedValue(
+						interpolationMode,
+						channelData.data(),
+						channelData.size(),
+						prevKeyframeIdx,
+						nextKeyframeIdx,
+						keyframeTimes[prevKeyframeIdx],
+						keyframeTimes[nextKeyframeIdx],
+						currentTimeSec);
+				}
+				else
+				{
+					interpolatedValue = GetInterpolatedValue<glm::quat>(
+						interpolationMode,
+						channelData.data(),
+						channelData.size(),
+						prevKeyframeIdx,
+						nextKeyframeIdx,
+						keyframeTimes[prevKeyframeIdx],
+						keyframeTimes[nextKeyframeIdx],
+						currentTimeSec);
+				}
+				interpolatedValue = glm::normalize(interpolatedValue);
+
+				clipSamplers.m_sampledValues[samplerIdx] =
+					glm::vec4(interpolatedValue.x, interpolatedValue.y, interpolatedValue.z, interpolatedValue.w);
+			}
+			break;
+			default: SEAssertF("Invalid animation target");
+			}
+		}
+
+		SEEndCPUEvent(); // "AnimationController::SampleActiveAnimation"
+	}
+
+
 	size_t AnimationController::AddChannelKeyframeTimes(size_t animIdx, std::vector<float>&& keyframeTimes)
 	{
 		if (animIdx >= m_animChannelKeyframeTimesSec.size())
@@ -102,10 +257,21 @@ namespace pr
 			m_longestAnimChannelTimesSec.emplace_back(0.f);
 			SEAssert(m_longestAnimChannelTimesSec.size() == m_animChannelKeyframeTimesSec.size(),
 				"Animation times and longest channel times are out of sync");
+
+			m_clipSamplers.emplace_back();
 		}
 
+		SEAssert(!keyframeTimes.empty(), "Keyframe times cannot be empty");
+		SEAssert(std::is_sorted(keyframeTimes.begin(), keyframeTimes.end()),
+			"Keyframe times must be sorted in ascending order");
+
 		const size_t channelKeyframeTimesIdx = m_animChannelKeyframeTimesSec[animIdx].size();
 
+		ClipSamplers& clipSamplers = m_clipSamplers[animIdx];
+		clipSamplers.m_keyframeCursors.emplace_back(0);
+		clipSamplers.m_prevKeyframeIdxs.emplace_back(0);
+		clipSamplers.m_nextKeyframeIdxs.emplace_back(0);
+
 		std::vector<float> const& newKeyframeTimes = 
 			m_animChannelKeyframeTimesSec[animIdx].emplace_back(std::move(keyframeTimes));
 		
@@ -128,6 +294,36 @@ namespace pr
 	}
 
 
+	size_t AnimationController::AddChannelSampler(size_t animIdx, AnimationData::Channel const& channel)
+	{
+		SEAssert(animIdx < m_clipSamplers.size() &&
+			channel.m_keyframeTimesIdx < m_animChannelKeyframeTimesSec[animIdx].size() &&
+			channel.m_dataIdx < m_channelData.size(),
+			"Channel keyframe times and data must be added before the channel sampler");
+		SEAssert(channel.m_targetPath == AnimationPath::Translation ||
+			channel.m_targetPath == AnimationPath::Rotation ||
+			channel.m_targetPath == AnimationPath::Scale,
+			"Only translation/rotation/scale channels are sampled by the AnimationController");
+
+		ClipSamplers& clipSamplers = m_clipSamplers[animIdx];
+
+		const size_t samplerIdx = clipSamplers.m_sampledValues.size();
+
+		clipSamplers.m_samplerKeyframeTimesIdxs.emplace_back(util::CheckedCast<uint32_t>(channel.m_keyframeTimesIdx));
+		clipSamplers.m_samplerDataIdxs.emplace_back(util::CheckedCast<uint32_t>(channel.m_dataIdx));
+		clipSamplers.m_samplerInterpolationModes.emplace_back(channel.m_interpolationMode);
+		clipSamplers.m_samplerTargetPaths.emplace_back(channel.m_targetPath);
+		switch (channel.m_targetPath) // Initialize to the identity transformation
+		{
+		case AnimationPath::Rotation: clipSamplers.m_sampledValues.emplace_back(0.f, 0.f, 0.f, 1.f); break;
+		case AnimationPath::Scale: clipSamplers.m_sampledValues.emplace_back(1.f, 1.f, 1.f, 0.f); break;
+		default: clipSamplers.m_sampledValues.emplace_back(0.f);
+		}
+
+		return samplerIdx;
+	}
+
+
 	void AnimationController::ShowImGuiWindow(pr::EntityManager& em, entt::entity animControllerEntity)
 	{
 		pr::NameComponent const& nameComponent = em.GetComponent<pr::NameComponent>(animControllerEntity);
@@ -269,66 +465,8 @@ namespace pr
 		size_t& prevKeyframeIdxOut,
 		size_t& nextKeyframeIdxOut)
 	{
-		// Find the next smallest/next largest keyframe time value about our current animation time:
-		const float currentTimeSec = animController->GetActiveClampedAnimationTimeSec();
-
-		std::vector<float> const& keyframeTimes = animController->GetKeyframeTimes(channel.m_keyframeTimesIdx);
-
-		// Find the closest keyframe time to the current time:
-		float minAbsDelta = std::numeric_limits<float>::max();
-		size_t minAbsDeltaIdx = 0;
-		float minKeyframeTimeSec = std::numeric_limits<float>::max();
-		size_t minKeyframeTimeIdx = 0;
-		float maxKeyframeTimeSec = std::numeric_limits<float>::min();
-		size_t maxKeyframeTimeIdx = 0;
-		for (size_t i = 0; i < keyframeTimes.size(); ++i)
-		{
-			const float curAbsDelta = glm::abs(currentTimeSec - keyframeTimes[i]);
-			if (curAbsDelta < minAbsDelta)
-			{
-				minAbsDelta = curAbsDelta;
-				minAbsDeltaIdx = i;
-			}
-
-			// Cache the min/max values we encounter:
-			if (keyframeTimes[i] < minKeyframeTimeSec)
-			{
-				minKeyframeTimeSec = keyframeTimes[i];
-				minKeyframeTimeIdx = i;
-			}
-			if (keyframeTimes[i] > maxKeyframeTimeSec)
-			{
-				maxKeyframeTimeSec = keyframeTimes[i];
-				maxKeyframeTimeIdx = i;
-			}
-		}
-
-		prevKeyframeIdxOut = 0;
-		nextKeyframeIdxOut = 0;
-
-		if (currentTimeSec < minKeyframeTimeSec) // Clamp to the min
-		{
-			prevKeyframeIdxOut = minKeyframeTimeIdx;
-			nextKeyframeIdxOut = minKeyframeTimeIdx;
-		}
-		else if (currentTimeSec > maxKeyframeTimeSec) // Clamp to the max
-		{
-			prevKeyframeIdxOut = maxKeyframeTimeIdx;
-			nextKeyframeIdxOut = maxKeyframeTimeIdx;
-		}
-		else
-		{
-			if (keyframeTimes[minAbsDeltaIdx] < currentTimeSec)
-			{
-				prevKeyframeIdxOut = minAbsDeltaIdx;
-				nextKeyframeIdxOut = (prevKeyframeIdxOut + 1) % keyframeTimes.size();
-			}
-			else // closest keyframe time >= currentTime
-			{
-				nextKeyframeIdxOut = minAbsDeltaIdx;
-				prevKeyframeIdxOut = nextKeyframeIdxOut == 0 ? keyframeTimes.size() - 1 : nextKeyframeIdxOut - 1;
-			}
-		}
+		// Keyframe segments are cached by the AnimationController when it is updated
+		animController->GetKeyframeSegment(channel.m_keyframeTimesIdx, prevKeyframeIdxOut, nextKeyframeIdxOut);
 	}
 
 
@@ -349,82 +487,25 @@ namespace pr
 
 		pr::Transform& transform = transformCmpt.GetTransform();
 
-		const float currentTimeSec = animCmpt.m_animationController->GetActiveClampedAnimationTimeSec();
-
+		// Channels are sampled in a single pass when the AnimationController is updated
+		AnimationController const* animController = animCmpt.m_animationController;
 		for (auto const& channel : animationData->m_channels)
 		{
-			// Find the next smallest/next largest keyframe time value about our current animation time:
-			size_t prevKeyframeIdx = 0;
-			size_t nextKeyframeIdx = 0;
-			GetPrevNextKeyframeIdx(animCmpt.m_animationController, channel, prevKeyframeIdx, nextKeyframeIdx);
-
-			// Select the appropriate channelData values:
-			std::vector<float> const& keyframeTimes =
-				animCmpt.m_animationController->GetKeyframeTimes(channel.m_keyframeTimesIdx);
-
-			std::vector<float> const& channelData = animCmpt.m_animationController->GetChannelData(channel.m_dataIdx);
-
 			switch (channel.m_targetPath)
 			{
 			case AnimationPath::Translation:
 			{
-				glm::vec3 const& interpolatedValue = GetInterpolatedValue<glm::vec3>(
-					channel.m_interpolationMode,
-					channelData.data(),
-					channelData.size(),
-					prevKeyframeIdx,
-					nextKeyframeIdx,
-					keyframeTimes[prevKeyframeIdx],
-					keyframeTimes[nextKeyframeIdx],
-					currentTimeSec);
-
-				transform.SetLocalTranslation(interpolatedValue);
+				transform.SetLocalTranslation(animController->GetSampledVec3(channel.m_samplerIdx));
 			}
 			break;
 			case AnimationPath::Rotation:
 			{
-				glm::quat interpolatedValue;
-				if (channel.m_interpolationMode == pr::InterpolationMode::SphericalLinearInterpolation)
-				{
-					interpolatedValue = GetSphericalLinearInterpolatedValue(
-						channel.m_interpolationMode,
-						channelData.data(),
-						channelData.size(),
-						prevKeyframeIdx,
-						nextKeyframeIdx,
-						keyframeTimes[prevKeyframeIdx],
-						keyframeTimes[nextKeyframeIdx],
-						currentTimeSec);
-				}
-				else
-				{
-					interpolatedValue = GetInterpolatedValue<glm::quat>(
-						channel.m_interpolationMode,
-						channelData.data(),
-						channelData.size(),
-						prevKeyframeIdx,
-						nextKeyframeIdx,
-						keyframeTimes[prevKeyframeIdx],
-						keyframeTimes[nextKeyframeIdx],
-						currentTimeSec);
-				}
-
-				transform.SetLocalRotation(glm::normalize(interpolatedValue));
+				transform.SetLocalRotation(animController->GetSampledRotation(channel.m_samplerIdx));
 			}
 			break;
 			case AnimationPath::Scale:
 			{
-				glm::vec3 const& interpolatedValue = GetInterpolatedValue<glm::vec3>(
-					channel.m_interpolationMode,
-					channelData.data(),
-					channelData.size(),
-					prevKeyframeIdx,
-					nextKeyframeIdx,
-					keyframeTimes[prevKeyframeIdx],
-					keyframeTimes[nextKeyframeIdx],
-					currentTimeSec);
-
-				transform.SetLocalScale(interpolatedValue);
+				transform.SetLocalScale(animController->GetSampledVec3(channel.m_samplerIdx));
 			}
 			break;
 			case AnimationPath::Weights:
@@ -461,7 +542,8 @@ namespace pr
 			animationIdx,
 			AnimationsDataComparator());
 
-		// Return null if node is not animated by the given keyframe times index
-		return animDataItr == m_animationsData.end() ? nullptr : &(*animDataItr);
+		// Return null if node is not animated by the given animation index
+		return (animDataItr == m_animationsData.end() || animDataItr->m_animationIdx != animationIdx) ?
+			nullptr : &(*animDataItr);
 	}
 }
\ No newline at end of file
@@ -50,6 +50,10 @@ namespace pr
 	inline float ComputeSegmentNormalizedInterpolationFactor(float prevSec, float nextSec, float requestedSec)
 	{
 		const float stepDuration = glm::abs(nextSec - prevSec); // td
+		if (stepDuration == 0.f)
+		{
+			return 0.f; // Clamped to a single keyframe
+		}
 		return glm::abs(requestedSec - prevSec) / stepDuration;
 	}
 
@@ -166,6 +170,30 @@ namespace pr
 	// -----------------------------------------------------------------------------------------------------------------
 
 
+	struct AnimationData final
+	{
+		static constexpr size_t k_invalidIdx = std::numeric_limits<size_t>::max();
+		static constexpr size_t k_invalidFloatsPerKeyframe = std::numeric_limits<uint8_t>::max();
+
+		size_t m_animationIdx;
+
+		struct Channel final
+		{
+			InterpolationMode m_interpolationMode	= InterpolationMode::InterpolationMode_Invalid;
+			AnimationPath m_targetPath				= AnimationPath::AnimationPath_Invalid;
+			size_t m_keyframeTimesIdx				= k_invalidIdx;
+			size_t m_dataIdx						= k_invalidIdx;
+			uint8_t m_dataFloatsPerKeyframe			= k_invalidFloatsPerKeyframe;
+			size_t m_samplerIdx						= k_invalidIdx; // Translation/rotation/scale channels only
+		};
+
+		std::vector<Channel> m_channels;
+	};
+
+
+	// -----------------------------------------------------------------------------------------------------------------
+
+
 	class AnimationController final
 	{
 	public:
@@ -217,6 +245,17 @@ namespace pr
 		std::vector<float> const& GetChannelData(size_t channelIdx) const;
 		size_t GetNumChannels() const;
 
+		// Registers a translation/rotation/scale channel to be sampled once per update. Returns the samplerIdx
+		size_t AddChannelSampler(size_t animIdx, AnimationData::Channel const&);
+
+
+	public: // Active animation sampling results, updated once per UpdateAnimationController call:
+		void GetKeyframeSegment(size_t keyframeTimesIdx, size_t& prevIdxOut, size_t& nextIdxOut) const;
+
+		glm::vec3 GetSampledVec3(size_t samplerIdx) const; // Translation/scale channels
+		glm::quat GetSampledRotation(size_t samplerIdx) const;
+
+
 	public:
 		static void ShowImGuiWindow(pr::EntityManager&, entt::entity);
 
@@ -237,6 +276,29 @@ namespace pr
 		std::vector<std::vector<float>> m_channelData; // ALL data for all animations
 
 
+	private:
+		// Sampling state for each animation, stored as parallel arrays. Keyframe cursors cache the index of the 1st
+		// keyframe time > the current time: Animation time moves by a small step each update, so cursors usually
+		// advance by 0 or 1 keyframes and we only fall back to a binary search when time jumps (e.g. looping)
+		struct ClipSamplers final
+		{
+			// Indexed by keyframeTimesIdx:
+			std::vector<uint32_t> m_keyframeCursors;
+			std::vector<uint32_t> m_prevKeyframeIdxs;
+			std::vector<uint32_t> m_nextKeyframeIdxs;
+
+			// Indexed by samplerIdx:
+			std::vector<uint32_t> m_samplerKeyframeTimesIdxs;
+			std::vector<uint32_t> m_samplerDataIdxs;
+			std::vector<InterpolationMode> m_samplerInterpolationModes;
+			std::vector<AnimationPath> m_samplerTargetPaths;
+			std::vector<glm::vec4> m_sampledValues; // Translation/scale: .xyz, Rotation: Quaternion .xyzw
+		};
+		std::vector<ClipSamplers> m_clipSamplers; // Indexed per animation
+
+		void SampleActiveAnimation(); // Updates the keyframe cursors, and samples all channels in a single pass
+
+
 	private: // Use the static creation factories
 		struct PrivateCTORTag { explicit PrivateCTORTag() = default; };
 		AnimationController() : AnimationController(PrivateCTORTag{}) {}
@@ -341,30 +403,39 @@ namespace pr
 	{
 		return m_channelData.size();
 	}
-	
 
-	// ----
 
+	inline void AnimationController::GetKeyframeSegment(
+		size_t keyframeTimesIdx, size_t& prevIdxOut, size_t& nextIdxOut) const
+	{
+		ClipSamplers const& clipSamplers = m_clipSamplers[m_activeAnimationIdx];
+		SEAssert(keyframeTimesIdx < clipSamplers.m_prevKeyframeIdxs.size(), "Invalid index");
 
-	struct AnimationData final
+		prevIdxOut = clipSamplers.m_prevKeyframeIdxs[keyframeTimesIdx];
+		nextIdxOut = clipSamplers.m_nextKeyframeIdxs[keyframeTimesIdx];
+	}
+
+
+	inline glm::vec3 AnimationController::GetSampledVec3(size_t samplerIdx) const
 	{
-		static constexpr size_t k_invalidIdx = std::numeric_limits<size_t>::max();
-		static constexpr size_t k_invalidFloatsPerKeyframe = std::numeric_limits<uint8_t>::max();
+		ClipSamplers const& clipSamplers = m_clipSamplers[m_activeAnimationIdx];
+		SEAssert(samplerIdx < clipSamplers.m_sampledValues.size(), "Invalid sampler index");
+		SEAssert(clipSamplers.m_samplerTargetPaths[samplerIdx] != AnimationPath::Rotation, "Sampler is a rotation");
 
-		size_t m_animationIdx;
+		return glm::vec3(clipSamplers.m_sampledValues[samplerIdx]);
+	}
 
-		struct Channel final
-		{
-			InterpolationMode m_interpolationMode	= InterpolationMode::InterpolationMode_Invalid;
-			AnimationPath m_targetPath				= AnimationPath::AnimationPath_Invalid;
-			size_t m_keyframeTimesIdx				= k_invalidIdx;
-			size_t m_dataIdx						= k_invalidIdx;
-			uint8_t m_dataFloatsPerKeyframe			= k_invalidFloatsPerKeyframe;
-		};
 
-		std::vector<Channel> m_channels;
-	};
+	inline glm::quat AnimationController::GetSampledRotation(size_t samplerIdx) const
+	{
+		ClipSamplers const& clipSamplers = m_clipSamplers[m_activeAnimationIdx];
+		SEAssert(samplerIdx < clipSamplers.m_sampledValues.size(), "Invalid sampler index");
+		SEAssert(clipSamplers.m_samplerTargetPaths[samplerIdx] == AnimationPath::Rotation, "Sampler is not a rotation");
 
+		glm::vec4 const& sampledValue = clipSamplers.m_sampledValues[samplerIdx];
+		return glm::quat(sampledValue.w, sampledValue.x, sampledValue.y, sampledValue.z);
+	}
+	
 
 	// ----
 
@@ -141,18 +141,24 @@ namespace pr
 	}
 
 
+	bool BoundsComponent::HasTransformChanged(pr::EntityManager& em, pr::Relationship const& relationship)
+	{
+		pr::TransformComponent const* transformCmpt = relationship.GetFirstInHierarchyAbove<pr::TransformComponent>(em);
+
+		return transformCmpt && transformCmpt->GetTransform().HasChanged();
+	}
+
+
 	void BoundsComponent::UpdateBoundsComponent(
 		pr::EntityManager& em,
 		pr::BoundsComponent& boundsCmpt,
 		pr::Relationship const& relationship,
-		entt::entity boundsEntity)
+		entt::entity boundsEntity,
+		bool transformChanged)
 	{
-		if (pr::TransformComponent const* transformCmpt = relationship.GetFirstInHierarchyAbove<pr::TransformComponent>(em))
+		if (transformChanged)
 		{
-			if (transformCmpt->GetTransform().HasChanged())
-			{
-				boundsCmpt.MarkDirty(em, boundsEntity);
-			}
+			boundsCmpt.MarkDirty(em, boundsEntity);
 		}
 
 		std::vector<entt::entity> const& childBounds = 
@@ -39,8 +39,11 @@ namespace pr
 			glm::vec3 const& minXYZ, 
 			glm::vec3 const& maxXYZ);
 
+		// Does not modify the registry: Can be called in parallel
+		static bool HasTransformChanged(pr::EntityManager&, pr::Relationship const&);
+
 		static void UpdateBoundsComponent(
-			pr::EntityManager&, pr::BoundsComponent&, pr::Relationship const&, entt::entity);
+			pr::EntityManager&, pr::BoundsComponent&, pr::Relationship const&, entt::entity, bool transformChanged);
 
 
 	public:
@@ -21,6 +21,7 @@
 #include "Core/Config.h"
 #include "Core/EventManager.h"
 #include "Core/ProfilingMarkers.h"
+#include "Core/ThreadPool.h"
 
 #include "Core/Definitions/ConfigKeys.h"
 #include "Core/Definitions/EventKeys.h"
@@ -39,9 +40,13 @@ namespace pr
 {
 	EntityManager::EntityManager()
 		: m_entityCommands(k_entityCommandBufferSize)
+		, m_useFlatTransformHierarchy(
+			!core::Config::KeyExists(core::configkeys::k_hierarchicalTransformUpdateCmdLineArg))
 	{
 		// Handle this during construction before anything can interact with the registry
 		ConfigureRegistry();
+
+		RegisterSystems();
 	}
 
 
@@ -70,7 +75,7 @@ namespace pr
 		ProcessEntityCommands();
 
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 
 			// Add all entities to the deferred delete queue
 			for (auto entityTuple : m_registry.storage<entt::entity>().each())
@@ -84,7 +89,7 @@ namespace pr
 		ExecuteDeferredDeletions();
 
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 			m_registry.clear();
 		}
 
@@ -99,22 +104,13 @@ namespace pr
 
 		ProcessEntityCommands();
 
-		// Handle interaction (player input, physics, animation, etc)
-		UpdateCameraController(stepTimeMs);
-
-		// Update the scene state:
-		if (m_animationEnabled)
+		// Handle interaction, and update the scene state. Systems are executed in parallel where their component
+		// accesses don't conflict. We hold the registry lock for their duration, and delegate it to them
 		{
-			UpdateAnimationControllers(stepTimeMs);  // Modifies Transforms
-		}
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 
-		UpdateTransforms(); // Transforms are immutable after this point
-		
-		UpdateAnimations(stepTimeMs);
-		UpdateBounds();
-		UpdateMaterials();
-		UpdateLightsAndShadows();
-		UpdateCameras();
+			m_systemScheduler.Execute(m_registry, m_registeryMutex, stepTimeMs);
+		}
 
 		ExecuteDeferredDeletions();
 	}
@@ -135,18 +131,30 @@ namespace pr
 	void EntityManager::EnqueueRenderUpdateHelper()
 	{
 		auto componentsView = m_registry.view<pr::RenderDataComponent, DirtyMarker<CmptType>, CmptType, OtherCmpts...>();
+
+		// Pack the IDs and data of every dirty component into a single update, rather than a command per entity
+		std::vector<gr::RenderDataID> renderDataIDs;
+		std::vector<RenderDataType> renderData;
+		renderDataIDs.reserve(componentsView.size_hint());
+		renderData.reserve(componentsView.size_hint());
+
 		for (auto entity : componentsView)
 		{
 			pr::RenderDataComponent const& renderDataComponent = componentsView.get<pr::RenderDataComponent>(entity);
 
 			CmptType const& component = componentsView.get<CmptType>(entity);
 
-			gr::RenderCommand::Enqueue<pr::UpdateRenderData<RenderDataType>>(
-				renderDataComponent.GetRenderDataID(),
-				CmptType::CreateRenderData(*this, entity, component));
+			renderDataIDs.emplace_back(renderDataComponent.GetRenderDataID());
+			renderData.emplace_back(CmptType::CreateRenderData(*this, entity, component));
 
 			m_registry.erase<DirtyMarker<CmptType>>(entity);
 		}
+
+		if (!renderDataIDs.empty())
+		{
+			gr::RenderCommand::Enqueue<pr::UpdateRenderDataBatch<RenderDataType>>(
+				std::move(renderDataIDs), std::move(renderData));
+		}
 	}
 
 
@@ -156,7 +164,7 @@ namespace pr
 		// -> Use entt::organizer
 
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 
 			// Register new render objects:
 			auto newRenderableEntitiesView = 
@@ -198,19 +206,32 @@ namespace pr
 			// Update dirty render data components:
 			// ------------------------------------
 
-			// Transforms:
+			// Transforms: Packed into a single update
 			auto transformCmptsView = m_registry.view<pr::TransformComponent>();
+
+			std::vector<gr::TransformID> dirtyTransformIDs;
+			std::vector<gr::Transform::RenderData> dirtyTransformData;
+
 			for (auto entity : transformCmptsView)
 			{
 				pr::TransformComponent& transformComponent = transformCmptsView.get<pr::TransformComponent>(entity);
 
 				if (transformComponent.GetTransform().HasChanged())
 				{
-					gr::RenderCommand::Enqueue<pr::UpdateTransformDataRenderCommand>(*this, transformComponent);
+					dirtyTransformIDs.emplace_back(transformComponent.GetTransformID());
+					dirtyTransformData.emplace_back(
+						pr::TransformComponent::CreateRenderData(*this, transformComponent));
+
 					transformComponent.GetTransform().ClearHasChangedFlag();
 				}
 			}
 
+			if (!dirtyTransformIDs.empty())
+			{
+				gr::RenderCommand::Enqueue<pr::UpdateTransformDataBatchRenderCommand>(
+					std::move(dirtyTransformIDs), std::move(dirtyTransformData));
+			}
+
 			// Handle camera changes:
 			auto newMainCameraView = m_registry.view<
 				pr::CameraComponent,
@@ -257,7 +278,7 @@ namespace pr
 	pr::BoundsComponent const* EntityManager::GetSceneBounds() const
 	{
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 
 			auto sceneBoundsEntityView = m_registry.view<pr::BoundsComponent, pr::BoundsComponent::SceneBoundsMarker>();
 			SEAssert(sceneBoundsEntityView.front() == sceneBoundsEntityView.back(),
@@ -282,7 +303,7 @@ namespace pr
 			"Entity does not have a valid camera component");
 
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 
 			entt::entity currentMainCamera = entt::null;
 			bool foundCurrentMainCamera = false;
@@ -340,7 +361,7 @@ namespace pr
 	entt::entity EntityManager::GetMainCamera() const
 	{
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 			
 			entt::entity mainCamEntity = entt::null;
 
@@ -370,7 +391,7 @@ namespace pr
 		const entt::entity prevActiveAmbient = GetActiveAmbientLight();
 
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 
 			// We might not have a previously active ambient light, if this is the first ambient light we've added
 			if (prevActiveAmbient != entt::null)
@@ -426,7 +447,7 @@ namespace pr
 		bool foundCurrentActiveAmbient = false;
 
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 
 			auto currentActiveAmbient = m_registry.view<pr::LightComponent::IsActiveIBLMarker>();
 			for (auto entity : currentActiveAmbient)
@@ -449,7 +470,7 @@ namespace pr
 		LOG("EntityManager: Resetting registry");
 
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 
 			// Register all entities for delete
 			for (auto entityTuple : m_registry.storage<entt::entity>().each())
@@ -476,7 +497,7 @@ namespace pr
 		
 		entt::entity newEntity = entt::null;
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 			newEntity = m_registry.create();
 		}
 
@@ -658,13 +679,79 @@ namespace pr
 	void EntityManager::ConfigureRegistry()
 	{
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 
 			m_registry.on_construct<DirtyMarker<pr::BoundsComponent>>().connect<&pr::EntityManager::OnBoundsDirty>(*this);
 		}
 	}
 
 
+	void EntityManager::RegisterSystems()
+	{
+		// Note: Systems that emplace a DirtyMarker<pr::BoundsComponent> also trigger OnBoundsDirty
+
+		m_systemScheduler.AddSystem("EntityManager::UpdateCameraController",
+			[this](double stepTimeMs) { UpdateCameraController(stepTimeMs); })
+			.Reads<pr::AnimationComponent, pr::CameraComponent::MainCameraMarker>()
+			.Writes<pr::CameraControlComponent, pr::CameraComponent, pr::TransformComponent>();
+
+		m_systemScheduler.AddSystem("EntityManager::UpdateAnimationControllers",
+			[this](double stepTimeMs)
+			{
+				if (m_animationEnabled)
+				{
+					UpdateAnimationControllers(stepTimeMs);
+				}
+			})
+			.Reads<pr::AnimationComponent>()
+			.Writes<pr::AnimationController, pr::TransformComponent>();
+
+		m_systemScheduler.AddSystem("EntityManager::UpdateTransforms",
+			[this](double) { UpdateTransforms(); }) // Transforms are immutable after this point
+			.Writes<pr::TransformComponent>();
+
+		m_systemScheduler.AddSystem("EntityManager::UpdateMorphAnimations",
+			[this](double) { UpdateMorphAnimations(); })
+			.Reads<pr::AnimationComponent, pr::AnimationController, pr::Mesh::MeshConceptMarker>()
+			.Writes<pr::MeshMorphComponent, DirtyMarker<pr::MeshMorphComponent>>();
+
+		m_systemScheduler.AddSystem("EntityManager::UpdateSkinAnimations",
+			[this](double stepTimeMs) { UpdateSkinAnimations(stepTimeMs); })
+			.Reads<pr::TransformComponent, pr::Mesh::MeshConceptMarker, pr::Relationship, pr::RenderDataComponent,
+				pr::BoundsComponent::SceneBoundsMarker, pr::ShadowMapComponent,
+				pr::LightComponent::DirectionalDeferredMarker>()
+			.Writes<pr::SkinningComponent, DirtyMarker<pr::SkinningComponent>,
+				pr::BoundsComponent, DirtyMarker<pr::BoundsComponent>, DirtyMarker<pr::ShadowMapComponent>>();
+
+		m_systemScheduler.AddSystem("EntityManager::UpdateBounds",
+			[this](double) { UpdateBounds(); })
+			.Reads<pr::TransformComponent, pr::Relationship, pr::RenderDataComponent,
+				pr::BoundsComponent::SceneBoundsMarker, pr::ShadowMapComponent,
+				pr::LightComponent::DirectionalDeferredMarker>()
+			.Writes<pr::BoundsComponent, DirtyMarker<pr::BoundsComponent>, DirtyMarker<pr::ShadowMapComponent>>();
+
+		m_systemScheduler.AddSystem("EntityManager::UpdateMaterials",
+			[this](double) { UpdateMaterials(); })
+			.Writes<pr::MaterialInstanceComponent, DirtyMarker<pr::MaterialInstanceComponent>>();
+
+		m_systemScheduler.AddSystem("EntityManager::UpdateLightsAndShadows",
+			[this](double) { UpdateLightsAndShadows(); })
+			.Reads<pr::BoundsComponent, pr::BoundsComponent::SceneBoundsMarker, pr::CameraComponent::MainCameraMarker,
+				pr::LightComponent::IBLDeferredMarker, pr::LightComponent::PointDeferredMarker,
+				pr::LightComponent::SpotDeferredMarker, pr::LightComponent::DirectionalDeferredMarker,
+				pr::ShadowMapComponent::HasShadowMarker, pr::Relationship, pr::RenderDataComponent>()
+			.Writes<pr::LightComponent, DirtyMarker<pr::LightComponent>,
+				pr::ShadowMapComponent, DirtyMarker<pr::ShadowMapComponent>,
+				pr::CameraComponent, DirtyMarker<pr::CameraComponent>,
+				pr::TransformComponent>(); // Light transforms are scaled to match their light volumes
+
+		m_systemScheduler.AddSystem("EntityManager::UpdateCameras",
+			[this](double) { UpdateCameras(); })
+			.Reads<pr::TransformComponent>()
+			.Writes<pr::CameraComponent, DirtyMarker<pr::CameraComponent>>();
+	}
+
+
 	void EntityManager::UpdateCameraController(double stepTimeMs)
 	{
 		SEBeginCPUEvent("EntityManager::UpdateCameraController");
@@ -674,7 +761,7 @@ namespace pr
 		if (mainCamera != entt::null &&
 			!HasComponent<pr::AnimationComponent>(mainCamera))
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 
 			pr::CameraControlComponent* cameraController = nullptr;
 			pr::TransformComponent* camControllerTransform = nullptr;
@@ -706,17 +793,33 @@ namespace pr
 	{
 		SEBeginCPUEvent("EntityManager::UpdateBounds");
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 
 			// Update "regular" bounds: Mark them as dirty if their transforms have changed
 			auto boundsView = m_registry.view<pr::BoundsComponent, pr::Relationship>(
 				entt::exclude<pr::BoundsComponent::SceneBoundsMarker>);
-			for (entt::entity entity : boundsView)
+
+			// Finding the Transform of each bounds walks up its hierarchy, so we check for changes in parallel. Marking
+			// bounds dirty and expanding them to contain their children modifies the registry and other bounds, so
+			// that's done serially
+			std::vector<entt::entity> boundsEntities(boundsView.begin(), boundsView.end());
+			std::vector<uint8_t> transformsChanged(boundsEntities.size(), 0);
+			pr::SystemScheduler::ParallelFor(m_registeryMutex, boundsEntities.size(),
+				[this, &boundsView, &boundsEntities, &transformsChanged](size_t boundsIdx)
+				{
+					transformsChanged[boundsIdx] = pr::BoundsComponent::HasTransformChanged(
+						*this, boundsView.get<pr::Relationship>(boundsEntities[boundsIdx]));
+				});
+
+			for (size_t boundsIdx = 0; boundsIdx < boundsEntities.size(); ++boundsIdx)
 			{
-				pr::BoundsComponent& bounds = boundsView.get<pr::BoundsComponent>(entity);
-				pr::Relationship const& relationship = boundsView.get<pr::Relationship>(entity);
+				const entt::entity entity = boundsEntities[boundsIdx];
 
-				pr::BoundsComponent::UpdateBoundsComponent(*this, bounds, relationship, entity);
+				pr::BoundsComponent::UpdateBoundsComponent(*this,
+					boundsView.get<pr::BoundsComponent>(entity),
+					boundsView.get<pr::Relationship>(entity),
+					entity,
+					transformsChanged[boundsIdx] != 0);
 			}
 
 			// Find the scene bounds entity:
@@ -793,37 +896,49 @@ namespace pr
 	{
 		SEBeginCPUEvent("EntityManager::UpdateAnimationControllers");
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
+
+			// Controllers, and the nodes they animate, are independent: Update them in parallel chunks
+			std::vector<entt::entity> entities;
 
 			// Update the animation controllers:
 			auto animationControllersView = m_registry.view<pr::AnimationController>();
-			for (auto entity : animationControllersView)
-			{
-				pr::AnimationController& animationController = animationControllersView.get<pr::AnimationController>(entity);
-				pr::AnimationController::UpdateAnimationController(animationController, stepTimeMs);
-			}
+			entities.assign(animationControllersView.begin(), animationControllersView.end());
+
+			pr::SystemScheduler::ParallelFor(m_registeryMutex, entities.size(),
+				[&animationControllersView, &entities, stepTimeMs](size_t entityIdx)
+				{
+					pr::AnimationController& animationController =
+						animationControllersView.get<pr::AnimationController>(entities[entityIdx]);
+
+					pr::AnimationController::UpdateAnimationController(animationController, stepTimeMs);
+				});
 
 			// Update the individual animation components:
 			auto animatedsView = m_registry.view<pr::AnimationComponent, pr::TransformComponent>();
-			for (auto entity : animatedsView)
-			{
-				pr::AnimationComponent& animationComponent = animatedsView.get<pr::AnimationComponent>(entity);
-				pr::TransformComponent& transformComponent = animatedsView.get<pr::TransformComponent>(entity);
+			entities.assign(animatedsView.begin(), animatedsView.end());
 
-				pr::AnimationComponent::ApplyAnimation(animationComponent, transformComponent);
-			}
+			pr::SystemScheduler::ParallelFor(m_registeryMutex, entities.size(),
+				[&animatedsView, &entities](size_t entityIdx)
+				{
+					const entt::entity entity = entities[entityIdx];
+
+					pr::AnimationComponent& animationComponent = animatedsView.get<pr::AnimationComponent>(entity);
+					pr::TransformComponent& transformComponent = animatedsView.get<pr::TransformComponent>(entity);
+
+					pr::AnimationComponent::ApplyAnimation(animationComponent, transformComponent);
+				});
 		}
 		SEEndCPUEvent();
 	}
 
 
-	void EntityManager::UpdateAnimations(double stepTimeMs)
+	void EntityManager::UpdateMorphAnimations()
 	{
-		SEBeginCPUEvent("EntityManager::UpdateAnimations");
+		SEBeginCPUEvent("EntityManager::UpdateMorphAnimations");
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 
-			// Morph animations:
 			auto morphMeshesView = 
 				m_registry.view<pr::AnimationComponent, pr::MeshMorphComponent, pr::Mesh::MeshConceptMarker>();
 			for (auto entity : morphMeshesView)
@@ -833,14 +948,40 @@ namespace pr
 
 				pr::MeshMorphComponent::ApplyAnimation(*this, entity, animCmpt, meshAnimCmpt);
 			}
+		}
+		SEEndCPUEvent();
+	}
+
+
+	void EntityManager::UpdateSkinAnimations(double stepTimeMs)
+	{
+		SEBeginCPUEvent("EntityManager::UpdateSkinAnimations");
+		{
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 
-			// Skin animations:
 			auto skinnedMeshesView =
 				m_registry.view<pr::SkinningComponent, pr::Mesh::MeshConceptMarker>();
-			for (auto entity : skinnedMeshesView)
+
+			std::vector<entt::entity> skinnedEntities(skinnedMeshesView.begin(), skinnedMeshesView.end());
+
+			// Building the matrix palettes does not modify the registry: Each skin is updated in parallel
+			std::vector<uint8_t> skinMatricesChanged(skinnedEntities.size(), 0);
+			pr::SystemScheduler::ParallelFor(m_registeryMutex, skinnedEntities.size(),
+				[&skinnedMeshesView, &skinnedEntities, &skinMatricesChanged](size_t skinIdx)
+				{
+					skinMatricesChanged[skinIdx] = pr::SkinningComponent::UpdateSkinMatrices(
+						skinnedMeshesView.get<pr::SkinningComponent>(skinnedEntities[skinIdx]));
+				});
+
+			for (size_t skinIdx = 0; skinIdx < skinnedEntities.size(); ++skinIdx)
 			{
-				pr::SkinningComponent& skinCmpt = skinnedMeshesView.get<pr::SkinningComponent>(entity);
-				pr::SkinningComponent::UpdateSkinMatrices(*this, entity, skinCmpt, static_cast<float>(stepTimeMs));
+				const entt::entity entity = skinnedEntities[skinIdx];
+
+				pr::SkinningComponent::FinalizeSkinMatrices(*this,
+					entity,
+					skinnedMeshesView.get<pr::SkinningComponent>(entity),
+					skinMatricesChanged[skinIdx] != 0,
+					static_cast<float>(stepTimeMs));
 			}
 		}
 		SEEndCPUEvent();
@@ -851,34 +992,55 @@ namespace pr
 	{
 		SEBeginCPUEvent("EntityManager::UpdateTransforms");
 
-		// Use the number of root transforms during the last update 
-		static size_t prevNumRootTransforms = 1;
+		if (m_useFlatTransformHierarchy)
+		{
+			{
+				std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
+
+				if (m_transformHierarchy.IsStale())
+				{
+					std::vector<pr::Transform*> rootNodes;
 
-		std::vector<std::future<void>> taskFutures;
-		taskFutures.reserve(prevNumRootTransforms);
+					auto transformComponentsView = m_registry.view<pr::TransformComponent>();
+					for (auto entity : transformComponentsView)
+					{
+						pr::Transform& node = transformComponentsView.get<pr::TransformComponent>(entity).GetTransform();
+						if (node.GetParent() == nullptr)
+						{
+							rootNodes.emplace_back(&node);
+						}
+					}
 
+					m_transformHierarchy.Build(rootNodes);
+				}
+			}
+
+			// Note: The SystemScheduler orders us after every system that modifies Transforms, and before any that
+			// access them, so we don't need to hold the registry lock (or any per-Transform locks) while we update
+			m_transformHierarchy.Update();
+		}
+		else
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			core::JobCounter transformJobCounter;
 
-			auto transformComponentsView = m_registry.view<pr::TransformComponent>();
-			for (auto entity : transformComponentsView)
 			{
-				// Find root nodes:
-				pr::TransformComponent& transformComponent = transformComponentsView.get<pr::TransformComponent>(entity);
-				pr::Transform& node = transformComponent.GetTransform();
-				if (node.GetParent() == nullptr)
+				std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
+
+				auto transformComponentsView = m_registry.view<pr::TransformComponent>();
+				for (auto entity : transformComponentsView)
 				{
-					pr::TransformComponent::DispatchTransformUpdateThreads(taskFutures, &node);
+					// Find root nodes:
+					pr::TransformComponent& transformComponent = transformComponentsView.get<pr::TransformComponent>(entity);
+					pr::Transform& node = transformComponent.GetTransform();
+					if (node.GetParent() == nullptr)
+					{
+						pr::TransformComponent::DispatchTransformUpdateThreads(transformJobCounter, &node);
+					}
 				}
 			}
-		}
 
-		prevNumRootTransforms = std::max(1llu, taskFutures.size());
-
-		// Wait for the updates to complete
-		for (std::future<void> const& taskFuture : taskFutures)
-		{
-			taskFuture.wait();
+			// Wait for the updates to complete. We execute any pending jobs while we wait
+			core::ThreadPool::WaitForCounter(transformJobCounter);
 		}
 
 		SEEndCPUEvent();
@@ -889,7 +1051,7 @@ namespace pr
 	{
 		SEBeginCPUEvent("EntityManager::UpdateMaterials");
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 
 			auto materialView = m_registry.view<pr::MaterialInstanceComponent>();
 			for (auto entity : materialView)
@@ -922,7 +1084,7 @@ namespace pr
 
 		// Add dirty markers to lights and shadows so the render data will be updated
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 
 			// Ambient lights:
 			auto ambientView = m_registry.view<pr::LightComponent, pr::LightComponent::IBLDeferredMarker>();
@@ -1005,7 +1167,7 @@ namespace pr
 
 		// Check for dirty cameras, or cameras with dirty transforms
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 
 			auto cameraComponentsView = m_registry.view<pr::CameraComponent>();
 			for (auto entity : cameraComponentsView)
@@ -1410,7 +1572,7 @@ namespace pr
 
 				// List the component types:
 				{
-					std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+					std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 
 					for (auto&& curr : m_registry.storage())
 					{
@@ -1498,7 +1660,7 @@ namespace pr
 			bool cameraChanged = false;
 
 			{
-				std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+				std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 
 				// We ly show cameras that have the CameraConceptMarker, so we can filter out "non-standard" cameras
 				// (e.g. shadow cameras)
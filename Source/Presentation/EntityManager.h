@@ -1,5 +1,8 @@
 // © 2022 Adam Badke. All rights reserved.
 #pragma once
+#include "SystemScheduler.h"
+#include "TransformHierarchy.h"
+
 #include "Core/CommandQueue.h"
 
 #include "Core/Interfaces/IEngineComponent.h"
@@ -27,9 +30,12 @@ namespace pr
 
 
 	private: // Systems:
+		void RegisterSystems(); // Declares the systems, and their component accesses, to the SystemScheduler
+
 		void UpdateCameraController(double stepTimeMs);
 		void UpdateAnimationControllers(double stepTimeMs);
-		void UpdateAnimations(double stepTimeMs);
+		void UpdateMorphAnimations();
+		void UpdateSkinAnimations(double stepTimeMs);
 		void UpdateTransforms();
 		void UpdateBounds();
 		void UpdateMaterials();
@@ -155,13 +161,18 @@ namespace pr
 
 	private:
 		entt::basic_registry<entt::entity> m_registry; // uint32_t entities
-		mutable std::recursive_mutex m_registeryMutex;
+		mutable pr::RegistryMutex m_registeryMutex;
 
 		std::vector<entt::entity> m_deferredDeleteQueue;
 		std::mutex m_deferredDeleteQueueMutex;
 
 	private: // Systems:
+		pr::SystemScheduler m_systemScheduler;
+
 		bool m_animationEnabled;
+
+		pr::TransformHierarchy m_transformHierarchy;
+		const bool m_useFlatTransformHierarchy; // If false, each root's hierarchy is walked (and locked) per-node
 	};
 
 
@@ -169,7 +180,7 @@ namespace pr
 	void EntityManager::EmplaceComponent(entt::entity entity)
 	{
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 
 			m_registry.emplace<T>(entity);
 		}
@@ -180,7 +191,7 @@ namespace pr
 	T* EntityManager::EmplaceComponent(entt::entity entity, Args&&... args)
 	{
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 
 			T& result = m_registry.emplace<T>(entity, std::forward<Args>(args)...);
 
@@ -193,7 +204,7 @@ namespace pr
 	void EntityManager::EmplaceOrReplaceComponent(entt::entity entity)
 	{
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 
 			m_registry.emplace_or_replace<T>(entity);
 		}
@@ -241,7 +252,7 @@ namespace pr
 			// It's only safe to add/remove/iterate components if no other thread is adding/removing/iterating
 			// components of the same type. For now, we obtain an exclusive lock on the entire registry, but this could
 			// be more granular
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 
 			m_registry.erase<T>(entity);
 		}
@@ -252,7 +263,7 @@ namespace pr
 	T* EntityManager::TryGetComponent(entt::entity entity)
 	{
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 
 			return m_registry.try_get<T>(entity);
 		}
@@ -263,7 +274,7 @@ namespace pr
 	T const* EntityManager::TryGetComponent(entt::entity entity) const
 	{
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 
 			return m_registry.try_get<T>(entity);
 		}
@@ -274,7 +285,7 @@ namespace pr
 	bool EntityManager::HasComponent(entt::entity entity) const
 	{
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 			return m_registry.any_of<T>(entity);
 		}
 	}
@@ -284,7 +295,7 @@ namespace pr
 	bool EntityManager::HasComponents(entt::entity entity) const
 	{
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 			return m_registry.all_of<T, Args...>(entity);
 		}
 	}
@@ -294,7 +305,7 @@ namespace pr
 	T& EntityManager::GetComponent(entt::entity entity)
 	{
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 			return m_registry.get<T>(entity);
 		}
 	}
@@ -304,7 +315,7 @@ namespace pr
 	T const& EntityManager::GetComponent(entt::entity entity) const
 	{
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 			return m_registry.get<T>(entity);
 		}
 	}
@@ -316,7 +327,7 @@ namespace pr
 		std::vector<entt::entity> result;
 
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 
 			auto view = m_registry.view<T, Args...>();
 			for (auto entity : view)
@@ -333,7 +344,7 @@ namespace pr
 	bool EntityManager::EntityExists() const
 	{
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 
 			auto view = m_registry.view<T, Args...>();
 			for (auto entity : view)
@@ -349,7 +360,7 @@ namespace pr
 	auto EntityManager::QueryRegistry(Callback&& callback) const
 	{
 		{
-			std::unique_lock<std::recursive_mutex> lock(m_registeryMutex);
+			std::unique_lock<pr::RegistryMutex> lock(m_registeryMutex);
 
 			auto view = m_registry.view<T, Args...>();
 			return std::forward<Callback>(callback)(view);
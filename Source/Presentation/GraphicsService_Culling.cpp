@@ -42,8 +42,17 @@ namespace pr
 					s_cullingData.m_cullingEnabled = false;
 				}
 			}
+			if (core::Config::KeyExists(core::configkeys::k_disableIncrementalCullingCmdLineArg))
+			{
+				{
+					std::unique_lock<std::shared_mutex> lock(s_cullingDataMutex);
+
+					s_cullingData.m_incrementalCullingEnabled = false;
+				}
+			}
 
 			EnableCulling(s_cullingData.m_cullingEnabled);
+			EnableIncrementalCulling(s_cullingData.m_incrementalCullingEnabled);
 		}
 	}
 
@@ -83,6 +92,40 @@ namespace pr
 	}
 
 
+	bool CullingGraphicsService::IsIncrementalCullingEnabled() const
+	{
+		if (s_cullingGraphicsSystem)
+		{
+			std::shared_lock<std::shared_mutex> lock(s_cullingDataMutex);
+
+			return s_cullingData.m_incrementalCullingEnabled;
+		}
+		return false;
+	}
+
+
+	void CullingGraphicsService::EnableIncrementalCulling(bool isEnabled)
+	{
+		{
+			std::unique_lock<std::shared_mutex> lock(s_cullingDataMutex);
+			s_cullingData.m_incrementalCullingEnabled = isEnabled;
+		}
+
+		if (s_cullingGraphicsSystem)
+		{
+			EnqueueServiceCommand([isEnabled]()
+				{
+					s_cullingGraphicsSystem->EnableIncrementalCulling(
+						ACCESS_KEY(gr::CullingGraphicsSystem::AccessKey), isEnabled);
+				});
+		}
+		else
+		{
+			LOG_ERROR("CullingGraphicsService has not been bound to the CullingGraphicsSystem");
+		}
+	}
+
+
 	void CullingGraphicsService::SetCullingDebugOverride(gr::RenderDataID overrideCameraID)
 	{
 		if (s_cullingGraphicsSystem)
@@ -112,6 +155,12 @@ namespace pr
 			EnableCulling(cullingEnabled);
 		}
 
+		bool incrementalCullingEnabled = IsIncrementalCullingEnabled();
+		if (ImGui::Checkbox("Enable incremental culling", &incrementalCullingEnabled))
+		{
+			EnableIncrementalCulling(incrementalCullingEnabled);
+		}
+
 		if (ImGui::BeginMenu("Culling override"))
 		{
 			std::vector<std::pair<std::string, gr::RenderDataID>> const& cameras =
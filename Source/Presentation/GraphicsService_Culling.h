@@ -20,6 +20,10 @@ namespace pr
 		bool IsCullingEnabled() const;
 		void EnableCulling(bool isEnabled);
 
+		// Reuse the previous frame's results for unchanged views, and only retest modified bounds
+		bool IsIncrementalCullingEnabled() const;
+		void EnableIncrementalCulling(bool isEnabled);
+
 		// View the culling results for a specific camera, rendered via the currently active camera
 		void SetCullingDebugOverride(gr::RenderDataID overrideCameraID); // gr::k_invalidRenderDataID disables override
 
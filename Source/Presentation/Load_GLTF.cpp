@@ -2089,6 +2089,13 @@ namespace
 					"The number of keyframe entries must be an exact multiple of the number of output floats");
 
 				animChannel.m_dataFloatsPerKeyframe = util::CheckedCast<uint8_t>(numOutputFloats / numKeyframeTimeEntries);
+
+				// Morph target weights are sampled by the MeshMorphComponent
+				if (animChannel.m_targetPath != pr::AnimationPath::Weights)
+				{
+					animChannel.m_samplerIdx =
+						fileMetadata->m_animationController->AddChannelSampler(animIdx, animChannel);
+				}
 			}
 		}
 	}
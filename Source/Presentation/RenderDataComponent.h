@@ -143,6 +143,47 @@ namespace pr
 	// ---
 
 
+	// Updates data of a single type for many render objects with one command. The IDs and data are packed into
+	// parallel arrays, which are moved into the command and then moved into the RenderDataManager (i.e. never copied)
+	template<typename T>
+	class UpdateRenderDataBatch final : public virtual gr::RenderCommand
+	{
+	public:
+		UpdateRenderDataBatch(std::vector<gr::RenderDataID>&&, std::vector<T>&&);
+
+		static void Execute(void*);
+
+	private:
+		const std::vector<gr::RenderDataID> m_renderDataIDs;
+		std::vector<T> m_data;
+	};
+
+
+	template<typename T>
+	UpdateRenderDataBatch<T>::UpdateRenderDataBatch(
+		std::vector<gr::RenderDataID>&& renderDataIDs, std::vector<T>&& data)
+		: m_renderDataIDs(std::move(renderDataIDs))
+		, m_data(std::move(data))
+	{
+		SEAssert(m_renderDataIDs.size() == m_data.size(), "Received a mismatched number of RenderDataIDs and data");
+	}
+
+
+	template<typename T>
+	void UpdateRenderDataBatch<T>::Execute(void* cmdData)
+	{
+		UpdateRenderDataBatch<T>* cmdPtr = reinterpret_cast<UpdateRenderDataBatch<T>*>(cmdData);
+
+		gr::RenderDataManager& renderData = cmdPtr->GetRenderDataManagerForModification();
+
+		renderData.SetObjectData(
+			std::span<const gr::RenderDataID>(cmdPtr->m_renderDataIDs), std::span<T>(cmdPtr->m_data));
+	}
+
+
+	// ---
+
+
 	template<typename T>
 	class DestroyRenderData final : public virtual gr::RenderCommand
 	{
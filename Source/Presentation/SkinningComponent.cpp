@@ -9,8 +9,137 @@
 #include "SkinningComponent.h"
 #include "TransformComponent.h"
 
+#include "Core/ThreadPool.h"
+
 #include "Core/Util/ImGuiUtils.h"
 
+#include <emmintrin.h> // SSE2
+
+
+namespace
+{
+	// Joints per job, when splitting the matrix palette of a large skeleton across threads
+	constexpr size_t k_numJointsPerJob = 128;
+
+
+	// The rows of an affine matrix, with an implicit [0, 0, 0, 1] 4th row
+	struct AffineRows
+	{
+		__m128 m_row0;
+		__m128 m_row1;
+		__m128 m_row2;
+	};
+
+
+	template<int lane>
+	inline __m128 Splat(__m128 v)
+	{
+		return _mm_shuffle_ps(v, v, _MM_SHUFFLE(lane, lane, lane, lane));
+	}
+
+
+	inline AffineRows LoadAffineRows(glm::vec4 const (&rows)[3]) // Must be 16B aligned
+	{
+		return AffineRows{ _mm_load_ps(&rows[0].x), _mm_load_ps(&rows[1].x), _mm_load_ps(&rows[2].x) };
+	}
+
+
+	inline AffineRows LoadAffineRows(glm::mat4 const& m)
+	{
+		// glm matrices are column-major: Transposing the columns gives the rows. The 4th row is discarded
+		__m128 row0 = _mm_loadu_ps(&m[0].x);
+		__m128 row1 = _mm_loadu_ps(&m[1].x);
+		__m128 row2 = _mm_loadu_ps(&m[2].x);
+		__m128 row3 = _mm_loadu_ps(&m[3].x);
+		_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+		return AffineRows{ row0, row1, row2 };
+	}
+
+
+	inline void StoreAffineRows(AffineRows const& affine, glm::vec4 (&rowsOut)[3]) // Must be 16B aligned
+	{
+		_mm_store_ps(&rowsOut[0].x, affine.m_row0);
+		_mm_store_ps(&rowsOut[1].x, affine.m_row1);
+		_mm_store_ps(&rowsOut[2].x, affine.m_row2);
+	}
+
+
+	inline void StoreMat4(__m128 row0, __m128 row1, __m128 row2, __m128 row3, glm::mat4& out)
+	{
+		_MM_TRANSPOSE4_PS(row0, row1, row2, row3); // Rows -> glm columns
+
+		_mm_storeu_ps(&out[0].x, row0);
+		_mm_storeu_ps(&out[1].x, row1);
+		_mm_storeu_ps(&out[2].x, row2);
+		_mm_storeu_ps(&out[3].x, row3);
+	}
+
+
+	inline void StoreMat4(AffineRows const& affine, glm::mat4& out)
+	{
+		StoreMat4(affine.m_row0, affine.m_row1, affine.m_row2, _mm_set_ps(1.f, 0.f, 0.f, 0.f), out);
+	}
+
+
+	inline AffineRows Multiply(AffineRows const& a, AffineRows const& b) // a * b
+	{
+		const __m128 translationMask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+
+		auto MultiplyRow = [&b, translationMask](__m128 aRow)
+			{
+				// The implicit 4th row of b contributes the translation of a
+				__m128 result = _mm_and_ps(aRow, translationMask);
+				result = _mm_add_ps(result, _mm_mul_ps(Splat<0>(aRow), b.m_row0));
+				result = _mm_add_ps(result, _mm_mul_ps(Splat<1>(aRow), b.m_row1));
+				return _mm_add_ps(result, _mm_mul_ps(Splat<2>(aRow), b.m_row2));
+			};
+
+		return AffineRows{ MultiplyRow(a.m_row0), MultiplyRow(a.m_row1), MultiplyRow(a.m_row2) };
+	}
+
+
+	inline __m128 Cross3(__m128 a, __m128 b) // The w component of the result is 0
+	{
+		const __m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+		const __m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+		const __m128 crossZXY = _mm_sub_ps(_mm_mul_ps(a, bYZX), _mm_mul_ps(aYZX, b));
+		return _mm_shuffle_ps(crossZXY, crossZXY, _MM_SHUFFLE(3, 0, 2, 1));
+	}
+
+
+	inline __m128 Dot3(__m128 a, __m128 b) // a.w or b.w must be 0. The result is splatted to all components
+	{
+		__m128 product = _mm_mul_ps(a, b);
+		product = _mm_add_ps(product, _mm_shuffle_ps(product, product, _MM_SHUFFLE(2, 3, 0, 1)));
+		return _mm_add_ps(product, _mm_shuffle_ps(product, product, _MM_SHUFFLE(1, 0, 3, 2)));
+	}
+
+
+	// Computes transpose(inverse(m)) for an affine m = [A, t]. The rows of transpose(inverse(A)) are the cross
+	// products of the rows of A (i.e. the cofactors) divided by the determinant, and the 4th row is -(A^-1 * t)
+	inline void StoreTransposeInverse(AffineRows const& m, glm::mat4& out)
+	{
+		const __m128 cofactors0 = Cross3(m.m_row1, m.m_row2);
+		const __m128 cofactors1 = Cross3(m.m_row2, m.m_row0);
+		const __m128 cofactors2 = Cross3(m.m_row0, m.m_row1);
+
+		const __m128 invDeterminant = _mm_div_ps(_mm_set1_ps(1.f), Dot3(m.m_row0, cofactors0));
+
+		const __m128 row0 = _mm_mul_ps(cofactors0, invDeterminant);
+		const __m128 row1 = _mm_mul_ps(cofactors1, invDeterminant);
+		const __m128 row2 = _mm_mul_ps(cofactors2, invDeterminant);
+
+		const __m128 invTranslation = _mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(Splat<3>(m.m_row0), row0),
+			_mm_mul_ps(Splat<3>(m.m_row1), row1)),
+			_mm_mul_ps(Splat<3>(m.m_row2), row2));
+
+		StoreMat4(row0, row1, row2, _mm_sub_ps(_mm_set_ps(1.f, 0.f, 0.f, 0.f), invTranslation), out);
+	}
+}
+
+
 
 namespace pr
 {
@@ -62,6 +191,7 @@ namespace pr
 		: m_jointEntities(std::move(jointEntities))
 		, m_parentOfCommonRootEntity(entt::null)
 		, m_parentOfCommonRootTransformID(gr::k_invalidTransformID)
+		, m_parentOfCommonRootTransform(nullptr)
 		, m_jointTransformIDs(std::move(jointTranformIDs))
 		, m_inverseBindMatrices(std::move(inverseBindMatrices))
 		, m_skeletonRootEntity(skeletonRootEntity)
@@ -69,8 +199,14 @@ namespace pr
 		, m_remainingBoundsUpdatePeriodMs(longestAnimationTimeSec * 1000.f)
 		, m_boundsEntities(std::move(boundsEntities))
 	{
-		m_jointTransforms.resize(m_jointEntities.size(), glm::mat4(1.f));
-		m_transposeInvJointTransforms.resize(m_jointEntities.size(), glm::mat4(1.f));
+		m_jointTransformPtrs.reserve(m_jointEntities.size());
+		for (entt::entity jointEntity : m_jointEntities)
+		{
+			pr::TransformComponent const* jointTransformCmpt = em->TryGetComponent<pr::TransformComponent>(jointEntity);
+			m_jointTransformPtrs.emplace_back(jointTransformCmpt ? &jointTransformCmpt->GetTransform() : nullptr);
+		}
+
+		InitializeJointMatrices();
 
 		// Find the first entity with a Transform component in the hierarchy above, that is NOT part of the skeletal
 		// hierarchy:
@@ -140,66 +276,143 @@ namespace pr
 				}
 			}
 		}
+
+		if (m_parentOfCommonRootEntity != entt::null)
+		{
+			m_parentOfCommonRootTransform =
+				&em->GetComponent<pr::TransformComponent>(m_parentOfCommonRootEntity).GetTransform();
+		}
 	}
 
 
-	void SkinningComponent::UpdateSkinMatrices(
-		pr::EntityManager& em, entt::entity owningEntity, SkinningComponent& skinningCmpt, float deltaTime)
+	SkinningComponent SkinningComponent::CreateDetachedSkinningComponent(
+		std::vector<pr::Transform const*>&& jointTransforms,
+		std::vector<glm::mat4>&& inverseBindMatrices,
+		pr::Transform const* parentOfCommonRootTransform)
 	{
-		bool foundDirty = false;
+		SkinningComponent skinningCmpt;
+		skinningCmpt.m_jointTransformPtrs = std::move(jointTransforms);
+		skinningCmpt.m_inverseBindMatrices = std::move(inverseBindMatrices);
+		skinningCmpt.m_parentOfCommonRootTransform = parentOfCommonRootTransform;
 
-		// As an optimization, we'll use the inverse of the common root's parent transform's global matrix to cancel out
-		// any unnecessary matrices in the transformation hierarchy, rather than recompute subranges in the skeletal 
-		// hierarchy: i.e. (ABC)^-1 * (ABCDEF) = DEF
-		pr::Transform const* parentOfRootTransform = nullptr;
-		if (skinningCmpt.m_parentOfCommonRootEntity != entt::null)
+		skinningCmpt.InitializeJointMatrices();
+
+		return skinningCmpt;
+	}
+
+
+	void SkinningComponent::InitializeJointMatrices()
+	{
+		const size_t numJoints = m_jointTransformPtrs.size();
+
+		m_jointTransforms.resize(numJoints, glm::mat4(1.f));
+		m_transposeInvJointTransforms.resize(numJoints, glm::mat4(1.f));
+		m_jointGlobals.resize(numJoints);
+		m_jointHasChanged.resize(numJoints, 0);
+
+		SEAssert(m_inverseBindMatrices.empty() || m_inverseBindMatrices.size() >= numJoints,
+			"Not enough inverse bind matrices for the number of joints");
+
+		m_affineInverseBindMatrices.resize(m_inverseBindMatrices.size());
+		for (size_t i = 0; i < m_inverseBindMatrices.size(); ++i)
 		{
-			pr::TransformComponent const& parentOfRootTransformCmpt = 
-				em.GetComponent<pr::TransformComponent>(skinningCmpt.m_parentOfCommonRootEntity);
+			glm::mat4 const& inverseBindMatrix = m_inverseBindMatrices[i];
+			SEAssert(glm::all(glm::lessThan(
+				glm::abs(glm::transpose(inverseBindMatrix)[3] - glm::vec4(0.f, 0.f, 0.f, 1.f)), glm::vec4(0.0001f))),
+				"Inverse bind matrices are expected to be affine");
 
-			parentOfRootTransform = &parentOfRootTransformCmpt.GetTransform();
+			StoreAffineRows(LoadAffineRows(inverseBindMatrix), m_affineInverseBindMatrices[i].m_rows);
 		}
+	}
+
 
-		// Combine skin Transforms:
-		for (size_t jointIdx = 0; jointIdx < skinningCmpt.m_jointEntities.size(); ++jointIdx)
+	bool SkinningComponent::UpdateSkinMatrices(SkinningComponent& skinningCmpt)
+	{
+		// As an optimization, we'll use the inverse of the common root's parent transform's global matrix to cancel out
+		// any unnecessary matrices in the transformation hierarchy, rather than recompute subranges in the skeletal 
+		// hierarchy: i.e. (ABC)^-1 * (ABCDEF) = DEF. It is shared by every joint, so we compute it once
+		const bool hasParentOfRoot = skinningCmpt.m_parentOfCommonRootTransform != nullptr;
+
+		AffineRows invParentOfRoot{};
+		if (hasParentOfRoot)
 		{
-			const entt::entity curEntity = skinningCmpt.m_jointEntities[jointIdx];
+			invParentOfRoot =
+				LoadAffineRows(glm::inverse(skinningCmpt.m_parentOfCommonRootTransform->GetGlobalMatrix()));
+		}
+
+		const bool hasInverseBindMatrices = !skinningCmpt.m_affineInverseBindMatrices.empty();
+
+		std::atomic<bool> foundDirty = false;
 
-			pr::TransformComponent const* jointTransformCmpt = em.TryGetComponent<pr::TransformComponent>(curEntity);
-			
-			if (jointTransformCmpt) // If null, no update necessary: Joints are initialized to the identity
+		// Combine skin Transforms. Large skeletons are split into ranges of joints, processed in parallel:
+		core::ThreadPool::ParallelForRange(0, skinningCmpt.m_jointTransformPtrs.size(),
+			[&skinningCmpt, &invParentOfRoot, hasParentOfRoot, hasInverseBindMatrices, &foundDirty](
+				size_t jointBegin, size_t jointEnd)
 			{
-				pr::Transform const& jointTransform = jointTransformCmpt->GetTransform();
-				if (jointTransform.HasChanged())
+				// Gather the global matrices of the changed joints:
+				bool rangeHasChanged = false;
+				for (size_t jointIdx = jointBegin; jointIdx < jointEnd; ++jointIdx)
 				{
-					foundDirty = true;
+					pr::Transform const* jointTransform = skinningCmpt.m_jointTransformPtrs[jointIdx];
 
-					// Get the joint transform, isolated using the inverse of the root node's parent global transform:
-					if (parentOfRootTransform)
+					// If null, no update necessary: Joints are initialized to the identity
+					const bool hasChanged = jointTransform && jointTransform->HasChanged();
+					if (hasChanged)
 					{
-						skinningCmpt.m_jointTransforms[jointIdx] = 
-							glm::inverse(parentOfRootTransform->GetGlobalMatrix()) * jointTransform.GetGlobalMatrix();
+						StoreAffineRows(LoadAffineRows(jointTransform->GetGlobalMatrix()),
+							skinningCmpt.m_jointGlobals[jointIdx].m_rows);
 					}
-					else
+					skinningCmpt.m_jointHasChanged[jointIdx] = hasChanged;
+					rangeHasChanged |= hasChanged;
+				}
+
+				if (!rangeHasChanged)
+				{
+					return;
+				}
+
+				for (size_t jointIdx = jointBegin; jointIdx < jointEnd; ++jointIdx)
+				{
+					if (!skinningCmpt.m_jointHasChanged[jointIdx])
 					{
-						skinningCmpt.m_jointTransforms[jointIdx] = jointTransform.GetGlobalMatrix();
+						continue;
+					}
+
+					AffineRows jointMatrix = LoadAffineRows(skinningCmpt.m_jointGlobals[jointIdx].m_rows);
+
+					// Isolate the joint using the inverse of the root node's parent global transform:
+					if (hasParentOfRoot)
+					{
+						jointMatrix = Multiply(invParentOfRoot, jointMatrix);
 					}
 
 					// Inverse bind matrix
-					if (!skinningCmpt.m_inverseBindMatrices.empty())
+					if (hasInverseBindMatrices)
 					{
-						skinningCmpt.m_jointTransforms[jointIdx] =
-							skinningCmpt.m_jointTransforms[jointIdx] * skinningCmpt.m_inverseBindMatrices[jointIdx];
+						jointMatrix = Multiply(
+							jointMatrix, LoadAffineRows(skinningCmpt.m_affineInverseBindMatrices[jointIdx].m_rows));
 					}
 
-					// Transpose inverse:
-					skinningCmpt.m_transposeInvJointTransforms[jointIdx] =
-						glm::transpose(glm::inverse(skinningCmpt.m_jointTransforms[jointIdx]));
+					StoreMat4(jointMatrix, skinningCmpt.m_jointTransforms[jointIdx]);
+					StoreTransposeInverse(jointMatrix, skinningCmpt.m_transposeInvJointTransforms[jointIdx]);
 				}
-			}
-		}
 
-		if (foundDirty)
+				foundDirty.store(true, std::memory_order_relaxed);
+			},
+			k_numJointsPerJob);
+
+		return foundDirty.load(std::memory_order_relaxed);
+	}
+
+
+	void SkinningComponent::FinalizeSkinMatrices(
+		pr::EntityManager& em,
+		entt::entity owningEntity,
+		SkinningComponent& skinningCmpt,
+		bool skinMatricesChanged,
+		float deltaTime)
+	{
+		if (skinMatricesChanged)
 		{
 			em.TryEmplaceComponent<DirtyMarker<pr::SkinningComponent>>(owningEntity);
 		}
@@ -210,16 +423,16 @@ namespace pr
 		{
 			skinningCmpt.m_remainingBoundsUpdatePeriodMs -= deltaTime;
 
-			for (size_t jointIdx = 0; jointIdx < skinningCmpt.m_jointTransforms.size(); ++jointIdx)
+			for (entt::entity boundsEntity : skinningCmpt.m_boundsEntities)
 			{
-				for (entt::entity boundsEntity : skinningCmpt.m_boundsEntities)
-				{
-					pr::BoundsComponent& bounds = em.GetComponent<pr::BoundsComponent>(boundsEntity);
+				pr::BoundsComponent& bounds = em.GetComponent<pr::BoundsComponent>(boundsEntity);
 
+				for (glm::mat4 const& jointTransform : skinningCmpt.m_jointTransforms)
+				{
 					bounds.ExpandBounds(
 						em,
-						(skinningCmpt.m_jointTransforms[jointIdx] * glm::vec4(bounds.GetOriginalMinXYZ(), 1.f)).xyz,
-						(skinningCmpt.m_jointTransforms[jointIdx] * glm::vec4(bounds.GetOriginalMaxXYZ(), 1.f)).xyz,
+						(jointTransform * glm::vec4(bounds.GetOriginalMinXYZ(), 1.f)).xyz,
+						(jointTransform * glm::vec4(bounds.GetOriginalMaxXYZ(), 1.f)).xyz,
 						boundsEntity);
 				}
 			}
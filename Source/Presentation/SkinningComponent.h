@@ -7,6 +7,7 @@
 namespace pr
 {
 	class EntityManager;
+	class Transform;
 
 
 	class SkinningComponent
@@ -23,11 +24,30 @@ namespace pr
 			float longestAnimationTimeSec,
 			std::vector<entt::entity>&& boundsEntities);
 
-		static void UpdateSkinMatrices(pr::EntityManager&, entt::entity owningEntity, SkinningComponent&, float deltaTime);
+		// Creates a SkinningComponent for joint Transforms that are not owned by the registry (e.g. for tests and
+		// benchmarks). Only UpdateSkinMatrices and the joint matrix accessors can be used with it
+		static SkinningComponent CreateDetachedSkinningComponent(
+			std::vector<pr::Transform const*>&& jointTransforms,
+			std::vector<glm::mat4>&& inverseBindMatrices,
+			pr::Transform const* parentOfCommonRootTransform);
+
+		// Rebuilds the matrix palette for any changed joints, returning true if it was modified. Does not access the
+		// registry: Multiple SkinningComponents can be updated in parallel, and large skeletons are split across jobs
+		static bool UpdateSkinMatrices(SkinningComponent&);
+
+		// Registry updates following UpdateSkinMatrices: Marks the skin dirty, and expands the bounds
+		static void FinalizeSkinMatrices(pr::EntityManager&,
+			entt::entity owningEntity,
+			SkinningComponent&,
+			bool skinMatricesChanged,
+			float deltaTime);
 
 		static gr::MeshPrimitive::SkinningRenderData CreateRenderData(
 			pr::EntityManager&, entt::entity skinnedMeshPrimitive, SkinningComponent const&);
 
+		std::vector<glm::mat4> const& GetJointTransforms() const;
+		std::vector<glm::mat4> const& GetTransposeInvJointTransforms() const;
+
 
 	public:
 		static void ShowImGuiWindow(pr::EntityManager&, entt::entity skinnedEntity);
@@ -51,12 +71,30 @@ namespace pr
 			std::vector<entt::entity>&& boundsEntities);
 
 
+	private:
+		// Sizes the per-joint arrays, and converts the inverse bind matrices to affine rows
+		void InitializeJointMatrices();
+
+
+	private:
+		// Affine matrix, stored as the 3 rows (i.e. row-major) of a 4x4 matrix with an implicit [0, 0, 0, 1] 4th row
+		struct alignas(16) AffineMatrix final
+		{
+			glm::vec4 m_rows[3];
+		};
+
+
 	private:
 		std::vector<entt::entity> m_jointEntities;
+
+		// Resolved once at construction (TransformComponents are pointer-stable), matching the order of the
+		// m_jointEntities array. Null if a joint has no TransformComponent
+		std::vector<pr::Transform const*> m_jointTransformPtrs;
 		
 		// Parent of the "common root": The first entity with a TransformComponent NOT part of the skeletal hierarchy
 		entt::entity m_parentOfCommonRootEntity; 
 		gr::TransformID m_parentOfCommonRootTransformID;
+		pr::Transform const* m_parentOfCommonRootTransform;
 
 		// Debug: All TransformIDs that might influence a MeshPrimitive: Maps MeshPrimitive joint index to a TransformID
 		std::vector<gr::TransformID> m_jointTransformIDs;
@@ -65,9 +103,14 @@ namespace pr
 		std::vector<glm::mat4> m_jointTransforms; 
 		std::vector<glm::mat4> m_transposeInvJointTransforms;
 
+		// Scratch: Global matrices of the joints, gathered contiguously. Only valid for joints flagged as changed
+		std::vector<AffineMatrix> m_jointGlobals;
+		std::vector<uint8_t> m_jointHasChanged;
+
 		// Optional: Matrices used to bring coordinates being skinned into the same space as each joint.
 		// Matches the order of the m_jointTransformIDs array, with >= the number of joints (if not empty)
 		std::vector<glm::mat4> m_inverseBindMatrices; 
+		std::vector<AffineMatrix> m_affineInverseBindMatrices; // Matches m_inverseBindMatrices
 
 		// Optional: Provides a pivot point for skinned geometry
 		entt::entity m_skeletonRootEntity;
@@ -81,4 +124,16 @@ namespace pr
 		// We use this to optimize our initial Bounds expansions
 		std::vector<entt::entity> m_boundsEntities;
 	};
+
+
+	inline std::vector<glm::mat4> const& SkinningComponent::GetJointTransforms() const
+	{
+		return m_jointTransforms;
+	}
+
+
+	inline std::vector<glm::mat4> const& SkinningComponent::GetTransposeInvJointTransforms() const
+	{
+		return m_transposeInvJointTransforms;
+	}
 }
\ No newline at end of file
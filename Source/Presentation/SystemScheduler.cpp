@@ -0,0 +1,182 @@
+// © 2025 Adam Badke. All rights reserved.
+#include "SystemScheduler.h"
+
+#include "Core/PerfLogger.h"
+#include "Core/ProfilingMarkers.h"
+
+#include "Core/Host/PerformanceTimer.h"
+
+
+namespace
+{
+	constexpr char const* k_systemsPerfLoggerName = "Entity systems";
+
+
+	bool Intersects(std::vector<entt::id_type> const& a, std::vector<entt::id_type> const& b) // Sorted inputs
+	{
+		auto aItr = a.begin();
+		auto bItr = b.begin();
+		while (aItr != a.end() && bItr != b.end())
+		{
+			if (*aItr < *bItr)
+			{
+				++aItr;
+			}
+			else if (*bItr < *aItr)
+			{
+				++bItr;
+			}
+			else
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+namespace pr
+{
+	thread_local RegistryMutex const* RegistryMutex::s_delegatedMutex = nullptr;
+	thread_local uint32_t RegistryMutex::s_delegatedHelpDepth = 0;
+
+
+	// -----------------------------------------------------------------------------------------------------------------
+
+
+	SystemScheduler::SystemBuilder SystemScheduler::AddSystem(char const* name, SystemFunction&& systemFunction)
+	{
+		SEAssert(name && systemFunction, "Systems require a name and a function");
+
+		const size_t systemIdx = m_systems.size();
+
+		System& newSystem = m_systems.emplace_back();
+		newSystem.m_name = name;
+		newSystem.m_function = std::move(systemFunction);
+
+		m_graphIsDirty = true;
+
+		return SystemBuilder(*this, systemIdx);
+	}
+
+
+	bool SystemScheduler::Conflicts(System const& a, System const& b)
+	{
+		return Intersects(a.m_writes, b.m_writes) ||
+			Intersects(a.m_writes, b.m_reads) ||
+			Intersects(a.m_reads, b.m_writes);
+	}
+
+
+	void SystemScheduler::BuildGraph()
+	{
+		for (System& system : m_systems)
+		{
+			system.m_dependents.clear();
+			system.m_numDependencies = 0;
+		}
+
+		// Conflicting systems execute in the order they were added
+		for (size_t laterIdx = 1; laterIdx < m_systems.size(); ++laterIdx)
+		{
+			for (size_t earlierIdx = 0; earlierIdx < laterIdx; ++earlierIdx)
+			{
+				if (Conflicts(m_systems[earlierIdx], m_systems[laterIdx]))
+				{
+					m_systems[earlierIdx].m_dependents.emplace_back(laterIdx);
+					m_systems[laterIdx].m_numDependencies++;
+				}
+			}
+		}
+
+		m_remainingDependencies = std::make_unique<std::atomic<uint32_t>[]>(m_systems.size());
+
+		m_graphIsDirty = false;
+	}
+
+
+	void SystemScheduler::Execute(
+		entt::basic_registry<entt::entity>& registry, RegistryMutex& registryMutex, double stepTimeMs)
+	{
+		SEBeginCPUEvent("SystemScheduler::Execute");
+
+		host::PerformanceTimer timer;
+		timer.Start();
+
+		if (m_graphIsDirty)
+		{
+			BuildGraph();
+		}
+
+		for (size_t systemIdx = 0; systemIdx < m_systems.size(); ++systemIdx)
+		{
+			for (AssureStorageFn assureStorage : m_systems[systemIdx].m_assureStorageFns)
+			{
+				assureStorage(registry);
+			}
+			m_remainingDependencies[systemIdx].store(m_systems[systemIdx].m_numDependencies, std::memory_order_relaxed);
+		}
+
+		core::JobCounter systemsCounter;
+		for (size_t systemIdx = 0; systemIdx < m_systems.size(); ++systemIdx)
+		{
+			if (m_systems[systemIdx].m_numDependencies == 0)
+			{
+				Dispatch(systemIdx, systemsCounter, registryMutex, stepTimeMs);
+			}
+		}
+
+		// Dependent systems are enqueued against the counter before the system they depend on completes, so it only
+		// reaches 0 once every system has executed
+		{
+			// We hold the lock on behalf of the systems: Any job we execute while waiting must not acquire it
+			RegistryMutex::ScopedDelegation delegation(registryMutex);
+
+			core::ThreadPool::WaitForCounter(systemsCounter);
+		}
+
+		const double totalTimeMs = timer.StopMs();
+
+		core::PerfLogger* perfLogger = core::PerfLogger::Get();
+		perfLogger->NotifyPeriod(totalTimeMs, k_systemsPerfLoggerName);
+		for (System const& system : m_systems)
+		{
+			perfLogger->NotifyPeriod(system.m_lastTimeMs, system.m_name.c_str(), k_systemsPerfLoggerName);
+		}
+
+		SEEndCPUEvent(); // "SystemScheduler::Execute"
+	}
+
+
+	void SystemScheduler::Dispatch(
+		size_t systemIdx, core::JobCounter& systemsCounter, RegistryMutex const& registryMutex, double stepTimeMs)
+	{
+		core::ThreadPool::EnqueueJob([this, systemIdx, &systemsCounter, &registryMutex, stepTimeMs]()
+			{
+				System& system = m_systems[systemIdx];
+				{
+					RegistryMutex::ScopedDelegation delegation(registryMutex);
+
+					SEBeginCPUEvent(system.m_name.c_str());
+
+					host::PerformanceTimer timer;
+					timer.Start();
+
+					system.m_function(stepTimeMs);
+
+					system.m_lastTimeMs = timer.StopMs();
+
+					SEEndCPUEvent(); // system.m_name
+				}
+
+				for (size_t dependentIdx : system.m_dependents)
+				{
+					if (m_remainingDependencies[dependentIdx].fetch_sub(1, std::memory_order_acq_rel) == 1)
+					{
+						Dispatch(dependentIdx, systemsCounter, registryMutex, stepTimeMs);
+					}
+				}
+			},
+			systemsCounter);
+	}
+}
\ No newline at end of file
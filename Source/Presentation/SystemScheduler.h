@@ -0,0 +1,273 @@
+// © 2025 Adam Badke. All rights reserved.
+#pragma once
+#include "Core/ThreadPool.h"
+
+
+namespace pr
+{
+	// Recursive mutex guarding the entity registry. The thread holding the lock can delegate it to work it dispatches
+	// to other threads (e.g. the systems executed by the SystemScheduler): Delegated threads skip locking entirely.
+	// Delegation is only safe if the delegated work does not conflict, and the lock is held until it has completed.
+	// Delegation is scoped to the job it was granted in: Jobs the thread executes while waiting within it (i.e. via
+	// ThreadPool::WaitForCounter) do not inherit it, and must not lock the registry: The lock owner is waiting on them
+	class RegistryMutex final
+	{
+	public:
+		// Grants the current thread the access held by the lock owner, for the lifetime of the ScopedDelegation
+		class ScopedDelegation final
+		{
+		public:
+			explicit ScopedDelegation(RegistryMutex const&);
+			~ScopedDelegation();
+
+		private:
+			RegistryMutex const* m_prevDelegatedMutex;
+			uint32_t m_prevDelegatedHelpDepth;
+
+		private: // No copying allowed
+			ScopedDelegation(ScopedDelegation const&) = delete;
+			ScopedDelegation& operator=(ScopedDelegation const&) = delete;
+		};
+
+
+	public:
+		RegistryMutex() = default;
+		~RegistryMutex() = default;
+
+		void lock();
+		bool try_lock();
+		void unlock();
+
+
+	private:
+		bool IsDelegated() const;
+
+
+	private:
+		std::recursive_mutex m_mutex;
+
+		static thread_local RegistryMutex const* s_delegatedMutex;
+		static thread_local uint32_t s_delegatedHelpDepth; // ThreadPool help depth the delegation was granted at
+
+
+	private: // No copying allowed
+		RegistryMutex(RegistryMutex const&) = delete;
+		RegistryMutex(RegistryMutex&&) noexcept = delete;
+		RegistryMutex& operator=(RegistryMutex const&) = delete;
+		RegistryMutex& operator=(RegistryMutex&&) noexcept = delete;
+	};
+
+
+	inline bool RegistryMutex::IsDelegated() const
+	{
+		return s_delegatedMutex == this && s_delegatedHelpDepth == core::ThreadPool::GetHelpDepth();
+	}
+
+
+	inline void RegistryMutex::lock()
+	{
+		if (!IsDelegated())
+		{
+			SEAssert(s_delegatedMutex != this,
+				"A job executed while waiting within a delegated scope is locking the registry. The lock owner is "
+				"waiting on this thread, so this would deadlock (or race, if this thread owns the lock)");
+
+			m_mutex.lock();
+		}
+	}
+
+
+	inline bool RegistryMutex::try_lock()
+	{
+		if (IsDelegated())
+		{
+			return true;
+		}
+
+		SEAssert(s_delegatedMutex != this,
+			"A job executed while waiting within a delegated scope is locking the registry. The lock owner is "
+			"waiting on this thread, so this would deadlock (or race, if this thread owns the lock)");
+
+		return m_mutex.try_lock();
+	}
+
+
+	inline void RegistryMutex::unlock()
+	{
+		if (!IsDelegated())
+		{
+			m_mutex.unlock();
+		}
+	}
+
+
+	inline RegistryMutex::ScopedDelegation::ScopedDelegation(RegistryMutex const& registryMutex)
+		: m_prevDelegatedMutex(s_delegatedMutex)
+		, m_prevDelegatedHelpDepth(s_delegatedHelpDepth)
+	{
+		s_delegatedMutex = &registryMutex;
+		s_delegatedHelpDepth = core::ThreadPool::GetHelpDepth();
+	}
+
+
+	inline RegistryMutex::ScopedDelegation::~ScopedDelegation()
+	{
+		s_delegatedMutex = m_prevDelegatedMutex;
+		s_delegatedHelpDepth = m_prevDelegatedHelpDepth;
+	}
+
+
+	// -----------------------------------------------------------------------------------------------------------------
+
+
+	// Executes the EntityManager systems on the ThreadPool. Each system declares the component types it reads and
+	// writes, and a system depends on every earlier-added system it conflicts with (i.e. either writes a type the other
+	// accesses). Systems with no conflicts run in parallel; conflicting systems run in the order they were added.
+	// Every type a system accesses (including marker types it emplaces/erases, and types touched by registry signals it
+	// triggers) must be declared: Undeclared accesses are data races
+	class SystemScheduler final
+	{
+	public:
+		using SystemFunction = std::function<void(double stepTimeMs)>;
+
+		class SystemBuilder final
+		{
+		public:
+			template<typename... Ts>
+			SystemBuilder& Reads();
+
+			template<typename... Ts>
+			SystemBuilder& Writes();
+
+		private:
+			friend class SystemScheduler;
+			SystemBuilder(SystemScheduler&, size_t systemIdx);
+
+			SystemScheduler& m_scheduler;
+			size_t m_systemIdx;
+		};
+
+
+	public:
+		SystemScheduler() = default;
+		~SystemScheduler() = default;
+
+
+	public:
+		SystemBuilder AddSystem(char const* name, SystemFunction&&);
+
+		// The calling thread must hold the registry lock: It is delegated to the systems for their execution
+		void Execute(entt::basic_registry<entt::entity>&, RegistryMutex&, double stepTimeMs);
+
+		// Executes fn(idx) for each index in [0, count) in parallel, from within a system. The calling system's
+		// registry access is delegated to each chunk
+		template<typename IndexFunctionType>
+		static void ParallelFor(RegistryMutex const&, size_t count, IndexFunctionType&& indexFunction);
+
+
+	private:
+		using AssureStorageFn = void(*)(entt::basic_registry<entt::entity>&);
+
+		struct System
+		{
+			std::string m_name;
+			SystemFunction m_function;
+
+			std::vector<entt::id_type> m_reads; // Sorted
+			std::vector<entt::id_type> m_writes; // Sorted
+
+			std::vector<AssureStorageFn> m_assureStorageFns;
+
+			std::vector<size_t> m_dependents;
+			uint32_t m_numDependencies = 0;
+
+			double m_lastTimeMs = 0.0;
+		};
+
+		template<typename T>
+		void AddAccess(size_t systemIdx, bool isWrite);
+
+		void BuildGraph();
+
+		void Dispatch(size_t systemIdx, core::JobCounter&, RegistryMutex const&, double stepTimeMs);
+
+		static bool Conflicts(System const&, System const&);
+
+
+	private:
+		std::vector<System> m_systems;
+		std::unique_ptr<std::atomic<uint32_t>[]> m_remainingDependencies; // Per system, reset before each Execute
+
+		bool m_graphIsDirty = true;
+
+
+	private: // No copying allowed
+		SystemScheduler(SystemScheduler const&) = delete;
+		SystemScheduler(SystemScheduler&&) noexcept = delete;
+		SystemScheduler& operator=(SystemScheduler const&) = delete;
+		SystemScheduler& operator=(SystemScheduler&&) noexcept = delete;
+	};
+
+
+	inline SystemScheduler::SystemBuilder::SystemBuilder(SystemScheduler& scheduler, size_t systemIdx)
+		: m_scheduler(scheduler)
+		, m_systemIdx(systemIdx)
+	{
+	}
+
+
+	template<typename... Ts>
+	SystemScheduler::SystemBuilder& SystemScheduler::SystemBuilder::Reads()
+	{
+		(m_scheduler.AddAccess<Ts>(m_systemIdx, false), ...);
+		return *this;
+	}
+
+
+	template<typename... Ts>
+	SystemScheduler::SystemBuilder& SystemScheduler::SystemBuilder::Writes()
+	{
+		(m_scheduler.AddAccess<Ts>(m_systemIdx, true), ...);
+		return *this;
+	}
+
+
+	template<typename T>
+	void SystemScheduler::AddAccess(size_t systemIdx, bool isWrite)
+	{
+		SEAssert(systemIdx < m_systems.size(), "Invalid system index");
+		System& system = m_systems[systemIdx];
+
+		const entt::id_type typeID = entt::type_id<T>().hash();
+
+		std::vector<entt::id_type>& accesses = isWrite ? system.m_writes : system.m_reads;
+		auto accessItr = std::lower_bound(accesses.begin(), accesses.end(), typeID);
+		if (accessItr == accesses.end() || *accessItr != typeID)
+		{
+			accesses.insert(accessItr, typeID);
+
+			// Storage is created lazily by the registry, which is not safe while other systems are executing
+			system.m_assureStorageFns.emplace_back(
+				[](entt::basic_registry<entt::entity>& registry) { registry.storage<T>(); });
+		}
+
+		m_graphIsDirty = true;
+	}
+
+
+	template<typename IndexFunctionType>
+	void SystemScheduler::ParallelFor(
+		RegistryMutex const& registryMutex, size_t count, IndexFunctionType&& indexFunction)
+	{
+		core::ThreadPool::ParallelForRange(0, count,
+			[&registryMutex, &indexFunction](size_t chunkBegin, size_t chunkEnd)
+			{
+				RegistryMutex::ScopedDelegation delegation(registryMutex);
+
+				for (size_t idx = chunkBegin; idx < chunkEnd; ++idx)
+				{
+					indexFunction(idx);
+				}
+			});
+	}
+}
\ No newline at end of file
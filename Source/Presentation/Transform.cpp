@@ -72,6 +72,7 @@ namespace
 namespace pr
 {
 	std::atomic<gr::TransformID> Transform::s_transformIDs = 0;
+	std::atomic<uint64_t> Transform::s_hierarchyVersion = 0;
 
 
 	Transform::Transform(Transform* parent)
@@ -100,6 +101,8 @@ namespace pr
 	{
 		std::unique_lock<std::recursive_mutex> lock(m_transformMutex);
 
+		s_hierarchyVersion.fetch_add(1, std::memory_order_release);
+
 		if (m_parent)
 		{
 			m_parent->UnregisterChild(this);
@@ -276,6 +279,8 @@ namespace pr
 		{
 			m_parent->RegisterChild(this);
 		}
+
+		s_hierarchyVersion.fetch_add(1, std::memory_order_release);
 		
 		MarkDirty();
 	}
@@ -6,6 +6,7 @@
 namespace pr
 {
 	class EntityManager;
+	class TransformHierarchy;
 
 
 	class Transform
@@ -107,6 +108,9 @@ namespace pr
 
 		gr::TransformID GetTransformID() const;
 
+		// Incremented whenever a Transform is created, destroyed, or (re)parented
+		static uint64_t GetHierarchyVersion();
+
 
 	public:
 		void ShowImGuiWindow(pr::EntityManager&, entt::entity owningEntity);
@@ -172,6 +176,12 @@ namespace pr
 
 	private: // Static TransformID functionality:
 		static std::atomic<gr::TransformID> s_transformIDs;
+
+		static std::atomic<uint64_t> s_hierarchyVersion;
+
+
+	private:
+		friend class pr::TransformHierarchy; // Reads/writes our data directly, without locking
 	};
 
 
@@ -194,6 +204,12 @@ namespace pr
 	{
 		return m_transformID;
 	}
+
+
+	inline uint64_t Transform::GetHierarchyVersion()
+	{
+		return s_hierarchyVersion.load(std::memory_order_acquire);
+	}
 }
 
 
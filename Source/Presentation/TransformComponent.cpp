@@ -98,12 +98,12 @@ namespace pr
 
 
 	void TransformComponent::DispatchTransformUpdateThreads(
-		std::vector<std::future<void>>& taskFuturesOut, pr::Transform* rootNode)
+		core::JobCounter& jobCounter, pr::Transform* rootNode)
 	{
 		// DFS walk down our Transform hierarchy, recomputing each Transform in turn. The goal here is to minimize the
 		// (re)computation required when we copy Transforms for the Render thread
 
-		taskFuturesOut.emplace_back(core::ThreadPool::EnqueueJob(
+		core::ThreadPool::EnqueueJob(
 			[rootNode]()
 			{
 				std::stack<pr::Transform*> transforms;
@@ -123,7 +123,8 @@ namespace pr
 						transforms.push(child);
 					}
 				}
-			}));
+			},
+			jobCounter);
 	}
 
 
@@ -146,4 +147,27 @@ namespace pr
 
 		renderData.SetTransformData(cmdPtr->m_transformID, cmdPtr->m_data);
 	}
+
+
+	// ---
+
+
+	UpdateTransformDataBatchRenderCommand::UpdateTransformDataBatchRenderCommand(
+		std::vector<gr::TransformID>&& transformIDs, std::vector<gr::Transform::RenderData>&& data)
+		: m_transformIDs(std::move(transformIDs))
+		, m_data(std::move(data))
+	{
+		SEAssert(m_transformIDs.size() == m_data.size(), "Received a mismatched number of TransformIDs and data");
+	}
+
+
+	void UpdateTransformDataBatchRenderCommand::Execute(void* cmdData)
+	{
+		UpdateTransformDataBatchRenderCommand* cmdPtr =
+			reinterpret_cast<UpdateTransformDataBatchRenderCommand*>(cmdData);
+
+		gr::RenderDataManager& renderData = cmdPtr->GetRenderDataManagerForModification();
+
+		renderData.SetTransformData(cmdPtr->m_transformIDs, cmdPtr->m_data);
+	}
 }
\ No newline at end of file
@@ -7,6 +7,11 @@
 #include "Renderer/RenderObjectIDs.h"
 
 
+namespace core
+{
+	class JobCounter;
+}
+
 namespace pr
 {
 	class EntityManager;
@@ -39,7 +44,7 @@ namespace pr
 
 	public: // Transform systems:
 		static void DispatchTransformUpdateThreads(
-			std::vector<std::future<void>>& taskFuturesOut, pr::Transform* rootNode);
+			core::JobCounter& jobCounter, pr::Transform* rootNode);
 
 
 	private:
@@ -85,4 +90,22 @@ namespace pr
 		const gr::TransformID m_transformID;
 		const gr::Transform::RenderData m_data;
 	};	
+
+
+	// ---
+
+
+	// Updates many Transforms with one command. The IDs and data are packed into parallel arrays
+	class UpdateTransformDataBatchRenderCommand final : public virtual gr::RenderCommand
+	{
+	public:
+		UpdateTransformDataBatchRenderCommand(
+			std::vector<gr::TransformID>&&, std::vector<gr::Transform::RenderData>&&);
+
+		static void Execute(void*);
+
+	private:
+		const std::vector<gr::TransformID> m_transformIDs;
+		const std::vector<gr::Transform::RenderData> m_data;
+	};
 }
\ No newline at end of file
@@ -0,0 +1,173 @@
+// © 2025 Adam Badke. All rights reserved.
+#include "Transform.h"
+#include "TransformHierarchy.h"
+
+#include "Core/Assert.h"
+#include "Core/ProfilingMarkers.h"
+#include "Core/ThreadPool.h"
+
+
+namespace pr
+{
+	TransformHierarchy::TransformHierarchy()
+		: m_hierarchyVersion(std::numeric_limits<uint64_t>::max()) // Stale until we're built
+		, m_recomputeAll(true)
+	{
+	}
+
+
+	bool TransformHierarchy::IsStale() const
+	{
+		return m_hierarchyVersion != pr::Transform::GetHierarchyVersion();
+	}
+
+
+	void TransformHierarchy::Build(std::vector<pr::Transform*> const& rootNodes)
+	{
+		SEBeginCPUEvent("TransformHierarchy::Build");
+
+		// Record the version first: If the hierarchy changes while we're building, we'll be rebuilt next time
+		m_hierarchyVersion = pr::Transform::GetHierarchyVersion();
+
+		m_transforms.clear();
+		m_parentIndices.clear();
+		m_levelOffsets.clear();
+
+		for (pr::Transform* rootNode : rootNodes)
+		{
+			SEAssert(rootNode->m_parent == nullptr, "Transform is not a root node");
+
+			m_transforms.emplace_back(rootNode);
+			m_parentIndices.emplace_back(k_invalidNodeIdx);
+		}
+
+		// Breadth-first traversal: Each level's children are appended as the next level
+		m_levelOffsets.emplace_back(0);
+		size_t levelBegin = 0;
+		while (levelBegin < m_transforms.size())
+		{
+			const size_t levelEnd = m_transforms.size();
+			m_levelOffsets.emplace_back(levelEnd);
+
+			for (size_t nodeIdx = levelBegin; nodeIdx < levelEnd; ++nodeIdx)
+			{
+				for (pr::Transform* child : m_transforms[nodeIdx]->m_children)
+				{
+					m_transforms.emplace_back(child);
+					m_parentIndices.emplace_back(static_cast<uint32_t>(nodeIdx));
+				}
+			}
+			levelBegin = levelEnd;
+		}
+
+		const size_t numNodes = m_transforms.size();
+		SEAssert(numNodes < k_invalidNodeIdx, "Too many Transforms");
+
+		m_localTranslations.resize(numNodes);
+		m_localRotations.resize(numNodes);
+		m_localScales.resize(numNodes);
+		m_localMatrices.resize(numNodes);
+		m_globalMatrices.resize(numNodes);
+		m_isDirty.resize(numNodes);
+
+		m_recomputeAll = true;
+
+		SEEndCPUEvent(); // "TransformHierarchy::Build"
+	}
+
+
+	void TransformHierarchy::Update()
+	{
+		SEBeginCPUEvent("TransformHierarchy::Update");
+
+		SEAssert(!IsStale(), "TransformHierarchy is stale, it must be rebuilt before it is updated");
+
+		const size_t numNodes = m_transforms.size();
+
+		core::ThreadPool::ParallelForRange(0, numNodes,
+			[this](size_t beginIdx, size_t endIdx) { GatherLocals(beginIdx, endIdx); },
+			k_minNodesPerJob);
+
+		// Parents are always in an earlier level, so each level only depends on the previous one
+		for (size_t levelIdx = 0; levelIdx + 1 < m_levelOffsets.size(); ++levelIdx)
+		{
+			core::ThreadPool::ParallelForRange(m_levelOffsets[levelIdx], m_levelOffsets[levelIdx + 1],
+				[this](size_t beginIdx, size_t endIdx) { PropagateGlobals(beginIdx, endIdx); },
+				k_minNodesPerJob);
+		}
+
+		core::ThreadPool::ParallelForRange(0, numNodes,
+			[this](size_t beginIdx, size_t endIdx) { PublishGlobals(beginIdx, endIdx); },
+			k_minNodesPerJob);
+
+		m_recomputeAll = false;
+
+		SEEndCPUEvent(); // "TransformHierarchy::Update"
+	}
+
+
+	void TransformHierarchy::GatherLocals(size_t beginIdx, size_t endIdx)
+	{
+		for (size_t nodeIdx = beginIdx; nodeIdx < endIdx; ++nodeIdx)
+		{
+			pr::Transform const* transform = m_transforms[nodeIdx];
+
+			// Note: A Transform that was recomputed outside of our update (e.g. via a non-const getter) is no longer
+			// dirty, but still flags that it has changed since the last time it was sent to the render thread
+			const bool isDirty = m_recomputeAll || transform->m_isDirty || transform->m_hasChanged;
+			m_isDirty[nodeIdx] = isDirty;
+
+			if (isDirty)
+			{
+				m_localTranslations[nodeIdx] = transform->m_localTranslation;
+				m_localRotations[nodeIdx] = transform->m_localRotationQuat;
+				m_localScales[nodeIdx] = transform->m_localScale;
+			}
+		}
+	}
+
+
+	void TransformHierarchy::PropagateGlobals(size_t beginIdx, size_t endIdx)
+	{
+		for (size_t nodeIdx = beginIdx; nodeIdx < endIdx; ++nodeIdx)
+		{
+			const uint32_t parentIdx = m_parentIndices[nodeIdx];
+
+			if (m_isDirty[nodeIdx])
+			{
+				m_localMatrices[nodeIdx] =
+					glm::translate(glm::mat4(1.f), m_localTranslations[nodeIdx]) *
+					glm::mat4_cast(m_localRotations[nodeIdx]) *
+					glm::scale(glm::mat4(1.f), m_localScales[nodeIdx]);
+			}
+			else if (parentIdx == k_invalidNodeIdx || !m_isDirty[parentIdx])
+			{
+				continue; // Neither we nor our parent changed
+			}
+
+			m_isDirty[nodeIdx] = true; // Propagate to our children in the next level
+
+			m_globalMatrices[nodeIdx] = parentIdx == k_invalidNodeIdx ?
+				m_localMatrices[nodeIdx] : m_globalMatrices[parentIdx] * m_localMatrices[nodeIdx];
+		}
+	}
+
+
+	void TransformHierarchy::PublishGlobals(size_t beginIdx, size_t endIdx)
+	{
+		for (size_t nodeIdx = beginIdx; nodeIdx < endIdx; ++nodeIdx)
+		{
+			if (!m_isDirty[nodeIdx])
+			{
+				continue;
+			}
+
+			pr::Transform* transform = m_transforms[nodeIdx];
+
+			transform->m_localMat = m_localMatrices[nodeIdx];
+			transform->m_globalMat = m_globalMatrices[nodeIdx];
+			transform->m_isDirty = false;
+			transform->m_hasChanged = true;
+		}
+	}
+}
\ No newline at end of file
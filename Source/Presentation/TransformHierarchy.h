@@ -0,0 +1,85 @@
+// © 2025 Adam Badke. All rights reserved.
+#pragma once
+
+
+namespace pr
+{
+	class Transform;
+
+
+	// Flat, data-oriented mirror of the pr::Transform hierarchy. Nodes are stored in contiguous SoA arrays sorted by
+	// hierarchy depth (i.e. level order), with each node's parent guaranteed to be in an earlier level. This allows
+	// global matrices to be propagated one level at a time, with each level distributed across the ThreadPool.
+	//
+	// Note: No per-Transform locks are taken during Update(): Transforms must not be modified while it is executing
+	class TransformHierarchy final
+	{
+	public:
+		TransformHierarchy();
+
+		TransformHierarchy(TransformHierarchy&&) noexcept = default;
+		TransformHierarchy& operator=(TransformHierarchy&&) noexcept = default;
+		~TransformHierarchy() = default;
+
+
+	public:
+		bool IsStale() const; // Has the Transform hierarchy changed since we were last built?
+
+		// Rebuilds the level-ordered node arrays. Transforms must not be (re)parented/created/destroyed during a build
+		void Build(std::vector<pr::Transform*> const& rootNodes);
+
+		// Recompute the local and global matrices of all modified Transforms, and their descendants
+		void Update();
+
+		size_t GetNumNodes() const;
+		size_t GetNumLevels() const;
+
+
+	private:
+		void GatherLocals(size_t beginIdx, size_t endIdx);
+		void PropagateGlobals(size_t beginIdx, size_t endIdx);
+		void PublishGlobals(size_t beginIdx, size_t endIdx);
+
+
+	private:
+		static constexpr uint32_t k_invalidNodeIdx = std::numeric_limits<uint32_t>::max();
+
+		// Nodes/chunks smaller than this are processed on the calling thread
+		static constexpr size_t k_minNodesPerJob = 256;
+
+		// Topology:
+		std::vector<pr::Transform*> m_transforms;
+		std::vector<uint32_t> m_parentIndices; // k_invalidNodeIdx for root nodes
+		std::vector<size_t> m_levelOffsets; // Level i contains nodes [m_levelOffsets[i], m_levelOffsets[i + 1])
+
+		// Local TRS: Mirrored from the Transforms when they're modified
+		std::vector<glm::vec3> m_localTranslations;
+		std::vector<glm::quat> m_localRotations;
+		std::vector<glm::vec3> m_localScales;
+
+		std::vector<glm::mat4> m_localMatrices;
+		std::vector<glm::mat4> m_globalMatrices;
+
+		std::vector<uint8_t> m_isDirty; // Not std::vector<bool>: Elements are written concurrently
+
+		uint64_t m_hierarchyVersion; // pr::Transform::GetHierarchyVersion() when we were last built
+		bool m_recomputeAll; // Set after a build: Our matrices must be fully (re)populated
+
+
+	private: // No copying allowed
+		TransformHierarchy(TransformHierarchy const&) = delete;
+		TransformHierarchy& operator=(TransformHierarchy const&) = delete;
+	};
+
+
+	inline size_t TransformHierarchy::GetNumNodes() const
+	{
+		return m_transforms.size();
+	}
+
+
+	inline size_t TransformHierarchy::GetNumLevels() const
+	{
+		return m_levelOffsets.empty() ? 0 : m_levelOffsets.size() - 1;
+	}
+}
\ No newline at end of file
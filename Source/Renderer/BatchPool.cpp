@@ -21,142 +21,376 @@ namespace
 
 namespace gr
 {
+	BatchHashTable::Table::Table(uint64_t capacity)
+		: m_entries(std::make_unique<Entry[]>(capacity))
+		, m_mask(capacity - 1)
+		, m_shift(util::CheckedCast<uint8_t>(64 - std::countr_zero(capacity)))
+	{
+		SEAssert(std::has_single_bit(capacity), "Capacity must be a power of 2");
+
+		for (uint64_t i = 0; i < capacity; ++i)
+		{
+			m_entries[i].m_hash.store(0, std::memory_order_relaxed);
+			m_entries[i].m_poolIndex.store(k_invalidPoolIndex, std::memory_order_relaxed);
+		}
+	}
+
+
+	uint64_t BatchHashTable::Table::GetFirstEntryIndex(util::HashKey hash) const
+	{
+		// Fibonacci hashing: Spreads similar hash values across the table to keep the probe sequences short
+		return (hash.m_hashKey * 0x9e3779b97f4a7c15ull) >> m_shift;
+	}
+
+
+	BatchHashTable::BatchHashTable()
+		: m_currentTable(nullptr)
+		, m_numEntries(0)
+	{
+		m_tables.emplace_back(std::make_unique<Table>(k_minCapacity));
+		m_currentTable.store(m_tables.back().get(), std::memory_order_release);
+	}
+
+
+	PoolIndex BatchHashTable::Find(util::HashKey hash) const noexcept
+	{
+		Table const* table = m_currentTable.load(std::memory_order_acquire);
+
+		// The table is never full, so we're guaranteed to find either the hash or an empty entry
+		for (uint64_t entryIdx = table->GetFirstEntryIndex(hash); ; entryIdx = (entryIdx + 1) & table->m_mask)
+		{
+			Entry const& entry = table->m_entries[entryIdx];
+
+			// The pool index is published last, so if it's valid the hash is too
+			const PoolIndex poolIndex = entry.m_poolIndex.load(std::memory_order_acquire);
+			if (poolIndex == k_invalidPoolIndex)
+			{
+				return k_invalidPoolIndex;
+			}
+			if (entry.m_hash.load(std::memory_order_relaxed) == hash.m_hashKey)
+			{
+				return poolIndex;
+			}
+		}
+	}
+
+
+	void BatchHashTable::Insert(util::HashKey hash, PoolIndex poolIndex)
+	{
+		SEAssert(poolIndex != k_invalidPoolIndex, "Invalid pool index");
+
+		Table* table = m_tables.back().get();
+
+		const uint64_t capacity = table->m_mask + 1;
+		if ((m_numEntries + 1) * k_maxLoadFactorDivisor > capacity)
+		{
+			// Grow: Populate a new table, and then publish it. Concurrent Find() calls might still be using the
+			// current table, so we retire it rather than destroying it
+			std::unique_ptr<Table> newTable = std::make_unique<Table>(capacity * 2);
+
+			for (uint64_t entryIdx = 0; entryIdx < capacity; ++entryIdx)
+			{
+				Entry const& entry = table->m_entries[entryIdx];
+
+				const PoolIndex existingPoolIndex = entry.m_poolIndex.load(std::memory_order_relaxed);
+				if (existingPoolIndex != k_invalidPoolIndex)
+				{
+					InsertInternal(*newTable, entry.m_hash.load(std::memory_order_relaxed), existingPoolIndex);
+				}
+			}
+
+			m_tables.emplace_back(std::move(newTable));
+			table = m_tables.back().get();
+
+			m_currentTable.store(table, std::memory_order_release);
+		}
+
+		InsertInternal(*table, hash, poolIndex);
+		m_numEntries++;
+	}
+
+
+	void BatchHashTable::InsertInternal(Table& table, util::HashKey hash, PoolIndex poolIndex)
+	{
+		uint64_t entryIdx = table.GetFirstEntryIndex(hash);
+		while (table.m_entries[entryIdx].m_poolIndex.load(std::memory_order_relaxed) != k_invalidPoolIndex)
+		{
+			SEAssert(table.m_entries[entryIdx].m_hash.load(std::memory_order_relaxed) != hash.m_hashKey,
+				"Hash already exists in the table");
+
+			entryIdx = (entryIdx + 1) & table.m_mask;
+		}
+
+		Entry& entry = table.m_entries[entryIdx];
+		entry.m_hash.store(hash.m_hashKey, std::memory_order_relaxed);
+		entry.m_poolIndex.store(poolIndex, std::memory_order_release); // Publish
+	}
+
+
+	void BatchHashTable::Erase(util::HashKey hash)
+	{
+		Table& table = *m_tables.back();
+
+		uint64_t holeIdx = table.GetFirstEntryIndex(hash);
+		while (table.m_entries[holeIdx].m_hash.load(std::memory_order_relaxed) != hash.m_hashKey ||
+			table.m_entries[holeIdx].m_poolIndex.load(std::memory_order_relaxed) == k_invalidPoolIndex)
+		{
+			SEAssert(table.m_entries[holeIdx].m_poolIndex.load(std::memory_order_relaxed) != k_invalidPoolIndex,
+				"Hash not found, this should not be possible");
+
+			holeIdx = (holeIdx + 1) & table.m_mask;
+		}
+
+		// Backward shift deletion: Move any later entries in the probe sequence that could occupy the hole into it, so
+		// lookups never need to probe past an empty entry (i.e. we don't need tombstones)
+		for (uint64_t entryIdx = (holeIdx + 1) & table.m_mask; ; entryIdx = (entryIdx + 1) & table.m_mask)
+		{
+			Entry& entry = table.m_entries[entryIdx];
+
+			const PoolIndex poolIndex = entry.m_poolIndex.load(std::memory_order_relaxed);
+			if (poolIndex == k_invalidPoolIndex)
+			{
+				break;
+			}
+
+			// The entry can move if the hole lies between its first probe index and its current index
+			const uint64_t entryHash = entry.m_hash.load(std::memory_order_relaxed);
+			const uint64_t firstEntryIdx = table.GetFirstEntryIndex(entryHash);
+			if (((entryIdx - firstEntryIdx) & table.m_mask) >= ((entryIdx - holeIdx) & table.m_mask))
+			{
+				table.m_entries[holeIdx].m_hash.store(entryHash, std::memory_order_relaxed);
+				table.m_entries[holeIdx].m_poolIndex.store(poolIndex, std::memory_order_relaxed);
+				holeIdx = entryIdx;
+			}
+		}
+		table.m_entries[holeIdx].m_poolIndex.store(k_invalidPoolIndex, std::memory_order_relaxed);
+
+		SEAssert(m_numEntries > 0, "Entry count is out of sync");
+		m_numEntries--;
+	}
+
+
+	void BatchHashTable::ReleaseRetiredTables()
+	{
+		if (m_tables.size() > 1)
+		{
+			m_tables.erase(m_tables.begin(), std::prev(m_tables.end()));
+		}
+	}
+
+
+	size_t BatchHashTable::GetNumEntries() const
+	{
+		return m_numEntries;
+	}
+
+
+	// ---
+
+
 	BatchPoolPage::BatchPoolPage(uint32_t baseIndex, uint8_t numFramesInFlight) noexcept
 		: m_batches{ gr::Batch() }
+		, m_freeIndexHead(0) // Tag = 0, index = 0
+		, m_deferredDeleteHead(k_invalidLocalIndex)
 		, m_baseIndex(baseIndex)
 		, m_numFramesInFlight(numFramesInFlight)
 	{
-		m_freeIndexes.reserve(k_pageSize);
+		// Link the free index stack: Lower indexes are popped first
 		for (uint32_t i = 0; i < k_pageSize; ++i)
 		{
-			m_freeIndexes.push_back(i);
-			m_batchRefCounts[i].m_value.store(0, std::memory_order_relaxed); // Initialize ref counts to 0
+			m_slotStates[i].m_nextFreeIndex.store(i + 1 < k_pageSize ? i + 1 : k_invalidLocalIndex,
+				std::memory_order_relaxed);
 		}
 	}
 
 
-	void BatchPoolPage::Update(
-		uint64_t currentFrameNum, std::unordered_map<util::HashKey, PoolIndex>& batchHashToIndexMap) noexcept
+	void BatchPoolPage::Update(uint64_t currentFrameNum, BatchHashTable& batchHashToIndexTable) noexcept
 	{
 		SEBeginCPUEvent("BatchPoolPage::Update");
 
-		ProcessDeferredDeletes(currentFrameNum, batchHashToIndexMap);
+		ProcessDeferredDeletes(currentFrameNum, batchHashToIndexTable);
 
 		SEEndCPUEvent(); // "BatchPoolPage::Update"
 	}
 
 
-	void BatchPoolPage::ProcessDeferredDeletes(
-		uint64_t currentFrameNum, std::unordered_map<util::HashKey, PoolIndex>& batchHashToIndexMap)
+	void BatchPoolPage::ProcessDeferredDeletes(uint64_t currentFrameNum, BatchHashTable& batchHashToIndexTable)
 	{
 		SEBeginCPUEvent("BatchPoolPage::ProcessDeferredDeletes");
 
+		// Drain the batches released since the last update:
+		uint32_t releasedIndex = m_deferredDeleteHead.exchange(k_invalidLocalIndex, std::memory_order_acquire);
+		while (releasedIndex != k_invalidLocalIndex)
 		{
-			std::lock_guard<std::mutex> lock(m_pageMutex);
+			m_pendingDeletes.emplace_back(releasedIndex);
+			releasedIndex = m_slotStates[releasedIndex].m_nextDeferredDeleteIndex.load(std::memory_order_relaxed);
+		}
 
-			while (!m_deferredDeletes.empty() &&
-				m_deferredDeletes.front().second + m_numFramesInFlight < currentFrameNum)
-			{
-				const uint32_t localIndex = m_deferredDeletes.front().first;
+		size_t pendingIdx = 0;
+		while (pendingIdx < m_pendingDeletes.size())
+		{
+			const uint32_t localIndex = m_pendingDeletes[pendingIdx];
+			AlignedSlotState& slotState = m_slotStates[localIndex];
 
-				if (m_batchRefCounts[localIndex].m_value.load() == 0 &&
-					m_batches[localIndex].IsValid())
-				{
-					SEAssert(batchHashToIndexMap.contains(m_batches[localIndex].GetDataHash()),
-						"batchHash not found, this should not be possible");
+			// Batches may have been re-referenced (via a hash lookup) since they were released
+			const bool isReferenced = slotState.m_refCount.load(std::memory_order_acquire) != 0;
 
-					// Update the batch hash to index map for the BatchPool:
-					batchHashToIndexMap.erase(m_batches[localIndex].GetDataHash());
+			if (!isReferenced &&
+				slotState.m_releaseFrameNum.load(std::memory_order_relaxed) + m_numFramesInFlight >= currentFrameNum)
+			{
+				++pendingIdx; // The batch might still be in use by in-flight frames: Try again next update
+				continue;
+			}
 
-					// Destroy the batch and return the index to the free pool:
-					m_batches[localIndex].Destroy();
-					m_freeIndexes.push_back(localIndex);
-				}
+			if (!isReferenced)
+			{
+				SEAssert(m_batches[localIndex].IsValid(), "Trying to delete an invalid Batch");
+
+				// Update the batch hash to index table for the BatchPool:
+				batchHashToIndexTable.Erase(m_batches[localIndex].GetDataHash());
 
-				m_deferredDeletes.pop();
+				// Destroy the batch and return the index to the free pool:
+				m_batches[localIndex].Destroy();
+				PushFreeIndex(localIndex);
 			}
+
+			slotState.m_isPendingDelete.store(false, std::memory_order_release);
+
+			m_pendingDeletes[pendingIdx] = m_pendingDeletes.back();
+			m_pendingDeletes.pop_back();
 		}
 
 		SEEndCPUEvent(); // "BatchPoolPage::ProcessDeferredDeletes"
 	}
 
 
-	void BatchPoolPage::Destroy(std::unordered_map<util::HashKey, PoolIndex>& batchHashToIndexMap)
+	void BatchPoolPage::Destroy(BatchHashTable& batchHashToIndexTable)
 	{
-		ProcessDeferredDeletes(std::numeric_limits<uint64_t>::max(), batchHashToIndexMap);
+		ProcessDeferredDeletes(std::numeric_limits<uint64_t>::max(), batchHashToIndexTable);
+
+#if defined(_DEBUG)
+		uint32_t numFreeIndexes = 0;
+		for (uint32_t freeIndex = static_cast<uint32_t>(m_freeIndexHead.load(std::memory_order_acquire));
+			freeIndex != k_invalidLocalIndex;
+			freeIndex = m_slotStates[freeIndex].m_nextFreeIndex.load(std::memory_order_relaxed))
+		{
+			numFreeIndexes++;
+		}
+		SEAssert(numFreeIndexes == k_pageSize, "Free indexes list is missing elements");
 
+		for (auto const& batch : m_batches)
 		{
-			std::lock_guard<std::mutex> lock(m_pageMutex);
+			SEAssert(!batch.IsValid(),
+				"BatchPoolPage is being destroyed, but some batches are still valid. This is unexpected.");
+		}
+		for (auto const& slotState : m_slotStates)
+		{
+			SEAssert(slotState.m_refCount.load(std::memory_order_relaxed) == 0,
+				"BatchPoolPage is being destroyed, but some batches have a non-zero ref count. This is unexpected.");
+		}
+#endif
+	}
 
-			SEAssert(m_freeIndexes.size() == k_pageSize, "Free indexes list is missing elements");
 
-#if defined(_DEBUG)
-			for (auto const& batch : m_batches)
+	bool BatchPoolPage::PopFreeIndex(uint32_t& localIndexOut) noexcept
+	{
+		uint64_t head = m_freeIndexHead.load(std::memory_order_acquire);
+		while (true)
+		{
+			const uint32_t localIndex = static_cast<uint32_t>(head);
+			if (localIndex == k_invalidLocalIndex)
 			{
-				SEAssert(!batch.IsValid(),
-					"BatchPoolPage is being destroyed, but some batches are still valid. This is unexpected.");
+				return false;
 			}
-			for (auto const& refCount : m_batchRefCounts)
+
+			// Incrementing the tag prevents ABA: If the index was popped and pushed back while we were reading its
+			// next index, the tag will have changed and our CAS will fail
+			const uint32_t nextIndex = m_slotStates[localIndex].m_nextFreeIndex.load(std::memory_order_relaxed);
+			const uint64_t newHead = (((head >> 32) + 1) << 32) | nextIndex;
+
+			if (m_freeIndexHead.compare_exchange_weak(
+				head, newHead, std::memory_order_acquire, std::memory_order_acquire))
 			{
-				SEAssert(refCount.m_value.load(std::memory_order_relaxed) == 0,
-					"BatchPoolPage is being destroyed, but some batches have a non-zero ref count. This is unexpected.");
+				localIndexOut = localIndex;
+				return true;
 			}
-#endif
 		}
 	}
 
 
+	void BatchPoolPage::PushFreeIndex(uint32_t localIndex) noexcept
+	{
+		uint64_t head = m_freeIndexHead.load(std::memory_order_relaxed);
+		uint64_t newHead = 0;
+		do
+		{
+			m_slotStates[localIndex].m_nextFreeIndex.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+			newHead = (((head >> 32) + 1) << 32) | localIndex;
+		} while (!m_freeIndexHead.compare_exchange_weak(
+			head, newHead, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+
 	bool BatchPoolPage::AddBatch(gr::Batch&& batch, PoolIndex& outIndex) noexcept
 	{
+		uint32_t index = 0;
+		if (!PopFreeIndex(index))
 		{
-			std::lock_guard<std::mutex> lock(m_pageMutex);
+			return false;
+		}
 
-			if (m_freeIndexes.empty())
-			{
-				return false;
-			}
+		SEAssert(!m_batches[index].IsValid(), "Batch at index %u is already valid. This should not happen", index);
+		SEAssert(m_slotStates[index].m_refCount.load(std::memory_order_relaxed) == 0,
+			"Batch at index %u has a non-zero ref count. This should not happen", index);
 
-			const uint32_t index = m_freeIndexes.back();
-			m_freeIndexes.pop_back();
+		m_batches[index] = std::move(batch);
 
-			SEAssert(!m_batches[index].IsValid(), "Batch at index %u is already valid. This should not happen", index);
-			SEAssert(m_batchRefCounts[index].m_value.load(std::memory_order_relaxed) == 0,
-				"Batch at index %u has a non-zero ref count. This should not happen", index);
+		outIndex = m_baseIndex + index; // Convert to global pool index
 
-			m_batches[index] = std::move(batch);
+		return true;
+	}
 
-			outIndex = m_baseIndex + index; // Convert to global pool index
 
-			return true;
-		}
+	void BatchPoolPage::ReturnUnusedBatch(uint32_t localIndex) noexcept
+	{
+		SEAssert(m_slotStates[localIndex].m_refCount.load(std::memory_order_relaxed) == 0,
+			"Trying to return a Batch that has been referenced");
+
+		m_batches[localIndex].Destroy();
+		PushFreeIndex(localIndex);
 	}
 
 
 	void BatchPoolPage::AddBatchRef(uint32_t localIndex) noexcept
 	{
-#if defined(_DEBUG)
-		std::lock_guard<std::mutex> lock(m_pageMutex);
-
 		SEAssert(m_batches[localIndex].IsValid(), "Trying to add a ref to an invalid Batch");
-#endif
 
-		m_batchRefCounts[localIndex].m_value.fetch_add(1, std::memory_order_relaxed);
+		m_slotStates[localIndex].m_refCount.fetch_add(1, std::memory_order_relaxed);
 	}
 
 
 	void BatchPoolPage::ReleaseBatch(uint32_t localIndex, uint64_t currentFrameNum) noexcept
 	{
-		SEAssert(m_batchRefCounts[localIndex].m_value.load() > 0, "About to underflow the counter");
+		AlignedSlotState& slotState = m_slotStates[localIndex];
+
+		SEAssert(slotState.m_refCount.load() > 0, "About to underflow the counter");
 
 		// We use memory_order_acq_rel here to ensure nothing is reordered
-		if (m_batchRefCounts[localIndex].m_value.fetch_sub(1, std::memory_order_acq_rel) == 1) // Free batches with 0 ref
+		if (slotState.m_refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) // Free batches with 0 ref
 		{
-			{
-				std::lock_guard<std::mutex> lock(m_pageMutex);
+			SEAssert(m_batches[localIndex].IsValid(), "Trying to free an invalid Batch");
 
-				SEAssert(m_batches[localIndex].IsValid(), "Trying to free an invalid Batch");
+			slotState.m_releaseFrameNum.store(currentFrameNum, std::memory_order_relaxed);
 
-				m_deferredDeletes.emplace(std::make_pair(localIndex, currentFrameNum));
+			// Push the batch onto the deferred delete list, if it's not already waiting for deletion
+			if (!slotState.m_isPendingDelete.exchange(true, std::memory_order_acq_rel))
+			{
+				uint32_t head = m_deferredDeleteHead.load(std::memory_order_relaxed);
+				do
+				{
+					slotState.m_nextDeferredDeleteIndex.store(head, std::memory_order_relaxed);
+				} while (!m_deferredDeleteHead.compare_exchange_weak(
+					head, localIndex, std::memory_order_release, std::memory_order_relaxed));
 			}
 		}
 	}
@@ -173,7 +407,8 @@ namespace gr
 
 
 	BatchPool::BatchPool(uint8_t numFramesInFlight)
-		: m_currentFrameNum(0)
+		: m_numPages(0)
+		, m_currentFrameNum(0)
 		, m_numFramesInFlight(numFramesInFlight)
 	{
 		SEAssert(m_numFramesInFlight > 0 && m_numFramesInFlight <= 3, "Unexpected number of frames in flight");
@@ -188,26 +423,27 @@ namespace gr
 
 	void BatchPool::Destroy()
 	{
-		{
-			std::unique_lock<std::shared_mutex> writeLock(m_poolMutex);
+		const uint32_t numPages = m_numPages.load(std::memory_order_acquire);
 
-			LOG("Destroying batch pool (%llu pages)", m_pages.size());
+		LOG("Destroying batch pool (%u pages)", numPages);
 
-			for (auto& page : m_pages)
-			{
-				page->Destroy(m_batchHashToIndexMap);
-			}
-			m_pages.clear();
+		for (uint32_t pageIdx = 0; pageIdx < numPages; ++pageIdx)
+		{
+			m_pages[pageIdx]->Destroy(m_batchHashToIndexTable);
+			m_pages[pageIdx] = nullptr;
+		}
+		m_numPages.store(0, std::memory_order_release);
 
-			SEAssert(m_batchHashToIndexMap.empty(),
-				"BatchPool is being destroyed, but m_batchHashToIndexMap is not empty");
+		m_batchHashToIndexTable.ReleaseRetiredTables();
 
-			gr::BatchHandle::s_batchPool = nullptr;
+		SEAssert(m_batchHashToIndexTable.GetNumEntries() == 0,
+			"BatchPool is being destroyed, but m_batchHashToIndexTable is not empty");
 
-			gr::IBatchBuilder<ComputeBatchBuilder>::s_batchPool = nullptr;
-			gr::IBatchBuilder<RasterBatchBuilder>::s_batchPool = nullptr;
-			gr::IBatchBuilder<RayTraceBatchBuilder>::s_batchPool = nullptr;
-		}
+		gr::BatchHandle::s_batchPool = nullptr;
+
+		gr::IBatchBuilder<ComputeBatchBuilder>::s_batchPool = nullptr;
+		gr::IBatchBuilder<RasterBatchBuilder>::s_batchPool = nullptr;
+		gr::IBatchBuilder<RayTraceBatchBuilder>::s_batchPool = nullptr;
 	}
 
 
@@ -215,18 +451,32 @@ namespace gr
 	{
 		SEBeginCPUEvent("BatchPool::Update");
 
+		m_currentFrameNum = currentFrameNum;
+
+		const uint32_t numPages = m_numPages.load(std::memory_order_acquire);
+		for (uint32_t pageIdx = 0; pageIdx < numPages; ++pageIdx)
 		{
-			std::unique_lock<std::shared_mutex> writeLock(m_poolMutex);
+			m_pages[pageIdx]->Update(m_currentFrameNum, m_batchHashToIndexTable);
+		}
+
+		// No lookups are in flight during the update, so tables retired by growth can be released
+		m_batchHashToIndexTable.ReleaseRetiredTables();
+
+		SEEndCPUEvent(); // "BatchPool::Update"
+	}
 
-			m_currentFrameNum = currentFrameNum;
 
-			for (auto& page : m_pages)
+	bool BatchPool::TryAddBatchToPages(gr::Batch&& batch, PoolIndex& poolIndexOut) noexcept
+	{
+		const uint32_t numPages = m_numPages.load(std::memory_order_acquire);
+		for (uint32_t pageIdx = 0; pageIdx < numPages; ++pageIdx)
+		{
+			if (m_pages[pageIdx]->AddBatch(std::move(batch), poolIndexOut))
 			{
-				page->Update(m_currentFrameNum, m_batchHashToIndexMap);
+				return true;
 			}
 		}
-
-		SEEndCPUEvent(); // "BatchPool::Update"
+		return false;
 	}
 
 
@@ -236,127 +486,88 @@ namespace gr
 
 		const util::HashKey batchHash = batch.GetDataHash();
 
-		auto TryAddBatch = [this, &batchHash, &batch, &renderDataID]() noexcept -> gr::BatchHandle
-			{
-				// Check if the batch already exists in the pool:
-				auto itr = m_batchHashToIndexMap.find(batchHash);
-				if (itr != m_batchHashToIndexMap.end())
-				{
-					// Batch already exists, return the existing handle
-					return gr::BatchHandle(itr->second, renderDataID);
-				}
-
-				for (auto& page : m_pages)
-				{
-					PoolIndex poolIndex;
-					if (page->AddBatch(std::move(batch), poolIndex))
-					{
-						SEAssert(!m_batchHashToIndexMap.contains(batchHash),
-							"Batch hash already added. This should not be possible");
-
-						m_batchHashToIndexMap.emplace(batchHash, poolIndex);
-
-						uint32_t pageIndex, localIndex;
-						PoolIndexToPageLocalIndexes(poolIndex, pageIndex, localIndex);
-
-						return gr::BatchHandle(poolIndex, renderDataID);
-					}
-				}
-
-				return gr::BatchHandle(); // Invalid
-			};
-
-		// Fast path: Add a batch to a page while only holding a read lock on the BatchPool mutex
+		// Fast path: Lock-free lookup of an existing batch
+		PoolIndex poolIndex = m_batchHashToIndexTable.Find(batchHash);
+		if (poolIndex != BatchHashTable::k_invalidPoolIndex)
 		{
-			std::shared_lock<std::shared_mutex> readLock(m_poolMutex);
-
-			gr::BatchHandle existingBatchHandle = TryAddBatch();
-			if (existingBatchHandle.IsValid())
-			{
-				SEEndCPUEvent(); // "BatchPool::AddBatch"
-				return existingBatchHandle;
-			}
+			SEEndCPUEvent(); // "BatchPool::AddBatch"
+			return gr::BatchHandle(poolIndex, renderDataID);
 		}
 
-		PoolIndex poolIndex;
+		// Speculatively move the batch into a free slot before taking the lock, to minimize the time we hold it
+		PoolIndex newPoolIndex = BatchHashTable::k_invalidPoolIndex;
+		const bool addedToExistingPage = TryAddBatchToPages(std::move(batch), newPoolIndex);
+
 		{
-			std::unique_lock<std::shared_mutex> writeLock(m_poolMutex);
+			std::lock_guard<std::mutex> insertLock(m_insertMutex);
 
-			// Retry adding the batch, incase it was added while we were waiting for the lock
-			gr::BatchHandle existingBatchHandle = TryAddBatch();
-			if (existingBatchHandle.IsValid())
+			// Retry the lookup, incase the batch was added while we were waiting for the lock
+			poolIndex = m_batchHashToIndexTable.Find(batchHash);
+			if (poolIndex == BatchHashTable::k_invalidPoolIndex)
 			{
-				SEEndCPUEvent(); // "BatchPool::AddBatch"
-				return existingBatchHandle;
-			}
+				if (!addedToExistingPage &&
+					!TryAddBatchToPages(std::move(batch), newPoolIndex)) // Another thread might have freed a slot
+				{
+					// If we made it this far, no page had free space. Create a new page:
+					const uint32_t numPages = m_numPages.load(std::memory_order_relaxed);
+					SEAssert(numPages < k_maxPages, "BatchPool has reached its maximum number of pages");
 
-			// If we made it this far, no page had free space. Create a new page:
-			// Note: It's possible a batch was released since we last held the lock, but we'll just accept that and
-			// create a new page anyway
-			const uint32_t newPageBaseIndex = util::CheckedCast<uint32_t>(m_pages.size()) * BatchPoolPage::k_pageSize;
+					m_pages[numPages] = std::make_unique<BatchPoolPage>(
+						numPages * util::CheckedCast<uint32_t>(BatchPoolPage::k_pageSize), m_numFramesInFlight);
 
-			m_pages.emplace_back(std::make_unique<BatchPoolPage>(newPageBaseIndex, m_numFramesInFlight));
+					const bool didAdd = m_pages[numPages]->AddBatch(std::move(batch), newPoolIndex);
+					SEAssert(didAdd, "Failed to add batch to new page. This should not be possible");
 
-			LOG("BatchPool: Increased page count to %llu", m_pages.size());
-			
-			const bool didAdd = m_pages.back()->AddBatch(std::move(batch), poolIndex);
-			SEAssert(didAdd, "Failed to add batch to new page. This should not be possible");
+					m_numPages.store(numPages + 1, std::memory_order_release); // Publish the new page
 
-			SEAssert(!m_batchHashToIndexMap.contains(batchHash),
-				"Batch hash already added. This should not be possible");
+					LOG("BatchPool: Increased page count to %u", numPages + 1);
+				}
 
-			m_batchHashToIndexMap.emplace(batchHash, poolIndex);
+				m_batchHashToIndexTable.Insert(batchHash, newPoolIndex);
+				poolIndex = newPoolIndex;
+			}
+			else if (addedToExistingPage)
+			{
+				// Another thread added the same batch first: Discard our copy
+				uint32_t localIndex = 0;
+				GetPage(newPoolIndex, localIndex).ReturnUnusedBatch(localIndex);
+			}
 		}
 
 		SEEndCPUEvent(); // "BatchPool::AddBatch"
-		return gr::BatchHandle(poolIndex, renderDataID); // Avoid deadlock: BatchHandle ctor calls AddBatchRef
+		return gr::BatchHandle(poolIndex, renderDataID);
 	}
 
 
-	void BatchPool::AddBatchRef(PoolIndex poolIndex) noexcept
+	BatchPoolPage& BatchPool::GetPage(PoolIndex poolIndex, uint32_t& localIndexOut) noexcept
 	{
-		uint32_t pageIndex, localIndex;
-		PoolIndexToPageLocalIndexes(poolIndex, pageIndex, localIndex);
+		uint32_t pageIndex = 0;
+		PoolIndexToPageLocalIndexes(poolIndex, pageIndex, localIndexOut);
 
-		SEAssert(pageIndex < m_pages.size(), "Batch index out of bounds");
-		SEAssert(localIndex < BatchPoolPage::k_pageSize, "Local batch index out of bounds");
+		SEAssert(pageIndex < m_numPages.load(std::memory_order_relaxed), "Batch index out of bounds");
+		SEAssert(localIndexOut < BatchPoolPage::k_pageSize, "Local batch index out of bounds");
 
-		{
-			std::shared_lock<std::shared_mutex> readLock(m_poolMutex);
-
-			m_pages[pageIndex]->AddBatchRef(localIndex);
-		}
+		return *m_pages[pageIndex];
 	}
 
 
-	void BatchPool::ReleaseBatch(PoolIndex poolIndex) noexcept
+	void BatchPool::AddBatchRef(PoolIndex poolIndex) noexcept
 	{
-		uint32_t pageIndex, localIndex;
-		PoolIndexToPageLocalIndexes(poolIndex, pageIndex, localIndex);
+		uint32_t localIndex = 0;
+		GetPage(poolIndex, localIndex).AddBatchRef(localIndex);
+	}
 
-		SEAssert(pageIndex < m_pages.size(), "Batch index out of bounds");
-		SEAssert(localIndex < BatchPoolPage::k_pageSize, "Local batch index out of bounds");
 
-		{
-			std::shared_lock<std::shared_mutex> readLock(m_poolMutex);
-	
-			m_pages[pageIndex]->ReleaseBatch(localIndex, m_currentFrameNum);
-		}
+	void BatchPool::ReleaseBatch(PoolIndex poolIndex) noexcept
+	{
+		uint32_t localIndex = 0;
+		GetPage(poolIndex, localIndex).ReleaseBatch(localIndex, m_currentFrameNum);
 	}
 
 
 	gr::Batch const* BatchPool::GetBatch(PoolIndex poolIndex) noexcept
 	{
-		uint32_t pageIndex, localIndex;
-		PoolIndexToPageLocalIndexes(poolIndex, pageIndex, localIndex);
-
-		SEAssert(pageIndex < m_pages.size(), "Batch index out of bounds");
-		SEAssert(localIndex < BatchPoolPage::k_pageSize, "Local batch index out of bounds");
-
-		{
-			std::shared_lock<std::shared_mutex> readLock(m_poolMutex);
-				
-			return &m_pages[pageIndex]->GetBatch(localIndex);
-		}
+		uint32_t localIndex = 0;
+		return &GetPage(poolIndex, localIndex).GetBatch(localIndex);
 	}
 }
\ No newline at end of file
@@ -21,6 +21,76 @@ namespace gr
 	using PoolIndex = uint32_t;
 
 
+	// Batch data hash -> PoolIndex lookup table, using open addressing with linear probing. Find() is lock-free, and can
+	// be called concurrently with a single inserter (i.e. Insert() calls must be externally synchronized) as populated
+	// entries are never modified while the pool is in use. Growing the table publishes a new, larger copy: Old copies
+	// are retired, and remain valid for any in-flight Find() calls until the next (exclusive) ReleaseRetiredTables()
+	class BatchHashTable
+	{
+	public:
+		static constexpr PoolIndex k_invalidPoolIndex = std::numeric_limits<PoolIndex>::max();
+
+
+	public:
+		BatchHashTable();
+		~BatchHashTable() = default;
+
+
+	public:
+		PoolIndex Find(util::HashKey) const noexcept; // Returns k_invalidPoolIndex if the hash is not found
+
+		void Insert(util::HashKey, PoolIndex); // Externally synchronized. The hash must not already exist
+
+		// Exclusive: Must not be called concurrently with any other function
+		void Erase(util::HashKey);
+		void ReleaseRetiredTables();
+
+		size_t GetNumEntries() const;
+
+
+	private:
+		static constexpr uint64_t k_minCapacity = 2048;
+		static constexpr uint64_t k_maxLoadFactorDivisor = 2; // Grow when the table is more than 1/2 full
+
+		struct Entry
+		{
+			std::atomic<uint64_t> m_hash;
+			std::atomic<PoolIndex> m_poolIndex; // Written last: k_invalidPoolIndex if the entry is empty
+		};
+
+		struct Table
+		{
+			Table(uint64_t capacity);
+
+			uint64_t GetFirstEntryIndex(util::HashKey) const;
+
+			std::unique_ptr<Entry[]> m_entries;
+			uint64_t m_mask; // Capacity - 1
+			uint8_t m_shift; // 64 - log2(capacity)
+		};
+
+		void InsertInternal(Table&, util::HashKey, PoolIndex);
+
+
+	private:
+		std::vector<std::unique_ptr<Table>> m_tables; // The back element is the current table, others are retired
+		std::atomic<Table const*> m_currentTable;
+		size_t m_numEntries;
+
+
+	private:
+		BatchHashTable(BatchHashTable const&) = delete;
+		BatchHashTable(BatchHashTable&&) noexcept = delete;
+		BatchHashTable& operator=(BatchHashTable const&) = delete;
+		BatchHashTable& operator=(BatchHashTable&&) noexcept = delete;
+	};
+
+
+	// ---
+
+
+	// Fixed-size page of pooled batches. Slots are claimed and returned via a lock-free (tagged) free index stack, and
+	// slots whose ref count reaches 0 are pushed onto a lock-free deferred delete list that is drained once per frame
 	class BatchPoolPage
 	{
 	public:
@@ -33,52 +103,71 @@ namespace gr
 		BatchPoolPage(BatchPoolPage&&) noexcept = default;
 		BatchPoolPage& operator=(BatchPoolPage&&) noexcept = default;
 
-		void Update(uint64_t currentFrameNum, std::unordered_map<util::HashKey, PoolIndex>&) noexcept;
+		// Exclusive: Must not be called concurrently with any other function
+		void Update(uint64_t currentFrameNum, BatchHashTable&) noexcept;
 
-		void Destroy(std::unordered_map<util::HashKey, PoolIndex>& batchHashToIndexMap);
+		void Destroy(BatchHashTable&);
 
 
 	public:
 		bool AddBatch(gr::Batch&& batch, PoolIndex& outIndex) noexcept;
 
-		void AddBatchRef(uint32_t pageIndex) noexcept; // Increments the ref count for the batch at pageIndex
+		// Destroys a batch that was added but never referenced, and returns its index to the free list
+		void ReturnUnusedBatch(uint32_t localIndex) noexcept;
 
-		// Decrements the ref count, removes the batch if it reaches 0
-		void ReleaseBatch(uint32_t pageIndex, uint64_t currentFrameNum) noexcept; 
+		void AddBatchRef(uint32_t localIndex) noexcept; // Increments the ref count for the batch at localIndex
+
+		// Decrements the ref count, schedules the batch for deletion if it reaches 0
+		void ReleaseBatch(uint32_t localIndex, uint64_t currentFrameNum) noexcept; 
 		
-		gr::Batch const& GetBatch(uint32_t pageIndex) noexcept;		
+		gr::Batch const& GetBatch(uint32_t localIndex) noexcept;		
 
 
 	private:
-		void ProcessDeferredDeletes(
-			uint64_t currentFrameNum, std::unordered_map<util::HashKey, PoolIndex>& batchHashToIndexMap);
+		void ProcessDeferredDeletes(uint64_t currentFrameNum, BatchHashTable&);
+
+		bool PopFreeIndex(uint32_t& localIndexOut) noexcept;
+		void PushFreeIndex(uint32_t localIndex) noexcept;
 
 
 	private:
+		static constexpr uint32_t k_invalidLocalIndex = std::numeric_limits<uint32_t>::max();
+
+		// Per-batch state. Each slot's atomics live in their own cache line, to avoid false sharing between batches
 		static constexpr size_t k_cacheAlignment = 64;
-		struct alignas(k_cacheAlignment) AlignedRefCount
+		struct alignas(k_cacheAlignment) AlignedSlotState
 		{
-			AlignedRefCount() noexcept : m_value(0), _padding{0} {}
-
-			std::atomic<uint32_t> m_value;
-			uint8_t _padding[k_cacheAlignment - sizeof(std::atomic<uint32_t>)]; // Guarantee correct alignment
+			AlignedSlotState() noexcept
+				: m_refCount(0)
+				, m_nextFreeIndex(k_invalidLocalIndex)
+				, m_nextDeferredDeleteIndex(k_invalidLocalIndex)
+				, m_isPendingDelete(false)
+				, m_releaseFrameNum(0)
+			{}
+
+			std::atomic<uint32_t> m_refCount;
+			std::atomic<uint32_t> m_nextFreeIndex; // Free index stack link
+			std::atomic<uint32_t> m_nextDeferredDeleteIndex; // Deferred delete list link
+			std::atomic<bool> m_isPendingDelete; // Is the slot in the deferred delete list/m_pendingDeletes?
+			std::atomic<uint64_t> m_releaseFrameNum; // Frame the ref count most recently reached 0
 		};
-		SEStaticAssert(sizeof(AlignedRefCount) == k_cacheAlignment, "Struct is not cache aligned");
+		SEStaticAssert(sizeof(AlignedSlotState) == k_cacheAlignment, "Struct is not cache aligned");
 
 		std::array<gr::Batch, k_pageSize> m_batches;
-		std::array<AlignedRefCount, k_pageSize> m_batchRefCounts; // Reference counts for each batch
+		std::array<AlignedSlotState, k_pageSize> m_slotStates;
+
+		// Free index stack head: [upper 32 bits: ABA tag, lower 32 bits: local index of the top element]
+		alignas(k_cacheAlignment) std::atomic<uint64_t> m_freeIndexHead;
 
-		std::vector<uint32_t> m_freeIndexes; // Free indices in the page: Relative to m_batches, not the overall pool
+		// Deferred delete list head: Released batches are pushed by any thread, and the list is drained in Update()
+		alignas(k_cacheAlignment) std::atomic<uint32_t> m_deferredDeleteHead;
 
-		// Batches that have had a ref count of 0 at some point
-		std::queue<std::pair<uint32_t, uint64_t>> m_deferredDeletes;
+		std::vector<uint32_t> m_pendingDeletes; // Drained, but not yet deleted. Only accessed by Update()
 
 		uint32_t m_baseIndex; // Base index of this page in the overall pool
 
 		const uint8_t m_numFramesInFlight;
 
-		std::mutex m_pageMutex;
-
 
 	private:
 		BatchPoolPage(BatchPoolPage const&) = delete;
@@ -89,6 +178,9 @@ namespace gr
 	// ---
 
 
+	// Thread-safe pool of de-duplicated batches. Batch lookups, ref counting, and batch access are lock-free; only
+	// inserting a new batch hash (and allocating new pages) is serialized.
+	// Note: Update() and Destroy() must not be called concurrently with any other BatchPool functions
 	class BatchPool
 	{
 	public:
@@ -125,11 +217,21 @@ namespace gr
 		
 
 	private:
-		std::vector<std::unique_ptr<BatchPoolPage>> m_pages;
+		bool TryAddBatchToPages(gr::Batch&& batch, PoolIndex& poolIndexOut) noexcept;
+
+		BatchPoolPage& GetPage(PoolIndex, uint32_t& localIndexOut) noexcept;
+
+
+	private:
+		static constexpr size_t k_maxPages = 4096;
+
+		// Pages are never moved or freed while the pool is in use, so they can be accessed without locking
+		std::array<std::unique_ptr<BatchPoolPage>, k_maxPages> m_pages;
+		std::atomic<uint32_t> m_numPages;
 
-		std::unordered_map<util::HashKey, PoolIndex> m_batchHashToIndexMap;
+		BatchHashTable m_batchHashToIndexTable;
 
-		std::shared_mutex m_poolMutex;
+		std::mutex m_insertMutex; // Serializes hash table insertions and page allocations
 
 		uint64_t m_currentFrameNum;
 		uint8_t m_numFramesInFlight;
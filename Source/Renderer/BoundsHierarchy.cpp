@@ -0,0 +1,460 @@
+// © 2025 Adam Badke. All rights reserved.
+#include "BoundsHierarchy.h"
+
+#include "Core/Assert.h"
+
+#include "Core/Util/CastUtils.h"
+
+
+namespace
+{
+	float GetSurfaceArea(glm::vec3 const& minXYZ, glm::vec3 const& maxXYZ)
+	{
+		const glm::vec3 extents = maxXYZ - minXYZ;
+		return 2.f * (extents.x * extents.y + extents.y * extents.z + extents.z * extents.x);
+	}
+
+
+	bool ContainsBounds(
+		glm::vec3 const& outerMinXYZ, glm::vec3 const& outerMaxXYZ,
+		glm::vec3 const& innerMinXYZ, glm::vec3 const& innerMaxXYZ)
+	{
+		return glm::all(glm::lessThanEqual(outerMinXYZ, innerMinXYZ)) &&
+			glm::all(glm::lessThanEqual(innerMaxXYZ, outerMaxXYZ));
+	}
+}
+
+namespace gr
+{
+	BoundsHierarchy::BoundsHierarchy()
+		: m_rootIdx(k_invalidNodeIdx)
+		, m_freeListIdx(k_invalidNodeIdx)
+	{
+	}
+
+
+	void BoundsHierarchy::Add(gr::RenderDataID renderDataID, glm::vec3 const& worldMinXYZ, glm::vec3 const& worldMaxXYZ)
+	{
+		SEAssert(!Contains(renderDataID), "RenderDataID has already been added");
+
+		const uint32_t leafIdx = AllocateNode();
+
+		Node& leaf = m_nodes[leafIdx];
+		leaf.m_renderDataID = renderDataID;
+		leaf.m_height = 0;
+		SetFatBounds(leaf, worldMinXYZ, worldMaxXYZ);
+
+		InsertLeaf(leafIdx);
+
+		m_renderDataIDToLeafIdx.emplace(renderDataID, leafIdx);
+	}
+
+
+	void BoundsHierarchy::Update(
+		gr::RenderDataID renderDataID, glm::vec3 const& worldMinXYZ, glm::vec3 const& worldMaxXYZ)
+	{
+		auto leafItr = m_renderDataIDToLeafIdx.find(renderDataID);
+		SEAssert(leafItr != m_renderDataIDToLeafIdx.end(), "RenderDataID has not been added");
+
+		const uint32_t leafIdx = leafItr->second;
+		Node& leaf = m_nodes[leafIdx];
+
+		// If the new bounds still fit within the fattened bounds, our ancestors are still valid
+		if (ContainsBounds(leaf.m_minXYZ, leaf.m_maxXYZ, worldMinXYZ, worldMaxXYZ))
+		{
+			leaf.m_leafMinXYZ = worldMinXYZ;
+			leaf.m_leafMaxXYZ = worldMaxXYZ;
+			return;
+		}
+
+		RemoveLeaf(leafIdx);
+		SetFatBounds(m_nodes[leafIdx], worldMinXYZ, worldMaxXYZ);
+		InsertLeaf(leafIdx);
+	}
+
+
+	void BoundsHierarchy::Remove(gr::RenderDataID renderDataID)
+	{
+		auto leafItr = m_renderDataIDToLeafIdx.find(renderDataID);
+		SEAssert(leafItr != m_renderDataIDToLeafIdx.end(), "RenderDataID has not been added");
+
+		const uint32_t leafIdx = leafItr->second;
+		m_renderDataIDToLeafIdx.erase(leafItr);
+
+		RemoveLeaf(leafIdx);
+		FreeNode(leafIdx);
+	}
+
+
+	void BoundsHierarchy::Clear()
+	{
+		m_nodes.clear();
+		m_rootIdx = k_invalidNodeIdx;
+		m_freeListIdx = k_invalidNodeIdx;
+		m_renderDataIDToLeafIdx.clear();
+	}
+
+
+	size_t BoundsHierarchy::GetNumNodes() const
+	{
+		// Each internal node has exactly 2 children
+		return m_renderDataIDToLeafIdx.empty() ? 0 : (m_renderDataIDToLeafIdx.size() * 2) - 1;
+	}
+
+
+	void BoundsHierarchy::QueryAABB(
+		glm::vec3 const& minXYZ, glm::vec3 const& maxXYZ, std::vector<gr::RenderDataID>& overlappingIDsOut) const
+	{
+		Query(
+			[&minXYZ, &maxXYZ](glm::vec3 const& nodeMinXYZ, glm::vec3 const& nodeMaxXYZ)
+			{
+				if (glm::any(glm::lessThan(nodeMaxXYZ, minXYZ)) || glm::any(glm::lessThan(maxXYZ, nodeMinXYZ)))
+				{
+					return TestResult::Outside;
+				}
+				return ContainsBounds(minXYZ, maxXYZ, nodeMinXYZ, nodeMaxXYZ) ?
+					TestResult::Inside : TestResult::Intersecting;
+			},
+			[&overlappingIDsOut](gr::RenderDataID renderDataID, glm::vec3 const&, glm::vec3 const&, bool)
+			{
+				overlappingIDsOut.emplace_back(renderDataID);
+			});
+	}
+
+
+	void BoundsHierarchy::QueryPoint(glm::vec3 const& point, std::vector<gr::RenderDataID>& containingIDsOut) const
+	{
+		Query(
+			[&point](glm::vec3 const& nodeMinXYZ, glm::vec3 const& nodeMaxXYZ)
+			{
+				return ContainsBounds(nodeMinXYZ, nodeMaxXYZ, point, point) ?
+					TestResult::Intersecting : TestResult::Outside;
+			},
+			[&containingIDsOut](gr::RenderDataID renderDataID, glm::vec3 const&, glm::vec3 const&, bool)
+			{
+				containingIDsOut.emplace_back(renderDataID);
+			});
+	}
+
+
+	void BoundsHierarchy::QueryRay(
+		glm::vec3 const& origin,
+		glm::vec3 const& direction,
+		float maxDistance,
+		std::vector<RayHit>& hitsOut) const
+	{
+		SEAssert(glm::dot(direction, direction) > 0.f, "Invalid ray direction");
+
+		const size_t firstHitIdx = hitsOut.size();
+
+		// Slab test: Division by 0 produces +/- infinity, which correctly rejects/accepts rays parallel to a slab
+		const glm::vec3 invDirection = 1.f / direction;
+
+		auto GetEntryDistance = [&origin, &invDirection, maxDistance](
+			glm::vec3 const& minXYZ, glm::vec3 const& maxXYZ, float& entryDistanceOut) -> bool
+			{
+				const glm::vec3 t0 = (minXYZ - origin) * invDirection;
+				const glm::vec3 t1 = (maxXYZ - origin) * invDirection;
+
+				const glm::vec3 tNear = glm::min(t0, t1);
+				const glm::vec3 tFar = glm::max(t0, t1);
+
+				entryDistanceOut = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.f));
+				const float exitDistance = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDistance));
+
+				return entryDistanceOut <= exitDistance;
+			};
+
+		Query(
+			[&GetEntryDistance](glm::vec3 const& nodeMinXYZ, glm::vec3 const& nodeMaxXYZ)
+			{
+				float entryDistance;
+				return GetEntryDistance(nodeMinXYZ, nodeMaxXYZ, entryDistance) ?
+					TestResult::Intersecting : TestResult::Outside;
+			},
+			[&GetEntryDistance, &hitsOut](
+				gr::RenderDataID renderDataID, glm::vec3 const& leafMinXYZ, glm::vec3 const& leafMaxXYZ, bool)
+			{
+				float entryDistance;
+				GetEntryDistance(leafMinXYZ, leafMaxXYZ, entryDistance);
+
+				hitsOut.emplace_back(RayHit{
+					.m_renderDataID = renderDataID,
+					.m_distance = entryDistance,
+					});
+			});
+
+		std::sort(hitsOut.begin() + firstHitIdx, hitsOut.end(),
+			[](RayHit const& a, RayHit const& b)
+			{
+				return a.m_distance < b.m_distance;
+			});
+	}
+
+
+	uint32_t BoundsHierarchy::AllocateNode()
+	{
+		uint32_t nodeIdx = m_freeListIdx;
+		if (nodeIdx != k_invalidNodeIdx)
+		{
+			m_freeListIdx = m_nodes[nodeIdx].m_parentIdx;
+		}
+		else
+		{
+			nodeIdx = util::CheckedCast<uint32_t>(m_nodes.size());
+			m_nodes.emplace_back();
+		}
+
+		Node& node = m_nodes[nodeIdx];
+		node.m_parentIdx = k_invalidNodeIdx;
+		node.m_child0Idx = k_invalidNodeIdx;
+		node.m_child1Idx = k_invalidNodeIdx;
+		node.m_height = 0;
+		node.m_renderDataID = gr::k_invalidRenderDataID;
+
+		return nodeIdx;
+	}
+
+
+	void BoundsHierarchy::FreeNode(uint32_t nodeIdx)
+	{
+		Node& node = m_nodes[nodeIdx];
+		node.m_parentIdx = m_freeListIdx;
+		node.m_height = -1;
+
+		m_freeListIdx = nodeIdx;
+	}
+
+
+	void BoundsHierarchy::InsertLeaf(uint32_t leafIdx)
+	{
+		if (m_rootIdx == k_invalidNodeIdx)
+		{
+			m_rootIdx = leafIdx;
+			m_nodes[leafIdx].m_parentIdx = k_invalidNodeIdx;
+			return;
+		}
+
+		const glm::vec3 leafMinXYZ = m_nodes[leafIdx].m_minXYZ;
+		const glm::vec3 leafMaxXYZ = m_nodes[leafIdx].m_maxXYZ;
+
+		// Find the best sibling: Descend towards the child that minimizes the increase in surface area
+		uint32_t siblingIdx = m_rootIdx;
+		while (!m_nodes[siblingIdx].IsLeaf())
+		{
+			Node const& node = m_nodes[siblingIdx];
+
+			const float area = GetSurfaceArea(node.m_minXYZ, node.m_maxXYZ);
+			const float combinedArea = GetSurfaceArea(
+				glm::min(node.m_minXYZ, leafMinXYZ), glm::max(node.m_maxXYZ, leafMaxXYZ));
+
+			// Cost of making a new parent for this node and the new leaf
+			const float cost = 2.f * combinedArea;
+
+			// Minimum cost of pushing the leaf further down the tree
+			const float inheritanceCost = 2.f * (combinedArea - area);
+
+			auto GetDescentCost = [this, &leafMinXYZ, &leafMaxXYZ, inheritanceCost](uint32_t childIdx)
+				{
+					Node const& child = m_nodes[childIdx];
+					const float childCombinedArea = GetSurfaceArea(
+						glm::min(child.m_minXYZ, leafMinXYZ), glm::max(child.m_maxXYZ, leafMaxXYZ));
+
+					return child.IsLeaf() ? (childCombinedArea + inheritanceCost) :
+						(childCombinedArea - GetSurfaceArea(child.m_minXYZ, child.m_maxXYZ) + inheritanceCost);
+				};
+			const float cost0 = GetDescentCost(node.m_child0Idx);
+			const float cost1 = GetDescentCost(node.m_child1Idx);
+
+			if (cost < cost0 && cost < cost1)
+			{
+				break;
+			}
+			siblingIdx = cost0 < cost1 ? node.m_child0Idx : node.m_child1Idx;
+		}
+
+		// Create a new parent for the sibling and the new leaf:
+		const uint32_t oldParentIdx = m_nodes[siblingIdx].m_parentIdx;
+		const uint32_t newParentIdx = AllocateNode(); // Note: Invalidates any Node references
+
+		Node& newParent = m_nodes[newParentIdx];
+		newParent.m_parentIdx = oldParentIdx;
+		newParent.m_child0Idx = siblingIdx;
+		newParent.m_child1Idx = leafIdx;
+		newParent.m_height = m_nodes[siblingIdx].m_height + 1;
+		newParent.m_minXYZ = glm::min(m_nodes[siblingIdx].m_minXYZ, leafMinXYZ);
+		newParent.m_maxXYZ = glm::max(m_nodes[siblingIdx].m_maxXYZ, leafMaxXYZ);
+
+		if (oldParentIdx != k_invalidNodeIdx)
+		{
+			ReplaceChild(oldParentIdx, siblingIdx, newParentIdx);
+		}
+		else
+		{
+			m_rootIdx = newParentIdx;
+		}
+
+		m_nodes[siblingIdx].m_parentIdx = newParentIdx;
+		m_nodes[leafIdx].m_parentIdx = newParentIdx;
+
+		RefitAncestors(newParentIdx);
+	}
+
+
+	void BoundsHierarchy::RemoveLeaf(uint32_t leafIdx)
+	{
+		if (leafIdx == m_rootIdx)
+		{
+			m_rootIdx = k_invalidNodeIdx;
+			return;
+		}
+
+		const uint32_t parentIdx = m_nodes[leafIdx].m_parentIdx;
+		const uint32_t grandParentIdx = m_nodes[parentIdx].m_parentIdx;
+		const uint32_t siblingIdx = m_nodes[parentIdx].m_child0Idx == leafIdx ?
+			m_nodes[parentIdx].m_child1Idx : m_nodes[parentIdx].m_child0Idx;
+
+		// Replace our parent with our sibling:
+		m_nodes[siblingIdx].m_parentIdx = grandParentIdx;
+		if (grandParentIdx != k_invalidNodeIdx)
+		{
+			ReplaceChild(grandParentIdx, parentIdx, siblingIdx);
+		}
+		else
+		{
+			m_rootIdx = siblingIdx;
+		}
+		FreeNode(parentIdx);
+
+		m_nodes[leafIdx].m_parentIdx = k_invalidNodeIdx;
+
+		RefitAncestors(grandParentIdx);
+	}
+
+
+	void BoundsHierarchy::RefitAncestors(uint32_t nodeIdx)
+	{
+		while (nodeIdx != k_invalidNodeIdx)
+		{
+			nodeIdx = Balance(nodeIdx);
+
+			Node& node = m_nodes[nodeIdx];
+			node.m_height = 1 + std::max(m_nodes[node.m_child0Idx].m_height, m_nodes[node.m_child1Idx].m_height);
+			CombineChildBounds(node);
+
+			nodeIdx = node.m_parentIdx;
+		}
+	}
+
+
+	uint32_t BoundsHierarchy::Balance(uint32_t nodeIdxA)
+	{
+		// Rotates the taller child of A up into A's position, if A's subtrees differ in height by more than 1:
+		//       A              C
+		//      / \            / \
+		//     B   C    ->    A   F/G
+		//        / \        / \
+		//       F   G      B   G/F
+		Node& nodeA = m_nodes[nodeIdxA];
+		if (nodeA.IsLeaf() || nodeA.m_height < 2)
+		{
+			return nodeIdxA;
+		}
+
+		const int32_t balance = m_nodes[nodeA.m_child1Idx].m_height - m_nodes[nodeA.m_child0Idx].m_height;
+		if (balance >= -1 && balance <= 1)
+		{
+			return nodeIdxA;
+		}
+
+		// C is the taller child, B is the shorter child
+		const bool rotateChild1Up = balance > 1;
+		const uint32_t nodeIdxB = rotateChild1Up ? nodeA.m_child0Idx : nodeA.m_child1Idx;
+		const uint32_t nodeIdxC = rotateChild1Up ? nodeA.m_child1Idx : nodeA.m_child0Idx;
+
+		Node& nodeB = m_nodes[nodeIdxB];
+		Node& nodeC = m_nodes[nodeIdxC];
+
+		const uint32_t nodeIdxF = nodeC.m_child0Idx;
+		const uint32_t nodeIdxG = nodeC.m_child1Idx;
+
+		Node& nodeF = m_nodes[nodeIdxF];
+		Node& nodeG = m_nodes[nodeIdxG];
+
+		// Swap A and C:
+		nodeC.m_child0Idx = nodeIdxA;
+		nodeC.m_parentIdx = nodeA.m_parentIdx;
+		nodeA.m_parentIdx = nodeIdxC;
+
+		if (nodeC.m_parentIdx != k_invalidNodeIdx)
+		{
+			ReplaceChild(nodeC.m_parentIdx, nodeIdxA, nodeIdxC);
+		}
+		else
+		{
+			m_rootIdx = nodeIdxC;
+		}
+
+		// The taller of F/G stays under C, the shorter replaces C under A:
+		const bool keepF = nodeF.m_height > nodeG.m_height;
+		const uint32_t keptIdx = keepF ? nodeIdxF : nodeIdxG;
+		const uint32_t movedIdx = keepF ? nodeIdxG : nodeIdxF;
+
+		nodeC.m_child1Idx = keptIdx;
+		if (rotateChild1Up)
+		{
+			nodeA.m_child1Idx = movedIdx;
+		}
+		else
+		{
+			nodeA.m_child0Idx = movedIdx;
+		}
+		m_nodes[movedIdx].m_parentIdx = nodeIdxA;
+
+		nodeA.m_height = 1 + std::max(nodeB.m_height, m_nodes[movedIdx].m_height);
+		CombineChildBounds(nodeA);
+
+		nodeC.m_height = 1 + std::max(nodeA.m_height, m_nodes[keptIdx].m_height);
+		CombineChildBounds(nodeC);
+
+		return nodeIdxC;
+	}
+
+
+	void BoundsHierarchy::ReplaceChild(uint32_t parentIdx, uint32_t oldChildIdx, uint32_t newChildIdx)
+	{
+		Node& parent = m_nodes[parentIdx];
+		if (parent.m_child0Idx == oldChildIdx)
+		{
+			parent.m_child0Idx = newChildIdx;
+		}
+		else
+		{
+			SEAssert(parent.m_child1Idx == oldChildIdx, "Node is not a child of the parent");
+			parent.m_child1Idx = newChildIdx;
+		}
+	}
+
+
+	void BoundsHierarchy::SetFatBounds(Node& leaf, glm::vec3 const& worldMinXYZ, glm::vec3 const& worldMaxXYZ)
+	{
+		SEAssert(glm::all(glm::lessThanEqual(worldMinXYZ, worldMaxXYZ)), "Invalid bounds");
+
+		const glm::vec3 margin = glm::max((worldMaxXYZ - worldMinXYZ) * k_fatBoundsScale, glm::vec3(k_minFatBoundsMargin));
+
+		leaf.m_leafMinXYZ = worldMinXYZ;
+		leaf.m_leafMaxXYZ = worldMaxXYZ;
+		leaf.m_minXYZ = worldMinXYZ - margin;
+		leaf.m_maxXYZ = worldMaxXYZ + margin;
+	}
+
+
+	void BoundsHierarchy::CombineChildBounds(Node& node)
+	{
+		Node const& child0 = m_nodes[node.m_child0Idx];
+		Node const& child1 = m_nodes[node.m_child1Idx];
+
+		node.m_minXYZ = glm::min(child0.m_minXYZ, child1.m_minXYZ);
+		node.m_maxXYZ = glm::max(child0.m_maxXYZ, child1.m_maxXYZ);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,188 @@
+// © 2025 Adam Badke. All rights reserved.
+#pragma once
+#include "RenderObjectIDs.h"
+
+
+namespace gr
+{
+	// Dynamic bounding volume hierarchy (BVH) of world-space AABBs, keyed by RenderDataID. Leaves store a fattened copy
+	// of their bounds, so small movements only update the leaf; bounds that escape their fattened AABB are removed
+	// and reinserted. Insertion uses a surface area heuristic, and the tree is kept balanced via AVL-style rotations.
+	//
+	// Note: Queries are const and can be executed concurrently, but not while the hierarchy is being modified
+	class BoundsHierarchy final
+	{
+	public:
+		enum class TestResult : uint8_t
+		{
+			Outside,		// No overlap: Skip the node and all of its children
+			Intersecting,	// Partial overlap: Test the node's children
+			Inside,			// Full containment: All of the node's children are contained, no further tests required
+		};
+
+		struct RayHit
+		{
+			gr::RenderDataID m_renderDataID;
+			float m_distance; // Distance along the ray to the bounds entry point. 0 if the origin is inside the bounds
+		};
+
+
+	public:
+		BoundsHierarchy();
+
+		BoundsHierarchy(BoundsHierarchy&&) noexcept = default;
+		BoundsHierarchy& operator=(BoundsHierarchy&&) noexcept = default;
+		~BoundsHierarchy() = default;
+
+
+	public:
+		void Add(gr::RenderDataID, glm::vec3 const& worldMinXYZ, glm::vec3 const& worldMaxXYZ);
+		void Update(gr::RenderDataID, glm::vec3 const& worldMinXYZ, glm::vec3 const& worldMaxXYZ);
+		void Remove(gr::RenderDataID);
+		void Clear();
+
+		bool Contains(gr::RenderDataID) const;
+
+		size_t GetNumLeaves() const;
+		size_t GetNumNodes() const;
+		uint32_t GetHeight() const;
+
+
+	public: // Queries:
+		// Generic traversal. testFn(glm::vec3 const& min, glm::vec3 const& max) -> TestResult is called for each
+		// visited node. Leaf bounds are tested using their exact (i.e. non-fattened) bounds. leafFn is called for each
+		// leaf that is not Outside, as leafFn(RenderDataID, glm::vec3 const& min, glm::vec3 const& max, bool isInside)
+		template<typename TestFn, typename LeafFn>
+		void Query(TestFn&& testFn, LeafFn&& leafFn) const;
+
+		void QueryAABB( // Bounds overlapping the AABB (e.g. a light volume)
+			glm::vec3 const& minXYZ, glm::vec3 const& maxXYZ, std::vector<gr::RenderDataID>& overlappingIDsOut) const;
+
+		void QueryPoint(glm::vec3 const& point, std::vector<gr::RenderDataID>& containingIDsOut) const;
+
+		// Bounds intersected by the ray within maxDistance, sorted nearest to furthest
+		void QueryRay(
+			glm::vec3 const& origin,
+			glm::vec3 const& direction,
+			float maxDistance,
+			std::vector<RayHit>& hitsOut) const;
+
+
+	private:
+		static constexpr uint32_t k_invalidNodeIdx = std::numeric_limits<uint32_t>::max();
+
+		// Leaf bounds are expanded by this fraction of their extents (plus a minimum margin) on each side
+		static constexpr float k_fatBoundsScale = 0.1f;
+		static constexpr float k_minFatBoundsMargin = 0.01f;
+
+		struct Node
+		{
+			glm::vec3 m_minXYZ; // Fattened, for leaf nodes
+			glm::vec3 m_maxXYZ;
+
+			glm::vec3 m_leafMinXYZ; // Exact bounds: Leaf nodes only
+			glm::vec3 m_leafMaxXYZ;
+
+			uint32_t m_parentIdx; // Next free node, when on the free list
+			uint32_t m_child0Idx;
+			uint32_t m_child1Idx;
+			int32_t m_height; // Leaf = 0, free = -1
+
+			gr::RenderDataID m_renderDataID;
+
+			bool IsLeaf() const { return m_child0Idx == k_invalidNodeIdx; }
+		};
+
+		uint32_t AllocateNode();
+		void FreeNode(uint32_t nodeIdx);
+
+		void InsertLeaf(uint32_t leafIdx);
+		void RemoveLeaf(uint32_t leafIdx);
+		void RefitAncestors(uint32_t nodeIdx); // Rebalances, and recomputes bounds/heights from nodeIdx to the root
+		uint32_t Balance(uint32_t nodeIdx); // Returns the index of the node now at nodeIdx's position
+
+		void ReplaceChild(uint32_t parentIdx, uint32_t oldChildIdx, uint32_t newChildIdx);
+		void SetFatBounds(Node&, glm::vec3 const& worldMinXYZ, glm::vec3 const& worldMaxXYZ);
+		void CombineChildBounds(Node&);
+
+
+	private:
+		std::vector<Node> m_nodes;
+		uint32_t m_rootIdx;
+		uint32_t m_freeListIdx;
+
+		std::unordered_map<gr::RenderDataID, uint32_t> m_renderDataIDToLeafIdx;
+
+
+	private: // No copying allowed
+		BoundsHierarchy(BoundsHierarchy const&) = delete;
+		BoundsHierarchy& operator=(BoundsHierarchy const&) = delete;
+	};
+
+
+	inline bool BoundsHierarchy::Contains(gr::RenderDataID renderDataID) const
+	{
+		return m_renderDataIDToLeafIdx.contains(renderDataID);
+	}
+
+
+	inline size_t BoundsHierarchy::GetNumLeaves() const
+	{
+		return m_renderDataIDToLeafIdx.size();
+	}
+
+
+	inline uint32_t BoundsHierarchy::GetHeight() const
+	{
+		return m_rootIdx == k_invalidNodeIdx ? 0 : static_cast<uint32_t>(m_nodes[m_rootIdx].m_height) + 1;
+	}
+
+
+	template<typename TestFn, typename LeafFn>
+	void BoundsHierarchy::Query(TestFn&& testFn, LeafFn&& leafFn) const
+	{
+		if (m_rootIdx == k_invalidNodeIdx)
+		{
+			return;
+		}
+
+		struct StackEntry
+		{
+			uint32_t m_nodeIdx;
+			bool m_isInside; // An ancestor was fully contained: No need to test this node
+		};
+		std::vector<StackEntry> stack;
+		stack.reserve(64);
+		stack.emplace_back(StackEntry{ m_rootIdx, false });
+
+		while (!stack.empty())
+		{
+			const StackEntry entry = stack.back();
+			stack.pop_back();
+
+			Node const& node = m_nodes[entry.m_nodeIdx];
+
+			bool isInside = entry.m_isInside;
+			if (!isInside)
+			{
+				const TestResult result = node.IsLeaf() ?
+					testFn(node.m_leafMinXYZ, node.m_leafMaxXYZ) : testFn(node.m_minXYZ, node.m_maxXYZ);
+				if (result == TestResult::Outside)
+				{
+					continue;
+				}
+				isInside = (result == TestResult::Inside);
+			}
+
+			if (node.IsLeaf())
+			{
+				leafFn(node.m_renderDataID, node.m_leafMinXYZ, node.m_leafMaxXYZ, isInside);
+			}
+			else
+			{
+				stack.emplace_back(StackEntry{ node.m_child0Idx, isInside });
+				stack.emplace_back(StackEntry{ node.m_child1Idx, isInside });
+			}
+		}
+	}
+}
\ No newline at end of file
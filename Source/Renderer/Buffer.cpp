@@ -77,6 +77,7 @@ namespace re
 		, m_cbvResourceHandle(INVALID_RESOURCE_IDX)
 		, m_srvResourceHandle(INVALID_RESOURCE_IDX)
 		, m_isCurrentlyMapped(false)
+		, m_singleFrameStagingData(nullptr)
 	{
 		SEAssert(m_dataByteSize % bufferParams.m_arraySize == 0,
 			"Size must be non-zero, and equally divisible by the number of elements");
@@ -132,7 +133,7 @@ namespace re
 
 		Register(newBuffer, numBytes, typeIDHash);
 
-		s_bufferAllocator->Stage(newBuffer->GetUniqueID(), data);
+		s_bufferAllocator->Stage(*newBuffer, data);
 
 		newBuffer->m_platObj->m_isCommitted = true;
 
@@ -148,7 +149,7 @@ namespace re
 			"Invalid type detected. Can only set data of the original type");
 		SEAssert(m_bufferParams.m_stagingPool == StagingPool::Permanent, "Cannot set data of an immutable buffer");
 
-		s_bufferAllocator->Stage(GetUniqueID(), data);
+		s_bufferAllocator->Stage(*this, data);
 		
 		m_platObj->m_isCommitted = true;
 
@@ -166,7 +167,7 @@ namespace re
 			re::Buffer::HasUsageBit(re::Buffer::Raw, m_bufferParams),
 			"Invalid buffer usage for partial updates");
 
-		s_bufferAllocator->StageMutable(GetUniqueID(), data, numBytes, dstBaseOffset);
+		s_bufferAllocator->StageMutable(*this, data, numBytes, dstBaseOffset);
 
 		m_platObj->m_isCommitted = true;
 	}
@@ -175,14 +176,14 @@ namespace re
 	void const* Buffer::GetData() const
 	{
 		void const* dataOut = nullptr;
-		s_bufferAllocator->GetData(GetUniqueID(), &dataOut);
+		s_bufferAllocator->GetData(*this, &dataOut);
 		return dataOut;
 	}
 
 
 	void Buffer::GetDataAndSize(void const** out_data, uint32_t* out_numBytes) const
 	{
-		s_bufferAllocator->GetData(GetUniqueID(), out_data);
+		s_bufferAllocator->GetData(*this, out_data);
 
 		*out_numBytes = m_dataByteSize;
 	}
@@ -223,7 +224,7 @@ namespace re
 
 		if (m_platObj->m_isCreated)
 		{
-			s_bufferAllocator->Deallocate(GetUniqueID());
+			s_bufferAllocator->Deallocate(*this);
 
 			m_platObj->GetContext()->RegisterForDeferredDelete(std::move(m_platObj));
 		}		
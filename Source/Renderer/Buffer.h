@@ -186,6 +186,8 @@ namespace re
 
 		bool m_isCurrentlyMapped;
 
+		void* m_singleFrameStagingData; // Single frame buffers only: Staged data, owned by the BufferAllocator
+
 #if defined(_DEBUG)
 		uint64_t m_creationFrameNum; // What frame was this buffer created on?
 #endif
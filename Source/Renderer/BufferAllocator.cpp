@@ -10,12 +10,16 @@
 #include "Core/ProfilingMarkers.h"
 
 #include "Core/Util/CastUtils.h"
+#include "Core/Util/MathUtils.h"
 
 
 namespace
 {
 	constexpr uint64_t k_invalidFrameNum = std::numeric_limits<uint64_t>::max();
 	constexpr uint32_t k_invalidCommitValue = std::numeric_limits<uint32_t>::max();
+	constexpr uint64_t k_invalidAllocatorID = std::numeric_limits<uint64_t>::max();
+
+	std::atomic<uint64_t> s_nextAllocatorID = 0;
 }
 
 namespace re
@@ -49,6 +53,7 @@ namespace re
 		, m_singleFrameGPUWriteIdx(0)
 		, m_currentFrameNum(k_invalidFrameNum)
 		, m_isValid(false)
+		, m_allocatorID(s_nextAllocatorID.fetch_add(1))
 	{
 		// We maintain N stack base indexes for each Type; Initialize them to 0
 		for (uint8_t allocationPoolIdx = 0; allocationPoolIdx < AllocationPool_Count; allocationPoolIdx++)
@@ -81,7 +86,6 @@ namespace re
 				tempAllocation.m_totalAllocationsByteSize = 0;
 			};
 		InitializeTemporaryAllocation(m_immutableAllocations);
-		InitializeTemporaryAllocation(m_singleFrameAllocations);
 
 		// Register the buffer allocator as the global allocator for buffers:
 		re::Buffer::s_bufferAllocator = this;
@@ -116,6 +120,14 @@ namespace re
 	void BufferAllocator::Destroy()
 	{
 		m_dirtyBuffers.clear();
+		{
+			std::lock_guard<std::recursive_mutex> lock(m_singleFrameAllocations.m_mutex);
+			for (auto& stagingContext : m_singleFrameAllocations.m_stagingContexts)
+			{
+				std::lock_guard<std::mutex> contextLock(stagingContext->m_mutex);
+				stagingContext->m_dirtyBuffers.clear();
+			}
+		}
 
 		{
 			std::scoped_lock lock(
@@ -151,11 +163,6 @@ namespace re
 				LOG_WARNING("Immutable allocations required more than the default reservation amount. Consider "
 					"increasing k_temporaryReservationBytes");
 			}
-			if (m_singleFrameAllocations.m_maxAllocationsByteSize >= k_temporaryReservationBytes)
-			{
-				LOG_WARNING("Single frame allocations required more than the default reservation amount. Consider "
-					"increasing k_temporaryReservationBytes");
-			}
 
 			SEAssert(m_mutableAllocations.m_handleToPtr.empty() && 
 				m_immutableAllocations.m_handleToPtr.empty() &&
@@ -168,6 +175,11 @@ namespace re
 				"Deallocations and tracking data are out of sync");
 
 			SEAssert(m_handleToCommitMetadata.empty(), "Handle to type and byte map should be cleared by now");
+
+			m_singleFrameAllocations.m_stagingContexts.clear();
+			m_singleFrameAllocations.m_freeBlocks.clear();
+			m_singleFrameAllocations.m_usedBlocks.clear();
+			m_singleFrameAllocations.m_oversizedBlocks.clear();
 		}
 
 		m_isValid = false;
@@ -184,6 +196,18 @@ namespace re
 		const Buffer::StagingPool stagingPool = buffer->GetStagingPool();
 		SEAssert(stagingPool != re::Buffer::StagingPool::StagingPool_Invalid, "Invalid AllocationType");
 
+		// Single frame buffers are recorded by the registering thread, and are never looked up via their handle:
+		if (buffer->GetLifetime() == re::Lifetime::SingleFrame)
+		{
+			SingleFrameStagingContext& stagingContext = GetSingleFrameStagingContext();
+			{
+				std::lock_guard<std::mutex> lock(stagingContext.m_mutex);
+				stagingContext.m_dirtyBuffers.emplace_back(buffer);
+			}
+			SEEndCPUEvent();
+			return;
+		}
+
 		const Handle uniqueID = buffer->GetUniqueID();
 
 		auto RecordHandleToPointer = [&](IAllocation& allocation)
@@ -211,11 +235,6 @@ namespace re
 				RecordHandleToPointer(m_immutableAllocations);
 			}
 			break;
-			case re::Lifetime::SingleFrame:
-			{
-				RecordHandleToPointer(m_singleFrameAllocations);
-			}
-			break;
 			default: SEAssertF("Invalid lifetime");
 			}
 
@@ -299,20 +318,7 @@ namespace re
 				UpdateAllocationTracking(m_immutableAllocations);
 			}
 			break;
-			case re::Lifetime::SingleFrame:
-			{
-				std::lock_guard<std::recursive_mutex> lock(m_singleFrameAllocations.m_mutex);
-
-				startIdx = util::CheckedCast<uint32_t>(m_singleFrameAllocations.m_committed.size());
-
-				m_singleFrameAllocations.m_committed.resize(
-					util::CheckedCast<uint32_t>(m_singleFrameAllocations.m_committed.size() + totalBytes),
-					0);
-
-				UpdateAllocationTracking(m_singleFrameAllocations);
-			}
-			break;
-			default: SEAssertF("Invalid lifetime");
+			default: SEAssertF("Invalid lifetime"); // Single frame buffers are allocated via AllocateSingleFrameStaging()
 			}
 		}
 		break;
@@ -342,10 +348,35 @@ namespace re
 	}
 
 
-	void BufferAllocator::Stage(Handle uniqueID, void const* data) noexcept
+	void BufferAllocator::Stage(re::Buffer& buffer, void const* data) noexcept
 	{
 		SEBeginCPUEvent("BufferAllocator::Stage");
 
+		// Single frame buffers are bump-allocated from the calling thread's staging block:
+		if (buffer.GetLifetime() == re::Lifetime::SingleFrame)
+		{
+			if (buffer.GetStagingPool() == Buffer::StagingPool::Temporary)
+			{
+				SEAssert(buffer.m_singleFrameStagingData == nullptr, "Single frame buffers can only be staged once");
+
+				const uint32_t totalBytes = buffer.GetTotalBytes();
+
+				SingleFrameStagingContext& stagingContext = GetSingleFrameStagingContext();
+				{
+					std::lock_guard<std::mutex> lock(stagingContext.m_mutex);
+
+					void* dest = AllocateSingleFrameStaging(stagingContext, totalBytes);
+					memcpy(dest, data, totalBytes);
+
+					buffer.m_singleFrameStagingData = dest;
+				}
+			}
+			SEEndCPUEvent();
+			return;
+		}
+
+		const Handle uniqueID = buffer.GetUniqueID();
+
 		uint32_t startIdx;
 		uint32_t totalBytes;
 		Buffer::StagingPool stagingPool;
@@ -375,7 +406,7 @@ namespace re
 		{
 		case Buffer::StagingPool::Permanent:
 		{
-			StageMutable(uniqueID, data, totalBytes, 0); // Internally adds the buffer to m_dirtyBuffers
+			StageMutable(buffer, data, totalBytes, 0); // Internally adds the buffer to m_dirtyBuffers
 		}
 		break;
 		case Buffer::StagingPool::Temporary:
@@ -392,15 +423,6 @@ namespace re
 				dirtyBuffer = m_immutableAllocations.m_handleToPtr.at(uniqueID).lock();
 			}
 			break;
-			case re::Lifetime::SingleFrame:
-			{
-				std::lock_guard<std::recursive_mutex> lock(m_singleFrameAllocations.m_mutex);
-				void* dest = &m_singleFrameAllocations.m_committed[startIdx];
-				memcpy(dest, data, totalBytes);
-
-				dirtyBuffer = m_singleFrameAllocations.m_handleToPtr.at(uniqueID).lock();
-			}
-			break;
 			default: SEAssertF("Invalid lifetime");
 			}
 			SEAssert(dirtyBuffer != nullptr, "Failed to convert weak to shared_ptr: Buffer leaked?");
@@ -425,12 +447,15 @@ namespace re
 	}
 
 
-	void BufferAllocator::StageMutable(Handle uniqueID, void const* data, uint32_t numBytes, uint32_t dstBaseByteOffset) noexcept
+	void BufferAllocator::StageMutable(
+		re::Buffer& buffer, void const* data, uint32_t numBytes, uint32_t dstBaseByteOffset) noexcept
 	{
 		SEBeginCPUEvent("BufferAllocator::StageMutable");
 
 		SEAssert(numBytes > 0, "0 bytes is only valid for signalling the Buffer::Update to update all bytes");
 
+		const Handle uniqueID = buffer.GetUniqueID();
+
 		uint32_t startIdx;
 		uint32_t totalBytes;
 		{
@@ -654,10 +679,19 @@ namespace re
 	}
 
 
-	void BufferAllocator::GetData(Handle uniqueID, void const** out_data) const noexcept
+	void BufferAllocator::GetData(re::Buffer const& buffer, void const** out_data) const noexcept
 	{
 		SEBeginCPUEvent("BufferAllocator::GetData");
 
+		if (buffer.GetLifetime() == re::Lifetime::SingleFrame)
+		{
+			*out_data = buffer.m_singleFrameStagingData; // Null for unstaged buffers
+			SEEndCPUEvent();
+			return;
+		}
+
+		const Handle uniqueID = buffer.GetUniqueID();
+
 		Buffer::StagingPool stagingPool;
 		re::Lifetime bufferLifetime;
 		uint32_t startIdx = -1;
@@ -697,13 +731,6 @@ namespace re
 				*out_data = static_cast<void const*>(&m_immutableAllocations.m_committed[startIdx]);
 			}
 			break;
-			case re::Lifetime::SingleFrame:
-			{
-				std::lock_guard<std::recursive_mutex> lock(m_singleFrameAllocations.m_mutex);
-				SEAssert(startIdx < m_singleFrameAllocations.m_committed.size(), "Invalid startIdx");
-				*out_data = static_cast<void const*>(&m_singleFrameAllocations.m_committed[startIdx]);
-			}
-			break;
 			default: SEAssertF("Invalid lifetime");
 			}
 		}
@@ -720,10 +747,19 @@ namespace re
 	}
 
 
-	void BufferAllocator::Deallocate(Handle uniqueID) noexcept
+	void BufferAllocator::Deallocate(re::Buffer& buffer) noexcept
 	{
 		SEBeginCPUEvent("BufferAllocator::Deallocate");
 
+		// Single frame staging memory is recycled in bulk at the end of each frame: There is nothing to free
+		if (buffer.GetLifetime() == re::Lifetime::SingleFrame)
+		{
+			SEEndCPUEvent();
+			return;
+		}
+
+		const Handle uniqueID = buffer.GetUniqueID();
+
 		Buffer::StagingPool stagingPool = re::Buffer::StagingPool::StagingPool_Invalid;
 		re::Lifetime bufferLifetime;
 		uint32_t startIdx = std::numeric_limits<uint32_t>::max();
@@ -778,11 +814,6 @@ namespace re
 				ProcessErasure(m_immutableAllocations, stagingPool);
 			}
 			break;
-			case re::Lifetime::SingleFrame:
-			{
-				ProcessErasure(m_singleFrameAllocations, stagingPool);
-			}
-			break;
 			default: SEAssertF("Invalid lifetime");
 			}
 		}
@@ -875,6 +906,25 @@ namespace re
 				}
 			}
 		}
+		{
+			std::lock_guard<std::recursive_mutex> lock(m_singleFrameAllocations.m_mutex);
+
+			for (auto const& stagingContext : m_singleFrameAllocations.m_stagingContexts)
+			{
+				std::lock_guard<std::mutex> contextLock(stagingContext->m_mutex);
+
+				for (std::shared_ptr<re::Buffer> const& currentBuffer : stagingContext->m_dirtyBuffers)
+				{
+					// Skip temporary buffers that were never staged: They'll never be buffered
+					if (!currentBuffer->GetPlatformObject()->m_isCreated &&
+						(currentBuffer->GetStagingPool() == Buffer::StagingPool::None ||
+							currentBuffer->m_singleFrameStagingData != nullptr))
+					{
+						platform::Buffer::Create(*currentBuffer, re::Buffer::s_bufferAllocator, m_numFramesInFlight);
+					}
+				}
+			}
+		}
 
 		SEEndCPUEvent();
 	}
@@ -895,6 +945,14 @@ namespace re
 				m_handleToCommitMetadataMutex,
 				m_dirtyBuffersMutex);
 
+			// Block any threads from staging single frame buffers until we're done:
+			std::vector<std::unique_lock<std::mutex>> stagingContextLocks;
+			stagingContextLocks.reserve(m_singleFrameAllocations.m_stagingContexts.size());
+			for (auto const& stagingContext : m_singleFrameAllocations.m_stagingContexts)
+			{
+				stagingContextLocks.emplace_back(stagingContext->m_mutex);
+			}
+
 			// Start by resetting all of our indexes etc:
 			ResetForNewFrame();
 
@@ -1041,11 +1099,6 @@ namespace re
 						}
 					}
 					break;
-					case re::Lifetime::SingleFrame:
-					{
-						BufferTemporaryData(currentHandle, currentBuffer.get());
-					}
-					break;
 					default: SEAssertF("Invalid lifetime");
 					}
 				}
@@ -1062,6 +1115,39 @@ namespace re
 			// Swap in our dirty list for the next frame
 			m_dirtyBuffers = std::move(stillDirtyMutableBuffers);
 
+			// Single frame buffers are written exactly once, so they're buffered in full:
+			for (auto const& stagingContext : m_singleFrameAllocations.m_stagingContexts)
+			{
+				for (std::shared_ptr<re::Buffer> const& currentBuffer : stagingContext->m_dirtyBuffers)
+				{
+					// Skip buffers that are about to go out of scope, and temporary buffers that were never staged
+					if (currentBuffer.use_count() == 1 ||
+						(currentBuffer->GetStagingPool() == Buffer::StagingPool::Temporary &&
+							currentBuffer->m_singleFrameStagingData == nullptr))
+					{
+						continue;
+					}
+
+					if (!currentBuffer->GetPlatformObject()->m_isCreated)
+					{
+						platform::Buffer::Create(*currentBuffer, this, m_numFramesInFlight);
+					}
+
+					if (currentBuffer->GetStagingPool() == Buffer::StagingPool::Temporary)
+					{
+						SEAssert(currentBuffer->GetPlatformObject()->m_isCommitted,
+							"Trying to buffer a buffer that has not had an initial commit made");
+
+						dirtyUploadHeapBuffers.emplace_back(PlatformCommitMetadata
+							{
+								.m_buffer = currentBuffer.get(),
+								.m_baseOffset = 0,
+								.m_numBytes = currentBuffer->GetTotalBytes(),
+							});
+					}
+				}
+			}
+
 			SEEndCPUEvent(); // "re::BufferAllocator::BufferData: Dirty buffers"
 
 			// Trigger platform buffering:
@@ -1159,8 +1245,45 @@ namespace re
 
 		SEBeginCPUEvent("re::BufferAllocator::ClearTemporaryStaging");
 
-		m_singleFrameAllocations.m_handleToPtr.clear();
-		m_singleFrameAllocations.m_committed.clear();
+		// Release the single frame buffers, and reset the per-thread allocators:
+		uint32_t numFrameAllocations = 0;
+		uint32_t numFrameAllocationsByteSize = 0;
+		for (auto const& stagingContext : m_singleFrameAllocations.m_stagingContexts)
+		{
+			for (std::shared_ptr<re::Buffer> const& singleFrameBuffer : stagingContext->m_dirtyBuffers)
+			{
+				singleFrameBuffer->m_singleFrameStagingData = nullptr; // The staging data is about to be recycled
+			}
+			stagingContext->m_dirtyBuffers.clear();
+
+			stagingContext->m_blockData = nullptr;
+			stagingContext->m_blockOffset = 0;
+			stagingContext->m_blockByteSize = 0;
+
+			numFrameAllocations += stagingContext->m_numFrameAllocations;
+			numFrameAllocationsByteSize += stagingContext->m_numFrameAllocationsByteSize;
+			stagingContext->m_numFrameAllocations = 0;
+			stagingContext->m_numFrameAllocationsByteSize = 0;
+		}
+
+		m_singleFrameAllocations.m_totalAllocations += numFrameAllocations;
+		m_singleFrameAllocations.m_totalAllocationsByteSize += numFrameAllocationsByteSize;
+		m_singleFrameAllocations.m_maxAllocations =
+			std::max(m_singleFrameAllocations.m_maxAllocations, numFrameAllocations);
+		m_singleFrameAllocations.m_maxAllocationsByteSize =
+			std::max(m_singleFrameAllocations.m_maxAllocationsByteSize, numFrameAllocationsByteSize);
+
+		// Recycle the staging blocks:
+		{
+			std::lock_guard<std::mutex> blockLock(m_singleFrameAllocations.m_blockMutex);
+
+			for (auto& block : m_singleFrameAllocations.m_usedBlocks)
+			{
+				m_singleFrameAllocations.m_freeBlocks.emplace_back(std::move(block));
+			}
+			m_singleFrameAllocations.m_usedBlocks.clear();
+			m_singleFrameAllocations.m_oversizedBlocks.clear();
+		}
 
 		// Clear immutable allocations: We only write this data exactly once, no point keeping it around
 		m_immutableAllocations.m_committed.clear();
@@ -1169,6 +1292,69 @@ namespace re
 	}
 
 
+	BufferAllocator::SingleFrameStagingContext& BufferAllocator::GetSingleFrameStagingContext()
+	{
+		// Each thread caches its staging context, along with the ID of the allocator that owns it (in case the
+		// allocator is destroyed and recreated)
+		thread_local uint64_t s_stagingContextAllocatorID = k_invalidAllocatorID;
+		thread_local SingleFrameStagingContext* s_stagingContext = nullptr;
+
+		if (s_stagingContextAllocatorID != m_allocatorID)
+		{
+			std::lock_guard<std::recursive_mutex> lock(m_singleFrameAllocations.m_mutex);
+
+			s_stagingContext = m_singleFrameAllocations.m_stagingContexts.emplace_back(
+				std::make_unique<SingleFrameStagingContext>()).get();
+			s_stagingContextAllocatorID = m_allocatorID;
+		}
+		return *s_stagingContext;
+	}
+
+
+	uint8_t* BufferAllocator::AllocateSingleFrameStaging(SingleFrameStagingContext& stagingContext, uint32_t numBytes)
+	{
+		// Note: The staging context's mutex is already locked
+
+		const uint32_t alignedBytes = util::RoundUpToNearestMultiple(numBytes, k_singleFrameStagingAlignment);
+
+		stagingContext.m_numFrameAllocations++;
+		stagingContext.m_numFrameAllocationsByteSize += numBytes;
+
+		if (stagingContext.m_blockOffset + alignedBytes > stagingContext.m_blockByteSize)
+		{
+			std::lock_guard<std::mutex> blockLock(m_singleFrameAllocations.m_blockMutex);
+
+			// Allocations larger than a block get a dedicated allocation, and leave the current block in place
+			if (alignedBytes > k_singleFrameStagingBlockBytes)
+			{
+				return m_singleFrameAllocations.m_oversizedBlocks.emplace_back(
+					std::make_unique_for_overwrite<uint8_t[]>(alignedBytes)).get();
+			}
+
+			if (m_singleFrameAllocations.m_freeBlocks.empty())
+			{
+				m_singleFrameAllocations.m_usedBlocks.emplace_back(
+					std::make_unique_for_overwrite<uint8_t[]>(k_singleFrameStagingBlockBytes));
+			}
+			else
+			{
+				m_singleFrameAllocations.m_usedBlocks.emplace_back(
+					std::move(m_singleFrameAllocations.m_freeBlocks.back()));
+				m_singleFrameAllocations.m_freeBlocks.pop_back();
+			}
+
+			stagingContext.m_blockData = m_singleFrameAllocations.m_usedBlocks.back().get();
+			stagingContext.m_blockOffset = 0;
+			stagingContext.m_blockByteSize = k_singleFrameStagingBlockBytes;
+		}
+
+		uint8_t* allocation = stagingContext.m_blockData + stagingContext.m_blockOffset;
+		stagingContext.m_blockOffset += alignedBytes;
+
+		return allocation;
+	}
+
+
 	uint32_t BufferAllocator::AdvanceBaseIdx(AllocationPool allocationPool, uint32_t alignedSize)
 	{
 		// Atomically advance the stack base index for the next call, and return the base index for the current one
@@ -18,10 +18,10 @@ namespace re
 
 	public:
 		virtual void Register(std::shared_ptr<re::Buffer> const&, uint32_t numBytes) noexcept = 0;
-		virtual void Stage(Handle uniqueID, void const* data) noexcept = 0;
-		virtual void StageMutable(Handle uniqueID, void const* data, uint32_t numBytes, uint32_t dstBaseByteOffset) noexcept = 0;
-		virtual void GetData(Handle uniqueID, void const** out_data) const noexcept = 0;
-		virtual void Deallocate(Handle uniqueID) noexcept = 0;
+		virtual void Stage(re::Buffer&, void const* data) noexcept = 0;
+		virtual void StageMutable(re::Buffer&, void const* data, uint32_t numBytes, uint32_t dstBaseByteOffset) noexcept = 0;
+		virtual void GetData(re::Buffer const&, void const** out_data) const noexcept = 0;
+		virtual void Deallocate(re::Buffer&) noexcept = 0;
 
 		virtual uint8_t GetNumFramesInFlight() const noexcept = 0;
 		virtual uint64_t GetCurrentRenderFrameNum() const noexcept = 0;
@@ -41,6 +41,10 @@ namespace re
 		// Reservation size for temporary CPU-side commit buffers
 		static constexpr uint32_t k_temporaryReservationBytes = 64 * 1024 * 1024; 
 
+		// Single frame CPU-side staging memory is handed out to each thread in blocks of this size
+		static constexpr uint32_t k_singleFrameStagingBlockBytes = 1024 * 1024;
+		static constexpr uint32_t k_singleFrameStagingAlignment = 16;
+
 		// No. of permanent mutable buffers we expect to see
 		static constexpr uint32_t k_permanentReservationCount = 128; 
 
@@ -153,7 +157,39 @@ namespace re
 			std::vector<uint8_t> m_committed; // Cleared after every frame; Temporaries are written to once
 		};
 		TemporaryAllocation m_immutableAllocations;
-		TemporaryAllocation m_singleFrameAllocations;
+
+		// Single frame buffers are staged with per-thread bump allocators, which carve their allocations from blocks
+		// shared by all threads. The staged data pointer is stored on the Buffer itself, so no per-handle bookkeeping
+		// is required. All blocks are recycled once the frame's data has been buffered
+		struct SingleFrameStagingContext final // Per-thread
+		{
+			std::vector<std::shared_ptr<re::Buffer>> m_dirtyBuffers; // Single frame buffers registered this frame
+
+			uint8_t* m_blockData = nullptr;
+			uint32_t m_blockOffset = 0;
+			uint32_t m_blockByteSize = 0;
+
+			uint32_t m_numFrameAllocations = 0;
+			uint32_t m_numFrameAllocationsByteSize = 0;
+
+			std::mutex m_mutex; // Only contended when the render thread collects the staged buffers
+		};
+
+		struct SingleFrameAllocation final : public virtual IAllocation
+		{
+			std::vector<std::unique_ptr<SingleFrameStagingContext>> m_stagingContexts; // Guarded by IAllocation::m_mutex
+
+			std::vector<std::unique_ptr<uint8_t[]>> m_freeBlocks;
+			std::vector<std::unique_ptr<uint8_t[]>> m_usedBlocks; // Handed out this frame
+			std::vector<std::unique_ptr<uint8_t[]>> m_oversizedBlocks; // Allocations larger than a block. Freed each frame
+			std::mutex m_blockMutex; // Only locked when a thread exhausts its current block
+		};
+		SingleFrameAllocation m_singleFrameAllocations;
+
+		SingleFrameStagingContext& GetSingleFrameStagingContext(); // For the calling thread
+		uint8_t* AllocateSingleFrameStaging(SingleFrameStagingContext&, uint32_t numBytes);
+
+		const uint64_t m_allocatorID; // Identifies the thread-local SingleFrameStagingContext cache entries we own
 
 
 		std::unordered_map<Handle, CommitMetadata> m_handleToCommitMetadata;
@@ -202,12 +238,12 @@ namespace re
 	private:		
 		uint32_t Allocate(Handle uniqueID, uint32_t numBytes, Buffer::StagingPool, re::Lifetime bufferLifetime); // Returns the start index
 
-		void Stage(Handle uniqueID, void const* data) noexcept override;	// Update the buffer data
-		void StageMutable(Handle uniqueID, void const* data, uint32_t numBytes, uint32_t dstBaseByteOffset) noexcept;
+		void Stage(re::Buffer&, void const* data) noexcept override;	// Update the buffer data
+		void StageMutable(re::Buffer&, void const* data, uint32_t numBytes, uint32_t dstBaseByteOffset) noexcept;
 		
-		void GetData(Handle uniqueID, void const** out_data) const noexcept;
+		void GetData(re::Buffer const&, void const** out_data) const noexcept;
 
-		void Deallocate(Handle uniqueID) noexcept;
+		void Deallocate(re::Buffer&) noexcept;
 
 
 	private:
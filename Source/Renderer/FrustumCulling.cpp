@@ -0,0 +1,302 @@
+// © 2025 Adam Badke. All rights reserved.
+#include "FrustumCulling.h"
+#include "TransformRenderData.h"
+
+#include "Core/Assert.h"
+
+#include <emmintrin.h> // SSE2
+
+
+namespace
+{
+	void GetAxisProjection(
+		std::array<glm::vec3, 8> const& cornerPoints,
+		const glm::vec3& axis,
+		float& minOut,
+		float& maxOut)
+	{
+		// Micro-optimization: Get the first point's projection to skip a round of min/max comparisons
+		minOut = glm::dot(cornerPoints[0], axis);
+		maxOut = minOut;
+
+		for (uint8_t i = 1; i < cornerPoints.size(); ++i)
+		{
+			const float projection = glm::dot(cornerPoints[i], axis);
+			minOut = std::min(minOut, projection);
+			maxOut = std::max(maxOut, projection);
+		}
+	}
+
+
+	bool TestAxisSeparation(
+		std::array<glm::vec3, 8> const& boundsCorners,
+		std::array<glm::vec3, 8> const& frustumCorners,
+		const glm::vec3& axis)
+	{
+		constexpr float k_epsilon = 0.000001f;
+		if (glm::dot(axis, axis) < k_epsilon) // Guard against degenerate axis (e.g. cross product of 2 near-parallel vectors)
+		{
+			return false; // Skip degenerate axis
+		}
+
+		float boundsProjectedMin, boundsProjectedMax;
+		GetAxisProjection(boundsCorners, axis, boundsProjectedMin, boundsProjectedMax);
+
+		float frustumProjectedMin, frustumProjectedMax;
+		GetAxisProjection(frustumCorners, axis, frustumProjectedMin, frustumProjectedMax);
+
+		return (boundsProjectedMax < frustumProjectedMin || 
+			frustumProjectedMax < boundsProjectedMin); // Do our projected regions overlap?
+	}
+}
+
+
+namespace grutil
+{
+	bool TestBoundsVisibility(
+		glm::vec3 const& worldMinXYZ,
+		glm::vec3 const& worldMaxXYZ,
+		gr::Camera::Frustum const& frustum)
+	{
+		const std::array<glm::vec3, 8> expandedBoundsPoints = {
+			glm::vec3(worldMinXYZ.x, worldMaxXYZ.y, worldMaxXYZ.z), // farTL
+			glm::vec3(worldMinXYZ.x, worldMinXYZ.y, worldMaxXYZ.z), // farBL
+			glm::vec3(worldMaxXYZ.x, worldMaxXYZ.y, worldMaxXYZ.z), // farTR
+			glm::vec3(worldMaxXYZ.x, worldMinXYZ.y, worldMaxXYZ.z), // farBR
+			glm::vec3(worldMinXYZ.x, worldMaxXYZ.y, worldMinXYZ.z), // nearTL
+			glm::vec3(worldMinXYZ.x, worldMinXYZ.y, worldMinXYZ.z), // nearBL
+			glm::vec3(worldMaxXYZ.x, worldMaxXYZ.y, worldMinXYZ.z), // nearTR
+			glm::vec3(worldMaxXYZ.x, worldMinXYZ.y, worldMinXYZ.z), // nearBR
+		};
+		
+		static constexpr glm::vec3 k_boundsFaceAxes[3] = {
+			gr::Transform::WorldAxisX,
+			gr::Transform::WorldAxisY,
+			gr::Transform::WorldAxisZ
+		};
+
+		// Separating Axis theorem: The following separating axes must be tested:
+		// 1) 6 face normals of the frustum
+		// 2) 3 face normals of the AABB Bounds (i.e. world XYZ)
+		// 3) The cross products of the edges of the frustum and Bounds
+
+		// 1) Test the frustum face normals:
+		for (uint8_t i = 0; i < frustum.m_normals.size(); ++i)
+		{
+			if (TestAxisSeparation(expandedBoundsPoints, frustum.m_corners, frustum.m_normals[i]))
+			{
+				return false;
+			}
+		}
+
+		// 2) Test the bounds face normals:
+		for (glm::vec3 const& axis : k_boundsFaceAxes)
+		{
+			if (TestAxisSeparation(expandedBoundsPoints, frustum.m_corners, axis))
+			{
+				return false;
+			}
+		}
+
+		// 2) Test all edge x edge pairs:
+		for (const auto& boundsFaceAxis : k_boundsFaceAxes)
+		{
+			for (uint8_t i = 0; i < frustum.m_edgeDirections.size(); ++i)
+			{
+				glm::vec3 const& crossAxis = glm::cross(boundsFaceAxis, frustum.m_edgeDirections[i]);
+
+				if (TestAxisSeparation(expandedBoundsPoints, frustum.m_corners, crossAxis))
+				{
+					return false;
+				}
+			}
+		}
+
+		// If we've made it this far, the object is visible
+		return true;
+	}
+
+
+	FrustumSlabs BuildFrustumSlabs(gr::Camera::Frustum const& frustum)
+	{
+		FrustumSlabs slabs;
+
+		for (uint8_t i = 0; i < FrustumSlabs::k_numFaceAxes; ++i)
+		{
+			slabs.m_normals[i] = frustum.m_normals[i];
+
+			// Use the same projection as the SAT test, so both paths agree on which bounds are separated
+			GetAxisProjection(frustum.m_corners, frustum.m_normals[i], slabs.m_normalMin[i], slabs.m_normalMax[i]);
+		}
+
+		slabs.m_cornersMin = frustum.m_corners[0];
+		slabs.m_cornersMax = frustum.m_corners[0];
+		for (uint8_t i = 1; i < frustum.m_corners.size(); ++i)
+		{
+			slabs.m_cornersMin = glm::min(slabs.m_cornersMin, frustum.m_corners[i]);
+			slabs.m_cornersMax = glm::max(slabs.m_cornersMax, frustum.m_corners[i]);
+		}
+
+		return slabs;
+	}
+
+
+	CullResult ClassifyBounds(glm::vec3 const& minXYZ, glm::vec3 const& maxXYZ, FrustumSlabs const& slabs)
+	{
+		if (glm::any(glm::lessThan(maxXYZ, slabs.m_cornersMin)) || glm::any(glm::lessThan(slabs.m_cornersMax, minXYZ)))
+		{
+			return CullResult::Outside;
+		}
+
+		bool isInside = true;
+		for (uint8_t faceIdx = 0; faceIdx < FrustumSlabs::k_numFaceAxes; ++faceIdx)
+		{
+			glm::vec3 const& normal = slabs.m_normals[faceIdx];
+
+			const float projectedMin = 
+				normal.x * (normal.x >= 0.f ? minXYZ.x : maxXYZ.x) +
+				normal.y * (normal.y >= 0.f ? minXYZ.y : maxXYZ.y) +
+				normal.z * (normal.z >= 0.f ? minXYZ.z : maxXYZ.z);
+
+			const float projectedMax = 
+				normal.x * (normal.x >= 0.f ? maxXYZ.x : minXYZ.x) +
+				normal.y * (normal.y >= 0.f ? maxXYZ.y : minXYZ.y) +
+				normal.z * (normal.z >= 0.f ? maxXYZ.z : minXYZ.z);
+
+			if (projectedMax < slabs.m_normalMin[faceIdx] || slabs.m_normalMax[faceIdx] < projectedMin)
+			{
+				return CullResult::Outside;
+			}
+			isInside &= (projectedMin >= slabs.m_normalMin[faceIdx] && projectedMax <= slabs.m_normalMax[faceIdx]);
+		}
+
+		return isInside ? CullResult::Inside : CullResult::Intersecting;
+	}
+
+
+	void ClassifyBounds(
+		BoundsSoA const& bounds,
+		size_t beginIdx,
+		size_t endIdx,
+		FrustumSlabs const& slabs,
+		uint8_t* resultsOut)
+	{
+		SEStaticAssert(BoundsSoA::k_simdWidth == 4, "SSE path expects 4-wide bounds");
+		SEAssert(endIdx <= bounds.Size() && bounds.m_minX.size() >= bounds.Size() + 3, "Bounds are not padded");
+
+		const __m128 frustumMinX = _mm_set1_ps(slabs.m_cornersMin.x);
+		const __m128 frustumMinY = _mm_set1_ps(slabs.m_cornersMin.y);
+		const __m128 frustumMinZ = _mm_set1_ps(slabs.m_cornersMin.z);
+		const __m128 frustumMaxX = _mm_set1_ps(slabs.m_cornersMax.x);
+		const __m128 frustumMaxY = _mm_set1_ps(slabs.m_cornersMax.y);
+		const __m128 frustumMaxZ = _mm_set1_ps(slabs.m_cornersMax.z);
+
+		for (size_t groupIdx = beginIdx; groupIdx < endIdx; groupIdx += 4)
+		{
+			// Note: Lanes past endIdx read padding/neighbouring bounds; their results are discarded
+			const __m128 minX = _mm_loadu_ps(&bounds.m_minX[groupIdx]);
+			const __m128 minY = _mm_loadu_ps(&bounds.m_minY[groupIdx]);
+			const __m128 minZ = _mm_loadu_ps(&bounds.m_minZ[groupIdx]);
+			const __m128 maxX = _mm_loadu_ps(&bounds.m_maxX[groupIdx]);
+			const __m128 maxY = _mm_loadu_ps(&bounds.m_maxY[groupIdx]);
+			const __m128 maxZ = _mm_loadu_ps(&bounds.m_maxZ[groupIdx]);
+
+			// World axes: Compare the AABBs against the frustum's AABB
+			__m128 isOutside = _mm_or_ps(
+				_mm_or_ps(_mm_cmplt_ps(maxX, frustumMinX), _mm_cmplt_ps(frustumMaxX, minX)),
+				_mm_or_ps(
+					_mm_or_ps(_mm_cmplt_ps(maxY, frustumMinY), _mm_cmplt_ps(frustumMaxY, minY)),
+					_mm_or_ps(_mm_cmplt_ps(maxZ, frustumMinZ), _mm_cmplt_ps(frustumMaxZ, minZ))));
+
+			__m128 isInside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+			// Frustum face normals: Project the AABB corners nearest/furthest along each normal
+			for (uint8_t faceIdx = 0; faceIdx < FrustumSlabs::k_numFaceAxes; ++faceIdx)
+			{
+				glm::vec3 const& normal = slabs.m_normals[faceIdx];
+
+				const __m128 normalX = _mm_set1_ps(normal.x);
+				const __m128 normalY = _mm_set1_ps(normal.y);
+				const __m128 normalZ = _mm_set1_ps(normal.z);
+
+				const __m128 projectedMin = _mm_add_ps(_mm_add_ps(
+					_mm_mul_ps(normalX, normal.x >= 0.f ? minX : maxX),
+					_mm_mul_ps(normalY, normal.y >= 0.f ? minY : maxY)),
+					_mm_mul_ps(normalZ, normal.z >= 0.f ? minZ : maxZ));
+
+				const __m128 projectedMax = _mm_add_ps(_mm_add_ps(
+					_mm_mul_ps(normalX, normal.x >= 0.f ? maxX : minX),
+					_mm_mul_ps(normalY, normal.y >= 0.f ? maxY : minY)),
+					_mm_mul_ps(normalZ, normal.z >= 0.f ? maxZ : minZ));
+
+				const __m128 slabMin = _mm_set1_ps(slabs.m_normalMin[faceIdx]);
+				const __m128 slabMax = _mm_set1_ps(slabs.m_normalMax[faceIdx]);
+
+				isOutside = _mm_or_ps(isOutside,
+					_mm_or_ps(_mm_cmplt_ps(projectedMax, slabMin), _mm_cmplt_ps(slabMax, projectedMin)));
+
+				isInside = _mm_and_ps(isInside,
+					_mm_and_ps(_mm_cmpge_ps(projectedMin, slabMin), _mm_cmple_ps(projectedMax, slabMax)));
+			}
+
+			const int outsideMask = _mm_movemask_ps(isOutside);
+			const int insideMask = _mm_movemask_ps(isInside);
+
+			const size_t numLanes = std::min<size_t>(4, endIdx - groupIdx);
+			for (size_t lane = 0; lane < numLanes; ++lane)
+			{
+				const CullResult result = (outsideMask & (1 << lane)) ? CullResult::Outside :
+					((insideMask & (1 << lane)) ? CullResult::Inside : CullResult::Intersecting);
+
+				resultsOut[groupIdx - beginIdx + lane] = static_cast<uint8_t>(result);
+			}
+		}
+	}
+
+
+	void CullBounds(
+		BoundsSoA const& bounds,
+		size_t beginIdx,
+		size_t endIdx,
+		gr::Camera::Frustum const& frustum,
+		FrustumSlabs const& slabs,
+		std::vector<uint8_t>& visibleOut)
+	{
+		visibleOut.resize(endIdx - beginIdx);
+
+		ClassifyBounds(bounds, beginIdx, endIdx, slabs, visibleOut.data());
+
+		for (size_t boundsIdx = beginIdx; boundsIdx < endIdx; ++boundsIdx)
+		{
+			uint8_t& result = visibleOut[boundsIdx - beginIdx];
+			if (static_cast<CullResult>(result) == CullResult::Intersecting)
+			{
+				result = TestBoundsVisibility(
+					glm::vec3(bounds.m_minX[boundsIdx], bounds.m_minY[boundsIdx], bounds.m_minZ[boundsIdx]),
+					glm::vec3(bounds.m_maxX[boundsIdx], bounds.m_maxY[boundsIdx], bounds.m_maxZ[boundsIdx]),
+					frustum);
+			}
+			else
+			{
+				result = (static_cast<CullResult>(result) == CullResult::Inside);
+			}
+		}
+	}
+
+
+	bool IsBoundsVisible(
+		glm::vec3 const& worldMinXYZ,
+		glm::vec3 const& worldMaxXYZ,
+		gr::Camera::Frustum const& frustum,
+		FrustumSlabs const& slabs)
+	{
+		switch (ClassifyBounds(worldMinXYZ, worldMaxXYZ, slabs))
+		{
+		case CullResult::Outside: return false;
+		case CullResult::Inside: return true;
+		case CullResult::Intersecting: return TestBoundsVisibility(worldMinXYZ, worldMaxXYZ, frustum);
+		default: SEAssertF("Invalid cull result");
+		}
+		return true; // This should never happen
+	}
+}
\ No newline at end of file
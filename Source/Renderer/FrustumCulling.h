@@ -0,0 +1,95 @@
+// © 2025 Adam Badke. All rights reserved.
+#pragma once
+#include "BoundsHierarchy.h"
+#include "CameraRenderData.h"
+#include "RenderObjectIDs.h"
+
+
+namespace grutil
+{
+	using CullResult = gr::BoundsHierarchy::TestResult;
+
+
+	// World-space AABBs stored as SoA arrays, so they can be tested against a frustum several at a time.
+	// Note: The float arrays are padded with k_simdWidth - 1 trailing elements, to allow full-width loads
+	struct BoundsSoA final
+	{
+		static constexpr size_t k_simdWidth = 4;
+
+		void Add(gr::RenderDataID renderDataID, glm::vec3 const& worldMinXYZ, glm::vec3 const& worldMaxXYZ)
+		{
+			m_renderDataIDs.emplace_back(renderDataID);
+			m_minX.emplace_back(worldMinXYZ.x);
+			m_minY.emplace_back(worldMinXYZ.y);
+			m_minZ.emplace_back(worldMinXYZ.z);
+			m_maxX.emplace_back(worldMaxXYZ.x);
+			m_maxY.emplace_back(worldMaxXYZ.y);
+			m_maxZ.emplace_back(worldMaxXYZ.z);
+		}
+
+		void Pad() // Call once all bounds have been added
+		{
+			const size_t paddedSize = m_renderDataIDs.size() + k_simdWidth - 1;
+			m_minX.resize(paddedSize, 0.f);
+			m_minY.resize(paddedSize, 0.f);
+			m_minZ.resize(paddedSize, 0.f);
+			m_maxX.resize(paddedSize, 0.f);
+			m_maxY.resize(paddedSize, 0.f);
+			m_maxZ.resize(paddedSize, 0.f);
+		}
+
+		size_t Size() const { return m_renderDataIDs.size(); }
+
+		std::vector<gr::RenderDataID> m_renderDataIDs;
+		std::vector<float> m_minX;
+		std::vector<float> m_minY;
+		std::vector<float> m_minZ;
+		std::vector<float> m_maxX;
+		std::vector<float> m_maxY;
+		std::vector<float> m_maxZ;
+	};
+
+
+	// The frustum face normals and world axes, with the min/max projections of the frustum corners onto each. These
+	// are the first 9 SAT axes, which can be tested against several AABBs at once
+	struct FrustumSlabs final
+	{
+		static constexpr uint8_t k_numFaceAxes = 6;
+
+		std::array<glm::vec3, k_numFaceAxes> m_normals;
+		std::array<float, k_numFaceAxes> m_normalMin;
+		std::array<float, k_numFaceAxes> m_normalMax;
+
+		glm::vec3 m_cornersMin; // The frustum's world-space AABB
+		glm::vec3 m_cornersMax;
+	};
+
+	FrustumSlabs BuildFrustumSlabs(gr::Camera::Frustum const&);
+
+
+	// Uses the separating axis theoreom to test AABB bounds against a world-space camera frustum.
+	// Returns true if a bounds is visible, or false otherwise
+	bool TestBoundsVisibility(glm::vec3 const& worldMinXYZ, glm::vec3 const& worldMaxXYZ, gr::Camera::Frustum const&);
+
+	// Scalar equivalent of the SIMD kernel below, for classifying individual AABBs (e.g. BoundsHierarchy nodes)
+	CullResult ClassifyBounds(glm::vec3 const& minXYZ, glm::vec3 const& maxXYZ, FrustumSlabs const&);
+
+	// Classifies the AABBs in [beginIdx, endIdx) against the frustum slabs, 4 at a time using SSE.
+	// resultsOut[i - beginIdx] receives the CullResult of the AABB at index i
+	void ClassifyBounds(
+		BoundsSoA const&, size_t beginIdx, size_t endIdx, FrustumSlabs const&, uint8_t* resultsOut);
+
+	// Classifies bounds in [beginIdx, endIdx) using the SIMD kernel, and resolves any ambiguous results with the exact
+	// SAT test. visibleOut[i - beginIdx] is set to true if the bounds at index i is visible
+	void CullBounds(
+		BoundsSoA const&,
+		size_t beginIdx,
+		size_t endIdx,
+		gr::Camera::Frustum const&,
+		FrustumSlabs const&,
+		std::vector<uint8_t>& visibleOut);
+
+	// Classifies a single AABB, and resolves an ambiguous result with the exact SAT test
+	bool IsBoundsVisible(
+		glm::vec3 const& worldMinXYZ, glm::vec3 const& worldMaxXYZ, gr::Camera::Frustum const&, FrustumSlabs const&);
+}
\ No newline at end of file
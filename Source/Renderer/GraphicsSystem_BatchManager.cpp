@@ -114,13 +114,12 @@ namespace gr
 		// Create/update batches for new/dirty objects
 		SEBeginCPUEvent("Create/update batches");
 
-		std::vector<gr::RenderDataID> const& dirtyIDs =
-			renderData.GetIDsWithAnyDirtyData<gr::MeshPrimitive::RenderData, gr::Material::MaterialInstanceRenderData>(
-				gr::RenderObjectFeature::IsMeshPrimitiveConcept);
+		renderData.GetIDsWithAnyDirtyData<gr::MeshPrimitive::RenderData, gr::Material::MaterialInstanceRenderData>(
+			m_dirtyIDs, gr::RenderObjectFeature::IsMeshPrimitiveConcept);
 
-		if (!dirtyIDs.empty())
+		if (!m_dirtyIDs.empty())
 		{
-			for (auto const& itr : gr::IDAdapter(renderData, dirtyIDs))
+			for (auto const& itr : gr::IDAdapter(renderData, m_dirtyIDs))
 			{
 				const gr::RenderDataID renderDataID = itr->GetRenderDataID();
 
@@ -75,5 +75,7 @@ namespace gr
 		
 		ViewBatches m_viewBatches; // Map of gr::Camera::View to vectors of Batches that passed culling
 		std::vector<gr::BatchHandle> m_allBatches; // Per-frame copy of m_permanentCachedBatches, with Buffers set
+
+		std::vector<gr::RenderDataID> m_dirtyIDs; // Reused each frame to avoid per-frame allocations
 	};
 }
\ No newline at end of file
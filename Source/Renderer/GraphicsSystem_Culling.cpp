@@ -1,6 +1,7 @@
 //  2023 Adam Badke. All rights reserved.
 #include "BoundsRenderData.h"
 #include "CameraRenderData.h"
+#include "FrustumCulling.h"
 #include "GraphicsSystem_Culling.h"
 #include "GraphicsSystemManager.h"
 #include "LightRenderData.h"
@@ -11,258 +12,292 @@
 #include "Core/ProfilingMarkers.h"
 #include "Core/ThreadPool.h"
 
-#include "Core/Util/ThreadSafeVector.h"
 
 
 namespace
 {
-	void GetAxisProjection(
-		std::array<glm::vec3, 8> const& cornerPoints,
-		const glm::vec3& axis,
-		float& minOut,
-		float& maxOut)
+	float GetDistanceToBounds(grutil::BoundsSoA const& bounds, size_t boundsIdx, glm::vec3 const& pos)
 	{
-		// Micro-optimization: Get the first point's projection to skip a round of min/max comparisons
-		minOut = glm::dot(cornerPoints[0], axis);
-		maxOut = minOut;
+		const glm::vec3 boundsCenter = glm::vec3(
+			bounds.m_minX[boundsIdx] + bounds.m_maxX[boundsIdx],
+			bounds.m_minY[boundsIdx] + bounds.m_maxY[boundsIdx],
+			bounds.m_minZ[boundsIdx] + bounds.m_maxZ[boundsIdx]) * 0.5f;
 
-		for (uint8_t i = 1; i < cornerPoints.size(); ++i)
-		{
-			const float projection = glm::dot(cornerPoints[i], axis);
-			minOut = std::min(minOut, projection);
-			maxOut = std::max(maxOut, projection);
-		}
+		return glm::length(pos - boundsCenter);
 	}
 
 
-	bool TestAxisSeparation(
-		std::array<glm::vec3, 8> const& boundsCorners,
-		std::array<glm::vec3, 8> const& frustumCorners,
-		const glm::vec3& axis)
+	void CullLights(
+		gr::RenderDataManager const& renderData, 
+		gr::BoundsHierarchy const& lightBoundsHierarchy,
+		gr::Camera::Frustum const& frustum,
+		std::vector<gr::RenderDataID>& pointLightIDsOut,
+		std::vector<gr::RenderDataID>& spotLightIDsOut,
+		bool cullingEnabled)
 	{
-		constexpr float k_epsilon = 0.000001f;
-		if (glm::dot(axis, axis) < k_epsilon) // Guard against degenerate axis (e.g. cross product of 2 near-parallel vectors)
+		SEBeginCPUEvent("CullLights");
+
+		SEAssert(pointLightIDsOut.empty() && spotLightIDsOut.empty(), "ID vectors are not empty");
+
+		pointLightIDsOut.reserve(renderData.GetNumElementsOfType<gr::Light::RenderDataPoint>());
+		spotLightIDsOut.reserve(renderData.GetNumElementsOfType<gr::Light::RenderDataSpot>());
+
+		if (!cullingEnabled)
 		{
-			return false; // Skip degenerate axis
+			for (auto const& lightItr : gr::LinearAdapter<gr::Light::RenderDataPoint>(renderData))
+			{
+				pointLightIDsOut.emplace_back(lightItr->GetRenderDataID());
+			}
+			for (auto const& lightItr : gr::LinearAdapter<gr::Light::RenderDataSpot>(renderData))
+			{
+				spotLightIDsOut.emplace_back(lightItr->GetRenderDataID());
+			}
 		}
+		else
+		{
+			const grutil::FrustumSlabs slabs = grutil::BuildFrustumSlabs(frustum);
 
-		float boundsProjectedMin, boundsProjectedMax;
-		GetAxisProjection(boundsCorners, axis, boundsProjectedMin, boundsProjectedMax);
+			// Hierarchical culling: Subtrees outside of the frustum are skipped without visiting their lights
+			lightBoundsHierarchy.Query(
+				[&slabs](glm::vec3 const& minXYZ, glm::vec3 const& maxXYZ)
+				{
+					return grutil::ClassifyBounds(minXYZ, maxXYZ, slabs);
+				},
+				[&](gr::RenderDataID lightID, glm::vec3 const& lightMinXYZ, glm::vec3 const& lightMaxXYZ, bool isInside)
+				{
+					if (!isInside && !grutil::TestBoundsVisibility(lightMinXYZ, lightMaxXYZ, frustum))
+					{
+						return;
+					}
 
-		float frustumProjectedMin, frustumProjectedMax;
-		GetAxisProjection(frustumCorners, axis, frustumProjectedMin, frustumProjectedMax);
+					if (renderData.HasObjectData<gr::Light::RenderDataPoint>(lightID))
+					{
+						if (renderData.GetObjectData<gr::Light::RenderDataPoint>(lightID).m_canContribute)
+						{
+							pointLightIDsOut.emplace_back(lightID);
+						}
+					}
+					else if (renderData.HasObjectData<gr::Light::RenderDataSpot>(lightID))
+					{
+						if (renderData.GetObjectData<gr::Light::RenderDataSpot>(lightID).m_canContribute)
+						{
+							spotLightIDsOut.emplace_back(lightID);
+						}
+					}
+				});
+		}
 
-		return (boundsProjectedMax < frustumProjectedMin || 
-			frustumProjectedMax < boundsProjectedMin); // Do our projected regions overlap?
+		SEEndCPUEvent(); // "CullLights"
 	}
 
 
-	// Uses the separating axis theoreom to test AABB bounds against a world-space camera frustum.
-	// Returns true if a bounds is visible, or false otherwise
-	bool TestBoundsVisibility(
-		gr::Bounds::RenderData const& bounds,
-		gr::Camera::Frustum const& frustum,
-		float* camToMeshBoundsDistOut = nullptr)
+	bool HasNonZeroScale(gr::RenderDataManager const& renderData, gr::RenderDataID renderDataID)
 	{
-		SEBeginCPUEvent("TestBoundsVisibility");
-
-		const std::array<glm::vec3, 8> expandedBoundsPoints = {
-			glm::vec3(bounds.m_worldMinXYZ.x, bounds.m_worldMaxXYZ.y, bounds.m_worldMaxXYZ.z), // farTL
-			glm::vec3(bounds.m_worldMinXYZ.x, bounds.m_worldMinXYZ.y, bounds.m_worldMaxXYZ.z), // farBL
-			glm::vec3(bounds.m_worldMaxXYZ.x, bounds.m_worldMaxXYZ.y, bounds.m_worldMaxXYZ.z), // farTR
-			glm::vec3(bounds.m_worldMaxXYZ.x, bounds.m_worldMinXYZ.y, bounds.m_worldMaxXYZ.z), // farBR
-			glm::vec3(bounds.m_worldMinXYZ.x, bounds.m_worldMaxXYZ.y, bounds.m_worldMinXYZ.z), // nearTL
-			glm::vec3(bounds.m_worldMinXYZ.x, bounds.m_worldMinXYZ.y, bounds.m_worldMinXYZ.z), // nearBL
-			glm::vec3(bounds.m_worldMaxXYZ.x, bounds.m_worldMaxXYZ.y, bounds.m_worldMinXYZ.z), // nearTR
-			glm::vec3(bounds.m_worldMaxXYZ.x, bounds.m_worldMinXYZ.y, bounds.m_worldMinXYZ.z), // nearBR
-		};
-		
-		static constexpr glm::vec3 k_boundsFaceAxes[3] = {
-			gr::Transform::WorldAxisX,
-			gr::Transform::WorldAxisY,
-			gr::Transform::WorldAxisZ
-		};
-		SEAssert(
-			glm::dot(glm::normalize(expandedBoundsPoints[2] - expandedBoundsPoints[0]), gr::Transform::WorldAxisX) > 0.99f &&
-			glm::dot(glm::normalize(expandedBoundsPoints[4] - expandedBoundsPoints[5]), gr::Transform::WorldAxisY) > 0.99f &&
-			glm::dot(glm::normalize(expandedBoundsPoints[0] - expandedBoundsPoints[4]), gr::Transform::WorldAxisZ) > 0.99f,
-			"Expanded bounds points are not axis aligned");
+		// GLTF specs: When the scale is 0 on all three axes, rendering can be skipped
+		gr::Transform::RenderData const& transformData = renderData.GetTransformDataFromRenderDataID(renderDataID);
 
+		return transformData.m_globalScale.x + 
+			transformData.m_globalScale.y + 
+			transformData.m_globalScale.z > 0.f;
+	}
 
-		// Separating Axis theorem: The following separating axes must be tested:
-		// 1) 6 face normals of the frustum
-		// 2) 3 face normals of the AABB Bounds (i.e. world XYZ)
-		// 3) The cross products of the edges of the frustum and Bounds
 
-		// 1) Test the frustum face normals:
-		for (uint8_t i = 0; i < frustum.m_normals.size(); ++i)
-		{
-			if (TestAxisSeparation(expandedBoundsPoints, frustum.m_corners, frustum.m_normals[i]))
-			{
-				SEEndCPUEvent(); // "TestBoundsVisibility"
-				return false;
-			}
-		}
+	// Tests the gathered MeshPrimitive bounds, and records/removes their visibility results
+	void CullMeshPrimitives(
+		grutil::BoundsSoA& meshPrimitiveBounds,
+		gr::Camera::Frustum const& frustum,
+		grutil::FrustumSlabs const& slabs,
+		std::unordered_map<gr::RenderDataID, float>& visibleMeshPrimDistancesOut)
+	{
+		meshPrimitiveBounds.Pad();
+
+		std::vector<uint8_t> meshPrimVisibility;
+		grutil::CullBounds(meshPrimitiveBounds, 0, meshPrimitiveBounds.Size(), frustum, slabs, meshPrimVisibility);
 
-		// 2) Test the bounds face normals:
-		for (glm::vec3 const& axis : k_boundsFaceAxes)
+		for (size_t primIdx = 0; primIdx < meshPrimitiveBounds.Size(); ++primIdx)
 		{
-			if (TestAxisSeparation(expandedBoundsPoints, frustum.m_corners, axis))
+			const gr::RenderDataID meshPrimID = meshPrimitiveBounds.m_renderDataIDs[primIdx];
+			if (meshPrimVisibility[primIdx])
 			{
-				SEEndCPUEvent(); // "TestBoundsVisibility"
-				return false;
+				visibleMeshPrimDistancesOut[meshPrimID] =
+					GetDistanceToBounds(meshPrimitiveBounds, primIdx, frustum.m_camPosition);
 			}
-		}
-
-		// 2) Test all edge x edge pairs:
-		for (const auto& boundsFaceAxis : k_boundsFaceAxes)
-		{
-			for (uint8_t i = 0; i < frustum.m_edgeDirections.size(); ++i)
+			else
 			{
-				glm::vec3 const& crossAxis = glm::cross(boundsFaceAxis, frustum.m_edgeDirections[i]);
-
-				if (TestAxisSeparation(expandedBoundsPoints, frustum.m_corners, crossAxis))
-				{
-					SEEndCPUEvent(); // "TestBoundsVisibility"
-					return false;
-				}
+				visibleMeshPrimDistancesOut.erase(meshPrimID);
 			}
 		}
-
-		// If we've made it this far, the object is visible
-		if (camToMeshBoundsDistOut)
-		{
-			glm::vec3 const& boundsCenter = (expandedBoundsPoints[0] + expandedBoundsPoints[6]) * 0.5f;
-			*camToMeshBoundsDistOut = glm::length(frustum.m_camPosition - boundsCenter);
-		}
-		
-		SEEndCPUEvent(); // "TestBoundsVisibility"
-		return true;
 	}
 
 
-	void CullLights(
-		gr::RenderDataManager const& renderData, 
+	void CullGeometry(
+		gr::RenderDataManager const& renderData,
+		gr::BoundsHierarchy const& meshBoundsHierarchy,
+		std::unordered_map<gr::RenderDataID, std::vector<gr::RenderDataID>> const& meshesToMeshPrimitiveBounds,
 		gr::Camera::Frustum const& frustum,
-		std::vector<gr::RenderDataID>& pointLightIDsOut,
-		std::vector<gr::RenderDataID>& spotLightIDsOut,
-		bool cullingEnabled)
+		std::unordered_set<gr::RenderDataID>& visibleMeshIDsOut,
+		std::unordered_map<gr::RenderDataID, float>& visibleMeshPrimDistancesOut)
 	{
-		SEBeginCPUEvent("CullLights");
+		SEBeginCPUEvent("CullGeometry");
 
-		SEAssert(pointLightIDsOut.empty() && spotLightIDsOut.empty(), "ID vectors are not empty");
+		SEAssert(visibleMeshIDsOut.empty() && visibleMeshPrimDistancesOut.empty(), "Visibility results are not empty");
 
-		pointLightIDsOut.reserve(renderData.GetNumElementsOfType<gr::Light::RenderDataPoint>());
-		spotLightIDsOut.reserve(renderData.GetNumElementsOfType<gr::Light::RenderDataSpot>());
+		const grutil::FrustumSlabs slabs = grutil::BuildFrustumSlabs(frustum);
 
-		auto DoCulling = [&renderData, &frustum, &cullingEnabled]<typename T>(
-			gr::LinearAdapter<T>&& lightObjects,
-			std::vector<gr::RenderDataID>& lightIDs)
-		{
-			for (auto const& lightItr : lightObjects)
+		// Hierarchical culling: Only gather the MeshPrimitive Bounds of visible Meshes
+		grutil::BoundsSoA meshPrimitiveBounds;
+		meshBoundsHierarchy.Query(
+			[&slabs](glm::vec3 const& minXYZ, glm::vec3 const& maxXYZ)
 			{
-				T const& lightRenderData = lightItr->Get<T>();
-				
-				gr::Bounds::RenderData const& lightBounds =
-					renderData.GetObjectData<gr::Bounds::RenderData>(lightRenderData.m_renderDataID);
+				return grutil::ClassifyBounds(minXYZ, maxXYZ, slabs);
+			},
+			[&](gr::RenderDataID meshID, glm::vec3 const& meshMinXYZ, glm::vec3 const& meshMaxXYZ, bool isInside)
+			{
+				if ((!isInside && !grutil::TestBoundsVisibility(meshMinXYZ, meshMaxXYZ, frustum)) ||
+					!HasNonZeroScale(renderData, meshID))
+				{
+					return;
+				}
+				visibleMeshIDsOut.emplace(meshID);
 
-				if (!cullingEnabled ||
-					(lightRenderData.m_canContribute &&
-						TestBoundsVisibility(lightBounds, frustum)))
+				for (gr::RenderDataID meshPrimID : meshesToMeshPrimitiveBounds.at(meshID))
 				{
-					lightIDs.emplace_back(lightRenderData.m_renderDataID);
+					if (HasNonZeroScale(renderData, meshPrimID))
+					{
+						gr::Bounds::RenderData const& primBounds =
+							renderData.GetObjectData<gr::Bounds::RenderData>(meshPrimID);
+
+						meshPrimitiveBounds.Add(meshPrimID, primBounds.m_worldMinXYZ, primBounds.m_worldMaxXYZ);
+					}
 				}
-			}
-		};
-		DoCulling(gr::LinearAdapter<gr::Light::RenderDataPoint>(renderData), pointLightIDsOut);
-		DoCulling(gr::LinearAdapter<gr::Light::RenderDataSpot>(renderData), spotLightIDsOut);
+			});
 
-		SEEndCPUEvent(); // "CullLights"
+		CullMeshPrimitives(meshPrimitiveBounds, frustum, slabs, visibleMeshPrimDistancesOut);
+
+		SEEndCPUEvent(); // "CullGeometry"
 	}
 
 
-	void CullGeometry(
-		gr::RenderDataManager const& renderData, 
+	// Updates a previous frame's results for an unchanged frustum. Returns the number of bounds that were retested
+	size_t UpdateCulledGeometry(
+		gr::RenderDataManager const& renderData,
 		std::unordered_map<gr::RenderDataID, std::vector<gr::RenderDataID>> const& meshesToMeshPrimitiveBounds,
+		std::unordered_map<gr::RenderDataID, gr::RenderDataID> const& meshPrimitivesToEncapsulatingMesh,
+		std::unordered_set<gr::RenderDataID> const& modifiedMeshBoundsIDs,
+		std::unordered_set<gr::RenderDataID> const& modifiedMeshPrimitiveBoundsIDs,
 		gr::Camera::Frustum const& frustum,
-		std::vector<gr::RenderDataID>& visibleIDsOut,
-		bool cullingEnabled)
+		std::unordered_set<gr::RenderDataID>& visibleMeshIDs,
+		std::unordered_map<gr::RenderDataID, float>& visibleMeshPrimDistances)
 	{
-		SEBeginCPUEvent("CullGeometry");
+		SEBeginCPUEvent("UpdateCulledGeometry");
 
-		struct IDAndDistance
-		{
-			gr::RenderDataID m_visibleID;
-			float m_distance;
-		};
-		std::vector<IDAndDistance> idsAndDistances;
-		idsAndDistances.reserve(visibleIDsOut.capacity());
+		const grutil::FrustumSlabs slabs = grutil::BuildFrustumSlabs(frustum);
 
-		for (auto const& encapsulatingBounds : meshesToMeshPrimitiveBounds)
-		{
-			const gr::RenderDataID meshID = encapsulatingBounds.first;
+		grutil::BoundsSoA meshPrimitiveBounds;
+		auto AddMeshPrimitiveBounds = [&renderData, &meshPrimitiveBounds, &visibleMeshPrimDistances](
+			gr::RenderDataID meshPrimID)
+			{
+				if (HasNonZeroScale(renderData, meshPrimID))
+				{
+					gr::Bounds::RenderData const& primBounds =
+						renderData.GetObjectData<gr::Bounds::RenderData>(meshPrimID);
 
-			// Hierarchical culling: Only test the MeshPrimitive Bounds if the Mesh Bounds is visible
-			gr::Bounds::RenderData const& meshBounds = renderData.GetObjectData<gr::Bounds::RenderData>(meshID);
-			gr::Transform::RenderData const& meshTransform = renderData.GetTransformDataFromRenderDataID(meshID);
-			
-			// GLTF specs: When the scale is 0 on all three axes, rendering can be skipped
-			const bool meshScaleNonZero = 
-				meshTransform.m_globalScale.x + 
-				meshTransform.m_globalScale.y + 
-				meshTransform.m_globalScale.z > 0.f;
+					meshPrimitiveBounds.Add(meshPrimID, primBounds.m_worldMinXYZ, primBounds.m_worldMaxXYZ);
+				}
+				else
+				{
+					visibleMeshPrimDistances.erase(meshPrimID);
+				}
+			};
 
-			float camToMeshBoundsDist = 0.f;
+		// Modified Meshes: Retest the Mesh, and all of its MeshPrimitives
+		for (gr::RenderDataID meshID : modifiedMeshBoundsIDs)
+		{
+			gr::Bounds::RenderData const& meshBounds = renderData.GetObjectData<gr::Bounds::RenderData>(meshID);
 
-			const bool meshIsVisible = meshScaleNonZero &&
-				TestBoundsVisibility(meshBounds, frustum, &camToMeshBoundsDist);
+			std::vector<gr::RenderDataID> const& meshPrimIDs = meshesToMeshPrimitiveBounds.at(meshID);
 
-			if (meshIsVisible || !cullingEnabled)
+			if (HasNonZeroScale(renderData, meshID) &&
+				grutil::IsBoundsVisible(meshBounds.m_worldMinXYZ, meshBounds.m_worldMaxXYZ, frustum, slabs))
 			{
-				std::vector<gr::RenderDataID> const& meshPrimitiveIDs = encapsulatingBounds.second;
-				for (auto const& meshPrimID : meshPrimitiveIDs)
-				{
-					gr::Bounds::RenderData const& primBounds = 
-						renderData.GetObjectData<gr::Bounds::RenderData>(meshPrimID);
-					gr::Transform::RenderData const& meshPrimTransform = 
-						renderData.GetTransformDataFromRenderDataID(meshPrimID);
+				visibleMeshIDs.emplace(meshID);
 
-					// GLTF specs: When the scale is 0 on all three axes, rendering can be skipped
-					const bool meshPrimScaleNonZero = 
-						meshPrimTransform.m_globalScale.x +
-						meshPrimTransform.m_globalScale.y +
-						meshPrimTransform.m_globalScale.z > 0.f;
+				for (gr::RenderDataID meshPrimID : meshPrimIDs)
+				{
+					AddMeshPrimitiveBounds(meshPrimID);
+				}
+			}
+			else
+			{
+				visibleMeshIDs.erase(meshID);
 
-					float camToMeshPrimBoundsDist = 0.f;
+				for (gr::RenderDataID meshPrimID : meshPrimIDs)
+				{
+					visibleMeshPrimDistances.erase(meshPrimID);
+				}
+			}
+		}
+		const size_t numMeshesRetested = modifiedMeshBoundsIDs.size();
 
-					const bool meshPrimIsVisible = meshPrimScaleNonZero &&
-						TestBoundsVisibility(primBounds, frustum, &camToMeshPrimBoundsDist);
+		// Modified MeshPrimitives: Only retest them if their Mesh is (still) visible
+		for (gr::RenderDataID meshPrimID : modifiedMeshPrimitiveBoundsIDs)
+		{
+			const gr::RenderDataID meshID = meshPrimitivesToEncapsulatingMesh.at(meshPrimID);
+			if (modifiedMeshBoundsIDs.contains(meshID))
+			{
+				continue; // Already handled
+			}
 
-					if (meshPrimIsVisible || !cullingEnabled)
-					{
-						idsAndDistances.emplace_back(IDAndDistance{
-							.m_visibleID = meshPrimID,
-							.m_distance = camToMeshPrimBoundsDist
-							});
-					}
-				}
+			if (visibleMeshIDs.contains(meshID))
+			{
+				AddMeshPrimitiveBounds(meshPrimID);
+			}
+			else
+			{
+				visibleMeshPrimDistances.erase(meshPrimID);
 			}
 		}
 
-		// Sort our IDs so they're ordered closest to the camera, to furthest away
+		CullMeshPrimitives(meshPrimitiveBounds, frustum, slabs, visibleMeshPrimDistances);
+
+		SEEndCPUEvent(); // "UpdateCulledGeometry"
+
+		return numMeshesRetested + meshPrimitiveBounds.Size();
+	}
+
+
+	// Sort our IDs so they're ordered closest to the camera, to furthest away
+	void SortVisibleIDs(
+		std::unordered_map<gr::RenderDataID, float> const& visibleMeshPrimDistances,
+		std::vector<gr::RenderDataID>& sortedVisibleIDsOut)
+	{
+		std::vector<std::pair<gr::RenderDataID, float>> idsAndDistances(
+			visibleMeshPrimDistances.begin(), visibleMeshPrimDistances.end());
+
 		std::sort(idsAndDistances.begin(), idsAndDistances.end(), 
-			[](IDAndDistance const& a, IDAndDistance const& b)
+			[](std::pair<gr::RenderDataID, float> const& a, std::pair<gr::RenderDataID, float> const& b)
 			{
-				return a.m_distance < b.m_distance;
+				return a.second < b.second;
 			});
 
-		// Finally, copy our sorted results into the outgoing vector:
-		for (IDAndDistance const& idAndDist : idsAndDistances)
+		sortedVisibleIDsOut.clear();
+		sortedVisibleIDsOut.reserve(idsAndDistances.size());
+		for (auto const& idAndDist : idsAndDistances)
 		{
-			visibleIDsOut.emplace_back(idAndDist.m_visibleID);			
+			sortedVisibleIDsOut.emplace_back(idAndDist.first);
 		}
+	}
 
-		SEEndCPUEvent(); // "CullGeometry"
+
+	void GetAllMeshPrimitiveIDs(
+		std::unordered_map<gr::RenderDataID, std::vector<gr::RenderDataID>> const& meshesToMeshPrimitiveBounds,
+		std::vector<gr::RenderDataID>& meshPrimitiveIDsOut)
+	{
+		for (auto const& encapsulatingBounds : meshesToMeshPrimitiveBounds)
+		{
+			meshPrimitiveIDsOut.insert(
+				meshPrimitiveIDsOut.end(), encapsulatingBounds.second.begin(), encapsulatingBounds.second.end());
+		}
 	}
 }
 
@@ -271,6 +306,9 @@ namespace gr
 	CullingGraphicsSystem::CullingGraphicsSystem(gr::GraphicsSystemManager* owningGSM)
 		: GraphicsSystem(GetScriptName(), owningGSM)
 		, INamedObject(GetScriptName())
+		, m_numViewCacheHits(0)
+		, m_numViewCacheMisses(0)
+		, m_numBoundsRetested(0)
 		, m_cullingServiceData{}
 	{
 		core::SystemLocator::Register<gr::CullingGraphicsSystem>(ACCESS_KEY(AccessKey), this);
@@ -303,6 +341,14 @@ namespace gr
 		SEBeginCPUEvent("CullingGraphicsSystem::PreRender");
 
 		gr::RenderDataManager const& renderData = m_graphicsSystemManager->GetRenderData();
+
+		auto AddMeshBounds = [this, &renderData](gr::RenderDataID meshBoundsID)
+			{
+				m_meshesToMeshPrimitiveBounds.emplace(meshBoundsID, std::vector<gr::RenderDataID>());
+
+				gr::Bounds::RenderData const& meshBounds = renderData.GetObjectData<gr::Bounds::RenderData>(meshBoundsID);
+				m_meshBoundsHierarchy.Add(meshBoundsID, meshBounds.m_worldMinXYZ, meshBounds.m_worldMaxXYZ);
+			};
 		
 		SEBeginCPUEvent("Add new Bounds");
 		if (renderData.HasIDsWithNewData<gr::Bounds::RenderData>())
@@ -321,7 +367,7 @@ namespace gr
 				if (encapsulatingBounds != k_invalidRenderDataID &&
 					!m_meshesToMeshPrimitiveBounds.contains(encapsulatingBounds))
 				{
-					m_meshesToMeshPrimitiveBounds.emplace(encapsulatingBounds, std::vector<gr::RenderDataID>());
+					AddMeshBounds(encapsulatingBounds);
 				}
 				else if (gr::HasFeature(gr::RenderObjectFeature::IsMeshBounds, renderData.GetFeatureBits(newBoundsID)) &&
 					!m_meshesToMeshPrimitiveBounds.contains(newBoundsID))
@@ -329,7 +375,7 @@ namespace gr
 					SEAssert(encapsulatingBounds == gr::k_invalidRenderDataID,
 						"Mesh Bounds should not have an encapsulating bounds");
 
-					m_meshesToMeshPrimitiveBounds.emplace(newBoundsID, std::vector<gr::RenderDataID>());
+					AddMeshBounds(newBoundsID);
 				}
 
 				if (gr::HasFeature(
@@ -346,6 +392,12 @@ namespace gr
 					// Map the MeshPrimitive back to its encapsulating Mesh:
 					m_meshPrimitivesToEncapsulatingMesh.emplace(newBoundsID, boundsData.m_encapsulatingBounds);
 				}
+
+				if (gr::HasFeature(gr::RenderObjectFeature::IsLightBounds, renderData.GetFeatureBits(newBoundsID)) &&
+					!m_lightBoundsHierarchy.Contains(newBoundsID))
+				{
+					m_lightBoundsHierarchy.Add(newBoundsID, boundsData.m_worldMinXYZ, boundsData.m_worldMaxXYZ);
+				}
 			}
 		}		
 		SEEndCPUEvent(); // "Add new Bounds"
@@ -366,6 +418,7 @@ namespace gr
 						" with delete commands");
 
 					m_meshesToMeshPrimitiveBounds.erase(deletedBoundsID);
+					m_meshBoundsHierarchy.Remove(deletedBoundsID);
 				}
 				else if (m_meshPrimitivesToEncapsulatingMesh.contains(deletedBoundsID)) // Deleted MeshPrimitive bounds
 				{
@@ -376,11 +429,90 @@ namespace gr
 						deletedBoundsID);
 
 					m_meshesToMeshPrimitiveBounds[encapsulatingBoundsID].erase(primitiveIDItr);
+					m_meshPrimitivesToEncapsulatingMesh.erase(deletedBoundsID);
+				}
+				else if (m_lightBoundsHierarchy.Contains(deletedBoundsID)) // Deleted light bounds
+				{
+					m_lightBoundsHierarchy.Remove(deletedBoundsID);
+				}
+
+				// Remove the deleted bounds from any cached results:
+				for (auto& viewCache : m_viewCullingCaches)
+				{
+					viewCache.second.m_visibleMeshIDs.erase(deletedBoundsID);
+					viewCache.second.m_visibleMeshPrimitiveDistances.erase(deletedBoundsID);
 				}
 			}
 		}
 		SEEndCPUEvent(); // "Remove deleted Bounds"
 
+		// Refit any modified Mesh and light bounds:
+		SEBeginCPUEvent("Update Bounds hierarchies");
+		std::vector<gr::RenderDataID> const* dirtyBoundsIDs = renderData.GetIDsWithDirtyData<gr::Bounds::RenderData>();
+		if (dirtyBoundsIDs)
+		{
+			for (gr::RenderDataID dirtyBoundsID : *dirtyBoundsIDs)
+			{
+				gr::BoundsHierarchy* boundsHierarchy = nullptr;
+				if (m_meshBoundsHierarchy.Contains(dirtyBoundsID))
+				{
+					boundsHierarchy = &m_meshBoundsHierarchy;
+				}
+				else if (m_lightBoundsHierarchy.Contains(dirtyBoundsID))
+				{
+					boundsHierarchy = &m_lightBoundsHierarchy;
+				}
+
+				if (boundsHierarchy)
+				{
+					gr::Bounds::RenderData const& dirtyBounds = 
+						renderData.GetObjectData<gr::Bounds::RenderData>(dirtyBoundsID);
+
+					boundsHierarchy->Update(dirtyBoundsID, dirtyBounds.m_worldMinXYZ, dirtyBounds.m_worldMaxXYZ);
+				}
+			}
+		}
+		SEEndCPUEvent(); // "Update Bounds hierarchies"
+
+		// Record the bounds that must be retested by incrementally-culled views:
+		SEBeginCPUEvent("Gather modified Bounds");
+		const bool incrementalCullingEnabled = 
+			m_cullingServiceData.m_cullingEnabled && m_cullingServiceData.m_incrementalCullingEnabled;
+
+		m_modifiedMeshBoundsIDs.clear();
+		m_modifiedMeshPrimitiveBoundsIDs.clear();
+		if (incrementalCullingEnabled)
+		{
+			auto RecordModifiedBounds = [this](std::vector<gr::RenderDataID> const* boundsIDs)
+				{
+					if (boundsIDs)
+					{
+						for (gr::RenderDataID boundsID : *boundsIDs)
+						{
+							if (m_meshesToMeshPrimitiveBounds.contains(boundsID))
+							{
+								m_modifiedMeshBoundsIDs.emplace(boundsID);
+							}
+							else if (m_meshPrimitivesToEncapsulatingMesh.contains(boundsID))
+							{
+								m_modifiedMeshPrimitiveBoundsIDs.emplace(boundsID);
+							}
+						}
+					}
+				};
+			RecordModifiedBounds(renderData.GetIDsWithNewData<gr::Bounds::RenderData>());
+			RecordModifiedBounds(dirtyBoundsIDs);
+		}
+		else
+		{
+			m_viewCullingCaches.clear(); // Cached results will be stale if incremental culling is re-enabled
+		}
+
+		const bool hasModifiedBounds = !m_modifiedMeshBoundsIDs.empty() || 
+			!m_modifiedMeshPrimitiveBoundsIDs.empty() ||
+			renderData.HasIDsWithDeletedData<gr::Bounds::RenderData>();
+		SEEndCPUEvent(); // "Gather modified Bounds"
+
 		// Erase any cached frustums for deleted cameras:
 		SEBeginCPUEvent("Erase cached frustums");
 		std::vector<gr::RenderDataID> const* deletedCamIDs = renderData.GetIDsWithDeletedData<gr::Camera::RenderData>();
@@ -397,6 +529,7 @@ namespace gr
 						break;
 					}
 					m_cachedFrustums.erase(deletedView);
+					m_viewCullingCaches.erase(deletedView);
 				}
 			}
 		}
@@ -415,8 +548,7 @@ namespace gr
 		
 		if (renderData.HasObjectData<gr::Camera::RenderData>())
 		{
-			util::ThreadSafeVector<std::future<void>> cullingFutures;
-			cullingFutures.reserve(renderData.GetNumElementsOfType<gr::Camera::RenderData>());
+			core::JobCounter cullingJobCounter;
 
 			const size_t numMeshPrimitives = m_meshPrimitivesToEncapsulatingMesh.size();
 
@@ -483,6 +615,16 @@ namespace gr
 						}
 					}
 
+					// We won't see any modifications while we're skipped: Our cached results must be rebuilt
+					{
+						std::lock_guard<std::mutex> lock(m_viewCullingCachesMutex);
+
+						for (uint8_t faceIdx = 0; faceIdx < numViews; faceIdx++)
+						{
+							m_viewCullingCaches.erase(gr::Camera::View(cameraID, faceIdx));
+						}
+					}
+
 					continue;
 				}
 
@@ -492,9 +634,9 @@ namespace gr
 				const bool cameraIsDirty = cameraItr->IsDirty<gr::Camera::RenderData>();
 
 				// Enqueue the culling job:
-				cullingFutures.emplace_back(core::ThreadPool::EnqueueJob(
+				core::ThreadPool::EnqueueJob(
 					[cameraID, camData, cameraIsDirty, camTransformData, numMeshPrimitives, activeCamRenderDataID,
-					this, &renderData]()
+					incrementalCullingEnabled, hasModifiedBounds, this, &renderData]()
 					{
 						SEBeginCPUEvent("Culling camera %d", cameraID);
 
@@ -586,12 +728,77 @@ namespace gr
 							renderIDsOut.reserve(numMeshPrimitives);
 
 							// Cull our views and populate the set of visible IDs:
-							CullGeometry(
-								renderData,
-								m_meshesToMeshPrimitiveBounds,
-								currentFrustum,
-								renderIDsOut,
-								m_cullingServiceData.m_cullingEnabled);
+							if (!m_cullingServiceData.m_cullingEnabled)
+							{
+								GetAllMeshPrimitiveIDs(m_meshesToMeshPrimitiveBounds, renderIDsOut);
+							}
+							else if (!incrementalCullingEnabled)
+							{
+								ViewCullingCache viewResults;
+								CullGeometry(
+									renderData,
+									m_meshBoundsHierarchy,
+									m_meshesToMeshPrimitiveBounds,
+									currentFrustum,
+									viewResults.m_visibleMeshIDs,
+									viewResults.m_visibleMeshPrimitiveDistances);
+
+								SortVisibleIDs(viewResults.m_visibleMeshPrimitiveDistances, renderIDsOut);
+							}
+							else
+							{
+								// Note: Elements of an unordered_map are not invalidated by insertions
+								ViewCullingCache* viewCache = nullptr;
+								bool isCacheHit = false;
+								{
+									std::lock_guard<std::mutex> lock(m_viewCullingCachesMutex);
+
+									auto const& [viewCacheItr, didInsert] = m_viewCullingCaches.try_emplace(currentView);
+									viewCache = &viewCacheItr->second;
+									isCacheHit = !didInsert && !cameraIsDirty;
+								}
+
+								if (isCacheHit)
+								{
+									m_numViewCacheHits.fetch_add(1, std::memory_order_relaxed);
+
+									if (hasModifiedBounds)
+									{
+										const size_t numRetested = UpdateCulledGeometry(
+											renderData,
+											m_meshesToMeshPrimitiveBounds,
+											m_meshPrimitivesToEncapsulatingMesh,
+											m_modifiedMeshBoundsIDs,
+											m_modifiedMeshPrimitiveBoundsIDs,
+											currentFrustum,
+											viewCache->m_visibleMeshIDs,
+											viewCache->m_visibleMeshPrimitiveDistances);
+
+										m_numBoundsRetested.fetch_add(numRetested, std::memory_order_relaxed);
+
+										SortVisibleIDs(viewCache->m_visibleMeshPrimitiveDistances, viewCache->m_sortedVisibleIDs);
+									}
+								}
+								else
+								{
+									m_numViewCacheMisses.fetch_add(1, std::memory_order_relaxed);
+
+									viewCache->m_visibleMeshIDs.clear();
+									viewCache->m_visibleMeshPrimitiveDistances.clear();
+
+									CullGeometry(
+										renderData,
+										m_meshBoundsHierarchy,
+										m_meshesToMeshPrimitiveBounds,
+										currentFrustum,
+										viewCache->m_visibleMeshIDs,
+										viewCache->m_visibleMeshPrimitiveDistances);
+
+									SortVisibleIDs(viewCache->m_visibleMeshPrimitiveDistances, viewCache->m_sortedVisibleIDs);
+								}
+
+								renderIDsOut = viewCache->m_sortedVisibleIDs;
+							}
 
 							// Finally, cache the results:
 							{
@@ -627,6 +834,7 @@ namespace gr
 
 								CullLights(
 									renderData,
+									m_lightBoundsHierarchy,
 									lightFrustum,
 									m_visiblePointLightIDs,
 									m_visibleSpotLightIDs,
@@ -637,17 +845,25 @@ namespace gr
 						}
 
 						SEEndCPUEvent(); // "Culling camera{RenderDataID}"						
-					}));
+					},
+					cullingJobCounter);
 			}
 
 			// Wait for our jobs to complete
-			for (size_t cullingFutureIdx = 0; cullingFutureIdx < cullingFutures.size(); cullingFutureIdx++)
-			{
-				cullingFutures[cullingFutureIdx].wait();
-			}
+			core::ThreadPool::WaitForCounter(cullingJobCounter);
 		}
 		SEEndCPUEvent(); // "Do culling"
 
+		// Record our incremental culling statistics:
+		m_frameCullingStatistics = CullingStatistics{
+			.m_numViewCacheHits = m_numViewCacheHits.exchange(0),
+			.m_numViewCacheMisses = m_numViewCacheMisses.exchange(0),
+			.m_numBoundsRetested = m_numBoundsRetested.exchange(0),
+		};
+		m_totalCullingStatistics.m_numViewCacheHits += m_frameCullingStatistics.m_numViewCacheHits;
+		m_totalCullingStatistics.m_numViewCacheMisses += m_frameCullingStatistics.m_numViewCacheMisses;
+		m_totalCullingStatistics.m_numBoundsRetested += m_frameCullingStatistics.m_numBoundsRetested;
+
 
 		// Debug mode: View another camera's culling results in the active camera's view
 		if (m_cullingServiceData.m_debugCameraOverrideID != gr::k_invalidRenderDataID)
@@ -740,6 +956,36 @@ namespace gr
 			}
 		}
 
+		if (ImGui::CollapsingHeader("Incremental culling"))
+		{
+			auto ShowStatistics = [](char const* label, CullingStatistics const& stats)
+				{
+					const uint64_t numViews = stats.m_numViewCacheHits + stats.m_numViewCacheMisses;
+					ImGui::Text(std::format("{}: View cache hits: {}, misses: {} ({:.1f}% hit rate), bounds retested: {}",
+						label,
+						stats.m_numViewCacheHits,
+						stats.m_numViewCacheMisses,
+						numViews > 0 ? 100.0 * stats.m_numViewCacheHits / numViews : 0.0,
+						stats.m_numBoundsRetested).c_str());
+				};
+			ShowStatistics("Frame", m_frameCullingStatistics);
+			ShowStatistics("Total", m_totalCullingStatistics);
+		}
+
+		if (ImGui::CollapsingHeader("Bounds hierarchies"))
+		{
+			auto ShowHierarchy = [](char const* label, gr::BoundsHierarchy const& boundsHierarchy)
+				{
+					ImGui::Text(std::format("{}: Leaves: {}, nodes: {}, height: {}",
+						label,
+						boundsHierarchy.GetNumLeaves(),
+						boundsHierarchy.GetNumNodes(),
+						boundsHierarchy.GetHeight()).c_str());
+				};
+			ShowHierarchy("Mesh bounds", m_meshBoundsHierarchy);
+			ShowHierarchy("Light bounds", m_lightBoundsHierarchy);
+		}
+
 		if (ImGui::CollapsingHeader("Bounds RenderDataID tracking"))
 		{
 			constexpr ImGuiTableFlags flags = 
@@ -826,6 +1072,12 @@ namespace gr
 	}
 
 
+	void CullingGraphicsSystem::EnableIncrementalCulling(AccessKey, bool isEnabled)
+	{
+		m_cullingServiceData.m_incrementalCullingEnabled = isEnabled;
+	}
+
+
 	void CullingGraphicsSystem::SetDebugCameraOverride(AccessKey, gr::RenderDataID debugCameraOverrideID)
 	{
 		m_cullingServiceData.m_debugCameraOverrideID = debugCameraOverrideID;
@@ -1,5 +1,6 @@
 //  2023 Adam Badke. All rights reserved.
 #pragma once
+#include "BoundsHierarchy.h"
 #include "CameraRenderData.h"
 #include "GraphicsSystem.h"
 #include "RenderObjectIDs.h"
@@ -17,6 +18,7 @@ namespace gr
 	{
 		gr::RenderDataID m_debugCameraOverrideID = gr::k_invalidRenderDataID;
 		bool m_cullingEnabled = true;
+		bool m_incrementalCullingEnabled = true; // Reuse results for unchanged views, only retest modified bounds
 	};
 
 
@@ -62,7 +64,12 @@ namespace gr
 		std::unordered_map<gr::RenderDataID, std::vector<gr::RenderDataID>> m_meshesToMeshPrimitiveBounds;
 		std::unordered_map<gr::RenderDataID, gr::RenderDataID> m_meshPrimitivesToEncapsulatingMesh;
 
-	private:
+		// Spatial index of the encapsulating Mesh bounds (i.e. the keys of m_meshesToMeshPrimitiveBounds)
+		gr::BoundsHierarchy m_meshBoundsHierarchy;
+
+		// Spatial index of the point/spot light bounds, culled against the active camera
+		gr::BoundsHierarchy m_lightBoundsHierarchy;
+
 		// Cached frustum planes; (Re)computed when a camera is added/dirtied
 		std::unordered_map<gr::Camera::View const, gr::Camera::Frustum> m_cachedFrustums;
 		std::mutex m_cachedFrustumsMutex;
@@ -76,11 +83,46 @@ namespace gr
 		std::vector<gr::RenderDataID> m_visibleSpotLightIDs;
 		std::mutex m_visibleLightsMutex;
 
+	private:
+		// Incremental culling: The previous frame's results for each view. If a view's frustum is unchanged, only the
+		// bounds that were added/modified this frame are retested
+		struct ViewCullingCache
+		{
+			std::unordered_set<gr::RenderDataID> m_visibleMeshIDs;
+			std::unordered_map<gr::RenderDataID, float> m_visibleMeshPrimitiveDistances; // Distance to the camera
+			std::vector<gr::RenderDataID> m_sortedVisibleIDs; // Nearest to furthest
+		};
+		std::unordered_map<gr::Camera::View const, ViewCullingCache> m_viewCullingCaches;
+		std::mutex m_viewCullingCachesMutex;
+
+		// Bounds added/modified this frame. Populated before the culling jobs are launched
+		std::unordered_set<gr::RenderDataID> m_modifiedMeshBoundsIDs;
+		std::unordered_set<gr::RenderDataID> m_modifiedMeshPrimitiveBoundsIDs;
+
+	public:
+		struct CullingStatistics
+		{
+			uint64_t m_numViewCacheHits = 0; // Views updated incrementally
+			uint64_t m_numViewCacheMisses = 0; // Views that were fully culled
+			uint64_t m_numBoundsRetested = 0; // Bounds retested during incremental updates
+		};
+		CullingStatistics const& GetFrameCullingStatistics() const; // Most recent frame
+		CullingStatistics const& GetTotalCullingStatistics() const; // Accumulated since creation
+
+	private:
+		std::atomic<uint64_t> m_numViewCacheHits;
+		std::atomic<uint64_t> m_numViewCacheMisses;
+		std::atomic<uint64_t> m_numBoundsRetested;
+
+		CullingStatistics m_frameCullingStatistics;
+		CullingStatistics m_totalCullingStatistics;
+
 
 	public: // Culling service interface:
 		using AccessKey = accesscontrol::AccessKey<CullingGraphicsSystem, pr::CullingGraphicsService>;
 
 		void EnableCulling(AccessKey, bool isEnabled);
+		void EnableIncrementalCulling(AccessKey, bool isEnabled);
 
 		// Enable culling debug override for a specific camera, rendered via the currently active camera.
 		// Disable by passing gr::k_invalidRenderDataID				
@@ -90,4 +132,16 @@ namespace gr
 	private:
 		CullingServiceData m_cullingServiceData;
 	};
+
+
+	inline CullingGraphicsSystem::CullingStatistics const& CullingGraphicsSystem::GetFrameCullingStatistics() const
+	{
+		return m_frameCullingStatistics;
+	}
+
+
+	inline CullingGraphicsSystem::CullingStatistics const& CullingGraphicsSystem::GetTotalCullingStatistics() const
+	{
+		return m_totalCullingStatistics;
+	}
 }
\ No newline at end of file
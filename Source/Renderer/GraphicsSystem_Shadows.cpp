@@ -337,10 +337,10 @@ namespace gr
 		gr::RenderDataManager const& renderData = m_graphicsSystemManager->GetRenderData();
 
 		// Update dirty shadow buffer data:
-		std::vector<gr::RenderDataID> const& dirtyShadows = 
-			renderData.GetIDsWithAnyDirtyData<gr::ShadowMap::RenderData, gr::Camera::RenderData, gr::Transform::RenderData>();
+		renderData.GetIDsWithAnyDirtyData<gr::ShadowMap::RenderData, gr::Camera::RenderData, gr::Transform::RenderData>(
+			m_dirtyShadowIDs);
 
-		for (auto const& itr : gr::IDAdapter(renderData, dirtyShadows))
+		for (auto const& itr : gr::IDAdapter(renderData, m_dirtyShadowIDs))
 		{
 			SEAssert((itr->HasObjectData<gr::Camera::RenderData>() &&
 				itr->HasObjectData<gr::ShadowMap::RenderData>()),
@@ -140,6 +140,8 @@ namespace gr
 		std::unordered_map<gr::RenderDataID, gr::ShadowRecord> m_lightIDToShadowRecords;
 		std::shared_ptr<re::Buffer> m_poissonSampleParamsBuffer;
 
+		std::vector<gr::RenderDataID> m_dirtyShadowIDs; // Reused each frame to avoid per-frame allocations
+
 	private:
 		// Get the logical array index (i.e. i * 6 = index of 2DArray face for a cubemap)
 		uint32_t GetShadowArrayIndex(ShadowTextureMetadata const&, gr::RenderDataID) const;
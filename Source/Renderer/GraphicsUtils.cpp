@@ -143,74 +143,57 @@ namespace grutil
 		weightedRowLuminances.resize(texParams.m_height, 0.0);
 		std::atomic<double> totalWeightedRowLuminance = 0.0;
 
-		// Process rows in parallel tasks:
-		std::vector<std::future<void>> rowTasks;
-		rowTasks.reserve(texParams.m_height);
-
-		constexpr uint32_t k_numRowsPerTask = 128;
-
-		uint32_t taskBaseRow = 0;
-		while (taskBaseRow < texParams.m_height)
-		{
-			rowTasks.emplace_back(core::ThreadPool::EnqueueJob(
-				[&texParams, &data, &totalWeightedRowLuminance, &Compute1DTableData, taskBaseRow, k_numRowsPerTask,
-				&weightedRowLuminances, &aliasTableData]() mutable
-				{
-					// Column conditional alias tables: We reuse this per row to minimize the working memory required
-					std::vector<double> weightedColLuminances;
-					weightedColLuminances.resize(texParams.m_width);
+		// Process chunks of rows in parallel:
+		core::ThreadPool::ParallelForRange(0, texParams.m_height,
+			[&texParams, &data, &totalWeightedRowLuminance, &Compute1DTableData, &weightedRowLuminances,
+			&aliasTableData](size_t firstRow, size_t lastRow)
+			{
+				// Column conditional alias tables: We reuse this per row to minimize the working memory required
+				std::vector<double> weightedColLuminances;
+				weightedColLuminances.resize(texParams.m_width);
 
-					double localTotalWeightedRowLuminance = 0.0; // Local sum to minimize atomic contention
+				double localTotalWeightedRowLuminance = 0.0; // Local sum to minimize atomic contention
 
-					for (uint32_t row = taskBaseRow; (row < taskBaseRow + k_numRowsPerTask && row < texParams.m_height); row++)
-					{
-						// Compute the pixel center to polar angle:
-						const double theta = ((row + 0.5) * glm::pi<double>()) / texParams.m_height;
-						const double rowSinTheta = glm::sin(theta); // We weight by sin(theta) to account for lat/long distortion
-
-						const uint32_t rowStartIndex = row * texParams.m_width;
+				for (uint32_t row = util::CheckedCast<uint32_t>(firstRow); row < lastRow; row++)
+				{
+					// Compute the pixel center to polar angle:
+					const double theta = ((row + 0.5) * glm::pi<double>()) / texParams.m_height;
+					const double rowSinTheta = glm::sin(theta); // We weight by sin(theta) to account for lat/long distortion
 
-						double currentRowLuminance = 0.0;
-						for (uint32_t col = 0; col < texParams.m_width; col++)
-						{
-							const uint32_t dataIndex = rowStartIndex + col;
+					const uint32_t rowStartIndex = row * texParams.m_width;
 
-							// Compute the weighted texel luminance:
-							glm::vec4 const& texel = data[dataIndex];
-							const float luminance = LinearToLuminance(texel.rgb);
-							const double weightedLuminance = luminance * rowSinTheta;
+					double currentRowLuminance = 0.0;
+					for (uint32_t col = 0; col < texParams.m_width; col++)
+					{
+						const uint32_t dataIndex = rowStartIndex + col;
 
-							// Record the weighted luminance:
-							currentRowLuminance += weightedLuminance;
-							localTotalWeightedRowLuminance += weightedLuminance;
+						// Compute the weighted texel luminance:
+						glm::vec4 const& texel = data[dataIndex];
+						const float luminance = LinearToLuminance(texel.rgb);
+						const double weightedLuminance = luminance * rowSinTheta;
 
-							weightedColLuminances[col] = weightedLuminance;
-						}
+						// Record the weighted luminance:
+						currentRowLuminance += weightedLuminance;
+						localTotalWeightedRowLuminance += weightedLuminance;
 
-						// Record the row's total weighted luminance once, to minimize cache thrashing:
-						weightedRowLuminances[row] = currentRowLuminance;
+						weightedColLuminances[col] = weightedLuminance;
+					}
 
-						// We've populated the column data, now compute the alias table for the row's columns:
-						const size_t baseIdx = static_cast<size_t>(row) * texParams.m_width;
+					// Record the row's total weighted luminance once, to minimize cache thrashing:
+					weightedRowLuminances[row] = currentRowLuminance;
 
-						Compute1DTableData(
-							weightedRowLuminances[row],
-							weightedColLuminances,
-							std::span{ aliasTableData->m_columnData }.subspan(baseIdx, texParams.m_width));
-					}
+					// We've populated the column data, now compute the alias table for the row's columns:
+					const size_t baseIdx = static_cast<size_t>(row) * texParams.m_width;
 
-					// Update the atomic total once, now that we're done:
-					totalWeightedRowLuminance.fetch_add(localTotalWeightedRowLuminance, std::memory_order_relaxed);
+					Compute1DTableData(
+						weightedRowLuminances[row],
+						weightedColLuminances,
+						std::span{ aliasTableData->m_columnData }.subspan(baseIdx, texParams.m_width));
 				}
-			));
-			taskBaseRow += k_numRowsPerTask;
-		}
-
-		// Wait for all tasks to complete:
-		for (std::future<void>& task : rowTasks)
-		{
-			task.wait();
-		}
+
+				// Update the atomic total once, now that we're done:
+				totalWeightedRowLuminance.fetch_add(localTotalWeightedRowLuminance, std::memory_order_relaxed);
+			});
 
 		// Finally, compute the row marginal alias table:
 		Compute1DTableData(
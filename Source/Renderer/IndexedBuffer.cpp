@@ -90,6 +90,19 @@ namespace gr
 	{
 		ImGui::Text(std::format("Managing {} indexed buffers:", m_indexedBuffers.size()).c_str());
 
+		UploadStats totalStats;
+		for (auto const& indexedBuffer : m_indexedBuffers)
+		{
+			UploadStats const& bufferStats = indexedBuffer->GetUploadStats();
+			totalStats.m_numBytesUploaded += bufferStats.m_numBytesUploaded;
+			totalStats.m_bufferByteSize += bufferStats.m_bufferByteSize;
+			totalStats.m_numUploadRanges += bufferStats.m_numUploadRanges;
+		}
+		ImGui::Text(std::format("Uploaded {} of {} total bytes this frame, in {} commit(s)",
+			totalStats.m_numBytesUploaded,
+			totalStats.m_bufferByteSize,
+			totalStats.m_numUploadRanges).c_str());
+
 		for (auto const& indexedBuffer : m_indexedBuffers)
 		{
 			indexedBuffer->ShowImGuiWindow();
@@ -1,6 +1,7 @@
 //  2025 Adam Badke.All rights reserved.
 #pragma once
 #include "Buffer.h"
+#include "IndexedBufferData.h"
 #include "RenderDataManager.h"
 #include "RenderObjectIDs.h"
 #include "TransformRenderData.h"
@@ -25,6 +26,13 @@ namespace gr
 	public:
 		typedef uint32_t IndexType;
 
+		struct UploadStats // Reset each frame
+		{
+			uint64_t m_numBytesUploaded = 0;
+			uint64_t m_bufferByteSize = 0; // Total size of the managed Buffer
+			uint32_t m_numUploadRanges = 0; // Number of partial commits staged
+		};
+
 
 	public:
 		class IIndexedBuffer
@@ -58,6 +66,7 @@ namespace gr
 			virtual void Destroy() = 0;
 			virtual bool UpdateBuffer(gr::RenderDataManager const&) = 0; // Returns true if Buffer was reallocated
 			virtual std::shared_ptr<re::Buffer> GetBuffer() const = 0;
+			virtual UploadStats const& GetUploadStats() const = 0;
 
 			// Get a BufferInput for the entire managed array buffer:
 			virtual re::BufferInput GetBufferInput(char const* shaderName) const = 0;
@@ -145,6 +154,7 @@ namespace gr
 		public:
 			bool UpdateBuffer(gr::RenderDataManager const&) override;
 			std::shared_ptr<re::Buffer> GetBuffer() const override;
+			UploadStats const& GetUploadStats() const override;
 
 			// Get a BufferInput for the entire managed array buffer:
 			re::BufferInput GetBufferInput(char const* shaderName) const override;
@@ -160,12 +170,15 @@ namespace gr
 		private:
 			IndexType GetIndex(gr::RenderDataManager const&, IDType) const override;
 
+			void CommitRange(IndexType baseIdx, IndexType numElements);
+
 
 		private:
-			std::unordered_map<IDType, IndexType> m_idToBufferIdx;
+			// CPU-side copy of the Buffer data. Elements are kept densely packed, so dirty elements can be coalesced
+			// into a few contiguous commits
+			gr::IndexedBufferData<BufferDataType> m_bufferData;
 
-			// We use a priority queue to ensure that indexes closest to 0 are reused first, to keep packing as tight
-			std::priority_queue<IndexType, std::vector<IndexType>, std::greater<IndexType>> m_freeIndexes;
+			UploadStats m_uploadStats;
 
 			std::string m_bufferName; // Note: Used for ID/lookup - Is not the shader name
 			std::shared_ptr<re::Buffer> m_buffer;
@@ -180,13 +193,12 @@ namespace gr
 
 			RenderObjectFeature m_featureBits;
 
+			std::vector<gr::RenderDataID> m_dirtyIDs; // Reused each update to avoid per-frame allocations
+
 			// Buffer create params:
 			re::Buffer::MemoryPoolPreference m_memPoolPreference;
 			re::Buffer::Access m_accessMask;
 
-			static constexpr uint32_t k_arraySizeAlignment = 16; // Buffer sizes are rounded up to nearest multiple
-			static constexpr float k_shrinkFactor = 2.f; // How much smaller before shrinking the Buffer?
-
 
 		private: // No copies allowed:
 			TypedIndexedBuffer(TypedIndexedBuffer const&) = delete;
@@ -402,9 +414,9 @@ namespace gr
 	{
 		if (m_buffer)
 		{
-			m_idToBufferIdx.clear();
-			m_freeIndexes = {};
+			m_bufferData.Clear();
 			m_buffer = nullptr;
+			m_uploadStats.m_bufferByteSize = 0;
 			
 			return true;
 		}
@@ -420,6 +432,17 @@ namespace gr
 	}
 
 
+	template<typename RenderDataType, typename BufferDataType>
+	void IndexedBufferManager::TypedIndexedBuffer<RenderDataType, BufferDataType>::CommitRange(
+		IndexType baseIdx, IndexType numElements)
+	{
+		m_buffer->Commit(&m_bufferData.GetElement(baseIdx), baseIdx, numElements);
+
+		m_uploadStats.m_numBytesUploaded += static_cast<uint64_t>(numElements) * sizeof(BufferDataType);
+		m_uploadStats.m_numUploadRanges++;
+	}
+
+
 	template<typename RenderDataType, typename BufferDataType>
 	bool IndexedBufferManager::TypedIndexedBuffer<RenderDataType, BufferDataType>::UpdateBuffer(
 		gr::RenderDataManager const& renderData)
@@ -428,6 +451,9 @@ namespace gr
 
 		util::ScopedThreadProtector lock(m_threadProtector);
 
+		m_uploadStats.m_numBytesUploaded = 0;
+		m_uploadStats.m_numUploadRanges = 0;
+
 		if (renderData.HasAnyDirtyData<RenderDataType>() == false &&
 			renderData.HasIDsWithDeletedData<RenderDataType>() == false)
 		{
@@ -442,46 +468,10 @@ namespace gr
 			SEEndCPUEvent();
 			return didClear;
 		}
-		
-		bool didReallocate = false;
-		if (m_buffer == nullptr ||
-			m_buffer->GetBufferParams().m_arraySize < numRenderDataElements ||
-			m_buffer->GetBufferParams().m_arraySize <= (numRenderDataElements / k_shrinkFactor))
-		{
-			const uint32_t arraySize = util::RoundUpToNearestMultiple(numRenderDataElements, k_arraySizeAlignment);
-
-			LOG(std::format("Creating indexed buffer from RenderData \"{}\" for buffer data \"{}\", with {} elements",
-				std::type_index(typeid(RenderDataType)).name(),
-				std::type_index(typeid(BufferDataType)).name(),
-				arraySize));
-
-			didReallocate = (m_buffer != nullptr);
-
-			// If the Buffer already exists, we rely on the deferred delete to keep it in scope for any in-flight frames
-			m_buffer = re::Buffer::CreateUncommittedArray<BufferDataType>(
-				m_bufferName.c_str(),
-				re::Buffer::BufferParams{
-					.m_lifetime = re::Lifetime::Permanent,
-					.m_stagingPool = re::Buffer::StagingPool::Permanent,
-					.m_memPoolPreference = m_memPoolPreference,
-					.m_accessMask = m_accessMask,
-					.m_usageMask = re::Buffer::Usage::Structured,
-					.m_arraySize = arraySize,
-				});
-
-			// Re-populate the free index queue:
-			m_freeIndexes = {};
-			for (IndexType i = 0; i < arraySize; ++i)
-			{
-				m_freeIndexes.emplace(i);
-			}
-
-			// Clear our index map: We'll re-populate it as we build our Buffer data
-			m_idToBufferIdx.clear();
 
-			// Build and commit our Buffer data:
-			std::vector<BufferDataType> bufferData;
-			bufferData.resize(arraySize);
+		if (m_buffer == nullptr) // Build our CPU-side data from scratch:
+		{
+			m_bufferData.Clear();
 
 			if constexpr (std::is_same_v<RenderDataType, gr::Transform::RenderData>)
 			{
@@ -497,15 +487,8 @@ namespace gr
 						continue;
 					}
 
-					SEAssert(!m_freeIndexes.empty(), "No more free indexes. This should not be possible");
-
-					const IndexType currentBufferIdx = m_freeIndexes.top();
-					m_freeIndexes.pop();
-
-					bufferData[currentBufferIdx] = m_createBufferData(
-						renderData.GetTransformDataFromTransformID(transformID), transformID, renderData);
-
-					m_idToBufferIdx.emplace(transformID, currentBufferIdx);
+					m_bufferData.AddOrUpdateElement(
+						transformID, m_createBufferData(transformRenderData, transformID, renderData));
 				}
 			}
 			else
@@ -521,43 +504,21 @@ namespace gr
 						continue;
 					}
 
-					SEAssert(!m_freeIndexes.empty(), "No more free indexes. This should not be possible");
-
-					const IndexType currentBufferIdx = m_freeIndexes.top();
-					m_freeIndexes.pop();
-
-					bufferData[currentBufferIdx] = m_createBufferData(
-						objectRenderData, itr->GetRenderDataID(), renderData);
-
-					m_idToBufferIdx.emplace(itr->GetRenderDataID(), currentBufferIdx);
+					m_bufferData.AddOrUpdateElement(
+						itr->GetRenderDataID(),
+						m_createBufferData(objectRenderData, itr->GetRenderDataID(), renderData));
 				}
 			}
-
-			m_buffer->Commit(bufferData.data(), 0, util::CheckedCast<uint32_t>(bufferData.size()));
 		}
-		else // Update the existing buffer:
+		else // Update the existing CPU-side data:
 		{
-			// Remove deleted RenderDataTypes:
-			auto ProcessDeletedIDs = [this](std::vector<gr::IDType> const& deletedIDs)
-				{
-					for (gr::IDType deletedID : deletedIDs)
-					{
-						// An ID might not be found if it was filtered out via the m_filterCallback
-						auto idToBufferIdxItr = m_idToBufferIdx.find(deletedID);
-						if (idToBufferIdxItr != m_idToBufferIdx.end())
-						{
-							const IndexType deletedIdx = m_idToBufferIdx.at(deletedID);
-							m_idToBufferIdx.erase(deletedID);
-							m_freeIndexes.emplace(deletedIdx);
-						}
-					}
-				};
-
+			// Remove deleted RenderDataTypes first, so the freed slots are compacted before any new elements are added
 			if constexpr (std::is_same_v<RenderDataType, gr::Transform::RenderData>)
 			{
-				std::vector<gr::TransformID> const& deletedTransformIDs = renderData.GetDeletedTransformIDs();
-
-				ProcessDeletedIDs(deletedTransformIDs);
+				for (gr::TransformID deletedID : renderData.GetDeletedTransformIDs())
+				{
+					m_bufferData.RemoveElement(deletedID);
+				}
 			}
 			else
 			{
@@ -566,7 +527,10 @@ namespace gr
 				
 				if (deletedRenderDataIDs)
 				{
-					ProcessDeletedIDs(*deletedRenderDataIDs);
+					for (gr::RenderDataID deletedID : *deletedRenderDataIDs)
+					{
+						m_bufferData.RemoveElement(deletedID);
+					}
 				}
 			}
 
@@ -591,26 +555,7 @@ namespace gr
 							continue;
 						}
 
-						IndexType bufferIdx = std::numeric_limits<IndexType>::max();
-
-						auto itr = m_idToBufferIdx.find(dirtyID);
-						if (itr == m_idToBufferIdx.end())
-						{
-							SEAssert(!m_freeIndexes.empty(), "No more free indexes. This should not be possible");
-
-							bufferIdx = m_freeIndexes.top();
-							m_freeIndexes.pop();
-
-							m_idToBufferIdx.emplace(dirtyID, bufferIdx);
-						}
-						else
-						{
-							bufferIdx = itr->second;
-						}
-
-						BufferDataType const& bufferData = m_createBufferData(*data, dirtyID, renderData);
-
-						m_buffer->Commit(&bufferData, bufferIdx, 1);
+						m_bufferData.AddOrUpdateElement(dirtyID, m_createBufferData(*data, dirtyID, renderData));
 					}
 				};
 
@@ -621,14 +566,53 @@ namespace gr
 			}
 			else
 			{
-				std::vector<gr::RenderDataID> const& dirtyIDs =
-					renderData.GetIDsWithAnyDirtyData<RenderDataType>(m_featureBits);
-				ProcessDirtyIDs(dirtyIDs);
+				renderData.GetIDsWithAnyDirtyData<RenderDataType>(m_dirtyIDs, m_featureBits);
+				ProcessDirtyIDs(m_dirtyIDs);
+			}
+		}
+
+		const uint32_t currentArraySize = m_buffer ? m_buffer->GetArraySize() : 0;
+		const uint32_t arraySize = gr::IndexedBufferData<BufferDataType>::GetRequiredArraySize(
+			currentArraySize, m_bufferData.GetNumElements());
+
+		bool didReallocate = false;
+		if (arraySize != currentArraySize)
+		{
+			LOG(std::format("Creating indexed buffer from RenderData \"{}\" for buffer data \"{}\", with {} elements",
+				std::type_index(typeid(RenderDataType)).name(),
+				std::type_index(typeid(BufferDataType)).name(),
+				arraySize));
+
+			didReallocate = (m_buffer != nullptr);
+
+			// If the Buffer already exists, we rely on the deferred delete to keep it in scope for any in-flight frames
+			m_buffer = re::Buffer::CreateUncommittedArray<BufferDataType>(
+				m_bufferName.c_str(),
+				re::Buffer::BufferParams{
+					.m_lifetime = re::Lifetime::Permanent,
+					.m_stagingPool = re::Buffer::StagingPool::Permanent,
+					.m_memPoolPreference = m_memPoolPreference,
+					.m_accessMask = m_accessMask,
+					.m_usageMask = re::Buffer::Usage::Structured,
+					.m_arraySize = arraySize,
+				});
+
+			// The new Buffer has no data: Upload all live elements in a single commit
+			if (m_bufferData.GetNumElements() > 0)
+			{
+				CommitRange(0, m_bufferData.GetNumElements());
 			}
+			m_bufferData.ClearDirtyElements();
+		}
+		else // Upload the dirty elements, coalesced into contiguous ranges:
+		{
+			m_bufferData.ConsumeDirtyRanges([this](IndexType baseIdx, IndexType numElements)
+				{
+					CommitRange(baseIdx, numElements);
+				});
 		}
 
-		SEAssert(m_idToBufferIdx.size() + m_freeIndexes.size() == m_buffer->GetArraySize(),
-			"Indexes are out of sync");
+		m_uploadStats.m_bufferByteSize = static_cast<uint64_t>(m_buffer->GetArraySize()) * sizeof(BufferDataType);
 
 		SEEndCPUEvent();
 		return didReallocate;
@@ -648,6 +632,14 @@ namespace gr
 	}
 
 
+	template<typename RenderDataType, typename BufferDataType>
+	IndexedBufferManager::UploadStats const&
+		IndexedBufferManager::TypedIndexedBuffer<RenderDataType, BufferDataType>::GetUploadStats() const
+	{
+		return m_uploadStats;
+	}
+
+
 	template<typename RenderDataType, typename BufferDataType>
 	re::BufferInput IndexedBufferManager::TypedIndexedBuffer<RenderDataType, BufferDataType>::GetBufferInput(
 		char const* shaderName) const
@@ -688,12 +680,12 @@ namespace gr
 			id = renderData.GetTransformIDFromRenderDataID(id);
 		}
 
-		auto itr = m_idToBufferIdx.find(id);
-		if (itr == m_idToBufferIdx.end())
+		const IndexType bufferIdx = m_bufferData.GetIndex(id);
+		if (bufferIdx == gr::IndexedBufferData<BufferDataType>::k_invalidIdx)
 		{
 			return INVALID_RESOURCE_IDX;
 		}
-		return itr->second;
+		return bufferIdx;
 	}
 
 
@@ -716,7 +708,7 @@ namespace gr
 			ImGui::Indent();
 
 			if (ImGui::CollapsingHeader(
-				std::format("{} registered IDs##", m_idToBufferIdx.size(), buffer->GetUniqueID()).c_str()))
+				std::format("{} registered IDs##", m_bufferData.GetNumElements(), buffer->GetUniqueID()).c_str()))
 			{
 				ImGui::Indent();
 
@@ -729,8 +721,8 @@ namespace gr
 				{
 					// Sort the IDs for consistent viewing:
 					std::vector<std::pair<gr::IDType, IndexType>> sortedIDs;
-					sortedIDs.reserve(m_idToBufferIdx.size());
-					for (auto const& entry : m_idToBufferIdx)
+					sortedIDs.reserve(m_bufferData.GetNumElements());
+					for (auto const& entry : m_bufferData.GetIDToIndexMap())
 					{
 						sortedIDs.emplace_back(entry);
 					}
@@ -776,8 +768,12 @@ namespace gr
 				}
 				ImGui::Unindent();
 			}
-			ImGui::Text(std::format("{} remaining free indexes", m_freeIndexes.size()).c_str());
+			ImGui::Text(std::format("{} free indexes", buffer->GetArraySize() - m_bufferData.GetNumElements()).c_str());
 			ImGui::Text(std::format("Buffer array size: {}", buffer->GetArraySize()).c_str());
+			ImGui::Text(std::format("Uploaded {} of {} bytes this frame, in {} commit(s)",
+				m_uploadStats.m_numBytesUploaded,
+				m_uploadStats.m_bufferByteSize,
+				m_uploadStats.m_numUploadRanges).c_str());
 
 			ImGui::NewLine();
 
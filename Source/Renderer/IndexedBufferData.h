@@ -0,0 +1,243 @@
+// © 2025 Adam Badke. All rights reserved.
+#pragma once
+#include "RenderObjectIDs.h"
+
+#include "Core/Assert.h"
+
+#include "Core/Util/CastUtils.h"
+#include "Core/Util/DenseBitset.h"
+#include "Core/Util/MathUtils.h"
+
+
+namespace gr
+{
+	// CPU-side copy of an indexed Buffer's elements. Elements are kept densely packed in [0, n): Removing an element
+	// moves the last element into its slot. Modified elements are tracked, so they can be uploaded to the Buffer in a
+	// few contiguous ranges. Buffer sizing and upload ranges are computed here, independently of the re::Buffer
+	template<typename BufferDataType>
+	class IndexedBufferData final
+	{
+	public:
+		typedef uint32_t IndexType;
+
+		static constexpr IndexType k_invalidIdx = std::numeric_limits<IndexType>::max();
+
+		static constexpr uint32_t k_arraySizeAlignment = 16; // Buffer sizes are rounded up to nearest multiple
+		static constexpr uint32_t k_shrinkFactor = 2; // How much smaller before shrinking the Buffer?
+		static constexpr IndexType k_maxBridgedGapElements = 8; // Clean elements merged into an upload range
+
+
+	public:
+		IndexedBufferData() = default;
+		~IndexedBufferData() = default;
+
+		IndexedBufferData(IndexedBufferData&&) noexcept = default;
+		IndexedBufferData& operator=(IndexedBufferData&&) noexcept = default;
+
+
+	public:
+		void Clear();
+
+		void AddOrUpdateElement(IDType, BufferDataType&&); // New and updated elements are marked dirty
+		void RemoveElement(IDType); // IDs that were never added (e.g. filtered out) are ignored
+
+		IndexType GetIndex(IDType) const; // k_invalidIdx if the ID has not been added
+		IDType GetID(IndexType) const;
+		BufferDataType const& GetElement(IndexType) const;
+
+		uint32_t GetNumElements() const;
+		std::unordered_map<IDType, IndexType> const& GetIDToIndexMap() const;
+
+		// Calls fn(IndexType baseIdx, IndexType numElements) for each contiguous range of dirty elements, in ascending
+		// order, and then clears the dirty flags. Gaps of up to k_maxBridgedGapElements clean elements are bridged:
+		// Re-uploading a few clean elements is cheaper than staging another commit
+		template<typename Fn>
+		void ConsumeDirtyRanges(Fn&&);
+
+		void ClearDirtyElements(); // E.g. after all elements have been uploaded to a new Buffer
+
+		// Returns the array size a Buffer holding numElements must be (re)allocated with, or currentArraySize if the
+		// existing Buffer can be kept. A currentArraySize of 0 indicates there is no Buffer
+		static uint32_t GetRequiredArraySize(uint32_t currentArraySize, uint32_t numElements);
+
+
+	private:
+		std::unordered_map<IDType, IndexType> m_idToBufferIdx;
+		std::vector<BufferDataType> m_bufferData;
+		std::vector<IDType> m_bufferIdxToID; // Parallel to m_bufferData
+		util::DenseBitset m_dirtyIndexes; // Elements of m_bufferData modified since the last upload
+
+
+	private: // No copies allowed:
+		IndexedBufferData(IndexedBufferData const&) = delete;
+		IndexedBufferData& operator=(IndexedBufferData const&) = delete;
+	};
+
+
+	template<typename BufferDataType>
+	void IndexedBufferData<BufferDataType>::Clear()
+	{
+		m_idToBufferIdx.clear();
+		m_bufferData.clear();
+		m_bufferIdxToID.clear();
+		m_dirtyIndexes.Resize(0);
+	}
+
+
+	template<typename BufferDataType>
+	void IndexedBufferData<BufferDataType>::AddOrUpdateElement(IDType id, BufferDataType&& bufferData)
+	{
+		auto itr = m_idToBufferIdx.find(id);
+		if (itr == m_idToBufferIdx.end())
+		{
+			const IndexType bufferIdx = util::CheckedCast<IndexType>(m_bufferData.size());
+
+			m_idToBufferIdx.emplace(id, bufferIdx);
+			m_bufferData.emplace_back(std::move(bufferData));
+			m_bufferIdxToID.emplace_back(id);
+			m_dirtyIndexes.PushBack(true);
+		}
+		else
+		{
+			m_bufferData[itr->second] = std::move(bufferData);
+			m_dirtyIndexes.Set(itr->second);
+		}
+	}
+
+
+	template<typename BufferDataType>
+	void IndexedBufferData<BufferDataType>::RemoveElement(IDType id)
+	{
+		auto itr = m_idToBufferIdx.find(id);
+		if (itr == m_idToBufferIdx.end())
+		{
+			return;
+		}
+
+		const IndexType deletedIdx = itr->second;
+		const IndexType lastIdx = util::CheckedCast<IndexType>(m_bufferData.size() - 1);
+
+		m_idToBufferIdx.erase(itr);
+
+		// Move the last element into the hole to keep the data densely packed:
+		if (deletedIdx != lastIdx)
+		{
+			m_bufferData[deletedIdx] = std::move(m_bufferData[lastIdx]);
+			m_bufferIdxToID[deletedIdx] = m_bufferIdxToID[lastIdx];
+			m_idToBufferIdx.at(m_bufferIdxToID[deletedIdx]) = deletedIdx;
+		}
+		m_bufferData.pop_back();
+		m_bufferIdxToID.pop_back();
+		m_dirtyIndexes.EraseUnordered(deletedIdx);
+
+		if (deletedIdx != lastIdx)
+		{
+			m_dirtyIndexes.Set(deletedIdx); // The moved element must be uploaded to its new location
+		}
+
+		SEAssert(m_idToBufferIdx.size() == m_bufferData.size() &&
+			m_bufferIdxToID.size() == m_bufferData.size() &&
+			m_dirtyIndexes.GetNumBits() == m_bufferData.size(),
+			"Indexes are out of sync");
+	}
+
+
+	template<typename BufferDataType>
+	typename IndexedBufferData<BufferDataType>::IndexType IndexedBufferData<BufferDataType>::GetIndex(IDType id) const
+	{
+		auto itr = m_idToBufferIdx.find(id);
+		if (itr == m_idToBufferIdx.end())
+		{
+			return k_invalidIdx;
+		}
+		return itr->second;
+	}
+
+
+	template<typename BufferDataType>
+	IDType IndexedBufferData<BufferDataType>::GetID(IndexType bufferIdx) const
+	{
+		SEAssert(bufferIdx < m_bufferIdxToID.size(), "Buffer index is OOB");
+		return m_bufferIdxToID[bufferIdx];
+	}
+
+
+	template<typename BufferDataType>
+	BufferDataType const& IndexedBufferData<BufferDataType>::GetElement(IndexType bufferIdx) const
+	{
+		SEAssert(bufferIdx < m_bufferData.size(), "Buffer index is OOB");
+		return m_bufferData[bufferIdx];
+	}
+
+
+	template<typename BufferDataType>
+	uint32_t IndexedBufferData<BufferDataType>::GetNumElements() const
+	{
+		return util::CheckedCast<uint32_t>(m_bufferData.size());
+	}
+
+
+	template<typename BufferDataType>
+	std::unordered_map<IDType, typename IndexedBufferData<BufferDataType>::IndexType> const&
+		IndexedBufferData<BufferDataType>::GetIDToIndexMap() const
+	{
+		return m_idToBufferIdx;
+	}
+
+
+	template<typename BufferDataType>
+	template<typename Fn>
+	void IndexedBufferData<BufferDataType>::ConsumeDirtyRanges(Fn&& fn)
+	{
+		IndexType rangeBeginIdx = k_invalidIdx;
+		IndexType rangeEndIdx = 0; // Exclusive
+
+		m_dirtyIndexes.ForEachSetBit([&](size_t dirtyIdx)
+			{
+				const IndexType bufferIdx = static_cast<IndexType>(dirtyIdx);
+
+				if (rangeBeginIdx != k_invalidIdx && bufferIdx - rangeEndIdx <= k_maxBridgedGapElements)
+				{
+					rangeEndIdx = bufferIdx + 1;
+					return;
+				}
+
+				if (rangeBeginIdx != k_invalidIdx)
+				{
+					fn(rangeBeginIdx, rangeEndIdx - rangeBeginIdx);
+				}
+				rangeBeginIdx = bufferIdx;
+				rangeEndIdx = bufferIdx + 1;
+			});
+
+		if (rangeBeginIdx != k_invalidIdx)
+		{
+			fn(rangeBeginIdx, rangeEndIdx - rangeBeginIdx);
+		}
+		m_dirtyIndexes.ClearAll();
+	}
+
+
+	template<typename BufferDataType>
+	void IndexedBufferData<BufferDataType>::ClearDirtyElements()
+	{
+		m_dirtyIndexes.ClearAll();
+	}
+
+
+	template<typename BufferDataType>
+	uint32_t IndexedBufferData<BufferDataType>::GetRequiredArraySize(uint32_t currentArraySize, uint32_t numElements)
+	{
+		// Note: Everything may have been filtered out, but we still allocate a (minimum-sized) Buffer in that case
+		numElements = std::max(numElements, 1u);
+
+		// Buffers at the minimum aligned size are never shrunk
+		if (currentArraySize == 0 ||
+			currentArraySize < numElements ||
+			(currentArraySize > k_arraySizeAlignment && numElements <= currentArraySize / k_shrinkFactor))
+		{
+			return util::RoundUpToNearestMultiple(numElements, k_arraySizeAlignment);
+		}
+		return currentArraySize;
+	}
+}
\ No newline at end of file
@@ -160,7 +160,7 @@ namespace gr
 			// Catch illegal accesses during RenderData modification
 			util::ScopedThreadProtector threadProjector(m_threadProtector);
 
-			SEAssert(m_IDToRenderObjectMetadata.empty() && m_transformIDToTransformMetadata.empty(),
+			SEAssert(m_renderObjectMetadata.IsEmpty() && m_transformMetadata.IsEmpty(),
 				"An ID to data map is not empty: Was a render object not destroyed via a render command?");
 
 			SEAssert(m_registeredRenderObjectIDs.empty() && m_registeredTransformIDs.empty(),
@@ -196,21 +196,22 @@ namespace gr
 				prevFrameDeletedTypes.clear();
 			}
 			m_perFrameDeletedDataIDs.clear();
-			m_perFrameSeenDeletedDataIDs.clear();
+			m_perFrameDeletedDataObjectBits.ClearAll();
 			for (auto& prevFrameDirtyTypes : m_perFramePerTypeDirtyDataIDs)
 			{
 				prevFrameDirtyTypes.clear();
 			}
-			for (auto& prevFrameDirtyTypeIDs : m_perFramePerTypeDirtySeenDataIDs)
+			for (util::DenseBitset& prevFrameDirtyObjectBits : m_perFramePerTypeDirtyObjectBits)
 			{
-				prevFrameDirtyTypeIDs.clear();
+				prevFrameDirtyObjectBits.ClearAll();
 			}
 
 			// Transforms:
 			m_perFrameNewTransformIDs.clear();
 			m_perFrameDeletedTransformIDs.clear();
 			m_perFrameDirtyTransformIDs.clear();
-			m_perFrameSeenDirtyTransformIDs.clear();
+			m_perFrameDirtyTransformBits.ClearAll();
+			m_perFrameDirtyTransformObjectBits.ClearAll();
 		}
 
 		m_currentFrame = currentFrame;
@@ -229,27 +230,113 @@ namespace gr
 	}
 
 
+	void RenderDataManager::AddDataTypeTables(DataTypeIndex dataTypeIndex)
+	{
+		if (dataTypeIndex < m_perTypeObjectDataIndexes.size())
+		{
+			return; // Tables already exist
+		}
+
+		const size_t numDataTypes = static_cast<size_t>(dataTypeIndex) + 1;
+
+		m_perTypeRegisteredRenderDataIDs.resize(numDataTypes);
+		m_perFramePerTypeNewDataIDs.resize(numDataTypes);
+		m_perFramePerTypeDeletedDataIDs.resize(numDataTypes);
+		m_perFramePerTypeDirtyDataIDs.resize(numDataTypes);
+
+		// The per-object tables must have an entry for every existing render object:
+		const uint32_t numRenderObjects = m_renderObjectMetadata.Size();
+
+		m_perTypeObjectDataIndexes.resize(numDataTypes, std::vector<DataIndex>(numRenderObjects, k_invalidDataIdx));
+		m_perTypeObjectDirtyFrames.resize(
+			numDataTypes, std::vector<uint64_t>(numRenderObjects, k_invalidDirtyFrameNum));
+		m_perFramePerTypeDirtyObjectBits.resize(numDataTypes, util::DenseBitset(numRenderObjects));
+		m_perTypeObjectHasDataBits.resize(numDataTypes, util::DenseBitset(numRenderObjects));
+	}
+
+
+	void RenderDataManager::AddRenderObjectSlot(gr::TransformID transformID)
+	{
+		// Append a (empty) slot for the newest render object to each of the per-object tables:
+		for (std::vector<DataIndex>& objectDataIndexes : m_perTypeObjectDataIndexes)
+		{
+			objectDataIndexes.emplace_back(k_invalidDataIdx);
+		}
+		for (std::vector<uint64_t>& objectDirtyFrames : m_perTypeObjectDirtyFrames)
+		{
+			objectDirtyFrames.emplace_back(k_invalidDirtyFrameNum);
+		}
+		for (util::DenseBitset& dirtyObjectBits : m_perFramePerTypeDirtyObjectBits)
+		{
+			dirtyObjectBits.PushBack(false);
+		}
+		for (util::DenseBitset& objectHasDataBits : m_perTypeObjectHasDataBits)
+		{
+			objectHasDataBits.PushBack(false);
+		}
+		for (util::DenseBitset& featureObjectBits : m_perFeatureObjectBits)
+		{
+			featureObjectBits.PushBack(false);
+		}
+		m_perFrameDeletedDataObjectBits.PushBack(false);
+
+		// The object's Transform might have already been modified this frame
+		const uint32_t transformIdx = m_transformMetadata.GetIndex(transformID);
+		m_perFrameDirtyTransformObjectBits.PushBack(
+			transformIdx != k_invalidDataIdx && m_perFrameDirtyTransformBits.Test(transformIdx));
+	}
+
+
+	void RenderDataManager::RemoveRenderObjectSlot(uint32_t renderObjectIdx)
+	{
+		// The last render object is moved into the erased slot: Mirror this in each of the per-object tables
+		for (std::vector<DataIndex>& objectDataIndexes : m_perTypeObjectDataIndexes)
+		{
+			objectDataIndexes[renderObjectIdx] = objectDataIndexes.back();
+			objectDataIndexes.pop_back();
+		}
+		for (std::vector<uint64_t>& objectDirtyFrames : m_perTypeObjectDirtyFrames)
+		{
+			objectDirtyFrames[renderObjectIdx] = objectDirtyFrames.back();
+			objectDirtyFrames.pop_back();
+		}
+		for (util::DenseBitset& dirtyObjectBits : m_perFramePerTypeDirtyObjectBits)
+		{
+			dirtyObjectBits.EraseUnordered(renderObjectIdx);
+		}
+		for (util::DenseBitset& objectHasDataBits : m_perTypeObjectHasDataBits)
+		{
+			objectHasDataBits.EraseUnordered(renderObjectIdx);
+		}
+		for (util::DenseBitset& featureObjectBits : m_perFeatureObjectBits)
+		{
+			featureObjectBits.EraseUnordered(renderObjectIdx);
+		}
+		m_perFrameDeletedDataObjectBits.EraseUnordered(renderObjectIdx);
+		m_perFrameDirtyTransformObjectBits.EraseUnordered(renderObjectIdx);
+	}
+
+
 	void RenderDataManager::RegisterObject(gr::RenderDataID renderDataID, gr::TransformID transformID)
 	{
 		{
 			// Catch illegal accesses during RenderData modification
 			util::ScopedThreadProtector threadProjector(m_threadProtector);
 
-			auto renderObjectMetadata = m_IDToRenderObjectMetadata.find(renderDataID);
-			if (renderObjectMetadata == m_IDToRenderObjectMetadata.end())
+			RenderObjectMetadata* renderObjectMetadata = m_renderObjectMetadata.TryGet(renderDataID);
+			if (renderObjectMetadata == nullptr)
 			{
-				m_IDToRenderObjectMetadata.emplace(
-					renderDataID,
-					RenderObjectMetadata(transformID));
+				m_renderObjectMetadata.Emplace(renderDataID, transformID);
+				AddRenderObjectSlot(transformID);
 
 				AddIDToTrackingList(m_registeredRenderObjectIDs, renderDataID);
 			}
 			else
 			{
-				SEAssert(renderObjectMetadata->second.m_transformID ==  transformID,
+				SEAssert(renderObjectMetadata->m_transformID ==  transformID,
 					"Received a different TransformID than what is already recorded");
 
-				renderObjectMetadata->second.m_referenceCount++;
+				renderObjectMetadata->m_referenceCount++;
 			}
 
 			// Multi-map our TransformID -> RenderDataID:
@@ -268,22 +355,24 @@ namespace gr
 			// Catch illegal accesses during RenderData modification
 			util::ScopedThreadProtector threadProjector(m_threadProtector);
 
-			SEAssert(m_IDToRenderObjectMetadata.contains(renderDataID),
+			SEAssert(m_renderObjectMetadata.Contains(renderDataID),
 				"Trying to destroy an object that does not exist");
 
-			RenderObjectMetadata& renderObjectMetadata = m_IDToRenderObjectMetadata.at(renderDataID);
+			RenderObjectMetadata& renderObjectMetadata = m_renderObjectMetadata.Get(renderDataID);
 			transformID = renderObjectMetadata.m_transformID;
 
 			renderObjectMetadata.m_referenceCount--;
 			if (renderObjectMetadata.m_referenceCount == 0)
 			{
-				ObjectTypeToDataIndexMap const& dataIndexMap =
-					renderObjectMetadata.m_dataTypeToDataIndexMap;
-
-				SEAssert(renderObjectMetadata.m_dataTypeToDataIndexMap.empty(),
+				SEAssert(std::ranges::all_of(m_perTypeObjectDataIndexes,
+					[renderObjectIdx = m_renderObjectMetadata.GetIndex(renderDataID)]
+					(std::vector<DataIndex> const& objectDataIndexes)
+					{
+						return objectDataIndexes[renderObjectIdx] == k_invalidDataIdx;
+					}),
 					"Cannot destroy an object with first destroying its associated data");
 
-				m_IDToRenderObjectMetadata.erase(renderDataID);
+				RemoveRenderObjectSlot(m_renderObjectMetadata.Erase(renderDataID));
 				
 				RemoveIDFromTrackingList(m_registeredRenderObjectIDs, renderDataID);
 
@@ -311,10 +400,18 @@ namespace gr
 		// Catch illegal accesses during RenderData modification
 		util::ScopedThreadProtector threadProjector(m_threadProtector);
 
-		SEAssert(m_IDToRenderObjectMetadata.contains(renderDataID), "Invalid object ID");
-		RenderObjectMetadata& renderObjectMetadata = m_IDToRenderObjectMetadata.at(renderDataID);
+		const uint32_t renderObjectIdx = m_renderObjectMetadata.GetIndex(renderDataID);
+		SEAssert(renderObjectIdx != RenderObjectSlotMap::k_invalidIndex, "Invalid object ID");
+		SEAssert((featureBits >> k_numFeatureBits) == 0, "Invalid feature bits");
+
+		m_renderObjectMetadata.GetAt(renderObjectIdx).m_featureBits |= featureBits;
 
-		renderObjectMetadata.m_featureBits |= featureBits;
+		// Mirror the feature bits in the per-feature object bitsets, for word-parallel queries:
+		util::DenseBitset::ForEachSetBit(featureBits, 0,
+			[this, renderObjectIdx](size_t featureBitIdx)
+			{
+				m_perFeatureObjectBits[featureBitIdx].Set(renderObjectIdx);
+			});
 	}
 
 
@@ -322,8 +419,8 @@ namespace gr
 	{
 		m_threadProtector.ValidateThreadAccess();
 
-		SEAssert(m_IDToRenderObjectMetadata.contains(renderDataID), "renderDataID is not registered");
-		RenderObjectMetadata const& renderObjectMetadata = m_IDToRenderObjectMetadata.at(renderDataID);
+		SEAssert(m_renderObjectMetadata.Contains(renderDataID), "renderDataID is not registered");
+		RenderObjectMetadata const& renderObjectMetadata = m_renderObjectMetadata.Get(renderDataID);
 
 		return renderObjectMetadata.m_featureBits;
 	}
@@ -334,28 +431,30 @@ namespace gr
 		// Catch illegal accesses during RenderData modification
 		util::ScopedThreadProtector threadProjector(m_threadProtector);
 
-		auto transformMetadataItr = m_transformIDToTransformMetadata.find(transformID);
-		if (transformMetadataItr == m_transformIDToTransformMetadata.end())
+		TransformMetadata* transformMetadata = m_transformMetadata.TryGet(transformID);
+		if (transformMetadata == nullptr)
 		{
-			const DataIndex newTransformDataIdx = util::CheckedCast<DataIndex>(m_transformRenderData.size());
+			m_transformMetadata.Emplace(
+				transformID,
+				TransformMetadata{
+					.m_referenceCount = 1,	// Initial reference count
+					.m_dirtyFrame = m_currentFrame});
 
-			// Allocate and initialize the Transform render data
+			// Allocate and initialize the Transform render data in the matching slot
 			m_transformRenderData.emplace_back();
 			m_transformRenderData.back().m_transformID = transformID;
 
-			m_transformIDToTransformMetadata.emplace(
-				transformID,
-				TransformMetadata{
-					.m_transformIdx = newTransformDataIdx,	// Transform index
-					.m_referenceCount = 1,					// Initial reference count
-					.m_dirtyFrame = m_currentFrame});
+			SEAssert(m_transformRenderData.size() == m_transformMetadata.Size(),
+				"Transform render data is out of sync with the Transform metadata");
+
+			m_perFrameDirtyTransformBits.PushBack(false);
 
 			AddIDToTrackingList(m_registeredTransformIDs, transformID);
 			AddIDToTrackingList(m_perFrameNewTransformIDs, transformID);
 		}
 		else
 		{
-			transformMetadataItr->second.m_referenceCount++;
+			transformMetadata->m_referenceCount++;
 		}
 	}
 
@@ -365,42 +464,33 @@ namespace gr
 		// Catch illegal accesses during RenderData modification
 		util::ScopedThreadProtector threadProjector(m_threadProtector);
 
-		auto transformMetadataItr = m_transformIDToTransformMetadata.find(transformID);
+		TransformMetadata* transformMetadata = m_transformMetadata.TryGet(transformID);
 
-		SEAssert(transformMetadataItr != m_transformIDToTransformMetadata.end(),
-			"Trying to unregister a Transform that does not exist");
+		SEAssert(transformMetadata != nullptr, "Trying to unregister a Transform that does not exist");
 
 		// Decriment our reference count. If it's zero, remove the record entirely
-		transformMetadataItr->second.m_referenceCount--;
+		transformMetadata->m_referenceCount--;
 
-		SEAssert(transformMetadataItr->second.m_referenceCount == m_transformToRenderDataIDs.count(transformID) ||
+		SEAssert(transformMetadata->m_referenceCount == m_transformToRenderDataIDs.count(transformID) ||
 			(transformID == k_invalidTransformID && 
-				transformMetadataItr->second.m_referenceCount == m_transformToRenderDataIDs.count(transformID) + 1),
+				transformMetadata->m_referenceCount == m_transformToRenderDataIDs.count(transformID) + 1),
 			"TransformID to RenderDataID map is out of sync");
 
-		if (transformMetadataItr->second.m_referenceCount == 0)
+		if (transformMetadata->m_referenceCount == 0)
 		{
-			const DataIndex indexToMove = util::CheckedCast<DataIndex>(m_transformRenderData.size() - 1);
-			const DataIndex indexToReplace = transformMetadataItr->second.m_transformIdx;
+			// Erase the TransformID record. The last record is moved into its slot, so we do the same with the data
+			const DataIndex indexToReplace = m_transformMetadata.Erase(transformID);
 
 			SEAssert(indexToReplace < m_transformRenderData.size(), "Invalid replacement index");
 
 			// Copy the transform to its new location, and remove the end element
-			m_transformRenderData[indexToReplace] = m_transformRenderData[indexToMove];
-			m_transformRenderData.pop_back();
-
-			// Update the indexes stored in any records referencing the entry we just moved. Transforms can be shared,
-			// so we need to check all records
-			for (auto& record : m_transformIDToTransformMetadata)
+			if (indexToReplace != m_transformRenderData.size() - 1)
 			{
-				if (record.second.m_transformIdx == indexToMove)
-				{
-					record.second.m_transformIdx = indexToReplace;
-				}
+				m_transformRenderData[indexToReplace] = m_transformRenderData.back();
 			}
+			m_transformRenderData.pop_back();
 
-			// Finally, erase the TransformID record:
-			m_transformIDToTransformMetadata.erase(transformID);
+			m_perFrameDirtyTransformBits.EraseUnordered(indexToReplace);
 			
 			RemoveIDFromTrackingList(m_registeredTransformIDs, transformID);
 			AddIDToTrackingList(m_perFrameDeletedTransformIDs, transformID);
@@ -416,22 +506,50 @@ namespace gr
 		// Catch illegal accesses during RenderData modification
 		util::ScopedThreadProtector threadProjector(m_threadProtector);
 
-		auto transformMetadataItr = m_transformIDToTransformMetadata.find(transformID);
+		SetTransformDataInternal(transformID, transformRenderData);
+	}
 
-		SEAssert(transformMetadataItr != m_transformIDToTransformMetadata.end(),
-			"Trying to set the data for a Transform that does not exist");
 
-		const DataIndex transformDataIdx = transformMetadataItr->second.m_transformIdx;
+	void RenderDataManager::SetTransformData(
+		std::span<const gr::TransformID> transformIDs, std::span<const gr::Transform::RenderData> transformRenderData)
+	{
+		SEAssert(transformIDs.size() == transformRenderData.size(),
+			"Received a mismatched number of TransformIDs and data");
+
+		// Catch illegal accesses during RenderData modification
+		util::ScopedThreadProtector threadProjector(m_threadProtector);
+
+		for (size_t i = 0; i < transformIDs.size(); ++i)
+		{
+			SetTransformDataInternal(transformIDs[i], transformRenderData[i]);
+		}
+	}
+
+
+	void RenderDataManager::SetTransformDataInternal(
+		gr::TransformID transformID, gr::Transform::RenderData const& transformRenderData)
+	{
+		const DataIndex transformDataIdx = m_transformMetadata.GetIndex(transformID);
+
+		SEAssert(transformDataIdx != k_invalidDataIdx, "Trying to set the data for a Transform that does not exist");
 		SEAssert(transformDataIdx < m_transformRenderData.size(), "Invalid transform index");
 
 		m_transformRenderData[transformDataIdx] = transformRenderData;
 
-		transformMetadataItr->second.m_dirtyFrame = m_currentFrame;
+		m_transformMetadata.GetAt(transformDataIdx).m_dirtyFrame = m_currentFrame;
 
 		// If this is the first time we've modified the transform this frame, add the TransformID to our tracking table
-		if (m_perFrameSeenDirtyTransformIDs.emplace(transformID).second)
+		if (!m_perFrameDirtyTransformBits.TestAndSet(transformDataIdx))
 		{
 			m_perFrameDirtyTransformIDs.emplace_back(transformID);
+
+			// Flag the render objects that use the Transform:
+			auto renderDataIDs = m_transformToRenderDataIDs.equal_range(transformID);
+			while (renderDataIDs.first != renderDataIDs.second)
+			{
+				m_perFrameDirtyTransformObjectBits.Set(m_renderObjectMetadata.GetIndex(renderDataIDs.first->second));
+				++renderDataIDs.first;
+			}
 		}
 	}
 
@@ -440,12 +558,9 @@ namespace gr
 	{
 		m_threadProtector.ValidateThreadAccess(); // Any thread can get data so long as no modification is happening
 
-		auto transformMetadataItr = m_transformIDToTransformMetadata.find(transformID);
-
-		SEAssert(transformMetadataItr != m_transformIDToTransformMetadata.end(),
-			"Trying to get the data for a Transform that does not exist");
+		const DataIndex transformDataIdx = m_transformMetadata.GetIndex(transformID);
 
-		const DataIndex transformDataIdx = transformMetadataItr->second.m_transformIdx;
+		SEAssert(transformDataIdx != k_invalidDataIdx, "Trying to get the data for a Transform that does not exist");
 		SEAssert(transformDataIdx < m_transformRenderData.size(), "Invalid transform index");
 
 		return m_transformRenderData[transformDataIdx];
@@ -458,9 +573,9 @@ namespace gr
 
 		m_threadProtector.ValidateThreadAccess(); // Any thread can get data so long as no modification is happening
 
-		SEAssert(m_IDToRenderObjectMetadata.contains(renderDataID), "Trying to find an object that does not exist");
+		SEAssert(m_renderObjectMetadata.Contains(renderDataID), "Trying to find an object that does not exist");
 
-		RenderObjectMetadata const& renderObjectMetadata = m_IDToRenderObjectMetadata.at(renderDataID);
+		RenderObjectMetadata const& renderObjectMetadata = m_renderObjectMetadata.Get(renderDataID);
 		
 		return GetTransformDataFromTransformID(renderObjectMetadata.m_transformID);
 	}
@@ -475,17 +590,17 @@ namespace gr
 			return false; // The default identity transform is never dirty
 		}
 
-		auto transformMetadataItr = m_transformIDToTransformMetadata.find(transformID);
+		TransformMetadata const* transformMetadata = m_transformMetadata.TryGet(transformID);
 
-		SEAssert(transformMetadataItr != m_transformIDToTransformMetadata.end(),
+		SEAssert(transformMetadata != nullptr,
 			"Trying to get the data for a Transform that does not exist. Are you sure you passed a TransformID?");
 
-		SEAssert(transformMetadataItr->second.m_dirtyFrame != k_invalidDirtyFrameNum &&
-			transformMetadataItr->second.m_dirtyFrame <= m_currentFrame &&
+		SEAssert(transformMetadata->m_dirtyFrame != k_invalidDirtyFrameNum &&
+			transformMetadata->m_dirtyFrame <= m_currentFrame &&
 			m_currentFrame != k_invalidDirtyFrameNum,
 			"Invalid dirty frame value");
 
-		return transformMetadataItr->second.m_dirtyFrame == m_currentFrame;		
+		return transformMetadata->m_dirtyFrame == m_currentFrame;
 	}
 
 
@@ -495,9 +610,9 @@ namespace gr
 
 		m_threadProtector.ValidateThreadAccess(); // Any thread can get data so long as no modification is happening
 
-		SEAssert(m_IDToRenderObjectMetadata.contains(renderDataID), "Trying to find an object that does not exist");
+		SEAssert(m_renderObjectMetadata.Contains(renderDataID), "Trying to find an object that does not exist");
 
-		RenderObjectMetadata const& renderObjectMetadata = m_IDToRenderObjectMetadata.at(renderDataID);
+		RenderObjectMetadata const& renderObjectMetadata = m_renderObjectMetadata.Get(renderDataID);
 
 		return TransformIsDirty(renderObjectMetadata.m_transformID);
 	}
@@ -562,7 +677,7 @@ namespace gr
 
 		const DataTypeIndex numDataTypes = util::CheckedCast<DataTypeIndex>(m_dataVectors.size());
 		const int numCols = numDataTypes + 3;
-		if (ImGui::BeginTable("m_IDToRenderObjectMetadata", numCols, flags))
+		if (ImGui::BeginTable("m_renderObjectMetadata", numCols, flags))
 		{
 			// Headers:				
 			ImGui::TableSetupColumn("RenderObjectID (ref. count)");
@@ -575,10 +690,10 @@ namespace gr
 			ImGui::TableHeadersRow();
 
 
-			for (auto const& entry : m_IDToRenderObjectMetadata)
+			for (uint32_t renderObjectIdx = 0; renderObjectIdx < m_renderObjectMetadata.Size(); ++renderObjectIdx)
 			{
-				const gr::RenderDataID renderDataID = entry.first;
-				RenderObjectMetadata const& renderObjectMetadata = entry.second;
+				const gr::RenderDataID renderDataID = m_renderObjectMetadata.GetKeyAt(renderObjectIdx);
+				RenderObjectMetadata const& renderObjectMetadata = m_renderObjectMetadata.GetAt(renderObjectIdx);
 
 				ImGui::TableNextRow();
 				ImGui::TableNextColumn();
@@ -589,10 +704,11 @@ namespace gr
 				ImGui::TableNextColumn();				
 
 				// TransformID (Ref. count) [dirty frame]
+				TransformMetadata const& transformMetadata = m_transformMetadata.Get(renderObjectMetadata.m_transformID);
 				ImGui::Text(std::format("{} ({}) [{}]",
 					renderObjectMetadata.m_transformID,
-					m_transformIDToTransformMetadata.at(renderObjectMetadata.m_transformID).m_referenceCount,
-					m_transformIDToTransformMetadata.at(renderObjectMetadata.m_transformID).m_dirtyFrame).c_str());
+					transformMetadata.m_referenceCount,
+					transformMetadata.m_dirtyFrame).c_str());
 
 				ImGui::TableNextColumn();
 
@@ -605,29 +721,28 @@ namespace gr
 
 					std::string cellText;
 
-					// ObjectTypeToDataIndexMap
-					auto const& objectTypeToDataIdx = renderObjectMetadata.m_dataTypeToDataIndexMap.find(i);
-					if (objectTypeToDataIdx == renderObjectMetadata.m_dataTypeToDataIndexMap.end())
+					// Data index
+					const DataIndex dataIdx = GetDataIndex(i, renderObjectIdx);
+					if (dataIdx == k_invalidDataIdx)
 					{
 						cellText = "-";
 					}
 					else
 					{
-						
-						cellText = std::format("{}", objectTypeToDataIdx->second).c_str();
+						cellText = std::format("{}", dataIdx).c_str();
 					}
 
 					cellText += " ";
 
-					// LastDirtyFrameMap
-					auto const& dirtyFrameRecord = renderObjectMetadata.m_dirtyFrameMap.find(i);
-					if (dirtyFrameRecord == renderObjectMetadata.m_dirtyFrameMap.end())
+					// Last dirty frame
+					const uint64_t dirtyFrame = GetDirtyFrame(i, renderObjectIdx);
+					if (dirtyFrame == k_invalidDirtyFrameNum)
 					{
 						cellText += "[-]";
 					}
 					else
 					{
-						cellText += std::format("[{}]", renderObjectMetadata.m_dirtyFrameMap.at(i)).c_str();
+						cellText += std::format("[{}]", dirtyFrame).c_str();
 					}
 
 					ImGui::Text(cellText.c_str());
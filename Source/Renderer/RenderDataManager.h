@@ -5,6 +5,8 @@
 
 #include "Core/Assert.h"
 #include "Core/Util/CastUtils.h"
+#include "Core/Util/DenseBitset.h"
+#include "Core/Util/SlotMap.h"
 #include "Core/Util/ThreadProtector.h"
 
 
@@ -41,6 +43,10 @@ namespace gr
 		template<typename T>
 		void SetObjectData(gr::RenderDataID, T const*);
 
+		// Bulk update: Sets data of a single type for many render objects. The data is moved from
+		template<typename T>
+		void SetObjectData(std::span<const gr::RenderDataID>, std::span<T>);
+
 		// To ensure this is thread safe, objects can only be accessed once all updates are complete (i.e. after all
 		// render commands have been executed)
 		template<typename T>
@@ -86,6 +92,11 @@ namespace gr
 		template<typename... Ts>
 		[[nodiscard]] std::vector<gr::RenderDataID> GetIDsWithAnyDirtyData(gr::FeatureBitmask = RenderObjectFeature::None) const;
 
+		// As above, but populates the supplied vector (existing contents are cleared) to avoid per-frame allocations
+		template<typename... Ts>
+		void GetIDsWithAnyDirtyData(
+			std::vector<gr::RenderDataID>& dirtyIDsOut, gr::FeatureBitmask = RenderObjectFeature::None) const;
+
 		template<typename T>
 		[[nodiscard]] bool IsDirty(gr::RenderDataID) const;
 
@@ -102,7 +113,8 @@ namespace gr
 		
 		[[nodiscard]] gr::FeatureBitmask GetFeatureBits(gr::RenderDataID) const;
 
-		// Get IDs associated with a type
+		// Get IDs associated with a type, in the same order as the type's data. Destroying data moves the last element
+		// into the destroyed element's slot, so the order changes whenever data of that type is destroyed
 		template<typename T>
 		[[nodiscard]] std::vector<gr::RenderDataID> const* GetRegisteredRenderDataIDs() const;
 
@@ -122,17 +134,14 @@ namespace gr
 		template<typename T, typename Next, typename... Rest>
 		[[nodiscard]] bool HasAnyDirtyDataInternal() const;
 
+		// Words of bits for 64 render objects, starting at render object index wordIdx * 64:
 		template<typename T>
-		[[nodiscard]] void GetIDsWithAnyDirtyDataInternal(std::vector<gr::RenderDataID>&) const;
-
-		template<typename T, typename Next, typename... Rest>
-		[[nodiscard]] void GetIDsWithAnyDirtyDataInternal(std::vector<gr::RenderDataID>&) const;
+		[[nodiscard]] uint64_t GetDirtyObjectsWord(size_t wordIdx) const;
 
 		template<typename T>
-		[[nodiscard]] size_t GetNumberOfDirtyIDs() const;
+		[[nodiscard]] uint64_t GetObjectsWithDataWord(size_t wordIdx) const;
 
-		template<typename T, typename Next, typename... Rest>
-		[[nodiscard]] size_t GetNumberOfDirtyIDs() const;
+		[[nodiscard]] uint64_t GetObjectsWithFeaturesWord(gr::FeatureBitmask, size_t wordIdx) const;
 
 
 	private:
@@ -145,6 +154,7 @@ namespace gr
 
 	public:
 		void SetTransformData(gr::TransformID, gr::Transform::RenderData const&);
+		void SetTransformData(std::span<const gr::TransformID>, std::span<const gr::Transform::RenderData>); // Bulk
 		
 		[[nodiscard]] gr::Transform::RenderData const& GetTransformDataFromTransformID(gr::TransformID) const;
 
@@ -179,16 +189,17 @@ namespace gr
 	private:
 		typedef uint8_t DataTypeIndex;
 		typedef uint32_t DataIndex;
-		typedef std::map<DataTypeIndex, DataIndex> ObjectTypeToDataIndexMap; // [data type index] == object index
+		static constexpr DataIndex k_invalidDataIdx = std::numeric_limits<DataIndex>::max();
 
-		typedef std::map<DataTypeIndex, uint64_t> LastDirtyFrameMap; // [data type index] == last dirty frame
 		static constexpr uint64_t k_invalidDirtyFrameNum = std::numeric_limits<uint64_t>::max();
 
+		static constexpr uint8_t k_numFeatureBits =
+			std::bit_width(static_cast<FeatureBitmask>(RenderObjectFeature::Invalid - 1));
+
+		// Note: The data indexes and dirty frames of each render object are stored in per-type tables, indexed by the
+		// object's dense index in m_renderObjectMetadata
 		struct RenderObjectMetadata
 		{
-			ObjectTypeToDataIndexMap m_dataTypeToDataIndexMap;
-			LastDirtyFrameMap m_dirtyFrameMap;
-
 			gr::TransformID m_transformID;
 
 			FeatureBitmask m_featureBits; // To assist in interpreting render data
@@ -199,10 +210,10 @@ namespace gr
 				: m_transformID(transformID), m_featureBits(0), m_referenceCount(1) {}
 			RenderObjectMetadata() = delete;
 		};
+		typedef util::SlotMap<gr::RenderDataID, RenderObjectMetadata> RenderObjectSlotMap;
 
 		struct TransformMetadata
 		{
-			DataIndex m_transformIdx;
 			uint32_t m_referenceCount;
 
 			uint64_t m_dirtyFrame;
@@ -213,6 +224,7 @@ namespace gr
 		std::vector<gr::RenderDataID> m_registeredRenderObjectIDs;
 		std::vector<gr::TransformID> m_registeredTransformIDs;
 
+		// Per-type registered IDs are stored in the same order as the data they own: [data type index][data index]
 		std::vector<std::vector<gr::RenderDataID>> m_perTypeRegisteredRenderDataIDs;
 
 		// New IDs/IDs with new types of data added in the current frame
@@ -222,12 +234,15 @@ namespace gr
 		std::vector<std::vector<gr::RenderDataID>> m_perFramePerTypeDeletedDataIDs;
 
 		std::vector<gr::RenderDataID> m_perFrameDeletedDataIDs; // IDs with ANY deleted data, regardless of type
-		std::unordered_set<gr::RenderDataID> m_perFrameSeenDeletedDataIDs; 
+		util::DenseBitset m_perFrameDeletedDataObjectBits; // [render object index]
 
-		// IDs that had data of a given type modified in the current frame. We track the IDs we've modified so we don't 
-		// double-add IDs to the vector
+		// IDs that had data of a given type modified in the current frame. We track the objects we've modified in
+		// bitsets so we don't double-add IDs to the vector, and to allow word-parallel dirty queries
 		std::vector<std::vector<gr::RenderDataID>> m_perFramePerTypeDirtyDataIDs;
-		std::vector<std::unordered_set<gr::RenderDataID>> m_perFramePerTypeDirtySeenDataIDs; 
+		std::vector<util::DenseBitset> m_perFramePerTypeDirtyObjectBits; // [data type index][render object index]
+
+		std::vector<util::DenseBitset> m_perTypeObjectHasDataBits; // [data type index][render object index]
+		std::array<util::DenseBitset, k_numFeatureBits> m_perFeatureObjectBits; // [feature bit][render object index]
 		
 
 		// Transforms:
@@ -235,7 +250,8 @@ namespace gr
 		std::vector<gr::TransformID> m_perFrameDeletedTransformIDs;
 
 		std::vector<gr::TransformID> m_perFrameDirtyTransformIDs;
-		std::unordered_set<gr::TransformID> m_perFrameSeenDirtyTransformIDs;
+		util::DenseBitset m_perFrameDirtyTransformBits; // [transform index]
+		util::DenseBitset m_perFrameDirtyTransformObjectBits; // [render object index]: Objects with a dirty Transform
 
 		// Multiple RenderDataIDs can share the same TransformID
 		std::unordered_multimap<gr::TransformID, gr::RenderDataID> m_transformToRenderDataIDs;
@@ -310,8 +326,8 @@ namespace gr
 			friend class gr::RenderDataManager;
 			ObjectIterator(
 				gr::RenderDataManager const* renderData,
-				std::unordered_map<gr::RenderDataID, RenderObjectMetadata>::const_iterator renderObjectMetadataBeginItr,
-				std::unordered_map<gr::RenderDataID, RenderObjectMetadata>::const_iterator const renderObjectMetadataEndItr,
+				uint32_t renderObjectBeginIdx,
+				uint32_t renderObjectEndIdx,
 				std::tuple<Ts const*...> endPtrs,
 				uint64_t currentFrame,
 				FeatureBitmask featureMask);
@@ -359,7 +375,9 @@ namespace gr
 
 		private:
 			template <typename T>
-			T const* GetPtrFromCurrentObjectDataIndicesItr() const;
+			T const* GetPtrFromCurrentObjectIdx() const;
+
+			RenderObjectMetadata const& GetCurrentObjectMetadata() const;
 
 			template<typename T, typename Next, typename... Rest>
 			bool AnyDirtyHelper() const;
@@ -373,8 +391,8 @@ namespace gr
 			std::tuple<Ts const*...> m_endPtrs;
 
 			gr::RenderDataManager const* m_renderData;
-			std::unordered_map<gr::RenderDataID, RenderObjectMetadata>::const_iterator m_renderObjectMetadataItr;
-			std::unordered_map<gr::RenderDataID, RenderObjectMetadata>::const_iterator const m_renderObjectMetadataEndItr;
+			uint32_t m_renderObjectIdx; // Dense index in RenderDataManager::m_renderObjectMetadata
+			uint32_t m_renderObjectEndIdx;
 
 			uint64_t m_currentFrame;
 			FeatureBitmask m_featureMask;
@@ -387,7 +405,7 @@ namespace gr
 
 		// Iterate over objects via std containers of RenderDataIDs. This is largely a convenience iterator; it functions 
 		// similarly to calling RenderDataManager::GetObjectData with each RenderDataID in the supplied container, except
-		// the results of the RenderDataID -> RenderObjectMetadata lookup are cached when the iterator is incremented.
+		// the results of the RenderDataID -> RenderObjectMetadata slot lookup are cached when the iterator is incremented.
 		// RenderDataManager iterators are not thread safe.
 		template<typename Container>
 		class IDIterator
@@ -398,7 +416,6 @@ namespace gr
 				gr::RenderDataManager const*, 
 				Container::const_iterator,
 				Container::const_iterator,
-				std::unordered_map<gr::RenderDataID, RenderObjectMetadata> const*,
 				uint64_t currentFrame,
 				RenderObjectFeature featureMask);
 
@@ -440,14 +457,19 @@ namespace gr
 			friend bool operator!=(IDIterator const& lhs, IDIterator const& rhs) { return lhs.m_idsIterator != rhs.m_idsIterator; }
 
 
+		private:
+			RenderObjectMetadata const& GetCurrentObjectMetadata() const;
+
+			void SkipFilteredIDs(); // Advance to the first ID (inclusive) that has all of the feature mask bits
+
+
 		private:
 			gr::RenderDataManager const* m_renderData;
 			Container::const_iterator m_idsIterator;
 			Container::const_iterator const m_idsEndIterator;
 
-			std::unordered_map<gr::RenderDataID, RenderObjectMetadata> const* m_IDToRenderObjectMetadata;
-			std::unordered_map<gr::RenderDataID, RenderObjectMetadata>::const_iterator m_currentObjectMetadata;
-
+			// Dense slot of the current object's metadata. Generational, to catch modifications during iteration
+			RenderObjectSlotMap::Handle m_currentObjectHandle;
 
 			uint64_t m_currentFrame;
 			RenderObjectFeature m_featureMask;
@@ -478,15 +500,32 @@ namespace gr
 		template<typename T>
 		DataTypeIndex GetAllocateDataIndexFromType();
 
+		// Data type tables must already exist for the data type index
+		template<typename T, typename DataType>
+		void SetObjectDataInternal(std::vector<T>&, DataTypeIndex, gr::RenderDataID, DataType&&);
+
+		void SetTransformDataInternal(gr::TransformID, gr::Transform::RenderData const&);
+
 		template<typename T>
 		DataTypeIndex GetDataIndexFromType() const;
 
 		template<typename T>
 		T const* GetObjectDataVectorIfExists(DataIndex) const;
 
+		template<typename T>
+		T const& GetObjectDataFromObjectIdx(uint32_t renderObjectIdx) const;
+
 		template <typename T>
 		T const* GetEndPtr() const; // Iterator begin/end helper
 
+		void AddDataTypeTables(DataTypeIndex); // Ensure all per-type tables have an entry for the data type index
+
+		void AddRenderObjectSlot(gr::TransformID); // Append an entry for the newest render object to per-object tables
+		void RemoveRenderObjectSlot(uint32_t renderObjectIdx); // Swap-and-pop the entry from the per-object tables
+
+		DataIndex GetDataIndex(DataTypeIndex, uint32_t renderObjectIdx) const; // k_invalidDataIdx if no data exists
+		uint64_t GetDirtyFrame(DataTypeIndex, uint32_t renderObjectIdx) const;
+
 
 	private:
 		static constexpr DataTypeIndex k_invalidDataTypeIdx = std::numeric_limits<DataTypeIndex>::max();
@@ -495,17 +534,21 @@ namespace gr
 
 		// Each type of render data is tightly packed into an array maintained in m_dataVectors
 		std::map<size_t, DataTypeIndex> m_typeInfoHashToDataVectorIdx;
-		std::vector<std::shared_ptr<void>> m_dataVectors; // Use shared_ptr because it type erases
+		std::vector<std::shared_ptr<void>> m_dataVectors; // Use shared_ptr because it type erases. Access via get()
 
 		// Render objects are represented as a set of indexes into arrays of typed data (meshes, materials, etc).
 		// Each render object maps to 0 or 1 instance of each data type
-		std::unordered_map<gr::RenderDataID, RenderObjectMetadata> m_IDToRenderObjectMetadata;
+		RenderObjectSlotMap m_renderObjectMetadata;
+
+		// Per-type tables, parallel to the dense render object slots: [data type index][render object index]
+		std::vector<std::vector<DataIndex>> m_perTypeObjectDataIndexes; // k_invalidDataIdx if the object has no data
+		std::vector<std::vector<uint64_t>> m_perTypeObjectDirtyFrames;
 
 		// Every render object has a transform, but many render objects share the same transform (E.g. mesh primitives).
 		// We expect Transforms to be both our largest and most frequently updated data mirrored in RenderDataManager, so we
 		// treat them as a special case to allow sharing
-		std::unordered_map<gr::TransformID, TransformMetadata> m_transformIDToTransformMetadata;
-		std::vector<gr::Transform::RenderData> m_transformRenderData;
+		util::SlotMap<gr::TransformID, TransformMetadata> m_transformMetadata;
+		std::vector<gr::Transform::RenderData> m_transformRenderData; // Parallel to the dense m_transformMetadata slots
 
 		// RenderDataManager accesses are all const, and we only update the RenderData via RenderCommands which are processed
 		// single-threaded at the beginning of a render thread frame. Thus, we don't have any syncronization primitives;
@@ -629,61 +672,75 @@ namespace gr
 		util::ScopedThreadProtector threadProjector(m_threadProtector);
 
 		SEAssert(s_dataTypeIndex < m_dataVectors.size(), "Data type index is OOB");
-		std::vector<T>& dataVector = *std::static_pointer_cast<std::vector<T>>(m_dataVectors[s_dataTypeIndex]).get();
+		std::vector<T>& dataVector = *static_cast<std::vector<T>*>(m_dataVectors[s_dataTypeIndex].get());
 
-		SEAssert(m_IDToRenderObjectMetadata.contains(renderDataID), "Invalid object ID");
-		RenderObjectMetadata& renderObjectMetadata = m_IDToRenderObjectMetadata.at(renderDataID);
+		// If our tracking tables don't have enough room for the data type index, increase their size
+		AddDataTypeTables(s_dataTypeIndex);
+
+		SetObjectDataInternal(dataVector, s_dataTypeIndex, renderDataID, *data);
+	}
+
+
+	template<typename T>
+	void RenderDataManager::SetObjectData(std::span<const gr::RenderDataID> renderDataIDs, std::span<T> data)
+	{
+		SEAssert(renderDataIDs.size() == data.size(), "Received a mismatched number of RenderDataIDs and data");
+
+		static const DataTypeIndex s_dataTypeIndex = GetAllocateDataIndexFromType<T>();
+
+		// Catch illegal accesses during RenderData modification
+		util::ScopedThreadProtector threadProjector(m_threadProtector);
+
+		SEAssert(s_dataTypeIndex < m_dataVectors.size(), "Data type index is OOB");
+		std::vector<T>& dataVector = *static_cast<std::vector<T>*>(m_dataVectors[s_dataTypeIndex].get());
 
 		// If our tracking tables don't have enough room for the data type index, increase their size
-		if (s_dataTypeIndex >= m_perTypeRegisteredRenderDataIDs.size())
-		{
-			m_perTypeRegisteredRenderDataIDs.resize(s_dataTypeIndex + 1);
-		}
-		if (s_dataTypeIndex >= m_perFramePerTypeNewDataIDs.size())
-		{
-			m_perFramePerTypeNewDataIDs.resize(s_dataTypeIndex + 1);
-		}
-		if (s_dataTypeIndex >= m_perFramePerTypeDeletedDataIDs.size())
-		{
-			m_perFramePerTypeDeletedDataIDs.resize(s_dataTypeIndex + 1);
-		}
-		if (s_dataTypeIndex >= m_perFramePerTypeDirtyDataIDs.size())
-		{
-			m_perFramePerTypeDirtyDataIDs.resize(s_dataTypeIndex + 1);
-		}
-		if (s_dataTypeIndex >= m_perFramePerTypeDirtySeenDataIDs.size())
+		AddDataTypeTables(s_dataTypeIndex);
+
+		// Scatter the packed data to each object's slot. Elements are moved, so data owning heap allocations (e.g.
+		// skinning matrices) is never deep-copied
+		for (size_t i = 0; i < renderDataIDs.size(); ++i)
 		{
-			m_perFramePerTypeDirtySeenDataIDs.resize(s_dataTypeIndex + 1);
+			SetObjectDataInternal(dataVector, s_dataTypeIndex, renderDataIDs[i], std::move(data[i]));
 		}
+	}
+
+
+	template<typename T, typename DataType>
+	void RenderDataManager::SetObjectDataInternal(
+		std::vector<T>& dataVector, DataTypeIndex dataTypeIndex, gr::RenderDataID renderDataID, DataType&& data)
+	{
+		const uint32_t renderObjectIdx = m_renderObjectMetadata.GetIndex(renderDataID);
+		SEAssert(renderObjectIdx != RenderObjectSlotMap::k_invalidIndex, "Invalid object ID");
 
 		// Add/update the dirty frame number:
-		renderObjectMetadata.m_dirtyFrameMap[s_dataTypeIndex] = m_currentFrame;
+		m_perTypeObjectDirtyFrames[dataTypeIndex][renderObjectIdx] = m_currentFrame;
 
 		// Get the index of the data in data vector for its type
-		auto const& objectTypeToDataIndex = renderObjectMetadata.m_dataTypeToDataIndexMap.find(s_dataTypeIndex);
-		if (objectTypeToDataIndex == renderObjectMetadata.m_dataTypeToDataIndexMap.end())
+		DataIndex& dataIndex = m_perTypeObjectDataIndexes[dataTypeIndex][renderObjectIdx];
+		if (dataIndex == k_invalidDataIdx)
 		{
 			// This is the first time we've added data for this object, we must store the destination index
-			const DataIndex newDataIndex = util::CheckedCast<DataIndex>(dataVector.size());
-			dataVector.emplace_back(*data);
-			renderObjectMetadata.m_dataTypeToDataIndexMap.emplace(s_dataTypeIndex , newDataIndex);
+			dataIndex = util::CheckedCast<DataIndex>(dataVector.size());
+			dataVector.emplace_back(std::forward<DataType>(data));
+
+			m_perTypeObjectHasDataBits[dataTypeIndex].Set(renderObjectIdx);
 
-			// Record the RenderDataID in our per-type registration list
-			m_perTypeRegisteredRenderDataIDs[s_dataTypeIndex].emplace_back(renderDataID);
+			// Record the RenderDataID in our per-type registration list, at the same index as the data
+			m_perTypeRegisteredRenderDataIDs[dataTypeIndex].emplace_back(renderDataID);
 
 			// Record the RenderDataID in the per-frame new data type tracker:
-			m_perFramePerTypeNewDataIDs[s_dataTypeIndex].emplace_back(renderDataID);
+			m_perFramePerTypeNewDataIDs[dataTypeIndex].emplace_back(renderDataID);
 		}
 		else
 		{
-			const DataIndex dataIndex = objectTypeToDataIndex->second;
-			dataVector[dataIndex] = *data;
+			dataVector[dataIndex] = std::forward<DataType>(data);
 		}
 
 		// Record the RenderDataID in the per-frame dirty data tracker:
-		if (m_perFramePerTypeDirtySeenDataIDs[s_dataTypeIndex].emplace(renderDataID).second)
+		if (!m_perFramePerTypeDirtyObjectBits[dataTypeIndex].TestAndSet(renderObjectIdx))
 		{
-			m_perFramePerTypeDirtyDataIDs[s_dataTypeIndex].emplace_back(renderDataID);
+			m_perFramePerTypeDirtyDataIDs[dataTypeIndex].emplace_back(renderDataID);
 		}
 	}
 
@@ -696,20 +753,25 @@ namespace gr
 
 		m_threadProtector.ValidateThreadAccess(); // Any thread can get data so long as no modification is happening
 
-		SEAssert(m_IDToRenderObjectMetadata.contains(renderDataID), "renderDataID is not registered");
+		const uint32_t renderObjectIdx = m_renderObjectMetadata.GetIndex(renderDataID);
+		SEAssert(renderObjectIdx != RenderObjectSlotMap::k_invalidIndex, "renderDataID is not registered");
 
+		return GetObjectDataFromObjectIdx<T>(renderObjectIdx);
+	}
+
+
+	template<typename T>
+	T const& RenderDataManager::GetObjectDataFromObjectIdx(uint32_t renderObjectIdx) const
+	{
 		const DataTypeIndex dataTypeIndex = GetDataIndexFromType<T>();
 		SEAssert(dataTypeIndex != k_invalidDataTypeIdx && dataTypeIndex < m_dataVectors.size(),
 			"Invalid data type index. This suggests we're accessing data of a specific type using an index, when "
 			"no data of that type exists");
-		
-		RenderObjectMetadata const& renderObjectMetadata = m_IDToRenderObjectMetadata.at(renderDataID);
-		SEAssert(renderObjectMetadata.m_dataTypeToDataIndexMap.contains(dataTypeIndex),
-			"Metadata does not have an entry for the current data type");
 
-		const DataIndex dataIdx = renderObjectMetadata.m_dataTypeToDataIndexMap.find(dataTypeIndex)->second;
+		const DataIndex dataIdx = GetDataIndex(dataTypeIndex, renderObjectIdx);
+		SEAssert(dataIdx != k_invalidDataIdx, "Metadata does not have an entry for the current data type");
 
-		std::vector<T> const& dataVector = *std::static_pointer_cast<std::vector<T>>(m_dataVectors[dataTypeIndex]).get();
+		std::vector<T> const& dataVector = *static_cast<std::vector<T> const*>(m_dataVectors[dataTypeIndex].get());
 		SEAssert(dataIdx < dataVector.size(), "Object index is OOB");
 
 		return dataVector[dataIdx];
@@ -726,7 +788,8 @@ namespace gr
 
 		m_threadProtector.ValidateThreadAccess(); // Any thread can get data so long as no modification is happening
 
-		SEAssert(m_IDToRenderObjectMetadata.contains(renderDataID), "renderDataID is not registered");
+		const uint32_t renderObjectIdx = m_renderObjectMetadata.GetIndex(renderDataID);
+		SEAssert(renderObjectIdx != RenderObjectSlotMap::k_invalidIndex, "renderDataID is not registered");
 
 		const DataTypeIndex dataTypeIndex = GetDataIndexFromType<T>();
 		SEAssert(dataTypeIndex == k_invalidDataTypeIdx || dataTypeIndex < m_dataVectors.size(),
@@ -734,9 +797,7 @@ namespace gr
 
 		if (dataTypeIndex != k_invalidDataTypeIdx)
 		{
-			RenderObjectMetadata const& renderObjectMetadata = m_IDToRenderObjectMetadata.at(renderDataID);
-
-			return renderObjectMetadata.m_dataTypeToDataIndexMap.contains(dataTypeIndex);
+			return GetDataIndex(dataTypeIndex, renderObjectIdx) != k_invalidDataIdx;
 		}
 		return false;
 	}
@@ -754,7 +815,7 @@ namespace gr
 	{
 		if constexpr (std::is_same_v<T, gr::Transform::RenderData>)
 		{
-			return !m_transformIDToTransformMetadata.empty();
+			return !m_transformMetadata.IsEmpty();
 		}
 
 		m_threadProtector.ValidateThreadAccess(); // Any thread can get data so long as no modification is happening
@@ -923,138 +984,112 @@ namespace gr
 	}
 
 
-	template<typename T>
-	void RenderDataManager::GetIDsWithAnyDirtyDataInternal(std::vector<gr::RenderDataID>& dirtyIDs) const
+	template<typename... Ts>
+	std::vector<gr::RenderDataID> RenderDataManager::GetIDsWithAnyDirtyData(
+		gr::FeatureBitmask featureBits /*= RenderObjectFeature::None*/) const
+	{
+		std::vector<gr::RenderDataID> dirtyIDs;
+		GetIDsWithAnyDirtyData<Ts...>(dirtyIDs, featureBits);
+		return dirtyIDs;
+	}
+
+
+	template<typename... Ts>
+	void RenderDataManager::GetIDsWithAnyDirtyData(
+		std::vector<gr::RenderDataID>& dirtyIDsOut, gr::FeatureBitmask featureBits /*= RenderObjectFeature::None*/) const
 	{
 		m_threadProtector.ValidateThreadAccess(); // Any thread can get data so long as no modification is happening
 
-		if constexpr (std::is_same_v<T, gr::Transform::RenderData>)
-		{
-			std::vector<gr::TransformID> const& dirtyTransformIDs = GetIDsWithDirtyTransformData();
+		dirtyIDsOut.clear();
 
-			for (gr::TransformID transformID : dirtyTransformIDs)
+		const bool hasDirtyData = ([this]()
 			{
-				auto renderDataIDs = m_transformToRenderDataIDs.equal_range(transformID);
-				while (renderDataIDs.first != renderDataIDs.second)
+				if constexpr (std::is_same_v<Ts, gr::Transform::RenderData>)
 				{
-					dirtyIDs.emplace_back(renderDataIDs.first->second);
-					++renderDataIDs.first;
+					return !m_perFrameDirtyTransformIDs.empty();
 				}
-			}
+				else
+				{
+					std::vector<gr::RenderDataID> const* dirtyIDs = GetIDsWithDirtyData<Ts>();
+					return dirtyIDs != nullptr && !dirtyIDs->empty();
+				}
+			}() || ...);
+		if (!hasDirtyData)
+		{
+			return; // Early out
 		}
-		else
+
+		// The per-object bitsets are all indexed by render object index, so we can combine them 64 objects at a time:
+		// We want objects with ANY of the Ts dirty, that have ALL of the Ts and feature bits
+		const size_t numWords = util::DenseBitset::GetNumWords(m_renderObjectMetadata.Size());
+		for (size_t wordIdx = 0; wordIdx < numWords; ++wordIdx)
 		{
-			std::vector<gr::RenderDataID> const* dirtyTs = GetIDsWithDirtyData<T>();
-			if (dirtyTs)
+			uint64_t objectBits = (GetDirtyObjectsWord<Ts>(wordIdx) | ...);
+			if (objectBits == 0)
 			{
-				dirtyIDs.insert(dirtyIDs.end(), dirtyTs->begin(), dirtyTs->end());
+				continue;
 			}
-		}
-	}
 
+			objectBits &= (GetObjectsWithDataWord<Ts>(wordIdx) & ...);
+			objectBits &= GetObjectsWithFeaturesWord(featureBits, wordIdx);
 
-	template<typename T, typename Next, typename... Rest>
-	void RenderDataManager::GetIDsWithAnyDirtyDataInternal(std::vector<gr::RenderDataID>& uniqueDirtyIDs) const
-	{
-		m_threadProtector.ValidateThreadAccess(); // Any thread can get data so long as no modification is happening
-
-		GetIDsWithAnyDirtyDataInternal<T>(uniqueDirtyIDs);
-		GetIDsWithAnyDirtyDataInternal<Next, Rest...>(uniqueDirtyIDs);
+			util::DenseBitset::ForEachSetBit(objectBits, wordIdx,
+				[this, &dirtyIDsOut](size_t renderObjectIdx)
+				{
+					dirtyIDsOut.emplace_back(
+						m_renderObjectMetadata.GetKeyAt(util::CheckedCast<uint32_t>(renderObjectIdx)));
+				});
+		}
 	}
 
 
-	template<typename... Ts>
-	std::vector<gr::RenderDataID> RenderDataManager::GetIDsWithAnyDirtyData(
-		gr::FeatureBitmask featureBits /*= RenderObjectFeature::None*/) const
+	template<typename T>
+	uint64_t RenderDataManager::GetDirtyObjectsWord(size_t wordIdx) const
 	{
-		m_threadProtector.ValidateThreadAccess(); // Any thread can get data so long as no modification is happening
-
-		const size_t numDirtyIDs = GetNumberOfDirtyIDs<Ts...>(); // Likely an over-estimation
-		if (numDirtyIDs == 0)
+		if constexpr (std::is_same_v<T, gr::Transform::RenderData>)
 		{
-			return {}; // Early out
+			return m_perFrameDirtyTransformObjectBits.GetWord(wordIdx);
 		}
-
-		// Concatenate a list of all dirty RenderDataIDs for each type:
-		std::vector<gr::RenderDataID> dirtyIDs;
-		dirtyIDs.reserve(numDirtyIDs);
-		
-		GetIDsWithAnyDirtyDataInternal<Ts...>(dirtyIDs);
-		SEAssert(dirtyIDs.size() <= numDirtyIDs, "Found more dirty IDs than anticipated. This should not be possible");
-
-		// Post-process the RenderDataIDs in-place to remove duplicates or IDs that don't own ALL of the required types
-		std::unordered_set<gr::RenderDataID> seenIDs;
-		seenIDs.reserve(dirtyIDs.size());
-
-		auto idItr = dirtyIDs.begin();
-		while (idItr != dirtyIDs.end())
+		else
 		{
-			const gr::RenderDataID curID = *idItr;
-
-			// We return a list of unique IDs, that contains all of the types
-			// If we've seen this ID, or it doesn't have all the types/feature bits, remove it
-			if (seenIDs.contains(curID) || 
-				!HasObjectData<Ts...>(curID) ||
-				(featureBits != RenderObjectFeature::None && !HasAllFeatures(featureBits, GetFeatureBits(curID))))
-			{
-				bool isLast = false;
-				auto lastElementItr = std::prev(dirtyIDs.end());
-				if (lastElementItr != idItr)
-				{
-					*idItr = *lastElementItr;
-				}
-				else
-				{
-					isLast = true;
-				}
-				dirtyIDs.pop_back();
-
-				seenIDs.emplace(curID);
-
-				if (dirtyIDs.empty() || isLast)
-				{
-					break;
-				}
-			}
-			else
+			const DataTypeIndex dataTypeIndex = GetDataIndexFromType<T>();
+			if (dataTypeIndex >= m_perFramePerTypeDirtyObjectBits.size()) // Also handles k_invalidDataTypeIdx
 			{
-				seenIDs.emplace(curID);
-				++idItr;
+				return 0;
 			}
+			return m_perFramePerTypeDirtyObjectBits[dataTypeIndex].GetWord(wordIdx);
 		}
-
-		return dirtyIDs;
 	}
 
 
 	template<typename T>
-	size_t RenderDataManager::GetNumberOfDirtyIDs() const
+	uint64_t RenderDataManager::GetObjectsWithDataWord(size_t wordIdx) const
 	{
-		m_threadProtector.ValidateThreadAccess(); // Any thread can get data so long as no modification is happening
-
 		if constexpr (std::is_same_v<T, gr::Transform::RenderData>)
 		{
-			size_t count = 0;
-			std::vector<gr::TransformID> const& dirtyTransformIDs = GetIDsWithDirtyTransformData();
-			for (gr::TransformID transformID : dirtyTransformIDs)
-			{
-				auto renderDataIDsItr = m_transformToRenderDataIDs.equal_range(transformID);
-				count += std::distance(renderDataIDsItr.first, renderDataIDsItr.second);
-			}
-			return count;
+			return std::numeric_limits<uint64_t>::max(); // All RenderDataIDs are associated with a Transform
 		}
 		else
 		{
-			std::vector<gr::RenderDataID> const* dirtyIDs = GetIDsWithDirtyData<T>();
-			return dirtyIDs ? dirtyIDs->size() : 0;
+			const DataTypeIndex dataTypeIndex = GetDataIndexFromType<T>();
+			if (dataTypeIndex >= m_perTypeObjectHasDataBits.size()) // Also handles k_invalidDataTypeIdx
+			{
+				return 0;
+			}
+			return m_perTypeObjectHasDataBits[dataTypeIndex].GetWord(wordIdx);
 		}
 	}
 
 
-	template<typename T, typename Next, typename... Rest>
-	size_t RenderDataManager::GetNumberOfDirtyIDs() const
+	inline uint64_t RenderDataManager::GetObjectsWithFeaturesWord(gr::FeatureBitmask featureBits, size_t wordIdx) const
 	{
-		return GetNumberOfDirtyIDs<T>() + GetNumberOfDirtyIDs<Next, Rest...>();
+		uint64_t objectBits = std::numeric_limits<uint64_t>::max();
+		util::DenseBitset::ForEachSetBit(featureBits, 0,
+			[this, wordIdx, &objectBits](size_t featureBitIdx)
+			{
+				objectBits &= m_perFeatureObjectBits[featureBitIdx].GetWord(wordIdx);
+			});
+		return objectBits;
 	}
 
 
@@ -1066,23 +1101,21 @@ namespace gr
 
 		m_threadProtector.ValidateThreadAccess(); // Any thread can get data so long as no modification is happening
 
-		SEAssert(m_IDToRenderObjectMetadata.contains(renderDataID), "renderDataID is not registered");
+		const uint32_t renderObjectIdx = m_renderObjectMetadata.GetIndex(renderDataID);
+		SEAssert(renderObjectIdx != RenderObjectSlotMap::k_invalidIndex, "renderDataID is not registered");
 
 		const DataTypeIndex dataTypeIndex = GetDataIndexFromType<T>();
 		SEAssert(dataTypeIndex != k_invalidDataTypeIdx && dataTypeIndex < m_dataVectors.size(),
 			"Invalid data type index. This suggests we're accessing data of a specific type using an index, when "
 			"no data of that type exists");
 
-		RenderObjectMetadata const& renderObjectMetadata = m_IDToRenderObjectMetadata.at(renderDataID);
-		SEAssert(renderObjectMetadata.m_dirtyFrameMap.contains(dataTypeIndex),
-			"Metadata dirty frame map does not have an entry for the current data type");
-		
-		SEAssert(renderObjectMetadata.m_dirtyFrameMap.at(dataTypeIndex) != k_invalidDirtyFrameNum &&
-			renderObjectMetadata.m_dirtyFrameMap.at(dataTypeIndex) <= m_currentFrame &&
+		const uint64_t dirtyFrame = GetDirtyFrame(dataTypeIndex, renderObjectIdx);
+		SEAssert(dirtyFrame != k_invalidDirtyFrameNum &&
+			dirtyFrame <= m_currentFrame &&
 			m_currentFrame != k_invalidDirtyFrameNum,
 			"Invalid dirty frame value");
 
-		return renderObjectMetadata.m_dirtyFrameMap.at(dataTypeIndex) == m_currentFrame;
+		return dirtyFrame == m_currentFrame;
 	}
 
 
@@ -1097,12 +1130,37 @@ namespace gr
 			return nullptr;
 		}
 		
-		std::vector<T> const& dataVector = *std::static_pointer_cast<std::vector<T>>(m_dataVectors[dataTypeIndex]).get();
+		std::vector<T> const& dataVector = *static_cast<std::vector<T> const*>(m_dataVectors[dataTypeIndex].get());
 
 		return dataIndex < dataVector.size() ? &dataVector[dataIndex] : nullptr;
 	}
 
 
+	inline RenderDataManager::DataIndex RenderDataManager::GetDataIndex(
+		DataTypeIndex dataTypeIndex, uint32_t renderObjectIdx) const
+	{
+		if (dataTypeIndex >= m_perTypeObjectDataIndexes.size()) // Also handles k_invalidDataTypeIdx
+		{
+			return k_invalidDataIdx;
+		}
+		SEAssert(renderObjectIdx < m_perTypeObjectDataIndexes[dataTypeIndex].size(), "Render object index is OOB");
+
+		return m_perTypeObjectDataIndexes[dataTypeIndex][renderObjectIdx];
+	}
+
+
+	inline uint64_t RenderDataManager::GetDirtyFrame(DataTypeIndex dataTypeIndex, uint32_t renderObjectIdx) const
+	{
+		if (dataTypeIndex >= m_perTypeObjectDirtyFrames.size()) // Also handles k_invalidDataTypeIdx
+		{
+			return k_invalidDirtyFrameNum;
+		}
+		SEAssert(renderObjectIdx < m_perTypeObjectDirtyFrames[dataTypeIndex].size(), "Render object index is OOB");
+
+		return m_perTypeObjectDirtyFrames[dataTypeIndex][renderObjectIdx];
+	}
+
+
 	template<typename T>
 	uint32_t RenderDataManager::GetNumElementsOfType() const
 	{
@@ -1119,7 +1177,7 @@ namespace gr
 			return 0;
 		}
 
-		std::vector<T> const& dataVector = *std::static_pointer_cast<std::vector<T>>(m_dataVectors[dataTypeIndex]).get();
+		std::vector<T> const& dataVector = *static_cast<std::vector<T> const*>(m_dataVectors[dataTypeIndex].get());
 		
 		return util::CheckedCast<uint32_t>(dataVector.size());
 	}
@@ -1164,11 +1222,9 @@ namespace gr
 
 		m_threadProtector.ValidateThreadAccess(); // Any thread can get data so long as no modification is happening
 
-		SEAssert(m_IDToRenderObjectMetadata.contains(renderDataID), "Trying to find an object that does not exist");
-
-		RenderObjectMetadata const& renderObjectMetadata = m_IDToRenderObjectMetadata.at(renderDataID);
+		SEAssert(m_renderObjectMetadata.Contains(renderDataID), "Trying to find an object that does not exist");
 
-		return renderObjectMetadata.m_transformID;
+		return m_renderObjectMetadata.Get(renderDataID).m_transformID;
 	}
 
 
@@ -1257,96 +1313,51 @@ namespace gr
 		// Catch illegal accesses during RenderData modification
 		util::ScopedThreadProtector threadProjector(m_threadProtector);
 
-		SEAssert(dataTypeIndex < m_dataVectors.size(), "Data index is OOB");
-		SEAssert(m_IDToRenderObjectMetadata.contains(renderDataID), "Invalid object ID");
-		RenderObjectMetadata& renderObjectMetadata = m_IDToRenderObjectMetadata.at(renderDataID);
-		
-		SEAssert(renderObjectMetadata.m_dataTypeToDataIndexMap.contains(dataTypeIndex),
-			"Data type index is not found in the metadata table");
+		SEAssert(dataTypeIndex < m_dataVectors.size() && dataTypeIndex < m_perTypeObjectDataIndexes.size(),
+			"Data index is OOB");
 
-		SEAssert(dataTypeIndex < m_perTypeRegisteredRenderDataIDs.size(),
-			"Data type index is OOB of our per-type registration lists");
+		const uint32_t renderObjectIdx = m_renderObjectMetadata.GetIndex(renderDataID);
+		SEAssert(renderObjectIdx != RenderObjectSlotMap::k_invalidIndex, "Invalid object ID");
 
-		// Ensure we've got a vector allocated for the given data type in our deleted data ID tracker
-		if (dataTypeIndex >= m_perFramePerTypeDeletedDataIDs.size())
-		{
-			m_perFramePerTypeDeletedDataIDs.emplace_back();
-		}
+		std::vector<DataIndex>& objectDataIndexes = m_perTypeObjectDataIndexes[dataTypeIndex];
+		std::vector<gr::RenderDataID>& registeredIDs = m_perTypeRegisteredRenderDataIDs[dataTypeIndex];
+
+		SEAssert(objectDataIndexes[renderObjectIdx] != k_invalidDataIdx,
+			"Data type index is not found in the metadata table");
 
-		std::vector<T>& dataVector = *std::static_pointer_cast<std::vector<T>>(m_dataVectors[dataTypeIndex]).get();
+		std::vector<T>& dataVector = *static_cast<std::vector<T>*>(m_dataVectors[dataTypeIndex].get());
+		SEAssert(registeredIDs.size() == dataVector.size(), "Per-type registration list is out of sync");
 
-		// Replace our dead element with one from the end:
+		// Replace our dead element with one from the end. This reorders GetRegisteredRenderDataIDs<T>():
 		const DataIndex indexToMove = util::CheckedCast<DataIndex>(dataVector.size() - 1);
-		const DataIndex indexToReplace = renderObjectMetadata.m_dataTypeToDataIndexMap.find(dataTypeIndex)->second;
+		const DataIndex indexToReplace = objectDataIndexes[renderObjectIdx];
+
+		SEAssert(registeredIDs[indexToReplace] == renderDataID, "Per-type registration list is out of sync");
 
-		// Move the data:
+		// Move the data and its RenderDataID, and update the index stored by the object that owns it:
 		if (indexToMove != indexToReplace)
 		{
 			dataVector[indexToReplace] = dataVector[indexToMove];
-		}
-		dataVector.pop_back();
-
 
-		// Walk the list of RenderDataIDs in our registration list for the data type:
-		//	a) Update the table referencing the index we moved to its new location
-		//	b) Find the location of the RenderObjectID in our per-type registration list
-		//	When we've done both, we can stop searching
-		bool foundObjectTypeToDataIndexMap = false;
-		bool foundPerTypeRegistrationIndex = false;
-		size_t perTypeIDIndexToDelete = std::numeric_limits<size_t>::max();
-		for (size_t idIndex = 0; idIndex < m_perTypeRegisteredRenderDataIDs[dataTypeIndex].size(); idIndex++)
-		{
-			gr::RenderDataID currentRenderDataID = m_perTypeRegisteredRenderDataIDs[dataTypeIndex][idIndex];
-
-			// Check: Is this the index of per-type RenderObjectID record we'll be removing?
-			if (currentRenderDataID == renderDataID)
-			{
-				perTypeIDIndexToDelete = idIndex;
-				foundPerTypeRegistrationIndex = true;
-			}
-
-			if (!foundObjectTypeToDataIndexMap)
-			{
-				// Find the RenderObjectMetadata record we need to update:
-				auto idToObjectMetadataItr = m_IDToRenderObjectMetadata.find(currentRenderDataID);
-				SEAssert(idToObjectMetadataItr != m_IDToRenderObjectMetadata.end(),
-					"Could not find registered ID in the ID to object metadata map");
-
-				ObjectTypeToDataIndexMap& typeToIndexMapToUpdate =
-					idToObjectMetadataItr->second.m_dataTypeToDataIndexMap;
-
-				auto dataTypeToIndexItr = typeToIndexMapToUpdate.find(dataTypeIndex);
-				if (dataTypeToIndexItr != typeToIndexMapToUpdate.end() && dataTypeToIndexItr->second == indexToMove)
-				{
-					dataTypeToIndexItr->second = indexToReplace;
-
-					foundObjectTypeToDataIndexMap = true;
-				}
-			}			
-
-			if (foundObjectTypeToDataIndexMap && foundPerTypeRegistrationIndex)
-			{
-				break;
-			}
+			const gr::RenderDataID movedRenderDataID = registeredIDs[indexToMove];
+			registeredIDs[indexToReplace] = movedRenderDataID;
+			objectDataIndexes[m_renderObjectMetadata.GetIndex(movedRenderDataID)] = indexToReplace;
 		}
-		SEAssert(foundObjectTypeToDataIndexMap && foundPerTypeRegistrationIndex, "Matching object was not found. This should not be possible");
-
-		// Remove the RenderDataID from the per-type registration list:
-		m_perTypeRegisteredRenderDataIDs[dataTypeIndex].erase(
-			m_perTypeRegisteredRenderDataIDs[dataTypeIndex].begin() + perTypeIDIndexToDelete);
+		dataVector.pop_back();
+		registeredIDs.pop_back();
 
 		// Add the RenderDataID to the deleted data trackers:
 		m_perFramePerTypeDeletedDataIDs[dataTypeIndex].emplace_back(renderDataID);
 
-		if (!m_perFrameSeenDeletedDataIDs.contains(renderDataID))
+		if (!m_perFrameDeletedDataObjectBits.TestAndSet(renderObjectIdx))
 		{
 			m_perFrameDeletedDataIDs.emplace_back(renderDataID);
-			m_perFrameSeenDeletedDataIDs.emplace(renderDataID);
 		}
 
-		// Finally, remove the index in the object's data index map:
-		renderObjectMetadata.m_dataTypeToDataIndexMap.erase(dataTypeIndex);
-		renderObjectMetadata.m_dirtyFrameMap.erase(dataTypeIndex);
+		// Finally, remove the object's data index and dirty frame records:
+		objectDataIndexes[renderObjectIdx] = k_invalidDataIdx;
+		m_perTypeObjectDirtyFrames[dataTypeIndex][renderObjectIdx] = k_invalidDirtyFrameNum;
+		m_perTypeObjectHasDataBits[dataTypeIndex].Reset(renderObjectIdx);
 	}
 
 
@@ -1367,7 +1378,7 @@ namespace gr
 
 			// Guarantee there is always some backing memory allocated for our iterator .end() to reference
 			std::vector<T>& dataVector =
-				*std::static_pointer_cast<std::vector<T>>(m_dataVectors.back()).get();
+				*static_cast<std::vector<T>*>(m_dataVectors.back().get());
 
 			constexpr size_t k_expectedMaxNumDataTypes = 16; // Arbitrary
 			dataVector.reserve(k_expectedMaxNumDataTypes);
@@ -1408,7 +1419,7 @@ namespace gr
 		if (s_dataTypeIndex != k_invalidDataTypeIdx)
 		{
 			std::vector<T> const& dataVector = 
-				*std::static_pointer_cast<std::vector<T>>(m_dataVectors[s_dataTypeIndex]).get();
+				*static_cast<std::vector<T> const*>(m_dataVectors[s_dataTypeIndex].get());
 
 			return &dataVector.data()[dataVector.size()]; // Get the address without dereferencing it
 		}
@@ -1427,7 +1438,7 @@ namespace gr
 		const DataTypeIndex dataTypeIndex = GetDataIndexFromType<T>();
 		if (dataTypeIndex != k_invalidDataTypeIdx)
 		{
-			std::vector<T>& dataVector = *std::static_pointer_cast<std::vector<T>>(m_dataVectors[dataTypeIndex]).get();
+			std::vector<T>& dataVector = *static_cast<std::vector<T>*>(m_dataVectors[dataTypeIndex].get());
 			beginPtr = &dataVector.data()[0]; // Get the address without dereferencing it
 		}
 
@@ -1453,8 +1464,8 @@ namespace gr
 
 		return ObjectIterator<Ts...>(
 			this,
-			m_IDToRenderObjectMetadata.begin(),
-			m_IDToRenderObjectMetadata.end(),
+			0,
+			m_renderObjectMetadata.Size(),
 			std::make_tuple(GetEndPtr<Ts>()...),
 			m_currentFrame,
 			featureMask);
@@ -1466,13 +1477,12 @@ namespace gr
 	{
 		m_threadProtector.ValidateThreadAccess(); // Any thread can get data so long as no modification is happening
 
-		const std::unordered_map<gr::RenderDataID, RenderObjectMetadata>::const_iterator objectDataIndicesEndItr =
-			m_IDToRenderObjectMetadata.end();
+		const uint32_t renderObjectEndIdx = m_renderObjectMetadata.Size();
 
 		return ObjectIterator<Ts...>(
 			nullptr,
-			objectDataIndicesEndItr,
-			objectDataIndicesEndItr,
+			renderObjectEndIdx,
+			renderObjectEndIdx,
 			std::make_tuple(GetEndPtr<Ts>()...),
 			m_currentFrame,
 			RenderObjectFeature::None);
@@ -1489,7 +1499,6 @@ namespace gr
 			this,
 			renderDataIDs.cbegin(),
 			renderDataIDs.cend(),
-			&m_IDToRenderObjectMetadata,
 			m_currentFrame,
 			featureMask);
 	}
@@ -1504,7 +1513,6 @@ namespace gr
 			this,
 			renderDataIDs.cend(),
 			renderDataIDs.cend(),
-			&m_IDToRenderObjectMetadata,
 			m_currentFrame,
 			RenderObjectFeature::None);
 	}
@@ -1540,32 +1548,32 @@ namespace gr
 	template<typename... Ts>
 	RenderDataManager::ObjectIterator<Ts...>::ObjectIterator(
 		gr::RenderDataManager const* renderData,
-		std::unordered_map<gr::RenderDataID, RenderObjectMetadata>::const_iterator objectIDToRenderObjectMetadataBeginItr,
-		std::unordered_map<gr::RenderDataID, RenderObjectMetadata>::const_iterator const objectIDToRenderObjectMetadataEndItr,
+		uint32_t renderObjectBeginIdx,
+		uint32_t renderObjectEndIdx,
 		std::tuple<Ts const*...> endPtrs,
 		uint64_t currentFrame,
 		FeatureBitmask featureMask)
 		: m_endPtrs(endPtrs)
 		, m_renderData(renderData)
-		, m_renderObjectMetadataItr(objectIDToRenderObjectMetadataBeginItr)
-		, m_renderObjectMetadataEndItr(objectIDToRenderObjectMetadataEndItr)
+		, m_renderObjectIdx(renderObjectBeginIdx)
+		, m_renderObjectEndIdx(renderObjectEndIdx)
 		, m_currentFrame(currentFrame)
 		, m_featureMask(featureMask)
 	{
 		// Find our first valid set of starting pointers:
 		bool hasValidPtrs = false;
-		while (m_renderObjectMetadataItr != m_renderObjectMetadataEndItr)
+		while (m_renderObjectIdx != m_renderObjectEndIdx)
 		{
-			// We have a set of gr::RenderDataID data indices. Try and make a tuple of valid pointers from all of them
-			m_ptrs = std::make_tuple(GetPtrFromCurrentObjectDataIndicesItr<Ts>()...);
-			
 			// Check the feature mask:
-			if (gr::HasAllFeatures(m_featureMask, m_renderObjectMetadataItr->second.m_featureBits) == false)
+			if (gr::HasAllFeatures(m_featureMask, GetCurrentObjectMetadata().m_featureBits) == false)
 			{
-				m_renderObjectMetadataItr++;
+				m_renderObjectIdx++;
 				continue;
 			}
 
+			// We have a set of gr::RenderDataID data indices. Try and make a tuple of valid pointers from all of them
+			m_ptrs = std::make_tuple(GetPtrFromCurrentObjectIdx<Ts>()...);
+
 			// If the current RenderDataID's object doesn't contain all data elements of the given template type (i.e.
 			// any of the tuple elements are null), skip to the next object:
 			bool tuplePtrsValid = true;
@@ -1577,12 +1585,12 @@ namespace gr
 			}
 
 			// Try the next object
-			m_renderObjectMetadataItr++;
+			m_renderObjectIdx++;
 		}
 
 		if (!hasValidPtrs)
 		{
-			SEAssert(m_renderObjectMetadataItr == m_renderObjectMetadataEndItr,
+			SEAssert(m_renderObjectIdx == m_renderObjectEndIdx,
 				"We should have checked every element, how is this possible?");
 
 			m_ptrs = m_endPtrs;
@@ -1603,23 +1611,23 @@ namespace gr
 		// hopefully this won't be an issue...
 
 		bool hasValidPtrs = true;
-		while (m_renderObjectMetadataItr != m_renderObjectMetadataEndItr)
+		while (m_renderObjectIdx != m_renderObjectEndIdx)
 		{
-			m_renderObjectMetadataItr++;
-			if (m_renderObjectMetadataItr == m_renderObjectMetadataEndItr)
+			m_renderObjectIdx++;
+			if (m_renderObjectIdx == m_renderObjectEndIdx)
 			{
 				hasValidPtrs = false;
 				break;
 			}
 
 			// Check the feature mask:
-			if (gr::HasAllFeatures(m_featureMask, m_renderObjectMetadataItr->second.m_featureBits) == false)
+			if (gr::HasAllFeatures(m_featureMask, GetCurrentObjectMetadata().m_featureBits) == false)
 			{
 				continue;
 			}
 
 			// We have a valid set of gr::RenderDataID data indices. Make a tuple from them
-			m_ptrs = std::make_tuple(GetPtrFromCurrentObjectDataIndicesItr<Ts>()...);
+			m_ptrs = std::make_tuple(GetPtrFromCurrentObjectIdx<Ts>()...);
 
 			// If the current object doesn't have a data of the given type (i.e. any of the tuple elements rae null), we
 			// want to skip over it to the next object:
@@ -1668,13 +1676,14 @@ namespace gr
 	[[nodiscard]] bool RenderDataManager::ObjectIterator<Ts...>::IsDirty() const
 	{
 		const DataTypeIndex dataTypeIndex = m_renderData->GetDataIndexFromType<T>();
+		const uint64_t dirtyFrame = m_renderData->GetDirtyFrame(dataTypeIndex, m_renderObjectIdx);
 
-		SEAssert(m_renderObjectMetadataItr->second.m_dirtyFrameMap.contains(dataTypeIndex) &&
-			m_renderObjectMetadataItr->second.m_dirtyFrameMap.at(dataTypeIndex) <= m_currentFrame &&
+		SEAssert(dirtyFrame != k_invalidDirtyFrameNum &&
+			dirtyFrame <= m_currentFrame &&
 			m_currentFrame != k_invalidDirtyFrameNum,
 			"Invalid dirty frame value");
 
-		return m_renderObjectMetadataItr->second.m_dirtyFrameMap.at(dataTypeIndex) == m_currentFrame;
+		return dirtyFrame == m_currentFrame;
 	}
 
 
@@ -1703,35 +1712,35 @@ namespace gr
 	template<typename... Ts>
 	gr::RenderDataID RenderDataManager::ObjectIterator<Ts...>::GetRenderDataID() const
 	{
-		return m_renderObjectMetadataItr->first;
+		return m_renderData->m_renderObjectMetadata.GetKeyAt(m_renderObjectIdx);
 	}
 
 
 	template<typename... Ts>
 	gr::RenderDataID RenderDataManager::ObjectIterator<Ts...>::GetTransformID() const
 	{
-		return m_renderObjectMetadataItr->second.m_transformID;
+		return GetCurrentObjectMetadata().m_transformID;
 	}
 
 
 	template <typename... Ts>
 	gr::Transform::RenderData const& RenderDataManager::ObjectIterator<Ts...>::GetTransformData() const
 	{
-		return m_renderData->GetTransformDataFromTransformID(m_renderObjectMetadataItr->second.m_transformID);
+		return m_renderData->GetTransformDataFromTransformID(GetCurrentObjectMetadata().m_transformID);
 	}
 
 
 	template <typename... Ts>
 	bool RenderDataManager::ObjectIterator<Ts...>::TransformIsDirty() const
 	{
-		return m_renderData->TransformIsDirty(m_renderObjectMetadataItr->second.m_transformID);
+		return m_renderData->TransformIsDirty(GetCurrentObjectMetadata().m_transformID);
 	}
 
 
 	template <typename... Ts>
 	gr::FeatureBitmask RenderDataManager::ObjectIterator<Ts...>::GetFeatureBits() const
 	{
-		return m_renderObjectMetadataItr->second.m_featureBits;
+		return GetCurrentObjectMetadata().m_featureBits;
 	}
 
 
@@ -1744,26 +1753,28 @@ namespace gr
 
 
 	template <typename... Ts> template <typename T>
-	T const* RenderDataManager::ObjectIterator<Ts...>::GetPtrFromCurrentObjectDataIndicesItr() const
+	T const* RenderDataManager::ObjectIterator<Ts...>::GetPtrFromCurrentObjectIdx() const
 	{
 		const DataTypeIndex dataTypeIndex = m_renderData->GetDataIndexFromType<T>();
 
-		ObjectTypeToDataIndexMap const& objectTypeToDataIndexMap = 
-			m_renderObjectMetadataItr->second.m_dataTypeToDataIndexMap;
-
-		// Make sure the data type index is found in current object's data index map
-		auto objecTypeToDataIdxIter = objectTypeToDataIndexMap.find(dataTypeIndex);
-		if (objecTypeToDataIdxIter != objectTypeToDataIndexMap.end())
+		// Get the index of the data within its typed array, for the current RenderDataID iteration
+		const DataIndex objectDataIndex = m_renderData->GetDataIndex(dataTypeIndex, m_renderObjectIdx);
+		if (objectDataIndex != k_invalidDataIdx)
 		{
-			// Get the index of the data within its typed array, for the current RenderDataID iteration
-			const DataIndex objectDataIndex = objecTypeToDataIdxIter->second;
-
 			return m_renderData->GetObjectDataVectorIfExists<T>(objectDataIndex);
 		}
 		return nullptr;
 	}
 
 
+	template <typename... Ts>
+	inline RenderDataManager::RenderObjectMetadata const&
+		RenderDataManager::ObjectIterator<Ts...>::GetCurrentObjectMetadata() const
+	{
+		return m_renderData->m_renderObjectMetadata.GetAt(m_renderObjectIdx);
+	}
+
+
 	// ---
 
 
@@ -1772,34 +1783,48 @@ namespace gr
 		gr::RenderDataManager const* renderData,
 		Container::const_iterator renderDataIDsBegin,
 		Container::const_iterator renderDataIDsEnd,
-		std::unordered_map<gr::RenderDataID, RenderObjectMetadata> const* IDToRenderObjectMetadata,
 		uint64_t currentFrame,
 		RenderObjectFeature featureMask)
 		: m_renderData(renderData)
 		, m_idsIterator(renderDataIDsBegin)
 		, m_idsEndIterator(renderDataIDsEnd)
-		, m_IDToRenderObjectMetadata(IDToRenderObjectMetadata)
 		, m_currentFrame(currentFrame)
 		, m_featureMask(featureMask)
 	{
-		while (m_idsIterator != m_idsEndIterator &&
-			gr::HasAllFeatures(m_featureMask, 
-				m_IDToRenderObjectMetadata->find(*m_idsIterator)->second.m_featureBits) == false)
-		{
-			++m_idsIterator;
-		}
+		SkipFilteredIDs();
+	}
+
 
-		if (m_idsIterator != m_idsEndIterator)
+	template<typename Container>
+	inline void RenderDataManager::IDIterator<Container>::SkipFilteredIDs()
+	{
+		RenderObjectSlotMap const& renderObjectMetadata = m_renderData->m_renderObjectMetadata;
+
+		while (m_idsIterator != m_idsEndIterator)
 		{
-			m_currentObjectMetadata = m_IDToRenderObjectMetadata->find(*m_idsIterator);
+			m_currentObjectHandle = renderObjectMetadata.GetHandle(*m_idsIterator);
 
-			SEAssert(m_currentObjectMetadata != m_IDToRenderObjectMetadata->end(),
+			SEAssert(m_currentObjectHandle.m_index != RenderObjectSlotMap::k_invalidIndex,
 				"Failed to find a metadata entry for the current ID."); // We can't iterate over deleted IDs
+
+			if (gr::HasAllFeatures(m_featureMask, GetCurrentObjectMetadata().m_featureBits))
+			{
+				return;
+			}
+			++m_idsIterator;
 		}
-		else
-		{
-			m_currentObjectMetadata = m_IDToRenderObjectMetadata->cend();
-		}
+		m_currentObjectHandle = RenderObjectSlotMap::Handle{};
+	}
+
+
+	template<typename Container>
+	inline RenderDataManager::RenderObjectMetadata const&
+		RenderDataManager::IDIterator<Container>::GetCurrentObjectMetadata() const
+	{
+		SEAssert(m_renderData->m_renderObjectMetadata.IsValid(m_currentObjectHandle),
+			"Invalid Get: Current object is past-the-end, or render data was modified during iteration");
+
+		return m_renderData->m_renderObjectMetadata.GetAt(m_currentObjectHandle.m_index);
 	}
 
 
@@ -1807,12 +1832,12 @@ namespace gr
 	template<typename T>
 	bool RenderDataManager::IDIterator<Container>::HasObjectData() const
 	{
-		SEAssert(m_currentObjectMetadata != m_IDToRenderObjectMetadata->cend(),
-			"Invalid Get: Current m_currentObjectMetadata is past-the-end");
+		SEAssert(m_renderData->m_renderObjectMetadata.IsValid(m_currentObjectHandle),
+			"Invalid Get: Current object is past-the-end, or render data was modified during iteration");
 
 		const DataTypeIndex dataTypeIndex = m_renderData->GetDataIndexFromType<T>();
 
-		return m_currentObjectMetadata->second.m_dataTypeToDataIndexMap.contains(dataTypeIndex);
+		return m_renderData->GetDataIndex(dataTypeIndex, m_currentObjectHandle.m_index) != k_invalidDataIdx;
 	}
 
 
@@ -1820,10 +1845,10 @@ namespace gr
 	template<typename T>
 	inline T const& RenderDataManager::IDIterator<Container>::Get() const
 	{
-		SEAssert(m_currentObjectMetadata != m_IDToRenderObjectMetadata->cend(),
-			"Invalid Get: Current m_currentObjectMetadata is past-the-end");
+		SEAssert(m_renderData->m_renderObjectMetadata.IsValid(m_currentObjectHandle),
+			"Invalid Get: Current object is past-the-end, or render data was modified during iteration");
 
-		return m_renderData->GetObjectData<T>(*m_idsIterator);
+		return m_renderData->GetObjectDataFromObjectIdx<T>(m_currentObjectHandle.m_index);
 	}
 
 
@@ -1831,17 +1856,18 @@ namespace gr
 	template<typename T>
 	bool RenderDataManager::IDIterator<Container>::IsDirty() const
 	{
-		SEAssert(m_currentObjectMetadata != m_IDToRenderObjectMetadata->cend(),
-			"Invalid Get: Current m_currentObjectMetadata is past-the-end");
+		SEAssert(m_renderData->m_renderObjectMetadata.IsValid(m_currentObjectHandle),
+			"Invalid Get: Current object is past-the-end, or render data was modified during iteration");
 
 		const DataTypeIndex dataTypeIndex = m_renderData->GetDataIndexFromType<T>();
+		const uint64_t dirtyFrame = m_renderData->GetDirtyFrame(dataTypeIndex, m_currentObjectHandle.m_index);
 
-		SEAssert(m_currentObjectMetadata->second.m_dirtyFrameMap.contains(dataTypeIndex) &&
-			m_currentObjectMetadata->second.m_dirtyFrameMap.at(dataTypeIndex) <= m_currentFrame &&
+		SEAssert(dirtyFrame != k_invalidDirtyFrameNum &&
+			dirtyFrame <= m_currentFrame &&
 			m_currentFrame != k_invalidDirtyFrameNum,
 			"Invalid dirty frame value");
 
-		return m_currentObjectMetadata->second.m_dirtyFrameMap.at(dataTypeIndex) == m_currentFrame;
+		return dirtyFrame == m_currentFrame;
 	}
 
 
@@ -1857,57 +1883,39 @@ namespace gr
 	inline gr::TransformID RenderDataManager::IDIterator<Container>::GetTransformID() const
 	{
 		SEAssert(m_idsIterator != m_idsEndIterator, "Invalid Get: Current m_idsIterator is past-the-end");
-		return m_currentObjectMetadata->second.m_transformID;
+		return GetCurrentObjectMetadata().m_transformID;
 	}
 
 
 	template<typename Container>
 	inline gr::Transform::RenderData const& RenderDataManager::IDIterator<Container>::GetTransformData() const
 	{
-		SEAssert(m_currentObjectMetadata != m_IDToRenderObjectMetadata->cend(),
-			"Invalid Get: Current m_currentObjectMetadata is past-the-end");
-		return m_renderData->GetTransformDataFromTransformID(m_currentObjectMetadata->second.m_transformID);
+		return m_renderData->GetTransformDataFromTransformID(GetCurrentObjectMetadata().m_transformID);
 	}
 
 
 	template<typename Container>
 	inline bool RenderDataManager::IDIterator<Container>::TransformIsDirty() const
 	{
-		SEAssert(m_currentObjectMetadata != m_IDToRenderObjectMetadata->cend(),
-			"Invalid Get: Current m_currentObjectMetadata is past-the-end");
-
-		return m_renderData->TransformIsDirty(m_currentObjectMetadata->second.m_transformID);
+		return m_renderData->TransformIsDirty(GetCurrentObjectMetadata().m_transformID);
 	}
 
 
 	template<typename Container>
 	inline gr::FeatureBitmask RenderDataManager::IDIterator<Container>::GetFeatureBits() const
 	{
-		SEAssert(m_currentObjectMetadata != m_IDToRenderObjectMetadata->cend(),
-			"Invalid Get: Current m_currentObjectMetadata is past-the-end");
-
-		return m_currentObjectMetadata->second.m_featureBits;
+		return GetCurrentObjectMetadata().m_featureBits;
 	}
 
 
 	template<typename Container>
 	inline RenderDataManager::IDIterator<Container>& RenderDataManager::IDIterator<Container>::operator++() // Prefix increment
 	{
-		while (++m_idsIterator != m_idsEndIterator &&
-			gr::HasAllFeatures(m_featureMask,
-				m_IDToRenderObjectMetadata->find(*m_idsIterator)->second.m_featureBits) == false)
-		{
-		}
+		++m_idsIterator;
+
+		// As a small optimization, we cache the current render object's metadata slot to save repeated queries
+		SkipFilteredIDs();
 
-		if (m_idsIterator != m_idsEndIterator)
-		{
-			// As a small optimization, we cache the current RenderObjectMetadata iterator to save repeated queries
-			m_currentObjectMetadata = m_IDToRenderObjectMetadata->find(*m_idsIterator);
-		}
-		else
-		{
-			m_currentObjectMetadata = m_IDToRenderObjectMetadata->cend();
-		}
 		return *this;
 	}
 
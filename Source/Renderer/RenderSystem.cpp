@@ -581,8 +581,7 @@ namespace gr
 
 		for (auto& executionGroup : m_updatePipeline)
 		{
-			std::vector<std::future<void>> updateStepFutures;
-			updateStepFutures.reserve(executionGroup.size());
+			core::JobCounter updateStepJobCounter;
 
 			for (auto const& currentStep : executionGroup)
 			{
@@ -592,18 +591,16 @@ namespace gr
 				}
 				else
 				{
-					updateStepFutures.emplace_back(core::ThreadPool::EnqueueJob([&]()
+					core::ThreadPool::EnqueueJob([&]()
 						{
 							ExecuteUpdateStep(currentStep);
-						}));
+						},
+						updateStepJobCounter);
 				}
 			}
 
 			// Wait for all tasks within the current execution group to complete
-			for (auto const& updateFuture : updateStepFutures)
-			{
-				updateFuture.wait();
-			}
+			core::ThreadPool::WaitForCounter(updateStepJobCounter);
 		}
 
 		SEEndCPUEvent();
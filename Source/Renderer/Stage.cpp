@@ -658,27 +658,30 @@ namespace gr
 			return;
 		}
 
-		// Populate the batch metadata:
-		SEBeginCPUEvent("Populate batchMetadata");
+		// Populate the batch sort keys: We read each batch's data hash once, and sort the packed keys instead of
+		// dereferencing the batch handles for every comparison
+		SEBeginCPUEvent("Populate batch sort keys");
 
-		std::vector<gr::StageBatchHandle const*> batchMetadata;
-		batchMetadata.reserve(m_resolvedBatches.size());
+		SEAssert(m_resolvedBatches.size() <= std::numeric_limits<uint32_t>::max(), "Too many batches");
+
+		m_batchSortKeys.clear();
+		m_batchSortKeys.reserve(m_resolvedBatches.size());
 		for (size_t i = 0; i < m_resolvedBatches.size(); i++)
 		{
-			batchMetadata.emplace_back(&m_resolvedBatches[i]);
+			m_batchSortKeys.emplace_back(util::RadixSortKey{
+				.m_key = (*m_resolvedBatches[i])->GetDataHash(),
+				.m_index = static_cast<uint32_t>(i) });
 		}
 
-		SEEndCPUEvent(); // "Populate batchMetadata"
+		SEEndCPUEvent(); // "Populate batch sort keys"
 
 
-		// Sort the batch metadata:
-		SEBeginCPUEvent("Sort batchMetadata");
+		// Sort the batch keys. Batches with identical data hashes are adjacent, and retain their relative order
+		SEBeginCPUEvent("Sort batch sort keys");
 
-		std::sort(batchMetadata.begin(), batchMetadata.end(),
-			[](gr::StageBatchHandle const* a, gr::StageBatchHandle const* b)
-			{ return (*(*a))->GetDataHash() < (*(*b))->GetDataHash(); });
+		util::RadixSort(m_batchSortKeys, m_batchSortScratch);
 			
-		SEEndCPUEvent(); // "Sort batchMetadata"
+		SEEndCPUEvent(); // "Sort batch sort keys"
 
 
 		// Merge the batches:
@@ -690,17 +693,17 @@ namespace gr
 		size_t unmergedIdx = 0;
 		do
 		{
-			gr::StageBatchHandle const* stageBatchHandle = batchMetadata[unmergedIdx];
+			gr::StageBatchHandle const* stageBatchHandle = &m_resolvedBatches[m_batchSortKeys[unmergedIdx].m_index];
 
 			// Add the first batch in the sequence to our final list. We duplicate the batch, as cached batches
 			// have a permanent Lifetime
 			mergedBatches.emplace_back(*stageBatchHandle);
 
 			// Find the index of the last batch with a matching hash in the sequence:
-			const uint64_t curBatchHash = (*(*batchMetadata[unmergedIdx]))->GetDataHash();
+			const uint64_t curBatchHash = m_batchSortKeys[unmergedIdx].m_key;
 			const size_t instanceStartIdx = unmergedIdx++;
-			while (unmergedIdx < batchMetadata.size() &&
-				(*(*batchMetadata[unmergedIdx]))->GetDataHash() == curBatchHash)
+			while (unmergedIdx < m_batchSortKeys.size() &&
+				m_batchSortKeys[unmergedIdx].m_key == curBatchHash)
 			{
 				unmergedIdx++;
 			}
@@ -734,20 +737,20 @@ namespace gr
 			if (setInstanceBuffer &&
 				(*(*stageBatchHandle)).GetRenderDataID() != gr::k_invalidRenderDataID)
 			{
-				// Use a view of our batch metadata to get the list of RenderDataIDs for each instance:
-				std::ranges::range auto&& instancedBatchView = batchMetadata
+				// Use a view of our sorted batch keys to get the list of RenderDataIDs for each instance:
+				std::ranges::range auto&& instancedBatchView = m_batchSortKeys
 					| std::views::drop(instanceStartIdx)
 					| std::views::take(numInstances)
-					| std::ranges::views::transform([](gr::StageBatchHandle const* batchMetadata) -> gr::RenderDataID
+					| std::ranges::views::transform([this](util::RadixSortKey const& batchSortKey) -> gr::RenderDataID
 						{
-							return (*(*batchMetadata)).GetRenderDataID();
+							return (*m_resolvedBatches[batchSortKey.m_index]).GetRenderDataID();
 						});
 
 				mergedBatches.back().SetSingleFrameBuffer(
 					ibm.GetLUTBufferInput<InstanceIndexData>(InstanceIndexData::s_shaderName, instancedBatchView));
 			}
 
-		} while (unmergedIdx < batchMetadata.size());
+		} while (unmergedIdx < m_batchSortKeys.size());
 
 		// Swap in our merged results:
 		m_resolvedBatches = std::move(mergedBatches);
@@ -16,6 +16,8 @@
 
 #include "Core/Interfaces/INamedObject.h"
 
+#include "Core/Util/RadixSort.h"
+
 
 namespace effect
 {
@@ -276,6 +278,10 @@ namespace gr
 
 		std::vector<gr::StageBatchHandle> m_resolvedBatches;
 
+		// Batch instancing: Reused each frame to avoid reallocations
+		std::vector<util::RadixSortKey> m_batchSortKeys; // Batch data hash, m_resolvedBatches index
+		std::vector<util::RadixSortKey> m_batchSortScratch;
+
 		gr::Batch::FilterBitmask m_requiredBatchFilterBitmasks;
 		gr::Batch::FilterBitmask m_excludedBatchFilterBitmasks;
 
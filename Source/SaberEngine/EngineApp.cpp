@@ -267,6 +267,8 @@ namespace app
 		m_renderManager->ThreadShutdown();
 		m_renderManager = nullptr;
 
+		core::PerfLogger::Get()->Shutdown(); // After the render thread has submitted its final timings
+
 		m_inputManager->Shutdown();
 		core::EventManager::Shutdown();
 
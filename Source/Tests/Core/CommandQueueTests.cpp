@@ -0,0 +1,322 @@
+// © 2025 Adam Badke. All rights reserved.
+#include "TestHarness.h"
+
+#include "Core/CommandQueue.h"
+
+
+namespace
+{
+	struct ExecutedCommand
+	{
+		uint32_t m_producerIdx;
+		uint32_t m_sequenceIdx;
+		uint64_t m_sortKey;
+	};
+	std::vector<ExecutedCommand> s_executedCommands; // Commands are executed single threaded
+
+	std::atomic<int64_t> s_numLiveCommands = 0;
+
+
+	// Records its execution. Padded to various sizes, so claims straddle the page boundaries at different offsets
+	template<size_t PaddingBytes>
+	class RecordExecutionCommand final
+	{
+	public:
+		RecordExecutionCommand(uint32_t producerIdx, uint32_t sequenceIdx, uint64_t sortKey = 0)
+			: m_producerIdx(producerIdx)
+			, m_sequenceIdx(sequenceIdx)
+			, m_sortKey(sortKey)
+		{
+			s_numLiveCommands.fetch_add(1);
+		}
+
+		~RecordExecutionCommand()
+		{
+			s_numLiveCommands.fetch_sub(1);
+		}
+
+		static void Execute(void* cmdData)
+		{
+			RecordExecutionCommand const* cmd = static_cast<RecordExecutionCommand const*>(cmdData);
+			s_executedCommands.emplace_back(ExecutedCommand{ cmd->m_producerIdx, cmd->m_sequenceIdx, cmd->m_sortKey });
+		}
+
+
+	private:
+		uint32_t m_producerIdx;
+		uint32_t m_sequenceIdx;
+		uint64_t m_sortKey;
+		std::array<uint8_t, PaddingBytes> m_padding{};
+	};
+
+
+	// Enqueues commands of varying sizes from several threads at once
+	template<typename EnqueueFunction>
+	void EnqueueFromProducers(uint32_t numProducers, uint32_t numCommandsPerProducer, EnqueueFunction&& enqueue)
+	{
+		std::vector<std::thread> producers;
+		for (uint32_t producerIdx = 0; producerIdx < numProducers; ++producerIdx)
+		{
+			producers.emplace_back([&enqueue, producerIdx, numCommandsPerProducer]()
+				{
+					for (uint32_t sequenceIdx = 0; sequenceIdx < numCommandsPerProducer; ++sequenceIdx)
+					{
+						enqueue(producerIdx, sequenceIdx);
+					}
+				});
+		}
+		for (std::thread& producer : producers)
+		{
+			producer.join();
+		}
+	}
+
+
+	template<typename Manager>
+	void EnqueueVaryingSizes(Manager& manager, uint32_t producerIdx, uint32_t sequenceIdx)
+	{
+		switch (sequenceIdx % 3)
+		{
+		case 0: manager.template Enqueue<RecordExecutionCommand<8>>(producerIdx, sequenceIdx); break;
+		case 1: manager.template Enqueue<RecordExecutionCommand<120>>(producerIdx, sequenceIdx); break;
+		default: manager.template Enqueue<RecordExecutionCommand<500>>(producerIdx, sequenceIdx); break;
+		}
+	}
+
+
+	// Returns the number of commands that were missing, duplicated, or executed out of order w.r.t their producer
+	uint32_t CountPerProducerOrderingErrors(uint32_t numProducers, uint32_t numCommandsPerProducer)
+	{
+		uint32_t numErrors = 0;
+
+		std::vector<uint32_t> nextSequenceIdx(numProducers, 0);
+		for (ExecutedCommand const& executed : s_executedCommands)
+		{
+			if (executed.m_producerIdx >= numProducers ||
+				executed.m_sequenceIdx != nextSequenceIdx[executed.m_producerIdx]++)
+			{
+				++numErrors;
+			}
+		}
+		for (uint32_t numExecuted : nextSequenceIdx)
+		{
+			numErrors += (numExecuted != numCommandsPerProducer);
+		}
+		return numErrors;
+	}
+
+
+	// Returns the number of commands that break (sort key, producer thread, sequence) ordering. Also returns the order
+	// the producers' commands were executed in, for the first sort key
+	uint32_t CountMergeOrderingErrors(uint32_t numProducers, std::vector<uint32_t>& firstKeyProducerOrderOut)
+	{
+		uint32_t numErrors = 0;
+
+		firstKeyProducerOrderOut.clear();
+
+		constexpr uint32_t k_invalidIdx = std::numeric_limits<uint32_t>::max();
+		std::vector<bool> producerIsFinished(numProducers, false); // For the current sort key
+		std::vector<uint32_t> prevSequenceIdx(numProducers, k_invalidIdx);
+		uint32_t prevProducerIdx = k_invalidIdx;
+
+		for (size_t cmdIdx = 0; cmdIdx < s_executedCommands.size(); ++cmdIdx)
+		{
+			ExecutedCommand const& executed = s_executedCommands[cmdIdx];
+			if (executed.m_producerIdx >= numProducers)
+			{
+				++numErrors;
+				continue;
+			}
+
+			if (cmdIdx > 0 && executed.m_sortKey != s_executedCommands[cmdIdx - 1].m_sortKey)
+			{
+				numErrors += (executed.m_sortKey < s_executedCommands[cmdIdx - 1].m_sortKey);
+
+				std::fill(producerIsFinished.begin(), producerIsFinished.end(), false);
+				std::fill(prevSequenceIdx.begin(), prevSequenceIdx.end(), k_invalidIdx);
+				prevProducerIdx = k_invalidIdx;
+			}
+
+			// Each producer's commands must be contiguous within a sort key...
+			if (executed.m_producerIdx != prevProducerIdx)
+			{
+				numErrors += producerIsFinished[executed.m_producerIdx];
+
+				if (prevProducerIdx != k_invalidIdx)
+				{
+					producerIsFinished[prevProducerIdx] = true;
+				}
+				prevProducerIdx = executed.m_producerIdx;
+
+				if (executed.m_sortKey == s_executedCommands.front().m_sortKey)
+				{
+					firstKeyProducerOrderOut.emplace_back(executed.m_producerIdx);
+				}
+			}
+
+			// ...and in the order they were enqueued
+			uint32_t& prevSequence = prevSequenceIdx[executed.m_producerIdx];
+			numErrors += (prevSequence != k_invalidIdx && executed.m_sequenceIdx <= prevSequence);
+			prevSequence = executed.m_sequenceIdx;
+		}
+		return numErrors;
+	}
+}
+
+
+SE_TEST(CommandManager_SharedBufferExecutesEveryCommandInProducerOrder)
+{
+	constexpr uint32_t k_numProducers = 8;
+	constexpr uint32_t k_numCommandsPerProducer = 20000;
+	constexpr uint32_t k_numFrames = 4;
+
+	{
+		// Tiny pages, so the buffer must chain (and then reuse) many of them while the producers are racing
+		core::CommandManager commandManager(4096);
+
+		for (uint32_t frameIdx = 0; frameIdx < k_numFrames; ++frameIdx)
+		{
+			EnqueueFromProducers(k_numProducers, k_numCommandsPerProducer,
+				[&commandManager](uint32_t producerIdx, uint32_t sequenceIdx)
+				{
+					EnqueueVaryingSizes(commandManager, producerIdx, sequenceIdx);
+				});
+
+			commandManager.SwapBuffers();
+
+			s_executedCommands.clear();
+			commandManager.Execute();
+
+			SE_CHECK(s_executedCommands.size() == k_numProducers * k_numCommandsPerProducer);
+			SE_CHECK(CountPerProducerOrderingErrors(k_numProducers, k_numCommandsPerProducer) == 0);
+		}
+	}
+	s_executedCommands.clear();
+
+	SE_CHECK(s_numLiveCommands.load() == 0); // Every command was destroyed exactly once
+}
+
+
+SE_TEST(CommandManager_PerThreadMergesManyProducersDeterministically)
+{
+	// More managers than each thread's producer cache has entries, so every lookup below evicts another manager
+	constexpr uint32_t k_numManagers = 12;
+	constexpr uint32_t k_numProducers = 16;
+	constexpr uint32_t k_numCommandsPerProducer = 2000;
+	constexpr uint32_t k_numFrames = 3;
+	constexpr uint64_t k_numSortKeys = 5;
+
+	{
+		std::vector<std::unique_ptr<core::CommandManager>> commandManagers;
+		for (uint32_t managerIdx = 0; managerIdx < k_numManagers; ++managerIdx)
+		{
+			commandManagers.emplace_back(
+				std::make_unique<core::CommandManager>(4096, core::CommandRecordingMode::PerThread));
+		}
+
+		for (uint32_t frameIdx = 0; frameIdx < k_numFrames; ++frameIdx)
+		{
+			EnqueueFromProducers(k_numProducers, k_numCommandsPerProducer,
+				[&commandManagers](uint32_t producerIdx, uint32_t sequenceIdx)
+				{
+					const uint64_t sortKey = (sequenceIdx * 7919llu + producerIdx) % k_numSortKeys;
+					for (auto& commandManager : commandManagers)
+					{
+						commandManager->EnqueueWithSortKey<RecordExecutionCommand<8>>(
+							sortKey, producerIdx, sequenceIdx, sortKey);
+					}
+				});
+
+			// The producer threads' slots are global, so every manager must merge them into the same order
+			std::vector<uint32_t> expectedProducerOrder;
+			for (uint32_t managerIdx = 0; managerIdx < k_numManagers; ++managerIdx)
+			{
+				commandManagers[managerIdx]->SwapBuffers();
+
+				s_executedCommands.clear();
+				commandManagers[managerIdx]->Execute();
+
+				SE_CHECK(s_executedCommands.size() == k_numProducers * k_numCommandsPerProducer);
+
+				std::vector<uint32_t> producerOrder;
+				SE_CHECK(CountMergeOrderingErrors(k_numProducers, producerOrder) == 0);
+				SE_CHECK(producerOrder.size() == k_numProducers);
+
+				if (managerIdx == 0)
+				{
+					expectedProducerOrder = producerOrder;
+				}
+				SE_CHECK(producerOrder == expectedProducerOrder);
+			}
+		}
+	}
+	s_executedCommands.clear();
+
+	SE_CHECK(s_numLiveCommands.load() == 0);
+}
+
+
+SE_TEST(CommandManager_PerThreadUniqueSortKeysIgnoreThreadSlots)
+{
+	constexpr uint32_t k_numProducers = 8;
+	constexpr uint32_t k_numCommandsPerProducer = 1000;
+
+	// A fresh set of threads each frame: Their slots are assigned in whichever order they first enqueue. Encoding the
+	// producer index in the low bits of the sort key makes the order independent of that
+	{
+		core::CommandManager commandManager(4096, core::CommandRecordingMode::PerThread);
+
+		for (uint32_t frameIdx = 0; frameIdx < 3; ++frameIdx)
+		{
+			EnqueueFromProducers(k_numProducers, k_numCommandsPerProducer,
+				[&commandManager](uint32_t producerIdx, uint32_t sequenceIdx)
+				{
+					const uint64_t sortKey = ((sequenceIdx % 7llu) << 32) | producerIdx;
+					commandManager.EnqueueWithSortKey<RecordExecutionCommand<8>>(
+						sortKey, producerIdx, sequenceIdx, sortKey);
+				});
+
+			commandManager.SwapBuffers();
+
+			s_executedCommands.clear();
+			commandManager.Execute();
+
+			SE_CHECK(s_executedCommands.size() == k_numProducers * k_numCommandsPerProducer);
+
+			// Every command's position is fully determined by its (sort key, sequence)
+			SE_CHECK(std::is_sorted(s_executedCommands.begin(), s_executedCommands.end(),
+				[](ExecutedCommand const& lhs, ExecutedCommand const& rhs)
+				{
+					return std::tie(lhs.m_sortKey, lhs.m_sequenceIdx) < std::tie(rhs.m_sortKey, rhs.m_sequenceIdx);
+				}));
+		}
+	}
+	s_executedCommands.clear();
+
+	SE_CHECK(s_numLiveCommands.load() == 0);
+}
+
+
+SE_BENCHMARK(CommandManager_SharedBufferEnqueueThroughput)
+{
+	constexpr uint32_t k_numProducers = 8;
+	constexpr uint32_t k_numCommandsPerProducer = 100000;
+
+	core::CommandManager commandManager(1024 * 1024);
+
+	const double medianMs = tests::MeasureMedianMs(10, [&commandManager]()
+		{
+			EnqueueFromProducers(k_numProducers, k_numCommandsPerProducer,
+				[&commandManager](uint32_t producerIdx, uint32_t sequenceIdx)
+				{
+					commandManager.Enqueue<RecordExecutionCommand<8>>(producerIdx, sequenceIdx);
+				});
+
+			// Reset the buffer we just wrote to, without executing it
+			commandManager.SwapBuffers();
+			commandManager.SwapBuffers();
+		});
+
+	tests::TestHarness::RecordTiming(
+		"Enqueue 800k commands from 8 threads", medianMs, k_numProducers * k_numCommandsPerProducer);
+}
\ No newline at end of file
@@ -0,0 +1,215 @@
+// © 2025 Adam Badke. All rights reserved.
+#include "TestHarness.h"
+
+#include "Core/Util/DenseBitset.h"
+
+
+namespace
+{
+	std::vector<size_t> GetSetBits(util::DenseBitset const& bitset)
+	{
+		std::vector<size_t> setBits;
+		bitset.ForEachSetBit([&setBits](size_t bitIdx)
+			{
+				setBits.emplace_back(bitIdx);
+			});
+		return setBits;
+	}
+
+
+	// Returns the number of bits that differ from the reference, plus any mismatch in the size or set bit count
+	uint32_t CountReferenceMismatches(util::DenseBitset const& bitset, std::vector<bool> const& reference)
+	{
+		if (bitset.GetNumBits() != reference.size() ||
+			bitset.GetNumWords() != util::DenseBitset::GetNumWords(reference.size()))
+		{
+			return 1;
+		}
+
+		uint32_t numMismatches = 0;
+		std::vector<size_t> expectedSetBits;
+		for (size_t bitIdx = 0; bitIdx < reference.size(); ++bitIdx)
+		{
+			numMismatches += (bitset.Test(bitIdx) != reference[bitIdx]);
+			if (reference[bitIdx])
+			{
+				expectedSetBits.emplace_back(bitIdx);
+			}
+		}
+		numMismatches += (GetSetBits(bitset) != expectedSetBits);
+		numMismatches += (bitset.Count() != expectedSetBits.size());
+		numMismatches += (bitset.Any() != !expectedSetBits.empty());
+		return numMismatches;
+	}
+}
+
+
+SE_TEST(DenseBitset_TestAndSetReturnsPreviousValue)
+{
+	util::DenseBitset bitset(130);
+
+	for (size_t bitIdx : { 0, 63, 64, 127, 129 })
+	{
+		SE_CHECK(!bitset.TestAndSet(bitIdx));
+		SE_CHECK(bitset.Test(bitIdx));
+		SE_CHECK(bitset.TestAndSet(bitIdx)); // Already set, and stays set
+		SE_CHECK(bitset.Test(bitIdx));
+	}
+	SE_CHECK(bitset.Count() == 5);
+
+	// Only the requested bit is touched, including its neighbours across a word boundary
+	SE_CHECK(!bitset.Test(1));
+	SE_CHECK(!bitset.Test(62));
+	SE_CHECK(!bitset.Test(65));
+	SE_CHECK(!bitset.Test(128));
+
+	bitset.Reset(64);
+	SE_CHECK(!bitset.TestAndSet(64));
+	SE_CHECK(bitset.TestAndSet(64));
+}
+
+
+SE_TEST(DenseBitset_ForEachSetBitCrossesWordBoundaries)
+{
+	util::DenseBitset bitset(200);
+	SE_CHECK(GetSetBits(bitset).empty());
+	SE_CHECK(!bitset.Any());
+
+	// First and last bits of each word, a whole word, and the last bit of a partial word
+	const std::vector<size_t> expectedSetBits = [&bitset]()
+		{
+			std::vector<size_t> setBits = { 0, 63, 64 };
+			for (size_t bitIdx = 128; bitIdx < 192; ++bitIdx)
+			{
+				setBits.emplace_back(bitIdx);
+			}
+			setBits.emplace_back(199);
+
+			// Set in reverse, to check they're visited in ascending order
+			for (auto bitItr = setBits.rbegin(); bitItr != setBits.rend(); ++bitItr)
+			{
+				bitset.Set(*bitItr);
+			}
+			return setBits;
+		}();
+
+	SE_CHECK(GetSetBits(bitset) == expectedSetBits);
+	SE_CHECK(bitset.Count() == expectedSetBits.size());
+	SE_CHECK(bitset.GetNumWords() == 4);
+	SE_CHECK(bitset.GetWord(1) == 1);
+	SE_CHECK(bitset.GetWord(2) == std::numeric_limits<uint64_t>::max());
+	SE_CHECK(bitset.GetWord(3) == (1ull << 7));
+
+	// Per-word iteration offsets the bit indexes by the word index
+	std::vector<size_t> wordSetBits;
+	util::DenseBitset::ForEachSetBit(bitset.GetWord(0), 5, [&wordSetBits](size_t bitIdx)
+		{
+			wordSetBits.emplace_back(bitIdx);
+		});
+	SE_CHECK(wordSetBits == std::vector<size_t>({ 5 * 64, 5 * 64 + 63 }));
+}
+
+
+SE_TEST(DenseBitset_ResizeClearsTruncatedAndNewBits)
+{
+	util::DenseBitset bitset(128);
+	for (size_t bitIdx = 0; bitIdx < 128; ++bitIdx)
+	{
+		bitset.Set(bitIdx);
+	}
+
+	// Shrinking into the middle of a word, then growing again, must not resurrect the truncated bits
+	bitset.Resize(70);
+	SE_CHECK(bitset.GetNumBits() == 70);
+	SE_CHECK(bitset.GetNumWords() == 2);
+	SE_CHECK(bitset.Count() == 70);
+
+	bitset.Resize(256);
+	SE_CHECK(bitset.GetNumWords() == 4);
+	SE_CHECK(bitset.Count() == 70);
+	SE_CHECK(bitset.Test(69));
+	SE_CHECK(!bitset.Test(70));
+	SE_CHECK(!bitset.Test(127));
+	SE_CHECK(!bitset.Test(255));
+
+	// Shrinking to a word boundary drops whole words
+	bitset.Resize(64);
+	SE_CHECK(bitset.GetNumWords() == 1);
+	SE_CHECK(bitset.Count() == 64);
+
+	bitset.Resize(0);
+	SE_CHECK(bitset.GetNumWords() == 0);
+	SE_CHECK(!bitset.Any());
+
+	bitset.Resize(65);
+	SE_CHECK(bitset.Count() == 0);
+}
+
+
+SE_TEST(DenseBitset_MatchesReferenceUnderRandomEdits)
+{
+	util::DenseBitset bitset;
+	std::vector<bool> reference;
+
+	std::mt19937 generator(24680);
+	for (uint32_t editIdx = 0; editIdx < 20000; ++editIdx)
+	{
+		const uint32_t editType = generator() % 8;
+		if (reference.empty() || editType < 3)
+		{
+			const bool value = generator() % 2 == 0;
+			bitset.PushBack(value);
+			reference.push_back(value);
+		}
+		else
+		{
+			const size_t bitIdx = generator() % reference.size();
+			switch (editType)
+			{
+			case 3:
+			{
+				SE_CHECK(bitset.TestAndSet(bitIdx) == reference[bitIdx]);
+				reference[bitIdx] = true;
+			}
+			break;
+			case 4:
+			{
+				bitset.Reset(bitIdx);
+				reference[bitIdx] = false;
+			}
+			break;
+			case 5:
+			{
+				bitset.EraseUnordered(bitIdx);
+				reference[bitIdx] = reference.back();
+				reference.pop_back();
+			}
+			break;
+			case 6:
+			{
+				bitset.PopBack();
+				reference.pop_back();
+			}
+			break;
+			default:
+			{
+				// Shrink or grow by up to 2 words
+				const size_t newNumBits = std::max<ptrdiff_t>(0, static_cast<ptrdiff_t>(reference.size()) +
+					static_cast<ptrdiff_t>(generator() % 257) - 128);
+				bitset.Resize(newNumBits);
+				reference.resize(newNumBits, false);
+			}
+			}
+		}
+
+		if (editIdx % 64 == 0)
+		{
+			SE_CHECK(CountReferenceMismatches(bitset, reference) == 0);
+		}
+	}
+	SE_CHECK(CountReferenceMismatches(bitset, reference) == 0);
+
+	bitset.ClearAll();
+	SE_CHECK(!bitset.Any());
+	SE_CHECK(bitset.GetNumBits() == reference.size());
+}
\ No newline at end of file
@@ -0,0 +1,277 @@
+// © 2025 Adam Badke. All rights reserved.
+#include "TestHarness.h"
+
+#include "Core/EventManager.h"
+
+#include "Core/Interfaces/IEventListener.h"
+
+
+namespace
+{
+	// Unique to these tests: Subscriptions can't be removed, so the listeners are never destroyed
+	constexpr util::CHashKey k_evenEventKey("EventManagerTests_EvenEvent");
+	constexpr util::CHashKey k_oddEventKey("EventManagerTests_OddEvent");
+
+
+	class RecordingListener final : public virtual core::IEventListener
+	{
+	public:
+		using ReceivedEvent = std::pair<uint32_t, uint32_t>; // (producer index, sequence index)
+
+		void HandleEvents() override
+		{
+			while (HasEvents())
+			{
+				core::EventManager::EventInfo const& eventInfo = GetEvent();
+				m_receivedEvents.emplace_back(std::get<ReceivedEvent>(eventInfo.m_data));
+			}
+		}
+
+		std::vector<ReceivedEvent> m_receivedEvents;
+	};
+
+
+	struct Listeners
+	{
+		RecordingListener m_evenListenerA;
+		RecordingListener m_evenListenerB; // Also subscribed to the even events, to exercise the batched fan-out
+		RecordingListener m_oddListener;
+
+		void Reset()
+		{
+			m_evenListenerA.m_receivedEvents.clear();
+			m_evenListenerB.m_receivedEvents.clear();
+			m_oddListener.m_receivedEvents.clear();
+		}
+	};
+
+
+	Listeners& GetListeners()
+	{
+		static Listeners s_listeners;
+		static const bool s_isSubscribed = [&]()
+			{
+				core::EventManager::Subscribe(k_evenEventKey, &s_listeners.m_evenListenerA);
+				core::EventManager::Subscribe(k_evenEventKey, &s_listeners.m_evenListenerB);
+				core::EventManager::Subscribe(k_oddEventKey, &s_listeners.m_oddListener);
+				return true;
+			}();
+		return s_listeners;
+	}
+
+
+	// Posts events alternating between the even/odd keys from several threads at once. The calling thread repeatedly
+	// executes the update function until all of the producers have finished
+	template<typename UpdateFunction>
+	void NotifyFromProducers(uint32_t numProducers, uint32_t numEventsPerProducer, UpdateFunction&& update)
+	{
+		std::atomic<uint32_t> numProducersFinished = 0;
+
+		std::vector<std::thread> producers;
+		for (uint32_t producerIdx = 0; producerIdx < numProducers; ++producerIdx)
+		{
+			producers.emplace_back([&numProducersFinished, producerIdx, numEventsPerProducer]()
+				{
+					for (uint32_t sequenceIdx = 0; sequenceIdx < numEventsPerProducer; ++sequenceIdx)
+					{
+						core::EventManager::Notify(core::EventManager::EventInfo{
+							.m_eventKey = (sequenceIdx % 2 == 0) ? k_evenEventKey : k_oddEventKey,
+							.m_data = std::pair<uint32_t, uint32_t>(producerIdx, sequenceIdx),
+						});
+					}
+					numProducersFinished.fetch_add(1);
+				});
+		}
+
+		while (numProducersFinished.load() < numProducers)
+		{
+			update();
+		}
+
+		for (std::thread& producer : producers)
+		{
+			producer.join();
+		}
+	}
+
+
+	// Returns the number of missing or duplicated events with the given parity
+	uint32_t CountDeliveryErrors(
+		std::vector<RecordingListener::ReceivedEvent> const& receivedEvents,
+		uint32_t numProducers,
+		uint32_t numEventsPerProducer,
+		uint32_t parity)
+	{
+		std::vector<uint32_t> numTimesReceived(numProducers * numEventsPerProducer, 0);
+
+		uint32_t numErrors = 0;
+		for (auto const& [producerIdx, sequenceIdx] : receivedEvents)
+		{
+			if (producerIdx >= numProducers || sequenceIdx >= numEventsPerProducer || sequenceIdx % 2 != parity)
+			{
+				++numErrors;
+				continue;
+			}
+			++numTimesReceived[producerIdx * numEventsPerProducer + sequenceIdx];
+		}
+
+		for (uint32_t eventIdx = 0; eventIdx < numTimesReceived.size(); ++eventIdx)
+		{
+			const uint32_t expectedCount = ((eventIdx % numEventsPerProducer) % 2 == parity) ? 1 : 0;
+			numErrors += (numTimesReceived[eventIdx] != expectedCount);
+		}
+		return numErrors;
+	}
+
+
+	// Returns the number of events received out of order w.r.t the thread that posted them
+	uint32_t CountPerProducerOrderingErrors(
+		std::vector<RecordingListener::ReceivedEvent> const& receivedEvents, uint32_t numProducers)
+	{
+		constexpr uint32_t k_noEventReceived = std::numeric_limits<uint32_t>::max();
+		std::vector<uint32_t> prevSequenceIdx(numProducers, k_noEventReceived);
+
+		uint32_t numErrors = 0;
+		for (auto const& [producerIdx, sequenceIdx] : receivedEvents)
+		{
+			uint32_t& prevSequence = prevSequenceIdx[producerIdx];
+			numErrors += (prevSequence != k_noEventReceived && sequenceIdx <= prevSequence);
+			prevSequence = sequenceIdx;
+		}
+		return numErrors;
+	}
+}
+
+
+SE_TEST(EventManager_DeliversEveryEventOnceUnderContention)
+{
+	// More events than the ring buffer holds, posted while we're concurrently updating: Some may spill into the
+	// overflow list
+	constexpr uint32_t k_numProducers = 8;
+	constexpr uint32_t k_numEventsPerProducer = 20000;
+
+	Listeners& listeners = GetListeners();
+	core::EventManager::Update(); // Register our subscriptions
+	listeners.Reset();
+
+	auto UpdateAndHandle = [&listeners]()
+		{
+			core::EventManager::Update();
+			listeners.m_evenListenerA.HandleEvents();
+			listeners.m_evenListenerB.HandleEvents();
+			listeners.m_oddListener.HandleEvents();
+		};
+
+	NotifyFromProducers(k_numProducers, k_numEventsPerProducer, UpdateAndHandle);
+	UpdateAndHandle(); // Pick up anything posted after our last update
+
+	SE_CHECK(CountDeliveryErrors(
+		listeners.m_evenListenerA.m_receivedEvents, k_numProducers, k_numEventsPerProducer, 0) == 0);
+	SE_CHECK(CountDeliveryErrors(
+		listeners.m_oddListener.m_receivedEvents, k_numProducers, k_numEventsPerProducer, 1) == 0);
+
+	// Listeners subscribed to the same event receive identical batches
+	SE_CHECK(listeners.m_evenListenerA.m_receivedEvents == listeners.m_evenListenerB.m_receivedEvents);
+
+	listeners.Reset();
+}
+
+
+SE_TEST(EventManager_SpillsIntoOverflowWhenRingIsFull)
+{
+	// No updates while posting: Everything past the ring buffer's capacity must spill, and still be delivered once
+	constexpr uint32_t k_numProducers = 8;
+	constexpr uint32_t k_numEventsPerProducer = 20000;
+	constexpr uint64_t k_ringCapacity = 131072;
+
+	Listeners& listeners = GetListeners();
+	core::EventManager::Update();
+	listeners.Reset();
+
+	const uint64_t numOverflowEventsBefore = core::EventManager::GetNumOverflowEvents();
+
+	NotifyFromProducers(k_numProducers, k_numEventsPerProducer, []() { std::this_thread::yield(); });
+
+	SE_CHECK(core::EventManager::GetNumOverflowEvents() - numOverflowEventsBefore ==
+		k_numProducers * k_numEventsPerProducer - k_ringCapacity);
+
+	core::EventManager::Update();
+	listeners.m_evenListenerA.HandleEvents();
+	listeners.m_evenListenerB.HandleEvents();
+	listeners.m_oddListener.HandleEvents();
+
+	SE_CHECK(CountDeliveryErrors(
+		listeners.m_evenListenerA.m_receivedEvents, k_numProducers, k_numEventsPerProducer, 0) == 0);
+	SE_CHECK(CountDeliveryErrors(
+		listeners.m_oddListener.m_receivedEvents, k_numProducers, k_numEventsPerProducer, 1) == 0);
+
+	listeners.Reset();
+}
+
+
+SE_TEST(EventManager_PreservesPerThreadOrderWithoutOverflow)
+{
+	// 100k events in a single frame fit in the ring buffer: Nothing spills, so each thread's events must be
+	// delivered in the order they were posted
+	constexpr uint32_t k_numProducers = 8;
+	constexpr uint32_t k_numEventsPerProducer = 12500;
+
+	Listeners& listeners = GetListeners();
+	core::EventManager::Update();
+	listeners.Reset();
+
+	const uint64_t numOverflowEventsBefore = core::EventManager::GetNumOverflowEvents();
+
+	NotifyFromProducers(k_numProducers, k_numEventsPerProducer, []() { std::this_thread::yield(); });
+
+	SE_CHECK(core::EventManager::GetNumOverflowEvents() == numOverflowEventsBefore);
+
+	core::EventManager::Update();
+	listeners.m_evenListenerA.HandleEvents();
+	listeners.m_evenListenerB.HandleEvents();
+	listeners.m_oddListener.HandleEvents();
+
+	SE_CHECK(CountDeliveryErrors(
+		listeners.m_evenListenerA.m_receivedEvents, k_numProducers, k_numEventsPerProducer, 0) == 0);
+	SE_CHECK(CountDeliveryErrors(
+		listeners.m_oddListener.m_receivedEvents, k_numProducers, k_numEventsPerProducer, 1) == 0);
+
+	SE_CHECK(CountPerProducerOrderingErrors(listeners.m_evenListenerA.m_receivedEvents, k_numProducers) == 0);
+	SE_CHECK(CountPerProducerOrderingErrors(listeners.m_oddListener.m_receivedEvents, k_numProducers) == 0);
+
+	listeners.Reset();
+}
+
+
+SE_BENCHMARK(EventManager_NotifyAndDispatchThroughput)
+{
+	// 100k events per frame, as a busy frame might post
+	constexpr uint32_t k_numProducers = 8;
+	constexpr uint32_t k_numEventsPerProducer = 12500;
+	constexpr uint32_t k_numIterations = 20;
+
+	Listeners& listeners = GetListeners();
+	core::EventManager::Update();
+
+	const uint64_t numOverflowEventsBefore = core::EventManager::GetNumOverflowEvents();
+
+	const double medianMs = tests::MeasureMedianMs(k_numIterations, [&listeners]()
+		{
+			NotifyFromProducers(k_numProducers, k_numEventsPerProducer, []() { std::this_thread::yield(); });
+			core::EventManager::Update();
+
+			listeners.m_evenListenerA.HandleEvents();
+			listeners.m_evenListenerB.HandleEvents();
+			listeners.m_oddListener.HandleEvents();
+			listeners.Reset();
+		});
+
+	// Includes the warm up iteration
+	const uint64_t numOverflowEvents = core::EventManager::GetNumOverflowEvents() - numOverflowEventsBefore;
+
+	tests::TestHarness::RecordTiming(
+		std::format("Notify 100k events from 8 threads, dispatch to 3 listeners ({} of {} events overflowed)",
+			numOverflowEvents, (k_numIterations + 1) * k_numProducers * k_numEventsPerProducer),
+		medianMs,
+		k_numProducers * k_numEventsPerProducer);
+}
\ No newline at end of file
@@ -0,0 +1,324 @@
+// © 2025 Adam Badke. All rights reserved.
+#include "TestHarness.h"
+
+#include "Core/Util/HashUtils.h"
+
+
+namespace
+{
+	// MSVC's std::hash<uint64_t>: FNV-1a over the bytes of the value
+	uint64_t FNV1aHash(uint64_t value)
+	{
+		uint64_t hash = 14695981039346656037ull;
+		for (uint8_t byteIdx = 0; byteIdx < sizeof(uint64_t); ++byteIdx)
+		{
+			hash ^= (value >> (byteIdx * 8)) & 0xff;
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+
+	// The previous util::HashDataBytes: Each 64-bit word was hashed and combined into a running hash, with any trailing
+	// bytes packed into a 0-padded word. Benchmarked as the baseline for XXH3
+	uint64_t PreviousHashDataBytes(void const* data, size_t numBytes)
+	{
+		uint64_t dataHash = 0;
+
+		const size_t numWords = numBytes / sizeof(uint64_t);
+		for (size_t wordIdx = 0; wordIdx < numWords; ++wordIdx)
+		{
+			uint64_t word = 0;
+			std::memcpy(&word, static_cast<uint8_t const*>(data) + wordIdx * sizeof(uint64_t), sizeof(uint64_t));
+			util::CombineHash(dataHash, FNV1aHash(word));
+		}
+
+		if (numBytes != sizeof(uint64_t)) // The single word fast path did not hash the (empty) remainder
+		{
+			uint64_t remainingBytes = 0;
+			std::memcpy(&remainingBytes,
+				static_cast<uint8_t const*>(data) + numWords * sizeof(uint64_t),
+				numBytes - numWords * sizeof(uint64_t));
+			util::CombineHash(dataHash, FNV1aHash(remainingBytes));
+		}
+		return dataHash;
+	}
+
+
+	std::vector<uint8_t> GenerateRandomBytes(size_t numBytes, std::mt19937& generator)
+	{
+		std::vector<uint8_t> bytes(numBytes);
+		for (uint8_t& byte : bytes)
+		{
+			byte = static_cast<uint8_t>(generator());
+		}
+		return bytes;
+	}
+
+
+	template<typename T>
+	size_t CountCollisions(std::vector<T> hashes)
+	{
+		std::sort(hashes.begin(), hashes.end(), [](T const& a, T const& b)
+			{
+				return std::memcmp(&a, &b, sizeof(T)) < 0;
+			});
+		return hashes.size() - std::distance(hashes.begin(), std::unique(hashes.begin(), hashes.end()));
+	}
+
+
+	// Sets of structured keys, as hashed by the engine: Each key is a small block of bytes
+	struct KeySet
+	{
+		char const* m_name;
+		size_t m_keySize;
+		std::vector<uint8_t> m_keyBytes; // Keys of m_keySize are packed contiguously
+
+		size_t GetNumKeys() const { return m_keyBytes.size() / m_keySize; }
+		uint8_t const* GetKey(size_t keyIdx) const { return m_keyBytes.data() + keyIdx * m_keySize; }
+	};
+
+
+	// Zero-filled lengths are hashed separately: They're the same bytes, with different sizes
+	std::vector<KeySet> BuildStructuredKeySets(uint32_t gridResolution, uint32_t numCounters)
+	{
+		std::vector<KeySet> keySets;
+
+		KeySet& gridKeys = keySets.emplace_back(KeySet{ .m_name = "float3 grid positions", .m_keySize = 12 });
+		for (uint32_t x = 0; x < gridResolution; ++x)
+		{
+			for (uint32_t y = 0; y < gridResolution; ++y)
+			{
+				for (uint32_t z = 0; z < gridResolution; ++z)
+				{
+					const glm::vec3 position = glm::vec3(x, y, z) * 0.25f;
+					uint8_t const* positionBytes = reinterpret_cast<uint8_t const*>(&position.x);
+					gridKeys.m_keyBytes.insert(gridKeys.m_keyBytes.end(), positionBytes, positionBytes + 12);
+				}
+			}
+		}
+
+		// Every 1 and 2-bit flip of a 64B block
+		KeySet& bitFlipKeys =
+			keySets.emplace_back(KeySet{ .m_name = "1 and 2-bit flips of a 64B block", .m_keySize = 64 });
+		std::mt19937 generator(112358);
+		const std::vector<uint8_t> block = GenerateRandomBytes(64, generator);
+		auto AddFlippedBlock = [&bitFlipKeys, &block](std::initializer_list<uint32_t> bitIndexes)
+			{
+				const size_t keyOffset = bitFlipKeys.m_keyBytes.size();
+				bitFlipKeys.m_keyBytes.insert(bitFlipKeys.m_keyBytes.end(), block.begin(), block.end());
+				for (uint32_t bitIdx : bitIndexes)
+				{
+					bitFlipKeys.m_keyBytes[keyOffset + bitIdx / 8] ^= static_cast<uint8_t>(1u << (bitIdx % 8));
+				}
+			};
+		AddFlippedBlock({});
+		for (uint32_t firstBitIdx = 0; firstBitIdx < 512; ++firstBitIdx)
+		{
+			AddFlippedBlock({ firstBitIdx });
+			for (uint32_t secondBitIdx = firstBitIdx + 1; secondBitIdx < 512; ++secondBitIdx)
+			{
+				AddFlippedBlock({ firstBitIdx, secondBitIdx });
+			}
+		}
+
+		// 16B counters: e.g. pairs of IDs
+		KeySet& counterKeys = keySets.emplace_back(KeySet{ .m_name = "16B counters", .m_keySize = 16 });
+		for (uint64_t counter = 0; counter < numCounters; ++counter)
+		{
+			const uint64_t words[2] = { counter, counter >> 3 };
+			uint8_t const* counterBytes = reinterpret_cast<uint8_t const*>(words);
+			counterKeys.m_keyBytes.insert(counterKeys.m_keyBytes.end(), counterBytes, counterBytes + 16);
+		}
+
+		return keySets;
+	}
+}
+
+
+SE_TEST(HashUtils_StreamingDigestsMatchOneShot)
+{
+	std::mt19937 generator(97531);
+
+	// Lengths around XXH3's internal boundaries: Its short, mid-size, and long input paths, and its stripes/blocks
+	for (size_t numBytes : { 0u, 1u, 3u, 4u, 8u, 9u, 16u, 17u, 128u, 129u, 240u, 241u, 1024u, 1025u, 100000u })
+	{
+		const std::vector<uint8_t> data = GenerateRandomBytes(numBytes, generator);
+		const uint64_t expectedHash = util::HashDataBytes(data.data(), data.size());
+		const util::Hash128 expectedHash128 = util::HashDataBytes128(data.data(), data.size());
+
+		// Random chunk sizes, including empty chunks
+		util::StreamingHasher hasher;
+		size_t offset = 0;
+		while (offset < data.size())
+		{
+			std::uniform_int_distribution<size_t> chunkSizeDist(0, std::min<size_t>(data.size() - offset, 300));
+			const size_t chunkSize = chunkSizeDist(generator);
+			hasher.Update(data.data() + offset, chunkSize);
+			offset += chunkSize;
+
+			// Digesting does not modify the state
+			tests::DoNotOptimize(hasher.Digest());
+		}
+		SE_CHECK(hasher.Digest() == expectedHash);
+		SE_CHECK(hasher.Digest128() == expectedHash128);
+
+		// Reset hashers can be reused
+		hasher.Reset();
+		hasher.Update(data.data(), data.size());
+		SE_CHECK(hasher.Digest() == expectedHash);
+		SE_CHECK(hasher.Digest128() == expectedHash128);
+	}
+
+	// Typed updates hash the object representation, as AddDataBytesToHash does
+	const glm::vec4 values[2] = { glm::vec4(1.f, 2.f, 3.f, 4.f), glm::vec4(-5.f) };
+	util::StreamingHasher typedHasher;
+	typedHasher.Update(values[0]);
+	typedHasher.Update(values[1]);
+	SE_CHECK(typedHasher.Digest() == util::HashDataBytes(values, sizeof(values)));
+
+	uint64_t combinedHash = 0;
+	util::AddDataBytesToHash(combinedHash, values[0]);
+	uint64_t expectedCombinedHash = 0;
+	util::CombineHash(expectedCombinedHash, util::HashDataBytes(&values[0], sizeof(glm::vec4)));
+	SE_CHECK(combinedHash == expectedCombinedHash);
+}
+
+
+SE_TEST(HashUtils_NoCollisionsOnStructuredKeys)
+{
+	for (KeySet const& keySet : BuildStructuredKeySets(64, 1 << 20))
+	{
+		std::vector<uint64_t> hashes;
+		std::vector<util::Hash128> hashes128;
+		for (size_t keyIdx = 0; keyIdx < keySet.GetNumKeys(); ++keyIdx)
+		{
+			hashes.emplace_back(util::HashDataBytes(keySet.GetKey(keyIdx), keySet.m_keySize));
+			hashes128.emplace_back(util::HashDataBytes128(keySet.GetKey(keyIdx), keySet.m_keySize));
+		}
+		SE_CHECK(CountCollisions(hashes) == 0);
+		SE_CHECK(CountCollisions(hashes128) == 0);
+	}
+
+	// Inputs that differ only in their number of trailing 0 bytes are distinct. The previous hash padded the trailing
+	// bytes of its last word with 0's, so these collided
+	const std::vector<uint8_t> zeros(256, 0);
+	std::vector<uint64_t> zeroPaddedHashes;
+	std::vector<util::Hash128> zeroPaddedHashes128;
+	for (size_t numBytes = 0; numBytes <= zeros.size(); ++numBytes)
+	{
+		zeroPaddedHashes.emplace_back(util::HashDataBytes(zeros.data(), numBytes));
+		zeroPaddedHashes128.emplace_back(util::HashDataBytes128(zeros.data(), numBytes));
+	}
+	SE_CHECK(CountCollisions(zeroPaddedHashes) == 0);
+	SE_CHECK(CountCollisions(zeroPaddedHashes128) == 0);
+}
+
+
+SE_BENCHMARK(HashUtils_Throughput)
+{
+	std::mt19937 generator(24680);
+
+	// Large buffers: e.g. vertex streams and texture data
+	{
+		constexpr size_t k_numBytes = 1024 * 1024;
+		const std::vector<uint8_t> data = GenerateRandomBytes(k_numBytes, generator);
+
+		auto MeasureBuffer = [&data](char const* label, auto&& HashFunction)
+			{
+				const double ms = tests::MeasureMedianMs(50, [&]()
+					{
+						tests::DoNotOptimize(HashFunction(data.data(), data.size()));
+					});
+				tests::TestHarness::RecordTiming(label, ms, data.size());
+			};
+
+		MeasureBuffer("XXH3 64-bit: 1MB buffer", util::HashDataBytes);
+		MeasureBuffer("XXH3 128-bit: 1MB buffer", util::HashDataBytes128);
+		MeasureBuffer("StreamingHasher, 4KB chunks: 1MB buffer", [](void const* bytes, size_t numBytes)
+			{
+				util::StreamingHasher hasher;
+				for (size_t offset = 0; offset < numBytes; offset += 4096)
+				{
+					const size_t chunkSize = std::min<size_t>(numBytes - offset, 4096);
+					hasher.Update(static_cast<uint8_t const*>(bytes) + offset, chunkSize);
+				}
+				return hasher.Digest();
+			});
+		MeasureBuffer("Previous FNV reference: 1MB buffer", PreviousHashDataBytes);
+	}
+
+	// Small keys: e.g. float3 positions, and root constants
+	{
+		constexpr size_t k_keySize = 12;
+		constexpr size_t k_numKeys = 1000000;
+		const std::vector<uint8_t> keyBytes = GenerateRandomBytes(k_keySize * k_numKeys, generator);
+
+		auto MeasureKeys = [&keyBytes](char const* label, auto&& HashFunction)
+			{
+				const double ms = tests::MeasureMedianMs(20, [&]()
+					{
+						uint64_t hashSum = 0;
+						for (size_t keyIdx = 0; keyIdx < k_numKeys; ++keyIdx)
+						{
+							hashSum += HashFunction(keyBytes.data() + keyIdx * k_keySize, k_keySize);
+						}
+						tests::DoNotOptimize(hashSum);
+					});
+				tests::TestHarness::RecordTiming(label, ms, k_numKeys);
+			};
+
+		MeasureKeys("XXH3 64-bit: 1M 12B keys", util::HashDataBytes);
+		MeasureKeys("Previous FNV reference: 1M 12B keys", PreviousHashDataBytes);
+	}
+}
+
+
+SE_BENCHMARK(HashUtils_Collisions)
+{
+	// Times hashing each key set, and reports the number of collisions in the label
+	auto MeasureKeySet = [](std::string_view hashName, KeySet const& keySet, auto&& HashFunction)
+		{
+			std::vector<uint64_t> hashes(keySet.GetNumKeys());
+			const double ms = tests::MeasureMedianMs(5, [&]()
+				{
+					for (size_t keyIdx = 0; keyIdx < keySet.GetNumKeys(); ++keyIdx)
+					{
+						hashes[keyIdx] = HashFunction(keySet.GetKey(keyIdx), keySet.m_keySize);
+					}
+				});
+			tests::TestHarness::RecordTiming(
+				std::format("{}: {} {} ({} collisions)",
+					hashName, keySet.GetNumKeys(), keySet.m_name, CountCollisions(hashes)),
+				ms,
+				keySet.GetNumKeys());
+		};
+
+	for (KeySet const& keySet : BuildStructuredKeySets(128, 1 << 22))
+	{
+		MeasureKeySet("XXH3 64-bit", keySet, util::HashDataBytes);
+		MeasureKeySet("Previous FNV reference", keySet, PreviousHashDataBytes);
+	}
+
+	// The same bytes with different sizes: Every length of 0-filled data, up to 1KB
+	const std::vector<uint8_t> zeros(1024, 0);
+	auto MeasureZeroFilledLengths = [&zeros](std::string_view hashName, auto&& HashFunction)
+		{
+			std::vector<uint64_t> hashes(zeros.size() + 1);
+			const double ms = tests::MeasureMedianMs(5, [&]()
+				{
+					for (size_t numBytes = 0; numBytes <= zeros.size(); ++numBytes)
+					{
+						hashes[numBytes] = HashFunction(zeros.data(), numBytes);
+					}
+				});
+			tests::TestHarness::RecordTiming(
+				std::format("{}: {} 0-filled lengths ({} collisions)",
+					hashName, hashes.size(), CountCollisions(hashes)),
+				ms,
+				hashes.size());
+		};
+
+	MeasureZeroFilledLengths("XXH3 64-bit", util::HashDataBytes);
+	MeasureZeroFilledLengths("Previous FNV reference", PreviousHashDataBytes);
+}
\ No newline at end of file
@@ -0,0 +1,346 @@
+// © 2025 Adam Badke. All rights reserved.
+#include "TestHarness.h"
+
+#include "Core/Inventory.h"
+
+
+namespace
+{
+	// Unique to these tests: Each test uses its own resource types, so their ResourceSystems start out empty
+	template<uint32_t TypeIdx>
+	struct TestResource final
+	{
+		uint64_t m_value;
+
+		void Destroy() {}
+
+		static std::array<std::atomic<uint32_t>, 1024> s_numLoads; // Indexed by resource index
+	};
+
+	template<uint32_t TypeIdx>
+	std::array<std::atomic<uint32_t>, 1024> TestResource<TypeIdx>::s_numLoads{};
+
+
+	constexpr uint64_t k_idBase = 0x5E1B0000;
+
+	util::HashKey GetResourceID(uint32_t resourceIdx)
+	{
+		return util::HashKey(k_idBase + resourceIdx);
+	}
+
+	uint64_t GetExpectedValue(uint32_t typeIdx, uint32_t resourceIdx)
+	{
+		return typeIdx * 100000llu + resourceIdx * 7llu;
+	}
+
+
+	template<uint32_t TypeIdx>
+	struct TestLoadContext final : public virtual core::ILoadContext<TestResource<TypeIdx>>
+	{
+		TestLoadContext(uint32_t resourceIdx) : m_resourceIdx(resourceIdx) {}
+
+		std::unique_ptr<TestResource<TypeIdx>> Load(core::InvPtr<TestResource<TypeIdx>>&) override
+		{
+			TestResource<TypeIdx>::s_numLoads[m_resourceIdx].fetch_add(1);
+
+			return std::make_unique<TestResource<TypeIdx>>(TestResource<TypeIdx>{
+				.m_value = GetExpectedValue(TypeIdx, m_resourceIdx) });
+		}
+
+		uint32_t m_resourceIdx;
+	};
+
+
+	template<uint32_t TypeIdx>
+	core::InvPtr<TestResource<TypeIdx>> GetTestResource(uint32_t resourceIdx)
+	{
+		return core::Inventory::Get<TestResource<TypeIdx>>(
+			GetResourceID(resourceIdx), std::make_shared<TestLoadContext<TypeIdx>>(resourceIdx));
+	}
+
+
+	// Requests and dereferences every resource of the given type, checking the results as it goes. Also queries
+	// random other resources, which may or may not have been requested yet by another thread
+	template<uint32_t TypeIdx>
+	void RequestAndCheckResources(
+		std::vector<uint32_t> const& requestOrder,
+		std::vector<core::InvPtr<TestResource<TypeIdx>>>& invPtrsOut,
+		std::mt19937& generator)
+	{
+		using Resource = TestResource<TypeIdx>;
+
+		for (uint32_t resourceIdx : requestOrder)
+		{
+			core::InvPtr<Resource> invPtr = GetTestResource<TypeIdx>(resourceIdx);
+			SE_CHECK(core::Inventory::Has<Resource>(GetResourceID(resourceIdx)));
+
+			SE_CHECK(invPtr->m_value == GetExpectedValue(TypeIdx, resourceIdx)); // Blocks until it has loaded
+			SE_CHECK(core::Inventory::HasLoaded<Resource>(GetResourceID(resourceIdx)));
+
+			const uint32_t otherIdx = generator() % requestOrder.size();
+			const bool otherHasLoaded = core::Inventory::HasLoaded<Resource>(GetResourceID(otherIdx));
+			SE_CHECK(!otherHasLoaded || core::Inventory::Has<Resource>(GetResourceID(otherIdx)));
+
+			invPtrsOut.emplace_back(std::move(invPtr));
+		}
+	}
+
+
+	// The loading job enqueued by the first request for a resource holds a copy of its InvPtr until the ThreadPool
+	// executes it, even if another thread stole the work. Wait for them, so the use counts only include our InvPtrs
+	template<uint32_t TypeIdx>
+	void WaitForLoadingJobs(std::vector<core::InvPtr<TestResource<TypeIdx>>> const& invPtrs, size_t numOwners)
+	{
+		for (core::InvPtr<TestResource<TypeIdx>> const& invPtr : invPtrs)
+		{
+			while (invPtr.UseCount() > numOwners)
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+
+	// Returns the number of InvPtrs that don't share the same control block as the first thread's InvPtr for the same
+	// resource, or that have an unexpected use count
+	template<uint32_t TypeIdx>
+	uint32_t CountMismatchedInvPtrs(
+		std::vector<std::vector<core::InvPtr<TestResource<TypeIdx>>>> const& threadInvPtrs, uint32_t numResources)
+	{
+		using Resource = TestResource<TypeIdx>;
+
+		std::vector<core::InvPtr<Resource> const*> firstThreadInvPtrs(numResources, nullptr);
+		for (core::InvPtr<Resource> const& invPtr : threadInvPtrs[0])
+		{
+			firstThreadInvPtrs[(invPtr->m_value - GetExpectedValue(TypeIdx, 0)) / 7] = &invPtr;
+		}
+
+		uint32_t numErrors = 0;
+		for (std::vector<core::InvPtr<Resource>> const& invPtrs : threadInvPtrs)
+		{
+			numErrors += (invPtrs.size() != numResources);
+
+			for (core::InvPtr<Resource> const& invPtr : invPtrs)
+			{
+				core::InvPtr<Resource> const* expected =
+					firstThreadInvPtrs[(invPtr->m_value - GetExpectedValue(TypeIdx, 0)) / 7];
+
+				numErrors += (expected == nullptr || !(invPtr == *expected));
+				numErrors += (invPtr.UseCount() != threadInvPtrs.size());
+			}
+		}
+		return numErrors;
+	}
+
+
+	// The previous lookup path, for reference: A global shared_mutex guarding a std::type_index map of ResourceSystems,
+	// a dynamic_cast, and a single shared_mutex guarding all of the type's resources
+	class PreviousInventoryReference final
+	{
+	public:
+		template<typename T>
+		void RegisterLoaded(util::HashKey id)
+		{
+			std::unique_lock<std::shared_mutex> writeLock(m_resourceSystemsMutex);
+
+			std::unique_ptr<IResourceSystem>& resourceSystem = m_resourceSystems[std::type_index(typeid(T))];
+			if (resourceSystem == nullptr)
+			{
+				resourceSystem = std::make_unique<ResourceSystem<T>>();
+			}
+
+			ResourceSystem<T>* typedResourceSystem = dynamic_cast<ResourceSystem<T>*>(resourceSystem.get());
+
+			std::unique_lock<std::shared_mutex> resourcesWriteLock(typedResourceSystem->m_resourcesMutex);
+			typedResourceSystem->m_resources.emplace(id, std::make_unique<std::atomic<core::ResourceState>>(
+				core::ResourceState::Ready));
+		}
+
+		template<typename T>
+		bool HasLoaded(util::HashKey id) const
+		{
+			ResourceSystem<T> const* resourceSystem = nullptr;
+			{
+				std::shared_lock<std::shared_mutex> readLock(m_resourceSystemsMutex);
+
+				auto resourceSystemItr = m_resourceSystems.find(std::type_index(typeid(T)));
+				if (resourceSystemItr != m_resourceSystems.end())
+				{
+					resourceSystem = dynamic_cast<ResourceSystem<T> const*>(resourceSystemItr->second.get());
+				}
+			}
+			if (resourceSystem == nullptr)
+			{
+				return false;
+			}
+
+			std::shared_lock<std::shared_mutex> readLock(resourceSystem->m_resourcesMutex);
+
+			auto resourceItr = resourceSystem->m_resources.find(id);
+			return resourceItr != resourceSystem->m_resources.end() &&
+				resourceItr->second->load(std::memory_order_acquire) == core::ResourceState::Ready;
+		}
+
+
+	private:
+		struct IResourceSystem
+		{
+			virtual ~IResourceSystem() = default;
+		};
+
+		template<typename T>
+		struct ResourceSystem final : public virtual IResourceSystem
+		{
+			std::unordered_map<util::HashKey, std::unique_ptr<std::atomic<core::ResourceState>>> m_resources;
+			mutable std::shared_mutex m_resourcesMutex;
+		};
+
+		std::unordered_map<std::type_index, std::unique_ptr<IResourceSystem>> m_resourceSystems;
+		mutable std::shared_mutex m_resourceSystemsMutex;
+	};
+
+
+	// Executes numLookupsPerThread lookups of random IDs from each thread at once
+	template<typename LookupFunction>
+	void LookupFromThreads(
+		uint32_t numThreads, uint32_t numLookupsPerThread, uint32_t numResources, LookupFunction&& lookup)
+	{
+		std::vector<std::thread> threads;
+		for (uint32_t threadIdx = 0; threadIdx < numThreads; ++threadIdx)
+		{
+			threads.emplace_back([&lookup, threadIdx, numLookupsPerThread, numResources]()
+				{
+					std::mt19937 generator(threadIdx);
+
+					uint32_t numLoaded = 0;
+					for (uint32_t lookupIdx = 0; lookupIdx < numLookupsPerThread; ++lookupIdx)
+					{
+						numLoaded += lookup(GetResourceID(generator() % numResources));
+					}
+					SE_CHECK(numLoaded == numLookupsPerThread);
+				});
+		}
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+	}
+}
+
+
+SE_TEST(Inventory_ConcurrentRequestsLoadEachResourceOnce)
+{
+	constexpr uint32_t k_numThreads = 8;
+	constexpr uint32_t k_numResources = 1024;
+
+	using ResourceA = TestResource<0>;
+	using ResourceB = TestResource<1>;
+
+	SE_CHECK(!core::Inventory::Has<ResourceA>(GetResourceID(0)));
+	SE_CHECK(!core::Inventory::HasLoaded<ResourceB>(GetResourceID(0)));
+
+	// Every thread requests every resource of both types, in the same order so they race to register each ID: The
+	// first request for each type creates its ResourceSystem, and the first request for each ID registers it
+	std::vector<std::vector<core::InvPtr<ResourceA>>> invPtrsA(k_numThreads);
+	std::vector<std::vector<core::InvPtr<ResourceB>>> invPtrsB(k_numThreads);
+	{
+		std::vector<std::thread> threads;
+		for (uint32_t threadIdx = 0; threadIdx < k_numThreads; ++threadIdx)
+		{
+			threads.emplace_back([&invPtrsA, &invPtrsB, threadIdx]()
+				{
+					std::vector<uint32_t> requestOrder(k_numResources);
+					std::iota(requestOrder.begin(), requestOrder.end(), 0);
+					std::shuffle(requestOrder.begin(), requestOrder.end(), std::mt19937(42));
+
+					std::mt19937 generator(threadIdx);
+
+					if (threadIdx % 2 == 0)
+					{
+						RequestAndCheckResources<0>(requestOrder, invPtrsA[threadIdx], generator);
+						RequestAndCheckResources<1>(requestOrder, invPtrsB[threadIdx], generator);
+					}
+					else
+					{
+						RequestAndCheckResources<1>(requestOrder, invPtrsB[threadIdx], generator);
+						RequestAndCheckResources<0>(requestOrder, invPtrsA[threadIdx], generator);
+					}
+				});
+		}
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+	// Every thread must have received the same resource for each ID, and each resource loaded exactly once
+	uint32_t numErrors = 0;
+	for (uint32_t resourceIdx = 0; resourceIdx < k_numResources; ++resourceIdx)
+	{
+		numErrors += (ResourceA::s_numLoads[resourceIdx].load() != 1);
+		numErrors += (ResourceB::s_numLoads[resourceIdx].load() != 1);
+	}
+	SE_CHECK(numErrors == 0);
+
+	WaitForLoadingJobs(invPtrsA[0], k_numThreads);
+	WaitForLoadingJobs(invPtrsB[0], k_numThreads);
+
+	SE_CHECK(CountMismatchedInvPtrs(invPtrsA, k_numResources) == 0);
+	SE_CHECK(CountMismatchedInvPtrs(invPtrsB, k_numResources) == 0);
+
+	// Releasing every InvPtr defers the release: The resources are still registered, but no longer loaded
+	invPtrsA.clear();
+	invPtrsB.clear();
+
+	for (uint32_t resourceIdx = 0; resourceIdx < k_numResources; ++resourceIdx)
+	{
+		numErrors += core::Inventory::HasLoaded<ResourceA>(GetResourceID(resourceIdx));
+		numErrors += core::Inventory::Has<ResourceB>(GetResourceID(resourceIdx));
+	}
+	SE_CHECK(numErrors == 0);
+}
+
+
+SE_BENCHMARK(Inventory_ConcurrentLookupThroughput)
+{
+	constexpr uint32_t k_numResources = 1024;
+	constexpr uint32_t k_numLookupsPerThread = 100000;
+
+	using Resource = TestResource<2>;
+
+	PreviousInventoryReference previousInventory;
+
+	std::vector<core::InvPtr<Resource>> invPtrs;
+	for (uint32_t resourceIdx = 0; resourceIdx < k_numResources; ++resourceIdx)
+	{
+		invPtrs.emplace_back(GetTestResource<2>(resourceIdx));
+		tests::DoNotOptimize(invPtrs.back()->m_value); // Wait for it to load
+
+		previousInventory.RegisterLoaded<Resource>(GetResourceID(resourceIdx));
+	}
+
+	for (uint32_t numThreads : { 1u, 8u })
+	{
+		const uint64_t numLookups = static_cast<uint64_t>(numThreads) * k_numLookupsPerThread;
+
+		const double inventoryMs = tests::MeasureMedianMs(10, [numThreads]()
+			{
+				LookupFromThreads(numThreads, k_numLookupsPerThread, k_numResources,
+					[](util::HashKey id) { return core::Inventory::HasLoaded<Resource>(id); });
+			});
+		tests::TestHarness::RecordTiming(
+			std::format("Inventory::HasLoaded, per-type slot and 16 shards: {} thread(s)", numThreads),
+			inventoryMs,
+			numLookups);
+
+		const double previousMs = tests::MeasureMedianMs(10, [numThreads, &previousInventory]()
+			{
+				LookupFromThreads(numThreads, k_numLookupsPerThread, k_numResources,
+					[&previousInventory](util::HashKey id) { return previousInventory.HasLoaded<Resource>(id); });
+			});
+		tests::TestHarness::RecordTiming(
+			std::format("Previous type map and single shared_mutex map reference: {} thread(s)", numThreads),
+			previousMs,
+			numLookups);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,203 @@
+// © 2025 Adam Badke. All rights reserved.
+#include "TestHarness.h"
+
+#include "Core/Logger.h"
+
+#include "Core/Definitions/ConfigKeys.h"
+
+
+namespace
+{
+	constexpr char const* k_testMessageTag = "LoggerTests:";
+
+
+	// Varies the record sizes, so the rings wrap around at different offsets
+	std::string GetTestPayload(uint32_t producerIdx, uint32_t sequenceIdx)
+	{
+		return std::string(sequenceIdx % 61, static_cast<char>('a' + producerIdx % 26));
+	}
+
+
+	void LogTestMessage(uint32_t producerIdx, uint32_t sequenceIdx)
+	{
+		// The payloads are temporaries: The logger must copy them, rather than holding on to the pointers
+		const std::string payload = GetTestPayload(producerIdx, sequenceIdx);
+		if (sequenceIdx % 4 == 0)
+		{
+			const std::wstring widePayload(payload.begin(), payload.end());
+			LOG(L"LoggerTests: producer %u message %u [%ls]", producerIdx, sequenceIdx, widePayload.c_str());
+		}
+		else
+		{
+			LOG_WARNING("LoggerTests: producer %u message %u [%s]", producerIdx, sequenceIdx, payload.c_str());
+		}
+	}
+
+
+	struct ParsedLog
+	{
+		std::vector<std::vector<uint32_t>> m_sequenceIdxs; // Per producer, in the order they were written
+		uint32_t m_numMalformedMessages = 0;
+		uint32_t m_numDroppedMessages = 0;
+	};
+
+
+	// Restarts the Logger so everything it has received is flushed to the log file, and parses our messages from it
+	ParsedLog ParseLogFile(uint32_t numProducers)
+	{
+		core::Logger::Shutdown();
+
+		ParsedLog parsedLog;
+		parsedLog.m_sequenceIdxs.resize(numProducers);
+
+		std::ifstream logFile(std::format("{}{}", core::configkeys::k_logOutputDir, core::configkeys::k_logFileName));
+
+		std::string line;
+		while (std::getline(logFile, line))
+		{
+			uint32_t numDropped = 0;
+			if (line.find("log messages were dropped") != std::string::npos &&
+				std::sscanf(line.c_str() + line.find_first_of("0123456789"), "%u", &numDropped) == 1)
+			{
+				parsedLog.m_numDroppedMessages += numDropped;
+				continue;
+			}
+
+			const size_t tagPos = line.find(k_testMessageTag);
+			if (tagPos == std::string::npos)
+			{
+				continue;
+			}
+
+			uint32_t producerIdx = 0;
+			uint32_t sequenceIdx = 0;
+			const size_t payloadBegin = line.find('[', tagPos);
+			const size_t payloadEnd = line.rfind(']');
+			const int numParsed = std::sscanf(
+				line.c_str() + tagPos, "LoggerTests: producer %u message %u", &producerIdx, &sequenceIdx);
+
+			if (numParsed != 2 ||
+				producerIdx >= numProducers ||
+				payloadBegin == std::string::npos ||
+				payloadEnd == std::string::npos ||
+				payloadEnd < payloadBegin ||
+				line.substr(payloadBegin + 1, payloadEnd - payloadBegin - 1) !=
+					GetTestPayload(producerIdx, sequenceIdx))
+			{
+				++parsedLog.m_numMalformedMessages;
+				continue;
+			}
+			parsedLog.m_sequenceIdxs[producerIdx].emplace_back(sequenceIdx);
+		}
+		logFile.close();
+
+		core::Logger::Startup(false); // Note: Truncates the log file
+
+		return parsedLog;
+	}
+}
+
+
+SE_TEST(Logger_DeliversEveryMessageInPerThreadOrder)
+{
+	// Each ring holds ~1k of these records: The producers will repeatedly fill their ring, and wait for the logger
+	constexpr uint32_t k_numProducers = 8;
+	constexpr uint32_t k_numMessagesPerProducer = 10000;
+
+	ParseLogFile(k_numProducers); // Start from an empty log file
+
+	std::vector<std::thread> producers;
+	for (uint32_t producerIdx = 0; producerIdx < k_numProducers; ++producerIdx)
+	{
+		producers.emplace_back([producerIdx]()
+			{
+				for (uint32_t sequenceIdx = 0; sequenceIdx < k_numMessagesPerProducer; ++sequenceIdx)
+				{
+					LogTestMessage(producerIdx, sequenceIdx);
+				}
+			});
+	}
+	for (std::thread& producer : producers)
+	{
+		producer.join();
+	}
+
+	const ParsedLog parsedLog = ParseLogFile(k_numProducers);
+
+	SE_CHECK(parsedLog.m_numMalformedMessages == 0);
+	SE_CHECK(parsedLog.m_numDroppedMessages == 0); // Producers wait for the logger thread rather than dropping
+
+	uint32_t numMissingOrReordered = 0;
+	for (std::vector<uint32_t> const& sequenceIdxs : parsedLog.m_sequenceIdxs)
+	{
+		numMissingOrReordered += (sequenceIdxs.size() != k_numMessagesPerProducer);
+		for (uint32_t idx = 0; idx < sequenceIdxs.size(); ++idx)
+		{
+			numMissingOrReordered += (sequenceIdxs[idx] != idx);
+		}
+	}
+	SE_CHECK(numMissingOrReordered == 0);
+}
+
+
+SE_TEST(Logger_CountsMessagesDroppedWithoutALoggerThread)
+{
+	// With no logger thread to drain it, a full ring drops (and counts) messages instead of blocking. Once the logger
+	// restarts, everything that fit must still be delivered
+	constexpr uint32_t k_numMessages = 5000;
+
+	ParseLogFile(1);
+
+	core::Logger::Shutdown();
+
+	std::thread producer([]()
+		{
+			for (uint32_t sequenceIdx = 0; sequenceIdx < k_numMessages; ++sequenceIdx)
+			{
+				LogTestMessage(0, sequenceIdx);
+			}
+		});
+	producer.join();
+
+	core::Logger::Startup(false);
+
+	const ParsedLog parsedLog = ParseLogFile(1);
+
+	SE_CHECK(parsedLog.m_numMalformedMessages == 0);
+	SE_CHECK(parsedLog.m_numDroppedMessages > 0);
+	SE_CHECK(parsedLog.m_sequenceIdxs[0].size() + parsedLog.m_numDroppedMessages == k_numMessages);
+
+	// Once the ring is full, smaller records may still fit: The survivors aren't necessarily contiguous, but must be
+	// in order
+	SE_CHECK(std::adjacent_find(parsedLog.m_sequenceIdxs[0].begin(), parsedLog.m_sequenceIdxs[0].end(),
+		[](uint32_t prev, uint32_t next) { return next <= prev; }) == parsedLog.m_sequenceIdxs[0].end());
+}
+
+
+SE_BENCHMARK(Logger_ProducerThroughput)
+{
+	constexpr uint32_t k_numProducers = 4;
+	constexpr uint32_t k_numMessagesPerProducer = 2000;
+
+	const double medianMs = tests::MeasureMedianMs(10, []()
+		{
+			std::vector<std::thread> producers;
+			for (uint32_t producerIdx = 0; producerIdx < k_numProducers; ++producerIdx)
+			{
+				producers.emplace_back([producerIdx]()
+					{
+						for (uint32_t sequenceIdx = 0; sequenceIdx < k_numMessagesPerProducer; ++sequenceIdx)
+						{
+							LOG("LoggerTests: producer %u message %u [%s]", producerIdx, sequenceIdx, "payload");
+						}
+					});
+			}
+			for (std::thread& producer : producers)
+			{
+				producer.join();
+			}
+		});
+
+	tests::TestHarness::RecordTiming("Log 8k messages from 4 threads (producer side only)",
+		medianMs, k_numProducers * k_numMessagesPerProducer);
+}
\ No newline at end of file
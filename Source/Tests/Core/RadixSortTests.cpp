@@ -0,0 +1,252 @@
+// © 2025 Adam Badke. All rights reserved.
+#include "TestHarness.h"
+
+#include "Core/Util/RadixSort.h"
+
+
+namespace
+{
+	// Keys are supplied in index order, as Stage::ResolveBatches does
+	std::vector<util::RadixSortKey> GenerateKeys(
+		size_t numKeys, std::function<uint64_t()> const& generateKey)
+	{
+		std::vector<util::RadixSortKey> keys;
+		keys.reserve(numKeys);
+		for (size_t keyIdx = 0; keyIdx < numKeys; ++keyIdx)
+		{
+			keys.emplace_back(util::RadixSortKey{ .m_key = generateKey(), .m_index = static_cast<uint32_t>(keyIdx) });
+		}
+		return keys;
+	}
+
+
+	// RadixSort must produce exactly the order of a stable sort on the key alone
+	bool MatchesStableSort(std::vector<util::RadixSortKey> keys, std::vector<util::RadixSortKey>& scratch)
+	{
+		std::vector<util::RadixSortKey> expected = keys;
+		std::stable_sort(expected.begin(), expected.end(),
+			[](util::RadixSortKey const& a, util::RadixSortKey const& b)
+			{
+				return a.m_key < b.m_key;
+			});
+
+		util::RadixSort(keys, scratch);
+
+		return std::equal(keys.begin(), keys.end(), expected.begin(), expected.end(),
+			[](util::RadixSortKey const& a, util::RadixSortKey const& b)
+			{
+				return a.m_key == b.m_key && a.m_index == b.m_index;
+			});
+	}
+
+
+	// Stands in for a gr::Batch: Only the data hash is read while sorting
+	struct TestBatch
+	{
+		uint64_t m_dataHash;
+		std::array<uint8_t, 248> m_batchData;
+	};
+
+
+	// Stands in for a gr::StageBatchHandle, which is dereferenced to reach the batch
+	struct TestBatchHandle
+	{
+		std::unique_ptr<TestBatch> m_batch;
+	};
+
+
+	// Batches are allocated individually, in shuffled order, and 1 in 8 has a unique data hash (i.e. the rest can be
+	// instanced)
+	std::vector<TestBatchHandle> CreateBatches(size_t numBatches, std::mt19937_64& generator)
+	{
+		std::vector<uint64_t> uniqueHashes(std::max<size_t>(numBatches / 8, 1));
+		for (uint64_t& hash : uniqueHashes)
+		{
+			hash = generator();
+		}
+
+		std::vector<std::unique_ptr<TestBatch>> allocatedBatches;
+		allocatedBatches.reserve(numBatches);
+		for (size_t batchIdx = 0; batchIdx < numBatches; ++batchIdx)
+		{
+			allocatedBatches.emplace_back(std::make_unique<TestBatch>(
+				TestBatch{ .m_dataHash = uniqueHashes[generator() % uniqueHashes.size()], .m_batchData = {} }));
+		}
+		std::shuffle(allocatedBatches.begin(), allocatedBatches.end(), generator);
+
+		std::vector<TestBatchHandle> batches;
+		batches.reserve(numBatches);
+		for (std::unique_ptr<TestBatch>& batch : allocatedBatches)
+		{
+			batches.emplace_back(TestBatchHandle{ .m_batch = std::move(batch) });
+		}
+		return batches;
+	}
+}
+
+
+SE_TEST(RadixSort_IsStableForEqualKeys)
+{
+	std::mt19937_64 generator(8642);
+	std::vector<util::RadixSortKey> scratch;
+
+	// Few distinct keys, so most keys have many equal neighbours. Sizes straddle the comparison sort cutoff
+	for (size_t numKeys : { 1000, 1024, 5000, 65536 })
+	{
+		std::vector<util::RadixSortKey> keys = GenerateKeys(numKeys, [&generator]() { return generator() % 16; });
+		SE_CHECK(MatchesStableSort(keys, scratch));
+
+		// Every key equal: Every pass is skipped, and the input order is kept
+		keys = GenerateKeys(numKeys, []() { return 0xabcdef0123456789ull; });
+		SE_CHECK(MatchesStableSort(keys, scratch));
+	}
+
+	// A stable sort keeps equal keys in index order
+	std::vector<util::RadixSortKey> keys = GenerateKeys(20000, [&generator]() { return generator() % 3; });
+	util::RadixSort(keys, scratch);
+	SE_CHECK(std::is_sorted(keys.begin(), keys.end(),
+		[](util::RadixSortKey const& a, util::RadixSortKey const& b)
+		{
+			return a.m_key < b.m_key || (a.m_key == b.m_key && a.m_index < b.m_index);
+		}));
+}
+
+
+SE_TEST(RadixSort_SmallInputsUseComparisonSort)
+{
+	std::mt19937_64 generator(97531);
+
+	// Below the cutoff the scratch buffer is never touched
+	for (size_t numKeys : { 0, 1, 2, 17, 1023 })
+	{
+		std::vector<util::RadixSortKey> scratch;
+
+		std::vector<util::RadixSortKey> keys = GenerateKeys(numKeys, [&generator]() { return generator() % 64; });
+		SE_CHECK(MatchesStableSort(keys, scratch));
+		SE_CHECK(scratch.empty());
+	}
+
+	// At the cutoff the radix sort is used, and sizes the scratch buffer
+	std::vector<util::RadixSortKey> scratch;
+	std::vector<util::RadixSortKey> keys = GenerateKeys(1024, [&generator]() { return generator() % 64; });
+	SE_CHECK(MatchesStableSort(keys, scratch));
+	SE_CHECK(scratch.size() == 1024);
+}
+
+
+SE_TEST(RadixSort_SortsFull64BitKeys)
+{
+	std::mt19937_64 generator(13579);
+	std::vector<util::RadixSortKey> scratch;
+
+	constexpr size_t k_numKeys = 50000;
+
+	// Random keys over the whole range, including the top bit
+	SE_CHECK(MatchesStableSort(GenerateKeys(k_numKeys, [&generator]() { return generator(); }), scratch));
+
+	// Keys that only differ in a single digit: Every other pass is skipped. This includes an odd number of passes,
+	// where the result finishes in the scratch buffer
+	for (uint32_t digitIdx = 0; digitIdx < 8; ++digitIdx)
+	{
+		const uint64_t baseKey = 0x8070605040302010ull;
+		const uint32_t shift = digitIdx * 8;
+
+		SE_CHECK(MatchesStableSort(GenerateKeys(k_numKeys, [&generator, baseKey, shift]()
+			{
+				return (baseKey & ~(0xffull << shift)) | ((generator() % 256) << shift);
+			}),
+			scratch));
+	}
+
+	// Keys at the extremes of the range
+	SE_CHECK(MatchesStableSort(GenerateKeys(k_numKeys, [&generator]()
+		{
+			constexpr uint64_t k_extremes[] = { 0, 1, std::numeric_limits<uint64_t>::max() - 1,
+				std::numeric_limits<uint64_t>::max(), 1ull << 63, (1ull << 63) - 1 };
+			return k_extremes[generator() % std::size(k_extremes)];
+		}),
+		scratch));
+
+	// The same scratch buffer is reused between calls of varying sizes
+	for (size_t numKeys : { 200000, 3000, 70000 })
+	{
+		SE_CHECK(MatchesStableSort(GenerateKeys(numKeys, [&generator]() { return generator() >> 3; }), scratch));
+	}
+}
+
+
+SE_BENCHMARK(RadixSort_BatchSortKeys)
+{
+	std::mt19937_64 generator(11235);
+
+	for (size_t numBatches : { 50000, 200000 })
+	{
+		const std::vector<TestBatchHandle> batches = CreateBatches(numBatches, generator);
+
+		// The previous Stage::ResolveBatches: std::sort pointers to the batch handles, reading both batches' data
+		// hashes through the handles for every comparison
+		std::vector<TestBatchHandle const*> batchPtrs;
+		const double handleSortMs = tests::MeasureMedianMs(10, [&batches, &batchPtrs]()
+			{
+				batchPtrs.clear();
+				batchPtrs.reserve(batches.size());
+				for (TestBatchHandle const& batch : batches)
+				{
+					batchPtrs.emplace_back(&batch);
+				}
+
+				std::sort(batchPtrs.begin(), batchPtrs.end(),
+					[](TestBatchHandle const* a, TestBatchHandle const* b)
+					{
+						return a->m_batch->m_dataHash < b->m_batch->m_dataHash;
+					});
+				tests::DoNotOptimize(batchPtrs.data());
+			});
+		tests::TestHarness::RecordTiming(
+			std::format("std::sort batch handles: {} batches", numBatches), handleSortMs, numBatches);
+
+		// Packing the keys, and sorting them: Separates the gain from packing from the gain from the radix sort
+		std::vector<util::RadixSortKey> sortKeys;
+		std::vector<util::RadixSortKey> scratch;
+		auto PackSortKeys = [&batches, &sortKeys]()
+			{
+				sortKeys.clear();
+				sortKeys.reserve(batches.size());
+				for (size_t batchIdx = 0; batchIdx < batches.size(); ++batchIdx)
+				{
+					sortKeys.emplace_back(util::RadixSortKey{
+						.m_key = batches[batchIdx].m_batch->m_dataHash,
+						.m_index = static_cast<uint32_t>(batchIdx) });
+				}
+			};
+
+		const double keySortMs = tests::MeasureMedianMs(10, [&sortKeys, &PackSortKeys]()
+			{
+				PackSortKeys();
+				std::sort(sortKeys.begin(), sortKeys.end(),
+					[](util::RadixSortKey const& a, util::RadixSortKey const& b)
+					{
+						return a.m_key < b.m_key || (a.m_key == b.m_key && a.m_index < b.m_index);
+					});
+				tests::DoNotOptimize(sortKeys.data());
+			});
+		tests::TestHarness::RecordTiming(
+			std::format("std::sort packed keys: {} batches", numBatches), keySortMs, numBatches);
+
+		const double radixSortMs = tests::MeasureMedianMs(10, [&sortKeys, &scratch, &PackSortKeys]()
+			{
+				PackSortKeys();
+				util::RadixSort(sortKeys, scratch);
+				tests::DoNotOptimize(sortKeys.data());
+			});
+		tests::TestHarness::RecordTiming(
+			std::format("RadixSort packed keys: {} batches", numBatches), radixSortMs, numBatches);
+
+		// Both orders group equal hashes identically
+		SE_CHECK(std::equal(sortKeys.begin(), sortKeys.end(), batchPtrs.begin(), batchPtrs.end(),
+			[](util::RadixSortKey const& sortKey, TestBatchHandle const* batch)
+			{
+				return sortKey.m_key == batch->m_batch->m_dataHash;
+			}));
+	}
+}
\ No newline at end of file
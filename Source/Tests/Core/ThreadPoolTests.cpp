@@ -0,0 +1,564 @@
+// © 2025 Adam Badke. All rights reserved.
+#include "TestHarness.h"
+
+#include "Core/ThreadPool.h"
+
+#include "Core/Util/WorkStealingDeque.h"
+
+
+namespace
+{
+	// Blocks until the counter reaches the expected value
+	void WaitForValue(std::atomic<uint32_t>& counter, uint32_t expectedValue)
+	{
+		uint32_t curValue = counter.load();
+		while (curValue != expectedValue)
+		{
+			counter.wait(curValue);
+			curValue = counter.load();
+		}
+	}
+
+
+	thread_local bool t_isWaitingForCounter = false;
+
+
+	// The previous ThreadPool: A single job queue guarded by a mutex and condition variable. Each job was wrapped in a
+	// std::packaged_task, and type-erased via a heap allocated wrapper. Benchmarked as the baseline for the
+	// work-stealing pool
+	class PreviousThreadPool final
+	{
+	public:
+		explicit PreviousThreadPool(size_t numWorkerThreads)
+		{
+			for (size_t i = 0; i < numWorkerThreads; ++i)
+			{
+				m_workerThreads.emplace_back(&PreviousThreadPool::ExecuteJobs, this);
+			}
+		}
+
+
+		~PreviousThreadPool()
+		{
+			{
+				std::unique_lock<std::mutex> waitingLock(m_jobQueueMutex);
+				m_isRunning = false;
+			}
+			m_jobQueueCV.notify_all();
+
+			for (std::thread& thread : m_workerThreads)
+			{
+				thread.join();
+			}
+		}
+
+
+		template<typename FunctionType>
+		std::future<std::invoke_result_t<FunctionType>> EnqueueJob(FunctionType job)
+		{
+			using ResultType = std::invoke_result_t<FunctionType>;
+
+			std::packaged_task<ResultType()> packagedTask(std::move(job));
+			std::future<ResultType> taskFuture(packagedTask.get_future());
+			{
+				std::unique_lock<std::mutex> waitingLock(m_jobQueueMutex);
+				m_jobQueue.push(std::make_unique<JobImpl<std::packaged_task<ResultType()>>>(std::move(packagedTask)));
+			}
+			m_jobQueueCV.notify_one();
+
+			return taskFuture;
+		}
+
+
+	private:
+		struct JobBase
+		{
+			virtual ~JobBase() = default;
+			virtual void Call() = 0;
+		};
+
+
+		template<typename Function>
+		struct JobImpl final : JobBase
+		{
+			explicit JobImpl(Function&& function) : m_function(std::move(function)) {}
+			void Call() override { m_function(); }
+
+			Function m_function;
+		};
+
+
+		void ExecuteJobs()
+		{
+			while (true)
+			{
+				std::unique_lock<std::mutex> waitingLock(m_jobQueueMutex);
+				m_jobQueueCV.wait(waitingLock, [this]() { return !m_jobQueue.empty() || !m_isRunning; });
+				if (!m_isRunning)
+				{
+					return;
+				}
+
+				std::unique_ptr<JobBase> currentJob = std::move(m_jobQueue.front());
+				m_jobQueue.pop();
+
+				waitingLock.unlock();
+
+				currentJob->Call();
+			}
+		}
+
+
+	private:
+		std::mutex m_jobQueueMutex;
+		std::condition_variable m_jobQueueCV;
+		std::queue<std::unique_ptr<JobBase>> m_jobQueue;
+		bool m_isRunning = true;
+
+		std::vector<std::thread> m_workerThreads;
+	};
+}
+
+
+SE_TEST(WorkStealingDeque_OwnerAndThievesTakeEveryItemOnce)
+{
+	constexpr uint32_t k_numItems = 200000;
+	constexpr uint32_t k_numThieves = 4;
+
+	util::WorkStealingDeque<uint32_t> deque(2); // Start tiny, to exercise the ring buffer growth under contention
+
+	std::vector<std::atomic<uint32_t>> numTimesTaken(k_numItems);
+	std::atomic<bool> ownerIsDone = false;
+
+	std::vector<std::thread> thieves;
+	for (uint32_t thiefIdx = 0; thiefIdx < k_numThieves; ++thiefIdx)
+	{
+		thieves.emplace_back([&]()
+			{
+				uint32_t item = 0;
+				while (!ownerIsDone.load() || !deque.IsEmpty())
+				{
+					if (deque.Steal(item))
+					{
+						numTimesTaken[item].fetch_add(1);
+					}
+				}
+			});
+	}
+
+	// The owner interleaves pushes with pops, like a worker that spawns and then executes its own jobs
+	uint32_t item = 0;
+	for (uint32_t itemIdx = 0; itemIdx < k_numItems; ++itemIdx)
+	{
+		deque.Push(itemIdx);
+		if (itemIdx % 3 == 0 && deque.Pop(item))
+		{
+			numTimesTaken[item].fetch_add(1);
+		}
+	}
+	while (deque.Pop(item))
+	{
+		numTimesTaken[item].fetch_add(1);
+	}
+	ownerIsDone.store(true);
+
+	for (std::thread& thief : thieves)
+	{
+		thief.join();
+	}
+
+	uint32_t numItemsNotTakenOnce = 0;
+	for (std::atomic<uint32_t> const& count : numTimesTaken)
+	{
+		numItemsNotTakenOnce += (count.load() != 1);
+	}
+	SE_CHECK(numItemsNotTakenOnce == 0);
+}
+
+
+SE_TEST(ThreadPool_ExecutesEveryJobFromConcurrentProducers)
+{
+	constexpr uint32_t k_numProducers = 4;
+	constexpr uint32_t k_numJobsPerProducer = 20000; // Exceeds the injection queue capacity, to exercise back pressure
+
+	std::vector<std::atomic<uint32_t>> numTimesExecuted(k_numProducers * k_numJobsPerProducer);
+
+	std::vector<std::thread> producers;
+	for (uint32_t producerIdx = 0; producerIdx < k_numProducers; ++producerIdx)
+	{
+		producers.emplace_back([&, producerIdx]()
+			{
+				std::vector<std::future<uint32_t>> futures;
+				futures.reserve(k_numJobsPerProducer);
+
+				for (uint32_t jobIdx = 0; jobIdx < k_numJobsPerProducer; ++jobIdx)
+				{
+					const uint32_t itemIdx = producerIdx * k_numJobsPerProducer + jobIdx;
+					futures.emplace_back(core::ThreadPool::EnqueueJob([&numTimesExecuted, itemIdx]()
+						{
+							numTimesExecuted[itemIdx].fetch_add(1);
+							return itemIdx;
+						}));
+				}
+
+				for (uint32_t jobIdx = 0; jobIdx < k_numJobsPerProducer; ++jobIdx)
+				{
+					SE_CHECK(futures[jobIdx].get() == producerIdx * k_numJobsPerProducer + jobIdx);
+				}
+			});
+	}
+	for (std::thread& producer : producers)
+	{
+		producer.join();
+	}
+
+	uint32_t numJobsNotExecutedOnce = 0;
+	for (std::atomic<uint32_t> const& count : numTimesExecuted)
+	{
+		numJobsNotExecutedOnce += (count.load() != 1);
+	}
+	SE_CHECK(numJobsNotExecutedOnce == 0);
+}
+
+
+SE_TEST(ThreadPool_ExecutesJobsSpawnedByWorkers)
+{
+	// Jobs enqueued from a worker thread are pushed to its own deque: Idle workers must steal them
+	constexpr uint32_t k_numParentJobs = 16;
+	constexpr uint32_t k_numChildJobsPerParent = 2000;
+
+	// Static: The final job may still be notifying waiters after we've observed the final count and returned
+	static std::atomic<uint32_t> s_numChildJobsExecuted;
+	s_numChildJobsExecuted.store(0);
+
+	for (uint32_t parentIdx = 0; parentIdx < k_numParentJobs; ++parentIdx)
+	{
+		core::ThreadPool::EnqueueJob([]()
+			{
+				for (uint32_t childIdx = 0; childIdx < k_numChildJobsPerParent; ++childIdx)
+				{
+					core::ThreadPool::EnqueueJob([]()
+						{
+							s_numChildJobsExecuted.fetch_add(1);
+							s_numChildJobsExecuted.notify_all();
+						});
+				}
+			});
+	}
+
+	WaitForValue(s_numChildJobsExecuted, k_numParentJobs * k_numChildJobsPerParent);
+	SE_CHECK(s_numChildJobsExecuted.load() == k_numParentJobs * k_numChildJobsPerParent);
+}
+
+
+SE_TEST(ThreadPool_ParallelForVisitsEveryIndexOnce)
+{
+	constexpr size_t k_numItems = 100003; // Not a multiple of the chunk size
+
+	std::vector<std::atomic<uint32_t>> numTimesVisited(k_numItems);
+
+	for (size_t grainSize : std::array<size_t, 6>{ 0, 1, 7, 4096, k_numItems, k_numItems * 2 })
+	{
+		for (std::atomic<uint32_t>& count : numTimesVisited)
+		{
+			count.store(0);
+		}
+
+		core::ThreadPool::ParallelFor(0, k_numItems,
+			[&numTimesVisited](size_t itemIdx)
+			{
+				numTimesVisited[itemIdx].fetch_add(1);
+			},
+			grainSize);
+
+		uint32_t numItemsNotVisitedOnce = 0;
+		for (std::atomic<uint32_t> const& count : numTimesVisited)
+		{
+			numItemsNotVisitedOnce += (count.load() != 1);
+		}
+		SE_CHECK(numItemsNotVisitedOnce == 0);
+	}
+}
+
+
+SE_TEST(ThreadPool_ContinuationsRunAfterTheirDependency)
+{
+	constexpr uint32_t k_numStages = 64;
+	constexpr uint32_t k_numJobsPerStage = 32;
+
+	// Each stage's jobs are continuations of the previous stage's counter, and check it has fully completed
+	std::atomic<uint32_t> numJobsExecuted = 0;
+	std::atomic<uint32_t> numOrderingViolations = 0;
+
+	// Holds the first stage open until every stage has been enqueued, so no counter reaches 0 prematurely. Static: The
+	// gate job may still be returning from wait() after we've released it
+	static std::atomic<bool> s_releaseFirstStage;
+	s_releaseFirstStage.store(false);
+
+	std::vector<std::unique_ptr<core::JobCounter>> stageCounters;
+	stageCounters.emplace_back(std::make_unique<core::JobCounter>());
+
+	core::ThreadPool::EnqueueJob([]()
+		{
+			s_releaseFirstStage.wait(false);
+		},
+		*stageCounters.back());
+
+	for (uint32_t stageIdx = 0; stageIdx < k_numStages; ++stageIdx)
+	{
+		if (stageIdx > 0)
+		{
+			stageCounters.emplace_back(std::make_unique<core::JobCounter>());
+		}
+
+		for (uint32_t jobIdx = 0; jobIdx < k_numJobsPerStage; ++jobIdx)
+		{
+			auto StageJob = [&numJobsExecuted, &numOrderingViolations, stageIdx]()
+				{
+					if (numJobsExecuted.load() < stageIdx * k_numJobsPerStage)
+					{
+						numOrderingViolations.fetch_add(1);
+					}
+					numJobsExecuted.fetch_add(1);
+				};
+
+			if (stageIdx == 0)
+			{
+				core::ThreadPool::EnqueueJob(StageJob, *stageCounters.back());
+			}
+			else
+			{
+				core::ThreadPool::EnqueueContinuation(
+					*stageCounters[stageIdx - 1], StageJob, stageCounters.back().get());
+			}
+		}
+	}
+
+	s_releaseFirstStage.store(true);
+	s_releaseFirstStage.notify_all();
+
+	for (auto& stageCounter : stageCounters)
+	{
+		core::ThreadPool::WaitForCounter(*stageCounter);
+	}
+
+	SE_CHECK(numJobsExecuted.load() == k_numStages * k_numJobsPerStage);
+	SE_CHECK(numOrderingViolations.load() == 0);
+}
+
+
+SE_TEST(ThreadPool_WaitingThreadsNeverExecuteFutureJobs)
+{
+	// Future jobs may be long-lived: A thread blocked in WaitForCounter must leave them for an idle worker, even when
+	// they're queued ahead of the work it's waiting on. Waits happen from the main thread and nested within workers
+	constexpr uint32_t k_numFutureJobs = 2048; // A multiple of k_numOuterJobs
+	constexpr uint32_t k_numOuterJobs = 64;
+	constexpr size_t k_numInnerItems = 256;
+
+	std::atomic<uint32_t> numFutureJobsExecutedWhileWaiting = 0;
+	std::atomic<uint64_t> innerItemSum = 0;
+
+	std::vector<std::future<void>> futures;
+	futures.reserve(k_numFutureJobs);
+
+	core::JobCounter outerCounter;
+	for (uint32_t iteration = 0; iteration < k_numFutureJobs; ++iteration)
+	{
+		futures.emplace_back(core::ThreadPool::EnqueueJob([&numFutureJobsExecutedWhileWaiting]()
+			{
+				if (t_isWaitingForCounter)
+				{
+					numFutureJobsExecutedWhileWaiting.fetch_add(1);
+				}
+			}));
+
+		if (iteration % (k_numFutureJobs / k_numOuterJobs) == 0)
+		{
+			core::ThreadPool::EnqueueJob([&innerItemSum]()
+				{
+					t_isWaitingForCounter = true;
+					core::ThreadPool::ParallelFor(0, k_numInnerItems,
+						[&innerItemSum](size_t itemIdx)
+						{
+							innerItemSum.fetch_add(itemIdx);
+						},
+						1);
+					t_isWaitingForCounter = false;
+				},
+				outerCounter);
+		}
+	}
+
+	t_isWaitingForCounter = true;
+	core::ThreadPool::WaitForCounter(outerCounter);
+	t_isWaitingForCounter = false;
+
+	for (std::future<void>& future : futures)
+	{
+		future.wait();
+	}
+
+	SE_CHECK(numFutureJobsExecutedWhileWaiting.load() == 0);
+	SE_CHECK(innerItemSum.load() == k_numOuterJobs * (k_numInnerItems * (k_numInnerItems - 1) / 2));
+}
+
+
+SE_BENCHMARK(ThreadPool_SmallJobThroughput)
+{
+	constexpr uint32_t k_numJobs = 100000;
+
+	static std::atomic<uint32_t> s_numJobsExecuted;
+	static std::atomic<uint32_t> s_numJobsExpected;
+
+	auto SmallJob = []()
+		{
+			if (s_numJobsExecuted.fetch_add(1) + 1 == s_numJobsExpected.load())
+			{
+				s_numJobsExecuted.notify_all();
+			}
+		};
+
+	// Each producer thread enqueues an equal share of the jobs, then we wait for all of them to be executed
+	auto MeasureProducers = [&SmallJob](std::string_view poolName, uint32_t numProducers, auto&& ProduceJobs)
+		{
+			const uint32_t numJobsPerProducer = k_numJobs / numProducers;
+
+			const double medianMs = tests::MeasureMedianMs(10, [&]()
+				{
+					s_numJobsExecuted.store(0);
+					s_numJobsExpected.store(numJobsPerProducer * numProducers);
+
+					std::vector<std::thread> producers;
+					for (uint32_t producerIdx = 0; producerIdx < numProducers; ++producerIdx)
+					{
+						producers.emplace_back([&ProduceJobs, &SmallJob, numJobsPerProducer]()
+							{
+								ProduceJobs(SmallJob, numJobsPerProducer);
+							});
+					}
+					for (std::thread& producer : producers)
+					{
+						producer.join();
+					}
+					WaitForValue(s_numJobsExecuted, numJobsPerProducer * numProducers);
+				});
+
+			tests::TestHarness::RecordTiming(
+				std::format("{}: {} producer thread(s)", poolName, numProducers),
+				medianMs,
+				numJobsPerProducer * numProducers);
+		};
+
+	// The engine's ThreadPool is started once with a fixed number of workers (and hosts the logger thread), so the
+	// sweep varies the number of threads enqueuing jobs. The previous pool is given the same number of workers
+	PreviousThreadPool previousPool(core::ThreadPool::GetNumWorkerThreads());
+
+	const uint32_t maxNumProducers = std::max(std::thread::hardware_concurrency(), 1u);
+	for (uint32_t numProducers = 1; numProducers <= maxNumProducers; numProducers *= 2)
+	{
+		MeasureProducers("Work-stealing pool, JobCounter", numProducers,
+			[](auto const& job, uint32_t numJobs)
+			{
+				core::JobCounter counter;
+				for (uint32_t jobIdx = 0; jobIdx < numJobs; ++jobIdx)
+				{
+					core::ThreadPool::EnqueueJob(job, counter);
+				}
+				core::ThreadPool::WaitForCounter(counter);
+			});
+
+		MeasureProducers("Work-stealing pool, std::future", numProducers,
+			[](auto const& job, uint32_t numJobs)
+			{
+				for (uint32_t jobIdx = 0; jobIdx < numJobs; ++jobIdx)
+				{
+					core::ThreadPool::EnqueueJob(job);
+				}
+			});
+
+		MeasureProducers("Previous mutex + condition variable pool reference", numProducers,
+			[&previousPool](auto const& job, uint32_t numJobs)
+			{
+				for (uint32_t jobIdx = 0; jobIdx < numJobs; ++jobIdx)
+				{
+					previousPool.EnqueueJob(job);
+				}
+			});
+	}
+}
+
+
+SE_BENCHMARK(ThreadPool_AllocationsPerJob)
+{
+	constexpr uint32_t k_numJobsPerBatch = 1000; // Well within the job slot pool and the injection queue
+	constexpr uint32_t k_numBatches = 100;
+	constexpr uint32_t k_numJobs = k_numJobsPerBatch * k_numBatches;
+
+	std::atomic<uint64_t> sum = 0;
+
+	// Counts the global allocations made while enqueueing and executing every job
+	auto CountAllocationsPerJob = [](char const* label, auto&& EnqueueAndExecuteBatch)
+		{
+			EnqueueAndExecuteBatch(); // Warm up any lazily allocated storage
+
+			const uint64_t numAllocationsBefore = tests::GetNumGlobalAllocations();
+
+			host::PerformanceTimer timer;
+			timer.Start();
+			for (uint32_t batchIdx = 0; batchIdx < k_numBatches; ++batchIdx)
+			{
+				EnqueueAndExecuteBatch();
+			}
+			const double ms = timer.StopMs();
+
+			const double allocationsPerJob =
+				static_cast<double>(tests::GetNumGlobalAllocations() - numAllocationsBefore) / k_numJobs;
+
+			tests::TestHarness::RecordTiming(
+				std::format("{}: {:.2f} allocations per job", label, allocationsPerJob), ms, k_numJobs);
+
+			return allocationsPerJob;
+		};
+
+	// Small jobs are stored inline, in pooled job slots
+	const double smallJobAllocations = CountAllocationsPerJob("JobCounter, small lambda", [&sum]()
+		{
+			core::JobCounter counter;
+			for (uint32_t jobIdx = 0; jobIdx < k_numJobsPerBatch; ++jobIdx)
+			{
+				core::ThreadPool::EnqueueJob([&sum, jobIdx]() { sum.fetch_add(jobIdx); }, counter);
+			}
+			core::ThreadPool::WaitForCounter(counter);
+		});
+	SE_CHECK(smallJobAllocations == 0.0);
+
+	// Captures larger than the inline storage fall back to the heap
+	CountAllocationsPerJob("JobCounter, 136B capture", [&sum]()
+		{
+			std::array<uint64_t, 16> payload{};
+			core::JobCounter counter;
+			for (uint32_t jobIdx = 0; jobIdx < k_numJobsPerBatch; ++jobIdx)
+			{
+				payload[0] = jobIdx;
+				core::ThreadPool::EnqueueJob([&sum, payload]() { sum.fetch_add(payload[0]); }, counter);
+			}
+			core::ThreadPool::WaitForCounter(counter);
+		});
+
+	// std::future jobs allocate their packaged_task's shared state
+	CountAllocationsPerJob("std::future, small lambda", [&sum]()
+		{
+			std::vector<std::future<void>> futures;
+			futures.reserve(k_numJobsPerBatch);
+			for (uint32_t jobIdx = 0; jobIdx < k_numJobsPerBatch; ++jobIdx)
+			{
+				futures.emplace_back(core::ThreadPool::EnqueueJob([&sum, jobIdx]() { sum.fetch_add(jobIdx); }));
+			}
+			for (std::future<void>& future : futures)
+			{
+				future.wait();
+			}
+		});
+
+	tests::DoNotOptimize(sum.load());
+}
\ No newline at end of file
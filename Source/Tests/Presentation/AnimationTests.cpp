@@ -0,0 +1,329 @@
+// © 2025 Adam Badke. All rights reserved.
+#include "TestHarness.h"
+
+#include "Presentation/AnimationComponent.h"
+
+
+namespace
+{
+	constexpr size_t k_animIdx = 0;
+
+
+	// Adds a channel to the 1st animation of the controller, with keyframe times in [0, clipDurationSec]. Quantized
+	// keyframe times include duplicates, as GLTF files may contain
+	pr::AnimationData::Channel AddRandomChannel(
+		pr::AnimationController& animController,
+		pr::AnimationPath targetPath,
+		pr::InterpolationMode interpolationMode,
+		uint32_t numKeyframes,
+		float clipDurationSec,
+		bool quantizeKeyframeTimes,
+		std::mt19937& generator)
+	{
+		std::uniform_real_distribution<float> timeDist(0.f, clipDurationSec);
+		std::uniform_real_distribution<float> valueDist(-1.f, 1.f);
+
+		std::vector<float> keyframeTimes(numKeyframes);
+		for (uint32_t keyframeIdx = 0; keyframeIdx < numKeyframes; ++keyframeIdx)
+		{
+			keyframeTimes[keyframeIdx] = quantizeKeyframeTimes ?
+				std::round(timeDist(generator) * 10.f) / 10.f :
+				clipDurationSec * keyframeIdx / std::max(numKeyframes - 1, 1u); // Evenly spaced, as baked clips are
+		}
+		std::sort(keyframeTimes.begin(), keyframeTimes.end());
+
+		const uint8_t floatsPerKeyframe = targetPath == pr::AnimationPath::Rotation ? 4 : 3;
+
+		std::vector<float> channelData;
+		channelData.reserve(numKeyframes * floatsPerKeyframe);
+		for (uint32_t keyframeIdx = 0; keyframeIdx < numKeyframes; ++keyframeIdx)
+		{
+			if (targetPath == pr::AnimationPath::Rotation)
+			{
+				const glm::quat rotation = glm::normalize(glm::quat(
+					valueDist(generator), valueDist(generator), valueDist(generator), valueDist(generator)));
+
+				channelData.insert(channelData.end(), { rotation.x, rotation.y, rotation.z, rotation.w });
+			}
+			else
+			{
+				channelData.insert(
+					channelData.end(), { valueDist(generator), valueDist(generator), valueDist(generator) });
+			}
+		}
+
+		pr::AnimationData::Channel channel{
+			.m_interpolationMode = interpolationMode,
+			.m_targetPath = targetPath,
+			.m_dataFloatsPerKeyframe = floatsPerKeyframe, };
+
+		channel.m_keyframeTimesIdx = animController.AddChannelKeyframeTimes(k_animIdx, std::move(keyframeTimes));
+		channel.m_dataIdx = animController.AddChannelData(std::move(channelData));
+		channel.m_samplerIdx = animController.AddChannelSampler(k_animIdx, channel);
+
+		return channel;
+	}
+
+
+	// The keyframe segment about the current time: The 1st keyframe time > currentTimeSec and its predecessor, clamped
+	// to the first/last keyframes
+	void GetBinarySearchKeyframeSegment(
+		std::vector<float> const& keyframeTimes, float currentTimeSec, size_t& prevIdxOut, size_t& nextIdxOut)
+	{
+		const size_t upperBoundIdx = std::distance(
+			keyframeTimes.begin(), std::upper_bound(keyframeTimes.begin(), keyframeTimes.end(), currentTimeSec));
+
+		prevIdxOut = upperBoundIdx == 0 ? 0 : upperBoundIdx - 1;
+		nextIdxOut = upperBoundIdx == keyframeTimes.size() ? keyframeTimes.size() - 1 : upperBoundIdx;
+	}
+
+
+	// The keyframe lookup before the AnimationController cached a cursor per channel: A scan of every keyframe time for
+	// the closest keyframe, and the min/max keyframe times. Benchmarked as the baseline for the cursors
+	void GetLinearScanKeyframeSegment(
+		std::vector<float> const& keyframeTimes, float currentTimeSec, size_t& prevIdxOut, size_t& nextIdxOut)
+	{
+		float minAbsDelta = std::numeric_limits<float>::max();
+		size_t minAbsDeltaIdx = 0;
+		float minKeyframeTimeSec = std::numeric_limits<float>::max();
+		size_t minKeyframeTimeIdx = 0;
+		float maxKeyframeTimeSec = std::numeric_limits<float>::min();
+		size_t maxKeyframeTimeIdx = 0;
+		for (size_t i = 0; i < keyframeTimes.size(); ++i)
+		{
+			const float curAbsDelta = glm::abs(currentTimeSec - keyframeTimes[i]);
+			if (curAbsDelta < minAbsDelta)
+			{
+				minAbsDelta = curAbsDelta;
+				minAbsDeltaIdx = i;
+			}
+			if (keyframeTimes[i] < minKeyframeTimeSec)
+			{
+				minKeyframeTimeSec = keyframeTimes[i];
+				minKeyframeTimeIdx = i;
+			}
+			if (keyframeTimes[i] > maxKeyframeTimeSec)
+			{
+				maxKeyframeTimeSec = keyframeTimes[i];
+				maxKeyframeTimeIdx = i;
+			}
+		}
+
+		if (currentTimeSec < minKeyframeTimeSec)
+		{
+			prevIdxOut = nextIdxOut = minKeyframeTimeIdx;
+		}
+		else if (currentTimeSec > maxKeyframeTimeSec)
+		{
+			prevIdxOut = nextIdxOut = maxKeyframeTimeIdx;
+		}
+		else if (keyframeTimes[minAbsDeltaIdx] < currentTimeSec)
+		{
+			prevIdxOut = minAbsDeltaIdx;
+			nextIdxOut = (prevIdxOut + 1) % keyframeTimes.size();
+		}
+		else
+		{
+			nextIdxOut = minAbsDeltaIdx;
+			prevIdxOut = nextIdxOut == 0 ? keyframeTimes.size() - 1 : nextIdxOut - 1;
+		}
+	}
+
+
+	glm::vec4 SampleChannel(
+		pr::AnimationController const& animController,
+		pr::AnimationData::Channel const& channel,
+		size_t prevKeyframeIdx,
+		size_t nextKeyframeIdx,
+		float currentTimeSec)
+	{
+		std::vector<float> const& keyframeTimes = animController.GetKeyframeTimes(channel.m_keyframeTimesIdx);
+		std::vector<float> const& channelData = animController.GetChannelData(channel.m_dataIdx);
+
+		if (channel.m_targetPath == pr::AnimationPath::Rotation)
+		{
+			const glm::quat rotation = glm::normalize(pr::GetSphericalLinearInterpolatedValue(
+				channel.m_interpolationMode,
+				channelData.data(),
+				channelData.size(),
+				prevKeyframeIdx,
+				nextKeyframeIdx,
+				keyframeTimes[prevKeyframeIdx],
+				keyframeTimes[nextKeyframeIdx],
+				currentTimeSec));
+
+			return glm::vec4(rotation.x, rotation.y, rotation.z, rotation.w);
+		}
+		return glm::vec4(pr::GetInterpolatedValue<glm::vec3>(
+			channel.m_interpolationMode,
+			channelData.data(),
+			channelData.size(),
+			prevKeyframeIdx,
+			nextKeyframeIdx,
+			keyframeTimes[prevKeyframeIdx],
+			keyframeTimes[nextKeyframeIdx],
+			currentTimeSec),
+			0.f);
+	}
+}
+
+
+SE_TEST(Animation_KeyframeCursorsMatchBinarySearch)
+{
+	constexpr float k_clipDurationSec = 4.f;
+
+	std::mt19937 generator(24680);
+
+	std::unique_ptr<pr::AnimationController> animController =
+		pr::AnimationController::CreateAnimationControllerObject();
+	animController->AddNewAnimation("Test animation");
+
+	std::vector<pr::AnimationData::Channel> channels;
+	for (uint32_t numKeyframes = 1; numKeyframes <= 64; numKeyframes += 3) // Includes single keyframe channels
+	{
+		channels.emplace_back(AddRandomChannel(*animController, pr::AnimationPath::Translation,
+			pr::InterpolationMode::Linear, numKeyframes, k_clipDurationSec, true, generator));
+		channels.emplace_back(AddRandomChannel(*animController, pr::AnimationPath::Rotation,
+			pr::InterpolationMode::SphericalLinearInterpolation, numKeyframes, k_clipDurationSec, true, generator));
+		channels.emplace_back(AddRandomChannel(*animController, pr::AnimationPath::Scale,
+			pr::InterpolationMode::Step, numKeyframes, k_clipDurationSec, true, generator));
+	}
+
+	// Mostly small forward steps (the common case), with occasional jumps over many keyframes. Playback loops, and
+	// periodically reverses
+	std::uniform_real_distribution<double> smallStepMsDist(0.0, 40.0);
+	std::uniform_real_distribution<double> largeStepMsDist(0.0, 3000.0);
+
+	uint32_t numMismatchedSegments = 0;
+	uint32_t numMismatchedValues = 0;
+	for (uint32_t updateIdx = 0; updateIdx < 2000; ++updateIdx)
+	{
+		if (updateIdx % 500 == 250)
+		{
+			animController->SetAnimationSpeed(-animController->GetAnimationSpeed());
+		}
+
+		const double stepMs = updateIdx % 50 == 0 ? largeStepMsDist(generator) : smallStepMsDist(generator);
+		pr::AnimationController::UpdateAnimationController(*animController, stepMs);
+
+		const float currentTimeSec = animController->GetActiveClampedAnimationTimeSec();
+
+		for (pr::AnimationData::Channel const& channel : channels)
+		{
+			size_t prevIdx = 0;
+			size_t nextIdx = 0;
+			animController->GetKeyframeSegment(channel.m_keyframeTimesIdx, prevIdx, nextIdx);
+
+			size_t expectedPrevIdx = 0;
+			size_t expectedNextIdx = 0;
+			GetBinarySearchKeyframeSegment(
+				animController->GetKeyframeTimes(channel.m_keyframeTimesIdx),
+				currentTimeSec,
+				expectedPrevIdx,
+				expectedNextIdx);
+
+			numMismatchedSegments += prevIdx != expectedPrevIdx || nextIdx != expectedNextIdx;
+
+			const glm::vec4 expectedValue =
+				SampleChannel(*animController, channel, expectedPrevIdx, expectedNextIdx, currentTimeSec);
+
+			glm::vec4 sampledValue = glm::vec4(0.f);
+			if (channel.m_targetPath == pr::AnimationPath::Rotation)
+			{
+				const glm::quat sampledRotation = animController->GetSampledRotation(channel.m_samplerIdx);
+				sampledValue = glm::vec4(sampledRotation.x, sampledRotation.y, sampledRotation.z, sampledRotation.w);
+			}
+			else
+			{
+				sampledValue = glm::vec4(animController->GetSampledVec3(channel.m_samplerIdx), 0.f);
+			}
+
+			numMismatchedValues += glm::length(sampledValue - expectedValue) > 1e-5f;
+		}
+	}
+	SE_CHECK(numMismatchedSegments == 0);
+	SE_CHECK(numMismatchedValues == 0);
+}
+
+
+SE_BENCHMARK(Animation_Sample500Skeletons)
+{
+	constexpr uint32_t k_numSkeletons = 500;
+	constexpr uint32_t k_numJoints = 60;
+	constexpr uint32_t k_numKeyframes = 120;
+	constexpr float k_clipDurationSec = 4.f; // Baked at 30 fps
+	constexpr double k_stepTimeMs = 1000.0 / 60.0;
+
+	std::mt19937 generator(13579);
+	std::uniform_real_distribution<double> startTimeMsDist(0.0, k_clipDurationSec * 1000.0);
+
+	// Every skeleton has a translation, rotation, and scale channel per joint, as loaded from GLTF
+	std::vector<std::unique_ptr<pr::AnimationController>> skeletons;
+	std::vector<pr::AnimationData::Channel> channels; // Identical for every skeleton
+	for (uint32_t skeletonIdx = 0; skeletonIdx < k_numSkeletons; ++skeletonIdx)
+	{
+		pr::AnimationController& animController =
+			*skeletons.emplace_back(pr::AnimationController::CreateAnimationControllerObject());
+		animController.AddNewAnimation("Benchmark animation");
+
+		for (uint32_t jointIdx = 0; jointIdx < k_numJoints; ++jointIdx)
+		{
+			for (pr::AnimationPath targetPath :
+				{ pr::AnimationPath::Translation, pr::AnimationPath::Rotation, pr::AnimationPath::Scale })
+			{
+				const pr::InterpolationMode interpolationMode = targetPath == pr::AnimationPath::Rotation ?
+					pr::InterpolationMode::SphericalLinearInterpolation : pr::InterpolationMode::Linear;
+
+				const pr::AnimationData::Channel channel = AddRandomChannel(
+					animController, targetPath, interpolationMode, k_numKeyframes, k_clipDurationSec, false, generator);
+				if (skeletonIdx == 0)
+				{
+					channels.emplace_back(channel);
+				}
+			}
+		}
+
+		// Skeletons are not in lockstep
+		pr::AnimationController::UpdateAnimationController(animController, startTimeMsDist(generator));
+	}
+	const uint64_t numSampledChannels = k_numSkeletons * channels.size();
+
+	const double cursorsMs = tests::MeasureMedianMs(60, [&skeletons]()
+		{
+			for (std::unique_ptr<pr::AnimationController> const& animController : skeletons)
+			{
+				pr::AnimationController::UpdateAnimationController(*animController, k_stepTimeMs);
+			}
+		});
+	tests::TestHarness::RecordTiming(
+		"Cached keyframe cursors: 500 skeletons", cursorsMs, numSampledChannels);
+
+	// The previous sampling: Each channel scanned its keyframe times, and was interpolated when applied to its node
+	std::vector<glm::vec4> sampledValues(channels.size());
+	const double linearScanMs = tests::MeasureMedianMs(60, [&skeletons, &channels, &sampledValues]()
+		{
+			for (std::unique_ptr<pr::AnimationController> const& animController : skeletons)
+			{
+				animController->UpdateCurrentAnimationTime(k_stepTimeMs);
+
+				const float currentTimeSec = animController->GetActiveClampedAnimationTimeSec();
+
+				for (size_t channelIdx = 0; channelIdx < channels.size(); ++channelIdx)
+				{
+					size_t prevIdx = 0;
+					size_t nextIdx = 0;
+					GetLinearScanKeyframeSegment(
+						animController->GetKeyframeTimes(channels[channelIdx].m_keyframeTimesIdx),
+						currentTimeSec,
+						prevIdx,
+						nextIdx);
+
+					sampledValues[channelIdx] =
+						SampleChannel(*animController, channels[channelIdx], prevIdx, nextIdx, currentTimeSec);
+				}
+				tests::DoNotOptimize(sampledValues.back());
+			}
+		});
+	tests::TestHarness::RecordTiming(
+		"Previous linear scan reference: 500 skeletons", linearScanMs, numSampledChannels);
+}
\ No newline at end of file
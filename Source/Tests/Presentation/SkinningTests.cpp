@@ -0,0 +1,228 @@
+// © 2025 Adam Badke. All rights reserved.
+#include "TestHarness.h"
+
+#include "Presentation/SkinningComponent.h"
+#include "Presentation/Transform.h"
+
+#include "Core/ThreadPool.h"
+
+
+namespace
+{
+	struct TestSkeleton
+	{
+		std::unique_ptr<pr::Transform> m_parentOfRoot;
+		std::vector<std::unique_ptr<pr::Transform>> m_joints;
+		std::vector<glm::mat4> m_inverseBindMatrices;
+	};
+
+
+	void SetRandomLocalTRS(pr::Transform& transform, std::mt19937& generator)
+	{
+		std::uniform_real_distribution<float> unitDist(-1.f, 1.f);
+		std::uniform_real_distribution<float> scaleDist(0.5f, 1.5f);
+
+		// Braced initialization: The distributions are sampled in order
+		transform.SetLocalTranslation(
+			2.f * glm::vec3{ unitDist(generator), unitDist(generator), unitDist(generator) });
+		transform.SetLocalRotation(glm::normalize(
+			glm::quat{ unitDist(generator), unitDist(generator), unitDist(generator), unitDist(generator) }));
+
+		// Non-uniform scale: The transpose inverse of the joint matrices differs from the joint matrices themselves
+		transform.SetLocalScale(glm::vec3{ scaleDist(generator), scaleDist(generator), scaleDist(generator) });
+
+		transform.Recompute();
+	}
+
+
+	// Each joint is parented to a random earlier joint, so parents are recomputed before their children. The root
+	// joint is parented to a Transform outside of the skeleton, which the skinning matrices cancel out
+	TestSkeleton BuildSkeleton(size_t numJoints, std::mt19937& generator)
+	{
+		TestSkeleton skeleton;
+		skeleton.m_parentOfRoot = std::make_unique<pr::Transform>(nullptr);
+		SetRandomLocalTRS(*skeleton.m_parentOfRoot, generator);
+
+		for (size_t jointIdx = 0; jointIdx < numJoints; ++jointIdx)
+		{
+			pr::Transform* parent = jointIdx == 0 ?
+				skeleton.m_parentOfRoot.get() : skeleton.m_joints[generator() % jointIdx].get();
+
+			SetRandomLocalTRS(*skeleton.m_joints.emplace_back(std::make_unique<pr::Transform>(parent)), generator);
+
+			// Inverse bind matrices are the inverse of each joint's global matrix in its bind pose
+			pr::Transform bindPose(nullptr);
+			SetRandomLocalTRS(bindPose, generator);
+			skeleton.m_inverseBindMatrices.emplace_back(glm::inverse(bindPose.GetGlobalMatrix()));
+		}
+		return skeleton;
+	}
+
+
+	std::vector<pr::Transform const*> GetJointTransforms(TestSkeleton const& skeleton)
+	{
+		std::vector<pr::Transform const*> jointTransforms;
+		for (std::unique_ptr<pr::Transform> const& joint : skeleton.m_joints)
+		{
+			jointTransforms.emplace_back(joint.get());
+		}
+		return jointTransforms;
+	}
+
+
+	// The joint matrices are scaled through the hierarchy: The tolerance is relative to their largest element
+	bool IsNearlyEqual(glm::mat4 const& result, glm::mat4 const& expected)
+	{
+		float maxElement = 1.f;
+		float maxError = 0.f;
+		for (glm::length_t col = 0; col < 4; ++col)
+		{
+			for (glm::length_t row = 0; row < 4; ++row)
+			{
+				maxElement = std::max(maxElement, std::abs(expected[col][row]));
+				maxError = std::max(maxError, std::abs(result[col][row] - expected[col][row]));
+			}
+		}
+		return maxError <= 0.0001f * maxElement;
+	}
+
+
+	// Compares the matrix palette against the previous glm implementation: (parentOfRoot^-1 * joint * inverseBind),
+	// and its transpose(inverse())
+	uint32_t CountMismatchedJoints(
+		pr::SkinningComponent const& skinningCmpt,
+		std::vector<pr::Transform const*> const& jointTransforms,
+		TestSkeleton const& skeleton)
+	{
+		const glm::mat4 invParentOfRoot = glm::inverse(skeleton.m_parentOfRoot->GetGlobalMatrix());
+
+		uint32_t numMismatchedJoints = 0;
+		for (size_t jointIdx = 0; jointIdx < jointTransforms.size(); ++jointIdx)
+		{
+			glm::mat4 expectedJointMatrix(1.f); // Joints without a Transform are the identity
+			glm::mat4 expectedTransposeInv(1.f);
+			if (jointTransforms[jointIdx])
+			{
+				expectedJointMatrix = invParentOfRoot *
+					jointTransforms[jointIdx]->GetGlobalMatrix() *
+					skeleton.m_inverseBindMatrices[jointIdx];
+
+				expectedTransposeInv = glm::transpose(glm::inverse(expectedJointMatrix));
+			}
+
+			numMismatchedJoints +=
+				!IsNearlyEqual(skinningCmpt.GetJointTransforms()[jointIdx], expectedJointMatrix) ||
+				!IsNearlyEqual(skinningCmpt.GetTransposeInvJointTransforms()[jointIdx], expectedTransposeInv);
+		}
+		return numMismatchedJoints;
+	}
+}
+
+
+SE_TEST(Skinning_AffineMathMatchesGLMInverse)
+{
+	std::mt19937 generator(24680);
+
+	// Skeletons larger than a job's worth of joints are split across the ThreadPool
+	for (size_t numJoints : { 1u, 60u, 300u })
+	{
+		TestSkeleton skeleton = BuildSkeleton(numJoints, generator);
+
+		std::vector<pr::Transform const*> jointTransforms = GetJointTransforms(skeleton);
+		if (numJoints > 1)
+		{
+			jointTransforms[numJoints / 2] = nullptr;
+		}
+
+		pr::SkinningComponent skinningCmpt = pr::SkinningComponent::CreateDetachedSkinningComponent(
+			std::vector<pr::Transform const*>(jointTransforms),
+			std::vector<glm::mat4>(skeleton.m_inverseBindMatrices),
+			skeleton.m_parentOfRoot.get());
+
+		SE_CHECK(pr::SkinningComponent::UpdateSkinMatrices(skinningCmpt));
+		SE_CHECK(CountMismatchedJoints(skinningCmpt, jointTransforms, skeleton) == 0);
+
+		// Unchanged joints are not rebuilt
+		skeleton.m_parentOfRoot->ClearHasChangedFlag();
+		for (std::unique_ptr<pr::Transform>& joint : skeleton.m_joints)
+		{
+			joint->ClearHasChangedFlag();
+		}
+		SE_CHECK(!pr::SkinningComponent::UpdateSkinMatrices(skinningCmpt));
+
+		// The last joint has no children: Moving it rebuilds it alone, and the palette must still match
+		SetRandomLocalTRS(*skeleton.m_joints.back(), generator);
+		SE_CHECK(pr::SkinningComponent::UpdateSkinMatrices(skinningCmpt));
+		SE_CHECK(CountMismatchedJoints(skinningCmpt, jointTransforms, skeleton) == 0);
+	}
+}
+
+
+SE_BENCHMARK(Skinning_Update1000Characters)
+{
+	constexpr size_t k_numCharacters = 1000;
+	constexpr size_t k_numJoints = 60;
+
+	std::mt19937 generator(13579);
+
+	// Joint Transforms are never cleared, so every joint of every character is rebuilt each iteration
+	std::vector<TestSkeleton> skeletons;
+	std::vector<pr::SkinningComponent> skins;
+	skeletons.reserve(k_numCharacters);
+	skins.reserve(k_numCharacters);
+	for (size_t characterIdx = 0; characterIdx < k_numCharacters; ++characterIdx)
+	{
+		TestSkeleton const& skeleton = skeletons.emplace_back(BuildSkeleton(k_numJoints, generator));
+
+		skins.emplace_back(pr::SkinningComponent::CreateDetachedSkinningComponent(
+			GetJointTransforms(skeleton),
+			std::vector<glm::mat4>(skeleton.m_inverseBindMatrices),
+			skeleton.m_parentOfRoot.get()));
+	}
+	const uint64_t numJoints = k_numCharacters * k_numJoints;
+
+	const double serialMs = tests::MeasureMedianMs(20, [&skins]()
+		{
+			for (pr::SkinningComponent& skinningCmpt : skins)
+			{
+				tests::DoNotOptimize(pr::SkinningComponent::UpdateSkinMatrices(skinningCmpt));
+			}
+		});
+	tests::TestHarness::RecordTiming("SSE affine palettes: 1000 characters, 1 thread", serialMs, numJoints);
+
+	// As EntityManager::UpdateSkinAnimations does: Each character is updated in parallel
+	const double parallelMs = tests::MeasureMedianMs(20, [&skins]()
+		{
+			core::ThreadPool::ParallelFor(0, skins.size(), [&skins](size_t characterIdx)
+				{
+					tests::DoNotOptimize(pr::SkinningComponent::UpdateSkinMatrices(skins[characterIdx]));
+				});
+		});
+	tests::TestHarness::RecordTiming("SSE affine palettes: 1000 characters, ParallelFor", parallelMs, numJoints);
+
+	// The previous palette build, without its per-joint registry lookups: The parent of the root was inverted for
+	// every joint, and the transpose inverse used a general 4x4 inverse
+	std::vector<glm::mat4> jointMatrices(k_numJoints);
+	std::vector<glm::mat4> transposeInvJointMatrices(k_numJoints);
+	const double referenceMs = tests::MeasureMedianMs(20, [&]()
+		{
+			for (TestSkeleton const& skeleton : skeletons)
+			{
+				for (size_t jointIdx = 0; jointIdx < k_numJoints; ++jointIdx)
+				{
+					pr::Transform const& jointTransform = *skeleton.m_joints[jointIdx];
+					if (jointTransform.HasChanged())
+					{
+						jointMatrices[jointIdx] = glm::inverse(skeleton.m_parentOfRoot->GetGlobalMatrix()) *
+							jointTransform.GetGlobalMatrix();
+
+						jointMatrices[jointIdx] = jointMatrices[jointIdx] * skeleton.m_inverseBindMatrices[jointIdx];
+
+						transposeInvJointMatrices[jointIdx] = glm::transpose(glm::inverse(jointMatrices[jointIdx]));
+					}
+				}
+				tests::DoNotOptimize(transposeInvJointMatrices.back()[3]);
+			}
+		});
+	tests::TestHarness::RecordTiming("Previous glm reference: 1000 characters, 1 thread", referenceMs, numJoints);
+}
\ No newline at end of file
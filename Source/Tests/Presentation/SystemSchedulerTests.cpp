@@ -0,0 +1,211 @@
+// © 2025 Adam Badke. All rights reserved.
+#include "TestHarness.h"
+
+#include "Presentation/SystemScheduler.h"
+
+
+namespace
+{
+	// Component types: Only their identity matters to the scheduler
+	struct ComponentA {};
+	struct ComponentB {};
+	struct ComponentC {};
+	struct ComponentD {};
+
+
+	// Records when each system begins and ends, relative to every other system's begin/end
+	struct SystemExecutionLog
+	{
+		std::atomic<uint32_t> m_nextEventIdx = 0;
+		std::vector<uint32_t> m_beginEventIdx;
+		std::vector<uint32_t> m_endEventIdx;
+		std::vector<uint32_t> m_numExecutions;
+
+		explicit SystemExecutionLog(size_t numSystems)
+			: m_beginEventIdx(numSystems, 0)
+			, m_endEventIdx(numSystems, 0)
+			, m_numExecutions(numSystems, 0)
+		{
+		}
+
+		void Reset()
+		{
+			m_nextEventIdx = 0;
+			std::fill(m_numExecutions.begin(), m_numExecutions.end(), 0);
+		}
+	};
+
+
+	pr::SystemScheduler::SystemFunction CreateLoggedSystem(SystemExecutionLog& executionLog, size_t systemIdx)
+	{
+		return [&executionLog, systemIdx](double)
+			{
+				executionLog.m_beginEventIdx[systemIdx] = executionLog.m_nextEventIdx.fetch_add(1);
+
+				// Earlier systems take longer, so a later system that was not held back would start before they end. We
+				// sleep rather than spin, so other threads can execute systems in the meantime even on a single core
+				const size_t numSystems = executionLog.m_numExecutions.size();
+				std::this_thread::sleep_for(std::chrono::microseconds((numSystems - systemIdx) * 100));
+
+				executionLog.m_numExecutions[systemIdx]++;
+				executionLog.m_endEventIdx[systemIdx] = executionLog.m_nextEventIdx.fetch_add(1);
+			};
+	}
+
+
+	// Executes the systems as EntityManager::Update does: With the registry lock held by the calling thread
+	void ExecuteSystems(
+		pr::SystemScheduler& scheduler, entt::basic_registry<entt::entity>& registry, pr::RegistryMutex& registryMutex)
+	{
+		std::unique_lock<pr::RegistryMutex> registryLock(registryMutex);
+		scheduler.Execute(registry, registryMutex, 16.0);
+	}
+}
+
+
+SE_TEST(SystemScheduler_ConflictingSystemsRunInRegistrationOrder)
+{
+	pr::SystemScheduler scheduler;
+	entt::basic_registry<entt::entity> registry;
+	pr::RegistryMutex registryMutex;
+
+	constexpr size_t k_numSystems = 7;
+	SystemExecutionLog executionLog(k_numSystems);
+
+	scheduler.AddSystem("0: Write A", CreateLoggedSystem(executionLog, 0)).Writes<ComponentA>();
+	scheduler.AddSystem("1: Read A, write B", CreateLoggedSystem(executionLog, 1))
+		.Reads<ComponentA>()
+		.Writes<ComponentB>();
+	scheduler.AddSystem("2: Write C", CreateLoggedSystem(executionLog, 2)).Writes<ComponentC>();
+	scheduler.AddSystem("3: Read A", CreateLoggedSystem(executionLog, 3)).Reads<ComponentA>();
+	scheduler.AddSystem("4: Write A, D", CreateLoggedSystem(executionLog, 4)).Writes<ComponentA, ComponentD>();
+	scheduler.AddSystem("5: Read B, C", CreateLoggedSystem(executionLog, 5)).Reads<ComponentB, ComponentC>();
+	scheduler.AddSystem("6: Read D", CreateLoggedSystem(executionLog, 6)).Reads<ComponentD>();
+
+	// (earlier, later) pairs where either system writes a type the other accesses
+	constexpr std::pair<size_t, size_t> k_conflicts[] = {
+		{ 0, 1 }, { 0, 3 }, { 0, 4 }, { 1, 4 }, { 3, 4 }, { 1, 5 }, { 2, 5 }, { 4, 6 },
+	};
+
+	for (uint32_t frameIdx = 0; frameIdx < 200; ++frameIdx)
+	{
+		executionLog.Reset();
+		ExecuteSystems(scheduler, registry, registryMutex);
+
+		SE_CHECK(std::ranges::all_of(executionLog.m_numExecutions, [](uint32_t count) { return count == 1; }));
+
+		for (auto const& [earlierIdx, laterIdx] : k_conflicts)
+		{
+			SE_CHECK(executionLog.m_endEventIdx[earlierIdx] < executionLog.m_beginEventIdx[laterIdx]);
+		}
+	}
+
+	// Systems added later join the existing order
+	scheduler.AddSystem("7: Write B", [&executionLog](double)
+		{
+			SE_CHECK(executionLog.m_numExecutions[1] == 1 && executionLog.m_numExecutions[5] == 1);
+		}).Writes<ComponentB>();
+
+	executionLog.Reset();
+	ExecuteSystems(scheduler, registry, registryMutex);
+}
+
+
+SE_TEST(SystemScheduler_NonConflictingSystemsOverlap)
+{
+	pr::SystemScheduler scheduler;
+	entt::basic_registry<entt::entity> registry;
+	pr::RegistryMutex registryMutex;
+
+	std::atomic<uint32_t> numRunning = 0;
+	std::atomic<uint32_t> maxNumRunning = 0;
+
+	// Each system waits (for a bounded time) until another is running alongside it. Execute's calling thread executes
+	// systems while it waits, so at least two threads run systems even with a single worker thread
+	auto OverlappingSystem = [&numRunning, &maxNumRunning](double)
+		{
+			const uint32_t numNowRunning = numRunning.fetch_add(1) + 1;
+
+			uint32_t prevMax = maxNumRunning.load();
+			while (numNowRunning > prevMax && !maxNumRunning.compare_exchange_weak(prevMax, numNowRunning))
+			{
+			}
+
+			const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+			while (maxNumRunning.load() < 2 && std::chrono::steady_clock::now() < timeout)
+			{
+				std::this_thread::yield();
+			}
+
+			numRunning.fetch_sub(1);
+		};
+
+	// Disjoint writes, and shared reads, do not conflict
+	scheduler.AddSystem("Write A", OverlappingSystem).Writes<ComponentA>();
+	scheduler.AddSystem("Write B", OverlappingSystem).Writes<ComponentB>();
+	scheduler.AddSystem("Read C", OverlappingSystem).Reads<ComponentC>();
+	scheduler.AddSystem("Read C, D", OverlappingSystem).Reads<ComponentC, ComponentD>();
+
+	for (uint32_t frameIdx = 0; frameIdx < 5; ++frameIdx)
+	{
+		maxNumRunning = 0;
+		ExecuteSystems(scheduler, registry, registryMutex);
+
+		SE_CHECK(maxNumRunning.load() >= 2);
+		SE_CHECK(numRunning.load() == 0);
+	}
+}
+
+
+SE_TEST(SystemScheduler_NestedParallelForInsideSystem)
+{
+	pr::SystemScheduler scheduler;
+	entt::basic_registry<entt::entity> registry;
+	pr::RegistryMutex registryMutex;
+
+	constexpr size_t k_numItems = 10000;
+	std::vector<std::atomic<uint32_t>> numVisits(k_numItems);
+	std::atomic<uint32_t> numOtherSystemExecutions = 0;
+
+	scheduler.AddSystem("ParallelFor", [&registryMutex, &numVisits](double)
+		{
+			// The system's registry access is delegated to its own thread...
+			{
+				std::unique_lock<pr::RegistryMutex> registryLock(registryMutex);
+			}
+
+			// ...and to every chunk of a nested ParallelFor: Locking the registry must not wait on the calling thread
+			pr::SystemScheduler::ParallelFor(registryMutex, k_numItems, [&registryMutex, &numVisits](size_t itemIdx)
+				{
+					std::unique_lock<pr::RegistryMutex> registryLock(registryMutex);
+					numVisits[itemIdx].fetch_add(1);
+				});
+		}).Writes<ComponentA>();
+
+	scheduler.AddSystem("Write B", [&registryMutex, &numOtherSystemExecutions](double)
+		{
+			std::unique_lock<pr::RegistryMutex> registryLock(registryMutex);
+			numOtherSystemExecutions.fetch_add(1);
+		}).Writes<ComponentB>();
+
+	constexpr uint32_t k_numFrames = 20;
+	for (uint32_t frameIdx = 0; frameIdx < k_numFrames; ++frameIdx)
+	{
+		ExecuteSystems(scheduler, registry, registryMutex);
+	}
+
+	SE_CHECK(std::ranges::all_of(numVisits, [](std::atomic<uint32_t> const& count) { return count == k_numFrames; }));
+	SE_CHECK(numOtherSystemExecutions.load() == k_numFrames);
+
+	// The delegation ends with the update: Another thread can acquire the registry lock
+	bool otherThreadAcquiredLock = false;
+	std::thread([&registryMutex, &otherThreadAcquiredLock]()
+		{
+			otherThreadAcquiredLock = registryMutex.try_lock();
+			if (otherThreadAcquiredLock)
+			{
+				registryMutex.unlock();
+			}
+		}).join();
+	SE_CHECK(otherThreadAcquiredLock);
+}
\ No newline at end of file
@@ -0,0 +1,258 @@
+// © 2025 Adam Badke. All rights reserved.
+#include "TestHarness.h"
+
+#include "Presentation/Transform.h"
+#include "Presentation/TransformComponent.h"
+#include "Presentation/TransformHierarchy.h"
+
+#include "Core/ThreadPool.h"
+
+
+namespace
+{
+	enum class ForestShape : uint8_t
+	{
+		Wide,	// Each node is parented to a random earlier node of its tree: Shallow, with many children each
+		Deep,	// Each tree is a single chain
+	};
+
+
+	// Owns a forest of Transforms. Parents are created (and stored) before their children
+	struct TestForest
+	{
+		std::vector<std::unique_ptr<pr::Transform>> m_transforms;
+		std::vector<pr::Transform*> m_rootNodes;
+
+		TestForest() = default;
+		TestForest(TestForest&&) noexcept = default;
+
+		~TestForest()
+		{
+			// Children first, so no Transform is destroyed while it still has children
+			while (!m_transforms.empty())
+			{
+				m_transforms.pop_back();
+			}
+		}
+	};
+
+
+	void SetRandomLocalTRS(pr::Transform& transform, std::mt19937& generator)
+	{
+		std::uniform_real_distribution<float> unitDist(-1.f, 1.f);
+		std::uniform_real_distribution<float> scaleDist(0.9f, 1.1f); // Keeps deep chains within a sensible range
+
+		// Braced initialization: The distributions are sampled in order
+		transform.SetLocalTranslation(glm::vec3{ unitDist(generator), unitDist(generator), unitDist(generator) });
+		transform.SetLocalRotation(glm::normalize(
+			glm::quat{ unitDist(generator), unitDist(generator), unitDist(generator), unitDist(generator) }));
+		transform.SetLocalScale(glm::vec3{ scaleDist(generator), scaleDist(generator), scaleDist(generator) });
+	}
+
+
+	// Node i belongs to tree (i % numRoots). Forests built from identically seeded generators are identical
+	TestForest BuildForest(size_t numNodes, size_t numRoots, ForestShape shape, std::mt19937& generator)
+	{
+		TestForest forest;
+		forest.m_transforms.reserve(numNodes);
+
+		for (size_t nodeIdx = 0; nodeIdx < numNodes; ++nodeIdx)
+		{
+			pr::Transform* parent = nullptr;
+			if (nodeIdx >= numRoots)
+			{
+				const size_t parentIdx = shape == ForestShape::Deep ?
+					nodeIdx - numRoots : (generator() % (nodeIdx / numRoots)) * numRoots + nodeIdx % numRoots;
+
+				parent = forest.m_transforms[parentIdx].get();
+			}
+
+			pr::Transform* node = forest.m_transforms.emplace_back(std::make_unique<pr::Transform>(parent)).get();
+			SetRandomLocalTRS(*node, generator);
+
+			if (parent == nullptr)
+			{
+				forest.m_rootNodes.emplace_back(node);
+			}
+		}
+		return forest;
+	}
+
+
+	// The per-root path EntityManager::UpdateTransforms takes when the flat hierarchy is disabled: A DFS job per root,
+	// recomputing (and locking) each Transform in turn
+	void UpdateEachRoot(TestForest const& forest)
+	{
+		core::JobCounter jobCounter;
+		for (pr::Transform* rootNode : forest.m_rootNodes)
+		{
+			pr::TransformComponent::DispatchTransformUpdateThreads(jobCounter, rootNode);
+		}
+		core::ThreadPool::WaitForCounter(jobCounter);
+	}
+
+
+	void ClearHasChangedFlags(TestForest const& forest)
+	{
+		for (std::unique_ptr<pr::Transform> const& transform : forest.m_transforms)
+		{
+			transform->ClearHasChangedFlag();
+		}
+	}
+
+
+	// Global matrices are scaled through the hierarchy: The tolerance is relative to their largest element
+	bool IsNearlyEqual(glm::mat4 const& result, glm::mat4 const& expected)
+	{
+		float maxElement = 1.f;
+		float maxError = 0.f;
+		for (glm::length_t col = 0; col < 4; ++col)
+		{
+			for (glm::length_t row = 0; row < 4; ++row)
+			{
+				maxElement = std::max(maxElement, std::abs(expected[col][row]));
+				maxError = std::max(maxError, std::abs(result[col][row] - expected[col][row]));
+			}
+		}
+		return maxError <= 0.00001f * maxElement;
+	}
+
+
+	uint32_t CountMismatchedGlobals(TestForest const& flatForest, TestForest const& referenceForest)
+	{
+		uint32_t numMismatched = 0;
+		for (size_t nodeIdx = 0; nodeIdx < flatForest.m_transforms.size(); ++nodeIdx)
+		{
+			pr::Transform const& flatNode = *flatForest.m_transforms[nodeIdx];
+			pr::Transform const& referenceNode = *referenceForest.m_transforms[nodeIdx];
+
+			numMismatched += !IsNearlyEqual(flatNode.GetGlobalMatrix(), referenceNode.GetGlobalMatrix());
+		}
+		return numMismatched;
+	}
+
+
+	// Nodes whose global matrix changed must be flagged, so they're sent to the render thread
+	uint32_t CountUnflaggedChanges(TestForest const& forest, std::vector<glm::mat4> const& prevGlobals)
+	{
+		uint32_t numUnflagged = 0;
+		for (size_t nodeIdx = 0; nodeIdx < forest.m_transforms.size(); ++nodeIdx)
+		{
+			pr::Transform const& node = *forest.m_transforms[nodeIdx];
+			numUnflagged += !IsNearlyEqual(node.GetGlobalMatrix(), prevGlobals[nodeIdx]) && !node.HasChanged();
+		}
+		return numUnflagged;
+	}
+}
+
+
+SE_TEST(TransformHierarchy_UpdateMatchesRecompute)
+{
+	constexpr size_t k_numNodes = 4000;
+	constexpr size_t k_numRoots = 16;
+	constexpr size_t k_numMovedPerFrame = 80;
+
+	for (ForestShape shape : { ForestShape::Wide, ForestShape::Deep })
+	{
+		std::mt19937 flatGenerator(1357);
+		std::mt19937 referenceGenerator(1357);
+		TestForest flatForest = BuildForest(k_numNodes, k_numRoots, shape, flatGenerator);
+		TestForest referenceForest = BuildForest(k_numNodes, k_numRoots, shape, referenceGenerator);
+
+		pr::TransformHierarchy hierarchy;
+		SE_CHECK(hierarchy.IsStale());
+
+		hierarchy.Build(flatForest.m_rootNodes);
+		SE_CHECK(!hierarchy.IsStale());
+		SE_CHECK(hierarchy.GetNumNodes() == k_numNodes);
+		SE_CHECK(shape != ForestShape::Deep || hierarchy.GetNumLevels() == k_numNodes / k_numRoots);
+
+		std::mt19937 moveGenerator(2468);
+		std::vector<glm::mat4> prevGlobals(k_numNodes, glm::mat4(1.f));
+		for (uint32_t frameIdx = 0; frameIdx < 4; ++frameIdx)
+		{
+			hierarchy.Update();
+			UpdateEachRoot(referenceForest);
+
+			SE_CHECK(CountMismatchedGlobals(flatForest, referenceForest) == 0);
+			SE_CHECK(CountUnflaggedChanges(flatForest, prevGlobals) == 0);
+
+			// As the render thread does, once it has copied the changed Transforms
+			for (size_t nodeIdx = 0; nodeIdx < k_numNodes; ++nodeIdx)
+			{
+				prevGlobals[nodeIdx] = flatForest.m_transforms[nodeIdx]->GetGlobalMatrix();
+			}
+			ClearHasChangedFlags(flatForest);
+			ClearHasChangedFlags(referenceForest);
+
+			// Move the same random nodes in both forests. Modifying Transforms doesn't make the hierarchy stale
+			for (size_t moveIdx = 0; moveIdx < k_numMovedPerFrame; ++moveIdx)
+			{
+				const size_t nodeIdx = moveGenerator() % k_numNodes;
+				SetRandomLocalTRS(*flatForest.m_transforms[nodeIdx], flatGenerator);
+				SetRandomLocalTRS(*referenceForest.m_transforms[nodeIdx], referenceGenerator);
+			}
+			SE_CHECK(!hierarchy.IsStale());
+		}
+
+		// Reparenting does make it stale
+		flatForest.m_transforms.back()->SetParent(flatForest.m_rootNodes.front());
+		SE_CHECK(hierarchy.IsStale());
+	}
+}
+
+
+SE_BENCHMARK(TransformHierarchy_Update100kNodes)
+{
+	constexpr size_t k_numNodes = 100000;
+
+	struct ForestConfig
+	{
+		ForestShape m_shape;
+		size_t m_numRoots;
+		char const* m_label;
+	};
+	constexpr ForestConfig k_forestConfigs[] = {
+		{ ForestShape::Wide, 100, "wide, 100 random trees" },
+		{ ForestShape::Deep, 1000, "deep, 1000 chains of 100" },
+	};
+
+	std::mt19937 generator(97531);
+	for (ForestConfig const& config : k_forestConfigs)
+	{
+		TestForest forest = BuildForest(k_numNodes, config.m_numRoots, config.m_shape, generator);
+
+		pr::TransformHierarchy hierarchy;
+		const double buildMs = tests::MeasureMedianMs(5, [&hierarchy, &forest]()
+			{
+				hierarchy.Build(forest.m_rootNodes);
+			});
+		tests::TestHarness::RecordTiming(
+			std::format("TransformHierarchy::Build: {}", config.m_label), buildMs, k_numNodes);
+
+		// Every root moves each frame, so every node's global matrix is recomputed by both paths
+		auto MoveRoots = [&forest]()
+			{
+				for (pr::Transform* rootNode : forest.m_rootNodes)
+				{
+					rootNode->TranslateLocal(glm::vec3(0.001f, 0.f, 0.f));
+				}
+			};
+
+		const double flatMs = tests::MeasureMedianMs(10, [&hierarchy, &MoveRoots]()
+			{
+				MoveRoots();
+				hierarchy.Update();
+			});
+		tests::TestHarness::RecordTiming(
+			std::format("Flat level-ordered update: {}", config.m_label), flatMs, k_numNodes);
+
+		const double perRootMs = tests::MeasureMedianMs(10, [&forest, &MoveRoots]()
+			{
+				MoveRoots();
+				UpdateEachRoot(forest);
+			});
+		tests::TestHarness::RecordTiming(
+			std::format("Per-root DFS update: {}", config.m_label), perRootMs, k_numNodes);
+	}
+}
\ No newline at end of file
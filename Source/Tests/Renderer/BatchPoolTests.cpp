@@ -0,0 +1,187 @@
+// © 2025 Adam Badke. All rights reserved.
+#include "TestHarness.h"
+
+#include "Renderer/Batch.h"
+#include "Renderer/BatchBuilder.h"
+#include "Renderer/BatchHandle.h"
+#include "Renderer/BatchPool.h"
+
+
+namespace
+{
+	constexpr uint8_t k_numFramesInFlight = 2;
+
+
+	// Compute batches are hashed by their thread group count, so each (key, generation) pair is a unique batch
+	gr::BatchHandle BuildBatch(uint32_t key, uint32_t generation)
+	{
+		return gr::ComputeBatchBuilder()
+			.SetThreadGroupCount(glm::uvec3(key, generation, 1))
+			.Build();
+	}
+
+
+	uint64_t GetBatchKey(gr::BatchHandle const& batchHandle)
+	{
+		glm::uvec3 const& threadGroupCount = batchHandle->GetComputeParams().m_threadGroupCount;
+		return (static_cast<uint64_t>(threadGroupCount.y) << 32) | threadGroupCount.x;
+	}
+
+
+	// Builds batches from a shared set of keys on several threads at once, so most builds find an existing batch via
+	// the lock-free lookup. A random subset of the handles is held across frames; the rest are released immediately
+	template<typename Function>
+	void BuildOnThreads(uint32_t numThreads, Function&& buildFunction)
+	{
+		std::vector<std::thread> builders;
+		for (uint32_t threadIdx = 0; threadIdx < numThreads; ++threadIdx)
+		{
+			builders.emplace_back([&buildFunction, threadIdx]() { buildFunction(threadIdx); });
+		}
+		for (std::thread& builder : builders)
+		{
+			builder.join();
+		}
+	}
+}
+
+
+SE_TEST(BatchPool_ConcurrentBuildsShareAndRecycleBatches)
+{
+	constexpr uint32_t k_numThreads = 8;
+	constexpr uint64_t k_numFrames = 60;
+	constexpr uint64_t k_framesPerGeneration = 10; // The set of batches being built changes every N frames
+	constexpr uint32_t k_numKeys = 4000;
+	constexpr uint32_t k_numBuildsPerThread = 5000;
+	constexpr size_t k_maxHeldHandlesPerThread = 1000;
+
+	gr::BatchPool batchPool(k_numFramesInFlight);
+
+	std::vector<std::vector<gr::BatchHandle>> heldHandles(k_numThreads);
+	std::atomic<uint32_t> numWrongBatches = 0;
+	std::atomic<gr::PoolIndex> maxPoolIndex = 0;
+	uint32_t numDuplicatedBatches = 0;
+
+	uint64_t frameNum = 0;
+	while (++frameNum <= k_numFrames)
+	{
+		batchPool.Update(frameNum); // Drains the deferred deletes: No builds are in flight
+
+		const uint32_t generation = static_cast<uint32_t>(frameNum / k_framesPerGeneration);
+
+		BuildOnThreads(k_numThreads, [&](uint32_t threadIdx)
+			{
+				std::mt19937 generator(static_cast<uint32_t>(frameNum * k_numThreads + threadIdx));
+				std::uniform_int_distribution<uint32_t> keyDist(0, k_numKeys - 1);
+
+				std::vector<gr::BatchHandle>& threadHandles = heldHandles[threadIdx];
+				gr::PoolIndex threadMaxPoolIndex = 0;
+
+				for (uint32_t buildIdx = 0; buildIdx < k_numBuildsPerThread; ++buildIdx)
+				{
+					const uint32_t key = keyDist(generator);
+					const uint64_t expectedBatchKey = (static_cast<uint64_t>(generation) << 32) | key;
+
+					gr::BatchHandle batchHandle = BuildBatch(key, generation);
+					if (!batchHandle.IsValid() || GetBatchKey(batchHandle) != expectedBatchKey)
+					{
+						numWrongBatches.fetch_add(1);
+						continue;
+					}
+					threadMaxPoolIndex = std::max(threadMaxPoolIndex, batchHandle.GetPoolIndex());
+
+					if (generator() % 4 == 0)
+					{
+						threadHandles.emplace_back(std::move(batchHandle));
+					}
+					if (threadHandles.size() > k_maxHeldHandlesPerThread)
+					{
+						// Release a random held handle: Batches from older generations drop to 0 refs over time
+						std::swap(threadHandles[generator() % threadHandles.size()], threadHandles.back());
+						threadHandles.pop_back();
+					}
+				}
+
+				gr::PoolIndex currentMax = maxPoolIndex.load();
+				while (currentMax < threadMaxPoolIndex &&
+					!maxPoolIndex.compare_exchange_weak(currentMax, threadMaxPoolIndex));
+			});
+
+		// Batches are de-duplicated: Every live handle to the same batch data must refer to the same pool slot
+		std::unordered_map<uint64_t, gr::PoolIndex> batchKeyToPoolIndex;
+		for (std::vector<gr::BatchHandle> const& threadHandles : heldHandles)
+		{
+			for (gr::BatchHandle const& batchHandle : threadHandles)
+			{
+				auto const& [itr, didInsert] =
+					batchKeyToPoolIndex.emplace(GetBatchKey(batchHandle), batchHandle.GetPoolIndex());
+				numDuplicatedBatches += !didInsert && itr->second != batchHandle.GetPoolIndex();
+			}
+		}
+	}
+	SE_CHECK(numWrongBatches.load() == 0);
+	SE_CHECK(numDuplicatedBatches == 0);
+
+	// Released batches are deleted once they're no longer in flight, and their slots are reused. Otherwise, every
+	// generation would claim another k_numKeys slots
+	SE_CHECK(maxPoolIndex.load() < 3 * k_numKeys);
+
+	// Release everything. Destroy() asserts that every slot was returned to its page's free index stack, and that the
+	// hash table is empty
+	heldHandles.clear();
+	for (uint8_t i = 0; i <= k_numFramesInFlight; ++i)
+	{
+		batchPool.Update(frameNum++);
+	}
+
+	// Batches deleted by the drain can be built again
+	{
+		gr::BatchHandle rebuiltHandle = BuildBatch(0, 0);
+		SE_CHECK(rebuiltHandle.IsValid() && GetBatchKey(rebuiltHandle) == 0);
+	}
+	batchPool.Destroy();
+}
+
+
+SE_BENCHMARK(BatchPool_ConcurrentBuildThroughput)
+{
+	constexpr uint32_t k_numKeys = 20000;
+	constexpr uint32_t k_numBuildsPerThread = 20000;
+
+	for (uint32_t numThreads : { 1u, 2u, 4u, 8u })
+	{
+		gr::BatchPool batchPool(k_numFramesInFlight);
+
+		// Keep every batch alive, as the batch managers do for batches that are reused frame to frame
+		std::vector<gr::BatchHandle> persistentHandles;
+		for (uint32_t key = 0; key < k_numKeys; ++key)
+		{
+			persistentHandles.emplace_back(BuildBatch(key, 0));
+		}
+
+		uint64_t frameNum = 0;
+		const double medianMs = tests::MeasureMedianMs(10, [&]()
+			{
+				batchPool.Update(++frameNum);
+
+				BuildOnThreads(numThreads, [&](uint32_t threadIdx)
+					{
+						std::mt19937 generator(threadIdx);
+						std::uniform_int_distribution<uint32_t> keyDist(0, k_numKeys - 1);
+
+						// Each handle adds a ref when built, and releases it when it goes out of scope
+						for (uint32_t buildIdx = 0; buildIdx < k_numBuildsPerThread; ++buildIdx)
+						{
+							BuildBatch(keyDist(generator), 0);
+						}
+					});
+			});
+		tests::TestHarness::RecordTiming(
+			std::format("Build 20k existing batches per thread: {} thread(s)", numThreads),
+			medianMs,
+			numThreads * k_numBuildsPerThread);
+
+		persistentHandles.clear();
+		batchPool.Destroy();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,312 @@
+// © 2025 Adam Badke. All rights reserved.
+#include "TestHarness.h"
+
+#include "Renderer/BoundsHierarchy.h"
+#include "Renderer/FrustumCulling.h"
+
+
+namespace
+{
+	struct TestBounds
+	{
+		glm::vec3 m_minXYZ;
+		glm::vec3 m_maxXYZ;
+	};
+	using BoundsMap = std::map<gr::RenderDataID, TestBounds>;
+
+
+	TestBounds GetRandomBounds(std::mt19937& generator, float sceneHalfExtent, float maxHalfExtent)
+	{
+		std::uniform_real_distribution<float> centerDist(-sceneHalfExtent, sceneHalfExtent);
+		std::uniform_real_distribution<float> halfExtentDist(0.f, maxHalfExtent);
+
+		const glm::vec3 center(centerDist(generator), centerDist(generator), centerDist(generator));
+		const glm::vec3 halfExtents(halfExtentDist(generator), halfExtentDist(generator), halfExtentDist(generator));
+
+		return TestBounds{ .m_minXYZ = center - halfExtents, .m_maxXYZ = center + halfExtents };
+	}
+
+
+	gr::Camera::Frustum BuildTestFrustum(glm::vec3 const& camPos, glm::vec3 const& target)
+	{
+		const glm::mat4 view = glm::lookAt(camPos, target, glm::vec3(0.f, 1.f, 0.f));
+		const glm::mat4 projection =
+			gr::Camera::BuildPerspectiveProjectionMatrix(glm::radians(70.f), 16.f / 9.f, 0.1f, 150.f);
+
+		return gr::Camera::Frustum(camPos, glm::inverse(projection * view));
+	}
+
+
+	bool Overlaps(TestBounds const& bounds, glm::vec3 const& minXYZ, glm::vec3 const& maxXYZ)
+	{
+		return !glm::any(glm::lessThan(bounds.m_maxXYZ, minXYZ)) && !glm::any(glm::lessThan(maxXYZ, bounds.m_minXYZ));
+	}
+
+
+	// Returns true (and the entry distance) if the ray hits the bounds within maxDistance
+	bool IntersectRay(
+		TestBounds const& bounds,
+		glm::vec3 const& origin,
+		glm::vec3 const& direction,
+		float maxDistance,
+		float& entryDistanceOut)
+	{
+		float exitDistance = maxDistance;
+		entryDistanceOut = 0.f;
+		for (uint8_t axis = 0; axis < 3; ++axis)
+		{
+			const float t0 = (bounds.m_minXYZ[axis] - origin[axis]) * (1.f / direction[axis]);
+			const float t1 = (bounds.m_maxXYZ[axis] - origin[axis]) * (1.f / direction[axis]);
+
+			entryDistanceOut = std::max(entryDistanceOut, std::min(t0, t1));
+			exitDistance = std::min(exitDistance, std::max(t0, t1));
+		}
+		return entryDistanceOut <= exitDistance;
+	}
+
+
+	// Returns the number of queries where the hierarchy's results differ from a brute force test of every bounds
+	uint32_t CountQueryMismatches(gr::BoundsHierarchy const& boundsHierarchy, BoundsMap const& boundsMap, uint32_t seed)
+	{
+		constexpr uint32_t k_numQueries = 200;
+
+		std::mt19937 generator(seed);
+		std::uniform_real_distribution<float> unitDist(-1.f, 1.f);
+
+		uint32_t numMismatches = 0;
+
+		numMismatches += (boundsHierarchy.GetNumLeaves() != boundsMap.size());
+		for (auto const& [renderDataID, bounds] : boundsMap)
+		{
+			numMismatches += !boundsHierarchy.Contains(renderDataID);
+		}
+
+		std::vector<gr::RenderDataID> resultIDs;
+		std::vector<gr::RenderDataID> expectedIDs;
+		for (uint32_t queryIdx = 0; queryIdx < k_numQueries; ++queryIdx)
+		{
+			// AABB:
+			const TestBounds queryBounds = GetRandomBounds(generator, 100.f, 20.f);
+
+			resultIDs.clear();
+			boundsHierarchy.QueryAABB(queryBounds.m_minXYZ, queryBounds.m_maxXYZ, resultIDs);
+
+			expectedIDs.clear();
+			for (auto const& [renderDataID, bounds] : boundsMap)
+			{
+				if (Overlaps(bounds, queryBounds.m_minXYZ, queryBounds.m_maxXYZ))
+				{
+					expectedIDs.emplace_back(renderDataID);
+				}
+			}
+			std::sort(resultIDs.begin(), resultIDs.end());
+			numMismatches += (resultIDs != expectedIDs);
+
+			// Point: Alternate between random points, and points exactly on the corner of a bounds
+			glm::vec3 point = queryBounds.m_minXYZ;
+			if (queryIdx % 2 == 1 && !boundsMap.empty())
+			{
+				point = std::next(boundsMap.begin(), queryIdx % boundsMap.size())->second.m_maxXYZ;
+			}
+
+			resultIDs.clear();
+			boundsHierarchy.QueryPoint(point, resultIDs);
+
+			expectedIDs.clear();
+			for (auto const& [renderDataID, bounds] : boundsMap)
+			{
+				if (Overlaps(bounds, point, point))
+				{
+					expectedIDs.emplace_back(renderDataID);
+				}
+			}
+			std::sort(resultIDs.begin(), resultIDs.end());
+			numMismatches += (resultIDs != expectedIDs);
+
+			// Ray:
+			const glm::vec3 origin = queryBounds.m_maxXYZ;
+			const glm::vec3 direction(unitDist(generator), unitDist(generator), unitDist(generator));
+			constexpr float k_maxRayDistance = 80.f;
+
+			std::vector<gr::BoundsHierarchy::RayHit> hits;
+			boundsHierarchy.QueryRay(origin, direction, k_maxRayDistance, hits);
+
+			numMismatches += std::adjacent_find(hits.begin(), hits.end(),
+				[](gr::BoundsHierarchy::RayHit const& prev, gr::BoundsHierarchy::RayHit const& next)
+				{
+					return next.m_distance < prev.m_distance;
+				}) != hits.end();
+
+			resultIDs.clear();
+			for (gr::BoundsHierarchy::RayHit const& hit : hits)
+			{
+				resultIDs.emplace_back(hit.m_renderDataID);
+
+				float entryDistance = 0.f;
+				numMismatches += !IntersectRay(boundsMap.at(hit.m_renderDataID), origin, direction, k_maxRayDistance,
+					entryDistance) || std::abs(entryDistance - hit.m_distance) > 0.001f;
+			}
+
+			expectedIDs.clear();
+			for (auto const& [renderDataID, bounds] : boundsMap)
+			{
+				float entryDistance = 0.f;
+				if (IntersectRay(bounds, origin, direction, k_maxRayDistance, entryDistance))
+				{
+					expectedIDs.emplace_back(renderDataID);
+				}
+			}
+			std::sort(resultIDs.begin(), resultIDs.end());
+			numMismatches += (resultIDs != expectedIDs);
+
+			// Frustum, as traversed when culling lights:
+			const gr::Camera::Frustum frustum = BuildTestFrustum(origin, origin + direction);
+			const grutil::FrustumSlabs slabs = grutil::BuildFrustumSlabs(frustum);
+
+			resultIDs.clear();
+			boundsHierarchy.Query(
+				[&slabs](glm::vec3 const& minXYZ, glm::vec3 const& maxXYZ)
+				{
+					return grutil::ClassifyBounds(minXYZ, maxXYZ, slabs);
+				},
+				[&](gr::RenderDataID renderDataID, glm::vec3 const& minXYZ, glm::vec3 const& maxXYZ, bool isInside)
+				{
+					if (isInside || grutil::TestBoundsVisibility(minXYZ, maxXYZ, frustum))
+					{
+						resultIDs.emplace_back(renderDataID);
+					}
+				});
+
+			expectedIDs.clear();
+			for (auto const& [renderDataID, bounds] : boundsMap)
+			{
+				if (grutil::TestBoundsVisibility(bounds.m_minXYZ, bounds.m_maxXYZ, frustum))
+				{
+					expectedIDs.emplace_back(renderDataID);
+				}
+			}
+			std::sort(resultIDs.begin(), resultIDs.end());
+			numMismatches += (resultIDs != expectedIDs);
+		}
+		return numMismatches;
+	}
+}
+
+
+SE_TEST(BoundsHierarchy_QueriesMatchBruteForceAsBoundsChange)
+{
+	constexpr gr::RenderDataID k_numBounds = 2000;
+
+	std::mt19937 generator(2468);
+
+	gr::BoundsHierarchy boundsHierarchy;
+	BoundsMap boundsMap;
+
+	for (gr::RenderDataID renderDataID = 0; renderDataID < k_numBounds; ++renderDataID)
+	{
+		const TestBounds bounds = GetRandomBounds(generator, 100.f, 5.f);
+		boundsHierarchy.Add(renderDataID, bounds.m_minXYZ, bounds.m_maxXYZ);
+		boundsMap.emplace(renderDataID, bounds);
+	}
+	SE_CHECK(CountQueryMismatches(boundsHierarchy, boundsMap, 1) == 0);
+
+	// The tree is kept balanced: A degenerate (linear) tree would be ~k_numBounds high
+	SE_CHECK(boundsHierarchy.GetHeight() <= 2 * static_cast<uint32_t>(std::ceil(std::log2(k_numBounds))));
+
+	// Small movements stay within the fattened leaf bounds, large movements reinsert the leaf
+	std::uniform_real_distribution<float> smallOffsetDist(-0.05f, 0.05f);
+	for (auto& [renderDataID, bounds] : boundsMap)
+	{
+		if (renderDataID % 2 == 0)
+		{
+			const glm::vec3 offset(smallOffsetDist(generator), smallOffsetDist(generator), smallOffsetDist(generator));
+			bounds.m_minXYZ = bounds.m_minXYZ + offset;
+			bounds.m_maxXYZ = bounds.m_maxXYZ + offset;
+		}
+		else if (renderDataID % 3 == 0)
+		{
+			bounds = GetRandomBounds(generator, 100.f, 5.f);
+		}
+		else
+		{
+			continue;
+		}
+		boundsHierarchy.Update(renderDataID, bounds.m_minXYZ, bounds.m_maxXYZ);
+	}
+	SE_CHECK(CountQueryMismatches(boundsHierarchy, boundsMap, 2) == 0);
+
+	// Remove some bounds, and add new ones: The freed nodes are reused
+	for (gr::RenderDataID renderDataID = 0; renderDataID < k_numBounds; renderDataID += 4)
+	{
+		boundsHierarchy.Remove(renderDataID);
+		boundsMap.erase(renderDataID);
+	}
+	for (gr::RenderDataID renderDataID = k_numBounds; renderDataID < k_numBounds + k_numBounds / 8; ++renderDataID)
+	{
+		const TestBounds bounds = GetRandomBounds(generator, 100.f, 20.f);
+		boundsHierarchy.Add(renderDataID, bounds.m_minXYZ, bounds.m_maxXYZ);
+		boundsMap.emplace(renderDataID, bounds);
+	}
+	SE_CHECK(boundsHierarchy.GetNumNodes() == 2 * boundsMap.size() - 1);
+	SE_CHECK(CountQueryMismatches(boundsHierarchy, boundsMap, 3) == 0);
+
+	boundsHierarchy.Clear();
+	SE_CHECK(boundsHierarchy.GetNumLeaves() == 0 && boundsHierarchy.GetHeight() == 0);
+	SE_CHECK(CountQueryMismatches(boundsHierarchy, {}, 4) == 0);
+}
+
+
+SE_BENCHMARK(BoundsHierarchy_CullLightBounds)
+{
+	constexpr gr::RenderDataID k_numLights = 10000;
+
+	std::mt19937 generator(1357);
+
+	gr::BoundsHierarchy boundsHierarchy;
+	std::vector<TestBounds> lightBounds;
+	for (gr::RenderDataID renderDataID = 0; renderDataID < k_numLights; ++renderDataID)
+	{
+		lightBounds.emplace_back(GetRandomBounds(generator, 500.f, 10.f));
+		boundsHierarchy.Add(renderDataID, lightBounds.back().m_minXYZ, lightBounds.back().m_maxXYZ);
+	}
+
+	const gr::Camera::Frustum frustum = BuildTestFrustum(glm::vec3(0.f), glm::vec3(1.f, 0.2f, -1.f));
+	const grutil::FrustumSlabs slabs = grutil::BuildFrustumSlabs(frustum);
+
+	std::vector<gr::RenderDataID> visibleIDs;
+	visibleIDs.reserve(k_numLights);
+
+	const double hierarchyMs = tests::MeasureMedianMs(20, [&]()
+		{
+			visibleIDs.clear();
+			boundsHierarchy.Query(
+				[&slabs](glm::vec3 const& minXYZ, glm::vec3 const& maxXYZ)
+				{
+					return grutil::ClassifyBounds(minXYZ, maxXYZ, slabs);
+				},
+				[&](gr::RenderDataID renderDataID, glm::vec3 const& minXYZ, glm::vec3 const& maxXYZ, bool isInside)
+				{
+					if (isInside || grutil::TestBoundsVisibility(minXYZ, maxXYZ, frustum))
+					{
+						visibleIDs.emplace_back(renderDataID);
+					}
+				});
+			tests::DoNotOptimize(visibleIDs.size());
+		});
+	tests::TestHarness::RecordTiming("Cull 10k light bounds: Hierarchy traversal", hierarchyMs, k_numLights);
+
+	const double linearMs = tests::MeasureMedianMs(20, [&]()
+		{
+			visibleIDs.clear();
+			for (gr::RenderDataID renderDataID = 0; renderDataID < k_numLights; ++renderDataID)
+			{
+				if (grutil::TestBoundsVisibility(
+					lightBounds[renderDataID].m_minXYZ, lightBounds[renderDataID].m_maxXYZ, frustum))
+				{
+					visibleIDs.emplace_back(renderDataID);
+				}
+			}
+			tests::DoNotOptimize(visibleIDs.size());
+		});
+	tests::TestHarness::RecordTiming("Cull 10k light bounds: Linear SAT", linearMs, k_numLights);
+}
\ No newline at end of file
@@ -0,0 +1,229 @@
+// © 2025 Adam Badke. All rights reserved.
+#include "TestHarness.h"
+
+#include "Renderer/FrustumCulling.h"
+
+
+namespace
+{
+	gr::Camera::Frustum BuildPerspectiveFrustum(
+		glm::vec3 const& camPos, glm::vec3 const& target, float fovY, float nearDist, float farDist)
+	{
+		const glm::mat4 view = glm::lookAt(camPos, target, glm::vec3(0.f, 1.f, 0.f));
+		const glm::mat4 projection = gr::Camera::BuildPerspectiveProjectionMatrix(fovY, 16.f / 9.f, nearDist, farDist);
+
+		return gr::Camera::Frustum(camPos, glm::inverse(projection * view));
+	}
+
+
+	gr::Camera::Frustum BuildOrthographicFrustum(glm::vec3 const& camPos, glm::vec3 const& target, float halfExtent)
+	{
+		const glm::mat4 view = glm::lookAt(camPos, target, glm::vec3(0.f, 1.f, 0.f));
+		const glm::mat4 projection = gr::Camera::BuildOrthographicProjectionMatrix(
+			-halfExtent, halfExtent, -halfExtent, halfExtent, 0.1f, 200.f);
+
+		return gr::Camera::Frustum(camPos, glm::inverse(projection * view));
+	}
+
+
+	std::vector<gr::Camera::Frustum> BuildTestFrustums()
+	{
+		return {
+			BuildPerspectiveFrustum(glm::vec3(0.f), glm::vec3(0.f, 0.f, -1.f), glm::radians(60.f), 0.1f, 100.f),
+			BuildPerspectiveFrustum( // Rotated off every world axis
+				glm::vec3(3.f, -2.f, 5.f), glm::vec3(-4.f, 7.f, -9.f), glm::radians(90.f), 0.5f, 250.f),
+			BuildPerspectiveFrustum( // Narrow, looking straight down
+				glm::vec3(0.f, 50.f, 0.f), glm::vec3(0.f, 0.f, 0.01f), glm::radians(10.f), 1.f, 1000.f),
+			BuildOrthographicFrustum(glm::vec3(10.f, 10.f, 10.f), glm::vec3(0.f), 25.f),
+		};
+	}
+
+
+	// Random bounds scattered around the origin: From points to bounds larger than the frustums, with varying aspect
+	grutil::BoundsSoA BuildRandomBounds(size_t numBounds, uint32_t seed)
+	{
+		std::mt19937 generator(seed);
+		std::uniform_real_distribution<float> centerDist(-150.f, 150.f);
+		std::uniform_real_distribution<float> log2ExtentDist(-10.f, 8.f);
+
+		grutil::BoundsSoA bounds;
+		for (size_t boundsIdx = 0; boundsIdx < numBounds; ++boundsIdx)
+		{
+			const glm::vec3 center(centerDist(generator), centerDist(generator), centerDist(generator));
+			const glm::vec3 halfExtents(
+				std::exp2(log2ExtentDist(generator)),
+				std::exp2(log2ExtentDist(generator)),
+				std::exp2(log2ExtentDist(generator)));
+
+			bounds.Add(static_cast<gr::RenderDataID>(boundsIdx), center - halfExtents, center + halfExtents);
+		}
+		bounds.Pad();
+		return bounds;
+	}
+
+
+	// Bounds the SIMD slabs are most likely to misclassify: Points, flat/line bounds, bounds touching the frustum's
+	// world AABB, bounds straddling the frustum corners and faces, and bounds enclosing the entire frustum
+	grutil::BoundsSoA BuildDegenerateBounds(gr::Camera::Frustum const& frustum)
+	{
+		const grutil::FrustumSlabs slabs = grutil::BuildFrustumSlabs(frustum);
+
+		grutil::BoundsSoA bounds;
+		auto AddBounds = [&bounds](glm::vec3 const& minXYZ, glm::vec3 const& maxXYZ)
+			{
+				bounds.Add(static_cast<gr::RenderDataID>(bounds.Size()), minXYZ, maxXYZ);
+			};
+
+		const glm::vec3 frustumCenter = (slabs.m_cornersMin + slabs.m_cornersMax) * 0.5f;
+		const glm::vec3 frustumExtents = slabs.m_cornersMax - slabs.m_cornersMin;
+
+		AddBounds(frustumCenter, frustumCenter); // Point
+		AddBounds(slabs.m_cornersMin - frustumExtents, slabs.m_cornersMax + frustumExtents); // Encloses the frustum
+		AddBounds(slabs.m_cornersMin, slabs.m_cornersMax); // Exactly the frustum's world AABB
+
+		for (glm::vec3 const& corner : frustum.m_corners)
+		{
+			AddBounds(corner, corner);
+			AddBounds(corner - glm::vec3(0.01f), corner + glm::vec3(0.01f));
+			AddBounds(corner - frustumExtents * 0.25f, corner + frustumExtents * 0.25f);
+		}
+
+		for (glm::vec3 const& point : frustum.m_points)
+		{
+			AddBounds(point, point);
+			AddBounds(point - glm::vec3(1.f, 0.f, 0.f), point + glm::vec3(1.f, 0.f, 0.f)); // Lines
+			AddBounds(point - glm::vec3(0.f, 1.f, 0.f), point + glm::vec3(0.f, 1.f, 0.f));
+			AddBounds(point - glm::vec3(0.f, 0.f, 1.f), point + glm::vec3(0.f, 0.f, 1.f));
+		}
+
+		for (uint8_t axis = 0; axis < 3; ++axis)
+		{
+			// Flat bounds through the frustum
+			glm::vec3 flatMin = slabs.m_cornersMin - frustumExtents;
+			glm::vec3 flatMax = slabs.m_cornersMax + frustumExtents;
+			flatMin[axis] = frustumCenter[axis];
+			flatMax[axis] = frustumCenter[axis];
+			AddBounds(flatMin, flatMax);
+
+			// Touching the frustum's world AABB from either side, and just beyond it
+			glm::vec3 touchingMin = frustumCenter - glm::vec3(1.f);
+			glm::vec3 touchingMax = frustumCenter + glm::vec3(1.f);
+
+			touchingMin[axis] = slabs.m_cornersMax[axis];
+			touchingMax[axis] = slabs.m_cornersMax[axis] + 1.f;
+			AddBounds(touchingMin, touchingMax);
+
+			touchingMin[axis] = slabs.m_cornersMin[axis] - 1.f;
+			touchingMax[axis] = slabs.m_cornersMin[axis];
+			AddBounds(touchingMin, touchingMax);
+
+			touchingMin[axis] = std::nextafter(slabs.m_cornersMax[axis], std::numeric_limits<float>::max());
+			touchingMax[axis] = slabs.m_cornersMax[axis] + 1.f;
+			AddBounds(touchingMin, touchingMax);
+		}
+
+		bounds.Pad();
+		return bounds;
+	}
+
+
+	// Returns the number of bounds in [beginIdx, endIdx) where the SIMD paths disagree with the exact SAT test
+	uint32_t CountMismatches(
+		grutil::BoundsSoA const& bounds, size_t beginIdx, size_t endIdx, gr::Camera::Frustum const& frustum)
+	{
+		const grutil::FrustumSlabs slabs = grutil::BuildFrustumSlabs(frustum);
+
+		std::vector<uint8_t> classifications(endIdx - beginIdx);
+		grutil::ClassifyBounds(bounds, beginIdx, endIdx, slabs, classifications.data());
+
+		std::vector<uint8_t> visibility;
+		grutil::CullBounds(bounds, beginIdx, endIdx, frustum, slabs, visibility);
+
+		uint32_t numMismatches = 0;
+		for (size_t boundsIdx = beginIdx; boundsIdx < endIdx; ++boundsIdx)
+		{
+			const glm::vec3 minXYZ(bounds.m_minX[boundsIdx], bounds.m_minY[boundsIdx], bounds.m_minZ[boundsIdx]);
+			const glm::vec3 maxXYZ(bounds.m_maxX[boundsIdx], bounds.m_maxY[boundsIdx], bounds.m_maxZ[boundsIdx]);
+
+			const bool isVisible = grutil::TestBoundsVisibility(minXYZ, maxXYZ, frustum);
+			const grutil::CullResult scalarResult = grutil::ClassifyBounds(minXYZ, maxXYZ, slabs);
+			const grutil::CullResult simdResult =
+				static_cast<grutil::CullResult>(classifications[boundsIdx - beginIdx]);
+
+			// The slabs are a subset of the SAT axes: Outside must be exact, and Inside is a conservative subset
+			const bool classificationIsValid = (simdResult == scalarResult) &&
+				(simdResult != grutil::CullResult::Outside || !isVisible) &&
+				(simdResult != grutil::CullResult::Inside || isVisible);
+
+			numMismatches += !classificationIsValid ||
+				(visibility[boundsIdx - beginIdx] != 0) != isVisible ||
+				grutil::IsBoundsVisible(minXYZ, maxXYZ, frustum, slabs) != isVisible;
+		}
+		return numMismatches;
+	}
+}
+
+
+SE_TEST(FrustumCulling_SIMDMatchesSATForRandomBounds)
+{
+	constexpr size_t k_numBounds = 100003; // Not a multiple of the SIMD width
+
+	const grutil::BoundsSoA bounds = BuildRandomBounds(k_numBounds, 12345);
+
+	for (gr::Camera::Frustum const& frustum : BuildTestFrustums())
+	{
+		SE_CHECK(CountMismatches(bounds, 0, bounds.Size(), frustum) == 0);
+
+		// Sub-ranges that start/end part way through a SIMD group
+		SE_CHECK(CountMismatches(bounds, 1, 2, frustum) == 0);
+		SE_CHECK(CountMismatches(bounds, 3, 10, frustum) == 0);
+		SE_CHECK(CountMismatches(bounds, bounds.Size() - 5, bounds.Size(), frustum) == 0);
+	}
+}
+
+
+SE_TEST(FrustumCulling_SIMDMatchesSATForDegenerateBounds)
+{
+	for (gr::Camera::Frustum const& frustum : BuildTestFrustums())
+	{
+		const grutil::BoundsSoA bounds = BuildDegenerateBounds(frustum);
+
+		SE_CHECK(CountMismatches(bounds, 0, bounds.Size(), frustum) == 0);
+		for (size_t beginIdx = 1; beginIdx < grutil::BoundsSoA::k_simdWidth; ++beginIdx)
+		{
+			SE_CHECK(CountMismatches(bounds, beginIdx, bounds.Size(), frustum) == 0);
+		}
+	}
+}
+
+
+SE_BENCHMARK(FrustumCulling_CullOneMillionBounds)
+{
+	constexpr size_t k_numBounds = 1000000;
+
+	const grutil::BoundsSoA bounds = BuildRandomBounds(k_numBounds, 6789);
+	const gr::Camera::Frustum frustum = BuildTestFrustums()[1];
+	const grutil::FrustumSlabs slabs = grutil::BuildFrustumSlabs(frustum);
+
+	std::vector<uint8_t> visibility;
+	const double simdMs = tests::MeasureMedianMs(10, [&]()
+		{
+			grutil::CullBounds(bounds, 0, bounds.Size(), frustum, slabs, visibility);
+			tests::DoNotOptimize(visibility[k_numBounds / 2]);
+		});
+	tests::TestHarness::RecordTiming("Cull 1M AABBs: SSE slabs + SAT fallback", simdMs, k_numBounds);
+
+	const double satMs = tests::MeasureMedianMs(10, [&]()
+		{
+			uint32_t numVisible = 0;
+			for (size_t boundsIdx = 0; boundsIdx < bounds.Size(); ++boundsIdx)
+			{
+				numVisible += grutil::TestBoundsVisibility(
+					glm::vec3(bounds.m_minX[boundsIdx], bounds.m_minY[boundsIdx], bounds.m_minZ[boundsIdx]),
+					glm::vec3(bounds.m_maxX[boundsIdx], bounds.m_maxY[boundsIdx], bounds.m_maxZ[boundsIdx]),
+					frustum);
+			}
+			tests::DoNotOptimize(numVisible);
+		});
+	tests::TestHarness::RecordTiming("Cull 1M AABBs: Scalar SAT", satMs, k_numBounds);
+}
\ No newline at end of file
@@ -0,0 +1,289 @@
+// © 2025 Adam Badke. All rights reserved.
+#include "TestHarness.h"
+
+#include "Renderer/IndexedBufferData.h"
+
+
+namespace
+{
+	using TestBufferData = gr::IndexedBufferData<uint64_t>;
+
+
+	struct UploadRange
+	{
+		TestBufferData::IndexType m_baseIdx;
+		TestBufferData::IndexType m_numElements;
+
+		bool operator==(UploadRange const&) const = default;
+	};
+
+
+	std::vector<UploadRange> ConsumeDirtyRanges(TestBufferData& bufferData)
+	{
+		std::vector<UploadRange> ranges;
+		bufferData.ConsumeDirtyRanges(
+			[&ranges](TestBufferData::IndexType baseIdx, TestBufferData::IndexType numElements)
+			{
+				ranges.emplace_back(UploadRange{ baseIdx, numElements });
+			});
+		return ranges;
+	}
+
+
+	// Adds IDs [0, numElements), each with data (ID * 10), and consumes the resulting dirty range
+	void AddElements(TestBufferData& bufferData, gr::IDType numElements)
+	{
+		for (gr::IDType id = 0; id < numElements; ++id)
+		{
+			bufferData.AddOrUpdateElement(id, id * 10ull);
+		}
+		ConsumeDirtyRanges(bufferData);
+	}
+
+
+	// Returns the number of elements whose ID <-> index mappings disagree, or whose data doesn't belong to their ID
+	uint32_t CountMappingErrors(
+		TestBufferData const& bufferData, std::unordered_map<gr::IDType, uint64_t> const& expected)
+	{
+		uint32_t numErrors = (bufferData.GetNumElements() != expected.size());
+		numErrors += (bufferData.GetIDToIndexMap().size() != expected.size());
+
+		for (TestBufferData::IndexType bufferIdx = 0; bufferIdx < bufferData.GetNumElements(); ++bufferIdx)
+		{
+			const gr::IDType id = bufferData.GetID(bufferIdx);
+
+			auto expectedItr = expected.find(id);
+			numErrors += (expectedItr == expected.end() ||
+				bufferData.GetIndex(id) != bufferIdx ||
+				bufferData.GetElement(bufferIdx) != expectedItr->second);
+		}
+		return numErrors;
+	}
+}
+
+
+SE_TEST(IndexedBufferData_RemovalKeepsElementsDense)
+{
+	TestBufferData bufferData;
+	AddElements(bufferData, 6);
+
+	std::unordered_map<gr::IDType, uint64_t> expected;
+	for (gr::IDType id = 0; id < 6; ++id)
+	{
+		expected.emplace(id, id * 10ull);
+	}
+	SE_CHECK(CountMappingErrors(bufferData, expected) == 0);
+
+	// Removing from the middle moves the last element into the hole, and marks it dirty at its new index
+	bufferData.RemoveElement(1);
+	expected.erase(1);
+	SE_CHECK(bufferData.GetNumElements() == 5);
+	SE_CHECK(bufferData.GetID(1) == 5);
+	SE_CHECK(bufferData.GetIndex(5) == 1);
+	SE_CHECK(bufferData.GetIndex(1) == TestBufferData::k_invalidIdx);
+	SE_CHECK(CountMappingErrors(bufferData, expected) == 0);
+	SE_CHECK(ConsumeDirtyRanges(bufferData) == std::vector<UploadRange>({ { 1, 1 } }));
+
+	// Removing the last element moves nothing, and leaves nothing to upload
+	bufferData.RemoveElement(4);
+	expected.erase(4);
+	SE_CHECK(CountMappingErrors(bufferData, expected) == 0);
+	SE_CHECK(ConsumeDirtyRanges(bufferData).empty());
+
+	// IDs that were never added (e.g. filtered out) are ignored
+	bufferData.RemoveElement(1);
+	bufferData.RemoveElement(1234);
+	SE_CHECK(CountMappingErrors(bufferData, expected) == 0);
+
+	// Removing the element that was moved moves it again
+	bufferData.RemoveElement(0);
+	expected.erase(0);
+	SE_CHECK(bufferData.GetID(0) == 3);
+	SE_CHECK(CountMappingErrors(bufferData, expected) == 0);
+
+	// New elements are appended to the packed range
+	bufferData.AddOrUpdateElement(1, 11);
+	expected.emplace(1, 11);
+	SE_CHECK(bufferData.GetIndex(1) == 3);
+	SE_CHECK(CountMappingErrors(bufferData, expected) == 0);
+
+	bufferData.Clear();
+	SE_CHECK(bufferData.GetNumElements() == 0);
+	SE_CHECK(bufferData.GetIndex(2) == TestBufferData::k_invalidIdx);
+	SE_CHECK(ConsumeDirtyRanges(bufferData).empty());
+}
+
+
+SE_TEST(IndexedBufferData_DirtyRangesBridgeSmallGaps)
+{
+	TestBufferData bufferData;
+
+	// Newly added elements are a single range
+	for (gr::IDType id = 0; id < 64; ++id)
+	{
+		bufferData.AddOrUpdateElement(id, id);
+	}
+	SE_CHECK(ConsumeDirtyRanges(bufferData) == std::vector<UploadRange>({ { 0, 64 } }));
+	SE_CHECK(ConsumeDirtyRanges(bufferData).empty()); // Consuming the ranges clears them
+
+	auto UpdateElements = [&bufferData](std::vector<gr::IDType> const& ids)
+		{
+			for (gr::IDType id : ids)
+			{
+				bufferData.AddOrUpdateElement(id, id + 1000);
+			}
+		};
+
+	// A gap of exactly k_maxBridgedGapElements clean elements is bridged...
+	static_assert(TestBufferData::k_maxBridgedGapElements == 8);
+	UpdateElements({ 0, 9 });
+	SE_CHECK(ConsumeDirtyRanges(bufferData) == std::vector<UploadRange>({ { 0, 10 } }));
+
+	// ...but a larger one is not
+	UpdateElements({ 0, 10 });
+	SE_CHECK(ConsumeDirtyRanges(bufferData) == std::vector<UploadRange>({ { 0, 1 }, { 10, 1 } }));
+
+	// Bridging chains across several gaps, and ranges are reported in ascending order, across bitset words
+	UpdateElements({ 63, 20, 12, 3, 29, 40, 41, 50 });
+	SE_CHECK(ConsumeDirtyRanges(bufferData) == std::vector<UploadRange>({ { 3, 27 }, { 40, 11 }, { 63, 1 } }));
+
+	// Updating an element more than once uploads it once
+	UpdateElements({ 5, 5, 5 });
+	SE_CHECK(ConsumeDirtyRanges(bufferData) == std::vector<UploadRange>({ { 5, 1 } }));
+
+	// Elements dirtied before a reallocation are not uploaded again
+	UpdateElements({ 1, 2, 3 });
+	bufferData.ClearDirtyElements();
+	SE_CHECK(ConsumeDirtyRanges(bufferData).empty());
+}
+
+
+SE_TEST(IndexedBufferData_ArraySizeGrowsAndShrinks)
+{
+	constexpr uint32_t k_alignment = TestBufferData::k_arraySizeAlignment;
+	static_assert(k_alignment == 16 && TestBufferData::k_shrinkFactor == 2);
+
+	// No Buffer yet: A minimum-sized Buffer is allocated, even if there are no elements
+	SE_CHECK(TestBufferData::GetRequiredArraySize(0, 0) == k_alignment);
+	SE_CHECK(TestBufferData::GetRequiredArraySize(0, 1) == k_alignment);
+	SE_CHECK(TestBufferData::GetRequiredArraySize(0, 17) == 32);
+
+	// Growing rounds up to the alignment
+	SE_CHECK(TestBufferData::GetRequiredArraySize(16, 16) == 16);
+	SE_CHECK(TestBufferData::GetRequiredArraySize(16, 17) == 32);
+	SE_CHECK(TestBufferData::GetRequiredArraySize(64, 1000) == 1008);
+
+	// Shrinking only happens once the elements fit in half the Buffer...
+	SE_CHECK(TestBufferData::GetRequiredArraySize(128, 65) == 128);
+	SE_CHECK(TestBufferData::GetRequiredArraySize(128, 64) == 64);
+	SE_CHECK(TestBufferData::GetRequiredArraySize(1008, 100) == 112);
+
+	// ...and Buffers at the minimum size are never shrunk
+	SE_CHECK(TestBufferData::GetRequiredArraySize(16, 0) == 16);
+	SE_CHECK(TestBufferData::GetRequiredArraySize(16, 1) == 16);
+	SE_CHECK(TestBufferData::GetRequiredArraySize(32, 0) == 16);
+
+	// A Buffer that shrank is not immediately shrunk or grown again
+	const uint32_t shrunkArraySize = TestBufferData::GetRequiredArraySize(512, 200);
+	SE_CHECK(shrunkArraySize == 208);
+	SE_CHECK(TestBufferData::GetRequiredArraySize(shrunkArraySize, 200) == shrunkArraySize);
+	SE_CHECK(TestBufferData::GetRequiredArraySize(shrunkArraySize, 105) == shrunkArraySize);
+}
+
+
+SE_TEST(IndexedBufferData_UploadsMatchCPUDataUnderRandomEdits)
+{
+	// Mirrors TypedIndexedBuffer::UpdateBuffer: A reallocated Buffer receives every element, otherwise only the dirty
+	// ranges are copied. The GPU-side copy must always match the CPU data
+	TestBufferData bufferData;
+	std::unordered_map<gr::IDType, uint64_t> expected;
+
+	std::vector<uint64_t> gpuData;
+	uint32_t numReallocations = 0;
+	uint32_t numShrinks = 0;
+
+	std::mt19937 generator(112358);
+	gr::IDType nextID = 0;
+	for (uint32_t frameIdx = 0; frameIdx < 1000; ++frameIdx)
+	{
+		// Phases of growth and decline, so the Buffer grows and shrinks
+		const bool isGrowing = (frameIdx / 100) % 2 == 0;
+
+		const uint32_t numEdits = generator() % 64;
+		for (uint32_t editIdx = 0; editIdx < numEdits; ++editIdx)
+		{
+			const uint32_t editType = generator() % 10;
+			if (expected.empty() || editType < (isGrowing ? 4u : 2u))
+			{
+				const uint64_t value = generator();
+				bufferData.AddOrUpdateElement(nextID, uint64_t(value));
+				expected.emplace(nextID++, value);
+			}
+			else
+			{
+				// Pick an existing element through its buffer index
+				const gr::IDType id = bufferData.GetID(generator() % bufferData.GetNumElements());
+				if (editType < 7)
+				{
+					const uint64_t value = generator();
+					bufferData.AddOrUpdateElement(id, uint64_t(value));
+					expected.at(id) = value;
+				}
+				else
+				{
+					bufferData.RemoveElement(id);
+					expected.erase(id);
+				}
+			}
+		}
+		SE_CHECK(CountMappingErrors(bufferData, expected) == 0);
+
+		const uint32_t numElements = bufferData.GetNumElements();
+		const uint32_t currentArraySize = util::CheckedCast<uint32_t>(gpuData.size());
+		const uint32_t arraySize = TestBufferData::GetRequiredArraySize(currentArraySize, numElements);
+		SE_CHECK(arraySize >= numElements);
+		SE_CHECK(arraySize % TestBufferData::k_arraySizeAlignment == 0);
+
+		if (arraySize != currentArraySize)
+		{
+			numReallocations++;
+			numShrinks += (arraySize < currentArraySize);
+
+			gpuData.assign(arraySize, 0);
+			for (TestBufferData::IndexType bufferIdx = 0; bufferIdx < numElements; ++bufferIdx)
+			{
+				gpuData[bufferIdx] = bufferData.GetElement(bufferIdx);
+			}
+			bufferData.ClearDirtyElements();
+		}
+		else
+		{
+			TestBufferData::IndexType prevRangeEndIdx = 0;
+			bufferData.ConsumeDirtyRanges(
+				[&](TestBufferData::IndexType baseIdx, TestBufferData::IndexType numRangeElements)
+				{
+					// Ranges are in bounds, ascending, and separated by more than the bridged gap size
+					SE_CHECK(numRangeElements > 0 && baseIdx + numRangeElements <= numElements);
+					SE_CHECK(prevRangeEndIdx == 0 ||
+						baseIdx - prevRangeEndIdx > TestBufferData::k_maxBridgedGapElements);
+					prevRangeEndIdx = baseIdx + numRangeElements;
+
+					for (TestBufferData::IndexType bufferIdx = baseIdx; bufferIdx < prevRangeEndIdx; ++bufferIdx)
+					{
+						gpuData[bufferIdx] = bufferData.GetElement(bufferIdx);
+					}
+				});
+		}
+
+		uint32_t numStaleElements = 0;
+		for (TestBufferData::IndexType bufferIdx = 0; bufferIdx < numElements; ++bufferIdx)
+		{
+			numStaleElements += (gpuData[bufferIdx] != bufferData.GetElement(bufferIdx));
+		}
+		SE_CHECK(numStaleElements == 0);
+	}
+
+	// The edits must have exercised both reallocation paths
+	SE_CHECK(numReallocations > numShrinks);
+	SE_CHECK(numShrinks > 0);
+}
\ No newline at end of file
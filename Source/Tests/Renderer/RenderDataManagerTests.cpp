@@ -0,0 +1,420 @@
+// © 2025 Adam Badke. All rights reserved.
+#include "TestHarness.h"
+
+#include "Renderer/RenderDataManager.h"
+
+
+namespace
+{
+	constexpr uint8_t k_numDataTypes = 4;
+
+
+	template<uint8_t TypeIdx>
+	struct BenchmarkRenderData
+	{
+		glm::vec4 m_value;
+		gr::RenderDataID m_renderDataID;
+	};
+
+
+	// RenderDataManager's metadata layout before its dense slot maps: A hash lookup per RenderDataID, and a
+	// red-black tree walk per data type. Benchmarked as the baseline for the adapters
+	struct PreviousRenderObjectMetadata
+	{
+		std::map<uint8_t, uint32_t> m_dataTypeToDataIndexMap;
+		std::map<uint8_t, uint64_t> m_dirtyFrameMap;
+		gr::TransformID m_transformID;
+	};
+
+
+	template<uint8_t TypeIdx>
+	void SetBenchmarkData(
+		gr::RenderDataManager& renderData,
+		std::vector<gr::RenderDataID> const& renderDataIDs,
+		std::unordered_map<gr::RenderDataID, PreviousRenderObjectMetadata>& previousMetadata,
+		std::vector<BenchmarkRenderData<0>>& previousDataVector)
+	{
+		for (gr::RenderDataID renderDataID : renderDataIDs)
+		{
+			const BenchmarkRenderData<TypeIdx> data{
+				.m_value = glm::vec4(static_cast<float>(renderDataID + TypeIdx)),
+				.m_renderDataID = renderDataID, };
+			renderData.SetObjectData(renderDataID, &data);
+
+			previousMetadata.at(renderDataID).m_dirtyFrameMap.emplace(TypeIdx, 1);
+			if constexpr (TypeIdx == 0)
+			{
+				previousMetadata.at(renderDataID).m_dataTypeToDataIndexMap.emplace(
+					TypeIdx, static_cast<uint32_t>(previousDataVector.size()));
+				previousDataVector.emplace_back(data);
+			}
+			else
+			{
+				previousMetadata.at(renderDataID).m_dataTypeToDataIndexMap.emplace(TypeIdx, 0);
+			}
+		}
+	}
+
+
+	// Owns a heap allocation, as (e.g.) skinning data does. Copies are counted, so we can check bulk updates move
+	template<uint8_t TypeIdx>
+	struct HeapOwningRenderData
+	{
+		std::vector<float> m_values;
+
+		static inline uint32_t s_numCopies = 0;
+
+		explicit HeapOwningRenderData(std::vector<float>&& values) : m_values(std::move(values)) {}
+
+		HeapOwningRenderData(HeapOwningRenderData const& rhs)
+			: m_values(rhs.m_values)
+		{
+			s_numCopies++;
+		}
+
+		HeapOwningRenderData& operator=(HeapOwningRenderData const& rhs)
+		{
+			m_values = rhs.m_values;
+			s_numCopies++;
+			return *this;
+		}
+
+		HeapOwningRenderData(HeapOwningRenderData&&) noexcept = default;
+		HeapOwningRenderData& operator=(HeapOwningRenderData&&) noexcept = default;
+	};
+
+
+	struct MoveOnlyRenderData
+	{
+		std::unique_ptr<uint32_t> m_value;
+	};
+
+
+	std::vector<gr::RenderDataID> GetIDList(std::vector<gr::RenderDataID> const* ids)
+	{
+		return ids ? *ids : std::vector<gr::RenderDataID>{};
+	}
+}
+
+
+SE_BENCHMARK(RenderDataManager_AdapterTraversal)
+{
+	constexpr gr::RenderDataID k_numObjects = 100000;
+
+	gr::RenderDataManager renderData;
+	renderData.BeginFrame(1);
+
+	std::unordered_map<gr::RenderDataID, PreviousRenderObjectMetadata> previousMetadata;
+	std::vector<BenchmarkRenderData<0>> previousDataVector;
+
+	std::vector<gr::RenderDataID> allIDs(k_numObjects);
+	std::iota(allIDs.begin(), allIDs.end(), 0);
+	for (gr::RenderDataID renderDataID : allIDs)
+	{
+		const gr::TransformID transformID = renderDataID / 2; // Objects share Transforms, as MeshPrimitives do
+		renderData.RegisterObject(renderDataID, transformID);
+		previousMetadata.emplace(renderDataID, PreviousRenderObjectMetadata{ .m_transformID = transformID });
+	}
+
+	// Each object has several types of data, so the previous layout's per-object maps have several entries
+	SetBenchmarkData<0>(renderData, allIDs, previousMetadata, previousDataVector);
+	SetBenchmarkData<1>(renderData, allIDs, previousMetadata, previousDataVector);
+	SetBenchmarkData<2>(renderData, allIDs, previousMetadata, previousDataVector);
+	SetBenchmarkData<3>(renderData, allIDs, previousMetadata, previousDataVector);
+	SE_CHECK(renderData.GetNumElementsOfType<BenchmarkRenderData<k_numDataTypes - 1>>() == k_numObjects);
+
+	// A random subset of the IDs, sorted as (e.g.) the culling results are
+	std::vector<gr::RenderDataID> subsetIDs;
+	std::mt19937 generator(97531);
+	std::sample(allIDs.begin(), allIDs.end(), std::back_inserter(subsetIDs), k_numObjects / 4, generator);
+
+	// The sums are exact: Every value is a small integer
+	const double expectedSum = std::accumulate(allIDs.begin(), allIDs.end(), 0.0);
+	const double expectedSubsetSum = std::accumulate(subsetIDs.begin(), subsetIDs.end(), 0.0);
+
+	auto MeasureTraversal = [](char const* label, size_t numItems, double expectedSum, auto&& Traverse)
+		{
+			double sum = 0.0;
+			const double ms = tests::MeasureMedianMs(20, [&]()
+				{
+					sum = Traverse();
+					tests::DoNotOptimize(sum);
+				});
+			SE_CHECK(sum == expectedSum);
+			tests::TestHarness::RecordTiming(label, ms, numItems);
+		};
+
+	MeasureTraversal("LinearAdapter: All objects", k_numObjects, expectedSum, [&renderData]()
+		{
+			double sum = 0.0;
+			for (auto const& itr : gr::LinearAdapter<BenchmarkRenderData<0>>(renderData))
+			{
+				sum += itr->Get<BenchmarkRenderData<0>>().m_value.x;
+			}
+			return sum;
+		});
+
+	MeasureTraversal("IDAdapter: All objects", k_numObjects, expectedSum, [&renderData, &allIDs]()
+		{
+			double sum = 0.0;
+			for (auto const& itr : gr::IDAdapter(renderData, allIDs))
+			{
+				if (itr->IsDirty<BenchmarkRenderData<0>>())
+				{
+					sum += itr->Get<BenchmarkRenderData<0>>().m_value.x;
+				}
+			}
+			return sum;
+		});
+
+	MeasureTraversal("IDAdapter: 25% subset", subsetIDs.size(), expectedSubsetSum, [&renderData, &subsetIDs]()
+		{
+			double sum = 0.0;
+			for (auto const& itr : gr::IDAdapter(renderData, subsetIDs))
+			{
+				if (itr->IsDirty<BenchmarkRenderData<0>>())
+				{
+					sum += itr->Get<BenchmarkRenderData<0>>().m_value.x;
+				}
+			}
+			return sum;
+		});
+
+	// The previous layout's IDIterator: Incrementing cached a hash lookup used by IsDirty, and Get went through
+	// GetObjectData (i.e. another hash lookup). Both then walked the object's std::map for the data type
+	auto PreviousLayoutTraversal = [&previousMetadata, &previousDataVector](std::vector<gr::RenderDataID> const& ids)
+		{
+			double sum = 0.0;
+			for (gr::RenderDataID renderDataID : ids)
+			{
+				auto currentMetadataItr = previousMetadata.find(renderDataID);
+				if (currentMetadataItr->second.m_dirtyFrameMap.at(0) == 1)
+				{
+					sum += previousDataVector[
+						previousMetadata.find(renderDataID)->second.m_dataTypeToDataIndexMap.at(0)].m_value.x;
+				}
+			}
+			return sum;
+		};
+
+	MeasureTraversal("Previous layout reference: All objects", k_numObjects, expectedSum, [&]()
+		{
+			return PreviousLayoutTraversal(allIDs);
+		});
+
+	MeasureTraversal("Previous layout reference: 25% subset", subsetIDs.size(), expectedSubsetSum, [&]()
+		{
+			return PreviousLayoutTraversal(subsetIDs);
+		});
+}
+
+
+SE_TEST(RenderDataManager_BulkSetObjectDataMatchesPerObjectUpdates)
+{
+	// Data type indexes are shared by every RenderDataManager, so we compare 2 types within a single manager: The bulk
+	// update sets type 0, and per-object updates set type 1 to the same values
+	using BulkData = HeapOwningRenderData<0>;
+	using PerObjectData = HeapOwningRenderData<1>;
+
+	constexpr gr::RenderDataID k_numObjects = 64;
+
+	gr::RenderDataManager renderData;
+	renderData.BeginFrame(1);
+
+	for (gr::RenderDataID renderDataID = 0; renderDataID < k_numObjects; ++renderDataID)
+	{
+		renderData.RegisterObject(renderDataID, renderDataID / 2);
+	}
+
+	// Frame 1: Every 2nd object gets data, so the batch below is a mix of new and existing data
+	for (gr::RenderDataID renderDataID = 0; renderDataID < k_numObjects; renderDataID += 2)
+	{
+		const BulkData bulkData({ static_cast<float>(renderDataID), 1.f });
+		renderData.SetObjectData(renderDataID, &bulkData);
+
+		const PerObjectData perObjectData({ static_cast<float>(renderDataID), 1.f });
+		renderData.SetObjectData(renderDataID, &perObjectData);
+	}
+
+	renderData.BeginFrame(2);
+
+	// Frame 2: 2 of every 3 objects, in a shuffled order. The first ID is repeated at the end: The last data wins
+	std::vector<gr::RenderDataID> batchIDs;
+	for (gr::RenderDataID renderDataID = 0; renderDataID < k_numObjects; ++renderDataID)
+	{
+		if (renderDataID % 3 != 0)
+		{
+			batchIDs.emplace_back(renderDataID);
+		}
+	}
+	std::mt19937 generator(86420);
+	std::shuffle(batchIDs.begin(), batchIDs.end(), generator);
+	batchIDs.emplace_back(batchIDs.front());
+
+	std::vector<BulkData> bulkData;
+	std::unordered_map<gr::RenderDataID, float const*> expectedHeapAllocations;
+	for (size_t batchIdx = 0; batchIdx < batchIDs.size(); ++batchIdx)
+	{
+		std::vector<float> values = { static_cast<float>(batchIDs[batchIdx]), 2.f, static_cast<float>(batchIdx) };
+
+		const PerObjectData perObjectData{ std::vector<float>(values) };
+		renderData.SetObjectData(batchIDs[batchIdx], &perObjectData);
+
+		bulkData.emplace_back(std::move(values));
+		expectedHeapAllocations[batchIDs[batchIdx]] = bulkData.back().m_values.data();
+	}
+
+	BulkData::s_numCopies = 0;
+	renderData.SetObjectData(batchIDs, std::span(bulkData));
+
+	// The data was moved: Each object holds the heap allocation we created, and nothing was copied
+	SE_CHECK(BulkData::s_numCopies == 0);
+	for (auto const& [renderDataID, heapAllocation] : expectedHeapAllocations)
+	{
+		SE_CHECK(renderData.GetObjectData<BulkData>(renderDataID).m_values.data() == heapAllocation);
+	}
+
+	// The tracking lists match those of the per-object updates, entry for entry
+	const std::vector<gr::RenderDataID> newIDs = GetIDList(renderData.GetIDsWithNewData<BulkData>());
+	const std::vector<gr::RenderDataID> dirtyIDs = GetIDList(renderData.GetIDsWithDirtyData<BulkData>());
+
+	SE_CHECK(!newIDs.empty());
+	SE_CHECK(newIDs == GetIDList(renderData.GetIDsWithNewData<PerObjectData>()));
+	SE_CHECK(dirtyIDs.size() == batchIDs.size() - 1); // The repeated ID is only listed once
+	SE_CHECK(dirtyIDs == GetIDList(renderData.GetIDsWithDirtyData<PerObjectData>()));
+	SE_CHECK(*renderData.GetRegisteredRenderDataIDs<BulkData>() ==
+		*renderData.GetRegisteredRenderDataIDs<PerObjectData>());
+	SE_CHECK(renderData.GetNumElementsOfType<BulkData>() == renderData.GetNumElementsOfType<PerObjectData>());
+
+	for (gr::RenderDataID renderDataID = 0; renderDataID < k_numObjects; ++renderDataID)
+	{
+		const bool hasData = renderData.HasObjectData<BulkData>(renderDataID);
+		SE_CHECK(hasData == renderData.HasObjectData<PerObjectData>(renderDataID));
+		if (hasData)
+		{
+			SE_CHECK(renderData.GetObjectData<BulkData>(renderDataID).m_values ==
+				renderData.GetObjectData<PerObjectData>(renderDataID).m_values);
+			SE_CHECK(renderData.IsDirty<BulkData>(renderDataID) == renderData.IsDirty<PerObjectData>(renderDataID));
+		}
+	}
+}
+
+
+SE_TEST(RenderDataManager_BulkSetObjectDataMovesMoveOnlyData)
+{
+	constexpr gr::RenderDataID k_numObjects = 8;
+
+	gr::RenderDataManager renderData;
+	renderData.BeginFrame(1);
+
+	std::vector<gr::RenderDataID> renderDataIDs(k_numObjects);
+	std::iota(renderDataIDs.begin(), renderDataIDs.end(), 0);
+
+	std::vector<MoveOnlyRenderData> data;
+	std::vector<uint32_t const*> heapAllocations;
+	for (gr::RenderDataID renderDataID : renderDataIDs)
+	{
+		renderData.RegisterObject(renderDataID, renderDataID);
+
+		data.emplace_back(MoveOnlyRenderData{ .m_value = std::make_unique<uint32_t>(renderDataID) });
+		heapAllocations.emplace_back(data.back().m_value.get());
+	}
+
+	renderData.SetObjectData(renderDataIDs, std::span(data));
+
+	SE_CHECK(std::ranges::all_of(data, [](MoveOnlyRenderData const& moved) { return moved.m_value == nullptr; }));
+	for (gr::RenderDataID renderDataID : renderDataIDs)
+	{
+		SE_CHECK(renderData.GetObjectData<MoveOnlyRenderData>(renderDataID).m_value.get() ==
+			heapAllocations[renderDataID]);
+	}
+
+	// Updating existing data moves into the existing element
+	renderData.BeginFrame(2);
+
+	const std::vector<gr::RenderDataID> updatedIDs = { 5, 2 };
+	std::vector<MoveOnlyRenderData> updatedData;
+	for (gr::RenderDataID renderDataID : updatedIDs)
+	{
+		updatedData.emplace_back(MoveOnlyRenderData{ .m_value = std::make_unique<uint32_t>(renderDataID + 100) });
+		heapAllocations[renderDataID] = updatedData.back().m_value.get();
+	}
+
+	renderData.SetObjectData(updatedIDs, std::span(updatedData));
+
+	for (gr::RenderDataID renderDataID : renderDataIDs)
+	{
+		MoveOnlyRenderData const& objectData = renderData.GetObjectData<MoveOnlyRenderData>(renderDataID);
+		SE_CHECK(objectData.m_value.get() == heapAllocations[renderDataID]);
+	}
+	SE_CHECK(*renderData.GetObjectData<MoveOnlyRenderData>(5).m_value == 105);
+	SE_CHECK(*renderData.GetIDsWithDirtyData<MoveOnlyRenderData>() == updatedIDs);
+	SE_CHECK(renderData.GetIDsWithNewData<MoveOnlyRenderData>()->empty());
+}
+
+
+SE_TEST(RenderDataManager_BulkSetTransformDataMatchesPerTransformUpdates)
+{
+	constexpr gr::RenderDataID k_numObjects = 64;
+
+	gr::RenderDataManager bulkRenderData;
+	gr::RenderDataManager perTransformRenderData;
+
+	for (gr::RenderDataManager* renderData : { &bulkRenderData, &perTransformRenderData })
+	{
+		renderData->BeginFrame(1);
+		for (gr::RenderDataID renderDataID = 0; renderDataID < k_numObjects; ++renderDataID)
+		{
+			renderData->RegisterObject(renderDataID, renderDataID / 2); // Objects share Transforms
+		}
+		renderData->BeginFrame(2);
+	}
+
+	// 3 of every 4 Transforms, in a shuffled order. The first ID is repeated at the end: The last data wins
+	std::vector<gr::TransformID> batchIDs;
+	for (gr::TransformID transformID = 0; transformID < k_numObjects / 2; ++transformID)
+	{
+		if (transformID % 4 != 0)
+		{
+			batchIDs.emplace_back(transformID);
+		}
+	}
+	std::mt19937 generator(13579);
+	std::shuffle(batchIDs.begin(), batchIDs.end(), generator);
+	batchIDs.emplace_back(batchIDs.front());
+
+	std::vector<gr::Transform::RenderData> batchData;
+	for (size_t batchIdx = 0; batchIdx < batchIDs.size(); ++batchIdx)
+	{
+		batchData.emplace_back(gr::Transform::RenderData{
+			.m_globalPosition = glm::vec3(static_cast<float>(batchIdx)),
+			.m_transformID = batchIDs[batchIdx], });
+
+		perTransformRenderData.SetTransformData(batchIDs[batchIdx], batchData.back());
+	}
+
+	bulkRenderData.SetTransformData(batchIDs, batchData);
+
+	SE_CHECK(bulkRenderData.GetIDsWithDirtyTransformData().size() == batchIDs.size() - 1);
+	SE_CHECK(bulkRenderData.GetIDsWithDirtyTransformData() == perTransformRenderData.GetIDsWithDirtyTransformData());
+	SE_CHECK(bulkRenderData.GetNumTransforms() == perTransformRenderData.GetNumTransforms());
+
+	for (gr::TransformID transformID = 0; transformID < k_numObjects / 2; ++transformID)
+	{
+		gr::Transform::RenderData const& bulkTransform = bulkRenderData.GetTransformDataFromTransformID(transformID);
+		gr::Transform::RenderData const& perTransformTransform =
+			perTransformRenderData.GetTransformDataFromTransformID(transformID);
+
+		SE_CHECK(bulkTransform.m_transformID == perTransformTransform.m_transformID);
+		SE_CHECK(bulkTransform.m_globalPosition.x == perTransformTransform.m_globalPosition.x);
+		SE_CHECK(bulkRenderData.TransformIsDirty(transformID) == perTransformRenderData.TransformIsDirty(transformID));
+	}
+
+	// Render objects referencing an updated Transform are flagged
+	for (gr::RenderDataID renderDataID = 0; renderDataID < k_numObjects; ++renderDataID)
+	{
+		const bool isDirty = bulkRenderData.TransformIsDirtyFromRenderDataID(renderDataID);
+		SE_CHECK(isDirty == perTransformRenderData.TransformIsDirtyFromRenderDataID(renderDataID));
+		SE_CHECK(isDirty == ((renderDataID / 2) % 4 != 0));
+	}
+}
\ No newline at end of file
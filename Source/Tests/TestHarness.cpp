@@ -0,0 +1,150 @@
+// © 2025 Adam Badke. All rights reserved.
+#include "TestHarness.h"
+
+
+namespace
+{
+	constexpr char const* CaseTypeToCStr(tests::CaseType caseType)
+	{
+		switch (caseType)
+		{
+		case tests::CaseType::Test: return "test";
+		case tests::CaseType::Benchmark: return "benchmark";
+		default: return "INVALID_CASE_TYPE";
+		}
+	}
+
+
+	std::atomic<uint64_t> s_numGlobalAllocations = 0;
+}
+
+
+// The Tests executable replaces the global allocation functions, so benchmarks can count allocations. The array and
+// nothrow forms forward to these. Over-aligned allocations are not counted
+void* operator new(size_t numBytes)
+{
+	s_numGlobalAllocations.fetch_add(1, std::memory_order_relaxed);
+
+	if (void* memory = std::malloc(numBytes == 0 ? 1 : numBytes))
+	{
+		return memory;
+	}
+	throw std::bad_alloc();
+}
+
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+
+void operator delete(void* memory, size_t) noexcept
+{
+	std::free(memory);
+}
+
+
+namespace tests
+{
+	std::atomic<uint32_t> TestHarness::s_numFailedChecks = 0;
+	std::mutex TestHarness::s_outputMutex;
+
+
+	uint64_t GetNumGlobalAllocations()
+	{
+		return s_numGlobalAllocations.load(std::memory_order_relaxed);
+	}
+
+
+	std::vector<TestHarness::Case>& TestHarness::GetCases()
+	{
+		static std::vector<Case> s_cases;
+		return s_cases;
+	}
+
+
+	bool TestHarness::RegisterCase(char const* name, CaseType caseType, CaseFunction caseFunction)
+	{
+		GetCases().emplace_back(Case{
+			.m_name = name,
+			.m_type = caseType,
+			.m_function = caseFunction,
+			});
+		return true;
+	}
+
+
+	uint32_t TestHarness::RunCases(CaseType caseType, std::string_view nameFilter)
+	{
+		std::vector<Case> cases;
+		for (Case const& registeredCase : GetCases())
+		{
+			const bool matchesFilter = nameFilter.empty() ||
+				std::string_view(registeredCase.m_name).find(nameFilter) != std::string_view::npos;
+			if (registeredCase.m_type == caseType && matchesFilter)
+			{
+				cases.emplace_back(registeredCase);
+			}
+		}
+
+		// Static initialization order is unspecified across translation units: Sort for a deterministic run order
+		std::sort(cases.begin(), cases.end(),
+			[](Case const& a, Case const& b) { return std::strcmp(a.m_name, b.m_name) < 0; });
+
+		std::cout << std::format("Running {} {} case(s)...\n", cases.size(), CaseTypeToCStr(caseType));
+
+		uint32_t numFailedCases = 0;
+		host::PerformanceTimer caseTimer;
+		for (Case const& curCase : cases)
+		{
+			std::cout << std::format("[ RUN    ] {}\n", curCase.m_name);
+
+			s_numFailedChecks.store(0);
+
+			caseTimer.Start();
+			curCase.m_function();
+			const double caseMs = caseTimer.StopMs();
+
+			const uint32_t numFailedChecks = s_numFailedChecks.load();
+			if (numFailedChecks == 0)
+			{
+				std::cout << std::format("[     OK ] {} ({:.2f} ms)\n", curCase.m_name, caseMs);
+			}
+			else
+			{
+				std::cout << std::format("[ FAILED ] {} ({} failed check(s))\n", curCase.m_name, numFailedChecks);
+				++numFailedCases;
+			}
+		}
+
+		std::cout << std::format("{} of {} {} case(s) passed\n\n",
+			cases.size() - numFailedCases, cases.size(), CaseTypeToCStr(caseType));
+
+		return numFailedCases;
+	}
+
+
+	void TestHarness::RecordFailure(char const* condition, char const* file, int line)
+	{
+		s_numFailedChecks.fetch_add(1);
+
+		std::lock_guard<std::mutex> lock(s_outputMutex);
+		std::cout << std::format("    Check failed: {}\n    File: {}\n    Line: {}\n", condition, file, line);
+	}
+
+
+	void TestHarness::RecordTiming(std::string_view label, double milliseconds, uint64_t numItems /*= 0*/)
+	{
+		std::lock_guard<std::mutex> lock(s_outputMutex);
+		if (numItems > 0)
+		{
+			std::cout << std::format("    {}: {:.3f} ms ({:.2f} ns/item)\n",
+				label, milliseconds, (milliseconds * 1000000.0) / static_cast<double>(numItems));
+		}
+		else
+		{
+			std::cout << std::format("    {}: {:.3f} ms\n", label, milliseconds);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+// © 2025 Adam Badke. All rights reserved.
+#pragma once
+#include "Core/Host/PerformanceTimer.h"
+
+
+namespace tests
+{
+	enum class CaseType : uint8_t
+	{
+		Test,		// Correctness checks: Any failed SE_CHECK fails the case
+		Benchmark,	// Timings: Only executed when requested on the command line
+
+		CaseType_Count
+	};
+
+
+	// Minimal self-registering test runner: Cases are registered during static initialization via the SE_TEST and
+	// SE_BENCHMARK macros, and executed (optionally filtered by name) from main
+	class TestHarness final
+	{
+	public:
+		using CaseFunction = void(*)();
+
+		static bool RegisterCase(char const* name, CaseType, CaseFunction); // Returns true
+
+		// Returns the number of cases that failed
+		static uint32_t RunCases(CaseType, std::string_view nameFilter);
+
+
+	public: // Thread safe: Checks may be executed from within jobs on the ThreadPool
+		static void RecordFailure(char const* condition, char const* file, int line);
+
+		static void RecordTiming(std::string_view label, double milliseconds, uint64_t numItems = 0);
+
+
+	private:
+		struct Case
+		{
+			char const* m_name;
+			CaseType m_type;
+			CaseFunction m_function;
+		};
+		static std::vector<Case>& GetCases(); // Function-local static: Cases are registered during static init
+
+		static std::atomic<uint32_t> s_numFailedChecks; // For the currently executing case
+		static std::mutex s_outputMutex;
+
+
+	private: // Static class only
+		TestHarness() = delete;
+		TestHarness(TestHarness const&) = delete;
+		TestHarness(TestHarness&&) noexcept = delete;
+		TestHarness& operator=(TestHarness const&) = delete;
+		TestHarness& operator=(TestHarness&&) noexcept = delete;
+	};
+
+
+	// Executes the function once to warm up, then numIterations times, and returns the median duration in ms
+	template<typename Function>
+	double MeasureMedianMs(uint32_t numIterations, Function&& function)
+	{
+		function(); // Warm up caches, pools, and lazily allocated storage
+
+		std::vector<double> timings;
+		timings.reserve(numIterations);
+
+		host::PerformanceTimer timer;
+		for (uint32_t iteration = 0; iteration < numIterations; ++iteration)
+		{
+			timer.Start();
+			function();
+			timings.emplace_back(timer.StopMs());
+		}
+
+		std::nth_element(timings.begin(), timings.begin() + timings.size() / 2, timings.end());
+		return timings[timings.size() / 2];
+	}
+
+
+	// The number of global operator new calls made so far, by any thread
+	uint64_t GetNumGlobalAllocations();
+
+
+	// Prevents the optimizer from discarding benchmarked results
+	template<typename T>
+	void DoNotOptimize(T const& value)
+	{
+		static std::atomic<uint64_t> s_sink;
+
+		uint64_t bits = 0;
+		std::memcpy(&bits, &value, std::min(sizeof(T), sizeof(bits)));
+		s_sink.fetch_xor(bits, std::memory_order_relaxed);
+	}
+}
+
+
+#define SE_TEST_CASE_INTERNAL(name, caseType) \
+	static void name(); \
+	static const bool name##_isRegistered = tests::TestHarness::RegisterCase(#name, caseType, &name); \
+	static void name()
+
+// Define a correctness test: SE_TEST(MyTest) { SE_CHECK(...); }
+#define SE_TEST(name) SE_TEST_CASE_INTERNAL(name, tests::CaseType::Test)
+
+// Define a benchmark: Report timings via tests::TestHarness::RecordTiming
+#define SE_BENCHMARK(name) SE_TEST_CASE_INTERNAL(name, tests::CaseType::Benchmark)
+
+// Non-fatal: Records the failure, and continues executing the case
+#define SE_CHECK(condition) \
+	if (!(condition)) \
+	{ \
+		tests::TestHarness::RecordFailure(#condition, __FILE__, __LINE__); \
+	}
\ No newline at end of file
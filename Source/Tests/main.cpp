@@ -0,0 +1,91 @@
+// © 2025 Adam Badke. All rights reserved.
+#include "TestHarness.h"
+
+#include "Core/EventManager_Platform.h"
+#include "Core/Logger.h"
+#include "Core/ThreadPool.h"
+
+#include "Core/Host/PerformanceTimer_Platform.h"
+#include "Core/Host/PerformanceTimer_Win32.h"
+
+
+namespace
+{
+	// Note: Incoming command line args are transformed to lower case before comparison with these keys
+	constexpr char const* k_delimiterChar = "-";
+	constexpr char const* k_benchmarksCmdLineArg = "-benchmarks"; // Run the benchmarks instead of the tests
+	constexpr char const* k_allCmdLineArg = "-all"; // Run the tests, followed by the benchmarks
+	constexpr char const* k_filterCmdLineArg = "-filter"; // Only run cases with names containing the next argument
+}
+
+
+int main(int argc, char* argv[])
+{
+	bool runTests = true;
+	bool runBenchmarks = false;
+	std::string nameFilter;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string currentArg = argv[i];
+		std::transform(
+			currentArg.begin(),
+			currentArg.end(),
+			currentArg.begin(),
+			[](unsigned char c) {return std::tolower(c); });
+
+		if (currentArg == k_benchmarksCmdLineArg)
+		{
+			runTests = false;
+			runBenchmarks = true;
+		}
+		else if (currentArg == k_allCmdLineArg)
+		{
+			runTests = true;
+			runBenchmarks = true;
+		}
+		else if (currentArg == k_filterCmdLineArg && i + 1 < argc && argv[i + 1][0] != *k_delimiterChar)
+		{
+			nameFilter = argv[i + 1]; // Case sensitive
+			++i;
+		}
+		else
+		{
+			std::cout << "Invalid command line argument: " << currentArg.c_str() << "\n";
+			std::cout << std::format("Usage: Tests.exe [{} | {}] [{} <case name substring>]\n",
+				k_benchmarksCmdLineArg, k_allCmdLineArg, k_filterCmdLineArg);
+			return -1;
+		}
+	}
+
+	// We're headless: Only bind the platform functions the cases depend on
+	platform::PerformanceTimer::Create	= &win32::PerformanceTimer::Create;
+	platform::PerformanceTimer::Start	= &win32::PerformanceTimer::Start;
+	platform::PerformanceTimer::PeekMs	= &win32::PerformanceTimer::PeekMs;
+	platform::PerformanceTimer::PeekSec = &win32::PerformanceTimer::PeekSec;
+
+	platform::EventManager::ProcessMessages = []() {}; // No window: There are no OS messages to pump
+
+	core::ThreadPool::Startup();
+	core::ThreadPool::NameCurrentThread(L"Main Thread");
+
+	// The engine's log output is written to the log file only, to keep the test output readable
+	core::Logger::Startup(false);
+
+	uint32_t numFailedCases = 0;
+	if (runTests)
+	{
+		numFailedCases += tests::TestHarness::RunCases(tests::CaseType::Test, nameFilter);
+	}
+	if (runBenchmarks)
+	{
+		numFailedCases += tests::TestHarness::RunCases(tests::CaseType::Benchmark, nameFilter);
+	}
+
+	core::Logger::Shutdown();
+	core::ThreadPool::Stop();
+
+	std::cout << (numFailedCases == 0 ? "All cases passed\n" : std::format("{} case(s) failed\n", numFailedCases));
+
+	return numFailedCases == 0 ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,3 @@
+// © 2025 Adam Badke. All rights reserved.
+#pragma once
+#include "pch.h"
\ No newline at end of file